@@ -116,6 +116,18 @@
 //
 uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, char *registrar_interface);
 
+// Change the limits of the buffer where CMDU fragments wait for the rest of
+// their CMDU (see "al_reassembly.h" for their meaning and build time defaults):
+//
+//   - 'max_cmdus_in_flight': partial CMDUs buffered at the same time.
+//   - 'max_fragments_per_cmdu': fragments accepted for one same CMDU.
+//   - 'timeout_ms': milliseconds a partial CMDU waits for its last fragment.
+//
+// A value of "0" keeps the current value of that limit. It can be called
+// before "start1905AL()" (ex: from the command line parsing code).
+//
+void set1905ALReassemblyLimits(uint32_t max_cmdus_in_flight, uint8_t max_fragments_per_cmdu, uint32_t timeout_ms);
+
 
 #endif
 
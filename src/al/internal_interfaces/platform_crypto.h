@@ -77,6 +77,18 @@ uint8_t PLATFORM_GET_RANDOM_BYTES(uint8_t *p, uint16_t len);
 //
 uint8_t PLATFORM_GENERATE_DH_KEY_PAIR(uint8_t **priv, uint16_t *priv_len, uint8_t **pub, uint16_t *pub_len);
 
+// Generating a DH key pair is slow. Platforms are allowed to generate them in
+// advance (in the background) so that "PLATFORM_GENERATE_DH_KEY_PAIR()" can
+// return right away.
+//
+// Calling this function is optional: it just lets the platform start doing so
+// as soon as possible (ie. at start up) instead of waiting for the first call
+// to "PLATFORM_GENERATE_DH_KEY_PAIR()".
+//
+// Return "0" if key pairs will not be generated in advance, "1" otherwise
+//
+uint8_t PLATFORM_PREPARE_DH_KEY_PAIRS(void);
+
 // Return the Diffie Hell shared secret (in output argument "shared_secret"
 // which is "shared_secret_len" bytes long) associated to a remote public key
 // ("remote_pub", which is "remote_pub_len" bytes long") and a local private
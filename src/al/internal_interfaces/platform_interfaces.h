@@ -525,6 +525,36 @@ void free_LIST_OF_BRIDGES(struct bridge *x, uint8_t nr);
 //
 uint8_t PLATFORM_SEND_RAW_PACKET(char *interface_name, uint8_t *dst_mac, uint8_t *src_mac, uint16_t eth_type, uint8_t *payload, uint16_t payload_len);
 
+// Description of one of the RAW ethernet frames to be sent with
+// "PLATFORM_SEND_RAW_PACKETS()". Fields have the same meaning as the arguments
+// of "PLATFORM_SEND_RAW_PACKET()".
+//
+struct rawPacket
+{
+    char      *interface_name;
+    uint8_t   *dst_mac;
+    uint8_t   *src_mac;
+    uint16_t   eth_type;
+    uint8_t   *payload;
+    uint16_t   payload_len;
+};
+
+// Same as "PLATFORM_SEND_RAW_PACKET()", but sending all the 'packets_nr'
+// frames contained in 'packets', in order.
+//
+// Consecutive entries going out through the same interface are handed to the
+// platform together (up to "MAX_RAW_PACKETS_PER_BATCH" of them at a time), so
+// callers should group them by interface whenever possible (ex: all fragments
+// of a CMDU on one interface, then all fragments on the next one...)
+//
+// Payloads are not modified and can be freed as soon as this function returns.
+//
+// If one or more packets cannot be sent (the rest of them are still sent),
+// this function returns "0", otherwise it returns "1"
+//
+#define MAX_RAW_PACKETS_PER_BATCH  (32)
+uint8_t PLATFORM_SEND_RAW_PACKETS(struct rawPacket *packets, uint16_t packets_nr);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Push button configuration
@@ -404,6 +404,7 @@ uint8_t PLATFORM_CREATE_QUEUE(const char *name);
 #define PLATFORM_QUEUE_EVENT_PUSH_BUTTON                  (0x04)
 #define PLATFORM_QUEUE_EVENT_AUTHENTICATED_LINK           (0x05)
 #define PLATFORM_QUEUE_EVENT_TOPOLOGY_CHANGE_NOTIFICATION (0x06)
+#define PLATFORM_QUEUE_EVENT_WORK_DONE                    (0x07)
 
 #define MAX_TIMER_TOKEN (1000)
 
@@ -430,4 +431,44 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
 //
 uint8_t PLATFORM_READ_QUEUE(uint8_t queue_id, uint8_t *message_buffer);
 
+// Same as "PLATFORM_READ_QUEUE()", but instead of copying the message into a
+// caller provided buffer, a pointer to the queue's own buffer is returned.
+//
+// The buffer belongs to the queue and remains valid until the next call to
+// "PLATFORM_READ_QUEUE*()" on this same 'queue_id'.
+//
+// If there is a problem this function returns "NULL"
+//
+uint8_t *PLATFORM_READ_QUEUE_NOCOPY(uint8_t queue_id);
+
+// Run 'work(data)' on a background thread (so that the caller, typically the AL
+// main thread, does not have to wait for it) and, once it has finished, insert
+// a "PLATFORM_QUEUE_EVENT_WORK_DONE" message in the queue whose id is
+// 'queue_id' (which is the value obtained when calling
+// "PLATFORM_CREATE_QUEUE()").
+//
+// The queue reader must then call 'done(data)' (from its own thread) so that
+// the result can be consumed.
+//
+// 'work' must not use anything that is not thread safe (the AL data model, for
+// example). Several works can run at the same time, in any order.
+//
+// The message inserted in the queue has the following format:
+//
+//   byte 0x00              - PLATFORM_QUEUE_EVENT_WORK_DONE
+//   byte 0x01              - Message length MSB (0x00)
+//   byte 0x02              - Message length LSB (sizeof(struct eventWorkDone))
+//   bytes 0x03 and beyond  - A "struct eventWorkDone" (in host memory layout)
+//
+// If the work could not be handed over to a background thread this function
+// returns "0" (and neither 'work' nor 'done' are called), otherwise it returns
+// "1".
+//
+struct eventWorkDone
+{
+    void    (*done)(void *data);
+    void     *data;
+};
+uint8_t PLATFORM_RUN_IN_BACKGROUND(uint8_t queue_id, void (*work)(void *data), void (*done)(void *data), void *data);
+
 #endif
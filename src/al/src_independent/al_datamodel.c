@@ -57,6 +57,7 @@
 #include "1905_cmdus.h"
 
 #include "al_extension.h"
+#include "al_timers.h"
 
 #include <string.h> // memcmp(), memcpy(), ...
 #include <stdio.h>    // snprintf
@@ -79,12 +80,12 @@ struct _dataModel
         char               *name;
         uint8_t               mac_address[6];
 
-        uint8_t               neighbors_nr;
+        uint16_t              neighbors_nr;
 
         struct _neighbor
         {
             uint8_t               al_mac_address[6];
-            uint8_t               remote_interfaces_nr;
+            uint16_t              remote_interfaces_nr;
 
             struct _remoteInterface
             {
@@ -94,16 +95,40 @@ struct _dataModel
 
             }                  *remote_interfaces;
 
-        }                  *neighbors;
+        }                 **neighbors;
+
+        struct hashTable     *neighbors_index;
+                                 // Neighbor AL MAC --> "struct _neighbor *"
 
     }                 *local_interfaces;
 
-    uint8_t              network_devices_nr;
+    uint16_t             network_devices_nr;
 
     struct _networkDevice
     {
             uint32_t                                      update_timestamp;
 
+            uint32_t                                      generation;
+                                                          // Incremented every
+                                                          // time the contents
+                                                          // of this entry
+                                                          // change
+
+            struct timerWheelTimer                        expiry_timer;
+                                                          // Fires "GC_MAX_AGE"
+                                                          // seconds after the
+                                                          // last update
+
+            uint16_t                                      position;
+                                                          // Index of this
+                                                          // entry in
+                                                          // "network_devices"
+
+            uint8_t                                       gc_candidate;
+                                                          // '1' if this entry
+                                                          // is already in
+                                                          // "gc_candidates"
+
             struct deviceInformationTypeTLV            *info;
 
             uint8_t                                       bridges_nr;
@@ -135,7 +160,7 @@ struct _dataModel
 
             struct ipv6TypeTLV                         *ipv6;
 
-            uint8_t                                       metrics_with_neighbors_nr;
+            uint16_t                                      metrics_with_neighbors_nr;
             struct _metricsWithNeighbor
             {
                 uint8_t                                       neighbor_al_mac_address[6];
@@ -151,11 +176,222 @@ struct _dataModel
             uint8_t                                       extensions_nr;
             struct vendorSpecificTLV                  **extensions;
 
-    }                 *network_devices;
+    }                **network_devices;
                          // This list will always contain at least ONE entry,
                          // containing the info of the *local* device.
+
+    struct hashTable    *network_devices_index;
+                         // AL MAC (from the "info" TLV) --> "struct
+                         // _networkDevice *"
+
+    struct hashTable    *mac_owners_index;
+                         // AL MAC of a 1905 neighbor or MAC of one of its
+                         // interfaces --> "struct _macOwner *"
+
+    uint16_t                gc_candidates_nr;
+    struct _networkDevice **gc_candidates;
+                         // Devices that *might* have to be removed the next
+                         // time the garbage collector runs (because their
+                         // "expiry_timer" fired or because their AL MAC is no
+                         // longer owned by any neighbor). This way the garbage
+                         // collector does not need to visit all devices.
 } data_model;
 
+// Entries of the "mac_owners_index": the same neighbor (and its interfaces) can
+// be visible from several local interfaces, thus each entry counts how many
+// times it has been inserted and is only removed once all of them are gone.
+//
+struct _macOwner
+{
+    uint8_t   al_mac_address[6];
+    uint32_t  references;
+};
+
+// Register (one more time) that 'mac_address' belongs to the 1905 device with
+// AL MAC 'al_mac_address'.
+//
+static void _macOwnerAdd(uint8_t *mac_address, uint8_t *al_mac_address)
+{
+    struct _macOwner *o;
+
+    if (NULL == (o = (struct _macOwner *)hashTableFind(data_model.mac_owners_index, mac_address)))
+    {
+        o = (struct _macOwner *)memalloc(sizeof(struct _macOwner));
+        o->references = 0;
+        hashTableInsert(data_model.mac_owners_index, mac_address, o);
+    }
+    memcpy(o->al_mac_address, al_mac_address, 6);
+    o->references++;
+}
+
+// Add device 'x' to the list of entries the garbage collector must check the
+// next time it runs. Nothing happens if 'x' is NULL, if it is the local device
+// or if it was already in the list.
+//
+static void _gcCandidateAdd(struct _networkDevice *x)
+{
+    if (NULL == x || x == data_model.network_devices[0] || 1 == x->gc_candidate)
+    {
+        return;
+    }
+
+    if (0 == data_model.gc_candidates_nr)
+    {
+        data_model.gc_candidates = (struct _networkDevice **)memalloc(sizeof(struct _networkDevice *));
+    }
+    else
+    {
+        data_model.gc_candidates = (struct _networkDevice **)memrealloc(data_model.gc_candidates, sizeof(struct _networkDevice *)*(data_model.gc_candidates_nr+1));
+    }
+    data_model.gc_candidates[data_model.gc_candidates_nr++] = x;
+    x->gc_candidate = 1;
+}
+
+// Undo one previous call to "_macOwnerAdd()" for 'mac_address'
+//
+static void _macOwnerRelease(uint8_t *mac_address)
+{
+    struct _macOwner *o;
+
+    if (NULL == (o = (struct _macOwner *)hashTableFind(data_model.mac_owners_index, mac_address)))
+    {
+        return;
+    }
+
+    if (0 == --o->references)
+    {
+        hashTableRemove(data_model.mac_owners_index, mac_address);
+        free(o);
+
+        // If this was the AL MAC of a device, its entry can now be removed
+        //
+        _gcCandidateAdd((struct _networkDevice *)hashTableFind(data_model.network_devices_index, mac_address));
+    }
+}
+
+// Given an 'al_mac_address', return a pointer to the "struct _networkDevice"
+// whose "info" TLV contains that address.
+// Returns NULL if such a device could not be found.
+//
+static struct _networkDevice *_alMacAddressToNetworkDeviceStruct(uint8_t *al_mac_address)
+{
+    return (struct _networkDevice *)hashTableFind(data_model.network_devices_index, al_mac_address);
+}
+
+// Update the "network_devices_index" after the "info" TLV of device 'x' has
+// changed from 'old_info' to 'x->info'
+//
+static void _reindexNetworkDevice(struct _networkDevice *x, struct deviceInformationTypeTLV *old_info)
+{
+    if (NULL != old_info && x == _alMacAddressToNetworkDeviceStruct(old_info->al_mac_address))
+    {
+        hashTableRemove(data_model.network_devices_index, old_info->al_mac_address);
+    }
+    if (NULL != x->info)
+    {
+        hashTableInsert(data_model.network_devices_index, x->info->al_mac_address, x);
+    }
+}
+
+// Callback of the "expiry_timer" of a device
+//
+static void _networkDeviceExpired(struct timerWheelTimer *timer, void *data)
+{
+    _gcCandidateAdd((struct _networkDevice *)data);
+}
+
+// Return a new "struct _networkDevice" with all its fields empty
+//
+static struct _networkDevice *_newNetworkDevice(void)
+{
+    struct _networkDevice *x;
+
+    x = (struct _networkDevice *)memalloc(sizeof(struct _networkDevice));
+
+    x->update_timestamp          = PLATFORM_GET_TIMESTAMP();
+    x->generation                = 1;
+    x->info                      = NULL;
+    x->bridges_nr                = 0;
+    x->bridges                   = NULL;
+    x->non1905_neighbors_nr      = 0;
+    x->non1905_neighbors         = NULL;
+    x->x1905_neighbors_nr        = 0;
+    x->x1905_neighbors           = NULL;
+    x->power_off_nr              = 0;
+    x->power_off                 = NULL;
+    x->l2_neighbors_nr           = 0;
+    x->l2_neighbors              = NULL;
+    x->supported_service         = NULL;
+    x->generic_phy               = NULL;
+    x->profile                   = NULL;
+    x->identification            = NULL;
+    x->control_url               = NULL;
+    x->ipv4                      = NULL;
+    x->ipv6                      = NULL;
+    x->metrics_with_neighbors_nr = 0;
+    x->metrics_with_neighbors    = NULL;
+    x->extensions                = NULL;
+    x->extensions_nr             = 0;
+    x->position                  = 0;
+    x->gc_candidate              = 0;
+
+    timerWheelSetup(&x->expiry_timer, _networkDeviceExpired, x);
+
+    return x;
+}
+
+// Return '1' if TLV structures 'a' and 'b' contain the same data (or are both
+// NULL), '0' otherwise
+//
+static uint8_t _sameTLV(uint8_t *a, uint8_t *b)
+{
+    if (NULL == a || NULL == b)
+    {
+        return a == b ? 1 : 0;
+    }
+
+    return 0 == compare_1905_TLV_structures(a, b) ? 1 : 0;
+}
+
+// Return '1' if the list of 'a_nr' TLV structures 'a' contains the same TLVs
+// (in the same order) as the list of 'b_nr' TLV structures 'b', '0' otherwise
+//
+static uint8_t _sameTLVList(uint8_t **a, uint8_t a_nr, uint8_t **b, uint8_t b_nr)
+{
+    uint8_t i;
+
+    if (a_nr != b_nr)
+    {
+        return 0;
+    }
+
+    for (i=0; i<a_nr; i++)
+    {
+        if (0 == _sameTLV(a[i], b[i]))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Free a list of 'nr' TLV structures (and the list itself)
+//
+static void _freeTLVList(uint8_t **list, uint8_t nr)
+{
+    uint8_t i;
+
+    for (i=0; i<nr; i++)
+    {
+        free_1905_TLV_structure(list[i]);
+    }
+    if (NULL != list)
+    {
+        free(list);
+    }
+}
+
 
 // Given a 'mac_address', return a pointer to the "struct _localInterface" that
 // represents the local interface with that address.
@@ -212,8 +448,6 @@ struct _localInterface *_nameToLocalInterfaceStruct(char *name)
 //
 struct _neighbor *_alMacAddressToNeighborStruct(char *local_interface_name, uint8_t *al_mac_address)
 {
-    uint8_t i;
-
     struct _localInterface *x;
 
     if (NULL == (x = _nameToLocalInterfaceStruct(local_interface_name)))
@@ -223,20 +457,9 @@ struct _neighbor *_alMacAddressToNeighborStruct(char *local_interface_name, uint
         return NULL;
     }
 
-    if (NULL != al_mac_address)
-    {
-        for (i=0; i<x->neighbors_nr; i++)
-        {
-            if (0 == memcmp(x->neighbors[i].al_mac_address, al_mac_address, 6))
-            {
-                return &x->neighbors[i];
-            }
-        }
-    }
-
-    // Not found!
+    // NULL if not found
     //
-    return NULL;
+    return (struct _neighbor *)hashTableFind(x->neighbors_index, al_mac_address);
 }
 
 // Given a 'mac_address', return a pointer to the "struct _remoteInterface" that
@@ -247,7 +470,7 @@ struct _neighbor *_alMacAddressToNeighborStruct(char *local_interface_name, uint
 //
 struct _remoteInterface *_macAddressToRemoteInterfaceStruct(char *local_interface_name, uint8_t *neighbor_al_mac_address, uint8_t *mac_address)
 {
-    uint8_t i;
+    uint16_t i;
 
     struct _neighbor *x;
 
@@ -300,19 +523,29 @@ uint8_t _insertNeighbor(char *local_interface_name, uint8_t *al_mac_address)
         return 2;
     }
 
+    if (0xffff == x->neighbors_nr)
+    {
+        return 0;
+    }
+
     if (0 == x->neighbors_nr)
     {
-        x->neighbors = (struct _neighbor *)memalloc(sizeof (struct _neighbor));
+        x->neighbors = (struct _neighbor **)memalloc(sizeof (struct _neighbor *));
 
     }
     else
     {
-        x->neighbors = (struct _neighbor *)memrealloc(x->neighbors, sizeof (struct _neighbor) * (x->neighbors_nr + 1));
+        x->neighbors = (struct _neighbor **)memrealloc(x->neighbors, sizeof (struct _neighbor *) * (x->neighbors_nr + 1));
     }
 
-    memcpy(x->neighbors[x->neighbors_nr].al_mac_address,        al_mac_address, 6);
-                    x->neighbors[x->neighbors_nr].remote_interfaces_nr = 0;
-                    x->neighbors[x->neighbors_nr].remote_interfaces    = NULL;
+    x->neighbors[x->neighbors_nr] = (struct _neighbor *)memalloc(sizeof (struct _neighbor));
+
+    memcpy(x->neighbors[x->neighbors_nr]->al_mac_address,        al_mac_address, 6);
+                    x->neighbors[x->neighbors_nr]->remote_interfaces_nr = 0;
+                    x->neighbors[x->neighbors_nr]->remote_interfaces    = NULL;
+
+    hashTableInsert(x->neighbors_index, al_mac_address, x->neighbors[x->neighbors_nr]);
+    _macOwnerAdd(al_mac_address, al_mac_address);
 
     x->neighbors_nr++;
 
@@ -345,6 +578,11 @@ uint8_t _insertNeighborInterface(char *local_interface_name, uint8_t *neighbor_a
         return 2;
     }
 
+    if (0xffff == x->remote_interfaces_nr)
+    {
+        return 0;
+    }
+
     if (0 == x->remote_interfaces_nr)
     {
         x->remote_interfaces    = (struct _remoteInterface *)memalloc(sizeof (struct _remoteInterface));
@@ -360,9 +598,87 @@ uint8_t _insertNeighborInterface(char *local_interface_name, uint8_t *neighbor_a
 
     x->remote_interfaces_nr++;
 
+    _macOwnerAdd(mac_address, neighbor_al_mac_address);
+
     return 1;
 }
 
+// Return '1' if 'mac_address' belongs to the local device or to one of its
+// 1905 neighbors, '0' otherwise (this is the same as checking whether
+// "DMmacToAlMac()" would return NULL, without allocating anything)
+//
+static uint8_t _macHasOwner(uint8_t *mac_address)
+{
+    if (
+         0    == memcmp(data_model.al_mac_address, mac_address, 6)          ||
+         NULL != _macAddressToLocalInterfaceStruct(mac_address)              ||
+         NULL != hashTableFind(data_model.mac_owners_index, mac_address)
+       )
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+// Must be called each time the "update_timestamp" of device 'x' changes: it
+// (re)starts its "expiry_timer" and, if its AL MAC is not owned by anyone,
+// schedules it for removal right away.
+//
+static void _touchNetworkDevice(struct _networkDevice *x)
+{
+    if (x == data_model.network_devices[0])
+    {
+        // The local device never expires
+        //
+        return;
+    }
+
+    // Add one extra tick so that, when the timer fires, the entry is already
+    // older than "GC_MAX_AGE" seconds
+    //
+    timerWheelArm(&x->expiry_timer, GC_MAX_AGE*1000 + TIMER_WHEEL_TICK_MS, 0);
+
+    if (NULL != x->info && 0 == _macHasOwner(x->info->al_mac_address))
+    {
+        _gcCandidateAdd(x);
+    }
+}
+
+// Return '1' if device 'x' must be removed by the garbage collector, '0'
+// otherwise
+//
+static uint8_t _networkDeviceIsGarbage(struct _networkDevice *x)
+{
+    uint32_t age;
+
+    age = PLATFORM_GET_TIMESTAMP() - x->update_timestamp;
+
+    if (age > GC_MAX_AGE*1000)
+    {
+        // Entry too old
+        //
+        return 1;
+    }
+
+    if (NULL != x->info && 0 == _macHasOwner(x->info->al_mac_address))
+    {
+        // MAC address no longer registered in the "topology discovery"
+        // database
+        //
+        return 1;
+    }
+
+    // Still alive. Make sure it will be checked again once it expires.
+    //
+    if (0 == timerWheelIsArmed(&x->expiry_timer))
+    {
+        timerWheelArm(&x->expiry_timer, GC_MAX_AGE*1000 - age + TIMER_WHEEL_TICK_MS, 0);
+    }
+
+    return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // API functions (only available to the 1905 core itself, ie. files inside the
 // 'lib1905' folder)
@@ -389,34 +705,18 @@ void DMinit()
     data_model.local_interfaces_nr      = 0;
     data_model.local_interfaces         = NULL;
 
+    data_model.network_devices_index    = hashTableCreate(6, 0);
+    data_model.mac_owners_index         = hashTableCreate(6, 0);
+
+    data_model.gc_candidates_nr         = 0;
+    data_model.gc_candidates            = NULL;
+
     // Regarding the "network_devices" list, we will init it with one element,
     // representing the local node
     //
     data_model.network_devices_nr       = 1;
-    data_model.network_devices          = (struct _networkDevice *)memalloc(sizeof(struct _networkDevice));
-
-    data_model.network_devices[0].update_timestamp          = PLATFORM_GET_TIMESTAMP();
-    data_model.network_devices[0].info                      = NULL;
-    data_model.network_devices[0].bridges_nr                = 0;
-    data_model.network_devices[0].bridges                   = NULL;
-    data_model.network_devices[0].non1905_neighbors_nr      = 0;
-    data_model.network_devices[0].non1905_neighbors         = NULL;
-    data_model.network_devices[0].x1905_neighbors_nr        = 0;
-    data_model.network_devices[0].x1905_neighbors           = NULL;
-    data_model.network_devices[0].power_off_nr              = 0;
-    data_model.network_devices[0].power_off                 = NULL;
-    data_model.network_devices[0].l2_neighbors_nr           = 0;
-    data_model.network_devices[0].l2_neighbors              = NULL;
-    data_model.network_devices[0].generic_phy               = NULL;
-    data_model.network_devices[0].profile                   = NULL;
-    data_model.network_devices[0].identification            = NULL;
-    data_model.network_devices[0].control_url               = NULL;
-    data_model.network_devices[0].ipv4                      = NULL;
-    data_model.network_devices[0].ipv6                      = NULL;
-    data_model.network_devices[0].metrics_with_neighbors_nr = 0;
-    data_model.network_devices[0].metrics_with_neighbors    = NULL;
-    data_model.network_devices[0].extensions                = NULL;
-    data_model.network_devices[0].extensions_nr             = 0;
+    data_model.network_devices          = (struct _networkDevice **)memalloc(sizeof(struct _networkDevice *));
+    data_model.network_devices[0]       = _newNetworkDevice();
 
     return;
 }
@@ -500,6 +800,7 @@ uint8_t DMinsertInterface(char *name, uint8_t *mac_address)
     memcpy(data_model.local_interfaces[data_model.local_interfaces_nr].mac_address,   mac_address, 6);
                     data_model.local_interfaces[data_model.local_interfaces_nr].neighbors    = NULL;
                     data_model.local_interfaces[data_model.local_interfaces_nr].neighbors_nr = 0;
+                    data_model.local_interfaces[data_model.local_interfaces_nr].neighbors_index = hashTableCreate(6, 0);
 
     data_model.local_interfaces_nr++;
 
@@ -546,9 +847,9 @@ uint8_t *DMinterfaceNameToMac(char *interface_name)
 }
 
 
-uint8_t (*DMgetListOfInterfaceNeighbors(char *local_interface_name, uint8_t *al_mac_addresses_nr))[6]
+uint8_t (*DMgetListOfInterfaceNeighbors(char *local_interface_name, uint16_t *al_mac_addresses_nr))[6]
 {
-    uint8_t i;
+    uint16_t i;
     uint8_t (*ret)[6];
 
     struct _localInterface *x;
@@ -571,25 +872,28 @@ uint8_t (*DMgetListOfInterfaceNeighbors(char *local_interface_name, uint8_t *al_
 
     for (i=0; i<x->neighbors_nr; i++)
     {
-        ret[i][0] = x->neighbors[i].al_mac_address[0];
-        ret[i][1] = x->neighbors[i].al_mac_address[1];
-        ret[i][2] = x->neighbors[i].al_mac_address[2];
-        ret[i][3] = x->neighbors[i].al_mac_address[3];
-        ret[i][4] = x->neighbors[i].al_mac_address[4];
-        ret[i][5] = x->neighbors[i].al_mac_address[5];
+        ret[i][0] = x->neighbors[i]->al_mac_address[0];
+        ret[i][1] = x->neighbors[i]->al_mac_address[1];
+        ret[i][2] = x->neighbors[i]->al_mac_address[2];
+        ret[i][3] = x->neighbors[i]->al_mac_address[3];
+        ret[i][4] = x->neighbors[i]->al_mac_address[4];
+        ret[i][5] = x->neighbors[i]->al_mac_address[5];
     }
 
     *al_mac_addresses_nr = x->neighbors_nr;
     return ret;
 }
 
-uint8_t (*DMgetListOfNeighbors(uint8_t *al_mac_addresses_nr))[6]
+uint8_t (*DMgetListOfNeighbors(uint16_t *al_mac_addresses_nr))[6]
 {
-    uint8_t i, j, k;
+    uint8_t  i;
+    uint16_t j;
 
-    uint8_t total;
+    uint16_t total;
     uint8_t (*ret)[6];
 
+    struct hashTable *already_present;
+
     if (NULL == al_mac_addresses_nr)
     {
         return NULL;
@@ -598,25 +902,20 @@ uint8_t (*DMgetListOfNeighbors(uint8_t *al_mac_addresses_nr))[6]
     total = 0;
     ret   = NULL;
 
+    // The same neighbor can be visible from several interfaces. This table is
+    // used to only report it once.
+    //
+    already_present = hashTableCreate(6, 0);
+
     for (i=0; i<data_model.local_interfaces_nr; i++)
     {
         for (j=0; j<data_model.local_interfaces[i].neighbors_nr; j++)
         {
-            // Check for duplicates
-            //
-            uint8_t already_present;
+            uint8_t *al_mac_address;
 
-            already_present = 0;
-            for (k=0; k<total; k++)
-            {
-                if (0 == memcmp(&ret[k], data_model.local_interfaces[i].neighbors[j].al_mac_address, 6))
-                {
-                    already_present = 1;
-                    break;
-                }
-            }
+            al_mac_address = data_model.local_interfaces[i].neighbors[j]->al_mac_address;
 
-            if (1 == already_present)
+            if (2 == hashTableInsert(already_present, al_mac_address, al_mac_address))
             {
                 continue;
             }
@@ -632,12 +931,14 @@ uint8_t (*DMgetListOfNeighbors(uint8_t *al_mac_addresses_nr))[6]
             {
                 ret = (uint8_t (*)[6])memrealloc(ret, sizeof(uint8_t[6])*(total + 1));
             }
-            memcpy(&ret[total], data_model.local_interfaces[i].neighbors[j].al_mac_address, 6);
+            memcpy(&ret[total], al_mac_address, 6);
 
             total++;
         }
     }
 
+    hashTableDestroy(already_present);
+
     *al_mac_addresses_nr = total;
 
     return ret;
@@ -645,48 +946,47 @@ uint8_t (*DMgetListOfNeighbors(uint8_t *al_mac_addresses_nr))[6]
 
 uint8_t (*DMgetListOfLinksWithNeighbor(uint8_t *neighbor_al_mac_address, char ***interfaces, uint8_t *links_nr))[6]
 {
-    uint8_t i, j, k;
-    uint8_t total;
+    uint8_t  i;
+    uint16_t k;
+    uint8_t  total;
 
     uint8_t (*ret)[6];
     char  **intfs;
 
+    struct _neighbor *x;
+
     total = 0;
     ret   = NULL;
     intfs = NULL;
 
     for (i=0; i<data_model.local_interfaces_nr; i++)
     {
-        for (j=0; j<data_model.local_interfaces[i].neighbors_nr; j++)
+        // We are just interested in 'neighbor_al_mac_address'
+        //
+        if (NULL == (x = (struct _neighbor *)hashTableFind(data_model.local_interfaces[i].neighbors_index, neighbor_al_mac_address)))
+        {
+            continue;
+        }
+
+        for (k=0; k<x->remote_interfaces_nr && total < 0xff; k++)
         {
-            // Filter neighbor (we are just interested in
-            // 'neighbor_al_mac_address')
+            // This is a new link between the local AL and the remote AL.
+            // Add it.
             //
-            if (0 != memcmp(neighbor_al_mac_address, data_model.local_interfaces[i].neighbors[j].al_mac_address, 6))
+            if (NULL == ret)
             {
-                continue;
+                ret   = (uint8_t (*)[6])memalloc(sizeof(uint8_t[6]));
+                intfs = (char **)memalloc(sizeof(char *));
             }
-
-            for (k=0; k<data_model.local_interfaces[i].neighbors[j].remote_interfaces_nr; k++)
+            else
             {
-                // This is a new link between the local AL and the remote AL.
-                // Add it.
-                //
-                if (NULL == ret)
-                {
-                    ret   = (uint8_t (*)[6])memalloc(sizeof(uint8_t[6]));
-                    intfs = (char **)memalloc(sizeof(char *));
-                }
-                else
-                {
-                    ret   = (uint8_t (*)[6])memrealloc(ret, sizeof(uint8_t[6])*(total + 1));
-                    intfs = (char **)memrealloc(intfs, sizeof(char *)*(total + 1));
-                }
-                memcpy(&ret[total], data_model.local_interfaces[i].neighbors[j].remote_interfaces[k].mac_address, 6);
-                intfs[total] = data_model.local_interfaces[i].name;
-
-                total++;
+                ret   = (uint8_t (*)[6])memrealloc(ret, sizeof(uint8_t[6])*(total + 1));
+                intfs = (char **)memrealloc(intfs, sizeof(char *)*(total + 1));
             }
+            memcpy(&ret[total], x->remote_interfaces[k].mac_address, 6);
+            intfs[total] = data_model.local_interfaces[i].name;
+
+            total++;
         }
     }
 
@@ -866,7 +1166,7 @@ uint8_t DMisNeighborBridged(char *local_interface_name, uint8_t *neighbor_al_mac
 {
     struct _neighbor *x;
 
-    uint8_t i;
+    uint16_t i;
 
     if (NULL == (x = _alMacAddressToNeighborStruct(local_interface_name, neighbor_al_mac_address)))
     {
@@ -896,7 +1196,7 @@ uint8_t DMisInterfaceBridged(char *local_interface_name)
 {
     struct _localInterface *x;
 
-    uint8_t i;
+    uint16_t i;
 
     x = _nameToLocalInterfaceStruct(local_interface_name);
     if (NULL == x)
@@ -907,7 +1207,7 @@ uint8_t DMisInterfaceBridged(char *local_interface_name)
 
     for (i=0; i<x->neighbors_nr; i++)
     {
-        if (1 == DMisNeighborBridged(local_interface_name, x->neighbors[i].al_mac_address))
+        if (1 == DMisNeighborBridged(local_interface_name, x->neighbors[i]->al_mac_address))
         {
             // If at least one neighbor is bridged, then this interface is
             // considered to be bridged.
@@ -926,56 +1226,34 @@ uint8_t DMisInterfaceBridged(char *local_interface_name)
 
 uint8_t *DMmacToAlMac(uint8_t *mac_address)
 {
-    uint8_t i, j, k;
-
     uint8_t *al_mac;
-    uint8_t found;
 
-    found  = 0;
-    al_mac = (uint8_t *)memalloc(sizeof(uint8_t)*6);
+    struct _macOwner *o;
 
     if (0 == memcmp(data_model.al_mac_address, mac_address, 6))
     {
         return data_model.al_mac_address;
     }
-    for (i=0; i<data_model.local_interfaces_nr; i++)
-    {
-        if (0 == memcmp(data_model.local_interfaces[i].mac_address, mac_address, 6))
-        {
-            found = 1;
-            memcpy(al_mac, data_model.al_mac_address, 6);
-        }
 
-        for (j=0; j<data_model.local_interfaces[i].neighbors_nr; j++)
-        {
-            if (0 == memcmp(data_model.local_interfaces[i].neighbors[j].al_mac_address, mac_address, 6))
-            {
-                found = 1;
-                memcpy(al_mac, data_model.local_interfaces[i].neighbors[j].al_mac_address, 6);
-            }
+    if (NULL != _macAddressToLocalInterfaceStruct(mac_address))
+    {
+        al_mac = (uint8_t *)memalloc(sizeof(uint8_t)*6);
+        memcpy(al_mac, data_model.al_mac_address, 6);
 
-            for (k=0; k<data_model.local_interfaces[i].neighbors[j].remote_interfaces_nr; k++)
-            {
-                if (0 == memcmp(data_model.local_interfaces[i].neighbors[j].remote_interfaces[k].mac_address, mac_address, 6))
-                {
-                    found = 1;
-                    memcpy(al_mac, data_model.local_interfaces[i].neighbors[j].al_mac_address, 6);
-                }
-            }
-        }
+        return al_mac;
     }
 
-    if (1 == found)
+    if (NULL != (o = (struct _macOwner *)hashTableFind(data_model.mac_owners_index, mac_address)))
     {
+        al_mac = (uint8_t *)memalloc(sizeof(uint8_t)*6);
+        memcpy(al_mac, o->al_mac_address, 6);
+
         return al_mac;
     }
-    else
-    {
-      // No matching MAC address was found
-      //
-      free(al_mac);
-      return NULL;
-    }
+
+    // No matching MAC address was found
+    //
+    return NULL;
 }
 
 uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
@@ -993,7 +1271,7 @@ uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
                                 uint8_t v4_update,  struct ipv4TypeTLV                          *ipv4,
                                 uint8_t v6_update,  struct ipv6TypeTLV                          *ipv6)
 {
-    uint8_t i,j;
+    struct _networkDevice *x;
 
     if (
          (NULL == al_mac_address)                                                     ||
@@ -1012,220 +1290,309 @@ uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
     //
     if (0 == memcmp(DMalMacGet(), al_mac_address, 6))
     {
-        i=0;
+        x = data_model.network_devices[0];
     }
     else
     {
-        for (i=1; i<data_model.network_devices_nr; i++)
-        {
-            if (NULL != data_model.network_devices[i].info)
-            {
-                if (0 == memcmp(data_model.network_devices[i].info->al_mac_address, al_mac_address, 6))
-                {
-                    break;
-                }
-            }
-        }
+        x = _alMacAddressToNetworkDeviceStruct(al_mac_address);
     }
 
-    if (i == data_model.network_devices_nr)
+    if (NULL == x)
     {
         // A matching entry was *not* found. Create a new one, but only if this
         // new information contains the "info" TLV (otherwise don't do anything
         // and wait for the "info" TLV to be received in the future)
         //
-        if (1 == in_update && NULL != info)
+        if (1 == in_update && NULL != info && 0xffff != data_model.network_devices_nr)
         {
             if (0 == data_model.network_devices_nr)
             {
-                data_model.network_devices = (struct _networkDevice *)memalloc(sizeof(struct _networkDevice));
+                data_model.network_devices = (struct _networkDevice **)memalloc(sizeof(struct _networkDevice *));
             }
             else
             {
-                data_model.network_devices = (struct _networkDevice *)memrealloc(data_model.network_devices, sizeof(struct _networkDevice)*(data_model.network_devices_nr+1));
-            }
-
-            data_model.network_devices[data_model.network_devices_nr].update_timestamp          = PLATFORM_GET_TIMESTAMP();
-            data_model.network_devices[data_model.network_devices_nr].info                      = 1 == in_update ? info                 : NULL;
-            data_model.network_devices[data_model.network_devices_nr].bridges_nr                = 1 == br_update ? bridges_nr           : 0;
-            data_model.network_devices[data_model.network_devices_nr].bridges                   = 1 == br_update ? bridges              : NULL;
-            data_model.network_devices[data_model.network_devices_nr].non1905_neighbors_nr      = 1 == no_update ? non1905_neighbors_nr : 0;
-            data_model.network_devices[data_model.network_devices_nr].non1905_neighbors         = 1 == no_update ? non1905_neighbors    : NULL;
-            data_model.network_devices[data_model.network_devices_nr].x1905_neighbors_nr        = 1 == x1_update ? x1905_neighbors_nr   : 0;
-            data_model.network_devices[data_model.network_devices_nr].x1905_neighbors           = 1 == x1_update ? x1905_neighbors      : NULL;
-            data_model.network_devices[data_model.network_devices_nr].power_off_nr              = 1 == po_update ? power_off_nr         : 0;
-            data_model.network_devices[data_model.network_devices_nr].power_off                 = 1 == po_update ? power_off            : NULL;
-            data_model.network_devices[data_model.network_devices_nr].l2_neighbors_nr           = 1 == l2_update ? l2_neighbors_nr      : 0;
-            data_model.network_devices[data_model.network_devices_nr].l2_neighbors              = 1 == l2_update ? l2_neighbors         : NULL;
-            data_model.network_devices[data_model.network_devices_nr].supported_service         = 1 == ss_update ? supported_service    : NULL;
-            data_model.network_devices[data_model.network_devices_nr].generic_phy               = 1 == ge_update ? generic_phy          : NULL;
-            data_model.network_devices[data_model.network_devices_nr].profile                   = 1 == pr_update ? profile              : NULL;
-            data_model.network_devices[data_model.network_devices_nr].identification            = 1 == id_update ? identification       : NULL;
-            data_model.network_devices[data_model.network_devices_nr].control_url               = 1 == co_update ? control_url          : NULL;
-            data_model.network_devices[data_model.network_devices_nr].ipv4                      = 1 == v4_update ? ipv4                 : NULL;
-            data_model.network_devices[data_model.network_devices_nr].ipv6                      = 1 == v6_update ? ipv6                 : NULL;
-
-            data_model.network_devices[data_model.network_devices_nr].metrics_with_neighbors_nr = 0;
-            data_model.network_devices[data_model.network_devices_nr].metrics_with_neighbors    = NULL;
-
-            data_model.network_devices[data_model.network_devices_nr].extensions                = NULL;
-            data_model.network_devices[data_model.network_devices_nr].extensions_nr             = 0;
+                data_model.network_devices = (struct _networkDevice **)memrealloc(data_model.network_devices, sizeof(struct _networkDevice *)*(data_model.network_devices_nr+1));
+            }
 
+            x = _newNetworkDevice();
+
+            x->info                      = 1 == in_update ? info                 : NULL;
+            x->bridges_nr                = 1 == br_update ? bridges_nr           : 0;
+            x->bridges                   = 1 == br_update ? bridges              : NULL;
+            x->non1905_neighbors_nr      = 1 == no_update ? non1905_neighbors_nr : 0;
+            x->non1905_neighbors         = 1 == no_update ? non1905_neighbors    : NULL;
+            x->x1905_neighbors_nr        = 1 == x1_update ? x1905_neighbors_nr   : 0;
+            x->x1905_neighbors           = 1 == x1_update ? x1905_neighbors      : NULL;
+            x->power_off_nr              = 1 == po_update ? power_off_nr         : 0;
+            x->power_off                 = 1 == po_update ? power_off            : NULL;
+            x->l2_neighbors_nr           = 1 == l2_update ? l2_neighbors_nr      : 0;
+            x->l2_neighbors              = 1 == l2_update ? l2_neighbors         : NULL;
+            x->supported_service         = 1 == ss_update ? supported_service    : NULL;
+            x->generic_phy               = 1 == ge_update ? generic_phy          : NULL;
+            x->profile                   = 1 == pr_update ? profile              : NULL;
+            x->identification            = 1 == id_update ? identification       : NULL;
+            x->control_url               = 1 == co_update ? control_url          : NULL;
+            x->ipv4                      = 1 == v4_update ? ipv4                 : NULL;
+            x->ipv6                      = 1 == v6_update ? ipv6                 : NULL;
+
+            x->position = data_model.network_devices_nr;
+
+            data_model.network_devices[data_model.network_devices_nr] = x;
             data_model.network_devices_nr++;
+
+            _reindexNetworkDevice(x, NULL);
+            _touchNetworkDevice(x);
         }
     }
     else
     {
-        // A matching entry was found. Update it. But first, free the old TLV
-        // structures (but only if a new value was provided!... otherwise retain
-        // the old item)
+        // A matching entry was found. Update it (but only the items for which
+        // a new value was provided!... otherwise retain the old item).
         //
-        data_model.network_devices[i].update_timestamp = PLATFORM_GET_TIMESTAMP();
+        // New values are compared against the stored ones: if they contain
+        // the same data, the new TLVs are freed and the old ones are kept (so
+        // that pointers to them remain valid and the entry 'generation' does
+        // not change).
+        //
+        uint8_t changed = 0;
+
+        x->update_timestamp = PLATFORM_GET_TIMESTAMP();
 
         if (NULL != info)
         {
-            if (NULL != data_model.network_devices[i].info)
+            if (1 == _sameTLV((uint8_t *)x->info, (uint8_t *)info))
             {
-                free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].info);
+                free_1905_TLV_structure((uint8_t *)info);
+            }
+            else
+            {
+                struct deviceInformationTypeTLV *old_info;
+
+                old_info = x->info;
+                x->info  = info;
+
+                _reindexNetworkDevice(x, old_info);
+
+                if (NULL != old_info)
+                {
+                    free_1905_TLV_structure((uint8_t *)old_info);
+                }
+                changed = 1;
             }
-            data_model.network_devices[i].info = info;
         }
 
         if (1 == br_update)
         {
-            for (j=0; j<data_model.network_devices[i].bridges_nr; j++)
+            if (1 == _sameTLVList((uint8_t **)x->bridges, x->bridges_nr, (uint8_t **)bridges, bridges_nr))
             {
-                free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].bridges[j]);
+                _freeTLVList((uint8_t **)bridges, bridges_nr);
             }
-            if (data_model.network_devices[i].bridges_nr > 0 && NULL != data_model.network_devices[i].bridges)
+            else
             {
-                free(data_model.network_devices[i].bridges);
+                _freeTLVList((uint8_t **)x->bridges, x->bridges_nr);
+                x->bridges_nr = bridges_nr;
+                x->bridges    = bridges;
+                changed = 1;
             }
-            data_model.network_devices[i].bridges_nr = bridges_nr;
-            data_model.network_devices[i].bridges    = bridges;
         }
 
         if (1 == no_update)
         {
-            for (j=0; j<data_model.network_devices[i].non1905_neighbors_nr; j++)
+            if (1 == _sameTLVList((uint8_t **)x->non1905_neighbors, x->non1905_neighbors_nr, (uint8_t **)non1905_neighbors, non1905_neighbors_nr))
             {
-                free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].non1905_neighbors[j]);
+                _freeTLVList((uint8_t **)non1905_neighbors, non1905_neighbors_nr);
             }
-            if (data_model.network_devices[i].non1905_neighbors_nr > 0 && NULL != data_model.network_devices[i].non1905_neighbors)
+            else
             {
-                free(data_model.network_devices[i].non1905_neighbors);
+                _freeTLVList((uint8_t **)x->non1905_neighbors, x->non1905_neighbors_nr);
+                x->non1905_neighbors_nr = non1905_neighbors_nr;
+                x->non1905_neighbors    = non1905_neighbors;
+                changed = 1;
             }
-            data_model.network_devices[i].non1905_neighbors_nr = non1905_neighbors_nr;
-            data_model.network_devices[i].non1905_neighbors    = non1905_neighbors;
         }
 
         if (1 == x1_update)
         {
-            for (j=0; j<data_model.network_devices[i].x1905_neighbors_nr; j++)
+            if (1 == _sameTLVList((uint8_t **)x->x1905_neighbors, x->x1905_neighbors_nr, (uint8_t **)x1905_neighbors, x1905_neighbors_nr))
             {
-                free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].x1905_neighbors[j]);
+                _freeTLVList((uint8_t **)x1905_neighbors, x1905_neighbors_nr);
             }
-            if (data_model.network_devices[i].x1905_neighbors_nr > 0 && NULL != data_model.network_devices[i].x1905_neighbors)
+            else
             {
-                free(data_model.network_devices[i].x1905_neighbors);
+                _freeTLVList((uint8_t **)x->x1905_neighbors, x->x1905_neighbors_nr);
+                x->x1905_neighbors_nr = x1905_neighbors_nr;
+                x->x1905_neighbors    = x1905_neighbors;
+                changed = 1;
             }
-            data_model.network_devices[i].x1905_neighbors_nr = x1905_neighbors_nr;
-            data_model.network_devices[i].x1905_neighbors    = x1905_neighbors;
         }
 
         if (1 == po_update)
         {
-            for (j=0; j<data_model.network_devices[i].power_off_nr; j++)
+            if (1 == _sameTLVList((uint8_t **)x->power_off, x->power_off_nr, (uint8_t **)power_off, power_off_nr))
             {
-                free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].power_off[j]);
+                _freeTLVList((uint8_t **)power_off, power_off_nr);
             }
-            if (data_model.network_devices[i].power_off_nr > 0 && NULL != data_model.network_devices[i].power_off)
+            else
             {
-                free(data_model.network_devices[i].power_off);
+                _freeTLVList((uint8_t **)x->power_off, x->power_off_nr);
+                x->power_off_nr = power_off_nr;
+                x->power_off    = power_off;
+                changed = 1;
             }
-            data_model.network_devices[i].power_off_nr = power_off_nr;
-            data_model.network_devices[i].power_off    = power_off;
         }
 
         if (1 == l2_update)
         {
-            for (j=0; j<data_model.network_devices[i].l2_neighbors_nr; j++)
+            if (1 == _sameTLVList((uint8_t **)x->l2_neighbors, x->l2_neighbors_nr, (uint8_t **)l2_neighbors, l2_neighbors_nr))
             {
-                free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].l2_neighbors[j]);
+                _freeTLVList((uint8_t **)l2_neighbors, l2_neighbors_nr);
             }
-            if (data_model.network_devices[i].l2_neighbors_nr > 0 && NULL != data_model.network_devices[i].l2_neighbors)
+            else
             {
-                free(data_model.network_devices[i].l2_neighbors);
+                _freeTLVList((uint8_t **)x->l2_neighbors, x->l2_neighbors_nr);
+                x->l2_neighbors_nr = l2_neighbors_nr;
+                x->l2_neighbors    = l2_neighbors;
+                changed = 1;
             }
-            data_model.network_devices[i].l2_neighbors_nr = l2_neighbors_nr;
-            data_model.network_devices[i].l2_neighbors    = l2_neighbors;
         }
 
         if (1 == ss_update)
         {
-            free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].supported_service);
-            data_model.network_devices[i].supported_service = supported_service;
+            if (1 == _sameTLV((uint8_t *)x->supported_service, (uint8_t *)supported_service))
+            {
+                free_1905_TLV_structure((uint8_t *)supported_service);
+            }
+            else
+            {
+                free_1905_TLV_structure((uint8_t *)x->supported_service);
+                x->supported_service = supported_service;
+                changed = 1;
+            }
         }
 
         if (1 == ge_update)
         {
-            free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].generic_phy);
-            data_model.network_devices[i].generic_phy = generic_phy;
+            if (1 == _sameTLV((uint8_t *)x->generic_phy, (uint8_t *)generic_phy))
+            {
+                free_1905_TLV_structure((uint8_t *)generic_phy);
+            }
+            else
+            {
+                free_1905_TLV_structure((uint8_t *)x->generic_phy);
+                x->generic_phy = generic_phy;
+                changed = 1;
+            }
         }
 
         if (1 == pr_update)
         {
-            free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].profile);
-            data_model.network_devices[i].profile = profile;
+            if (1 == _sameTLV((uint8_t *)x->profile, (uint8_t *)profile))
+            {
+                free_1905_TLV_structure((uint8_t *)profile);
+            }
+            else
+            {
+                free_1905_TLV_structure((uint8_t *)x->profile);
+                x->profile = profile;
+                changed = 1;
+            }
         }
 
         if (1 == id_update)
         {
-            free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].identification);
-            data_model.network_devices[i].identification = identification;
+            if (1 == _sameTLV((uint8_t *)x->identification, (uint8_t *)identification))
+            {
+                free_1905_TLV_structure((uint8_t *)identification);
+            }
+            else
+            {
+                free_1905_TLV_structure((uint8_t *)x->identification);
+                x->identification = identification;
+                changed = 1;
+            }
         }
 
         if (1 == co_update)
         {
-            free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].control_url);
-            data_model.network_devices[i].control_url = control_url;
+            if (1 == _sameTLV((uint8_t *)x->control_url, (uint8_t *)control_url))
+            {
+                free_1905_TLV_structure((uint8_t *)control_url);
+            }
+            else
+            {
+                free_1905_TLV_structure((uint8_t *)x->control_url);
+                x->control_url = control_url;
+                changed = 1;
+            }
         }
 
         if (1 == v4_update)
         {
-            free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].ipv4);
-            data_model.network_devices[i].ipv4 = ipv4;
+            if (1 == _sameTLV((uint8_t *)x->ipv4, (uint8_t *)ipv4))
+            {
+                free_1905_TLV_structure((uint8_t *)ipv4);
+            }
+            else
+            {
+                free_1905_TLV_structure((uint8_t *)x->ipv4);
+                x->ipv4 = ipv4;
+                changed = 1;
+            }
         }
 
         if (1 == v6_update)
         {
-            free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].ipv6);
-            data_model.network_devices[i].ipv6 = ipv6;
+            if (1 == _sameTLV((uint8_t *)x->ipv6, (uint8_t *)ipv6))
+            {
+                free_1905_TLV_structure((uint8_t *)ipv6);
+            }
+            else
+            {
+                free_1905_TLV_structure((uint8_t *)x->ipv6);
+                x->ipv6 = ipv6;
+                changed = 1;
+            }
         }
 
+        if (1 == changed)
+        {
+            x->generation++;
+        }
+
+        _touchNetworkDevice(x);
     }
 
     return 1;
 }
 
-uint8_t DMnetworkDeviceInfoNeedsUpdate(uint8_t *al_mac_address)
+uint32_t DMnetworkDeviceGeneration(uint8_t *al_mac_address)
 {
-    uint8_t i;
+    struct _networkDevice *x;
 
-    // First, search for an existing entry with the same AL MAC address
-    //
-    for (i=0; i<data_model.network_devices_nr; i++)
+    if (NULL == al_mac_address)
     {
-        if (NULL != data_model.network_devices[i].info)
-        {
-            if (0 == memcmp(data_model.network_devices[i].info->al_mac_address, al_mac_address, 6))
-            {
-                break;
-            }
-        }
+        return 0;
+    }
+
+    if (0 == memcmp(DMalMacGet(), al_mac_address, 6))
+    {
+        x = data_model.network_devices[0];
+    }
+    else
+    {
+        x = _alMacAddressToNetworkDeviceStruct(al_mac_address);
     }
 
-    if (i == data_model.network_devices_nr)
+    return NULL == x ? 0 : x->generation;
+}
+
+uint8_t DMnetworkDeviceInfoNeedsUpdate(uint8_t *al_mac_address)
+{
+    struct _networkDevice *x;
+
+    // First, search for an existing entry with the same AL MAC address
+    //
+    if (NULL == (x = _alMacAddressToNetworkDeviceStruct(al_mac_address)))
     {
         // A matching entry was *not* found. Thus a refresh of the information
         // is needed.
@@ -1236,7 +1603,7 @@ uint8_t DMnetworkDeviceInfoNeedsUpdate(uint8_t *al_mac_address)
     {
         // A matching entry was found. Check its timestamp.
         //
-        if (PLATFORM_GET_TIMESTAMP() - data_model.network_devices[i].update_timestamp > MAX_AGE * 1000)
+        if (PLATFORM_GET_TIMESTAMP() - x->update_timestamp > MAX_AGE * 1000)
         {
             return 1;
         }
@@ -1252,7 +1619,9 @@ uint8_t DMupdateNetworkDeviceMetrics(uint8_t *metrics)
     uint8_t *FROM_al_mac_address;  // Metrics are reported FROM this AL entity...
     uint8_t *TO_al_mac_address;    // ... TO this other one.
 
-    uint8_t i, j;
+    uint16_t j;
+
+    struct _networkDevice *x;
 
     if (NULL == metrics)
     {
@@ -1291,23 +1660,13 @@ uint8_t DMupdateNetworkDeviceMetrics(uint8_t *metrics)
 
     // Next, search for an existing entry with the same AL MAC address
     //
-    for (i=0; i<data_model.network_devices_nr; i++)
-    {
-        if (NULL == data_model.network_devices[i].info)
-        {
-            // We haven't received general info about this device yet.
-            // This can happen, for example, when only metrics have been
-            // received so far.
-            //
-            continue;
-        }
-        if (0 == memcmp(data_model.network_devices[i].info->al_mac_address, FROM_al_mac_address, 6))
-        {
-            break;
-        }
-    }
+    // Note that devices we haven't received general info about yet (which
+    // can happen, for example, when only metrics have been received so far)
+    // are not indexed.
+    //
+    x = _alMacAddressToNetworkDeviceStruct(FROM_al_mac_address);
 
-    if (i == data_model.network_devices_nr)
+    if (NULL == x)
     {
         // A matching entry was *not* found.
         //
@@ -1326,66 +1685,91 @@ uint8_t DMupdateNetworkDeviceMetrics(uint8_t *metrics)
     // new one) search for a sub-entry that matches the AL MAC of the node the
     // metrics are being reported against.
     //
-    for (j=0; j<data_model.network_devices[i].metrics_with_neighbors_nr; j++)
+    for (j=0; j<x->metrics_with_neighbors_nr; j++)
     {
-        if (0 == memcmp(data_model.network_devices[i].metrics_with_neighbors[j].neighbor_al_mac_address, TO_al_mac_address, 6))
+        if (0 == memcmp(x->metrics_with_neighbors[j].neighbor_al_mac_address, TO_al_mac_address, 6))
         {
             break;
         }
     }
 
-    if (j == data_model.network_devices[i].metrics_with_neighbors_nr)
+    if (j == x->metrics_with_neighbors_nr && 0xffff == x->metrics_with_neighbors_nr)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Too many metrics entries for 1905 node (%02x:%02x:%02x:%02x:%02x:%02x). Ignoring data...\n", FROM_al_mac_address[0], FROM_al_mac_address[1], FROM_al_mac_address[2], FROM_al_mac_address[3], FROM_al_mac_address[4], FROM_al_mac_address[5]);
+        return 0;
+    }
+    else if (j == x->metrics_with_neighbors_nr)
     {
         // A matching entry was *not* found. Create a new one
         //
-        if (0 == data_model.network_devices[i].metrics_with_neighbors_nr)
+        if (0 == x->metrics_with_neighbors_nr)
         {
-            data_model.network_devices[i].metrics_with_neighbors = (struct _metricsWithNeighbor *)memalloc(sizeof(struct _metricsWithNeighbor));
+            x->metrics_with_neighbors = (struct _metricsWithNeighbor *)memalloc(sizeof(struct _metricsWithNeighbor));
         }
         else
         {
-            data_model.network_devices[i].metrics_with_neighbors = (struct _metricsWithNeighbor *)memrealloc(data_model.network_devices[i].metrics_with_neighbors, sizeof(struct _metricsWithNeighbor)*(data_model.network_devices[i].metrics_with_neighbors_nr+1));
+            x->metrics_with_neighbors = (struct _metricsWithNeighbor *)memrealloc(x->metrics_with_neighbors, sizeof(struct _metricsWithNeighbor)*(x->metrics_with_neighbors_nr+1));
         }
 
-        memcpy(data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].neighbor_al_mac_address, TO_al_mac_address, 6);
+        memcpy(x->metrics_with_neighbors[x->metrics_with_neighbors_nr].neighbor_al_mac_address, TO_al_mac_address, 6);
 
         if (TLV_TYPE_TRANSMITTER_LINK_METRIC == *metrics)
         {
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].tx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].tx_metrics           = (struct transmitterLinkMetricTLV*)metrics;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].tx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].tx_metrics           = (struct transmitterLinkMetricTLV*)metrics;
 
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].rx_metrics_timestamp = 0;
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].rx_metrics           = NULL;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].rx_metrics_timestamp = 0;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].rx_metrics           = NULL;
         }
         else
         {
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].tx_metrics_timestamp = 0;
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].tx_metrics           = NULL;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].tx_metrics_timestamp = 0;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].tx_metrics           = NULL;
 
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].rx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].rx_metrics           = (struct receiverLinkMetricTLV*)metrics;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].rx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].rx_metrics           = (struct receiverLinkMetricTLV*)metrics;
         }
 
-        data_model.network_devices[i].metrics_with_neighbors_nr++;
+        x->metrics_with_neighbors_nr++;
+        x->generation++;
     }
     else
     {
         // A matching entry was found. Update it. But first, free the old TLV
-        // structures.
+        // structures (or the new one, if it contains the same data as the old
+        // one, which is then kept).
         //
         if (TLV_TYPE_TRANSMITTER_LINK_METRIC == *metrics)
         {
-            free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics);
+            x->metrics_with_neighbors[j].tx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
 
-            data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
-            data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics           = (struct transmitterLinkMetricTLV*)metrics;
+            if (1 == _sameTLV((uint8_t *)x->metrics_with_neighbors[j].tx_metrics, metrics))
+            {
+                free_1905_TLV_structure(metrics);
+            }
+            else
+            {
+                free_1905_TLV_structure((uint8_t *)x->metrics_with_neighbors[j].tx_metrics);
+
+                x->metrics_with_neighbors[j].tx_metrics = (struct transmitterLinkMetricTLV*)metrics;
+                x->generation++;
+            }
         }
         else
         {
-            free_1905_TLV_structure((uint8_t *)data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics);
+            x->metrics_with_neighbors[j].rx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
+
+            if (1 == _sameTLV((uint8_t *)x->metrics_with_neighbors[j].rx_metrics, metrics))
+            {
+                free_1905_TLV_structure(metrics);
+            }
+            else
+            {
+                free_1905_TLV_structure((uint8_t *)x->metrics_with_neighbors[j].rx_metrics);
 
-            data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
-            data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics           = (struct receiverLinkMetricTLV*)metrics;
+                x->metrics_with_neighbors[j].rx_metrics = (struct receiverLinkMetricTLV*)metrics;
+                x->generation++;
+            }
         }
     }
 
@@ -1399,7 +1783,7 @@ void DMdumpNetworkDevices(void (*write_function)(const char *fmt, ...))
     //
     #define MAX_PREFIX  100
 
-    uint8_t  i, j;
+    uint16_t i, j;
 
     write_function("\n");
 
@@ -1411,104 +1795,104 @@ void DMdumpNetworkDevices(void (*write_function)(const char *fmt, ...))
 
         snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        write_function("%supdate timestamp: %d\n", new_prefix, data_model.network_devices[i].update_timestamp);
+        write_function("%supdate timestamp: %d\n", new_prefix, data_model.network_devices[i]->update_timestamp);
 
         snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->general_info->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure((uint8_t* )data_model.network_devices[i].info, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure((uint8_t* )data_model.network_devices[i]->info, print_callback, write_function, new_prefix);
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->bridging_capabilities_nr: %d", i, data_model.network_devices[i].bridges_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->bridging_capabilities_nr: %d", i, data_model.network_devices[i]->bridges_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].bridges_nr; j++)
+        for (j=0; j<data_model.network_devices[i]->bridges_nr; j++)
         {
             snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->bridging_capabilities[%d]->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i].bridges[j], print_callback, write_function, new_prefix);
+            visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i]->bridges[j], print_callback, write_function, new_prefix);
         }
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->non_1905_neighbors_nr: %d", i, data_model.network_devices[i].non1905_neighbors_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->non_1905_neighbors_nr: %d", i, data_model.network_devices[i]->non1905_neighbors_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].non1905_neighbors_nr; j++)
+        for (j=0; j<data_model.network_devices[i]->non1905_neighbors_nr; j++)
         {
             snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->non_1905_neighbors[%d]->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i].non1905_neighbors[j], print_callback, write_function, new_prefix);
+            visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i]->non1905_neighbors[j], print_callback, write_function, new_prefix);
         }
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->x1905_neighbors_nr: %d", i, data_model.network_devices[i].x1905_neighbors_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->x1905_neighbors_nr: %d", i, data_model.network_devices[i]->x1905_neighbors_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].x1905_neighbors_nr; j++)
+        for (j=0; j<data_model.network_devices[i]->x1905_neighbors_nr; j++)
         {
             snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->x1905_neighbors[%d]->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i].x1905_neighbors[j], print_callback, write_function, new_prefix);
+            visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i]->x1905_neighbors[j], print_callback, write_function, new_prefix);
         }
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->power_off_interfaces_nr: %d", i, data_model.network_devices[i].power_off_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->power_off_interfaces_nr: %d", i, data_model.network_devices[i]->power_off_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].power_off_nr; j++)
+        for (j=0; j<data_model.network_devices[i]->power_off_nr; j++)
         {
             snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->power_off_interfaces[%d]->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i].power_off[j], print_callback, write_function, new_prefix);
+            visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i]->power_off[j], print_callback, write_function, new_prefix);
         }
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->l2_neighbors_nr: %d", i, data_model.network_devices[i].l2_neighbors_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->l2_neighbors_nr: %d", i, data_model.network_devices[i]->l2_neighbors_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].l2_neighbors_nr; j++)
+        for (j=0; j<data_model.network_devices[i]->l2_neighbors_nr; j++)
         {
             snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->l2_neighbors[%d]->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i].l2_neighbors[j], print_callback, write_function, new_prefix);
+            visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i]->l2_neighbors[j], print_callback, write_function, new_prefix);
         }
 
         snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->generic_phys->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure((uint8_t* )data_model.network_devices[i].generic_phy, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure((uint8_t* )data_model.network_devices[i]->generic_phy, print_callback, write_function, new_prefix);
 
         snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->profile->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure((uint8_t* )data_model.network_devices[i].profile, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure((uint8_t* )data_model.network_devices[i]->profile, print_callback, write_function, new_prefix);
 
         snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->identification->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure((uint8_t* )data_model.network_devices[i].identification, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure((uint8_t* )data_model.network_devices[i]->identification, print_callback, write_function, new_prefix);
 
         snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->control_url->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i].control_url, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i]->control_url, print_callback, write_function, new_prefix);
 
         snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->ipv4->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i].ipv4, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i]->ipv4, print_callback, write_function, new_prefix);
 
         snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->ipv6->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i].ipv6, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i]->ipv6, print_callback, write_function, new_prefix);
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->metrics_nr: %d", i, data_model.network_devices[i].metrics_with_neighbors_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->metrics_nr: %d", i, data_model.network_devices[i]->metrics_with_neighbors_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].metrics_with_neighbors_nr; j++)
+        for (j=0; j<data_model.network_devices[i]->metrics_with_neighbors_nr; j++)
         {
             snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->metrics[%d]->tx->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            if (NULL != data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics)
+            if (NULL != data_model.network_devices[i]->metrics_with_neighbors[j].tx_metrics)
             {
-                write_function("%slast_updated: %d\n", new_prefix, data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics_timestamp);
-                visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics, print_callback, write_function, new_prefix);
+                write_function("%slast_updated: %d\n", new_prefix, data_model.network_devices[i]->metrics_with_neighbors[j].tx_metrics_timestamp);
+                visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i]->metrics_with_neighbors[j].tx_metrics, print_callback, write_function, new_prefix);
             }
             snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->metrics[%d]->rx->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            if (NULL != data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics)
+            if (NULL != data_model.network_devices[i]->metrics_with_neighbors[j].rx_metrics)
             {
-                write_function("%slast updated: %d\n", new_prefix, data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics_timestamp);
-                visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics, print_callback, write_function, new_prefix);
+                write_function("%slast updated: %d\n", new_prefix, data_model.network_devices[i]->metrics_with_neighbors[j].rx_metrics_timestamp);
+                visit_1905_TLV_structure((uint8_t *)data_model.network_devices[i]->metrics_with_neighbors[j].rx_metrics, print_callback, write_function, new_prefix);
             }
         }
 
@@ -1518,47 +1902,54 @@ void DMdumpNetworkDevices(void (*write_function)(const char *fmt, ...))
         //
         snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        dumpExtendedInfo((uint8_t **)data_model.network_devices[i].extensions, data_model.network_devices[i].extensions_nr, print_callback, write_function, new_prefix);
+        dumpExtendedInfo((uint8_t **)data_model.network_devices[i]->extensions, data_model.network_devices[i]->extensions_nr, print_callback, write_function, new_prefix);
     }
 
     return;
 }
 
-uint8_t DMrunGarbageCollector(void)
+uint16_t DMrunGarbageCollector(void)
 {
-    uint8_t i, j, k;
-    uint8_t removed_entries;
-    uint8_t original_devices_nr;
+    uint16_t i, j, k;
+    uint16_t removed_entries;
+    uint16_t original_devices_nr;
+
+    struct hashTable *removed_al_macs;
 
     removed_entries     = 0;
+    removed_al_macs     = NULL;
 
-    // Visit all existing devices, searching for those with a timestamp older
-    // than GC_MAX_AGE
+    // Instead of visiting all existing devices, only check those that have
+    // been flagged as candidates since the last run: the ones whose
+    // "expiry_timer" fired (ie. not updated in the last GC_MAX_AGE seconds)
+    // and the ones whose AL MAC stopped being owned by any neighbor.
     //
-    // Note that we skip element "0", which is always the local device. We don't
+    // Note that the local device (element "0") is never a candidate. We don't
     // care when it was last updated as it is always updated "on demand", just
     // before someone requests its data (right now the only place where this
     // happens is when using an ALME custom command)
     //
+    // Also note that removing a device can add new candidates to the list,
+    // which is why "gc_candidates_nr" is re-read on each iteration.
+    //
     original_devices_nr = data_model.network_devices_nr;
-    for (i=1; i<data_model.network_devices_nr; i++)
+    for (i=0; i<data_model.gc_candidates_nr; i++)
     {
-        uint8_t *p = NULL;
+        struct _networkDevice *x;
 
-        if (
-             (PLATFORM_GET_TIMESTAMP() - data_model.network_devices[i].update_timestamp > (GC_MAX_AGE*1000)) ||
-             (NULL != data_model.network_devices[i].info && NULL == (p = DMmacToAlMac(data_model.network_devices[i].info->al_mac_address)))
-           )
+        x = data_model.gc_candidates[i];
+        x->gc_candidate = 0;
+
+        if (1 == _networkDeviceIsGarbage(x))
         {
             // Entry too old or with a MAC address no longer registered in the
             // "topology discovery" database. Remove it.
             //
             uint8_t  al_mac_address[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-            struct _networkDevice *x;
 
             removed_entries++;
 
-            x = &data_model.network_devices[i];
+            timerWheelCancel(&x->expiry_timer);
 
             // First, free all child structures
             //
@@ -1568,6 +1959,10 @@ uint8_t DMrunGarbageCollector(void)
                 // later use
                 //
                 memcpy(al_mac_address, x->info->al_mac_address, 6);
+                if (x == _alMacAddressToNetworkDeviceStruct(al_mac_address))
+                {
+                    hashTableRemove(data_model.network_devices_index, al_mac_address);
+                }
 
                 PLATFORM_PRINTF_DEBUG_DETAIL("Removing old device entry (%02x:%02x:%02x:%02x:%02x:%02x)\n", x->info->al_mac_address[0], x->info->al_mac_address[1], x->info->al_mac_address[2], x->info->al_mac_address[3], x->info->al_mac_address[4], x->info->al_mac_address[5]);
                 free_1905_TLV_structure((uint8_t*)x->info);
@@ -1682,7 +2077,7 @@ uint8_t DMrunGarbageCollector(void)
 
             // Next, remove the _networkDevice entry
             //
-            if (i == (data_model.network_devices_nr-1))
+            if (x->position == (data_model.network_devices_nr-1))
             {
                 // Last element. It will automatically be removed below (keep
                 // reading)
@@ -1692,66 +2087,85 @@ uint8_t DMrunGarbageCollector(void)
                 // Place the last element here (we don't care about preserving
                 // order)
                 //
-                data_model.network_devices[i] = data_model.network_devices[data_model.network_devices_nr-1];
-                i--;
+                data_model.network_devices[x->position]           = data_model.network_devices[data_model.network_devices_nr-1];
+                data_model.network_devices[x->position]->position = x->position;
             }
             data_model.network_devices_nr--;
 
-            // Next, Remove all references to this node from other node's
-            // metrics information entries
+            free(x);
+
+            // References to this node from other node's metrics are removed
+            // below, all at once, after all candidates have been processed
             //
-            for (j=0; j<data_model.network_devices_nr; j++)
+            if (NULL == removed_al_macs)
             {
-                uint8_t original_neighbors_nr;
+                removed_al_macs = hashTableCreate(6, 0);
+            }
+            hashTableInsert(removed_al_macs, al_mac_address, removed_al_macs); // Only used as a set
 
-                original_neighbors_nr = data_model.network_devices[j].metrics_with_neighbors_nr;
+            // And also from the local interfaces database
+            //
+            DMremoveALNeighborFromInterface(al_mac_address, "all");
+        }
+    }
 
-                for (k=0; k<data_model.network_devices[j].metrics_with_neighbors_nr; k++)
-                {
-                    if (0 == memcmp(al_mac_address, data_model.network_devices[j].metrics_with_neighbors[k].neighbor_al_mac_address, 6))
-                    {
-                        free_1905_TLV_structure((uint8_t*)data_model.network_devices[j].metrics_with_neighbors[k].tx_metrics);
-                        free_1905_TLV_structure((uint8_t*)data_model.network_devices[j].metrics_with_neighbors[k].rx_metrics);
-
-                        // Place last element here (we don't care about
-                        // preserving order)
-                        //
-                        if (k == (data_model.network_devices[j].metrics_with_neighbors_nr-1))
-                        {
-                            // Last element. It will automatically be removed
-                            // below (keep reading)
-                        }
-                        else
-                        {
-                            data_model.network_devices[j].metrics_with_neighbors[k] = data_model.network_devices[j].metrics_with_neighbors[data_model.network_devices[j].metrics_with_neighbors_nr-1];
-                            k--;
-                        }
-                        data_model.network_devices[j].metrics_with_neighbors_nr--;
-                    }
-                }
+    if (NULL != data_model.gc_candidates)
+    {
+        free(data_model.gc_candidates);
+        data_model.gc_candidates    = NULL;
+        data_model.gc_candidates_nr = 0;
+    }
+
+    if (NULL != removed_al_macs)
+    {
+        // Remove all references to the removed nodes from the remaining nodes'
+        // metrics information entries
+        //
+        for (j=0; j<data_model.network_devices_nr; j++)
+        {
+            uint16_t original_neighbors_nr;
+
+            original_neighbors_nr = data_model.network_devices[j]->metrics_with_neighbors_nr;
 
-                if (original_neighbors_nr != data_model.network_devices[j].metrics_with_neighbors_nr)
+            for (k=0; k<data_model.network_devices[j]->metrics_with_neighbors_nr; k++)
+            {
+                if (NULL != hashTableFind(removed_al_macs, data_model.network_devices[j]->metrics_with_neighbors[k].neighbor_al_mac_address))
                 {
-                    if (0 == data_model.network_devices[j].metrics_with_neighbors_nr)
+                    free_1905_TLV_structure((uint8_t*)data_model.network_devices[j]->metrics_with_neighbors[k].tx_metrics);
+                    free_1905_TLV_structure((uint8_t*)data_model.network_devices[j]->metrics_with_neighbors[k].rx_metrics);
+
+                    // Place last element here (we don't care about
+                    // preserving order)
+                    //
+                    if (k == (data_model.network_devices[j]->metrics_with_neighbors_nr-1))
                     {
-                        free(data_model.network_devices[j].metrics_with_neighbors);
+                        // Last element. It will automatically be removed
+                        // below (keep reading)
                     }
                     else
                     {
-                        data_model.network_devices[j].metrics_with_neighbors = (struct _metricsWithNeighbor *)memrealloc(data_model.network_devices[j].metrics_with_neighbors, sizeof(struct _metricsWithNeighbor)*(data_model.network_devices[j].metrics_with_neighbors_nr));
+                        data_model.network_devices[j]->metrics_with_neighbors[k] = data_model.network_devices[j]->metrics_with_neighbors[data_model.network_devices[j]->metrics_with_neighbors_nr-1];
+                        k--;
                     }
+                    data_model.network_devices[j]->metrics_with_neighbors_nr--;
                 }
             }
 
-            // And also from the local interfaces database
-            //
-            DMremoveALNeighborFromInterface(al_mac_address, "all");
+            if (original_neighbors_nr != data_model.network_devices[j]->metrics_with_neighbors_nr)
+            {
+                if (0 == data_model.network_devices[j]->metrics_with_neighbors_nr)
+                {
+                    free(data_model.network_devices[j]->metrics_with_neighbors);
+                    data_model.network_devices[j]->metrics_with_neighbors = NULL;
+                }
+                else
+                {
+                    data_model.network_devices[j]->metrics_with_neighbors = (struct _metricsWithNeighbor *)memrealloc(data_model.network_devices[j]->metrics_with_neighbors, sizeof(struct _metricsWithNeighbor)*(data_model.network_devices[j]->metrics_with_neighbors_nr));
+                }
+            }
         }
 
-        if (NULL != p)
-        {
-            free(p);
-        }
+        hashTableDestroy(removed_al_macs);
     }
 
     // If at least one element was removed, we need to realloc
@@ -1764,7 +2178,7 @@ uint8_t DMrunGarbageCollector(void)
         }
         else
         {
-            data_model.network_devices = (struct _networkDevice *)memrealloc(data_model.network_devices, sizeof(struct _networkDevice)*(data_model.network_devices_nr));
+            data_model.network_devices = (struct _networkDevice **)memrealloc(data_model.network_devices, sizeof(struct _networkDevice *)*(data_model.network_devices_nr));
         }
     }
 
@@ -1773,15 +2187,19 @@ uint8_t DMrunGarbageCollector(void)
 
 void DMremoveALNeighborFromInterface(uint8_t *al_mac_address, char *interface_name)
 {
-    uint8_t i, j;
+    uint8_t  i;
+    uint16_t j, k;
 
     for (i=0; i<data_model.local_interfaces_nr; i++)
     {
-        uint8_t original_neighbors_nr;
+        struct _localInterface *x;
+        struct _neighbor       *n;
+
+        x = &data_model.local_interfaces[i];
 
         if (
-             (0 != memcmp(data_model.local_interfaces[i].name, interface_name, strlen(data_model.local_interfaces[i].name)+1)) &&
-             (0 != memcmp(interface_name,                      "all",          strlen(interface_name)+1))
+             (0 != memcmp(x->name,       interface_name, strlen(x->name)+1)) &&
+             (0 != memcmp(interface_name, "all",         strlen(interface_name)+1))
            )
         {
             // Ignore this interface
@@ -1789,55 +2207,53 @@ void DMremoveALNeighborFromInterface(uint8_t *al_mac_address, char *interface_na
             continue;
         }
 
-        original_neighbors_nr = data_model.local_interfaces[i].neighbors_nr;
-
-        for (j=0; j<data_model.local_interfaces[i].neighbors_nr; j++)
+        if (NULL == (n = (struct _neighbor *)hashTableRemove(x->neighbors_index, al_mac_address)))
         {
-            if (0 == memcmp(al_mac_address, data_model.local_interfaces[i].neighbors[j].al_mac_address, 6))
-            {
-                if (data_model.local_interfaces[i].neighbors[j].remote_interfaces_nr > 0 && NULL != data_model.local_interfaces[i].neighbors[j].remote_interfaces)
-                {
-                    free(data_model.local_interfaces[i].neighbors[j].remote_interfaces);
+            // Not a neighbor in this interface
+            //
+            continue;
+        }
 
-                    data_model.local_interfaces[i].neighbors[j].remote_interfaces    = NULL;
-                    data_model.local_interfaces[i].neighbors[j].remote_interfaces_nr = 0;
-                }
+        for (k=0; k<n->remote_interfaces_nr; k++)
+        {
+            _macOwnerRelease(n->remote_interfaces[k].mac_address);
+        }
+        _macOwnerRelease(n->al_mac_address);
 
-                // Place last element here (we don't care about preserving
-                // order)
-                //
-                if (j == (data_model.local_interfaces[i].neighbors_nr-1))
-                {
-                    // Last element. It will automatically be removed
-                    // below (keep reading)
-                }
-                else
-                {
-                    data_model.local_interfaces[i].neighbors[j] = data_model.local_interfaces[i].neighbors[data_model.local_interfaces[i].neighbors_nr-1];
-                    j--;
-                }
-                data_model.local_interfaces[i].neighbors_nr--;
-            }
+        if (n->remote_interfaces_nr > 0 && NULL != n->remote_interfaces)
+        {
+            free(n->remote_interfaces);
         }
 
-        if (original_neighbors_nr != data_model.local_interfaces[i].neighbors_nr)
+        // Place last element here (we don't care about preserving order)
+        //
+        for (j=0; j<x->neighbors_nr; j++)
         {
-            if (0 == data_model.local_interfaces[i].neighbors_nr)
+            if (n == x->neighbors[j])
             {
-                free(data_model.local_interfaces[i].neighbors);
-            }
-            else
-            {
-                data_model.local_interfaces[i].neighbors = (struct _neighbor *)memrealloc(data_model.local_interfaces[i].neighbors, sizeof(struct _neighbor)*(data_model.local_interfaces[i].neighbors_nr));
+                x->neighbors[j] = x->neighbors[x->neighbors_nr-1];
+                break;
             }
         }
+        x->neighbors_nr--;
+        free(n);
+
+        if (0 == x->neighbors_nr)
+        {
+            free(x->neighbors);
+            x->neighbors = NULL;
+        }
+        else
+        {
+            x->neighbors = (struct _neighbor **)memrealloc(x->neighbors, sizeof(struct _neighbor *)*(x->neighbors_nr));
+        }
     }
 }
 
 
 struct vendorSpecificTLV ***DMextensionsGet(uint8_t *al_mac_address, uint8_t **nr)
 {
-    uint8_t                         i;
+    struct _networkDevice          *x;
     struct vendorSpecificTLV   ***extensions;
 
     // Find device
@@ -1847,23 +2263,12 @@ struct vendorSpecificTLV ***DMextensionsGet(uint8_t *al_mac_address, uint8_t **n
         return NULL;
     }
 
-    // Search for an existing entry with the same AL MAC address
+    // Search for an existing entry with the same AL MAC address (devices we
+    // haven't received general info about yet are not indexed)
     //
-    for (i=0; i<data_model.network_devices_nr; i++)
-    {
-        if (NULL == data_model.network_devices[i].info)
-        {
-            // We haven't received general info about this device yet.
-            //
-            continue;
-        }
-        if (0 == memcmp(data_model.network_devices[i].info->al_mac_address, al_mac_address, 6))
-        {
-            break;
-        }
-    }
+    x = _alMacAddressToNetworkDeviceStruct(al_mac_address);
 
-    if (i == data_model.network_devices_nr)
+    if (NULL == x)
     {
         // A matching entry was *not* found.
         //
@@ -1872,10 +2277,15 @@ struct vendorSpecificTLV ***DMextensionsGet(uint8_t *al_mac_address, uint8_t **n
     }
     else
     {
-        // Point to the datamodel extensions section
+        // Point to the datamodel extensions section.
+        //
+        // The caller is free to modify it, thus the entry is considered to
+        // have changed.
         //
-        extensions = &data_model.network_devices[i].extensions;
-        *nr        = &data_model.network_devices[i].extensions_nr;
+        extensions = &x->extensions;
+        *nr        = &x->extensions_nr;
+
+        x->generation++;
     }
 
     return extensions;
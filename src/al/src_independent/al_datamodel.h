@@ -112,7 +112,7 @@ uint8_t *DMinterfaceNameToMac(char *interface_name);
 // The returned pointer, once it is no longer needed, must be freed by the
 // caller with "free()"
 //
-uint8_t (*DMgetListOfInterfaceNeighbors(char *local_interface_name, uint8_t *al_mac_addresses_nr))[6];
+uint8_t (*DMgetListOfInterfaceNeighbors(char *local_interface_name, uint16_t *al_mac_addresses_nr))[6];
 
 // Returns a list of 6 bytes arrays with the AL MACs of all neighbors (from
 // *all* interfaces) from where a "topology discovery" message has been
@@ -125,7 +125,7 @@ uint8_t (*DMgetListOfInterfaceNeighbors(char *local_interface_name, uint8_t *al_
 // The returned pointer, once it is no longer needed, must be freed by the
 // caller with "free()"
 //
-uint8_t (*DMgetListOfNeighbors(uint8_t *al_mac_addresses_nr))[6];
+uint8_t (*DMgetListOfNeighbors(uint16_t *al_mac_addresses_nr))[6];
 
 
 // A given neighbor might be "reachable" in several ways:
@@ -316,6 +316,11 @@ uint8_t *DMmacToAlMac(uint8_t *mac_addresses);
 // caller must not free them at any point (they will automatically be freed the
 // next time this function is called with new (updated) data)
 //
+//   NOTE: Provided TLVs that contain exactly the same data as the ones already
+//   stored are freed right away, and the stored ones are kept. Only when
+//   something actually changes does the "generation" of the entry (see
+//   "DMnetworkDeviceGeneration()") increase.
+//
 //   NOTE: For metrics, a different function is used
 //        ("DMupdateNetworkDeviceMetrics()"). The reason for this is that
 //        "metrics" work in a slighlty different way: they are not overwritten
@@ -350,6 +355,17 @@ uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
                                 uint8_t v4_update,  struct ipv4TypeTLV                          *ipv4,
                                 uint8_t v6_update,  struct ipv6TypeTLV                          *ipv6);
 
+// Given the AL MAC address of a node, return a number that changes every time
+// the information stored about that node changes (ie. its TLVs, metrics or
+// extensions).
+//
+// Consumers can remember this value and skip the node later if it has not
+// changed since then.
+//
+// Returns "0" if the node is unknown.
+//
+uint32_t DMnetworkDeviceGeneration(uint8_t *al_mac_address);
+
 // Given the AL MAC address of a node, returns "0" if the last time its "device
 // info" was updated (ie. the last time someone called
 // "DMupdateNetworkDeviceInfo()" on that node) was quite recently, indicating
@@ -359,7 +375,7 @@ uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
 //
 // NOTE: "recently" means no longer than MAX_AGE seconds ago
 //
-#define MAX_AGE 50 // Must be smaller than the "TIMER_TOKEN_DISCOVERY" period
+#define MAX_AGE 50 // Must be smaller than the "discovery_timer" period
                    // (which is 60 seconds)
 uint8_t DMnetworkDeviceInfoNeedsUpdate(uint8_t *al_mac_address);
 
@@ -393,6 +409,10 @@ void DMdumpNetworkDevices(void (*write_function)(const char *fmt, ...));
 //
 // If an entry is older than "GC_MAX_AGE" seconds, this function removes it.
 //
+// Each entry has its own expiry timer (see "al_timers.h"), so this function
+// only visits the entries that have expired (or that have lost their owner)
+// since the last call, not the whole database.
+//
 // "GC_MAX_AGE" must be higher than 60 seconds, which is the network rediscovery
 // period defined in the IEEE1905 standard.
 //
@@ -400,7 +420,7 @@ void DMdumpNetworkDevices(void (*write_function)(const char *fmt, ...));
 // means it will return "0" if no entry eas removed)
 //
 #define GC_MAX_AGE (90)
-uint8_t DMrunGarbageCollector(void);
+uint16_t DMrunGarbageCollector(void);
 
 // Remove a neighbor from a particular local interface.
 //
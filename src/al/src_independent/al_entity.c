@@ -70,336 +70,92 @@
 #include "al_recv.h"
 #include "al_utils.h"
 #include "al_extension.h"
+#include "al_reassembly.h"
+#include "al_timers.h"
+#include "al_metrics.h"
+#include "al_query.h"
 
 #include "platform_interfaces.h"
+#include "platform_crypto.h"
 #include "platform_os.h"
 #include "platform_alme_server.h"
 
 #include <string.h> // memcmp(), memcpy(), ...
 
-#define TIMER_TOKEN_DISCOVERY          (1)
-#define TIMER_TOKEN_GARBAGE_COLLECTOR  (2)
+#define TIMER_TOKEN_WHEEL  (1)
 
 
 ////////////////////////////////////////////////////////////////////////////////
 // Private functions and data
 ////////////////////////////////////////////////////////////////////////////////
 
-// CMDUs can be received in multiple fragments/packets when they are too big to
-// fit in a single "network transmission unit" (which is never bigger than
-// MAX_NETWORK_SEGMENT_SIZE).
+// Maximum number of ("mac_address", "message_id") tuples remembered by
+// "_checkDuplicates()" and for how long (in milliseconds) they are remembered.
+// Both can be changed at build time (ex: "-DDUPLICATES_LOG_ENTRIES=4096").
 //
-// Fragments that belong to one same CMDU contain the same 'mid' and different
-// 'fragment id' values. In addition, the last fragment is the only one to
-// contain the 'last fragment indicator' field set.
+// The age is a trade-off:
 //
-//   NOTE: This is all also explained in "Sections 7.1.1 and 7.1.2"
+//   - Copies of a relayed multicast CMDU reach us through different paths
+//     within a short time, so a tuple only needs to be remembered for a
+//     while. Copies delayed longer than that are processed again.
 //
-// This function will "buffer" fragments until either all pieces arrive or a
-// timer expires (in which case all previous fragments are discarded/ignored)
+//   - An AL that restarts begins generating MIDs again and, for as long as
+//     its old tuples are remembered, its new CMDUs that happen to reuse one
+//     of those MIDs are wrongly discarded.
 //
-//   NOTE: Instead of a timer, we will use a buffer that holds up to
-//         MAX_MIDS_IN_FLIGHT CMDUs.
-//         If we are still waiting for MAX_MIDS_IN_FLIGHT CMDUs to be completed
-//         (ie. we haven't received all their fragments yet), and a new fragment
-//         for a new CMDU arrives, we will discard all fragments from the
-//         oldest one.
+// By default tuples are remembered for as long as a partial CMDU is kept by the
+// reassembly module, which is already the longest time the network is assumed
+// to take to deliver all the pieces of a CMDU.
 //
-// Every time this function is called, two things can happen:
-//
-//   1. The just received fragment was the last one needed to complete a CMDU.
-//      In this case, the CMDU structure result of all those fragments being
-//      parsed is returned.
-//
-//   2. The just received fragment is not yet the last one needed to complete a
-//      CMDU. In this case the fragment is internally buffered (ie. the caller
-//      does not need to keep the passed buffer around in memory) and this
-//      function returns NULL.
-//
-// This function received two arguments:
-//
-//   - 'packet_buffer' is a pointer to the received stream containing a
-//     fragment (or a whole) CMDU
-//
-//   - 'len' is the length of this 'packet_buffer' in bytes
-//
-struct CMDU *_reAssembleFragmentedCMDUs(uint8_t *packet_buffer, uint16_t len)
-{
-    #define MAX_MIDS_IN_FLIGHT     5
-    #define MAX_FRAGMENTS_PER_MID  3
-
-    // This is a static structure used to store the fragments belonging to up to
-    // 'MAX_MIDS_IN_FLIGHT' CMDU messages.
-    // Initially all entries are marked as "empty" by setting the 'in_use' field
-    // to "0"
-    //
-    static struct _midsInFlight
-    {
-        uint8_t in_use;  // Is this entry free?
-
-        uint8_t mid;     // 'mid' associated to this CMDU
-
-        uint8_t src_addr[6];
-        uint8_t dst_addr[6];
-                       // These two (together with the 'mid' field) will be used
-                       // to identify fragments belonging to one same CMDU.
-
-        uint8_t fragments[MAX_FRAGMENTS_PER_MID];
-                       // Each entry represents a fragment number.
-                       //   - "1" means that fragment has been received
-                       //   - "0" means no fragment with that number has been
-                       //     received.
-
-        uint8_t last_fragment;
-                       // Number of the fragment carrying the
-                       // 'last_fragment_indicator' flag.
-                       // This is always a number between 0 and
-                       // MAX_FRAGMENTS_PER_MID-1.
-                       // Iniitally it is set to "MAX_FRAGMENTS_PER_MID",
-                       // meaning that no fragment with the
-                       // 'last_fragment_indicator' flag has been received yet.
-
-        uint8_t *streams[MAX_FRAGMENTS_PER_MID+1];
-                       // Each of the bit streams associated to each fragment
-                       //
-                       // The size is "MAX_FRAGMENTS_PER_MID+1" instead of
-                       // "MAX_FRAGMENTS_PER_MID" to store a final NULL entry
-                       // (this makes it easier to later call
-                       // "parse_1905_CMDU_header_from_packet()"
-
-        uint32_t age;    // Used to keep track of which is the oldest CMDU for
-                       // which a fragment was received (so that we can free
-                       // it when the CMDUs buffer is full)
-
-    } mids_in_flight[MAX_MIDS_IN_FLIGHT] = \
-    {[ 0 ... MAX_MIDS_IN_FLIGHT-1 ] = (struct _midsInFlight) { .in_use = 0 }};
-
-    static uint32_t current_age = 0;
-
-    uint8_t  i, j;
-    uint8_t *p;
-    struct CMDU_header cmdu_header;
-
-    if (!parse_1905_CMDU_header_from_packet(packet_buffer, len, &cmdu_header))
-    {
-        PLATFORM_PRINTF_DEBUG_ERROR("Could not retrieve CMDU header from bit stream\n");
-        return NULL;
-    }
-    PLATFORM_PRINTF_DEBUG_DETAIL("mid = %d, fragment_id = %d, last_fragment_indicator = %d\n",
-                                 cmdu_header.mid, cmdu_header.fragment_id, cmdu_header.last_fragment_indicator);
-
-    // Skip over ethernet header
-    p = packet_buffer + (6+6+2);
-    len -= (6+6+2);
-
-    // Find the set of streams associated to this 'mid' and add the just
-    // received stream to its set of streams
-    //
-    for (i = 0; i<MAX_MIDS_IN_FLIGHT; i++)
-    {
-        if (
-                                              1        ==  mids_in_flight[i].in_use          &&
-                                  cmdu_header.mid      ==  mids_in_flight[i].mid             &&
-             0 == memcmp(cmdu_header.dst_addr,    mids_in_flight[i].dst_addr, 6)    &&
-             0 == memcmp(cmdu_header.src_addr,    mids_in_flight[i].src_addr, 6)
-           )
-        {
-            // Fragments for this 'mid' have previously been received. Add this
-            // new one to the set.
-
-            // ...but first check for errors
-            //
-            if (cmdu_header.fragment_id > MAX_FRAGMENTS_PER_MID)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Too many fragments (%d) for one same CMDU (max supported is %d)\n",
-                                            cmdu_header.fragment_id, MAX_FRAGMENTS_PER_MID);
-                PLATFORM_PRINTF_DEBUG_ERROR("  mid      = %d\n", cmdu_header.mid);
-                PLATFORM_PRINTF_DEBUG_ERROR("  src_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                            cmdu_header.src_addr[0], cmdu_header.src_addr[1], cmdu_header.src_addr[2],
-                                            cmdu_header.src_addr[3], cmdu_header.src_addr[4], cmdu_header.src_addr[5]);
-                PLATFORM_PRINTF_DEBUG_ERROR("  dst_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                            cmdu_header.dst_addr[0], cmdu_header.dst_addr[1], cmdu_header.dst_addr[2],
-                                            cmdu_header.dst_addr[3], cmdu_header.dst_addr[4], cmdu_header.dst_addr[5]);
-                return NULL;
-            }
-
-            if (1 == mids_in_flight[i].fragments[cmdu_header.fragment_id])
-            {
-                PLATFORM_PRINTF_DEBUG_WARNING("Ignoring duplicated fragment #%d\n", cmdu_header.fragment_id);
-                PLATFORM_PRINTF_DEBUG_WARNING("  mid      = %d\n", cmdu_header.mid);
-                PLATFORM_PRINTF_DEBUG_WARNING("  src_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                              cmdu_header.src_addr[0], cmdu_header.src_addr[1], cmdu_header.src_addr[2],
-                                              cmdu_header.src_addr[3], cmdu_header.src_addr[4], cmdu_header.src_addr[5]);
-                PLATFORM_PRINTF_DEBUG_WARNING("  dst_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                              cmdu_header.dst_addr[0], cmdu_header.dst_addr[1], cmdu_header.dst_addr[2],
-                                              cmdu_header.dst_addr[3], cmdu_header.dst_addr[4], cmdu_header.dst_addr[5]);
-                return NULL;
-            }
-
-            if (1 == cmdu_header.last_fragment_indicator && MAX_FRAGMENTS_PER_MID != mids_in_flight[i].last_fragment)
-            {
-                PLATFORM_PRINTF_DEBUG_WARNING("This fragment (#%d) and a previously received one (#%d) both contain the 'last_fragment_indicator' flag set. Ignoring...\n",
-                                              cmdu_header.fragment_id, mids_in_flight[i].last_fragment);
-                PLATFORM_PRINTF_DEBUG_WARNING("  mid      = %d\n", cmdu_header.mid);
-                PLATFORM_PRINTF_DEBUG_WARNING("  src_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                              cmdu_header.src_addr[0], cmdu_header.src_addr[1], cmdu_header.src_addr[2],
-                                              cmdu_header.src_addr[3], cmdu_header.src_addr[4], cmdu_header.src_addr[5]);
-                PLATFORM_PRINTF_DEBUG_WARNING("  dst_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                              cmdu_header.dst_addr[0], cmdu_header.dst_addr[1], cmdu_header.dst_addr[2],
-                                              cmdu_header.dst_addr[3], cmdu_header.dst_addr[4], cmdu_header.dst_addr[5]);
-                return NULL;
-            }
-
-            // ...and now actually save the stream for later
-            //
-            mids_in_flight[i].fragments[cmdu_header.fragment_id] = 1;
-
-            if (1 == cmdu_header.last_fragment_indicator)
-            {
-                mids_in_flight[i].last_fragment = cmdu_header.fragment_id;
-            }
-
-            mids_in_flight[i].streams[cmdu_header.fragment_id] = (uint8_t *)memalloc((sizeof(uint8_t) * len));
-            memcpy(mids_in_flight[i].streams[cmdu_header.fragment_id], p, len);
-
-            mids_in_flight[i].age = current_age++;
+#ifndef DUPLICATES_LOG_ENTRIES
+#  define DUPLICATES_LOG_ENTRIES  (2048)
+#endif
 
-            break;
-        }
-    }
+#ifndef DUPLICATES_MAX_AGE_MS
+#  define DUPLICATES_MAX_AGE_MS   (REASSEMBLY_TIMEOUT_MS)
+#endif
 
-    // If we get inside the next "if()", that means no previous entry matches
-    // this 'mid' + 'src_addr' + 'dst_addr' tuple.
-    // What we have to do then is to search for an empty slot and add this as
-    // the first stream associated to this new tuple.
-    //
-    if (MAX_MIDS_IN_FLIGHT == i)
+static struct
+{
+    struct _duplicatesLogEntry
     {
-        for (i = 0; i<MAX_MIDS_IN_FLIGHT; i++)
-        {
-            if (0 == mids_in_flight[i].in_use)
-            {
-                break;
-            }
-        }
-
-        if (MAX_MIDS_IN_FLIGHT == i)
-        {
-            // All slots are in use!!
-            //
-            // We need to discard the oldest one (ie. the one with the lowest
-            // 'age')
-            //
-            uint32_t lowest_age;
-
-            lowest_age = mids_in_flight[0].age;
-            j          = 0;
-
-            for (i=1; i<MAX_MIDS_IN_FLIGHT; i++)
-            {
-                if (mids_in_flight[i].age < lowest_age)
-                {
-                    lowest_age = mids_in_flight[i].age;
-                    j          = i;
-                }
-            }
-
-            PLATFORM_PRINTF_DEBUG_WARNING("Discarding old CMDU fragments to make room for the just received one. CMDU being discarded:\n");
-            PLATFORM_PRINTF_DEBUG_WARNING("  mid      = %d\n", mids_in_flight[j].mid);
-            PLATFORM_PRINTF_DEBUG_WARNING("  mids_in_flight[j].src_addr = %02x:%02x:%02x:%02x:%02x:%02x\n", mids_in_flight[j].src_addr[0], mids_in_flight[j].src_addr[1], mids_in_flight[j].src_addr[2], mids_in_flight[j].src_addr[3], mids_in_flight[j].src_addr[4], mids_in_flight[j].src_addr[5]);
-            PLATFORM_PRINTF_DEBUG_WARNING("  mids_in_flight[j].dst_addr = %02x:%02x:%02x:%02x:%02x:%02x\n", mids_in_flight[j].dst_addr[0], mids_in_flight[j].dst_addr[1], mids_in_flight[j].dst_addr[2], mids_in_flight[j].dst_addr[3], mids_in_flight[j].dst_addr[4], mids_in_flight[j].dst_addr[5]);
-
-            for (i=0; i<MAX_FRAGMENTS_PER_MID; i++)
-            {
-                if (1 == mids_in_flight[j].fragments[i] && NULL != mids_in_flight[j].streams[i])
-                {
-                    free(mids_in_flight[j].streams[i]);
-                }
-            }
-
-            mids_in_flight[j].in_use = 0;
+        uint8_t   key[6+2];   // MAC address + MID (big endian)
+        uint32_t  timestamp;  // When it was inserted
 
-            i = j;
-        }
+    }                 *entries;
+                          // Circular buffer of DUPLICATES_LOG_ENTRIES
+                          // elements, from the oldest ('start') to the newest
+                          // one ('start' + 'total' - 1)
 
-        // Now that we have our empty slot, initialize it and fill it with the
-        // just received stream:
-        //
-        mids_in_flight[i].in_use = 1;
-        mids_in_flight[i].mid    = cmdu_header.mid;
+    uint32_t           start;
+    uint32_t           total;
 
-        memcpy(mids_in_flight[i].src_addr, cmdu_header.src_addr, 6);
-        memcpy(mids_in_flight[i].dst_addr, cmdu_header.dst_addr, 6);
+    struct hashTable  *index;
+                          // Key --> "struct _duplicatesLogEntry *"
 
-        for (j=0; j<MAX_FRAGMENTS_PER_MID; j++)
-        {
-            mids_in_flight[i].fragments[j] = 0;
-            mids_in_flight[i].streams[j]   = NULL;
-        }
-        mids_in_flight[i].streams[MAX_FRAGMENTS_PER_MID] = NULL;
+    uint32_t           hits;    // Duplicated CMDUs found (and discarded)
+    uint32_t           misses;  // New tuples inserted
 
-        mids_in_flight[i].fragments[cmdu_header.fragment_id]  = 1;
-        mids_in_flight[i].streams[cmdu_header.fragment_id]    = (uint8_t *)memalloc((sizeof(uint8_t) * len));
-        memcpy(mids_in_flight[i].streams[cmdu_header.fragment_id], p, len);
+} duplicates_log;
 
-        if (1 == cmdu_header.last_fragment_indicator)
-        {
-            mids_in_flight[i].last_fragment = cmdu_header.fragment_id;
-        }
-        else
-        {
-            mids_in_flight[i].last_fragment = MAX_FRAGMENTS_PER_MID;
-              // NOTE: This means "no 'last_fragment_indicator' flag has been
-              //       received yet.
-        }
+// Remove the oldest entry from "duplicates_log"
+//
+static void _duplicatesLogDropOldest(void)
+{
+    struct _duplicatesLogEntry *e;
 
-        mids_in_flight[i].age = current_age++;
-    }
+    e = &duplicates_log.entries[duplicates_log.start];
 
-    // At this point we have an entry in the 'mids_in_flight' array (entry 'i')
-    // where a new stream/fragment has been added.
-    //
-    // We now have to check if we have received all fragments for this 'mid'
-    // and, if so, process them and obtain a CMDU structure that will be
-    // returned to the caller of the function.
+    // The index might already point to a newer entry with the same key (this
+    // happens when a tuple expires and is seen again later)
     //
-    // Otherwise, return NULL.
-    //
-    if (MAX_FRAGMENTS_PER_MID != mids_in_flight[i].last_fragment)
+    if (e == hashTableFind(duplicates_log.index, e->key))
     {
-        struct CMDU *c;
-
-        for (j=0; j<=mids_in_flight[i].last_fragment; j++)
-        {
-            if (0 == mids_in_flight[i].fragments[j])
-            {
-                PLATFORM_PRINTF_DEBUG_DETAIL("We still have to wait for more fragments to complete the CMDU message\n");
-                return NULL;
-            }
-        }
-
-        c = parse_1905_CMDU_from_packets(mids_in_flight[i].streams);
-
-        if (NULL == c)
-        {
-            PLATFORM_PRINTF_DEBUG_WARNING("parse_1905_CMDU_header_from_packet() failed\n");
-        }
-        else
-        {
-            PLATFORM_PRINTF_DEBUG_DETAIL("All fragments belonging to this CMDU have already been received and the CMDU structure is ready\n");
-        }
-
-        for (j=0; j<=mids_in_flight[i].last_fragment; j++)
-        {
-            free(mids_in_flight[i].streams[j]);
-        }
-        mids_in_flight[i].in_use = 0;
-
-        return c;
+        hashTableRemove(duplicates_log.index, e->key);
     }
 
-    PLATFORM_PRINTF_DEBUG_DETAIL("The last fragment has not yet been received\n");
-    return NULL;
+    duplicates_log.start = (duplicates_log.start + 1) % DUPLICATES_LOG_ENTRIES;
+    duplicates_log.total--;
 }
 
 // Returns '1' if the packet has already been processed in the past and thus,
@@ -424,8 +180,9 @@ struct CMDU *_reAssembleFragmentedCMDUs(uint8_t *packet_buffer, uint16_t len)
 //   2. If the CMDU is *not* a relayed one, check against the ethernet source
 //      address
 //
-// This function keeps track of the latest MAX_DUPLICATES_LOG_ENTRIES tuples
-// of ("mac_address", "message_id") and:
+// This function keeps track of the ("mac_address", "message_id") tuples seen
+// during the last DUPLICATES_MAX_AGE_MS milliseconds (up to
+// DUPLICATES_LOG_ENTRIES of them) and:
 //
 //   1. If the provided tuple matches an already existing one, this function
 //      returns '1'
@@ -433,19 +190,13 @@ struct CMDU *_reAssembleFragmentedCMDUs(uint8_t *packet_buffer, uint16_t len)
 //   2. Otherwise, the entry is added (discarding, if needed, the oldest entry)
 //      and this function returns '0'
 //
-uint8_t _checkDuplicates(uint8_t *src_mac_address, struct CMDU *c)
+uint8_t _checkDuplicates(uint8_t *src_mac_address, struct CMDU_view *c)
 {
-    #define MAX_DUPLICATES_LOG_ENTRIES 10
-
-    static uint8_t  mac_addresses[MAX_DUPLICATES_LOG_ENTRIES][6];
-    static uint16_t message_ids  [MAX_DUPLICATES_LOG_ENTRIES];
+    uint8_t  mac_address[6];
+    uint8_t  key[6+2];
+    uint32_t now;
 
-    static uint8_t start = 0;
-    static uint8_t total = 0;
-
-    uint8_t mac_address[6];
-
-    uint8_t i;
+    struct _duplicatesLogEntry *e;
 
     if(
         CMDU_TYPE_TOPOLOGY_RESPONSE               == c->message_type ||
@@ -498,20 +249,15 @@ uint8_t _checkDuplicates(uint8_t *src_mac_address, struct CMDU *c)
     memcpy(mac_address, src_mac_address, 6);
     if (1 == c->relay_indicator)
     {
-        uint8_t i;
-        uint8_t *p;
+        struct TLV_view *t;
 
-        i = 0;
-        while (NULL != (p = c->list_of_TLVs[i]))
+        // There is no need to parse the whole TLV: its value is just the AL
+        // MAC address
+        //
+        t = find_1905_TLV_view(c, TLV_TYPE_AL_MAC_ADDRESS_TYPE);
+        if (NULL != t && 6 == t->length)
         {
-            if (TLV_TYPE_AL_MAC_ADDRESS_TYPE == *p)
-            {
-                struct alMacAddressTypeTLV *t = (struct alMacAddressTypeTLV *)p;
-
-                memcpy(mac_address, t->al_mac_address, 6);
-                break;
-            }
-            i++;
+            memcpy(mac_address, t->stream + 3, 6);
         }
     }
 
@@ -522,56 +268,50 @@ uint8_t _checkDuplicates(uint8_t *src_mac_address, struct CMDU *c)
     {
         if (0 == memcmp(mac_address, DMalMacGet(), 6))
         {
+            duplicates_log.hits++;
             return 1;
         }
     }
 
-    // Find if the ("mac_address", "message_id") tuple is already present in the
-    // database
+    // Forget about tuples that are too old
     //
-    for (i=0; i<total; i++)
+    now = PLATFORM_GET_TIMESTAMP();
+    while (duplicates_log.total > 0 && now - duplicates_log.entries[duplicates_log.start].timestamp > DUPLICATES_MAX_AGE_MS)
     {
-        uint8_t index;
-
-        index = (start + i) % MAX_DUPLICATES_LOG_ENTRIES;
-
-        if (
-             0 == memcmp(mac_addresses[index],    mac_address, 6) &&
-                                  message_ids[index]    == c->message_id
-           )
-        {
-            // The entry already exists!
-            //
-            return 1;
-        }
+        _duplicatesLogDropOldest();
     }
 
-    // This is a new entry, insert it into the cache and return "0"
+    // Find if the ("mac_address", "message_id") tuple is already present in the
+    // database
     //
-    if (total < MAX_DUPLICATES_LOG_ENTRIES)
+    memcpy(key, mac_address, 6);
+    key[6] = (uint8_t)(c->message_id >> 8);
+    key[7] = (uint8_t)(c->message_id     );
+
+    if (NULL != hashTableFind(duplicates_log.index, key))
     {
-        // There is space for new entries
+        // The entry already exists!
         //
-        uint8_t index;
-
-        index = (start + total) % MAX_DUPLICATES_LOG_ENTRIES;
-
-        memcpy(mac_addresses[index], mac_address, 6);
-        message_ids[index] = c->message_id;
-
-        total++;
+        duplicates_log.hits++;
+        return 1;
     }
-    else
+
+    // This is a new entry, insert it into the cache (replacing the oldest one
+    // if there is no space left) and return "0"
+    //
+    if (DUPLICATES_LOG_ENTRIES == duplicates_log.total)
     {
-        // We need to replace the oldest entry
-        //
-        memcpy(mac_addresses[start], mac_address, 6);
-        message_ids[start] = c->message_id;
+        _duplicatesLogDropOldest();
+    }
 
-        start++;
+    e = &duplicates_log.entries[(duplicates_log.start + duplicates_log.total) % DUPLICATES_LOG_ENTRIES];
 
-        start = start % MAX_DUPLICATES_LOG_ENTRIES;
-    }
+    memcpy(e->key, key, 6+2);
+    e->timestamp = now;
+
+    hashTableInsert(duplicates_log.index, e->key, e);
+    duplicates_log.total++;
+    duplicates_log.misses++;
 
     return 0;
 }
@@ -595,11 +335,17 @@ void _checkForwarding(uint8_t *receiving_interface_addr, uint8_t *destination_ma
         char **ifs_names;
         uint8_t  ifs_nr;
 
+        char **forward_ifs_names;
+        uint8_t  forward_ifs_nr;
+
         char *aux;
 
         PLATFORM_PRINTF_DEBUG_DETAIL("Relay multicast flag set. Forwarding...\n");
 
         ifs_names = PLATFORM_GET_LIST_OF_1905_INTERFACES(&ifs_nr);
+
+        forward_ifs_names = (char **)memalloc(sizeof(char *) * (ifs_nr + 1));
+        forward_ifs_nr    = 0;
         for (i=0; i<ifs_nr; i++)
         {
             uint8_t authenticated;
@@ -640,7 +386,9 @@ void _checkForwarding(uint8_t *receiving_interface_addr, uint8_t *destination_ma
                 free_1905_INTERFACE_INFO(x);
             }
 
-            // Retransmit message
+            // Retransmit message on this interface (the actual transmission
+            // takes place below, once all interfaces have been checked, so
+            // that the CMDU is only forged once)
             //
             switch (c->message_type)
             {
@@ -717,11 +465,15 @@ void _checkForwarding(uint8_t *receiving_interface_addr, uint8_t *destination_ma
             }
             PLATFORM_PRINTF_DEBUG_INFO("--> %s (forwarding from %s to %s)\n", aux, DMmacToInterfaceName(receiving_interface_addr), ifs_names[i]);
 
-            if (0 == send1905RawPacket(ifs_names[i], c->message_id, destination_mac_addr, c))
-            {
-                PLATFORM_PRINTF_DEBUG_WARNING("Could not retransmit 1905 message on interface %s\n", x->name);
-            }
+            forward_ifs_names[forward_ifs_nr++] = ifs_names[i];
+        }
+
+        if (0 == send1905RawPacketOnInterfaces(forward_ifs_names, forward_ifs_nr, c->message_id, destination_mac_addr, c))
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("Could not retransmit 1905 message\n");
         }
+
+        free(forward_ifs_names);
         free_LIST_OF_1905_INTERFACES(ifs_names, ifs_nr);
     }
 
@@ -877,11 +629,231 @@ void _triggerAPSearchProcess(void)
     free_LIST_OF_1905_INTERFACES(ifs_names, ifs_nr);
 }
 
+// Received CMDUs are processed straight from their views (see
+// "process1905Cmdu()"). When they also have to be printed, they are
+// materialized on this arena instead of the heap, so that each one costs a
+// single "reset" instead of dozens of malloc()/free() calls. It is only used by
+// the main thread.
+//
+// Chunks are CMDU_ARENA_CHUNK_SIZE bytes long, which is enough for the parsed
+// contents of any typical (not fragmented) CMDU.
+//
+#define CMDU_ARENA_CHUNK_SIZE  (8*1024)
+static struct memArena *cmdu_arena = NULL;
+
+// Print the contents of the CMDU in view 'v'. Everything is allocated from the
+// "cmdu_arena", which stays selected until the CMDU is no longer needed, and
+// released at once by the final reset.
+//
+static void _printCMDU(struct CMDU_view *v)
+{
+    struct memArena *previous;
+    struct CMDU     *c;
+
+    previous = memArenaSelect(cmdu_arena);
+
+    c = materialize_1905_CMDU_view(v);
+    if (NULL == c)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("materialize_1905_CMDU_view() failed\n");
+    }
+    else
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("CMDU message contents:\n");
+        visit_1905_CMDU_structure(c, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+    }
+
+    memArenaSelect(previous);
+    memArenaReset(cmdu_arena);
+}
+
+
+// Timer callbacks
+//
+static struct timerWheelTimer discovery_timer;
+static struct timerWheelTimer garbage_collector_timer;
+static struct timerWheelTimer metrics_sampler_timer;
+
+static void _discoveryTimerCallback(struct timerWheelTimer *timer, void *data)
+{
+    uint16_t mid;
+    uint8_t  i;
+
+    char **ifs_names;
+    uint8_t  ifs_nr;
+
+    // According to "Section 8.2.1.1" and "Section 8.2.1.2"
+    // we now have to send a "Topology discovery message"
+    // followed by a "802.1 bridge discovery message" but,
+    // according to the rules in "Section 7.2", only on each
+    // and every of the *authenticated* 1905 interfaces
+    // that are in the state of "PWR_ON" or "PWR_SAVE"
+    //
+    ifs_names = PLATFORM_GET_LIST_OF_1905_INTERFACES(&ifs_nr);
+    mid       = getNextMid();
+    for (i=0; i<ifs_nr; i++)
+    {
+        uint8_t authenticated;
+        uint8_t power_state;
+
+        struct interfaceInfo *x;
+
+        x = PLATFORM_GET_1905_INTERFACE_INFO(ifs_names[i]);
+        if (NULL == x)
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("Could not retrieve info of interface %s\n", ifs_names[i]);
+            authenticated = 0;
+            power_state   = INTERFACE_POWER_STATE_OFF;
+        }
+        else
+        {
+            authenticated = x->is_secured;
+            power_state   = x->power_state;
+
+            free_1905_INTERFACE_INFO(x);
+        }
+
+        if (
+            (0 == authenticated                                                                     ) ||
+            ((power_state != INTERFACE_POWER_STATE_ON) && (power_state!= INTERFACE_POWER_STATE_SAVE))
+           )
+        {
+            // Do not send the discovery messages on this
+            // interface
+            //
+            continue;
+        }
+
+        // Topology discovery message
+        //
+        if (0 == send1905TopologyDiscoveryPacket(ifs_names[i], mid))
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("Could not send 1905 topology discovery message\n");
+        }
+
+        // 802.1 bridge discovery message
+        //
+        if (0 == sendLLDPBridgeDiscoveryPacket(ifs_names[i]))
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("Could not send LLDP bridge discovery message\n");
+        }
+    }
+    free_LIST_OF_1905_INTERFACES(ifs_names, ifs_nr);
+}
+
+static void _metricsSamplerTimerCallback(struct timerWheelTimer *timer, void *data)
+{
+    // The local device metrics are marked as dirty once the new sample is
+    // published
+    //
+    metricsSamplerRun(*(uint8_t *)data);
+}
+
+static void _garbageCollectorTimerCallback(struct timerWheelTimer *timer, void *data)
+{
+    PLATFORM_PRINTF_DEBUG_DETAIL("Running garbage collector...\n");
+
+    {
+        struct reassemblyStats stats;
+
+        reassemblyExpire();
+        reassemblyGetStats(&stats);
+
+        PLATFORM_PRINTF_DEBUG_DETAIL("Fragmented CMDUs: %u completed, %u evicted, %u timed out, %u fragments dropped, %u in flight\n",
+                                     stats.completed, stats.evicted, stats.timed_out, stats.dropped, stats.in_flight);
+        PLATFORM_PRINTF_DEBUG_DETAIL("Duplicates cache: %u hits, %u misses, %u entries\n",
+                                     duplicates_log.hits, duplicates_log.misses, duplicates_log.total);
+    }
+    {
+        uint32_t hits, misses;
+
+        getFrameCacheStats(&hits, &misses);
+
+        PLATFORM_PRINTF_DEBUG_DETAIL("Frames cache: %u hits, %u misses\n", hits, misses);
+    }
+    {
+        uint32_t sent, coalesced, timed_out, scheduled;
+
+        topologyQueryStats(&sent, &coalesced, &timed_out, &scheduled);
+
+        PLATFORM_PRINTF_DEBUG_DETAIL("Topology queries: %u sent, %u coalesced, %u timed out, %u scheduled\n", sent, coalesced, timed_out, scheduled);
+    }
+
+    if (DMrunGarbageCollector() > 0)
+    {
+        uint16_t mid;
+
+        char **ifs_names;
+        uint8_t  ifs_nr;
+
+        uint8_t  i;
+
+        PLATFORM_PRINTF_DEBUG_DETAIL("Some elements were removed. Sending a topology change notification...");
+
+        markLocalDeviceDataDirty(LOCAL_DEVICE_DATA_NEIGHBORS | LOCAL_DEVICE_DATA_METRICS);
+
+        // According to "Section 8.2.2.3" and "Section
+        // 7.2", we now have to send a "Topology
+        // Notification message) on all *authenticated*
+        // interfaces that are in the state of "PWR_ON" or
+        // "PWR_SAVE"
+        //
+        ifs_names = PLATFORM_GET_LIST_OF_1905_INTERFACES(&ifs_nr);
+        mid       = getNextMid();
+        for (i=0; i<ifs_nr; i++)
+        {
+            uint8_t authenticated;
+            uint8_t power_state;
+
+            struct interfaceInfo *x;
+
+            x = PLATFORM_GET_1905_INTERFACE_INFO(ifs_names[i]);
+            if (NULL == x)
+            {
+                PLATFORM_PRINTF_DEBUG_WARNING("Could not retrieve info of interface %s\n", ifs_names[i]);
+                authenticated = 0;
+                power_state   = INTERFACE_POWER_STATE_OFF;
+            }
+            else
+            {
+                authenticated = x->is_secured;
+                power_state   = x->power_state;
+
+                free_1905_INTERFACE_INFO(x);
+            }
+
+            if (
+                (0 == authenticated                                                                     ) ||
+                ((power_state != INTERFACE_POWER_STATE_ON) && (power_state!= INTERFACE_POWER_STATE_SAVE))
+               )
+            {
+                // Do not send the topology notification  messages on
+                // this interface
+                //
+                continue;
+            }
+
+            // Topology notification message
+            //
+            if (0 == send1905TopologyNotificationPacket(ifs_names[i], mid))
+            {
+                PLATFORM_PRINTF_DEBUG_WARNING("Could not send 1905 topology discovery message\n");
+            }
+        }
+        free_LIST_OF_1905_INTERFACES(ifs_names, ifs_nr);
+    }
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Public functions
 ////////////////////////////////////////////////////////////////////////////////
 
+void set1905ALReassemblyLimits(uint32_t max_cmdus_in_flight, uint8_t max_fragments_per_cmdu, uint32_t timeout_ms)
+{
+    reassemblySetLimits(max_cmdus_in_flight, max_fragments_per_cmdu, timeout_ms);
+}
+
 uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, char *registrar_interface)
 {
     uint8_t   queue_id;
@@ -987,6 +959,15 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
         free_1905_INTERFACE_INFO(x);
     }
 
+    // Both the registrar (M2) and the enrollees (M1) need a new DH key pair
+    // for each WSC exchange. Let the platform start preparing them now so that
+    // onboarding a new device does not have to wait for it.
+    //
+    if (0 == PLATFORM_PREPARE_DH_KEY_PAIRS())
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("DH key pairs will be generated on demand\n");
+    }
+
     // Create a queue that will later be used by the platform code to notify us
     // when certain types of "events" take place
     //
@@ -1022,15 +1003,15 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
     }
     free_LIST_OF_1905_INTERFACES(interfaces_names, interfaces_nr);
 
-    // We are also interested in processing a 60 seconds timeout event (so that
-    // we can send new discovery messages into the network)
+    // All AL timers run on a timer wheel driven by one single periodic
+    // platform timer
     //
-    PLATFORM_PRINTF_DEBUG_DETAIL("Registering DISCOVERY time out event (periodic)...\n");
+    PLATFORM_PRINTF_DEBUG_DETAIL("Registering TIMER WHEEL time out event (periodic)...\n");
     {
         struct eventTimeOut aux;
 
-        aux.timeout_ms = 60000;  // 60 seconds
-        aux.token      = TIMER_TOKEN_DISCOVERY;
+        aux.timeout_ms = TIMER_WHEEL_TICK_MS;
+        aux.token      = TIMER_TOKEN_WHEEL;
 
         if (0 == PLATFORM_REGISTER_QUEUE_EVENT(queue_id, PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC, &aux))
         {
@@ -1039,45 +1020,27 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
         }
     }
 
-    // ...and a slighlty higher timeout to "clean" the database from nodes that
-    // have left the network without notice
+    // We are interested in processing a 60 seconds timeout event (so that we
+    // can send new discovery messages into the network).
     //
-    PLATFORM_PRINTF_DEBUG_DETAIL("Registering GARBAGE COLLECTOR time out event (periodic)...\n");
-    {
-        struct eventTimeOut aux;
-
-        aux.timeout_ms = 70000;  // 70 seconds
-        aux.token      = TIMER_TOKEN_GARBAGE_COLLECTOR;
-
-        if (0 == PLATFORM_REGISTER_QUEUE_EVENT(queue_id, PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC, &aux))
-        {
-            PLATFORM_PRINTF_DEBUG_ERROR("Could not register timer callback\n");
-            return AL_ERROR_OS;
-        }
-    }
-
     // As soon as we enter the queue message processing loop we want to start
-    // the discovery process as if a "DISCOVERY timeout" event had just
-    // happened.
-    // In other words, we want the first "DISCOVERY timeout" event to take place
-    // at t=0 and then every 60 seconds.
-    // In order to "force" this first event at t=0 we use a new timer event,
-    // but this time this is a one time (ie. non-periodic) timer which will
-    // time out in just one second from now.
+    // the discovery process, so the first "DISCOVERY timeout" event takes
+    // place right away (on the first tick) and then every 60 seconds.
     //
-    PLATFORM_PRINTF_DEBUG_DETAIL("Registering a one time forced DISCOVERY event...\n");
-    {
-        struct eventTimeOut aux;
+    timerWheelSetup(&discovery_timer, _discoveryTimerCallback, NULL);
+    timerWheelArm(&discovery_timer, 1, 60000);
 
-        aux.timeout_ms = 1;
-        aux.token      = TIMER_TOKEN_DISCOVERY;
+    // ...and a slighlty higher timeout to "clean" the database from nodes that
+    // have left the network without notice
+    //
+    timerWheelSetup(&garbage_collector_timer, _garbageCollectorTimerCallback, NULL);
+    timerWheelArm(&garbage_collector_timer, 70000, 70000);
 
-        if (0 == PLATFORM_REGISTER_QUEUE_EVENT(queue_id, PLATFORM_QUEUE_EVENT_TIMEOUT, &aux))
-        {
-            PLATFORM_PRINTF_DEBUG_ERROR("Could not register timer callback\n");
-            return AL_ERROR_OS;
-        }
-    }
+    // Link metrics are periodically sampled in the background so that metrics
+    // queries can be answered without having to ask the platform each time
+    //
+    timerWheelSetup(&metrics_sampler_timer, _metricsSamplerTimerCallback, &queue_id);
+    timerWheelArm(&metrics_sampler_timer, METRICS_SAMPLER_PERIOD_MS, METRICS_SAMPLER_PERIOD_MS);
 
     // Do also register the ALME interface (ie. we want ALME REQUEST messages to
     // be inserted into the queue so that we can process them)
@@ -1129,10 +1092,12 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
         return AL_ERROR_PROTOCOL_EXTENSION;
     }
 
-    // Prepare the message queue
+    // Prepare the CMDUs arena
     //
-    PLATFORM_PRINTF_DEBUG_DETAIL("Allocating memory to hold a queue message...\n");
-    queue_message = (uint8_t *)memalloc(MAX_NETWORK_SEGMENT_SIZE+3);
+    cmdu_arena = memArenaCreate(CMDU_ARENA_CHUNK_SIZE);
+
+    duplicates_log.entries = (struct _duplicatesLogEntry *)memalloc(sizeof(struct _duplicatesLogEntry) * DUPLICATES_LOG_ENTRIES);
+    duplicates_log.index   = hashTableCreate(6+2, DUPLICATES_LOG_ENTRIES);
 
     PLATFORM_PRINTF_DEBUG_DETAIL("Entering read-process loop...\n");
     while(1)
@@ -1143,7 +1108,7 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
 
         PLATFORM_PRINTF_DEBUG_DETAIL("\n");
         PLATFORM_PRINTF_DEBUG_DETAIL("Waiting for new queue message...\n");
-        if (0 == PLATFORM_READ_QUEUE(queue_id, queue_message))
+        if (NULL == (queue_message = PLATFORM_READ_QUEUE_NOCOPY(queue_id)))
         {
             PLATFORM_PRINTF_DEBUG_WARNING("Something went wrong while trying to retrieve a new message from the queue. Ignoring...\n");
             continue;
@@ -1227,8 +1192,11 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
                         }
                         else
                         {
-                            PLATFORM_PRINTF_DEBUG_DETAIL("LLDP message contents:\n");
-                            visit_lldp_PAYLOAD_structure(payload, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+                            if (1 == PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+                            {
+                                PLATFORM_PRINTF_DEBUG_DETAIL("LLDP message contents:\n");
+                                visit_lldp_PAYLOAD_structure(payload, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+                            }
 
                             processLlpdPayload(payload, receiving_interface_addr);
 
@@ -1240,51 +1208,82 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
 
                     case ETHERTYPE_1905:
                     {
-                        struct CMDU *c;
+                        uint8_t          **streams;
+                        struct CMDU_view  *v;
+                        struct CMDU       *c;
 
                         PLATFORM_PRINTF_DEBUG_DETAIL("CMDU message received. Reassembling...\n");
 
-                        c = _reAssembleFragmentedCMDUs(p, message_len);
+                        streams = reassemblyAddFragment(p, message_len);
 
-                        if (NULL == c)
+                        if (NULL == streams)
                         {
                             // This was just a fragment part of a big CMDU.
                             // The data has been internally cached, waiting for
                             // the rest of pieces.
+                            //
+                            break;
+                        }
+
+                        // Only the CMDU header and the list of TLVs are
+                        // looked at. TLVs are only parsed (into regular
+                        // structures) when they are going to be stored, or
+                        // when the whole CMDU has to be printed or forwarded.
+                        //
+                        v = parse_1905_CMDU_view_from_packets(streams);
+                        if (NULL == v)
+                        {
+                            PLATFORM_PRINTF_DEBUG_WARNING("parse_1905_CMDU_view_from_packets() failed\n");
+                        }
+                        else if (
+                                  1 == _checkDuplicates(src_addr, v)
+                                )
+                        {
+                            PLATFORM_PRINTF_DEBUG_WARNING("Receiving on %s a CMDU which is a duplicate of a previous one (mid = %d). Discarding...\n", receiving_interface_name, v->message_id);
                         }
                         else
                         {
-                            if (
-                                 1 == _checkDuplicates(src_addr, c)
-                               )
+                            uint8_t res;
+
+                            if (1 == PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
                             {
-                               PLATFORM_PRINTF_DEBUG_WARNING("Receiving on %s a CMDU which is a duplicate of a previous one (mid = %d). Discarding...\n", receiving_interface_name, c->message_id);
+                                _printCMDU(v);
                             }
-                            else
-                            {
-                                uint8_t res;
 
-                                PLATFORM_PRINTF_DEBUG_DETAIL("CMDU message contents:\n");
-                                visit_1905_CMDU_structure(c, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+                            // Process the message on the local node
+                            //
+                            res = process1905Cmdu(v, receiving_interface_addr, src_addr, queue_id);
+                            if (PROCESS_CMDU_OK_TRIGGER_AP_SEARCH == res)
+                            {
+                                _triggerAPSearchProcess();
+                            }
 
-                                // Process the message on the local node
-                                //
-                                res = process1905Cmdu(c, receiving_interface_addr, src_addr, queue_id);
-                                if (PROCESS_CMDU_OK_TRIGGER_AP_SEARCH == res)
+                            // It might be necessary to retransmit this
+                            // message on the rest of interfaces (depending
+                            // on the "relayed multicast" flag). Malformed
+                            // CMDUs are not forwarded.
+                            //
+                            // The forwarded CMDU is extended (and forged) by
+                            // the sending code, so it lives on the heap.
+                            //
+                            if (1 == v->relay_indicator)
+                            {
+                                c = materialize_1905_CMDU_view(v);
+                                if (NULL == c)
                                 {
-                                    _triggerAPSearchProcess();
+                                    PLATFORM_PRINTF_DEBUG_WARNING("Malformed CMDU. Not forwarding it\n");
+                                }
+                                else
+                                {
+                                    _checkForwarding(receiving_interface_addr, dst_addr, c);
+                                    free_1905_CMDU_structure(c);
                                 }
-
-                                // It might be necessary to retransmit this
-                                // message on the rest of interfaces (depending
-                                // on the "relayed multicast" flag
-                                //
-                                _checkForwarding(receiving_interface_addr, dst_addr, c);
                             }
-
-                            free_1905_CMDU_structure(c);
                         }
 
+                        free_1905_CMDU_view(v);
+                        free_1905_CMDU_packets(streams);
+
                         break;
                     }
 
@@ -1346,137 +1345,9 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
 
                 switch(timer_id)
                 {
-                    case TIMER_TOKEN_DISCOVERY:
-                    {
-                        uint16_t mid;
-
-                        char **ifs_names;
-                        uint8_t  ifs_nr;
-
-                        // According to "Section 8.2.1.1" and "Section 8.2.1.2"
-                        // we now have to send a "Topology discovery message"
-                        // followed by a "802.1 bridge discovery message" but,
-                        // according to the rules in "Section 7.2", only on each
-                        // and every of the *authenticated* 1905 interfaces
-                        // that are in the state of "PWR_ON" or "PWR_SAVE"
-                        //
-                        ifs_names = PLATFORM_GET_LIST_OF_1905_INTERFACES(&ifs_nr);
-                        mid       = getNextMid();
-                        for (i=0; i<ifs_nr; i++)
-                        {
-                            uint8_t authenticated;
-                            uint8_t power_state;
-
-                            struct interfaceInfo *x;
-
-                            x = PLATFORM_GET_1905_INTERFACE_INFO(ifs_names[i]);
-                            if (NULL == x)
-                            {
-                                PLATFORM_PRINTF_DEBUG_WARNING("Could not retrieve info of interface %s\n", ifs_names[i]);
-                                authenticated = 0;
-                                power_state   = INTERFACE_POWER_STATE_OFF;
-                            }
-                            else
-                            {
-                                authenticated = x->is_secured;
-                                power_state   = x->power_state;
-
-                                free_1905_INTERFACE_INFO(x);
-                            }
-
-                            if (
-                                (0 == authenticated                                                                     ) ||
-                                ((power_state != INTERFACE_POWER_STATE_ON) && (power_state!= INTERFACE_POWER_STATE_SAVE))
-                               )
-                            {
-                                // Do not send the discovery messages on this
-                                // interface
-                                //
-                                continue;
-                            }
-
-                            // Topology discovery message
-                            //
-                            if (0 == send1905TopologyDiscoveryPacket(ifs_names[i], mid))
-                            {
-                                PLATFORM_PRINTF_DEBUG_WARNING("Could not send 1905 topology discovery message\n");
-                            }
-
-                            // 802.1 bridge discovery message
-                            //
-                            if (0 == sendLLDPBridgeDiscoveryPacket(ifs_names[i]))
-                            {
-                                PLATFORM_PRINTF_DEBUG_WARNING("Could not send LLDP bridge discovery message\n");
-                            }
-                        }
-                        free_LIST_OF_1905_INTERFACES(ifs_names, ifs_nr);
-
-                        break;
-                    }
-
-                    case TIMER_TOKEN_GARBAGE_COLLECTOR:
+                    case TIMER_TOKEN_WHEEL:
                     {
-                        PLATFORM_PRINTF_DEBUG_DETAIL("Running garbage collector...\n");
-
-                        if (DMrunGarbageCollector() > 0)
-                        {
-                            uint16_t mid;
-
-                            char **ifs_names;
-                            uint8_t  ifs_nr;
-
-                            PLATFORM_PRINTF_DEBUG_DETAIL("Some elements were removed. Sending a topology change notification...");
-
-                            // According to "Section 8.2.2.3" and "Section
-                            // 7.2", we now have to send a "Topology
-                            // Notification message) on all *authenticated*
-                            // interfaces that are in the state of "PWR_ON" or
-                            // "PWR_SAVE"
-                            //
-                            ifs_names = PLATFORM_GET_LIST_OF_1905_INTERFACES(&ifs_nr);
-                            mid       = getNextMid();
-                            for (i=0; i<ifs_nr; i++)
-                            {
-                                uint8_t authenticated;
-                                uint8_t power_state;
-
-                                struct interfaceInfo *x;
-
-                                x = PLATFORM_GET_1905_INTERFACE_INFO(ifs_names[i]);
-                                if (NULL == x)
-                                {
-                                    PLATFORM_PRINTF_DEBUG_WARNING("Could not retrieve info of interface %s\n", ifs_names[i]);
-                                    authenticated = 0;
-                                    power_state   = INTERFACE_POWER_STATE_OFF;
-                                }
-                                else
-                                {
-                                    authenticated = x->is_secured;
-                                    power_state   = x->power_state;
-
-                                    free_1905_INTERFACE_INFO(x);
-                                }
-
-                                if (
-                                    (0 == authenticated                                                                     ) ||
-                                    ((power_state != INTERFACE_POWER_STATE_ON) && (power_state!= INTERFACE_POWER_STATE_SAVE))
-                                   )
-                                {
-                                    // Do not send the topology notification  messages on
-                                    // this interface
-                                    //
-                                    continue;
-                                }
-
-                                // Topology notification message
-                                //
-                                if (0 == send1905TopologyNotificationPacket(ifs_names[i], mid))
-                                {
-                                    PLATFORM_PRINTF_DEBUG_WARNING("Could not send 1905 topology discovery message\n");
-                                }
-                            }
-                            free_LIST_OF_1905_INTERFACES(ifs_names, ifs_nr);
-                        }
+                        timerWheelAdvance(PLATFORM_GET_TIMESTAMP());
                         break;
                     }
 
@@ -1502,6 +1373,8 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
 
                 PLATFORM_PRINTF_DEBUG_DETAIL("New queue message arrived: push button event\n");
 
+                markLocalDeviceDataDirty(LOCAL_DEVICE_DATA_INTERFACES);
+
                 // According to "Section 9.2.2.1", we must first make sure that
                 // none of the interfaces is in the middle of a previous "push
                 // button" configuration sequence.
@@ -1724,6 +1597,8 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
                 char **ifs_names;
                 uint8_t  ifs_nr;
 
+                markLocalDeviceDataDirty(LOCAL_DEVICE_DATA_INTERFACES);
+
                 // The first six bytes of the message payload contain the MAC
                 // address of the interface where the "push button"
                 // configuration process succeeded.
@@ -1845,6 +1720,8 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
 
                 PLATFORM_PRINTF_DEBUG_DETAIL("New queue message arrived: topology change notification event\n");
 
+                markLocalDeviceDataDirty(LOCAL_DEVICE_DATA_INTERFACES | LOCAL_DEVICE_DATA_NEIGHBORS | LOCAL_DEVICE_DATA_METRICS);
+
                 // TODO:
                 //   1. Find which L2 neighbors are no longer available
                 //   2. Set their timestamp to 0
@@ -1852,7 +1729,7 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
                 //      database
                 //
                 // Until this is done, nodes will only be removed from the
-                // database when the "TIMER_TOKEN_GARBAGE_COLLECTOR" timer
+                // database when the "garbage_collector_timer" timer
                 // expires.
 
                 // According to "Section 8.2.2.3" and "Section 7.2", we now
@@ -1907,6 +1784,28 @@ uint8_t start1905AL(uint8_t *al_mac_address, uint8_t map_whole_network_flag, cha
                 break;
             }
 
+            case PLATFORM_QUEUE_EVENT_WORK_DONE:
+            {
+                // Some work that was run in the background (see
+                // "PLATFORM_RUN_IN_BACKGROUND()") has finished. Let its
+                // owner consume the result.
+                //
+                struct eventWorkDone w;
+
+                PLATFORM_PRINTF_DEBUG_DETAIL("New queue message arrived: background work done\n");
+
+                if (message_len != sizeof(struct eventWorkDone))
+                {
+                    PLATFORM_PRINTF_DEBUG_WARNING("Invalid 'work done' message length (%d)\n", message_len);
+                    break;
+                }
+                memcpy(&w, &queue_message[3], sizeof(struct eventWorkDone));
+
+                w.done(w.data);
+
+                break;
+            }
+
             default:
             {
                 PLATFORM_PRINTF_DEBUG_WARNING("Unknown queue message type (%d)\n", message_type);
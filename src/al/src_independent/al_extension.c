@@ -69,8 +69,8 @@ struct _ieee1905CmduExtension
     struct _cmduExtension
     {
         char name[MAX_EXTENSION_NAME_LEN];
-        CMDU_EXTENSION_CBK process;
-        CMDU_EXTENSION_CBK send;
+        CMDU_VIEW_EXTENSION_CBK process;
+        CMDU_EXTENSION_CBK      send;
 
     } *entries;
 
@@ -108,12 +108,12 @@ struct _ieee1905DmExtension
 // - free1905CmduExtensions()   : Free no longer used resources allocated by
 //                                send1905CmduExtensions().
 //
-uint8_t process1905CmduExtensions(struct CMDU *c)
+uint8_t process1905CmduExtensions(struct CMDU_view *v)
 {
     uint32_t                          i;
     struct _ieee1905CmduExtension  *t;
 
-    if (NULL == c)
+    if (NULL == v)
     {
         return 0;
     }
@@ -126,7 +126,7 @@ uint8_t process1905CmduExtensions(struct CMDU *c)
         {
             if (NULL != t->entries[i].process)
             {
-                t->entries[i].process(c);
+                t->entries[i].process(v);
             }
         }
     }
@@ -187,9 +187,9 @@ uint8_t free1905CmduExtensions(struct CMDU *c)
 
             if (vs_tlv->m)
             {
-                free(vs_tlv->m);
+                memfree(vs_tlv->m);
             }
-            free(vs_tlv);
+            memfree(vs_tlv);
         }
         i++;
     }
@@ -469,7 +469,7 @@ struct vendorSpecificTLV *vendorSpecificTLVDuplicate(struct vendorSpecificTLV *t
 //                                    'dnd' extended info response
 //
 uint8_t register1905CmduExtension(char *name,
-                                CMDU_EXTENSION_CBK process,
+                                CMDU_VIEW_EXTENSION_CBK process,
                                 CMDU_EXTENSION_CBK send)
 {
     uint32_t                          i;
@@ -62,6 +62,10 @@
 // Insert, process, free third-party extensions in a CMDU
 typedef uint8_t (*CMDU_EXTENSION_CBK)(struct CMDU *);
 
+// Process third-party extensions in a received CMDU (whose TLVs have not been
+// parsed, see "parse_1905_CMDU_view_from_packets()")
+typedef uint8_t (*CMDU_VIEW_EXTENSION_CBK)(struct CMDU_view *);
+
 // Obtain third-party local node informatiom
 typedef void  (*DM_OBTAIN_LOCAL_INFO_CBK)(struct vendorSpecificTLV ***extensions,
                                           uint8_t                      *nr);
@@ -98,12 +102,14 @@ typedef void  (*DM_EXTENSION_CBK)(uint8_t **memory_structure,
 // Each registered 'process' callback is responsible for processing its own
 // non-standard TLVs.
 //
-// 'c' is the CMDU structure which contains a list of TLVs. This 'c' pointer
-// will be passed as argument to all the registered 'process' callbacks.
+// 'v' is the view of the received CMDU, which contains the list of (not yet
+// parsed) TLVs. This 'v' pointer will be passed as argument to all the
+// registered 'process' callbacks, which must call
+// "materialize_1905_TLV_view()" on those TLVs they want to look into.
 //
 // Return '0' if there was a problem, '1' otherwise.
 //
-uint8_t process1905CmduExtensions(struct CMDU *c);
+uint8_t process1905CmduExtensions(struct CMDU_view *v);
 
 // This funtion runs through all the registered 'send' callbacks.
 // Each registered 'send' callback is responsible for adding its own
@@ -238,7 +244,8 @@ uint8_t vendorSpecificTLVInsertInCDMU(struct CMDU *memory_structure, struct vend
 //
 // In this regard, it is the third-party developer responsibility to clone the
 // original Vendor Specific TLV and update the datamodel extension section with
-// it.
+// it. (When processing a received CMDU, which is only available as a view, use
+// "materialize_1905_TLV_view()" instead: it already returns a new copy)
 //
 // 'tlv' is the original TLV
 //
@@ -275,14 +282,14 @@ uint8_t start1905ALExtensions(void);
 // 'name' is the name assigned by the extension group (ex. BBF).
 //
 // 'process' is a callback used to process non-standard TLVs inside the incoming
-// CMDU
+// CMDU (it receives a view of the CMDU, not the parsed structure)
 //
 // 'send' is a callback used to insert non-standard TLVs in the outgoig CMDU
 //
 // Return '0' if there was a problem, '1' otherwise.
 //
 uint8_t register1905CmduExtension(char *name,
-                                CMDU_EXTENSION_CBK process,
+                                CMDU_VIEW_EXTENSION_CBK process,
                                 CMDU_EXTENSION_CBK send);
 
 // This function registers the callbacks required to extend the ALME 'dnd'
@@ -0,0 +1,391 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+#include "platform.h"
+#include "utils.h"
+
+#include "1905_tlvs.h"
+
+#include "al_datamodel.h"
+#include "al_metrics.h"
+#include "al_send.h"
+
+#include "platform_interfaces.h"
+#include "platform_os.h"
+
+#include <string.h> // memcmp(), memcpy(), ...
+
+////////////////////////////////////////////////////////////////////////////////
+// Private functions and data
+////////////////////////////////////////////////////////////////////////////////
+
+struct _snapshot
+{
+    uint32_t                  timestamp;  // When the sample was started
+    uint16_t                  links_nr;
+    uint16_t                  links_max;  // Allocated size of 'links'
+    struct linkMetricsSample *links;
+
+    struct hashTable         *index;      // Local + neighbor interface MAC
+                                          // addresses (12 bytes) -> entry of
+                                          // 'links'
+};
+
+static struct
+{
+    struct _snapshot  buffers[2];
+    uint8_t           current;            // Index of the snapshot served to
+                                          // readers
+    uint8_t           busy;               // Set while a sample is being taken
+                                          // in the background
+} sampler;
+
+// Everything a background sample needs. It is filled from the AL main thread
+// (which is the only one allowed to read the data model) before the work is
+// handed over.
+//
+struct _samplerWork
+{
+    struct _snapshot *snapshot;           // Where the new sample is written
+    struct _snapshot *previous;           // Sample currently being served
+                                          // (only read, to compute deltas)
+
+    uint16_t          links_nr;
+    struct _linkToSample
+    {
+        char     *local_interface_name;
+        uint8_t   local_interface_address[6];
+        uint8_t   neighbor_interface_address[6];
+
+    }                *links;
+};
+
+// Return the link in 'snapshot' going from 'local_interface_address' to
+// 'neighbor_interface_address' or NULL if there is none
+//
+static struct linkMetricsSample *_findLink(struct _snapshot *snapshot, uint8_t *local_interface_address, uint8_t *neighbor_interface_address)
+{
+    uint8_t key[12];
+
+    if (NULL == snapshot->index)
+    {
+        return NULL;
+    }
+
+    memcpy(&key[0], local_interface_address,    6);
+    memcpy(&key[6], neighbor_interface_address, 6);
+
+    return (struct linkMetricsSample *)hashTableFind(snapshot->index, key);
+}
+
+// Return how much a counter has increased from 'previous' to 'now'. If it
+// went backwards (ex: the interface was restarted) it is assumed to have
+// started again from zero.
+//
+static uint32_t _counterDelta(uint32_t previous, uint32_t now)
+{
+    if (now < previous)
+    {
+        return now;
+    }
+    return now - previous;
+}
+
+// Fill the "*_delta" and "*_rate" fields of 'l' given the 'previous' sample of
+// the same link, taken 'interval_ms' milliseconds before (or NULL if there is
+// none)
+//
+static void _computeDeltas(struct linkMetricsSample *l, struct linkMetricsSample *previous, uint32_t interval_ms)
+{
+    if (NULL == previous || 0 == interval_ms)
+    {
+        l->interval_ms            = 0;
+        l->tx_packet_ok_delta     = 0;
+        l->tx_packet_errors_delta = 0;
+        l->rx_packet_ok_delta     = 0;
+        l->rx_packet_errors_delta = 0;
+        l->tx_packet_ok_rate      = 0;
+        l->rx_packet_ok_rate      = 0;
+
+        return;
+    }
+
+    l->interval_ms            = interval_ms;
+    l->tx_packet_ok_delta     = _counterDelta(previous->metrics.tx_packet_ok,     l->metrics.tx_packet_ok);
+    l->tx_packet_errors_delta = _counterDelta(previous->metrics.tx_packet_errors, l->metrics.tx_packet_errors);
+    l->rx_packet_ok_delta     = _counterDelta(previous->metrics.rx_packet_ok,     l->metrics.rx_packet_ok);
+    l->rx_packet_errors_delta = _counterDelta(previous->metrics.rx_packet_errors, l->metrics.rx_packet_errors);
+
+    l->tx_packet_ok_rate      = (uint32_t)(((uint64_t)l->tx_packet_ok_delta * 1000) / interval_ms);
+    l->rx_packet_ok_rate      = (uint32_t)(((uint64_t)l->rx_packet_ok_delta * 1000) / interval_ms);
+}
+
+// Append the sample of link 'link' to 'snapshot', computing how much its
+// counters have changed since the 'previous' snapshot
+//
+// 'snapshot->links' must already be large enough to hold it.
+//
+// This function runs on a background thread: it must only use the platform
+// and the two snapshots (never the data model).
+//
+static void _sampleLink(struct _snapshot *snapshot, struct _snapshot *previous, struct _linkToSample *link)
+{
+    struct linkMetricsSample *l;
+    struct interfaceInfo     *f;
+    struct linkMetrics       *m;
+    uint8_t                   key[12];
+
+    memcpy(&key[0], link->local_interface_address,    6);
+    memcpy(&key[6], link->neighbor_interface_address, 6);
+
+    if (NULL != hashTableFind(snapshot->index, key))
+    {
+        // Already sampled (the same link can be reported by more than one
+        // neighbor while the database is being updated)
+        //
+        return;
+    }
+
+    l = &snapshot->links[snapshot->links_nr++];
+    hashTableInsert(snapshot->index, key, l);
+
+    memcpy(l->local_interface_address,    link->local_interface_address,    6);
+    memcpy(l->neighbor_interface_address, link->neighbor_interface_address, 6);
+
+    f = PLATFORM_GET_1905_INTERFACE_INFO(link->local_interface_name);
+    if (NULL == f)
+    {
+        l->intf_type = MEDIA_TYPE_UNKNOWN;
+    }
+    else
+    {
+        l->intf_type = f->interface_type;
+        free_1905_INTERFACE_INFO(f);
+    }
+
+    m = PLATFORM_GET_LINK_METRICS(link->local_interface_name, link->neighbor_interface_address);
+    if (NULL == m)
+    {
+        memset(&l->metrics, 0, sizeof(l->metrics));
+        memcpy(l->metrics.local_interface_address,    link->local_interface_address,    6);
+        memcpy(l->metrics.neighbor_interface_address, link->neighbor_interface_address, 6);
+    }
+    else
+    {
+        l->metrics = *m;
+        free_LINK_METRICS(m);
+    }
+
+    _computeDeltas(l, _findLink(previous, link->local_interface_address, link->neighbor_interface_address), snapshot->timestamp - previous->timestamp);
+}
+
+// Background part of "metricsSamplerRun()": query the platform for every link
+// in 'data' (a "struct _samplerWork") and write the result into the back
+// snapshot
+//
+static void _samplerWork(void *data)
+{
+    struct _samplerWork *w = (struct _samplerWork *)data;
+    struct _snapshot    *s = w->snapshot;
+    uint16_t             i;
+
+    s->timestamp = PLATFORM_GET_TIMESTAMP();
+    s->links_nr  = 0;
+
+    if (NULL == s->index)
+    {
+        s->index = hashTableCreate(12, 0);
+    }
+    else
+    {
+        hashTableClear(s->index);
+    }
+
+    // Make room for all the links beforehand, so that the entries pointed to
+    // by 'index' never move while the sample is being taken
+    //
+    if (s->links_max < w->links_nr)
+    {
+        s->links_max = w->links_nr;
+        s->links     = (struct linkMetricsSample *)memrealloc(s->links, sizeof(struct linkMetricsSample) * s->links_max);
+    }
+
+    for (i=0; i<w->links_nr; i++)
+    {
+        _sampleLink(s, w->previous, &w->links[i]);
+    }
+}
+
+// Main thread part of "metricsSamplerRun()", called once "_samplerWork()" has
+// finished: start serving the new sample
+//
+static void _samplerDone(void *data)
+{
+    struct _samplerWork *w = (struct _samplerWork *)data;
+    uint16_t             i;
+
+    // Links that no longer exist are simply not part of the new sample
+    //
+    sampler.current = 1 - sampler.current;
+    sampler.busy    = 0;
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("Link metrics sampled (%d links)\n", w->snapshot->links_nr);
+
+    for (i=0; i<w->links_nr; i++)
+    {
+        free(w->links[i].local_interface_name);
+    }
+    free(w->links);
+    free(w);
+
+    markLocalDeviceDataDirty(LOCAL_DEVICE_DATA_METRICS);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions (exported only to files in this same folder)
+////////////////////////////////////////////////////////////////////////////////
+
+void metricsSamplerRun(uint8_t queue_id)
+{
+    struct _samplerWork *w;
+
+    uint8_t (*al_mac_addresses)[6];
+    uint16_t  al_mac_addresses_nr;
+
+    uint16_t i, j;
+
+    if (sampler.busy)
+    {
+        // The previous sample has not finished yet (the platform is taking
+        // longer than a whole period to report the metrics). Skip this one.
+        //
+        PLATFORM_PRINTF_DEBUG_DETAIL("Link metrics sampler still busy. Skipping this period\n");
+        return;
+    }
+
+    // Collect the list of links now, as the data model can only be read from
+    // this thread
+    //
+    w = (struct _samplerWork *)memalloc(sizeof(struct _samplerWork));
+    w->snapshot = &sampler.buffers[1 - sampler.current];
+    w->previous = &sampler.buffers[sampler.current];
+    w->links_nr = 0;
+    w->links    = NULL;
+
+    al_mac_addresses = DMgetListOfNeighbors(&al_mac_addresses_nr);
+
+    for (i=0; i<al_mac_addresses_nr; i++)
+    {
+        uint8_t  (*remote_macs)[6];
+        char   **local_interfaces;
+        uint8_t    links_nr;
+
+        remote_macs = DMgetListOfLinksWithNeighbor(al_mac_addresses[i], &local_interfaces, &links_nr);
+
+        for (j=0; j<links_nr; j++)
+        {
+            struct _linkToSample *l;
+            uint8_t              *local_interface_address;
+
+            local_interface_address = DMinterfaceNameToMac(local_interfaces[j]);
+            if (NULL == local_interface_address)
+            {
+                continue;
+            }
+
+            w->links = (struct _linkToSample *)memrealloc(w->links, sizeof(struct _linkToSample) * (w->links_nr + 1));
+            l        = &w->links[w->links_nr++];
+
+            l->local_interface_name = strdup(local_interfaces[j]);
+            memcpy(l->local_interface_address,    local_interface_address, 6);
+            memcpy(l->neighbor_interface_address, remote_macs[j],          6);
+        }
+
+        DMfreeListOfLinksWithNeighbor(remote_macs, local_interfaces, links_nr);
+    }
+
+    free(al_mac_addresses);
+
+    // The platform calls (one or more system calls per link) are made on a
+    // background thread. The snapshot being served is not touched until
+    // "_samplerDone()" swaps both of them.
+    //
+    sampler.busy = 1;
+
+    if (0 == PLATFORM_RUN_IN_BACKGROUND(queue_id, _samplerWork, _samplerDone, w))
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("Could not use a background thread. Sampling link metrics in the foreground\n");
+
+        _samplerWork(w);
+        _samplerDone(w);
+    }
+}
+
+uint32_t metricsSamplerTimestamp(uint16_t *links_nr)
+{
+    struct _snapshot *s = &sampler.buffers[sampler.current];
+
+    if (NULL != links_nr)
+    {
+        *links_nr = s->links_nr;
+    }
+
+    return s->timestamp;
+}
+
+struct linkMetricsSample *metricsSamplerLookup(uint8_t *local_interface_address, uint8_t *neighbor_interface_address)
+{
+    if (NULL == local_interface_address || NULL == neighbor_interface_address)
+    {
+        return NULL;
+    }
+
+    return _findLink(&sampler.buffers[sampler.current], local_interface_address, neighbor_interface_address);
+}
@@ -0,0 +1,131 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+#ifndef _AL_METRICS_H_
+#define _AL_METRICS_H_
+
+#include "platform_interfaces.h"
+
+// Link metrics (see "Section 6.4.10" and "Section 6.4.11") of the links that
+// join the local node with its 1905 neighbors are needed every time a
+// "link metric query" or an ALME "get metric" request arrives, and every time
+// the local device information in the database is refreshed.
+//
+// Instead of asking the platform for them each time (which might imply one or
+// more system calls per link), this module samples all of them every
+// METRICS_SAMPLER_PERIOD_MS milliseconds (the caller is responsible for
+// calling "metricsSamplerRun()" that often) and keeps the result in memory.
+// The platform is queried from a background thread, so that the AL main loop
+// is not blocked while the sample is being taken.
+//
+// Two snapshots are kept: the one being served to readers and the one the next
+// sample is written into. Once a sample is complete both are swapped, so that
+// readers never see a half updated snapshot, and the previous sample is still
+// around to compute how much each counter has changed in between.
+//
+// The default period can be changed at build time (ex: by adding
+// "-DMETRICS_SAMPLER_PERIOD_MS=1000" to the compiler flags).
+//
+#ifndef METRICS_SAMPLER_PERIOD_MS
+#  define METRICS_SAMPLER_PERIOD_MS  (5000)
+#endif
+
+struct linkMetricsSample
+{
+    uint8_t   local_interface_address[6];     // Local end of the link ("A")
+    uint8_t   neighbor_interface_address[6];  // Remote end of the link ("B")
+
+    uint16_t  intf_type;                      // One of the "MEDIA_TYPE_*" values
+                                              // of the local interface
+
+    struct linkMetrics metrics;               // What the platform reported
+
+    // Changes since the previous sample of this same link. They are all set
+    // to zero the first time a link is sampled. If a counter is smaller than
+    // in the previous sample (ex: because the interface was restarted) its new
+    // value is taken as the delta.
+    //
+    uint32_t  interval_ms;                    // Time between both samples
+    uint32_t  tx_packet_ok_delta;
+    uint32_t  tx_packet_errors_delta;
+    uint32_t  rx_packet_ok_delta;
+    uint32_t  rx_packet_errors_delta;
+    uint32_t  tx_packet_ok_rate;              // Packets per second
+    uint32_t  rx_packet_ok_rate;              // Packets per second
+};
+
+// Start taking a new sample of all the links with all the 1905 neighbors
+// currently present in the database.
+//
+// The platform is queried from a background thread. Once it is done, the AL
+// main thread (the one reading from queue 'queue_id') makes it the sample
+// returned by "metricsSamplerLookup()" and marks the local device metrics as
+// dirty (see "markLocalDeviceDataDirty()").
+// If the previous sample has not finished yet this call does nothing.
+//
+void metricsSamplerRun(uint8_t queue_id);
+
+// Timestamp (as returned by PLATFORM_GET_TIMESTAMP()) of the most recent
+// sample and number of links it contains (both are 0 if no sample has been
+// taken yet)
+//
+uint32_t metricsSamplerTimestamp(uint16_t *links_nr);
+
+// Return the most recent sample of the link between the local interface whose
+// MAC address is 'local_interface_address' and the neighbor interface whose MAC
+// address is 'neighbor_interface_address', or NULL if that link has not been
+// sampled yet.
+//
+// The returned pointer is only valid until the next sample is published (which
+// only happens on the AL main thread, while processing the queue) and must not
+// be freed.
+//
+struct linkMetricsSample *metricsSamplerLookup(uint8_t *local_interface_address, uint8_t *neighbor_interface_address);
+
+#endif
@@ -0,0 +1,350 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+#include "platform.h"
+#include "utils.h"
+
+#include "al_query.h"
+#include "al_send.h"
+#include "al_utils.h"
+#include "al_timers.h"
+
+#include "platform_crypto.h"
+
+#include <string.h> // memcmp(), memcpy(), ...
+
+////////////////////////////////////////////////////////////////////////////////
+// Private functions and data
+////////////////////////////////////////////////////////////////////////////////
+
+#define QUERY_STATE_WAITING      (0)  // Refresh delayed ('timer' not expired)
+#define QUERY_STATE_READY        (1)  // In the "ready" list, waiting for a token
+#define QUERY_STATE_OUTSTANDING  (2)  // Sent ('timer' is the response timeout)
+#define QUERY_STATE_ANSWERED     (3)  // Answered while still in the "ready"
+                                      // list (it will be freed, and not sent,
+                                      // once it reaches the head of the list)
+
+struct _query
+{
+    uint8_t                  al_mac_address[6];
+    char                    *interface_name;
+
+    uint8_t                  state;       // One of "QUERY_STATE_*"
+    struct timerWheelTimer   timer;
+
+    struct _query           *next;        // Next entry in the "ready" list
+};
+
+static struct
+{
+    uint8_t                  initialized;
+
+    struct hashTable        *index;       // AL MAC --> "struct _query *" (all
+                                          // queries except the "answered" ones)
+
+    struct _query           *ready_head;  // Queries waiting for a token, in the
+    struct _query           *ready_tail;  // same order they became ready
+
+    uint32_t                 tokens;      // In thousandths of a query
+    uint32_t                 last_refill; // Timestamp of the last update of
+                                          // 'tokens'
+
+    struct timerWheelTimer   drain_timer; // Armed while there are queries in
+                                          // the "ready" list but no tokens
+
+    uint32_t                 sent;
+    uint32_t                 coalesced;
+    uint32_t                 timed_out;
+} scheduler;
+
+static void _freeQuery(struct _query *q)
+{
+    free(q->interface_name);
+    free(q);
+}
+
+// Add the tokens accumulated since the last time this function was called
+//
+static void _refillTokens(void)
+{
+    uint32_t now;
+    uint32_t elapsed;
+
+    now     = PLATFORM_GET_TIMESTAMP();
+    elapsed = now - scheduler.last_refill;
+
+    if (elapsed >= (TOPOLOGY_QUERY_BURST * 1000) / TOPOLOGY_QUERY_RATE)
+    {
+        scheduler.tokens = TOPOLOGY_QUERY_BURST * 1000;
+    }
+    else
+    {
+        scheduler.tokens += elapsed * TOPOLOGY_QUERY_RATE;
+
+        if (scheduler.tokens > TOPOLOGY_QUERY_BURST * 1000)
+        {
+            scheduler.tokens = TOPOLOGY_QUERY_BURST * 1000;
+        }
+    }
+    scheduler.last_refill = now;
+}
+
+static void _readyPush(struct _query *q)
+{
+    q->state = QUERY_STATE_READY;
+    q->next  = NULL;
+
+    if (NULL == scheduler.ready_tail)
+    {
+        scheduler.ready_head = q;
+    }
+    else
+    {
+        scheduler.ready_tail->next = q;
+    }
+    scheduler.ready_tail = q;
+}
+
+static struct _query *_readyPop(void)
+{
+    struct _query *q;
+
+    if (NULL != (q = scheduler.ready_head))
+    {
+        scheduler.ready_head = q->next;
+        if (NULL == scheduler.ready_head)
+        {
+            scheduler.ready_tail = NULL;
+        }
+        q->next = NULL;
+    }
+
+    return q;
+}
+
+// Send as many queries from the "ready" list as the available tokens allow. If
+// some of them must wait, arm the "drain_timer" so that this function is
+// called again once there is at least one new token.
+//
+static void _drain(void)
+{
+    _refillTokens();
+
+    while (NULL != scheduler.ready_head && scheduler.tokens >= 1000)
+    {
+        struct _query *q;
+
+        q = _readyPop();
+
+        if (QUERY_STATE_ANSWERED == q->state)
+        {
+            _freeQuery(q);
+            continue;
+        }
+
+        scheduler.tokens -= 1000;
+
+        if (0 == send1905TopologyQueryPacket(q->interface_name, getNextMid(), q->al_mac_address))
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'topology query' message\n");
+
+            hashTableRemove(scheduler.index, q->al_mac_address);
+            _freeQuery(q);
+            continue;
+        }
+        scheduler.sent++;
+
+        q->state = QUERY_STATE_OUTSTANDING;
+        timerWheelArm(&q->timer, TOPOLOGY_QUERY_TIMEOUT_MS, 0);
+    }
+
+    if (NULL != scheduler.ready_head)
+    {
+        timerWheelArm(&scheduler.drain_timer, (1000 - scheduler.tokens) / TOPOLOGY_QUERY_RATE + 1, 0);
+    }
+}
+
+static void _drainTimerCallback(struct timerWheelTimer *timer, void *data)
+{
+    _drain();
+}
+
+// Callback of the 'timer' of each query: either its refresh delay is over or
+// no response arrived in time
+//
+static void _queryTimerCallback(struct timerWheelTimer *timer, void *data)
+{
+    struct _query *q;
+
+    q = (struct _query *)data;
+
+    if (QUERY_STATE_WAITING == q->state)
+    {
+        _readyPush(q);
+        _drain();
+    }
+    else if (QUERY_STATE_OUTSTANDING == q->state)
+    {
+        // Forget about it. A new query will be scheduled the next time this
+        // device is listed in a "topology response".
+        //
+        PLATFORM_PRINTF_DEBUG_DETAIL("Topology query to %02x:%02x:%02x:%02x:%02x:%02x timed out\n", q->al_mac_address[0], q->al_mac_address[1], q->al_mac_address[2], q->al_mac_address[3], q->al_mac_address[4], q->al_mac_address[5]);
+        scheduler.timed_out++;
+
+        hashTableRemove(scheduler.index, q->al_mac_address);
+        _freeQuery(q);
+    }
+}
+
+static void _init(void)
+{
+    if (1 == scheduler.initialized)
+    {
+        return;
+    }
+
+    scheduler.index       = hashTableCreate(6, 0);
+    scheduler.ready_head  = NULL;
+    scheduler.ready_tail  = NULL;
+    scheduler.tokens      = TOPOLOGY_QUERY_BURST * 1000;
+    scheduler.last_refill = PLATFORM_GET_TIMESTAMP();
+    scheduler.sent        = 0;
+    scheduler.coalesced   = 0;
+    scheduler.timed_out   = 0;
+
+    timerWheelSetup(&scheduler.drain_timer, _drainTimerCallback, NULL);
+
+    scheduler.initialized = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions (exported only to files in this same folder)
+////////////////////////////////////////////////////////////////////////////////
+
+uint8_t topologyQuerySchedule(char *interface_name, uint8_t *al_mac_address, uint8_t refresh)
+{
+    struct _query *q;
+
+    if (NULL == interface_name || NULL == al_mac_address)
+    {
+        return 0;
+    }
+
+    _init();
+
+    if (NULL != hashTableFind(scheduler.index, al_mac_address))
+    {
+        scheduler.coalesced++;
+        return 0;
+    }
+
+    q = (struct _query *)memalloc(sizeof(struct _query));
+
+    memcpy(q->al_mac_address, al_mac_address, 6);
+    q->interface_name = strdup(interface_name);
+    q->next           = NULL;
+
+    timerWheelSetup(&q->timer, _queryTimerCallback, q);
+
+    hashTableInsert(scheduler.index, al_mac_address, q);
+
+    if (1 == refresh)
+    {
+        uint32_t r = 0;
+
+        PLATFORM_GET_RANDOM_BYTES((uint8_t *)&r, sizeof(r));
+
+        q->state = QUERY_STATE_WAITING;
+        timerWheelArm(&q->timer, r % TOPOLOGY_QUERY_SPREAD_MS, 0);
+    }
+    else
+    {
+        _readyPush(q);
+        _drain();
+    }
+
+    return 1;
+}
+
+void topologyQueryAnswered(uint8_t *al_mac_address)
+{
+    struct _query *q;
+
+    if (0 == scheduler.initialized)
+    {
+        return;
+    }
+
+    if (NULL == (q = (struct _query *)hashTableRemove(scheduler.index, al_mac_address)))
+    {
+        return;
+    }
+
+    timerWheelCancel(&q->timer);
+
+    if (QUERY_STATE_READY == q->state)
+    {
+        // It cannot be removed from the middle of the "ready" list. It will be
+        // freed once it reaches the head.
+        //
+        q->state = QUERY_STATE_ANSWERED;
+    }
+    else
+    {
+        _freeQuery(q);
+    }
+}
+
+void topologyQueryStats(uint32_t *sent, uint32_t *coalesced, uint32_t *timed_out, uint32_t *scheduled)
+{
+    *sent      = scheduler.sent;
+    *coalesced = scheduler.coalesced;
+    *timed_out = scheduler.timed_out;
+    *scheduled = 1 == scheduler.initialized ? hashTableCount(scheduler.index) : 0;
+}
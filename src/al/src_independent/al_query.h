@@ -0,0 +1,121 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+#ifndef _AL_QUERY_H_
+#define _AL_QUERY_H_
+
+// When the "map whole network" mode is enabled (see "DMmapWholeNetworkSet()"),
+// every "topology response" that is received makes the AL send a "topology
+// query" to each one of the neighbors listed in it (so that, eventually, the
+// whole network is known).
+//
+// After a topology change in a big network this used to create "query storms"
+// (the same devices being listed in many responses, and thus queried many
+// times in a row). Instead of sending them right away, queries are now handed
+// to this scheduler, which:
+//
+//   - Keeps at most one query per AL MAC, either pending or outstanding
+//     (ie. sent but not answered yet). New requests for the same AL MAC are
+//     ignored ("coalesced") until the previous one is answered or times out.
+//
+//   - Limits the number of queries per second with a token bucket: up to
+//     TOPOLOGY_QUERY_BURST queries can be sent back to back, and after that
+//     only TOPOLOGY_QUERY_RATE per second.
+//
+//   - Delays queries that only *refresh* the information of an already known
+//     device by a random amount of time (up to TOPOLOGY_QUERY_SPREAD_MS), so
+//     that refreshes are spread over the garbage collector period instead of
+//     all happening at once. Queries for unknown devices are not delayed.
+//
+// All the defaults can be changed at build time (ex: by adding
+// "-DTOPOLOGY_QUERY_RATE=20" to the compiler flags).
+//
+#ifndef TOPOLOGY_QUERY_RATE
+#  define TOPOLOGY_QUERY_RATE        (10)     // Queries per second
+#endif
+
+#ifndef TOPOLOGY_QUERY_BURST
+#  define TOPOLOGY_QUERY_BURST       (20)     // Queries
+#endif
+
+#ifndef TOPOLOGY_QUERY_TIMEOUT_MS
+#  define TOPOLOGY_QUERY_TIMEOUT_MS  (5000)   // Time to wait for a response
+#endif
+
+#ifndef TOPOLOGY_QUERY_SPREAD_MS
+#  define TOPOLOGY_QUERY_SPREAD_MS   (20000)  // Must be smaller than
+                                              // "GC_MAX_AGE - MAX_AGE" (see
+                                              // "al_datamodel.h")
+#endif
+
+// Schedule a "topology query" for the 1905 device whose AL MAC is
+// 'al_mac_address', to be sent through interface 'interface_name'.
+//
+// 'refresh' must be set to '1' if the device is already present in the
+// database (and the query is only needed to refresh its information) and to
+// '0' otherwise.
+//
+// Returns '1' if a new query was scheduled or '0' if there already was one
+// for that same device (or if there was an error).
+//
+uint8_t topologyQuerySchedule(char *interface_name, uint8_t *al_mac_address, uint8_t refresh);
+
+// Must be called every time a "topology response" from the device whose AL MAC
+// is 'al_mac_address' is received (whether it was requested or not), so that
+// any query scheduled for it is considered answered.
+//
+void topologyQueryAnswered(uint8_t *al_mac_address);
+
+// Return statistics: number of queries sent, number of requests coalesced with
+// an already scheduled one, number of queries that were never answered and
+// number of queries currently scheduled (pending or outstanding).
+//
+void topologyQueryStats(uint32_t *sent, uint32_t *coalesced, uint32_t *timed_out, uint32_t *scheduled);
+
+#endif
@@ -0,0 +1,385 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+#include "platform.h"
+#include "utils.h"
+
+#include "1905_cmdus.h"
+
+#include "al_reassembly.h"
+
+#include <string.h> // memcmp(), memcpy(), ...
+
+////////////////////////////////////////////////////////////////////////////////
+// Private functions and data
+////////////////////////////////////////////////////////////////////////////////
+
+// Partial CMDUs are identified by the source MAC address, the 'mid' and the
+// 'message type' of their fragments, in this order.
+//
+#define REASSEMBLY_KEY_LEN  (6+2+2)
+
+struct _partialCMDU
+{
+    uint8_t   key[REASSEMBLY_KEY_LEN];
+
+    uint8_t   fragments_nr;   // Size of 'streams'
+    uint8_t **streams;        // Stream (without the ethernet header) of each
+                              // fragment or NULL if it hasn't been received yet
+
+    uint8_t   last_fragment;  // Number of the fragment carrying the
+                              // 'last_fragment_indicator' flag or
+                              // 'fragments_nr' if it hasn't been received yet
+    uint8_t   received_nr;    // Number of non NULL 'streams'
+
+    uint32_t  timestamp;      // When the first fragment was received
+
+    struct _partialCMDU *prev;
+    struct _partialCMDU *next;
+                              // List of all partial CMDUs, from the oldest to
+                              // the newest one
+};
+
+static struct
+{
+    uint32_t             max_cmdus_in_flight;
+    uint8_t              max_fragments_per_cmdu;
+    uint32_t             timeout_ms;
+
+    struct hashTable    *index;   // Key --> "struct _partialCMDU *"
+
+    struct _partialCMDU *oldest;
+    struct _partialCMDU *newest;
+
+    struct reassemblyStats stats;
+
+} reassembly =
+{
+    .max_cmdus_in_flight    = REASSEMBLY_MAX_CMDUS_IN_FLIGHT,
+    .max_fragments_per_cmdu = REASSEMBLY_MAX_FRAGMENTS_PER_CMDU,
+    .timeout_ms             = REASSEMBLY_TIMEOUT_MS,
+};
+
+static void _buildKey(struct CMDU_header *cmdu_header, uint8_t *key)
+{
+    memcpy(key, cmdu_header->src_addr, 6);
+
+    key[6] = (uint8_t)(cmdu_header->mid          >> 8);
+    key[7] = (uint8_t)(cmdu_header->mid              );
+    key[8] = (uint8_t)(cmdu_header->message_type >> 8);
+    key[9] = (uint8_t)(cmdu_header->message_type     );
+}
+
+// Remove 'x' from the list and the index and free it (including all the
+// streams it still owns)
+//
+static void _discardPartialCMDU(struct _partialCMDU *x)
+{
+    uint8_t i;
+
+    if (NULL != x->prev)
+    {
+        x->prev->next = x->next;
+    }
+    else
+    {
+        reassembly.oldest = x->next;
+    }
+
+    if (NULL != x->next)
+    {
+        x->next->prev = x->prev;
+    }
+    else
+    {
+        reassembly.newest = x->prev;
+    }
+
+    hashTableRemove(reassembly.index, x->key);
+    reassembly.stats.in_flight--;
+
+    for (i=0; i<x->fragments_nr; i++)
+    {
+        if (NULL != x->streams[i])
+        {
+            free(x->streams[i]);
+        }
+    }
+    free(x->streams);
+    free(x);
+}
+
+static void _printDiscardedCMDU(const char *reason, struct _partialCMDU *x)
+{
+    PLATFORM_PRINTF_DEBUG_WARNING("Discarding %s CMDU fragments (%d of them received):\n", reason, x->received_nr);
+    PLATFORM_PRINTF_DEBUG_WARNING("  mid          = %d\n", (x->key[6] << 8) | x->key[7]);
+    PLATFORM_PRINTF_DEBUG_WARNING("  message_type = %d\n", (x->key[8] << 8) | x->key[9]);
+    PLATFORM_PRINTF_DEBUG_WARNING("  src_addr     = %02x:%02x:%02x:%02x:%02x:%02x\n", x->key[0], x->key[1], x->key[2], x->key[3], x->key[4], x->key[5]);
+}
+
+// Create a new (empty) partial CMDU for 'key', evicting the oldest one if
+// needed
+//
+static struct _partialCMDU *_newPartialCMDU(uint8_t *key)
+{
+    struct _partialCMDU *x;
+
+    while (NULL != reassembly.oldest && reassembly.stats.in_flight >= reassembly.max_cmdus_in_flight)
+    {
+        _printDiscardedCMDU("old", reassembly.oldest);
+        _discardPartialCMDU(reassembly.oldest);
+        reassembly.stats.evicted++;
+    }
+
+    x = (struct _partialCMDU *)memalloc(sizeof(struct _partialCMDU));
+
+    memcpy(x->key, key, REASSEMBLY_KEY_LEN);
+
+    x->fragments_nr  = reassembly.max_fragments_per_cmdu;
+    x->streams       = (uint8_t **)memalloc(sizeof(uint8_t *) * x->fragments_nr);
+    memset(x->streams, 0, sizeof(uint8_t *) * x->fragments_nr);
+    x->last_fragment = x->fragments_nr;
+    x->received_nr   = 0;
+    x->timestamp     = PLATFORM_GET_TIMESTAMP();
+
+    x->prev          = reassembly.newest;
+    x->next          = NULL;
+
+    if (NULL != reassembly.newest)
+    {
+        reassembly.newest->next = x;
+    }
+    else
+    {
+        reassembly.oldest = x;
+    }
+    reassembly.newest = x;
+
+    hashTableInsert(reassembly.index, key, x);
+    reassembly.stats.in_flight++;
+
+    return x;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions (exported only to files in this same folder)
+////////////////////////////////////////////////////////////////////////////////
+
+void reassemblySetLimits(uint32_t max_cmdus_in_flight, uint8_t max_fragments_per_cmdu, uint32_t timeout_ms)
+{
+    if (0 != max_cmdus_in_flight)
+    {
+        reassembly.max_cmdus_in_flight = max_cmdus_in_flight;
+    }
+    if (0 != max_fragments_per_cmdu)
+    {
+        reassembly.max_fragments_per_cmdu = max_fragments_per_cmdu;
+    }
+    if (0 != timeout_ms)
+    {
+        reassembly.timeout_ms = timeout_ms;
+    }
+}
+
+uint8_t **reassemblyAddFragment(uint8_t *packet_buffer, uint16_t len)
+{
+    struct CMDU_header   cmdu_header;
+    struct _partialCMDU *x;
+
+    uint8_t   key[REASSEMBLY_KEY_LEN];
+    uint8_t  *p;
+    uint8_t **streams;
+    uint8_t   i;
+
+    if (!parse_1905_CMDU_header_from_packet(packet_buffer, len, &cmdu_header))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("Could not retrieve CMDU header from bit stream\n");
+        return NULL;
+    }
+    PLATFORM_PRINTF_DEBUG_DETAIL("mid = %d, fragment_id = %d, last_fragment_indicator = %d\n",
+                                 cmdu_header.mid, cmdu_header.fragment_id, cmdu_header.last_fragment_indicator);
+
+    // Skip over ethernet header
+    //
+    p    = packet_buffer + (6+6+2);
+    len -= (6+6+2);
+
+    if (NULL == reassembly.index)
+    {
+        reassembly.index = hashTableCreate(REASSEMBLY_KEY_LEN, reassembly.max_cmdus_in_flight);
+    }
+
+    reassemblyExpire();
+
+    _buildKey(&cmdu_header, key);
+    x = (struct _partialCMDU *)hashTableFind(reassembly.index, key);
+
+    // Most CMDUs fit in a single packet. They don't need to be buffered at all.
+    //
+    if (NULL == x && 0 == cmdu_header.fragment_id && cmdu_header.last_fragment_indicator)
+    {
+        streams    = (uint8_t **)memalloc(sizeof(uint8_t *) * 2);
+        streams[0] = (uint8_t *)memalloc(sizeof(uint8_t) * len);
+        streams[1] = NULL;
+        memcpy(streams[0], p, len);
+
+        reassembly.stats.completed++;
+
+        return streams;
+    }
+
+    // Check for errors before buffering the fragment
+    //
+    if (cmdu_header.fragment_id >= (NULL == x ? reassembly.max_fragments_per_cmdu : x->fragments_nr))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("Too many fragments (%d) for one same CMDU (max supported is %d)\n",
+                                    cmdu_header.fragment_id + 1, NULL == x ? reassembly.max_fragments_per_cmdu : x->fragments_nr);
+        PLATFORM_PRINTF_DEBUG_ERROR("  mid      = %d\n", cmdu_header.mid);
+        PLATFORM_PRINTF_DEBUG_ERROR("  src_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
+                                    cmdu_header.src_addr[0], cmdu_header.src_addr[1], cmdu_header.src_addr[2],
+                                    cmdu_header.src_addr[3], cmdu_header.src_addr[4], cmdu_header.src_addr[5]);
+        reassembly.stats.dropped++;
+        return NULL;
+    }
+
+    if (NULL != x && NULL != x->streams[cmdu_header.fragment_id])
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Ignoring duplicated fragment #%d\n", cmdu_header.fragment_id);
+        PLATFORM_PRINTF_DEBUG_WARNING("  mid      = %d\n", cmdu_header.mid);
+        PLATFORM_PRINTF_DEBUG_WARNING("  src_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
+                                      cmdu_header.src_addr[0], cmdu_header.src_addr[1], cmdu_header.src_addr[2],
+                                      cmdu_header.src_addr[3], cmdu_header.src_addr[4], cmdu_header.src_addr[5]);
+        reassembly.stats.dropped++;
+        return NULL;
+    }
+
+    if (NULL != x && cmdu_header.last_fragment_indicator && x->fragments_nr != x->last_fragment)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("This fragment (#%d) and a previously received one (#%d) both contain the 'last_fragment_indicator' flag set. Ignoring...\n",
+                                      cmdu_header.fragment_id, x->last_fragment);
+        PLATFORM_PRINTF_DEBUG_WARNING("  mid      = %d\n", cmdu_header.mid);
+        PLATFORM_PRINTF_DEBUG_WARNING("  src_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
+                                      cmdu_header.src_addr[0], cmdu_header.src_addr[1], cmdu_header.src_addr[2],
+                                      cmdu_header.src_addr[3], cmdu_header.src_addr[4], cmdu_header.src_addr[5]);
+        reassembly.stats.dropped++;
+        return NULL;
+    }
+
+    if (NULL == x)
+    {
+        x = _newPartialCMDU(key);
+    }
+
+    // ...and now actually save the stream for later
+    //
+    x->streams[cmdu_header.fragment_id] = (uint8_t *)memalloc(sizeof(uint8_t) * len);
+    memcpy(x->streams[cmdu_header.fragment_id], p, len);
+    x->received_nr++;
+
+    if (cmdu_header.last_fragment_indicator)
+    {
+        x->last_fragment = cmdu_header.fragment_id;
+    }
+
+    // Check if we have now received all fragments for this CMDU
+    //
+    if (x->fragments_nr == x->last_fragment)
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("The last fragment has not yet been received\n");
+        return NULL;
+    }
+    for (i=0; i<=x->last_fragment; i++)
+    {
+        if (NULL == x->streams[i])
+        {
+            PLATFORM_PRINTF_DEBUG_DETAIL("We still have to wait for more fragments to complete the CMDU message\n");
+            return NULL;
+        }
+    }
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("All fragments belonging to this CMDU have already been received\n");
+
+    // Hand the streams over to the caller (no need to copy them again). Any
+    // fragment received with a number higher than the last one is discarded
+    // together with the entry.
+    //
+    streams = (uint8_t **)memalloc(sizeof(uint8_t *) * (x->last_fragment + 2));
+    for (i=0; i<=x->last_fragment; i++)
+    {
+        streams[i]    = x->streams[i];
+        x->streams[i] = NULL;
+    }
+    streams[i] = NULL;
+
+    _discardPartialCMDU(x);
+    reassembly.stats.completed++;
+
+    return streams;
+}
+
+void reassemblyExpire(void)
+{
+    uint32_t now;
+
+    now = PLATFORM_GET_TIMESTAMP();
+
+    while (NULL != reassembly.oldest && now - reassembly.oldest->timestamp > reassembly.timeout_ms)
+    {
+        _printDiscardedCMDU("timed out", reassembly.oldest);
+        _discardPartialCMDU(reassembly.oldest);
+        reassembly.stats.timed_out++;
+    }
+}
+
+void reassemblyGetStats(struct reassemblyStats *stats)
+{
+    *stats = reassembly.stats;
+}
+
@@ -0,0 +1,135 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+#ifndef _AL_REASSEMBLY_H_
+#define _AL_REASSEMBLY_H_
+
+// CMDUs can be received in multiple fragments/packets when they are too big to
+// fit in a single "network transmission unit" (see "Sections 7.1.1 and
+// 7.1.2").
+//
+// Fragments that belong to one same CMDU share the same source MAC address,
+// 'message type' and 'mid', and contain different 'fragment id' values. The
+// last fragment is the only one to contain the 'last fragment indicator' flag
+// set.
+//
+// This module buffers fragments until all the pieces of a CMDU arrive. Partial
+// CMDUs are discarded when:
+//
+//   - More than REASSEMBLY_TIMEOUT_MS milliseconds have elapsed since their
+//     first fragment was received ("timed out").
+//
+//   - The buffer already holds REASSEMBLY_MAX_CMDUS_IN_FLIGHT partial CMDUs
+//     and a fragment for a new one arrives. The oldest one is then discarded
+//     ("evicted").
+//
+// Fragments with a 'fragment id' equal or greater than
+// REASSEMBLY_MAX_FRAGMENTS_PER_CMDU are discarded ("dropped"), as are
+// duplicated fragments.
+//
+// The default limits can be changed at build time (ex: by adding
+// "-DREASSEMBLY_MAX_CMDUS_IN_FLIGHT=128" to the compiler flags) or at run time
+// with "reassemblySetLimits()" (which the platform code reaches through
+// "set1905ALReassemblyLimits()", ex: from the AL entity "-f" command line
+// option).
+//
+#ifndef REASSEMBLY_MAX_CMDUS_IN_FLIGHT
+#  define REASSEMBLY_MAX_CMDUS_IN_FLIGHT     (64)
+#endif
+
+#ifndef REASSEMBLY_MAX_FRAGMENTS_PER_CMDU
+#  define REASSEMBLY_MAX_FRAGMENTS_PER_CMDU  (16)
+#endif
+
+#ifndef REASSEMBLY_TIMEOUT_MS
+#  define REASSEMBLY_TIMEOUT_MS              (5000)
+#endif
+
+// Counters (since start up) of what happened to the received fragments
+//
+struct reassemblyStats
+{
+    uint32_t completed;  // CMDUs whose fragments were all received
+    uint32_t evicted;    // Partial CMDUs discarded to make room for new ones
+    uint32_t timed_out;  // Partial CMDUs discarded because of their age
+    uint32_t dropped;    // Invalid or duplicated fragments ignored
+    uint32_t in_flight;  // Partial CMDUs currently being buffered
+};
+
+// Change the limits explained above. Partial CMDUs already buffered are not
+// affected by a new 'max_fragments_per_cmdu' value.
+//
+// A value of "0" keeps the current value of that limit.
+//
+void reassemblySetLimits(uint32_t max_cmdus_in_flight, uint8_t max_fragments_per_cmdu, uint32_t timeout_ms);
+
+// Feed a received packet ('packet_buffer', 'len' bytes long, starting with the
+// ethernet header) containing a CMDU fragment (or a whole CMDU).
+//
+// If this was the last fragment needed to complete a CMDU, the (NULL
+// terminated) list of all those fragments (without the ethernet header) is
+// returned, ready to be parsed (ex: with "parse_1905_CMDU_view_from_packets()").
+// The caller becomes responsible of freeing it with "free_1905_CMDU_packets()".
+//
+// Otherwise the fragment is internally buffered (ie. the caller does not need
+// to keep 'packet_buffer' around in memory) and NULL is returned.
+//
+uint8_t **reassemblyAddFragment(uint8_t *packet_buffer, uint16_t len);
+
+// Discard all partial CMDUs that have timed out. This is also done every time
+// "reassemblyAddFragment()" is called, so this only needs to be called from
+// time to time to release memory when no new fragments arrive.
+//
+void reassemblyExpire(void);
+
+// Fill 'stats' with the current value of the counters
+//
+void reassemblyGetStats(struct reassemblyStats *stats);
+
+#endif
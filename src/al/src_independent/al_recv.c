@@ -55,6 +55,7 @@
 #include "al_send.h"
 #include "al_wsc.h"
 #include "al_extension.h"
+#include "al_query.h"
 
 #include "1905_tlvs.h"
 #include "1905_cmdus.h"
@@ -68,13 +69,103 @@
 
 #include <string.h> // memcmp(), memcpy(), ...
 
+////////////////////////////////////////////////////////////////////////////////
+// Private functions and data
+////////////////////////////////////////////////////////////////////////////////
+
+// Where to send the "M2" message built (in the background) as a response to an
+// "M1" message
+//
+struct _wscM2Destination
+{
+    char     *interface_name;
+    uint8_t   mac_address[6];
+};
+
+// Called (from the AL main thread) once the "M2" message requested with
+// "wscBuildM2Async()" is ready
+//
+static void _wscM2Ready(uint8_t *m2, uint16_t m2_size, void *context)
+{
+    struct _wscM2Destination *d = (struct _wscM2Destination *)context;
+
+    if (NULL != m2)
+    {
+        if ( 0 == send1905APAutoconfigurationWSCPacket(d->interface_name, getNextMid(), d->mac_address, m2, m2_size))
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'AP autoconfiguration WSC-M2' message\n");
+        }
+
+        wscFreeM2(m2, m2_size);
+    }
+
+    free(d->interface_name);
+    free(d);
+}
+
+// Returns a pointer to the value of the TLV 't' (ie. to the byte right after
+// its "type" and "length" fields) if it is exactly 'length' bytes long, or NULL
+// otherwise.
+//
+// It is used to read the fields of fixed size TLVs straight from the received
+// packet, without parsing the whole TLV (see "materialize_1905_TLV_view()").
+//
+static uint8_t *_tlvValue(struct TLV_view *t, uint16_t length)
+{
+    if (length != t->length)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Malformed TLV (%d): length is %d instead of %d\n", t->type, t->length, length);
+        return NULL;
+    }
+
+    return t->stream + 3;
+}
+
+// Parses the TLV 't' into its own structure. Only done for TLVs that are going
+// to be stored in the database: everything else is read from the view.
+//
+// Returns NULL (and logs it) if the TLV is malformed.
+//
+static uint8_t *_materializeTLV(struct TLV_view *t)
+{
+    uint8_t *p;
+
+    p = materialize_1905_TLV_view(t);
+    if (NULL == p)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Malformed TLV (%d) inside CMDU\n", t->type);
+    }
+
+    return p;
+}
+
+// Frees the 'tlvs_nr' TLV structures contained in 'tlvs' and the 'tlvs' array
+// itself
+//
+static void _freeTLVs(uint8_t **tlvs, uint8_t tlvs_nr)
+{
+    uint8_t i;
+
+    if (NULL == tlvs)
+    {
+        return;
+    }
+
+    for (i=0; i<tlvs_nr; i++)
+    {
+        free_1905_TLV_structure(tlvs[i]);
+    }
+    free(tlvs);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Public functions (exported only to files in this same folder)
 ////////////////////////////////////////////////////////////////////////////////
 
-uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8_t *src_addr, uint8_t queue_id)
+uint8_t process1905Cmdu(struct CMDU_view *v, uint8_t *receiving_interface_addr, uint8_t *src_addr, uint8_t queue_id)
 {
-    if (NULL == c)
+    if (NULL == v)
     {
         return PROCESS_CMDU_KO;
     }
@@ -82,9 +173,9 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
     // Third party implementations maybe need to process some protocol
     // extensions
     //
-    process1905CmduExtensions(c);
+    process1905CmduExtensions(v);
 
-    switch (c->message_type)
+    switch (v->message_type)
     {
         case CMDU_TYPE_TOPOLOGY_DISCOVERY:
         {
@@ -93,8 +184,9 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             // interface MACs are seen on each interface) and send a "topology
             // query" message asking for more details.
 
-            uint8_t *p;
-            uint8_t  i;
+            struct TLV_view *tlv;
+            uint8_t         *value;
+            uint16_t         i;
 
             uint8_t  dummy_mac_address[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
@@ -114,43 +206,39 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             // what type of discovery messages ("topology discovery" and/or
             // "bridge discovery") have been received on each link.
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
-
             // First, extract the AL MAC and MAC addresses of the interface
             // which transmitted this "topology discovery" message
             //
-            i = 0;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_AL_MAC_ADDRESS_TYPE:
                     {
-                        struct alMacAddressTypeTLV *t = (struct alMacAddressTypeTLV *)p;
-
-                        memcpy(al_mac_address, t->al_mac_address, 6);
+                        if (NULL != (value = _tlvValue(tlv, 6)))
+                        {
+                            memcpy(al_mac_address, value, 6);
+                        }
 
                         break;
                     }
                     case TLV_TYPE_MAC_ADDRESS_TYPE:
                     {
-                        struct macAddressTypeTLV *t = (struct macAddressTypeTLV *)p;
-
-                        memcpy(mac_address, t->mac_address, 6);
+                        if (NULL != (value = _tlvValue(tlv, 6)))
+                        {
+                            memcpy(mac_address, value, 6);
+                        }
 
                         break;
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
                         break;
                     }
                 }
-                i++;
             }
 
             // Make sure that both the AL MAC and MAC addresses were contained
@@ -170,6 +258,10 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             //
             if (1 == (first_discovery = DMupdateDiscoveryTimeStamps(receiving_interface_addr, al_mac_address, mac_address, TIMESTAMP_TOPOLOGY_DISCOVERY, &ellapsed)))
             {
+                // A new neighbor (or a new link with an already known one)
+                //
+                markLocalDeviceDataDirty(LOCAL_DEVICE_DATA_NEIGHBORS | LOCAL_DEVICE_DATA_METRICS);
+
 #ifdef SPEED_UP_DISCOVERY
                 // If the data model did not contain an entry for this neighbor,
                 // "manually" (ie. "out of cycle") send a "Topology Discovery"
@@ -224,8 +316,9 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             // The "sender" AL MAC address is contained in the unique TLV
             // embedded in the just received "topology notification" CMDU.
 
-            uint8_t *p;
-            uint8_t  i;
+            struct TLV_view *tlv;
+            uint8_t         *value;
+            uint16_t         i;
 
             uint8_t dummy_mac_address[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
@@ -236,35 +329,30 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
 
             PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_TOPOLOGY_NOTIFICATION (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
-
             // Extract the AL MAC addresses of the interface which transmitted
             // this "topology notification" message
             //
-            i = 0;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_AL_MAC_ADDRESS_TYPE:
                     {
-                        struct alMacAddressTypeTLV *t = (struct alMacAddressTypeTLV *)p;
-
-                        memcpy(al_mac_address, t->al_mac_address, 6);
+                        if (NULL != (value = _tlvValue(tlv, 6)))
+                        {
+                            memcpy(al_mac_address, value, 6);
+                        }
 
                         break;
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
                         break;
                     }
                 }
-                i++;
             }
 
             // Make sure that both the AL MAC and MAC addresses were contained
@@ -341,7 +429,7 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                 dst_mac = p;
             }
 
-            if ( 0 == send1905TopologyResponsePacket(DMmacToInterfaceName(receiving_interface_addr), c->message_id, dst_mac))
+            if ( 0 == send1905TopologyResponsePacket(DMmacToInterfaceName(receiving_interface_addr), v->message_id, dst_mac))
             {
                 PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'topology query' message\n");
             }
@@ -359,8 +447,9 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             // internal database (that keeps track of which 1905 devices are
             // present in the network)
 
-            uint8_t *p;
-            uint8_t  i;
+            struct TLV_view *tlv;
+            uint8_t         *p;
+            uint16_t         i;
 
             struct deviceInformationTypeTLV      *info = NULL;
             struct deviceBridgingCapabilityTLV  **x    = NULL;
@@ -377,32 +466,30 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             uint8_t l2_neighbors_nr;
 
             uint8_t xi, yi, zi, qi, ri;
+            uint8_t malformed;
 
-            PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_TOPOLOGY_RESPONSE (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
+            uint8_t  al_mac_address[6];
+            uint32_t generation;
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
+            PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_TOPOLOGY_RESPONSE (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
-            // First, extract the device info TLV and "count" how many bridging
-            // capability TLVs, non-1905 neighbors TLVs and 1905 neighbors TLVs
-            // there are
+            // First, "count" how many bridging capability TLVs, non-1905
+            // neighbors TLVs and 1905 neighbors TLVs there are
             //
             bridges_nr           = 0;
             non1905_neighbors_nr = 0;
             x1905_neighbors_nr   = 0;
             power_off_nr         = 0;
             l2_neighbors_nr      = 0;
-            i                    = 0;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_DEVICE_INFORMATION_TYPE:
+                    case TLV_TYPE_SUPPORTED_SERVICE:
                     {
-                        info = (struct deviceInformationTypeTLV *)p;
                         break;
                     }
                     case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
@@ -430,11 +517,6 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                         l2_neighbors_nr++;
                         break;
                     }
-                    case TLV_TYPE_SUPPORTED_SERVICE:
-                    {
-                        s = (struct supportedServiceTLV *)p;
-                        break;
-                    }
                     case TLV_TYPE_VENDOR_SPECIFIC:
                     {
                         // According to the standard, zero or more Vendor
@@ -444,11 +526,10 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
                         break;
                     }
                 }
-                i++;
             }
 
             // Next, now that we know how many TLVs of each type there are,
@@ -476,117 +557,121 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                 r = (struct l2NeighborDeviceTLV          **)memalloc(sizeof(struct l2NeighborDeviceTLV          *) * l2_neighbors_nr);
             }
 
-            xi = 0;
-            yi = 0;
-            zi = 0;
-            qi = 0;
-            ri = 0;
-            i  = 0;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            // These are the TLVs that end up in the database, and thus the
+            // only ones that are parsed into their own structures. The rest
+            // (vendor specific and unexpected ones) are never looked into.
+            //
+            // If any of them is malformed, the whole CMDU is discarded.
+            //
+            xi        = 0;
+            yi        = 0;
+            zi        = 0;
+            qi        = 0;
+            ri        = 0;
+            malformed = 0;
+            for (i=0; i<v->tlvs_nr && 0 == malformed; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_DEVICE_INFORMATION_TYPE:
                     {
+                        if (NULL != (p = _materializeTLV(tlv)))
+                        {
+                            free_1905_TLV_structure((uint8_t *)info);
+                            info = (struct deviceInformationTypeTLV *)p;
+                        }
                         break;
                     }
                     case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
                     {
-                        x[xi++] = (struct deviceBridgingCapabilityTLV *)p;
+                        if (NULL != (p = _materializeTLV(tlv)))
+                        {
+                            x[xi++] = (struct deviceBridgingCapabilityTLV *)p;
+                        }
                         break;
                     }
                     case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:
                     {
-                        y[yi++] = (struct non1905NeighborDeviceListTLV *)p;
+                        if (NULL != (p = _materializeTLV(tlv)))
+                        {
+                            y[yi++] = (struct non1905NeighborDeviceListTLV *)p;
+                        }
                         break;
                     }
                     case TLV_TYPE_NEIGHBOR_DEVICE_LIST:
                     {
-                        z[zi++] = (struct neighborDeviceListTLV *)p;
+                        if (NULL != (p = _materializeTLV(tlv)))
+                        {
+                            z[zi++] = (struct neighborDeviceListTLV *)p;
+                        }
                         break;
                     }
                     case TLV_TYPE_POWER_OFF_INTERFACE:
                     {
-                        q[qi++] = (struct powerOffInterfaceTLV *)p;
+                        if (NULL != (p = _materializeTLV(tlv)))
+                        {
+                            q[qi++] = (struct powerOffInterfaceTLV *)p;
+                        }
                         break;
                     }
                     case TLV_TYPE_L2_NEIGHBOR_DEVICE:
                     {
-                        r[ri++] = (struct l2NeighborDeviceTLV *)p;
+                        if (NULL != (p = _materializeTLV(tlv)))
+                        {
+                            r[ri++] = (struct l2NeighborDeviceTLV *)p;
+                        }
                         break;
                     }
                     case TLV_TYPE_SUPPORTED_SERVICE:
                     {
-                        break;
-                    }
-                    case TLV_TYPE_VENDOR_SPECIFIC:
-                    {
-                        // According to the standard, zero or more Vendor
-                        // Specific TLVs may be present.
-                        //
-                        free_1905_TLV_structure(p);
+                        if (NULL != (p = _materializeTLV(tlv)))
+                        {
+                            free_1905_TLV_structure((uint8_t *)s);
+                            s = (struct supportedServiceTLV *)p;
+                        }
                         break;
                     }
                     default:
                     {
-                        // We are not interested in other TLVs. Free them
+                        // Not stored, thus not worth parsing
                         //
-                        free_1905_TLV_structure(p);
-                        break;
+                        continue;
                     }
                 }
-                i++;
+
+                if (NULL == p)
+                {
+                    malformed = 1;
+                }
             }
 
-            // The CMDU structure is not needed anymore, but we cannot just let
-            // the caller call "free_1905_CMDU_structure()", because it would
-            // also free the TLVs references that we need (ie. those saved in
-            // the "x", "y", "z", "q" and "r" pointer arrays).
-            // The "fix" is easy: just set "c->list_of_TLVs" to NULL so that
-            // when the caller calls "free_1905_CMDU_structure()", this function
-            // ignores (ie. does not free) the "list_of_TLVs" list.
-            //
-            // This will work because and memory won't be lost because:
-            //
-            //   1. Those TLVs contained in "c->list_of_TLVs" that we are not
-            //      keeping track off have already been freed (see the "default"
-            //      case in the previous "switch" structure).
-            //
-            //   2. The rest of them will be freed when the data model entry
-            //      is replaced/deleted.
-            //
-            //   3. Setting "C->list_of_TLVs" to NULL will cause
-            //      "free_1905_CMDU_structure()" to ignore this list.
-            //
-            free(c->list_of_TLVs);
-            c->list_of_TLVs = NULL;
+            if (1 == malformed || NULL == info)
+            {
+                if (NULL == info)
+                {
+                    PLATFORM_PRINTF_DEBUG_WARNING("More TLVs were expected inside this CMDU\n");
+                }
 
-            // Next, update the database. This will take care of duplicate
-            // entries (and free TLVs if needed)
-            //
-            PLATFORM_PRINTF_DEBUG_DETAIL("Updating network devices database...\n");
-            DMupdateNetworkDeviceInfo(info->al_mac_address,
-                                      1, info,
-                                      1, x, bridges_nr,
-                                      1, y, non1905_neighbors_nr,
-                                      1, z, x1905_neighbors_nr,
-                                      1, q, power_off_nr,
-                                      1, r, l2_neighbors_nr,
-                                      1, s,
-                                      0, NULL,
-                                      0, NULL,
-                                      0, NULL,
-                                      0, NULL,
-                                      0, NULL,
-                                      0, NULL);
+                free_1905_TLV_structure((uint8_t *)info);
+                free_1905_TLV_structure((uint8_t *)s);
+                _freeTLVs((uint8_t **)x, xi);
+                _freeTLVs((uint8_t **)y, yi);
+                _freeTLVs((uint8_t **)z, zi);
+                _freeTLVs((uint8_t **)q, qi);
+                _freeTLVs((uint8_t **)r, ri);
 
-            // Show all network devices (ie. print them through the logging
-            // system)
+                return PROCESS_CMDU_KO;
+            }
+
+            // If a topology query for this device was still scheduled (or
+            // waiting for this response), it is no longer needed
             //
-            DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            topologyQueryAnswered(info->al_mac_address);
 
-            // And finally, send other queries to the device so that we can
-            // keep updating the database once the responses are received
+            // Next, send other queries to the device so that we can keep
+            // updating the database once the responses are received
             //
             if ( 0 == send1905MetricsQueryPacket(DMmacToInterfaceName(receiving_interface_addr), getNextMid(), info->al_mac_address))
             {
@@ -640,8 +725,6 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                     //
                     for (j=0; j<z[i]->neighbors_nr; j++)
                     {
-                        uint8_t ii, jj;
-
                         // Discard the current node (obviously)
                         //
                         if (0 == memcmp(DMalMacGet(), z[i]->neighbors[j].mac_address, 6))
@@ -649,19 +732,6 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                             continue;
                         }
 
-                        // Discard nodes I have just asked for
-                        //
-                        for (ii=0; ii<i; ii++)
-                        {
-                            for (jj=0; jj<z[ii]->neighbors_nr; jj++)
-                            {
-                                if (0 == memcmp(z[ii]->neighbors[jj].mac_address, z[i]->neighbors[j].mac_address, 6))
-                                {
-                                    continue;
-                                }
-                            }
-                        }
-
                         // Discard neighbors whose information was updated
                         // recently (ie. no need to flood the network)
                         //
@@ -670,14 +740,54 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                             continue;
                         }
 
-                        if ( 0 == send1905TopologyQueryPacket(DMmacToInterfaceName(receiving_interface_addr), getNextMid(), z[i]->neighbors[j].mac_address))
-                        {
-                            PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'topology query' message\n");
-                        }
+                        // Let the scheduler decide when to send the query.
+                        // It takes care of not querying the same node twice
+                        // (even if it is listed by several neighbors) and of
+                        // not sending too many queries at once.
+                        //
+                        topologyQuerySchedule(DMmacToInterfaceName(receiving_interface_addr), z[i]->neighbors[j].mac_address,
+                                              0 == DMnetworkDeviceGeneration(z[i]->neighbors[j].mac_address) ? 0 : 1);
                     }
                 }
             }
 
+            // And finally, update the database. This will take care of
+            // duplicate entries (and free TLVs if needed).
+            //
+            // This must be done last, as TLVs identical to the ones already
+            // stored in the database are freed right away (ie. they can no
+            // longer be used after this call)
+            //
+            memcpy(al_mac_address, info->al_mac_address, 6);
+            generation = DMnetworkDeviceGeneration(al_mac_address);
+
+            PLATFORM_PRINTF_DEBUG_DETAIL("Updating network devices database...\n");
+            DMupdateNetworkDeviceInfo(al_mac_address,
+                                      1, info,
+                                      1, x, bridges_nr,
+                                      1, y, non1905_neighbors_nr,
+                                      1, z, x1905_neighbors_nr,
+                                      1, q, power_off_nr,
+                                      1, r, l2_neighbors_nr,
+                                      1, s,
+                                      0, NULL,
+                                      0, NULL,
+                                      0, NULL,
+                                      0, NULL,
+                                      0, NULL,
+                                      0, NULL);
+
+            // Show all network devices (ie. print them through the logging
+            // system), but only if something has changed
+            //
+            if (
+                 1 == PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL) &&
+                 generation != DMnetworkDeviceGeneration(al_mac_address)
+               )
+            {
+                DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            }
+
             break;
         }
         case CMDU_TYPE_VENDOR_SPECIFIC:
@@ -691,32 +801,49 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
         }
         case CMDU_TYPE_LINK_METRIC_QUERY:
         {
-            uint8_t *p;
-            uint8_t  i;
+            struct TLV_view *tlv;
+            uint8_t         *value;
+            uint16_t         i;
 
+            uint8_t *p;
             uint8_t *dst_mac;
 
+            struct linkMetricQueryTLV  query;
             struct linkMetricQueryTLV *t;
 
             PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_LINK_METRIC_QUERY (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
-
             // First, search for the "struct linkMetricQueryTLV"
             //
-            i = 0;
             t = NULL;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_LINK_METRIC_QUERY:
                     {
-                        t = (struct linkMetricQueryTLV *)p;
+                        // Fixed size TLV: its fields are read straight from
+                        // the packet
+                        //
+                        if (NULL != (value = _tlvValue(tlv, 8)))
+                        {
+                            query.tlv.type          = TLV_TYPE_LINK_METRIC_QUERY;
+                            query.destination       = value[0];
+                            query.link_metrics_type = value[7];
+
+                            if (LINK_METRIC_QUERY_TLV_SPECIFIC_NEIGHBOR == query.destination)
+                            {
+                                memcpy(query.specific_neighbor, value + 1, 6);
+                            }
+                            else
+                            {
+                                memset(query.specific_neighbor, 0x00, 6);
+                            }
+
+                            t = &query;
+                        }
                         break;
                     }
                     case TLV_TYPE_VENDOR_SPECIFIC:
@@ -728,11 +855,10 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
                         break;
                     }
                 }
-                i++;
             }
 
             if (NULL == t)
@@ -797,7 +923,7 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                 dst_mac = p;
             }
 
-            if ( 0 == send1905MetricsResponsePacket(DMmacToInterfaceName(receiving_interface_addr), c->message_id, dst_mac, t->destination, t->specific_neighbor, t->link_metrics_type))
+            if ( 0 == send1905MetricsResponsePacket(DMmacToInterfaceName(receiving_interface_addr), v->message_id, dst_mac, t->destination, t->specific_neighbor, t->link_metrics_type))
             {
                 PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'metrics response' message\n");
             }
@@ -815,30 +941,32 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             // internal database (that keeps track of which 1905 devices are
             // present in the network)
 
-            uint8_t *p;
-            uint8_t  i;
+            struct TLV_view *tlv;
+            uint8_t         *p;
+            uint16_t         i;
 
             PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_LINK_METRIC_RESPONSE (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
-
             // Call "DMupdateNetworkDeviceMetrics()" for each TLV
             //
             PLATFORM_PRINTF_DEBUG_DETAIL("Updating network devices database...\n");
 
-            i = 0;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_TRANSMITTER_LINK_METRIC:
                     case TLV_TYPE_RECEIVER_LINK_METRIC:
                     {
-                        DMupdateNetworkDeviceMetrics(p);
+                        // The database keeps the parsed TLV (and takes care of
+                        // freeing it)
+                        //
+                        if (NULL != (p = _materializeTLV(tlv)))
+                        {
+                            DMupdateNetworkDeviceMetrics(p);
+                        }
                         break;
                     }
                     case TLV_TYPE_VENDOR_SPECIFIC:
@@ -846,31 +974,23 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                         // According to the standard, zero or more Vendor
                         // Specific TLVs may be present.
                         //
-                        free_1905_TLV_structure(p);
                         break;
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
-
-                        free_1905_TLV_structure(p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
                         break;
                     }
                 }
-                i++;
             }
 
-            // References to the TLVs cannot be freed by the caller (see the
-            // comment in "case CMDU_TYPE_TOPOLOGY_RESPONSE:" to understand the
-            // following two lines).
-            //
-            free(c->list_of_TLVs);
-            c->list_of_TLVs = NULL;
-
             // Show all network devices (ie. print them through the logging
             // system)
             //
-            DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            if (1 == PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+            {
+                DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            }
 
             break;
         }
@@ -881,8 +1001,9 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             // response" message must be sent.
             // Otherwise, the message is ignored.
 
-            uint8_t *p;
-            uint8_t i;
+            struct TLV_view *tlv;
+            uint8_t         *value;
+            uint16_t         i;
 
             uint8_t dummy_mac_address[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
@@ -906,12 +1027,6 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
 
             PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_AP_AUTOCONFIGURATION_SEARCH (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
-
             // First, parse the incomming packet to find out three things:
             // - The AL MAC of the node searching for AP-autoconfiguration
             //   parameters.
@@ -920,34 +1035,38 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             // - The "freq band" contained in the "autoconfig freq band TLV"
             //   (must match the one of our local registrar interface)
             //
-            i = 0;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_AL_MAC_ADDRESS_TYPE:
                     {
-                        struct alMacAddressTypeTLV *t = (struct alMacAddressTypeTLV *)p;
-
-                        memcpy(al_mac_address, t->al_mac_address, 6);
+                        if (NULL != (value = _tlvValue(tlv, 6)))
+                        {
+                            memcpy(al_mac_address, value, 6);
+                        }
 
                         break;
                     }
                     case TLV_TYPE_SEARCHED_ROLE:
                     {
-                        struct searchedRoleTLV *t = (struct searchedRoleTLV *)p;
-
-                        searched_role_is_present = 1;
-                        searched_role            = t->role;
+                        if (NULL != (value = _tlvValue(tlv, 1)))
+                        {
+                            searched_role_is_present = 1;
+                            searched_role            = value[0];
+                        }
 
                         break;
                     }
                     case TLV_TYPE_AUTOCONFIG_FREQ_BAND:
                     {
-                        struct autoconfigFreqBandTLV *t = (struct autoconfigFreqBandTLV *)p;
-
-                        freq_band_is_present = 1;
-                        freq_band            = t->freq_band;
+                        if (NULL != (value = _tlvValue(tlv, 1)))
+                        {
+                            freq_band_is_present = 1;
+                            freq_band            = value[0];
+                        }
 
                         break;
                     }
@@ -965,11 +1084,10 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
                         break;
                     }
                 }
-                i++;
             }
 
             // Make sure that all needed parameters were present in the message
@@ -1031,7 +1149,7 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                 {
                     PLATFORM_PRINTF_DEBUG_DETAIL("Interface %s is AP, registrar, and uses the same freq band. Sending response...\n",ifs_names[i]);
 
-                    if ( 0 == send1905APAutoconfigurationResponsePacket(DMmacToInterfaceName(receiving_interface_addr), c->message_id, al_mac_address, freq_band,
+                    if ( 0 == send1905APAutoconfigurationResponsePacket(DMmacToInterfaceName(receiving_interface_addr), v->message_id, al_mac_address, freq_band,
                                                                         supported_service_is_present || searched_service_is_present))
                     {
                         PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'AP autoconfiguration response' message\n");
@@ -1059,8 +1177,9 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             // the same freq band as the one contained in the message and send
             // a AP-autoconfig WSC-M1
 
-            uint8_t *p;
-            uint8_t i;
+            struct TLV_view *tlv;
+            uint8_t         *value;
+            uint16_t         i;
 
             char **ifs_names;
             uint8_t  ifs_nr;
@@ -1071,13 +1190,10 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             uint8_t supported_freq_band_is_present;
             uint8_t supported_freq_band;
 
-            PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_AP_AUTOCONFIGURATION_RESPONSE (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
+            supported_role_is_present      = 0;
+            supported_freq_band_is_present = 0;
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
+            PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_AP_AUTOCONFIGURATION_RESPONSE (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
             // First, parse the incomming packet to find out two things:
             //   parameters.
@@ -1087,36 +1203,38 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             // band TLV" (must match the one of our local unconfigured
             // interface)
             //
-            i = 0;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_SUPPORTED_ROLE:
                     {
-                        struct supportedRoleTLV *t = (struct supportedRoleTLV *)p;
-
-                        supported_role_is_present = 1;
-                        supported_role            = t->role;
+                        if (NULL != (value = _tlvValue(tlv, 1)))
+                        {
+                            supported_role_is_present = 1;
+                            supported_role            = value[0];
+                        }
 
                         break;
                     }
                     case TLV_TYPE_SUPPORTED_FREQ_BAND:
                     {
-                        struct supportedFreqBandTLV *t = (struct supportedFreqBandTLV *)p;
-
-                        supported_freq_band_is_present = 1;
-                        supported_freq_band            = t->freq_band;
+                        if (NULL != (value = _tlvValue(tlv, 1)))
+                        {
+                            supported_freq_band_is_present = 1;
+                            supported_freq_band            = value[0];
+                        }
 
                         break;
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
                         break;
                     }
                 }
-                i++;
             }
 
             // Make sure that all needed parameters were present in the message
@@ -1240,8 +1358,8 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
         }
         case CMDU_TYPE_AP_AUTOCONFIGURATION_WSC:
         {
-            uint8_t *p;
-            uint8_t i;
+            struct TLV_view *tlv;
+            uint16_t         i;
 
             uint8_t  *wsc_frame;
             uint16_t  wsc_frame_size;
@@ -1255,35 +1373,34 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
 
             PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_AP_AUTOCONFIGURATION_WSC (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
-
             wsc_frame      = NULL;
             wsc_frame_size = 0;
-            i = 0;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_WSC:
                     {
-                        struct wscTLV *t = (struct wscTLV *)p;
-
-                        wsc_frame      = t->wsc_frame;
-                        wsc_frame_size = t->wsc_frame_size;
+                        // The WSC frame is the whole value of the TLV. There
+                        // is no need to copy it: both "wscProcessM2Async()"
+                        // and "wscBuildM2Async()" keep their own copy.
+                        //
+                        if (tlv->length > 0)
+                        {
+                            wsc_frame      = tlv->stream + 3;
+                            wsc_frame_size = tlv->length;
+                        }
 
                         break;
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
                         break;
                     }
                 }
-                i++;
             }
 
             // Make sure there was a WSC TLV in the message
@@ -1301,7 +1418,10 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                 // Process it and apply the configuration to the corresponding
                 // interface.
                 //
-                wscProcessM2(NULL, NULL, 0, wsc_frame, wsc_frame_size);
+                // The key agreement takes some time: it is done in the
+                // background and the interface is configured once it finishes.
+                //
+                wscProcessM2Async(queue_id, NULL, NULL, 0, wsc_frame, wsc_frame_size);
                   // NOTE: this function will automatically free M1.
 
                 // One more thing: This node *might* have other unconfigured AP
@@ -1321,15 +1441,21 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                 // We hadn't previously sent an M1 (ie. we are the registrar),
                 // thus the contents of the just received message must be M1.
                 //
-                // Process it and send an M2 response.
+                // Process it and send an M2 response (once it is ready, as
+                // it is built in the background)
                 //
-                uint8_t   *m2;
-                uint16_t   m2_size;
+                struct _wscM2Destination *d;
 
-                uint8_t   *dst_mac;
                 uint8_t   *p;
 
-                wscBuildM2(wsc_frame, wsc_frame_size, &m2, &m2_size);
+                if (NULL == DMmacToInterfaceName(receiving_interface_addr))
+                {
+                    PLATFORM_PRINTF_DEBUG_WARNING("Unknown receiving interface. Ignoring M1 message.\n");
+                    break;
+                }
+
+                d = (struct _wscM2Destination *)memalloc(sizeof(struct _wscM2Destination));
+                d->interface_name = strdup(DMmacToInterfaceName(receiving_interface_addr));
 
                 // We must send M2 to the AL MAC of the node who sent M1,
                 // however, this AL MAC is *not* contained in M1.
@@ -1345,25 +1471,20 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                     // dropping the packet, sending M2 to the 'src' address
                     // from the M1 seems the right thing to do.
                     //
-                    dst_mac = src_addr;
-                    PLATFORM_PRINTF_DEBUG_WARNING("Unknown destination AL MAC. Using the 'src' MAC from M1 (%02x:%02x:%02x:%02x:%02x:%02x)\n", dst_mac[0],dst_mac[1], dst_mac[2], dst_mac[3], dst_mac[4], dst_mac[5]);
+                    memcpy(d->mac_address, src_addr, 6);
+                    PLATFORM_PRINTF_DEBUG_WARNING("Unknown destination AL MAC. Using the 'src' MAC from M1 (%02x:%02x:%02x:%02x:%02x:%02x)\n", src_addr[0], src_addr[1], src_addr[2], src_addr[3], src_addr[4], src_addr[5]);
                 }
                 else
                 {
-                    dst_mac = p;
-                }
-
-                if ( 0 == send1905APAutoconfigurationWSCPacket(DMmacToInterfaceName(receiving_interface_addr), getNextMid(), dst_mac, m2, m2_size))
-                {
-                    PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'AP autoconfiguration WSC-M2' message\n");
+                    memcpy(d->mac_address, p, 6);
+                    free(p);
                 }
 
-                if (NULL != p)
+                if (0 == wscBuildM2Async(queue_id, wsc_frame, wsc_frame_size, _wscM2Ready, d))
                 {
-                    free(p);
+                    free(d->interface_name);
+                    free(d);
                 }
-
-                wscFreeM2(m2, m2_size);
             }
             else
             {
@@ -1393,8 +1514,9 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             //           the received message did not contain 802.11 media type
             //           information.
 
-            uint8_t *p;
-            uint8_t i;
+            struct TLV_view *tlv;
+            uint8_t         *value;
+            uint16_t         i;
 
             uint8_t dummy_mac_address[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
@@ -1410,61 +1532,75 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
 
             PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
-
             // First, parse the incomming packet to find out if the 'push
             // button' event TLV contains 802.11 data.
             //
-            i = 0;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_AL_MAC_ADDRESS_TYPE:
                     {
-                        struct alMacAddressTypeTLV *t = (struct alMacAddressTypeTLV *)p;
-
-                        memcpy(al_mac_address, t->al_mac_address, 6);
+                        if (NULL != (value = _tlvValue(tlv, 6)))
+                        {
+                            memcpy(al_mac_address, value, 6);
+                        }
 
                         break;
                     }
                     case TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION:
                     {
-                        uint8_t j;
-                        struct pushButtonEventNotificationTLV *t = (struct pushButtonEventNotificationTLV *)p;
+                        // Only the media types are needed, thus they are read
+                        // straight from the packet: the value is the number
+                        // of media types followed by one entry per media type
+                        // (2 bytes media type, 1 byte media specific data
+                        // size and the media specific data itself).
+                        //
+                        // Note that a zero length TLV is accepted (meaning
+                        // "no media types") as some implementations send it
+                        // this way (see "FIX_BROKEN_TLVS").
+                        //
+                        uint8_t  j;
+                        uint8_t  media_types_nr;
+                        uint16_t media_type;
+                        uint16_t offset;
 
+                        value          = tlv->stream + 3;
+                        media_types_nr = tlv->length > 0 ? value[0] : 0;
+                        offset         = 1;
 
-                        for (j=0; j<t->media_types_nr; j++)
+                        for (j=0; j<media_types_nr && offset + 3 <= tlv->length; j++)
                         {
+                            media_type = (value[offset] << 8) | value[offset+1];
+
                             if (
-                                 INTERFACE_TYPE_IEEE_802_11B_2_4_GHZ == t->media_types[j].media_type ||
-                                 INTERFACE_TYPE_IEEE_802_11G_2_4_GHZ == t->media_types[j].media_type ||
-                                 INTERFACE_TYPE_IEEE_802_11A_5_GHZ   == t->media_types[j].media_type ||
-                                 INTERFACE_TYPE_IEEE_802_11N_2_4_GHZ == t->media_types[j].media_type ||
-                                 INTERFACE_TYPE_IEEE_802_11N_5_GHZ   == t->media_types[j].media_type ||
-                                 INTERFACE_TYPE_IEEE_802_11AC_5_GHZ  == t->media_types[j].media_type ||
-                                 INTERFACE_TYPE_IEEE_802_11AD_60_GHZ == t->media_types[j].media_type ||
-                                 INTERFACE_TYPE_IEEE_802_11AF_GHZ    == t->media_types[j].media_type
+                                 INTERFACE_TYPE_IEEE_802_11B_2_4_GHZ == media_type ||
+                                 INTERFACE_TYPE_IEEE_802_11G_2_4_GHZ == media_type ||
+                                 INTERFACE_TYPE_IEEE_802_11A_5_GHZ   == media_type ||
+                                 INTERFACE_TYPE_IEEE_802_11N_2_4_GHZ == media_type ||
+                                 INTERFACE_TYPE_IEEE_802_11N_5_GHZ   == media_type ||
+                                 INTERFACE_TYPE_IEEE_802_11AC_5_GHZ  == media_type ||
+                                 INTERFACE_TYPE_IEEE_802_11AD_60_GHZ == media_type ||
+                                 INTERFACE_TYPE_IEEE_802_11AF_GHZ    == media_type
                                 )
                             {
                                 wifi_data_is_present = 1;
                                 break;
                             }
+
+                            offset += 3 + value[offset+2];
                         }
 
                         break;
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
                         break;
                     }
                 }
-                i++;
             }
 
             if (0 == memcmp(al_mac_address, dummy_mac_address, 6))
@@ -1484,6 +1620,7 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             {
                 PLATFORM_SET_INTERFACE_POWER_MODE(ifs_names[i], INTERFACE_POWER_STATE_ON);
             }
+            markLocalDeviceDataDirty(LOCAL_DEVICE_DATA_INTERFACES);
 #endif
             // Finally, for those non wifi interfaces (or a wifi interface whose
             // MAC address matches the network registrar MAC address), start
@@ -1542,7 +1679,7 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                 free_1905_INTERFACE_INFO(x);
 
                 PLATFORM_PRINTF_DEBUG_INFO("Starting push button configuration process on interface %s\n", ifs_names[i]);
-                if (0 == PLATFORM_START_PUSH_BUTTON_CONFIGURATION(ifs_names[i], queue_id, al_mac_address, c->message_id))
+                if (0 == PLATFORM_START_PUSH_BUTTON_CONFIGURATION(ifs_names[i], queue_id, al_mac_address, v->message_id))
                 {
                     PLATFORM_PRINTF_DEBUG_WARNING("Could not start 'push button' configuration process on interface\n",ifs_names[i]);
                 }
@@ -1595,7 +1732,7 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                 dst_mac = p;
             }
 
-            if ( 0 == send1905GenericPhyResponsePacket(DMmacToInterfaceName(receiving_interface_addr), c->message_id, dst_mac))
+            if ( 0 == send1905GenericPhyResponsePacket(DMmacToInterfaceName(receiving_interface_addr), v->message_id, dst_mac))
             {
                 PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'topology query' message\n");
             }
@@ -1615,29 +1752,33 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
 
             struct genericPhyDeviceInformationTypeTLV *t;
 
-            uint8_t *p;
-            uint8_t  i;
+            struct TLV_view *tlv;
+            uint16_t         i;
 
-            PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_GENERIC_PHY_RESPONSE (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
+            uint8_t  al_mac_address[6];
+            uint32_t generation;
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
+            PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_GENERIC_PHY_RESPONSE (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
             // Call "DMupdateGenericPhyInfo()" for the "generic phy
             // device information type TLV"  contained in this CMDU.
             //
-            i = 0;
             t = NULL;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION:
                     {
-                        t = (struct genericPhyDeviceInformationTypeTLV *)p;
+                        // This is the TLV that ends up in the database, thus
+                        // the only one parsed into its own structure
+                        //
+                        if (NULL == t)
+                        {
+                            t = (struct genericPhyDeviceInformationTypeTLV *)_materializeTLV(tlv);
+                        }
                         break;
                     }
                     case TLV_TYPE_VENDOR_SPECIFIC:
@@ -1645,18 +1786,14 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                         // According to the standard, zero or more Vendor
                         // Specific TLVs may be present.
                         //
-                        free_1905_TLV_structure(p);
                         break;
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
-
-                        free_1905_TLV_structure(p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
                         break;
                     }
                 }
-                i++;
             }
 
             if (NULL == t)
@@ -1665,8 +1802,11 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                 return PROCESS_CMDU_KO;
             }
 
+            memcpy(al_mac_address, t->al_mac_address, 6);
+            generation = DMnetworkDeviceGeneration(al_mac_address);
+
             PLATFORM_PRINTF_DEBUG_DETAIL("Updating network devices database...\n");
-            DMupdateNetworkDeviceInfo(t->al_mac_address,
+            DMupdateNetworkDeviceInfo(al_mac_address,
                                       0, NULL,
                                       0, NULL, 0,
                                       0, NULL, 0,
@@ -1681,17 +1821,16 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                                       0, NULL,
                                       0, NULL);
 
-            // References to the TLVs cannot be freed by the caller (see the
-            // comment in "case CMDU_TYPE_TOPOLOGY_RESPONSE:" to understand the
-            // following two lines).
-            //
-            free(c->list_of_TLVs);
-            c->list_of_TLVs = NULL;
-
             // Show all network devices (ie. print them through the logging
-            // system)
+            // system), but only if something has changed
             //
-            DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            if (
+                 1 == PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL) &&
+                 generation != DMnetworkDeviceGeneration(al_mac_address)
+               )
+            {
+                DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            }
 
             break;
         }
@@ -1727,7 +1866,7 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                 dst_mac = p;
             }
 
-            if ( 0 == send1905HighLayerResponsePacket(DMmacToInterfaceName(receiving_interface_addr), c->message_id, dst_mac))
+            if ( 0 == send1905HighLayerResponsePacket(DMmacToInterfaceName(receiving_interface_addr), v->message_id, dst_mac))
             {
                 PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'high layer response' message\n");
             }
@@ -1753,85 +1892,136 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
 
             uint8_t  al_mac_address[6];
             uint8_t  al_mac_address_is_present;
+            uint8_t  malformed;
 
-            uint8_t *p;
-            uint8_t  i;
+            uint32_t generation;
 
-            PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_HIGHER_LAYER_RESPONSE (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
+            struct TLV_view *tlv;
+            uint8_t         *value;
+            uint8_t         *p;
+            uint16_t         i;
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
+            PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_HIGHER_LAYER_RESPONSE (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
             // Call "DMupdateGenericPhyInfo()" with each of the TLVs contained
-            // in this CMDU
+            // in this CMDU. Only those are parsed into their own structures:
+            // the AL MAC address is read straight from the packet.
             //
             PLATFORM_PRINTF_DEBUG_DETAIL("Updating network devices database...\n");
 
-            i                         = 0;
             al_mac_address_is_present = 0;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            malformed                 = 0;
+            for (i=0; i<v->tlvs_nr && 0 == malformed; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_AL_MAC_ADDRESS_TYPE:
                     {
-                        struct alMacAddressTypeTLV *t = (struct alMacAddressTypeTLV *)p;
-
-                        memcpy(al_mac_address, t->al_mac_address, 6);
+                        if (NULL != (value = _tlvValue(tlv, 6)))
+                        {
+                            memcpy(al_mac_address, value, 6);
 
-                        al_mac_address_is_present = 1;
+                            al_mac_address_is_present = 1;
+                        }
 
-                        free_1905_TLV_structure(p);
                         break;
                     }
                     case TLV_TYPE_1905_PROFILE_VERSION:
                     {
-                        profile = (struct x1905ProfileVersionTLV *)p;
+                        if (NULL == (p = _materializeTLV(tlv)))
+                        {
+                            malformed = 1;
+                        }
+                        else
+                        {
+                            free_1905_TLV_structure((uint8_t *)profile);
+                            profile = (struct x1905ProfileVersionTLV *)p;
+                        }
                         break;
                     }
                     case TLV_TYPE_DEVICE_IDENTIFICATION:
                     {
-                        identification = (struct deviceIdentificationTypeTLV *)p;
+                        if (NULL == (p = _materializeTLV(tlv)))
+                        {
+                            malformed = 1;
+                        }
+                        else
+                        {
+                            free_1905_TLV_structure((uint8_t *)identification);
+                            identification = (struct deviceIdentificationTypeTLV *)p;
+                        }
                         break;
                     }
                     case TLV_TYPE_CONTROL_URL:
                     {
-                        control_url = (struct controlUrlTypeTLV *)p;
+                        if (NULL == (p = _materializeTLV(tlv)))
+                        {
+                            malformed = 1;
+                        }
+                        else
+                        {
+                            free_1905_TLV_structure((uint8_t *)control_url);
+                            control_url = (struct controlUrlTypeTLV *)p;
+                        }
                         break;
                     }
                     case TLV_TYPE_IPV4:
                     {
-                        ipv4 = (struct ipv4TypeTLV *)p;
+                        if (NULL == (p = _materializeTLV(tlv)))
+                        {
+                            malformed = 1;
+                        }
+                        else
+                        {
+                            free_1905_TLV_structure((uint8_t *)ipv4);
+                            ipv4 = (struct ipv4TypeTLV *)p;
+                        }
                         break;
                     }
                     case TLV_TYPE_IPV6:
                     {
-                        ipv6 = (struct ipv6TypeTLV *)p;
+                        if (NULL == (p = _materializeTLV(tlv)))
+                        {
+                            malformed = 1;
+                        }
+                        else
+                        {
+                            free_1905_TLV_structure((uint8_t *)ipv6);
+                            ipv6 = (struct ipv6TypeTLV *)p;
+                        }
                         break;
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
-
-                        free_1905_TLV_structure(p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
                         break;
                     }
                 }
-                i++;
             }
 
-            if (0 == al_mac_address_is_present)
+            if (1 == malformed || 0 == al_mac_address_is_present)
             {
-                PLATFORM_PRINTF_DEBUG_WARNING("More TLVs were expected inside this CMDU\n");
+                if (0 == al_mac_address_is_present)
+                {
+                    PLATFORM_PRINTF_DEBUG_WARNING("More TLVs were expected inside this CMDU\n");
+                }
+
+                free_1905_TLV_structure((uint8_t *)profile);
+                free_1905_TLV_structure((uint8_t *)identification);
+                free_1905_TLV_structure((uint8_t *)control_url);
+                free_1905_TLV_structure((uint8_t *)ipv4);
+                free_1905_TLV_structure((uint8_t *)ipv6);
+
                 return PROCESS_CMDU_KO;
             }
 
             // Next, update the database. This will take care of duplicate
             // entries (and free the TLV if needed)
             //
+            generation = DMnetworkDeviceGeneration(al_mac_address);
+
             PLATFORM_PRINTF_DEBUG_DETAIL("Updating network devices database...\n");
             DMupdateNetworkDeviceInfo(al_mac_address,
                                       0, NULL,
@@ -1848,17 +2038,16 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                                       1, ipv4,
                                       1, ipv6);
 
-            // References to the TLVs cannot be freed by the caller (see the
-            // comment in "case CMDU_TYPE_TOPOLOGY_RESPONSE:" to understand the
-            // following two lines).
-            //
-            free(c->list_of_TLVs);
-            c->list_of_TLVs = NULL;
-
             // Show all network devices (ie. print them through the logging
-            // system)
+            // system), but only if something has changed
             //
-            DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            if (
+                 1 == PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL) &&
+                 generation != DMnetworkDeviceGeneration(al_mac_address)
+               )
+            {
+                DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            }
 
             break;
         }
@@ -1868,55 +2057,70 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             // set the local interfaces to the requested power modes and reply
             // back with the result of these operations
 
-            struct interfacePowerChangeInformationTLV *t;
+            struct TLV_view *tlv;
+            uint8_t         *entries;
+            uint8_t          entries_nr;
+            uint16_t         i;
 
-            uint8_t *p;
-            uint8_t  i;
+            uint8_t *interface_address;
+            uint8_t  requested_power_state;
 
             PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_INTERFACE_POWER_CHANGE_REQUEST (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
-
             // Search for the "interface power change information type" TLV
             //
-            i = 0;
-            t = NULL;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            entries = NULL;
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION:
                     {
-                        t = (struct interfacePowerChangeInformationTLV *)p;
+                        // Read straight from the packet: the value is the
+                        // number of interfaces followed by one 7 bytes entry
+                        // (6 bytes MAC address, 1 byte state) per interface.
+                        // A zero length TLV means "no interfaces" (see
+                        // "FIX_BROKEN_TLVS").
+                        //
+                        entries_nr = tlv->length > 0 ? tlv->stream[3] : 0;
+
+                        if (tlv->length > 0 && tlv->length != 1 + 7 * entries_nr)
+                        {
+                            PLATFORM_PRINTF_DEBUG_WARNING("Malformed TLV (%d) inside CMDU\n", tlv->type);
+                            break;
+                        }
+
+                        entries = tlv->stream + 4;
                         break;
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
 
                         break;
                     }
                 }
-                i++;
             }
 
-            if (NULL == t)
+            if (NULL == entries)
             {
                 PLATFORM_PRINTF_DEBUG_WARNING("More TLVs were expected inside this CMDU\n");
                 return PROCESS_CMDU_KO;
             }
 
-            for (i=0; i<t->power_change_interfaces_nr; i++)
+            for (i=0; i<entries_nr; i++)
             {
                 uint8_t r;
                 uint8_t results;
 
+                interface_address     = entries + 7 * i;
+                requested_power_state = entries[7 * i + 6];
+
 #ifndef DO_NOT_ACCEPT_UNAUTHENTICATED_COMMANDS
-                r = PLATFORM_SET_INTERFACE_POWER_MODE(DMmacToInterfaceName(t->power_change_interfaces[i].interface_address), t->power_change_interfaces[i].requested_power_state);
+                r = PLATFORM_SET_INTERFACE_POWER_MODE(DMmacToInterfaceName(interface_address), requested_power_state);
+                markLocalDeviceDataDirty(LOCAL_DEVICE_DATA_INTERFACES);
 #else
                 r = INTERFACE_POWER_RESULT_KO;
 #endif
@@ -1940,7 +2144,7 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                     }
                     case INTERFACE_POWER_RESULT_KO:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("  Could not set power mode on interface %s\n",DMmacToInterfaceName(t->power_change_interfaces[i].interface_address));
+                        PLATFORM_PRINTF_DEBUG_WARNING("  Could not set power mode on interface %s\n",DMmacToInterfaceName(interface_address));
                         results = POWER_STATE_RESULT_NO_CHANGE;
                         break;
                     }
@@ -1953,11 +2157,11 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
                 }
 
                 PLATFORM_PRINTF_DEBUG_DETAIL("  Setting interface #%d %s (%02x:%02x:%02x:%02x:%02x:%02x) to %s --> %s\n", i,
-                                             DMmacToInterfaceName(t->power_change_interfaces[i].interface_address),
-                                             t->power_change_interfaces[i].interface_address[0], t->power_change_interfaces[i].interface_address[1], t->power_change_interfaces[i].interface_address[2], t->power_change_interfaces[i].interface_address[3], t->power_change_interfaces[i].interface_address[4], t->power_change_interfaces[i].interface_address[5],
-                                             t->power_change_interfaces[i].requested_power_state == POWER_STATE_REQUEST_OFF  ? "POWER OFF"  :
-                                             t->power_change_interfaces[i].requested_power_state == POWER_STATE_REQUEST_ON   ? "POWER ON"   :
-                                             t->power_change_interfaces[i].requested_power_state == POWER_STATE_REQUEST_SAVE ? "POWER SAVE" :
+                                             DMmacToInterfaceName(interface_address),
+                                             interface_address[0], interface_address[1], interface_address[2], interface_address[3], interface_address[4], interface_address[5],
+                                             requested_power_state == POWER_STATE_REQUEST_OFF  ? "POWER OFF"  :
+                                             requested_power_state == POWER_STATE_REQUEST_ON   ? "POWER ON"   :
+                                             requested_power_state == POWER_STATE_REQUEST_SAVE ? "POWER SAVE" :
                                              "Unknown",
                                              results == POWER_STATE_RESULT_COMPLETED ? "Completed" :
                                              results == POWER_STATE_RESULT_NO_CHANGE ? "No change" :
@@ -1973,56 +2177,70 @@ uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8
             // When an "interface power change" response is received we don't
             // need to do anything special. Simply log the event.
 
-            struct interfacePowerChangeStatusTLV *t;
+            struct TLV_view *tlv;
+            uint8_t         *entries;
+            uint8_t          entries_nr;
+            uint16_t         i;
 
-            uint8_t *p;
-            uint8_t  i;
+            uint8_t *interface_address;
+            uint8_t  result;
 
             PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_INTERFACE_POWER_CHANGE_RESPONSE (%s)\n", DMmacToInterfaceName(receiving_interface_addr));
 
-            if (NULL == c->list_of_TLVs)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-                break;
-            }
-
             // Search for the "interface power change status" TLV
             //
-            i = 0;
-            t = NULL;
-            while (NULL != (p = c->list_of_TLVs[i]))
+            entries = NULL;
+            for (i=0; i<v->tlvs_nr; i++)
             {
-                switch (*p)
+                tlv = &v->tlvs[i];
+
+                switch (tlv->type)
                 {
                     case TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS:
                     {
-                        t = (struct interfacePowerChangeStatusTLV *)p;
+                        // Read straight from the packet: the value is the
+                        // number of interfaces followed by one 7 bytes entry
+                        // (6 bytes MAC address, 1 byte state) per interface.
+                        // A zero length TLV means "no interfaces" (see
+                        // "FIX_BROKEN_TLVS").
+                        //
+                        entries_nr = tlv->length > 0 ? tlv->stream[3] : 0;
+
+                        if (tlv->length > 0 && tlv->length != 1 + 7 * entries_nr)
+                        {
+                            PLATFORM_PRINTF_DEBUG_WARNING("Malformed TLV (%d) inside CMDU\n", tlv->type);
+                            break;
+                        }
+
+                        entries = tlv->stream + 4;
                         break;
                     }
                     default:
                     {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", *p);
+                        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected TLV (%d) type inside CMDU\n", tlv->type);
 
                         break;
                     }
                 }
-                i++;
             }
 
-            if (NULL == t)
+            if (NULL == entries)
             {
                 PLATFORM_PRINTF_DEBUG_WARNING("More TLVs were expected inside this CMDU\n");
                 return PROCESS_CMDU_KO;
             }
 
-            for (i=0; i<t->power_change_interfaces_nr; i++)
+            for (i=0; i<entries_nr; i++)
             {
+                interface_address = entries + 7 * i;
+                result            = entries[7 * i + 6];
+
                 PLATFORM_PRINTF_DEBUG_DETAIL("  Interface #%d %s (%02x:%02x:%02x:%02x:%02x:%02x) --> %s\n", i,
-                                             DMmacToInterfaceName(t->power_change_interfaces[i].interface_address),
-                                             t->power_change_interfaces[i].interface_address[0], t->power_change_interfaces[i].interface_address[1], t->power_change_interfaces[i].interface_address[2], t->power_change_interfaces[i].interface_address[3], t->power_change_interfaces[i].interface_address[4], t->power_change_interfaces[i].interface_address[5],
-                                             t->power_change_interfaces[i].result == POWER_STATE_RESULT_COMPLETED ? "Completed" :
-                                             t->power_change_interfaces[i].result == POWER_STATE_RESULT_NO_CHANGE ? "No change" :
-                                             t->power_change_interfaces[i].result == POWER_STATE_RESULT_ALTERNATIVE_CHANGE ? "Alternative change" :
+                                             DMmacToInterfaceName(interface_address),
+                                             interface_address[0], interface_address[1], interface_address[2], interface_address[3], interface_address[4], interface_address[5],
+                                             result == POWER_STATE_RESULT_COMPLETED ? "Completed" :
+                                             result == POWER_STATE_RESULT_NO_CHANGE ? "No change" :
+                                             result == POWER_STATE_RESULT_ALTERNATIVE_CHANGE ? "Alternative change" :
                                              "Unknown");
             }
 
@@ -2121,10 +2339,24 @@ uint8_t processLlpdPayload(struct PAYLOAD *payload, uint8_t *receiving_interface
 
     // Finally, update the data model
     //
-    if (0 == DMupdateDiscoveryTimeStamps(receiving_interface_addr, al_mac_address, mac_address, TIMESTAMP_BRIDGE_DISCOVERY, NULL))
+    switch (DMupdateDiscoveryTimeStamps(receiving_interface_addr, al_mac_address, mac_address, TIMESTAMP_BRIDGE_DISCOVERY, NULL))
     {
-        PLATFORM_PRINTF_DEBUG_WARNING("Problems updating data model with topology response TLVs\n");
-        return 0;
+        case 0:
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("Problems updating data model with topology response TLVs\n");
+            return 0;
+        }
+        case 1:
+        {
+            // A new neighbor (or a new link with an already known one)
+            //
+            markLocalDeviceDataDirty(LOCAL_DEVICE_DATA_NEIGHBORS | LOCAL_DEVICE_DATA_METRICS);
+            break;
+        }
+        default:
+        {
+            break;
+        }
     }
 
     return 1;
@@ -60,7 +60,11 @@
 // This function does *not* deal with "discarding" or "forwarding" the packet
 // (that should have already been taken care of before this function is called)
 //
-// 'c' is the just received CMDU structure.
+// 'v' is the view of the just received CMDU. Its TLVs are read straight from
+// the packet, and only those that are stored in the topology data base are
+// parsed into their own structures (see "materialize_1905_TLV_view()"), thus
+// 'v' (and the packet it points to) can be released as soon as this function
+// returns.
 //
 // 'receiving_interface_addr' is the MAC address of the local interface where
 // the CMDU packet was received
@@ -84,7 +88,7 @@
 #define PROCESS_CMDU_KO                     (0)
 #define PROCESS_CMDU_OK                     (1)
 #define PROCESS_CMDU_OK_TRIGGER_AP_SEARCH   (2)
-uint8_t process1905Cmdu(struct CMDU *c, uint8_t *receiving_interface_addr, uint8_t *src_addr, uint8_t queue_id);
+uint8_t process1905Cmdu(struct CMDU_view *v, uint8_t *receiving_interface_addr, uint8_t *src_addr, uint8_t queue_id);
 
 // Call this function when receiving an LLPD "bridge discovery" message so that
 // the topology database is properly updated.
@@ -56,6 +56,7 @@
 #include "al_send.h"
 #include "al_datamodel.h"
 #include "al_utils.h"
+#include "al_metrics.h"
 
 #include "1905_tlvs.h"
 #include "1905_cmdus.h"
@@ -317,7 +318,7 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
 {
     char                  **interfaces_names;
     uint8_t                   interfaces_names_nr;
-    uint8_t                   i, j, k;
+    uint16_t                  i, j, k;
 
     *non_1905_neighbors    = NULL;
     *neighbors             = NULL;
@@ -326,7 +327,7 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
     *neighbors_nr          = 0;
 
     uint8_t (*al_mac_addresses)[6];
-    uint8_t al_mac_addresses_nr;
+    uint16_t al_mac_addresses_nr;
 
     interfaces_names = PLATFORM_GET_LIST_OF_1905_INTERFACES(&interfaces_names_nr);
 
@@ -389,7 +390,7 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
             for (j=0; j<x->neighbor_mac_addresses_nr; j++)
             {
                 uint8_t *al_mac;
-                uint8_t k;
+                uint16_t k;
 
                 al_mac = DMmacToAlMac(x->neighbor_mac_addresses[j]);
 
@@ -1015,13 +1016,13 @@ void _obtainLocalMetricsTLVs(uint8_t destination, uint8_t *specific_neighbor, ui
                              uint8_t *nr)
 {
     uint8_t (*al_mac_addresses)[6];
-    uint8_t   al_mac_addresses_nr;
+    uint16_t  al_mac_addresses_nr;
 
     struct transmitterLinkMetricTLV   **tx_tlvs;
     struct receiverLinkMetricTLV      **rx_tlvs;
 
     uint8_t total_tlvs;
-    uint8_t i, j;
+    uint16_t i, j;
 
     al_mac_addresses = DMgetListOfNeighbors(&al_mac_addresses_nr);
 
@@ -1129,25 +1130,44 @@ void _obtainLocalMetricsTLVs(uint8_t destination, uint8_t *specific_neighbor, ui
             //
             for (j=0; j<links_nr; j++)
             {
-                struct interfaceInfo *f;
-                struct linkMetrics   *l;
-
-                f = PLATFORM_GET_1905_INTERFACE_INFO(local_interfaces[j]);
-                l = PLATFORM_GET_LINK_METRICS(local_interfaces[j], remote_macs[j]);
+                struct linkMetricsSample *sample;
+                struct linkMetrics       *l;
+                uint16_t                  intf_type;
 
-                if (NULL != tx_tlvs)
+                // Metrics are served from the last sample taken by the link
+                // metrics sampler. Only links that have appeared after that
+                // sample was taken need to be queried to the platform.
+                //
+                sample = metricsSamplerLookup(DMinterfaceNameToMac(local_interfaces[j]), remote_macs[j]);
+                if (NULL != sample)
                 {
-                    memcpy(tx_tlvs[total_tlvs]->transmitter_link_metrics[j].local_interface_address,    DMinterfaceNameToMac(local_interfaces[j]), 6);
-                    memcpy(tx_tlvs[total_tlvs]->transmitter_link_metrics[j].neighbor_interface_address, remote_macs[j],                            6);
+                    intf_type = sample->intf_type;
+                    l         = &sample->metrics;
+                }
+                else
+                {
+                    struct interfaceInfo *f;
 
+                    f = PLATFORM_GET_1905_INTERFACE_INFO(local_interfaces[j]);
                     if (NULL == f)
                     {
-                        tx_tlvs[total_tlvs]->transmitter_link_metrics[j].intf_type = MEDIA_TYPE_UNKNOWN;
+                        intf_type = MEDIA_TYPE_UNKNOWN;
                     }
                     else
                     {
-                        tx_tlvs[total_tlvs]->transmitter_link_metrics[j].intf_type = f->interface_type;
+                        intf_type = f->interface_type;
+                        free_1905_INTERFACE_INFO(f);
                     }
+
+                    l = PLATFORM_GET_LINK_METRICS(local_interfaces[j], remote_macs[j]);
+                }
+
+                if (NULL != tx_tlvs)
+                {
+                    memcpy(tx_tlvs[total_tlvs]->transmitter_link_metrics[j].local_interface_address,    DMinterfaceNameToMac(local_interfaces[j]), 6);
+                    memcpy(tx_tlvs[total_tlvs]->transmitter_link_metrics[j].neighbor_interface_address, remote_macs[j],                            6);
+
+                    tx_tlvs[total_tlvs]->transmitter_link_metrics[j].intf_type   = intf_type;
                     tx_tlvs[total_tlvs]->transmitter_link_metrics[j].bridge_flag = DMisLinkBridged(local_interfaces[j], al_mac_addresses[i], remote_macs[j]);
 
                     if (NULL == l)
@@ -1173,14 +1193,7 @@ void _obtainLocalMetricsTLVs(uint8_t destination, uint8_t *specific_neighbor, ui
                     memcpy(rx_tlvs[total_tlvs]->receiver_link_metrics[j].local_interface_address,    DMinterfaceNameToMac(local_interfaces[j]), 6);
                     memcpy(rx_tlvs[total_tlvs]->receiver_link_metrics[j].neighbor_interface_address, remote_macs[j],                            6);
 
-                    if (NULL == f)
-                    {
-                        rx_tlvs[total_tlvs]->receiver_link_metrics[j].intf_type = MEDIA_TYPE_UNKNOWN;
-                    }
-                    else
-                    {
-                        rx_tlvs[total_tlvs]->receiver_link_metrics[j].intf_type = f->interface_type;
-                    }
+                    rx_tlvs[total_tlvs]->receiver_link_metrics[j].intf_type = intf_type;
 
                     if (NULL == l)
                     {
@@ -1196,11 +1209,7 @@ void _obtainLocalMetricsTLVs(uint8_t destination, uint8_t *specific_neighbor, ui
                     }
                 }
 
-                if (NULL != f)
-                {
-                    free_1905_INTERFACE_INFO(f);
-                }
-                if (NULL != l)
+                if (NULL == sample && NULL != l)
                 {
                     free_LINK_METRICS(l);
                 }
@@ -2103,6 +2112,314 @@ void _memoryBufferWriterEnd()
     return;
 }
 
+//******************************************************************************
+//******* Frames forging and caching *******************************************
+//******************************************************************************
+//
+// Forge 'cmdu' (after adding the protocol extensions to it) and return the
+// NULL terminated list of resulting streams (one per fragment), or NULL if
+// there was a problem.
+//
+// 'streams_lens' and 'streams_nr' are output arguments set to the length of
+// each stream and the number of streams.
+//
+// Once no longer needed, the caller must free the returned list with
+// "free_1905_CMDU_packets()" and 'streams_lens' with "free()".
+//
+static uint8_t **_forgeCmdu(struct CMDU *cmdu, uint16_t **streams_lens, uint8_t *streams_nr)
+{
+    uint8_t **streams;
+
+    // Insert protocol extensions to the CMDU, which has been already built at
+    // this point.
+    //
+    send1905CmduExtensions(cmdu);
+
+    if (1 == PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("Contents of CMDU to send:\n");
+        visit_1905_CMDU_structure(cmdu, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+    }
+
+    streams = forge_1905_CMDU_from_structure(cmdu, streams_lens);
+    if (NULL == streams)
+    {
+        // Could not forge the packet. Error?
+        //
+        PLATFORM_PRINTF_DEBUG_WARNING("forge_1905_CMDU_from_structure() failed!\n");
+        return NULL;
+    }
+
+    // Free previously allocated CMDU extensions (no longer needed)
+    //
+    free1905CmduExtensions(cmdu);
+
+    *streams_nr = 0;
+    while(streams[*streams_nr])
+    {
+        (*streams_nr)++;
+    }
+
+    if (0 == *streams_nr)
+    {
+        // Could not forge the packet. Error?
+        //
+        PLATFORM_PRINTF_DEBUG_WARNING("forge_1905_CMDU_from_structure() returned 0 streams!\n");
+
+        free_1905_CMDU_packets(streams);
+        free(*streams_lens);
+        return NULL;
+    }
+
+    return streams;
+}
+
+// Send the 'streams_nr' forged 'streams' (as returned by "_forgeCmdu()") on all
+// the 'interfaces_nr' interfaces contained in 'interfaces_names'.
+//
+static void _sendStreams(char **interfaces_names, uint8_t interfaces_nr, uint16_t mid, uint8_t *dst_mac_address, uint8_t **streams, uint16_t *streams_lens, uint8_t streams_nr)
+{
+    struct rawPacket *packets;
+    uint16_t          packets_nr;
+
+    uint8_t x, i;
+
+    // Build the list of frames to send, grouped by interface (all fragments on
+    // the first interface, then all fragments on the second one, etc...) so
+    // that the platform can push each group at once
+    //
+    packets    = (struct rawPacket *)memalloc(sizeof(struct rawPacket) * streams_nr * interfaces_nr);
+    packets_nr = 0;
+
+    for (i=0; i<interfaces_nr; i++)
+    {
+        for (x=0; x<streams_nr; x++)
+        {
+            PLATFORM_PRINTF_DEBUG_DETAIL("Sending 1905 message on interface %s, MID %d, fragment %d/%d\n", interfaces_names[i], mid, x+1, streams_nr);
+
+            packets[packets_nr].interface_name = interfaces_names[i];
+            packets[packets_nr].dst_mac        = dst_mac_address;
+            packets[packets_nr].src_mac        = DMalMacGet();
+            packets[packets_nr].eth_type       = ETHERTYPE_1905;
+            packets[packets_nr].payload        = streams[x];
+            packets[packets_nr].payload_len    = streams_lens[x];
+            packets_nr++;
+        }
+    }
+
+    if (0 == PLATFORM_SEND_RAW_PACKETS(packets, packets_nr))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("Packet could not be sent!\n");
+    }
+
+    free(packets);
+}
+
+// Some CMDUs (the "topology discovery" and the "topology response" ones) are
+// sent very often and their contents only change when the local topology
+// changes.
+//
+// Instead of building and forging them each time, the forged streams are kept
+// in this cache (one entry per interface and CMDU type). Next time the same
+// CMDU has to be sent on the same interface, only its 'mid' (the only field
+// that changes from one transmission to the next one) is patched in the cached
+// streams before sending them again.
+//
+// Entries are discarded when the local information they were built from is
+// flagged as stale (see "markLocalDeviceDataDirty()"). Those whose contents
+// also come from platform information whose changes are not notified are, in
+// addition, not used for longer than FRAME_CACHE_MAX_AGE_MS milliseconds.
+//
+struct _cachedFrames
+{
+    char      *interface_name;
+    uint16_t   message_type;
+    uint32_t   timestamp;       // When the streams were forged
+
+    uint8_t  **streams;         // As returned by "_forgeCmdu()"
+    uint16_t  *streams_lens;
+    uint8_t    streams_nr;
+};
+
+static struct
+{
+    struct _cachedFrames *entries;
+    uint8_t               entries_nr;
+
+    uint32_t              hits;
+    uint32_t              misses;
+} frame_cache;
+
+// What the contents of each type of cached CMDU depend on
+//
+static struct
+{
+    uint16_t  message_type;
+    uint32_t  depends_on;       // "LOCAL_DEVICE_DATA_*" parts
+    uint8_t   expires;          // '1' if FRAME_CACHE_MAX_AGE_MS applies
+
+} frame_cache_types[] =
+{
+    // Only the AL MAC address and the MAC address of the interface
+    //
+    { CMDU_TYPE_TOPOLOGY_DISCOVERY, LOCAL_DEVICE_DATA_INTERFACES,                                                            0 },
+
+    // Device information, neighbors, supported services, ...
+    //
+    { CMDU_TYPE_TOPOLOGY_RESPONSE,  LOCAL_DEVICE_DATA_INTERFACES | LOCAL_DEVICE_DATA_NEIGHBORS | LOCAL_DEVICE_DATA_IDENTITY, 1 },
+};
+
+// Offset, inside each forged stream, of the CMDU 'mid' field (it comes right
+// after the 'message version', 'reserved' and 'message type' fields)
+//
+#define CMDU_MID_OFFSET  (4)
+
+static struct _cachedFrames *_frameCacheFind(char *interface_name, uint16_t message_type)
+{
+    uint8_t i;
+
+    for (i=0; i<frame_cache.entries_nr; i++)
+    {
+        if (
+             frame_cache.entries[i].message_type == message_type &&
+             0 == strcmp(frame_cache.entries[i].interface_name, interface_name)
+           )
+        {
+            return &frame_cache.entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+// Return the entry of "frame_cache_types" for CMDU type 'message_type' (which
+// must be one of the types that are cached)
+//
+static uint8_t _frameCacheType(uint16_t message_type)
+{
+    uint8_t i;
+
+    for (i=0; i<sizeof(frame_cache_types)/sizeof(frame_cache_types[0]) - 1; i++)
+    {
+        if (frame_cache_types[i].message_type == message_type)
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+// Remove the cached streams of all CMDU types whose contents depend on any of
+// the 'parts' (an OR'ed combination of "LOCAL_DEVICE_DATA_*" values)
+//
+static void _frameCacheFlush(uint32_t parts)
+{
+    uint8_t i, kept;
+
+    kept = 0;
+    for (i=0; i<frame_cache.entries_nr; i++)
+    {
+        if (0 == (frame_cache_types[_frameCacheType(frame_cache.entries[i].message_type)].depends_on & parts))
+        {
+            frame_cache.entries[kept++] = frame_cache.entries[i];
+            continue;
+        }
+
+        free(frame_cache.entries[i].interface_name);
+        free_1905_CMDU_packets(frame_cache.entries[i].streams);
+        free(frame_cache.entries[i].streams_lens);
+    }
+    frame_cache.entries_nr = kept;
+
+    if (0 == frame_cache.entries_nr && NULL != frame_cache.entries)
+    {
+        free(frame_cache.entries);
+        frame_cache.entries = NULL;
+    }
+}
+
+// If a (not too old) forged version of the CMDU of type 'message_type' for
+// interface 'interface_name' exists in the cache, send it with the new 'mid'
+// and return '1'. Otherwise return '0' (and the caller must build the CMDU and
+// call "_frameCacheForgeAndSend()").
+//
+static uint8_t _frameCacheSend(char *interface_name, uint16_t message_type, uint16_t mid, uint8_t *dst_mac_address)
+{
+    struct _cachedFrames *c;
+    uint8_t               x;
+
+    c = _frameCacheFind(interface_name, message_type);
+    if (
+         NULL == c ||
+         (
+           1 == frame_cache_types[_frameCacheType(message_type)].expires &&
+           PLATFORM_GET_TIMESTAMP() - c->timestamp > FRAME_CACHE_MAX_AGE_MS
+         )
+       )
+    {
+        frame_cache.misses++;
+        return 0;
+    }
+    frame_cache.hits++;
+
+    for (x=0; x<c->streams_nr; x++)
+    {
+        c->streams[x][CMDU_MID_OFFSET]   = (uint8_t)(mid >> 8);
+        c->streams[x][CMDU_MID_OFFSET+1] = (uint8_t)(mid & 0xff);
+    }
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("Using cached frames for CMDU type 0x%04x on interface %s\n", message_type, interface_name);
+
+    _sendStreams(&interface_name, 1, mid, dst_mac_address, c->streams, c->streams_lens, c->streams_nr);
+
+    return 1;
+}
+
+// Forge 'cmdu', send it on interface 'interface_name' and keep the forged
+// streams in the cache for the next time.
+//
+// Return '0' if there was a problem, '1' otherwise.
+//
+static uint8_t _frameCacheForgeAndSend(char *interface_name, uint16_t mid, uint8_t *dst_mac_address, struct CMDU *cmdu)
+{
+    struct _cachedFrames *c;
+
+    uint8_t  **streams;
+    uint16_t  *streams_lens;
+    uint8_t    streams_nr;
+
+    streams = _forgeCmdu(cmdu, &streams_lens, &streams_nr);
+    if (NULL == streams)
+    {
+        return 0;
+    }
+
+    _sendStreams(&interface_name, 1, mid, dst_mac_address, streams, streams_lens, streams_nr);
+
+    c = _frameCacheFind(interface_name, cmdu->message_type);
+    if (NULL == c)
+    {
+        frame_cache.entries = (struct _cachedFrames *)memrealloc(frame_cache.entries, sizeof(struct _cachedFrames) * (frame_cache.entries_nr + 1));
+        c = &frame_cache.entries[frame_cache.entries_nr++];
+
+        c->interface_name = strdup(interface_name);
+        c->message_type   = cmdu->message_type;
+    }
+    else
+    {
+        free_1905_CMDU_packets(c->streams);
+        free(c->streams_lens);
+    }
+
+    c->timestamp    = PLATFORM_GET_TIMESTAMP();
+    c->streams      = streams;
+    c->streams_lens = streams_lens;
+    c->streams_nr   = streams_nr;
+
+    return 1;
+}
+
 //******************************************************************************
 //******* Local device data dump ***********************************************
 //******************************************************************************
@@ -2127,21 +2444,28 @@ void _memoryBufferWriterEnd()
 // ("CUSTOM_COMMAND_DUMP_NETWORK_DEVICES") and, as a result, we must send the
 // local information as part of the response.
 //
+// Regenerating all the TLVs every time is expensive, thus only the parts of
+// the local information flagged as stale (see "markLocalDeviceDataDirty()")
+// are regenerated, and the rest are left untouched in the database.
+//
+static uint32_t local_device_dirty     = LOCAL_DEVICE_DATA_ALL;
+static uint32_t local_device_timestamp = 0;
+
 void _updateLocalDeviceData()
 {
-    struct deviceInformationTypeTLV            *info;
-    struct deviceBridgingCapabilityTLV        **bridges;
-    struct non1905NeighborDeviceListTLV       **non1905_neighbors; uint8_t non1905_neighbors_nr;
-    struct neighborDeviceListTLV              **x1905_neighbors;   uint8_t x1905_neighbors_nr;
-    struct powerOffInterfaceTLV               **power_off;
-    struct l2NeighborDeviceTLV                **l2_neighbors;
-    struct supportedServiceTLV                 *supported_service_tlv;
-    struct genericPhyDeviceInformationTypeTLV  *generic_phy;
-    struct x1905ProfileVersionTLV              *profile;
-    struct deviceIdentificationTypeTLV         *identification;
-    struct controlUrlTypeTLV                   *control_url;
-    struct ipv4TypeTLV                         *ipv4;
-    struct ipv6TypeTLV                         *ipv6;
+    struct deviceInformationTypeTLV            *info                  = NULL;
+    struct deviceBridgingCapabilityTLV        **bridges               = NULL;
+    struct non1905NeighborDeviceListTLV       **non1905_neighbors     = NULL; uint8_t non1905_neighbors_nr = 0;
+    struct neighborDeviceListTLV              **x1905_neighbors       = NULL; uint8_t x1905_neighbors_nr   = 0;
+    struct powerOffInterfaceTLV               **power_off             = NULL;
+    struct l2NeighborDeviceTLV                **l2_neighbors          = NULL;
+    struct supportedServiceTLV                 *supported_service_tlv = NULL;
+    struct genericPhyDeviceInformationTypeTLV  *generic_phy           = NULL;
+    struct x1905ProfileVersionTLV              *profile               = NULL;
+    struct deviceIdentificationTypeTLV         *identification        = NULL;
+    struct controlUrlTypeTLV                   *control_url           = NULL;
+    struct ipv4TypeTLV                         *ipv4                  = NULL;
+    struct ipv6TypeTLV                         *ipv6                  = NULL;
 
     struct transmitterLinkMetricTLV           **tx_tlvs;
     struct receiverLinkMetricTLV              **rx_tlvs;
@@ -2150,83 +2474,121 @@ void _updateLocalDeviceData()
 
     struct vendorSpecificTLV                  **extensions;        uint8_t extensions_nr;
 
+    uint8_t  interfaces_update;
+    uint8_t  neighbors_update;
+    uint8_t  identity_update;
+
+    if (PLATFORM_GET_TIMESTAMP() - local_device_timestamp > LOCAL_DEVICE_DATA_MAX_AGE_MS)
+    {
+        local_device_dirty = LOCAL_DEVICE_DATA_ALL;
+    }
+    if (LOCAL_DEVICE_DATA_ALL == local_device_dirty)
+    {
+        local_device_timestamp = PLATFORM_GET_TIMESTAMP();
+    }
+
+    interfaces_update = (local_device_dirty & LOCAL_DEVICE_DATA_INTERFACES) ? 1 : 0;
+    neighbors_update  = (local_device_dirty & LOCAL_DEVICE_DATA_NEIGHBORS)  ? 1 : 0;
+    identity_update   = (local_device_dirty & LOCAL_DEVICE_DATA_IDENTITY)   ? 1 : 0;
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("Updating local device data (dirty parts: 0x%02x)\n", local_device_dirty);
+
     // We need to allocate these structures in the heap (instead of simply
     // declaring variables in the stack) because they are going to be "saved"
     // in the database when calling "DMupdate*()"
     //
-    info            = (struct deviceInformationTypeTLV*)          memalloc(sizeof(struct deviceInformationTypeTLV));
-    bridges         = (struct deviceBridgingCapabilityTLV**)      memalloc(sizeof(struct deviceBridgingCapabilityTLV*));
-    bridges[0]      = (struct deviceBridgingCapabilityTLV*)       memalloc(sizeof(struct deviceBridgingCapabilityTLV));
-    power_off       = (struct powerOffInterfaceTLV**)             memalloc(sizeof(struct powerOffInterfaceTLV*));
-    power_off[0]    = (struct powerOffInterfaceTLV*)              memalloc(sizeof(struct powerOffInterfaceTLV));
-    l2_neighbors    = (struct l2NeighborDeviceTLV**)              memalloc(sizeof(struct l2NeighborDeviceTLV*));
-    l2_neighbors[0] = (struct l2NeighborDeviceTLV*)               memalloc(sizeof(struct l2NeighborDeviceTLV));
-    supported_service_tlv = (struct supportedServiceTLV*)         memalloc(sizeof(struct supportedServiceTLV));
-    generic_phy     = (struct genericPhyDeviceInformationTypeTLV*)memalloc(sizeof(struct genericPhyDeviceInformationTypeTLV));
-    profile         = (struct x1905ProfileVersionTLV*)            memalloc(sizeof(struct x1905ProfileVersionTLV));
-    identification  = (struct deviceIdentificationTypeTLV*)       memalloc(sizeof(struct deviceIdentificationTypeTLV));
-    control_url     = (struct controlUrlTypeTLV*)                 memalloc(sizeof(struct controlUrlTypeTLV));
-    ipv4            = (struct ipv4TypeTLV*)                       memalloc(sizeof(struct ipv4TypeTLV));
-    ipv6            = (struct ipv6TypeTLV*)                       memalloc(sizeof(struct ipv6TypeTLV));
-
-    _obtainLocalDeviceInfoTLV           (info);
-    _obtainLocalBridgingCapabilitiesTLV (bridges[0]);
-    _obtainLocalNeighborsTLV            (&non1905_neighbors, &non1905_neighbors_nr, &x1905_neighbors, &x1905_neighbors_nr);
-    _obtainLocalPowerOffInterfacesTLV   (power_off[0]);
-    _obtainLocalL2NeighborsTLV          (l2_neighbors[0]);
-    _obtainLocalSupportedServicesTLV    (supported_service_tlv);
-    _obtainLocalGenericPhyTLV           (generic_phy);
-    _obtainLocalProfileTLV              (profile);
-    _obtainLocalDeviceIdentificationTLV (identification);
-    _obtainLocalControlUrlTLV           (control_url);
-    _obtainLocalIpsTLVs                 (ipv4, ipv6);
-
-    _obtainLocalMetricsTLVs             (LINK_METRIC_QUERY_TLV_ALL_NEIGHBORS,
-                                         NULL,
-                                         LINK_METRIC_QUERY_TLV_BOTH_TX_AND_RX_LINK_METRICS,
-                                         &tx_tlvs,
-                                         &rx_tlvs,
-                                         &total_metrics_tlvs);
+    if (1 == interfaces_update)
+    {
+        info            = (struct deviceInformationTypeTLV*)          memalloc(sizeof(struct deviceInformationTypeTLV));
+        bridges         = (struct deviceBridgingCapabilityTLV**)      memalloc(sizeof(struct deviceBridgingCapabilityTLV*));
+        bridges[0]      = (struct deviceBridgingCapabilityTLV*)       memalloc(sizeof(struct deviceBridgingCapabilityTLV));
+        power_off       = (struct powerOffInterfaceTLV**)             memalloc(sizeof(struct powerOffInterfaceTLV*));
+        power_off[0]    = (struct powerOffInterfaceTLV*)              memalloc(sizeof(struct powerOffInterfaceTLV));
+        generic_phy     = (struct genericPhyDeviceInformationTypeTLV*)memalloc(sizeof(struct genericPhyDeviceInformationTypeTLV));
+        ipv4            = (struct ipv4TypeTLV*)                       memalloc(sizeof(struct ipv4TypeTLV));
+        ipv6            = (struct ipv6TypeTLV*)                       memalloc(sizeof(struct ipv6TypeTLV));
+
+        _obtainLocalDeviceInfoTLV           (info);
+        _obtainLocalBridgingCapabilitiesTLV (bridges[0]);
+        _obtainLocalPowerOffInterfacesTLV   (power_off[0]);
+        _obtainLocalGenericPhyTLV           (generic_phy);
+        _obtainLocalIpsTLVs                 (ipv4, ipv6);
+    }
+    if (1 == neighbors_update)
+    {
+        l2_neighbors    = (struct l2NeighborDeviceTLV**)              memalloc(sizeof(struct l2NeighborDeviceTLV*));
+        l2_neighbors[0] = (struct l2NeighborDeviceTLV*)               memalloc(sizeof(struct l2NeighborDeviceTLV));
 
-    // Retrieve extra (non-standard) local info by third-party implementations
-    // (i.e. BBF obtains non-1905 link metrics info)
-    //
-    obtainExtendedLocalInfo(&extensions, &extensions_nr);
+        _obtainLocalNeighborsTLV            (&non1905_neighbors, &non1905_neighbors_nr, &x1905_neighbors, &x1905_neighbors_nr);
+        _obtainLocalL2NeighborsTLV          (l2_neighbors[0]);
+    }
+    if (1 == identity_update)
+    {
+        supported_service_tlv = (struct supportedServiceTLV*)         memalloc(sizeof(struct supportedServiceTLV));
+        profile         = (struct x1905ProfileVersionTLV*)            memalloc(sizeof(struct x1905ProfileVersionTLV));
+        identification  = (struct deviceIdentificationTypeTLV*)       memalloc(sizeof(struct deviceIdentificationTypeTLV));
+        control_url     = (struct controlUrlTypeTLV*)                 memalloc(sizeof(struct controlUrlTypeTLV));
+
+        _obtainLocalSupportedServicesTLV    (supported_service_tlv);
+        _obtainLocalProfileTLV              (profile);
+        _obtainLocalDeviceIdentificationTLV (identification);
+        _obtainLocalControlUrlTLV           (control_url);
+    }
 
     // The following function will take care of "freeing" the allocated memory
     // if needed
     //
-    DMupdateNetworkDeviceInfo(info->al_mac_address,
-                              1, info,
-                              1, bridges,           1,
-                              1, non1905_neighbors, non1905_neighbors_nr,
-                              1, x1905_neighbors,   x1905_neighbors_nr,
-                              1, power_off,         1,
-                              1, l2_neighbors,      1,
-                              1, supported_service_tlv,
-                              1, generic_phy,
-                              1, profile,
-                              1, identification,
-                              1, control_url,
-                              1, ipv4,
-                              1, ipv6);
-
-    // The next function, however, takes care only of the pointers to metrics
-    // information, and not of the memory used to hold the list of pointers
-    // themselves...
-    //
-    for (i=0; i<total_metrics_tlvs; i++)
+    DMupdateNetworkDeviceInfo(DMalMacGet(),
+                              interfaces_update, info,
+                              interfaces_update, bridges,           1,
+                              neighbors_update,  non1905_neighbors, non1905_neighbors_nr,
+                              neighbors_update,  x1905_neighbors,   x1905_neighbors_nr,
+                              interfaces_update, power_off,         1,
+                              neighbors_update,  l2_neighbors,      1,
+                              identity_update,   supported_service_tlv,
+                              interfaces_update, generic_phy,
+                              identity_update,   profile,
+                              identity_update,   identification,
+                              identity_update,   control_url,
+                              interfaces_update, ipv4,
+                              interfaces_update, ipv6);
+
+    if (local_device_dirty & LOCAL_DEVICE_DATA_METRICS)
     {
-        DMupdateNetworkDeviceMetrics((uint8_t *)tx_tlvs[i]);
-        DMupdateNetworkDeviceMetrics((uint8_t *)rx_tlvs[i]);
+        _obtainLocalMetricsTLVs(LINK_METRIC_QUERY_TLV_ALL_NEIGHBORS,
+                                NULL,
+                                LINK_METRIC_QUERY_TLV_BOTH_TX_AND_RX_LINK_METRICS,
+                                &tx_tlvs,
+                                &rx_tlvs,
+                                &total_metrics_tlvs);
+
+        // The next function, however, takes care only of the pointers to
+        // metrics information, and not of the memory used to hold the list of
+        // pointers themselves...
+        //
+        for (i=0; i<total_metrics_tlvs; i++)
+        {
+            DMupdateNetworkDeviceMetrics((uint8_t *)tx_tlvs[i]);
+            DMupdateNetworkDeviceMetrics((uint8_t *)rx_tlvs[i]);
+        }
+
+        // ... and that's why we need to do this (the "0" is so that pointers
+        // themselves are not freed, as they are now responsibility of the
+        // database)
+        //
+        total_metrics_tlvs = 0;
+        _freeLocalMetricsTLVs(&tx_tlvs, &rx_tlvs, &total_metrics_tlvs);
     }
 
-    // ... and that's why we need to do this (the "0" is so that pointers
-    // themselves are not freed, as they are now responsibility of the
-    // database)
+    local_device_dirty = 0;
+
+    // Retrieve extra (non-standard) local info by third-party implementations
+    // (i.e. BBF obtains non-1905 link metrics info).
     //
-    total_metrics_tlvs = 0;
-    _freeLocalMetricsTLVs(&tx_tlvs, &rx_tlvs, &total_metrics_tlvs);
+    // There is no way to know when this information changes, thus it is
+    // always regenerated.
+    //
+    obtainExtendedLocalInfo(&extensions, &extensions_nr);
 
     // Update the datamodel with the extended info (Vendor Specific TLVs).
     // The next function, however, takes care only of the pointers to the TLVs,
@@ -2247,66 +2609,31 @@ void _updateLocalDeviceData()
 ////////////////////////////////////////////////////////////////////////////////
 
 uint8_t send1905RawPacket(char *interface_name, uint16_t mid, uint8_t *dst_mac_address, struct CMDU *cmdu)
+{
+    return send1905RawPacketOnInterfaces(&interface_name, 1, mid, dst_mac_address, cmdu);
+}
+
+uint8_t send1905RawPacketOnInterfaces(char **interfaces_names, uint8_t interfaces_nr, uint16_t mid, uint8_t *dst_mac_address, struct CMDU *cmdu)
 {
     uint8_t  **streams;
     uint16_t  *streams_lens;
+    uint8_t    streams_nr;
 
-    uint8_t total_streams, x;
-
-    // Insert protocol extensions to the CMDU, which has been already built at
-    // this point.
-    //
-    send1905CmduExtensions(cmdu);
-
-    PLATFORM_PRINTF_DEBUG_DETAIL("Contents of CMDU to send:\n");
-    visit_1905_CMDU_structure(cmdu, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
-
-    streams = forge_1905_CMDU_from_structure(cmdu, &streams_lens);
-    if (NULL == streams)
+    if (0 == interfaces_nr)
     {
-        // Could not forge the packet. Error?
-        //
-        PLATFORM_PRINTF_DEBUG_WARNING("forge_1905_CMDU_from_structure() failed!\n");
-        return 0;
+        return 1;
     }
 
-    // Free previously allocated CMDU extensions (no longer needed)
+    // The CMDU is forged only once, no matter on how many interfaces it is
+    // going to be sent
     //
-    free1905CmduExtensions(cmdu);
-
-    total_streams = 0;
-    while(streams[total_streams])
-    {
-        total_streams++;
-    }
-
-    if (0 == total_streams)
+    streams = _forgeCmdu(cmdu, &streams_lens, &streams_nr);
+    if (NULL == streams)
     {
-        // Could not forge the packet. Error?
-        //
-        PLATFORM_PRINTF_DEBUG_WARNING("forge_1905_CMDU_from_structure() returned 0 streams!\n");
-
-        free_1905_CMDU_packets(streams);
-        free(streams_lens);
         return 0;
     }
 
-    x = 0;
-    while(streams[x])
-    {
-        PLATFORM_PRINTF_DEBUG_DETAIL("Sending 1905 message on interface %s, MID %d, fragment %d/%d\n", interface_name, mid, x+1, total_streams);
-        if (0 == PLATFORM_SEND_RAW_PACKET(interface_name,
-                                          dst_mac_address,
-                                          DMalMacGet(),
-                                          ETHERTYPE_1905,
-                                          streams[x],
-                                          streams_lens[x]))
-        {
-            PLATFORM_PRINTF_DEBUG_ERROR("Packet could not be sent!\n");
-        }
-
-        x++;
-    }
+    _sendStreams(interfaces_names, interfaces_nr, mid, dst_mac_address, streams, streams_lens, streams_nr);
 
     free_1905_CMDU_packets(streams);
     free(streams_lens);
@@ -2359,6 +2686,11 @@ uint8_t send1905TopologyDiscoveryPacket(char *interface_name, uint16_t mid)
 
     PLATFORM_PRINTF_DEBUG_INFO("--> CMDU_TYPE_TOPOLOGY_DISCOVERY (%s)\n", interface_name);
 
+    if (1 == _frameCacheSend(interface_name, CMDU_TYPE_TOPOLOGY_DISCOVERY, mid, mcast_address))
+    {
+        return 1;
+    }
+
     memcpy(interface_mac_address, DMinterfaceNameToMac(interface_name), 6);
 
     // Fill the AL MAC address type TLV
@@ -2388,7 +2720,7 @@ uint8_t send1905TopologyDiscoveryPacket(char *interface_name, uint16_t mid)
 
     // Send the packet
     //
-    if (0 == send1905RawPacket(interface_name, mid, mcast_address, &discovery_message))
+    if (0 == _frameCacheForgeAndSend(interface_name, mid, mcast_address, &discovery_message))
     {
         PLATFORM_PRINTF_DEBUG_ERROR("Could not send the 1905 packet\n");
         free(discovery_message.list_of_TLVs);
@@ -2492,6 +2824,11 @@ uint8_t send1905TopologyResponsePacket(char *interface_name, uint16_t mid, uint8
     PLATFORM_PRINTF_DEBUG_INFO("--> CMDU_TYPE_TOPOLOGY_RESPONSE (%s)\n", interface_name);
     PLATFORM_PRINTF_DEBUG_DETAIL("Sending to %02x:%02x:%02x:%02x:%02x:%02x\n", destination_al_mac_address[0], destination_al_mac_address[1], destination_al_mac_address[2], destination_al_mac_address[3], destination_al_mac_address[4], destination_al_mac_address[5]);
 
+    if (1 == _frameCacheSend(interface_name, CMDU_TYPE_TOPOLOGY_RESPONSE, mid, destination_al_mac_address))
+    {
+        return 1;
+    }
+
     // Fill all the needed TLVs
     //
     _obtainLocalDeviceInfoTLV          (&device_info);
@@ -2579,7 +2916,7 @@ uint8_t send1905TopologyResponsePacket(char *interface_name, uint16_t mid, uint8
 
     // Send the packet
     //
-    if (0 == send1905RawPacket(interface_name, mid, destination_al_mac_address, &response_message))
+    if (0 == _frameCacheForgeAndSend(interface_name, mid, destination_al_mac_address, &response_message))
     {
         PLATFORM_PRINTF_DEBUG_WARNING("Could not send packet\n");
         ret = 0 ;
@@ -4146,3 +4483,17 @@ uint8_t send1905CustomCommandResponseALME(uint8_t alme_client_id, uint8_t comman
     return ret;
 }
 
+void markLocalDeviceDataDirty(uint32_t parts)
+{
+    local_device_dirty |= parts;
+
+    // Discard the cached messages built from any of these parts
+    //
+    _frameCacheFlush(parts);
+}
+
+void getFrameCacheStats(uint32_t *hits, uint32_t *misses)
+{
+    *hits   = frame_cache.hits;
+    *misses = frame_cache.misses;
+}
@@ -75,6 +75,16 @@
 //
 uint8_t send1905RawPacket(char *interface_name, uint16_t mid, uint8_t *dst_mac_address, struct CMDU *cmdu);
 
+// Same as "send1905RawPacket()", but sending the same 'cmdu' on all the
+// 'interfaces_nr' interfaces contained in 'interfaces_names'.
+//
+// The CMDU is forged only once and all resulting frames (all fragments, on
+// all interfaces) are handed to the platform in a single batch.
+//
+// Return '0' if there was a problem, '1' otherwise.
+//
+uint8_t send1905RawPacketOnInterfaces(char **interfaces_names, uint8_t interfaces_nr, uint16_t mid, uint8_t *dst_mac_address, struct CMDU *cmdu);
+
 // This function sends a "1905 ALME reply" (the one represented by the provided
 // 'out' pointer, which must point to a "struct *ALME" structure).
 //
@@ -572,4 +582,66 @@ uint8_t send1905MetricsResponseALME(uint8_t alme_client_id, uint8_t *mac_address
 //
 uint8_t send1905CustomCommandResponseALME(uint8_t alme_client_id, uint8_t command);
 
+
+////////////////////////////////////////////////////////////////////////////////
+// Local device information
+////////////////////////////////////////////////////////////////////////////////
+
+// The database entry of the local node is only refreshed when someone is going
+// to look at it (see "_updateLocalDeviceData()"), and then only the parts of it
+// that might have changed since the last refresh are regenerated.
+//
+// These are the parts the local device information is split into:
+//
+#define LOCAL_DEVICE_DATA_INTERFACES  (1<<0)  // Device information, bridging
+                                              // capabilities, power off
+                                              // interfaces, generic phy and IPs
+#define LOCAL_DEVICE_DATA_NEIGHBORS   (1<<1)  // 1905, non-1905 and L2 neighbors
+#define LOCAL_DEVICE_DATA_METRICS     (1<<2)  // Link metrics
+#define LOCAL_DEVICE_DATA_IDENTITY    (1<<3)  // Supported services, profile,
+                                              // identification and control URL
+#define LOCAL_DEVICE_DATA_ALL         (0x0F)
+
+// Some of this information comes from the platform, which does not notify
+// every change (ex: a new IP address or a new entry in the bridge forwarding
+// tables). That's why, no matter what, everything is regenerated when more
+// than LOCAL_DEVICE_DATA_MAX_AGE_MS milliseconds have elapsed since the last
+// full refresh.
+//
+#ifndef LOCAL_DEVICE_DATA_MAX_AGE_MS
+#  define LOCAL_DEVICE_DATA_MAX_AGE_MS  (60000)
+#endif
+
+// Flag the provided 'parts' (an OR'ed combination of "LOCAL_DEVICE_DATA_*"
+// values) of the local device information as stale, so that they are
+// regenerated the next time it is refreshed.
+//
+// It also discards the cached frames (see below) built from any of them.
+//
+// Call this function every time an event that might change them takes place
+// (ex: an interface changes its state or a neighbor appears/disappears)
+//
+void markLocalDeviceDataDirty(uint32_t parts);
+
+// "Topology discovery" and "topology response" messages are forged once per
+// interface and then re-sent (with a new 'mid') from a cache until the local
+// information they contain is flagged as stale:
+//
+//   - "Topology discovery" messages only contain the AL MAC address and the
+//     interface MAC address. They are kept until the interfaces change.
+//
+//   - "Topology response" messages are kept until the interfaces, neighbors or
+//     identity change or, at most, for FRAME_CACHE_MAX_AGE_MS milliseconds
+//     (some of their contents, such as the non-1905 neighbors, come from
+//     platform information whose changes are not notified).
+//
+#ifndef FRAME_CACHE_MAX_AGE_MS
+#  define FRAME_CACHE_MAX_AGE_MS  (10000)
+#endif
+
+// Fill 'hits' and 'misses' with the number of times (since start up) a cached
+// frame could and could not be used
+//
+void getFrameCacheStats(uint32_t *hits, uint32_t *misses);
+
 #endif
@@ -0,0 +1,323 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+#include "platform.h"
+#include "utils.h"
+
+#include "al_timers.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Private functions and data
+////////////////////////////////////////////////////////////////////////////////
+
+#define ROOT_BITS   (8)                 // Level 0: one slot per tick
+#define LEVEL_BITS  (6)                 // Levels 1, 2 and 3
+#define ROOT_SIZE   (1 << ROOT_BITS)
+#define LEVEL_SIZE  (1 << LEVEL_BITS)
+#define ROOT_MASK   (ROOT_SIZE  - 1)
+#define LEVEL_MASK  (LEVEL_SIZE - 1)
+
+#define MAX_TICKS   ((1 << (ROOT_BITS + 3*LEVEL_BITS)) - 1)
+
+// Slot of level 'n' (1, 2 or 3) that contains tick 't'
+//
+#define LEVEL_INDEX(t, n)  (((t) >> (ROOT_BITS + ((n)-1)*LEVEL_BITS)) & LEVEL_MASK)
+
+static struct
+{
+    uint8_t                  started;
+    uint32_t                 last_ms;   // Last timestamp seen
+    uint64_t                 elapsed_ms;// Since tick "0". Never wraps, unlike
+                                        // the 32 bits platform timestamps
+    uint32_t                 current;   // Next tick to process
+    uint32_t                 count;     // Armed timers
+
+    struct timerWheelTimer  *root[ROOT_SIZE];
+    struct timerWheelTimer  *levels[3][LEVEL_SIZE];
+
+} wheel;
+
+static void _start(void)
+{
+    if (0 == wheel.started)
+    {
+        wheel.last_ms    = PLATFORM_GET_TIMESTAMP();
+        wheel.elapsed_ms = 0;
+        wheel.current    = 0;
+        wheel.started    = 1;
+    }
+}
+
+// Update 'wheel.elapsed_ms' with the new timestamp 'now_ms'.
+//
+// Only the (unsigned) difference with the previous timestamp is used, so the
+// 32 bits platform timestamp wrapping around (every ~49.7 days) goes
+// unnoticed. A timestamp older than the previous one (ex: taken by the caller
+// before a timer was armed) does not move time backwards.
+//
+static void _sync(uint32_t now_ms)
+{
+    uint32_t delta;
+
+    delta = now_ms - wheel.last_ms;
+    if ((int32_t)delta < 0)
+    {
+        return;
+    }
+
+    wheel.last_ms     = now_ms;
+    wheel.elapsed_ms += delta;
+}
+
+static void _link(struct timerWheelTimer **head, struct timerWheelTimer *timer)
+{
+    timer->next  = *head;
+    timer->pprev = head;
+
+    if (NULL != timer->next)
+    {
+        timer->next->pprev = &timer->next;
+    }
+    *head = timer;
+}
+
+static void _unlink(struct timerWheelTimer *timer)
+{
+    *timer->pprev = timer->next;
+
+    if (NULL != timer->next)
+    {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->next  = NULL;
+    timer->pprev = NULL;
+}
+
+// Insert 'timer' (whose 'expires' field has already been set) in the slot it
+// belongs to, given how far in the future it expires
+//
+static void _insert(struct timerWheelTimer *timer)
+{
+    uint32_t delta;
+
+    delta = timer->expires - wheel.current;
+
+    if ((int32_t)delta < 0)
+    {
+        // Already expired. Process it on the next tick.
+        //
+        timer->expires = wheel.current;
+        _link(&wheel.root[wheel.current & ROOT_MASK], timer);
+    }
+    else if (delta < ROOT_SIZE)
+    {
+        _link(&wheel.root[timer->expires & ROOT_MASK], timer);
+    }
+    else if (delta < (1 << (ROOT_BITS + LEVEL_BITS)))
+    {
+        _link(&wheel.levels[0][LEVEL_INDEX(timer->expires, 1)], timer);
+    }
+    else if (delta < (1 << (ROOT_BITS + 2*LEVEL_BITS)))
+    {
+        _link(&wheel.levels[1][LEVEL_INDEX(timer->expires, 2)], timer);
+    }
+    else
+    {
+        if (delta > MAX_TICKS)
+        {
+            timer->expires = wheel.current + MAX_TICKS;
+        }
+        _link(&wheel.levels[2][LEVEL_INDEX(timer->expires, 3)], timer);
+    }
+}
+
+// Move all timers from slot 'index' of level 'n' to lower levels. Returns
+// 'index' (so that the caller knows whether this level has wrapped around too)
+//
+static uint32_t _cascade(uint8_t n, uint32_t index)
+{
+    struct timerWheelTimer *list;
+
+    list = wheel.levels[n-1][index];
+    wheel.levels[n-1][index] = NULL;
+
+    while (NULL != list)
+    {
+        struct timerWheelTimer *timer;
+
+        timer = list;
+        list  = list->next;
+
+        timer->next  = NULL;
+        timer->pprev = NULL;
+        _insert(timer);
+    }
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions (exported only to files in this same folder)
+////////////////////////////////////////////////////////////////////////////////
+
+void timerWheelSetup(struct timerWheelTimer *timer, timerWheelCallback callback, void *data)
+{
+    timer->next     = NULL;
+    timer->pprev    = NULL;
+    timer->expires  = 0;
+    timer->period   = 0;
+    timer->callback = callback;
+    timer->data     = data;
+}
+
+void timerWheelArm(struct timerWheelTimer *timer, uint32_t timeout_ms, uint32_t period_ms)
+{
+    _start();
+
+    if (NULL != timer->pprev)
+    {
+        _unlink(timer);
+        wheel.count--;
+    }
+
+    _sync(PLATFORM_GET_TIMESTAMP());
+
+    // Tick 't' is processed once 't * TIMER_WHEEL_TICK_MS' milliseconds have
+    // elapsed. Round the absolute expiration time up (and not just the
+    // timeout), so that the timer never fires before 'timeout_ms'.
+    //
+    timer->expires = (uint32_t)((wheel.elapsed_ms + timeout_ms + TIMER_WHEEL_TICK_MS - 1) / TIMER_WHEEL_TICK_MS);
+    timer->period  = (period_ms + TIMER_WHEEL_TICK_MS - 1) / TIMER_WHEEL_TICK_MS;
+
+    if (0 != period_ms && 0 == timer->period)
+    {
+        timer->period = 1;
+    }
+
+    _insert(timer);
+    wheel.count++;
+}
+
+void timerWheelCancel(struct timerWheelTimer *timer)
+{
+    if (NULL != timer->pprev)
+    {
+        _unlink(timer);
+        wheel.count--;
+    }
+}
+
+uint8_t timerWheelIsArmed(const struct timerWheelTimer *timer)
+{
+    return NULL != timer->pprev ? 1 : 0;
+}
+
+void timerWheelAdvance(uint32_t now_ms)
+{
+    uint32_t target;
+
+    _start();
+    _sync(now_ms);
+
+    target = (uint32_t)(wheel.elapsed_ms / TIMER_WHEEL_TICK_MS);
+
+    while ((int32_t)(target - wheel.current) >= 0)
+    {
+        struct timerWheelTimer *pending;
+        uint32_t                index;
+
+        // Each time a level wraps around, bring down the timers from the next
+        // slot of the level above
+        //
+        index = wheel.current & ROOT_MASK;
+        if (0 == index                                              &&
+            0 == _cascade(1, LEVEL_INDEX(wheel.current, 1))         &&
+            0 == _cascade(2, LEVEL_INDEX(wheel.current, 2)))
+        {
+            _cascade(3, LEVEL_INDEX(wheel.current, 3));
+        }
+
+        // Detach the list of timers expiring on this tick, so that callbacks
+        // arming new timers do not interfere with it (they can still cancel
+        // timers from it)
+        //
+        pending = wheel.root[index];
+        wheel.root[index] = NULL;
+        if (NULL != pending)
+        {
+            pending->pprev = &pending;
+        }
+
+        wheel.current++;
+
+        while (NULL != pending)
+        {
+            struct timerWheelTimer *timer;
+
+            timer = pending;
+            _unlink(timer);
+            wheel.count--;
+
+            if (0 != timer->period)
+            {
+                timer->expires += timer->period;
+                _insert(timer);
+                wheel.count++;
+            }
+
+            timer->callback(timer, timer->data);
+        }
+    }
+}
+
+uint32_t timerWheelCount(void)
+{
+    return wheel.count;
+}
@@ -0,0 +1,137 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+#ifndef _AL_TIMERS_H_
+#define _AL_TIMERS_H_
+
+#include "platform.h"
+
+// Timers for the AL main thread.
+//
+// Instead of asking the platform for a new timer each time something needs a
+// timeout, the AL receives one single periodic platform timer event every
+// TIMER_WHEEL_TICK_MS milliseconds and calls "timerWheelAdvance()", which runs
+// the callbacks of all the timers that expired since the previous call.
+//
+// Timers are kept in a hierarchical timing wheel (the same structure the Linux
+// kernel uses for its timers): the first level has one slot per tick for the
+// next 256 ticks, and each one of the following levels covers 64 times more
+// time with the same granularity as a whole slot of the previous one. When a
+// level wraps around, the timers in the next slot of the level above are moved
+// ("cascaded") to their final slot in the level below.
+//
+// This way arming and cancelling a timer is O(1) no matter how many timers
+// there are, and each tick only touches the timers that expire on it.
+//
+// Timeouts have a granularity of one tick and are limited to (2^26 - 1) ticks.
+// Longer timeouts are silently clamped. A timer never fires before its timeout
+// has elapsed, but it may fire up to one tick (plus the platform timer event
+// latency) later.
+//
+// The wheel keeps its own 64 bits count of elapsed milliseconds, so the 32 bits
+// platform timestamps wrapping around (every ~49.7 days) is harmless.
+//
+// Timers are not thread safe: they must only be used from the AL main thread.
+//
+#ifndef TIMER_WHEEL_TICK_MS
+#  define TIMER_WHEEL_TICK_MS  (100)
+#endif
+
+struct timerWheelTimer;
+
+// Function called when a timer expires. It can freely arm or cancel any timer
+// (including 'timer' itself).
+//
+typedef void (*timerWheelCallback)(struct timerWheelTimer *timer, void *data);
+
+// The memory for each timer is provided by its user (typically embedded in a
+// bigger structure), and must remain valid while the timer is armed.
+// Fields are private: use the functions below.
+//
+struct timerWheelTimer
+{
+    struct timerWheelTimer   *next;
+    struct timerWheelTimer  **pprev;     // NULL when the timer is not armed
+
+    uint32_t                  expires;   // Absolute tick
+    uint32_t                  period;    // Ticks. "0" for one-shot timers
+
+    timerWheelCallback        callback;
+    void                     *data;
+};
+
+// Prepare a new (not armed) timer. Must be called once before any other
+// function.
+//
+void timerWheelSetup(struct timerWheelTimer *timer, timerWheelCallback callback, void *data);
+
+// Arm (or re-arm, if it was already armed) 'timer' so that it expires after
+// 'timeout_ms' milliseconds. If 'period_ms' is not "0", the timer is then
+// automatically re-armed every 'period_ms' milliseconds until it is cancelled.
+//
+void timerWheelArm(struct timerWheelTimer *timer, uint32_t timeout_ms, uint32_t period_ms);
+
+// Disarm 'timer' (nothing happens if it was not armed)
+//
+void timerWheelCancel(struct timerWheelTimer *timer);
+
+// Return "1" if 'timer' is armed, "0" otherwise
+//
+uint8_t timerWheelIsArmed(const struct timerWheelTimer *timer);
+
+// Run the callbacks of all the timers that have expired at time 'now_ms' (as
+// returned by "PLATFORM_GET_TIMESTAMP()").
+//
+void timerWheelAdvance(uint32_t now_ms);
+
+// Return the number of timers currently armed
+//
+uint32_t timerWheelCount(void);
+
+#endif
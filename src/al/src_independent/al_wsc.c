@@ -55,6 +55,7 @@
 
 #include "platform_crypto.h"
 #include "platform_interfaces.h"
+#include "platform_os.h"
 
 #include <string.h> // memcmp(), memcpy(), ...
 
@@ -219,6 +220,22 @@ uint8_t         *last_m1      = NULL;
 uint16_t         last_m1_size = 0;
 struct wscKey *last_key     = NULL;
 
+// Run 'work(data)' on a background thread and then 'done(data)' on the AL main
+// thread (once the corresponding "PLATFORM_QUEUE_EVENT_WORK_DONE" message is
+// read from queue 'queue_id').
+// If the platform cannot do that, both are run right now, one after the other.
+//
+static void _runInBackground(uint8_t queue_id, void (*work)(void *data), void (*done)(void *data), void *data)
+{
+    if (0 == PLATFORM_RUN_IN_BACKGROUND(queue_id, work, done, data))
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("Could not use a background thread. Running WSC work in the foreground\n");
+
+        work(data);
+        done(data);
+    }
+}
+
 // This is the key derivation function used in the WPS standard to obtain a
 // final hash that is later used for encryption.
 //
@@ -607,10 +624,27 @@ uint8_t  wscBuildM1(char *interface_name, uint8_t **m1, uint16_t *m1_size, void
     return 1;
 }
 
-uint8_t  wscProcessM2(void *key, uint8_t *m1, uint16_t m1_size, uint8_t *m2, uint16_t m2_size)
+// Settings extracted from an "M2" message
+//
+struct _apSettings
+{
+    uint8_t  ssid[64];
+    uint8_t  bssid[6];
+    uint16_t auth_type;
+    uint16_t encryption_type;
+    uint8_t  network_key[64];
+};
+
+// Authenticate and decrypt 'm2' (which was received as a response to 'm1',
+// built together with 'k') and fill 'settings' with its contents.
+//
+// This is where all the expensive cryptographic operations take place. It does
+// not use the data model nor any global variable, thus it can be run from a
+// background thread.
+//
+static uint8_t _processM2(struct wscKey *k, uint8_t *m1, uint16_t m1_size, uint8_t *m2, uint16_t m2_size, struct _apSettings *settings)
 {
     uint8_t         *p;
-    struct wscKey *k;
 
     // "Useful data" we want to extract from M2
     //
@@ -650,19 +684,6 @@ uint8_t  wscProcessM2(void *key, uint8_t *m1, uint16_t m1_size, uint8_t *m2, uin
     uint16_t  m1_privkey_len;
     uint8_t  *m1_mac;
 
-    if (NULL == m1)
-    {
-        // Use the last M1 built message
-
-        m1              = last_m1;
-        m1_size         = last_m1_size;
-        k               = last_key;
-    }
-    else
-    {
-        k = (struct wscKey *)key;
-    }
-
     m1_privkey      = k->key;
     m1_privkey_len  = k->key_len;
     m1_mac          = k->mac;
@@ -994,14 +1015,168 @@ uint8_t  wscProcessM2(void *key, uint8_t *m1, uint16_t m1_size, uint8_t *m2, uin
         }
     }
 
-    // Apply the security settings so that this AP clones the registrar
-    // configuration
-    //
-    PLATFORM_CONFIGURE_80211_AP(DMmacToInterfaceName(m1_mac), ssid, bssid, auth_type, encryption_type, network_key);
+    memcpy(settings->ssid,        ssid,        sizeof(settings->ssid));
+    memcpy(settings->bssid,       bssid,       sizeof(settings->bssid));
+    memcpy(settings->network_key, network_key, sizeof(settings->network_key));
+    settings->auth_type       = auth_type;
+    settings->encryption_type = encryption_type;
+
+    return 1;
+}
+
+// Apply the security settings so that this AP clones the registrar
+// configuration, and then free the 'm1' and 'k' buffers (which were built
+// together by "wscBuildM1()")
+//
+static void _applyM2(struct wscKey *k, uint8_t *m1, struct _apSettings *settings)
+{
+    PLATFORM_CONFIGURE_80211_AP(DMmacToInterfaceName(k->mac), settings->ssid, settings->bssid, settings->auth_type, settings->encryption_type, settings->network_key);
+
+    free(m1);
+    free(k->key);
+    free(k);
+}
+
+// Return in 'm1', 'm1_size' and 'k' the "M1" message and key to use when
+// processing an "M2" message (see "wscProcessM2()" for the meaning of the
+// 'key' and 'm1' arguments), and give up their ownership (ie. the "last M1"
+// is forgotten).
+//
+// Returns "0" if there is no such "M1"
+//
+static uint8_t _takeM1(void *key, uint8_t **m1, uint16_t *m1_size, struct wscKey **k)
+{
+    if (NULL == *m1)
+    {
+        // Use the last M1 built message
+        //
+        *m1      = last_m1;
+        *m1_size = last_m1_size;
+        *k       = last_key;
+    }
+    else
+    {
+        *k = (struct wscKey *)key;
+    }
+
+    if (NULL == *m1 || NULL == *k)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("No M1 message was previously built. Ignoring M2 message.\n");
+        return 0;
+    }
+
+    if (*m1 == last_m1)
+    {
+        last_m1  = NULL;
+        last_key = NULL;
+    }
+
+    return 1;
+}
+
+// Undo "_takeM1()" (used when the "M2" message could not be processed, so that
+// a future "M2" can still be processed with this same "M1")
+//
+static void _giveBackM1(struct wscKey *k, uint8_t *m1, uint16_t m1_size)
+{
+    if (NULL == last_m1)
+    {
+        last_m1      = m1;
+        last_m1_size = m1_size;
+        last_key     = k;
+    }
+    else
+    {
+        // A new "M1" has been built in the meantime. This one is useless now.
+        //
+        free(m1);
+        free(k->key);
+        free(k);
+    }
+}
+
+uint8_t  wscProcessM2(void *key, uint8_t *m1, uint16_t m1_size, uint8_t *m2, uint16_t m2_size)
+{
+    struct wscKey      *k;
+    struct _apSettings  settings;
+
+    if (0 == _takeM1(key, &m1, &m1_size, &k))
+    {
+        return 0;
+    }
+
+    if (0 == _processM2(k, m1, m1_size, m2, m2_size, &settings))
+    {
+        _giveBackM1(k, m1, m1_size);
+        return 0;
+    }
+
+    _applyM2(k, m1, &settings);
+
+    return 1;
+}
+
+// State of an "M2" message being processed in the background
+//
+struct _processM2Work
+{
+    struct wscKey       *k;
+    uint8_t             *m1;
+    uint16_t             m1_size;
+
+    uint8_t             *m2;          // Private copy
+    uint16_t             m2_size;
+
+    struct _apSettings   settings;
+    uint8_t              result;      // Value returned by "_processM2()"
+};
+
+static void _processM2InBackground(void *data)
+{
+    struct _processM2Work *w = (struct _processM2Work *)data;
+
+    w->result = _processM2(w->k, w->m1, w->m1_size, w->m2, w->m2_size, &w->settings);
+}
+
+static void _processM2Done(void *data)
+{
+    struct _processM2Work *w = (struct _processM2Work *)data;
+
+    if (1 == w->result)
+    {
+        _applyM2(w->k, w->m1, &w->settings);
+    }
+    else
+    {
+        _giveBackM1(w->k, w->m1, w->m1_size);
+    }
+
+    free(w->m2);
+    free(w);
+}
+
+uint8_t wscProcessM2Async(uint8_t queue_id, void *key, uint8_t *m1, uint16_t m1_size, uint8_t *m2, uint16_t m2_size)
+{
+    struct _processM2Work *w;
+    struct wscKey         *k;
 
-    free(m1);      last_m1 = NULL;
-    free(k->key);  k->key  = NULL;  last_key->key = NULL;
-    free(k);       k       = NULL;  last_key      = NULL;
+    if (NULL == m2 || 0 == m2_size || 0 == _takeM1(key, &m1, &m1_size, &k))
+    {
+        return 0;
+    }
+
+    w = (struct _processM2Work *)memalloc(sizeof(struct _processM2Work));
+
+    w->k       = k;
+    w->m1      = m1;
+    w->m1_size = m1_size;
+    w->m2      = (uint8_t *)memalloc(m2_size);
+    w->m2_size = m2_size;
+    w->result  = 0;
+
+    memcpy(w->m2, m2, m2_size);
+
+    _runInBackground(queue_id, _processM2InBackground, _processM2Done, w);
 
     return 1;
 }
@@ -1009,12 +1184,17 @@ uint8_t  wscProcessM2(void *key, uint8_t *m1, uint16_t m1_size, uint8_t *m2, uin
 //
 //////////////////////////////////////// Registrar functions ///////////////////
 //
-uint8_t wscBuildM2(uint8_t *m1, uint16_t m1_size, uint8_t **m2, uint16_t *m2_size)
+// Build the "M2" response to 'm1' using the configuration of registrar
+// interface 'x'.
+//
+// This is where all the expensive cryptographic operations take place. It does
+// not use the data model nor any global variable, thus it can be run from a
+// background thread.
+//
+static uint8_t _buildM2(struct interfaceInfo *x, uint8_t *m1, uint16_t m1_size, uint8_t **m2, uint16_t *m2_size)
 {
     uint8_t  *buffer;
 
-    struct interfaceInfo  *x;
-
     uint8_t *p;
 
     uint8_t  aux8;
@@ -1035,20 +1215,9 @@ uint8_t wscBuildM2(uint8_t *m1, uint16_t m1_size, uint8_t **m2, uint16_t *m2_siz
 
     uint8_t  registrar_nonce[16];
 
-    char  *registrar_interface_name;
-
     uint16_t encryption_types;
     uint16_t auth_types;
 
-    // If this node is processing an M1 message, it must mean one of our
-    // interfaces is the network registrar.
-    //
-    if (NULL == (registrar_interface_name = DMmacToInterfaceName(DMregistrarMacGet())))
-    {
-        PLATFORM_PRINTF_DEBUG_WARNING("None of this nodes' interfaces matches the registrar MAC address. Ignoring M1 message.\n");
-        return 0;
-    }
-
     // We first need to extract the following parameters contained in "M1":
     //
     //   - Mac address
@@ -1116,12 +1285,6 @@ uint8_t wscBuildM2(uint8_t *m1, uint16_t m1_size, uint8_t **m2, uint16_t *m2_siz
 
     // Now we can build "M2"
     //
-    if (NULL == (x = PLATFORM_GET_1905_INTERFACE_INFO(registrar_interface_name)))
-    {
-        PLATFORM_PRINTF_DEBUG_WARNING("Could not retrieve info of interface %s\n", registrar_interface_name );
-        return 0;
-    }
-
     buffer = (uint8_t *)memalloc(sizeof(uint8_t)*1000);
     p      = buffer;
 
@@ -1581,14 +1744,131 @@ uint8_t wscBuildM2(uint8_t *m1, uint16_t m1_size, uint8_t **m2, uint16_t *m2_siz
                                                                           _InB( hash,          &p,  8);
     }
 
-    free_1905_INTERFACE_INFO(x);
-
     *m2      = buffer;
     *m2_size = p-buffer;
 
     return 1;
 }
 
+// Return the information of the local registrar interface, or NULL if none of
+// the local interfaces is the registrar.
+// The returned structure must be freed with "free_1905_INTERFACE_INFO()"
+//
+static struct interfaceInfo *_registrarInterfaceInfo(void)
+{
+    struct interfaceInfo *x;
+    char                 *registrar_interface_name;
+
+    // If this node is processing an M1 message, it must mean one of our
+    // interfaces is the network registrar.
+    //
+    if (NULL == (registrar_interface_name = DMmacToInterfaceName(DMregistrarMacGet())))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("None of this nodes' interfaces matches the registrar MAC address. Ignoring M1 message.\n");
+        return NULL;
+    }
+
+    if (NULL == (x = PLATFORM_GET_1905_INTERFACE_INFO(registrar_interface_name)))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Could not retrieve info of interface %s\n", registrar_interface_name );
+        return NULL;
+    }
+
+    return x;
+}
+
+uint8_t wscBuildM2(uint8_t *m1, uint16_t m1_size, uint8_t **m2, uint16_t *m2_size)
+{
+    struct interfaceInfo *x;
+    uint8_t               ret;
+
+    if (NULL == (x = _registrarInterfaceInfo()))
+    {
+        return 0;
+    }
+
+    ret = _buildM2(x, m1, m1_size, m2, m2_size);
+
+    free_1905_INTERFACE_INFO(x);
+
+    return ret;
+}
+
+// State of an "M2" message being built in the background
+//
+struct _buildM2Work
+{
+    struct interfaceInfo  *x;
+
+    uint8_t               *m1;        // Private copy
+    uint16_t               m1_size;
+
+    uint8_t               *m2;
+    uint16_t               m2_size;
+    uint8_t                result;    // Value returned by "_buildM2()"
+
+    void                 (*done)(uint8_t *m2, uint16_t m2_size, void *context);
+    void                  *context;
+};
+
+static void _buildM2InBackground(void *data)
+{
+    struct _buildM2Work *w = (struct _buildM2Work *)data;
+
+    w->result = _buildM2(w->x, w->m1, w->m1_size, &w->m2, &w->m2_size);
+}
+
+static void _buildM2Done(void *data)
+{
+    struct _buildM2Work *w = (struct _buildM2Work *)data;
+
+    if (1 == w->result)
+    {
+        w->done(w->m2, w->m2_size, w->context);
+    }
+    else
+    {
+        w->done(NULL, 0, w->context);
+    }
+
+    free_1905_INTERFACE_INFO(w->x);
+    free(w->m1);
+    free(w);
+}
+
+uint8_t wscBuildM2Async(uint8_t queue_id, uint8_t *m1, uint16_t m1_size, void (*done)(uint8_t *m2, uint16_t m2_size, void *context), void *context)
+{
+    struct _buildM2Work  *w;
+    struct interfaceInfo *x;
+
+    if (NULL == m1 || 0 == m1_size || NULL == done)
+    {
+        return 0;
+    }
+
+    if (NULL == (x = _registrarInterfaceInfo()))
+    {
+        return 0;
+    }
+
+    w = (struct _buildM2Work *)memalloc(sizeof(struct _buildM2Work));
+
+    w->x        = x;
+    w->m1       = (uint8_t *)memalloc(m1_size);
+    w->m1_size  = m1_size;
+    w->m2       = NULL;
+    w->m2_size  = 0;
+    w->result   = 0;
+    w->done     = done;
+    w->context  = context;
+
+    memcpy(w->m1, m1, m1_size);
+
+    _runInBackground(queue_id, _buildM2InBackground, _buildM2Done, w);
+
+    return 1;
+}
+
 uint8_t wscFreeM2(uint8_t *m, uint16_t m_size)
 {
     if (0 == m_size || NULL == m)
@@ -142,6 +142,33 @@ uint8_t  wscProcessM2(void *key, uint8_t *m1, uint16_t m1_size, uint8_t *m2, uin
 uint8_t wscBuildM2(uint8_t *m1, uint16_t m1_size, uint8_t **m2, uint16_t *m2_size);
 uint8_t wscFreeM2(uint8_t *m, uint16_t m_size);
 
+// The Diffie-Hellman key agreement and key derivation needed to build or
+// process an "M2" message take a long time (specially on small CPUs). While a
+// registrar answers a burst of "M1" messages (ex: after a power cut) nothing
+// else would be processed.
+//
+// That's why, instead of "wscBuildM2()" and "wscProcessM2()", the AL main
+// thread uses the following versions, which do the expensive part on a
+// background thread (see "PLATFORM_RUN_IN_BACKGROUND()") and return right
+// away:
+//
+//   - "wscProcessM2Async()" takes the same arguments as "wscProcessM2()" plus
+//     the id of the AL queue, where the "PLATFORM_QUEUE_EVENT_WORK_DONE"
+//     message will be received once the work has finished. The interface is
+//     configured when that message is processed.
+//
+//   - "wscBuildM2Async()" takes the "M1" message and the AL queue id, and then,
+//     when the "PLATFORM_QUEUE_EVENT_WORK_DONE" message is processed, calls
+//     'done' with the resulting "M2" message (which must then be freed with
+//     "wscFreeM2()") and the provided 'context'. If "M2" could not be built,
+//     'done' is called with 'm2' set to NULL.
+//
+// Both functions make a private copy of the 'm1'/'m2' input buffers, thus they
+// can be freed as soon as the function returns.
+//
+uint8_t wscProcessM2Async(uint8_t queue_id, void *key, uint8_t *m1, uint16_t m1_size, uint8_t *m2, uint16_t m2_size);
+uint8_t wscBuildM2Async(uint8_t queue_id, uint8_t *m1, uint16_t m1_size, void (*done)(uint8_t *m2, uint16_t m2_size, void *context), void *context);
+
 
 #define WSC_TYPE_M1      (0x00)
 #define WSC_TYPE_M2      (0x01)
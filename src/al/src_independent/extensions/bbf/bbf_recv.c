@@ -49,7 +49,7 @@
 
 #include "al_datamodel.h"
 #include "al_recv.h"
-#include "al_extension.h" // VendorSpecificTLVDuplicate
+#include "al_extension.h" // vendorSpecificTLVEmbedExtension
 #include "1905_tlvs.h"
 #include "bbf_tlvs.h"
 #include "bbf_send.h"     // CBKUpdateBBFExtendedInfo
@@ -63,26 +63,18 @@ extern uint8_t   bbf_query; // from bbf_send.c
 // CMDU extension callbacks
 ////////////////////////////////////////////////////////////////////////////////
 
-uint8_t CBKprocess1905BBFExtensions(struct CMDU *memory_structure)
+uint8_t CBKprocess1905BBFExtensions(struct CMDU_view *view)
 {
-    uint8_t     *p;
-    uint8_t      i;
+    struct TLV_view *t;
+    uint16_t         i;
 
-    struct vendorSpecificTLV   *vs_tlv;
-
-    if (NULL == memory_structure)
+    if (NULL == view)
     {
         // Invalid param
         //
         return 0;
     }
 
-    if (NULL == memory_structure->list_of_TLVs)
-    {
-        PLATFORM_PRINTF_DEBUG_ERROR("Malformed structure.");
-        return 0;
-    }
-
     // BBF protocol extension: Metrics of non-1905 links. Interested only on:
     //
     // CMDU_TYPE_LINK_METRIC_QUERY
@@ -98,27 +90,30 @@ uint8_t CBKprocess1905BBFExtensions(struct CMDU *memory_structure)
     // Future expectations: non-1905 link metrics should be included in the
     // IEEE1905 standard. Meanwhile, a BBF protocol extension can be used.
     //
-    switch (memory_structure->message_type)
+    // Only the embedded BBF TLVs are parsed. The (outer) Vendor Specific TLV
+    // is read straight from the packet: its value is the 3 bytes OUI followed
+    // by the embedded TLV.
+    //
+    switch (view->message_type)
     {
         case CMDU_TYPE_LINK_METRIC_QUERY:
         {
             uint8_t                      *tlv;
 
-            i = 0;
-            while (NULL != (p = memory_structure->list_of_TLVs[i]))
+            for (i=0; i<view->tlvs_nr; i++)
             {
+                t = &view->tlvs[i];
+
                 // Protocol extensions are always embedded inside a Vendor
                 // Specific TLV. Ignore other TLVs
                 //
-                if (*p == TLV_TYPE_VENDOR_SPECIFIC)
+                if (t->type == TLV_TYPE_VENDOR_SPECIFIC && t->length > 3)
                 {
-                    vs_tlv = (struct vendorSpecificTLV *)p;
-
                     // Process only embedded BBF TLVs
                     //
-                    if (0 == memcmp(vs_tlv->vendorOUI, BBF_OUI, 3))
+                    if (0 == memcmp(t->stream + 3, BBF_OUI, 3))
                     {
-                        tlv = parse_bbf_TLV_from_packet(vs_tlv->m);
+                        tlv = parse_bbf_TLV_from_packet(t->stream + 6);
 
                         if (NULL == tlv)
                         {
@@ -147,7 +142,6 @@ uint8_t CBKprocess1905BBFExtensions(struct CMDU *memory_structure)
                         break;
                     }
                 }
-                i++;
             }
 
             break;
@@ -158,28 +152,28 @@ uint8_t CBKprocess1905BBFExtensions(struct CMDU *memory_structure)
           struct transmitterLinkMetricTLV *transmitter_tlv = NULL;
           struct receiverLinkMetricTLV    *receiver_tlv = NULL;
           struct vendorSpecificTLV       **extensions;
+          struct vendorSpecificTLV        *vs_tlv;
           uint8_t                            extensions_nr;
           uint8_t                           *bbf_tlv;
           uint8_t                            std_FROM_al_mac_address[6];
           uint8_t                            no_std_FROM_al_mac_address[6];
 
-          i = 0;
           extensions_nr = 0;
           extensions = NULL;
-          while (NULL != (p = memory_structure->list_of_TLVs[i]))
+          for (i=0; i<view->tlvs_nr; i++)
           {
+              t = &view->tlvs[i];
+
               // Protocol extensions are always embedded inside a Vendor
               // Specific TLV. Ignore other TLVs
               //
-              if (*p == TLV_TYPE_VENDOR_SPECIFIC)
+              if (t->type == TLV_TYPE_VENDOR_SPECIFIC)
               {
-                  vs_tlv = (struct vendorSpecificTLV *)p;
-
                   // Process only embedded BBF TLVs
                   //
-                  if (0 == memcmp(vs_tlv->vendorOUI, BBF_OUI, 3))
+                  if (t->length > 3 && 0 == memcmp(t->stream + 3, BBF_OUI, 3))
                   {
-                      bbf_tlv = parse_bbf_TLV_from_packet(vs_tlv->m);
+                      bbf_tlv = parse_bbf_TLV_from_packet(t->stream + 6);
 
                       if (NULL == bbf_tlv)
                       {
@@ -190,36 +184,46 @@ uint8_t CBKprocess1905BBFExtensions(struct CMDU *memory_structure)
                           if ((*bbf_tlv == BBF_TLV_TYPE_NON_1905_TRANSMITTER_LINK_METRIC) ||
                               (*bbf_tlv == BBF_TLV_TYPE_NON_1905_RECEIVER_LINK_METRIC) )
                           {
-                              // Prepare a list of TLV extensions to update the
-                              // datamodel
+                              // The Vendor Specific TLV is going to be stored
+                              // in the datamodel: this is the only case where
+                              // it needs to be parsed into its own structure
                               //
-                              if (NULL == extensions)
-                              {
-                                  extensions = (struct vendorSpecificTLV **)memalloc(sizeof(struct vendorSpecificTLV *));
-                              }
-                              else
-                              {
-                                  extensions = (struct vendorSpecificTLV **)memrealloc(extensions, sizeof(struct vendorSpecificTLV *) * (extensions_nr + 1));
-                              }
-
-                              // Store a clone of the TLV included in the CMDU,
-                              // because the main stack will release it
-                              //
-                              extensions[extensions_nr] = vendorSpecificTLVDuplicate(vs_tlv);
-                              extensions_nr++;
+                              vs_tlv = (struct vendorSpecificTLV *)materialize_1905_TLV_view(t);
 
-                              // Get the AL MAC of the neighbor who provides
-                              // these metrics
-                              //
-                              if (*bbf_tlv == BBF_TLV_TYPE_NON_1905_TRANSMITTER_LINK_METRIC)
+                              if (NULL == vs_tlv)
                               {
-                                  transmitter_tlv = (struct transmitterLinkMetricTLV *)bbf_tlv;
-                                  memcpy(no_std_FROM_al_mac_address, transmitter_tlv->local_al_address, 6);
+                                  PLATFORM_PRINTF_DEBUG_ERROR("Malformed Vendor Specific TLV\n");
                               }
                               else
                               {
-                                  receiver_tlv = (struct receiverLinkMetricTLV *)bbf_tlv;
-                                  memcpy(no_std_FROM_al_mac_address, receiver_tlv->local_al_address, 6);
+                                  // Prepare a list of TLV extensions to update
+                                  // the datamodel
+                                  //
+                                  if (NULL == extensions)
+                                  {
+                                      extensions = (struct vendorSpecificTLV **)memalloc(sizeof(struct vendorSpecificTLV *));
+                                  }
+                                  else
+                                  {
+                                      extensions = (struct vendorSpecificTLV **)memrealloc(extensions, sizeof(struct vendorSpecificTLV *) * (extensions_nr + 1));
+                                  }
+
+                                  extensions[extensions_nr] = vs_tlv;
+                                  extensions_nr++;
+
+                                  // Get the AL MAC of the neighbor who
+                                  // provides these metrics
+                                  //
+                                  if (*bbf_tlv == BBF_TLV_TYPE_NON_1905_TRANSMITTER_LINK_METRIC)
+                                  {
+                                      transmitter_tlv = (struct transmitterLinkMetricTLV *)bbf_tlv;
+                                      memcpy(no_std_FROM_al_mac_address, transmitter_tlv->local_al_address, 6);
+                                  }
+                                  else
+                                  {
+                                      receiver_tlv = (struct receiverLinkMetricTLV *)bbf_tlv;
+                                      memcpy(no_std_FROM_al_mac_address, receiver_tlv->local_al_address, 6);
+                                  }
                               }
                           }
                           else if (*bbf_tlv == BBF_TLV_TYPE_NON_1905_LINK_METRIC_RESULT_CODE)
@@ -253,26 +257,16 @@ uint8_t CBKprocess1905BBFExtensions(struct CMDU *memory_structure)
               // whom we need to remove the metrics info
               //
               // Little trick: process standard metrics TLVs to get the CMDU's
-              // sender AL MAC.
+              // sender AL MAC (which is the first field of both TLVs, so there
+              // is no need to parse them)
               //
-              else if (*p == TLV_TYPE_TRANSMITTER_LINK_METRIC)
-              {
-                  struct transmitterLinkMetricTLV *metrics;
-
-                  metrics = (struct transmitterLinkMetricTLV *)p;
-
-                  memcpy(std_FROM_al_mac_address, metrics->local_al_address, 6);
-              }
-              else if (*p == TLV_TYPE_RECEIVER_LINK_METRIC)
+              else if (
+                        (t->type == TLV_TYPE_TRANSMITTER_LINK_METRIC || t->type == TLV_TYPE_RECEIVER_LINK_METRIC) &&
+                        t->length >= 6
+                      )
               {
-                  struct receiverLinkMetricTLV *metrics;
-
-                  metrics = (struct receiverLinkMetricTLV *)p;
-
-                  memcpy(std_FROM_al_mac_address, metrics->local_al_address, 6);
+                  memcpy(std_FROM_al_mac_address, t->stream + 3, 6);
               }
-
-              i++;
           }
 
           // Even when there is not any non-1905 metrics TLV, we need to remove
@@ -62,11 +62,12 @@
 // This implementation will only process defined BBF TLVs embedded inside a
 // Vendor Specific TLV whose OUI is the BBF one (0x00256d)
 //
-// 'memory_structure' is the CMDU structure
+// 'view' is the view of the received CMDU (Vendor Specific TLVs are only
+// parsed when they have to be stored in the datamodel)
 //
 // Return '0' if there was a problem, '1' otherwise
 //
-uint8_t CBKprocess1905BBFExtensions(struct CMDU *memory_structure);
+uint8_t CBKprocess1905BBFExtensions(struct CMDU_view *view);
 
 #endif
 
@@ -104,7 +104,7 @@ static void _obtainLocalNon1905NeighborsTLV(struct non1905NeighborDeviceListTLV
     *non_1905_neighbors_nr = 0;
 
     uint8_t (*al_mac_addresses)[6];
-    uint8_t al_mac_addresses_nr;
+    uint16_t al_mac_addresses_nr;
 
     interfaces_names = PLATFORM_GET_LIST_OF_1905_INTERFACES(&interfaces_names_nr);
 
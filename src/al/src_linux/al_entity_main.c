@@ -174,7 +174,7 @@ static void _printUsage(char *program_name)
 {
     printf("AL entity (build %s)\n", _BUILD_NUMBER_);
     printf("\n");
-    printf("Usage: %s -m <al_mac_address> -i <interfaces_list> [-w] [-r <registrar_interface>] [-v] [-p <alme_port_number>]\n", program_name);
+    printf("Usage: %s -m <al_mac_address> -i <interfaces_list> [-w] [-r <registrar_interface>] [-v] [-p <alme_port_number>] [-f <reassembly_limits>]\n", program_name);
     printf("\n");
     printf("  ...where:\n");
     printf("       '<al_mac_address>' is the AL MAC address that this AL entity will receive\n");
@@ -196,6 +196,11 @@ static void _printUsage(char *program_name)
     printf("       '<alme_port_number>', is the port number where a TCP socket will be opened to receive\n");
     printf("       ALME messages. If this argument is not given, a default value of '8888' is used.\n");
     printf("\n");
+    printf("       '<reassembly_limits>' is a comma sepparated list with the maximum number of partial\n");
+    printf("       CMDUs waiting for more fragments, the maximum number of fragments per CMDU and the\n");
+    printf("       milliseconds a partial CMDU waits for its last fragment (ex: '64,16,5000'). A value of\n");
+    printf("       '0' keeps the default value of that limit.\n");
+    printf("\n");
 
     return;
 }
@@ -221,7 +226,7 @@ int main(int argc, char *argv[])
     registerGhnSpiritInterfaceType();
     registerSimulatedInterfaceType();
 
-    while ((c = getopt (argc, argv, "m:i:wr:vh:p:")) != -1)
+    while ((c = getopt (argc, argv, "m:i:wr:vh:p:f:")) != -1)
     {
         switch (c)
         {
@@ -279,6 +284,26 @@ int main(int argc, char *argv[])
                 break;
             }
 
+            case 'f':
+            {
+                // Fragments reassembly limits: 'cmdus,fragments,timeout_ms'
+                //
+                unsigned int max_cmdus_in_flight;
+                unsigned int max_fragments_per_cmdu;
+                unsigned int timeout_ms;
+
+                if (
+                     3 != sscanf(optarg, "%u,%u,%u", &max_cmdus_in_flight, &max_fragments_per_cmdu, &timeout_ms) ||
+                     max_fragments_per_cmdu > 0xff
+                   )
+                {
+                    _printUsage(argv[0]);
+                    exit(1);
+                }
+                set1905ALReassemblyLimits(max_cmdus_in_flight, max_fragments_per_cmdu, timeout_ms);
+                break;
+            }
+
             case 'h':
             {
                 _printUsage(argv[0]);
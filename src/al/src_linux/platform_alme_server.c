@@ -56,7 +56,6 @@
 #include <arpa/inet.h>  // socket(), AF_INET, htons(), ...
 #include <errno.h>      // errno
 #include <pthread.h>    // threads and mutex functions
-#include <mqueue.h>     // mq_*() functions
 #include <string.h>     // strerror()
 #include <stdio.h>      // snprintf(), ...
 #include <stdlib.h>     // free(), malloc(), ...
@@ -54,6 +54,9 @@
 #include "openssl/evp.h"  // SHA digest and AES stuff
 #include "openssl/hmac.h" // HMAC stuff
 
+#include <pthread.h>      // threads and mutex functions
+#include <unistd.h>       // sleep()
+
 #include "platform_crypto.h"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -118,6 +121,175 @@ static int DH_set0_key(DH *dh, BIGNUM *pub_key, BIGNUM *priv_key)
 
 #endif
 
+// The group parameters ("p" and "g") are converted to "BIGNUM" format only
+// once, into this "template" DH object, which is then cloned each time a new
+// DH object is needed.
+//
+static DH             *dh_params      = NULL;
+static pthread_once_t  dh_params_once = PTHREAD_ONCE_INIT;
+
+static void _dhParamsInit(void)
+{
+    DH *dh;
+
+    if (NULL == (dh = DH_new()))
+    {
+        return;
+    }
+
+    // Convert binary to BIGNUM format
+    //
+    if (0 == DH_set0_pqg(dh,
+                         BN_bin2bn(dh1536_p,sizeof(dh1536_p),NULL),
+                         NULL, BN_bin2bn(dh1536_g,sizeof(dh1536_g),NULL)))
+    {
+        DH_free(dh);
+        return;
+    }
+
+    dh_params = dh;
+}
+
+// Return a new DH object with the "1536-bit MODP" group parameters already set
+// (but no keys), or NULL if there was a problem.
+//
+static DH *_dhNew(void)
+{
+    pthread_once(&dh_params_once, _dhParamsInit);
+
+    if (NULL == dh_params)
+    {
+        return NULL;
+    }
+
+    return DHparams_dup(dh_params);
+}
+
+// Generating a DH key pair takes a long time (it is a 1536-bit modular
+// exponentiation), thus a few of them are generated in advance by a low
+// priority background thread, which refills the pool each time one of them is
+// taken by "PLATFORM_GENERATE_DH_KEY_PAIR()".
+//
+// If the pool is empty (ex: when lots of key pairs are needed at the same
+// time) the caller generates its own key pair, just like before.
+//
+// Keys are never reused: each pair is only returned once.
+//
+// The size of the pool can be changed at build time (ex: by adding
+// "-DDH_KEY_PAIR_POOL_SIZE=16" to the compiler flags).
+//
+#ifndef DH_KEY_PAIR_POOL_SIZE
+#  define DH_KEY_PAIR_POOL_SIZE  (4)
+#endif
+
+struct _dhKeyPair
+{
+    uint8_t   *priv;
+    uint16_t   priv_len;
+    uint8_t   *pub;
+    uint16_t   pub_len;
+};
+
+static struct
+{
+    pthread_mutex_t    mutex;
+    pthread_cond_t     cond;      // Signaled each time a pair is taken
+
+    struct _dhKeyPair  pairs[DH_KEY_PAIR_POOL_SIZE];
+    uint8_t            pairs_nr;
+
+    uint32_t           hits;      // Pairs taken from the pool
+    uint32_t           misses;    // Pairs generated on the spot
+
+} dh_pool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER};
+
+static pthread_once_t dh_pool_once = PTHREAD_ONCE_INIT;
+static uint8_t        dh_pool_ok   = 0;  // '1' if the refill thread is running
+
+static uint8_t _dhGenerateKeyPair(struct _dhKeyPair *k)
+{
+    DH *dh;
+    const BIGNUM *priv_key = NULL;
+    const BIGNUM *pub_key = NULL;
+
+    if (NULL == (dh = _dhNew()))
+    {
+        return 0;
+    }
+
+    // Obtain key pair
+    //
+    if (0 == DH_generate_key(dh))
+    {
+        DH_free(dh);
+        return 0;
+    }
+
+    DH_get0_key(dh, &pub_key, &priv_key);
+    k->priv_len = BN_num_bytes(priv_key);
+    k->priv     = (uint8_t *)malloc(k->priv_len);
+    BN_bn2bin(priv_key, k->priv);
+
+    k->pub_len = BN_num_bytes(pub_key);
+    k->pub     = (uint8_t *)malloc(k->pub_len);
+    BN_bn2bin(pub_key, k->pub);
+
+    DH_free(dh);
+      // NOTE: This internally frees "dh->p" and "dh->q", thus no need for us
+      // to do anything else.
+
+    return 1;
+}
+
+static void *_dhPoolThread(void *p)
+{
+    // Lowest priority: this thread must never steal CPU from the rest
+    //
+    if (-1 == nice(19))
+    {
+        // Not a problem
+    }
+
+    while (1)
+    {
+        struct _dhKeyPair k;
+
+        pthread_mutex_lock(&dh_pool.mutex);
+        while (DH_KEY_PAIR_POOL_SIZE == dh_pool.pairs_nr)
+        {
+            pthread_cond_wait(&dh_pool.cond, &dh_pool.mutex);
+        }
+        pthread_mutex_unlock(&dh_pool.mutex);
+
+        if (0 == _dhGenerateKeyPair(&k))
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] Could not generate a DH key pair for the pool\n");
+            sleep(1);
+            continue;
+        }
+
+        pthread_mutex_lock(&dh_pool.mutex);
+        dh_pool.pairs[dh_pool.pairs_nr++] = k;
+        pthread_mutex_unlock(&dh_pool.mutex);
+    }
+
+    return NULL;
+}
+
+static void _dhPoolStart(void)
+{
+    pthread_t thread;
+
+    if (0 != pthread_create(&thread, NULL, _dhPoolThread, NULL))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] Could not create the DH key pairs thread\n");
+        return;
+    }
+    pthread_detach(thread);
+
+    dh_pool_ok = 1;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Platform API: Interface related functions to be used by platform-independent
@@ -152,11 +324,17 @@ uint8_t PLATFORM_GET_RANDOM_BYTES(uint8_t *p, uint16_t len)
     }
 }
 
+uint8_t PLATFORM_PREPARE_DH_KEY_PAIRS(void)
+{
+    pthread_once(&dh_pool_once, _dhPoolStart);
+
+    return dh_pool_ok;
+}
+
 uint8_t PLATFORM_GENERATE_DH_KEY_PAIR(uint8_t **priv, uint16_t *priv_len, uint8_t **pub, uint16_t *pub_len)
 {
-    DH *dh;
-    const BIGNUM *priv_key = NULL;
-    const BIGNUM *pub_key = NULL;
+    struct _dhKeyPair k;
+    uint8_t           from_pool;
 
     if (
          NULL == priv     ||
@@ -168,41 +346,36 @@ uint8_t PLATFORM_GENERATE_DH_KEY_PAIR(uint8_t **priv, uint16_t *priv_len, uint8_
         return 0;
     }
 
-    if (NULL == (dh = DH_new()))
+    PLATFORM_PREPARE_DH_KEY_PAIRS();
+
+    from_pool = 0;
+
+    pthread_mutex_lock(&dh_pool.mutex);
+    if (dh_pool.pairs_nr > 0)
     {
-        return 0;
-    }
+        k         = dh_pool.pairs[--dh_pool.pairs_nr];
+        from_pool = 1;
 
-    // Convert binary to BIGNUM format
-    //
-    if (0 == DH_set0_pqg(dh,
-                         BN_bin2bn(dh1536_p,sizeof(dh1536_p),NULL),
-                         NULL, BN_bin2bn(dh1536_g,sizeof(dh1536_g),NULL)))
+        dh_pool.hits++;
+        pthread_cond_signal(&dh_pool.cond);
+    }
+    else
     {
-        DH_free(dh);
-        return 0;
+        dh_pool.misses++;
     }
+    pthread_mutex_unlock(&dh_pool.mutex);
 
-    // Obtain key pair
-    //
-    if (0 == DH_generate_key(dh))
+    if (0 == from_pool && 0 == _dhGenerateKeyPair(&k))
     {
-        DH_free(dh);
         return 0;
     }
 
-    DH_get0_key(dh, &pub_key, &priv_key);
-    *priv_len = BN_num_bytes(priv_key);
-    *priv     = (uint8_t *)malloc(*priv_len);
-    BN_bn2bin(priv_key, *priv);
-
-    *pub_len = BN_num_bytes(pub_key);
-    *pub     = (uint8_t *)malloc(*pub_len);
-    BN_bn2bin(pub_key, *pub);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] DH key pair %s (pool: %u hits, %u misses)\n", 1 == from_pool ? "taken from the pool" : "generated on the spot", dh_pool.hits, dh_pool.misses);
 
-    DH_free(dh);
-      // NOTE: This internally frees "dh->p" and "dh->q", thus no need for us
-      // to do anything else.
+    *priv     = k.priv;
+    *priv_len = k.priv_len;
+    *pub      = k.pub;
+    *pub_len  = k.pub_len;
 
     return 1;
 }
@@ -227,19 +400,8 @@ uint8_t PLATFORM_COMPUTE_DH_SHARED_SECRET(uint8_t **shared_secret, uint16_t *sha
         return 0;
     }
 
-    if (NULL == (dh = DH_new()))
-    {
-        return 0;
-    }
-
-    // Convert binary to BIGNUM format
-    //
-    if (0 == DH_set0_pqg(dh,
-                         BN_bin2bn(dh1536_p,sizeof(dh1536_p),NULL),
-                         NULL,
-                         BN_bin2bn(dh1536_g,sizeof(dh1536_g),NULL)))
+    if (NULL == (dh = _dhNew()))
     {
-        DH_free(dh);
         return 0;
     }
 
@@ -57,7 +57,9 @@
 #include "platform_interfaces_wrt1900acx_priv.h"
 #endif
 
-#include <stdio.h>            // printf(), popen()
+#include "platform_metrics_priv.h"
+
+#include <stdio.h>            // printf(), fopen()
 #include <stdlib.h>           // malloc(), ssize_t
 #include <stdarg.h>           // va_*
 #include <string.h>           // strdup()
@@ -71,6 +73,8 @@
 #include <netinet/ether.h>    // ETH_P_ALL, ETH_A_LEN
 #include <unistd.h>           // close()
 #include <pthread.h>          // pthread_create(), mutex functions
+#include <sys/socket.h>       // sendmmsg(), struct mmsghdr
+#include <sys/uio.h>          // struct iovec
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -93,6 +97,32 @@ static char **interfaces_list_extended_params  = NULL;
 //
 pthread_mutex_t interface_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+// Transmit sockets cache.
+//
+// Opening a RAW socket and retrieving the interface index every time a packet
+// has to be sent is expensive (and it happens a lot: once per fragment, per
+// interface, per discovery tick...), thus we keep one already opened socket
+// (and its associated interface index) per registered interface.
+//
+// Entries are indexed in the same way as "interfaces_list" (entry 'i' belongs
+// to "interfaces_list[i]") and they are lazily (re)opened when needed: if the
+// socket could not be opened at registration time (ex: the interface did not
+// exist yet) or if the kernel later reports that the interface has gone away
+// (or has been re-created with a different index), the entry is invalidated
+// and a new socket is opened the next time it is needed.
+//
+struct _txSocket
+{
+    int fd;       // -1 if not opened yet (or invalidated)
+    int ifindex;
+};
+static struct _txSocket *tx_sockets = NULL;
+
+// "tx_sockets" is used by "PLATFORM_SEND_RAW_PACKET()", which can be called
+// from different threads, thus its access is also protected with a mutex
+//
+pthread_mutex_t tx_sockets_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 // Special interfaces stubs.
 //
 // "Regular" interfaces will be handled using standard Linux procedures (for
@@ -531,99 +561,263 @@ static void *_pushButtonConfigurationThread(void *p)
     return NULL;
 }
 
-// Returns an uint32_t obtained by reading the first line of file
-// "/sys/class/net/<interface_name>/<parameter_name>"
+// Returns the index (inside "interfaces_list" and "tx_sockets") of the
+// interface called 'interface_name' or '-1' if it was never registered
 //
-static int32_t _readInterfaceParameter(char *interface_name, char *parameter_name)
+static int _findInterface(char *interface_name)
 {
-    int32_t ret;
+    int i;
 
-    FILE *fp;
+    for (i=0; i<interfaces_nr; i++)
+    {
+        if (0 == strcmp(interfaces_list[i], interface_name))
+        {
+            return i;
+        }
+    }
 
-    char sys_path[100];
+    return -1;
+}
 
-    ret = 0;
+// Closes the cached transmit socket of entry 'i' (if any). The next call to
+// "_openTxSocket()" on the same entry will open a new one.
+//
+// Must be called with "tx_sockets_mutex" taken.
+//
+static void _closeTxSocket(int i)
+{
+    if (-1 != tx_sockets[i].fd)
+    {
+        close(tx_sockets[i].fd);
+    }
+    tx_sockets[i].fd      = -1;
+    tx_sockets[i].ifindex = 0;
+}
+
+// Makes sure entry 'i' of "tx_sockets" contains an opened RAW socket (and the
+// index of the interface it is associated to).
+//
+// Returns '1' on success, '0' otherwise.
+//
+// Must be called with "tx_sockets_mutex" taken.
+//
+static uint8_t _openTxSocket(int i)
+{
+    int           s;
+    struct ifreq  ifr;
 
-    snprintf(sys_path, sizeof(sys_path), "/sys/class/net/%s/%s", interface_name, parameter_name);
+    if (-1 != tx_sockets[i].fd)
+    {
+        // Already opened
+        //
+        return 1;
+    }
 
-    if(NULL != (fp = fopen(sys_path, "r")))
+    // Note that the "protocol" argument is '0': this socket is only used to
+    // transmit, and this way the kernel does not queue received frames on it
+    //
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Opening TX RAW socket for interface %s\n", interfaces_list[i]);
+    s = socket(AF_PACKET, SOCK_RAW, 0);
+    if (-1 == s)
     {
-        char aux[30];
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] socket('%s') returned with errno=%d (%s) while opening a RAW socket\n", interfaces_list[i], errno, strerror(errno));
+        return 0;
+    }
 
-        if (NULL != fgets(aux, sizeof(aux), fp))
-        {
-            ret = atoi(aux);
-        }
-        fclose(fp);
+    // Retrieve ethernet interface index
+    //
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, interfaces_list[i], IFNAMSIZ-1);
+    if (ioctl(s, SIOCGIFINDEX, &ifr) == -1)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] ioctl('%s',SIOCGIFINDEX) returned with errno=%d (%s) while opening a RAW socket\n", interfaces_list[i], errno, strerror(errno));
+        close(s);
+        return 0;
     }
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Successfully got interface index %d\n", ifr.ifr_ifindex);
 
-    return ret;
+    tx_sockets[i].fd      = s;
+    tx_sockets[i].ifindex = ifr.ifr_ifindex;
+
+    return 1;
 }
 
-// Returns an int32_t obtained by reading the output of
-// "iw dev $INTERFACE station get $MAC | grep $PARAMETER_NAME"
+// Prints the contents of a RAW packet (used for debug purposes)
 //
-static int32_t _readWifiNeighborParameter(char *interface_name, uint8_t *neighbor_interface_address, char *parameter_name)
+static void _printRawPacket(struct rawPacket *p)
 {
-    int32_t   ret;
-    FILE    *pipe;
-    char    *line;
-    size_t   len;
+    int i, first_time;
+    char aux1[200];
+    char aux2[10];
 
-    char     command[200];
+    if (0 == PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+    {
+        // Nothing would be printed. Don't waste time building the dump.
+        //
+        return;
+    }
 
-    ret = 0;
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Preparing to send RAW packet:\n");
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Interface name = %s\n", p->interface_name);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - DST  MAC       = 0x%02x:0x%02x:0x%02x:0x%02x:0x%02x:0x%02x\n", p->dst_mac[0], p->dst_mac[1], p->dst_mac[2], p->dst_mac[3], p->dst_mac[4], p->dst_mac[5]);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - SRC  MAC       = 0x%02x:0x%02x:0x%02x:0x%02x:0x%02x:0x%02x\n", p->src_mac[0], p->src_mac[1], p->src_mac[2], p->src_mac[3], p->src_mac[4], p->src_mac[5]);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Ether type     = 0x%04x\n", p->eth_type);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload length = %d\n", p->payload_len);
 
-    if ((NULL == interface_name) || (NULL == neighbor_interface_address) || (NULL == parameter_name))
+    aux1[0]    = 0x0;
+    aux2[0]    = 0x0;
+    first_time = 1;
+    for (i=0; i<p->payload_len; i++)
     {
-        return 0;
+        snprintf(aux2, 6, "0x%02x ", p->payload[i]);
+        strncat(aux1, aux2, 200-strlen(aux1)-1);
+
+        if (0 != i && 0 == (i+1)%8)
+        {
+            if (1 == first_time)
+            {
+                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload        = %s\n", aux1);
+                first_time = 0;
+            }
+            else
+            {
+                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]                      %s\n", aux1);
+            }
+            aux1[0] = 0x0;
+        }
     }
+    if (1 == first_time)
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload        = %s\n", aux1);
+    }
+    else
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]                      %s\n", aux1);
+    }
+}
 
-    sprintf(command, "iw dev %s station get %02x:%02x:%02x:%02x:%02x:%02x | grep %s",
-            interface_name,
-            neighbor_interface_address[0], neighbor_interface_address[1], neighbor_interface_address[2],
-            neighbor_interface_address[3], neighbor_interface_address[4], neighbor_interface_address[5],
-            parameter_name);
+// Sends the first 'packets_nr' packets of 'packets' (all of them on the
+// interface whose index inside "tx_sockets" is 'idx') with as few "sendmmsg()"
+// calls as possible (typically just one).
+//
+// Payloads are not copied anywhere: each frame is described to the kernel as
+// an ethernet header followed by the caller's payload (plus some padding when
+// the frame is shorter than the minimum ethernet frame length).
+//
+// Returns the number of packets that were successfully sent.
+//
+// Must be called with "tx_sockets_mutex" taken.
+//
+#define MIN_ETHERNET_FRAME_LEN (60)
+static uint16_t _sendRawPacketsBatch(int idx, struct rawPacket *packets, uint16_t packets_nr)
+{
+    static uint8_t padding[MIN_ETHERNET_FRAME_LEN];
 
-    // Execute the IW query command
-    //
-    pipe = popen(command, "r");
+    struct ether_header  headers[MAX_RAW_PACKETS_PER_BATCH];
+    struct sockaddr_ll   addresses[MAX_RAW_PACKETS_PER_BATCH];
+    struct iovec         iovecs[MAX_RAW_PACKETS_PER_BATCH][3];
+    struct mmsghdr       msgs[MAX_RAW_PACKETS_PER_BATCH];
+
+    uint16_t i, first, sent;
+    int      retries;
+    int      err;
+    int      ret;
 
-    if (!pipe)
+    if (packets_nr > MAX_RAW_PACKETS_PER_BATCH)
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] popen() returned with errno=%d (%s)\n", errno, strerror(errno));
-        return 0;
+        packets_nr = MAX_RAW_PACKETS_PER_BATCH;
     }
 
-    // Next read the parameter
-    //
-    line = NULL;
-    if (-1 != getline(&line, &len, pipe))
+    memset(msgs,      0, sizeof(msgs));
+    memset(addresses, 0, sizeof(addresses));
+
+    for (i=0; i<packets_nr; i++)
     {
-        char    *value;
+        struct rawPacket *p = &packets[i];
+        size_t            frame_len;
 
-        // Remove the last "\n"
+        _printRawPacket(p);
+
+        // Fill ethernet header
         //
-        line[strlen(line)-1] = 0x00;
+        memcpy(headers[i].ether_dhost, p->dst_mac, ETH_ALEN);
+        memcpy(headers[i].ether_shost, p->src_mac, ETH_ALEN);
+        headers[i].ether_type = htons(p->eth_type);
+
+        iovecs[i][0].iov_base = &headers[i];
+        iovecs[i][0].iov_len  = sizeof(headers[i]);
+        iovecs[i][1].iov_base = p->payload;
+        iovecs[i][1].iov_len  = p->payload_len;
+
+        msgs[i].msg_hdr.msg_iov    = iovecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 2;
 
-        value = strstr(line, ":");
-        if ((NULL != value) && (1 == sscanf(value+1, "%d", &ret)))
+        frame_len = sizeof(headers[i]) + p->payload_len;
+        if (frame_len < MIN_ETHERNET_FRAME_LEN)
         {
-             PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Neighbor %02x:%02x:%02x:%02x:%02x:%02x (%s) %d = %d\n",
-                 neighbor_interface_address[0], neighbor_interface_address[1], neighbor_interface_address[2],
-                 neighbor_interface_address[3], neighbor_interface_address[4], neighbor_interface_address[5],
-                 interface_name, parameter_name, ret);
+            iovecs[i][2].iov_base = padding;
+            iovecs[i][2].iov_len  = MIN_ETHERNET_FRAME_LEN - frame_len;
+
+            msgs[i].msg_hdr.msg_iovlen = 3;
         }
-        else
+
+        // Prepare sockaddr_ll (the interface index is filled below)
+        //
+        addresses[i].sll_halen = ETH_ALEN;
+        memcpy(addresses[i].sll_addr, p->dst_mac, ETH_ALEN);
+
+        msgs[i].msg_hdr.msg_name    = &addresses[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+    }
+
+    // If the interface disappeared (or was re-created with a different index)
+    // since the cached socket was opened, "sendmmsg()" fails with one of the
+    // errors checked below. In that case the cached entry is invalidated and
+    // the remaining packets are sent again (only once) on a freshly opened
+    // socket.
+    //
+    sent    = 0;
+    first   = 0;
+    retries = 0;
+    while (first < packets_nr)
+    {
+        if (0 == _openTxSocket(idx))
+        {
+            break;
+        }
+        for (i=first; i<packets_nr; i++)
+        {
+            addresses[i].sll_ifindex = tx_sockets[idx].ifindex;
+        }
+
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Sending %d packet(s) to RAW socket\n", packets_nr - first);
+        ret = sendmmsg(tx_sockets[idx].fd, &msgs[first], packets_nr - first, 0);
+
+        if (ret > 0)
         {
-             PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Parameter not found\n");
+            sent  += ret;
+            first += ret;
+            continue;
         }
+
+        err = errno;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] sendmmsg('%s') returned with errno=%d (%s)\n", packets[first].interface_name, err, strerror(err));
+
+        if ((ENXIO == err || ENODEV == err) && 0 == retries)
+        {
+            _closeTxSocket(idx);
+            retries++;
+            continue;
+        }
+
+        // Give up on this packet, but still try with the rest of them
+        //
+        first++;
     }
 
-    free(line);
-    pclose(pipe);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] %d/%d packet(s) sent!\n", sent, packets_nr);
 
-    return ret;
+    return sent;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -686,6 +880,9 @@ void addInterface(char *long_interface_name)
         interfaces_list                 = realloc(interfaces_list,                 (sizeof (char *)) * (interfaces_nr+1));
         interfaces_list_extended_params = realloc(interfaces_list_extended_params, (sizeof (char *)) * (interfaces_nr+1));
     }
+    pthread_mutex_lock(&tx_sockets_mutex);
+    tx_sockets = (struct _txSocket *)realloc(tx_sockets, (sizeof (struct _txSocket)) * (interfaces_nr+1));
+    pthread_mutex_unlock(&tx_sockets_mutex);
 
     // The interface name can be either something like this:
     //
@@ -721,6 +918,16 @@ void addInterface(char *long_interface_name)
         PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Added interface %s with no additional parameters\n", interfaces_list[interfaces_nr]);
     }
 
+    // Open the transmit socket now, so that it is ready by the time the first
+    // packet has to be sent. If it fails (ex: the interface does not exist
+    // yet) it will be retried later from "PLATFORM_SEND_RAW_PACKET()"
+    //
+    pthread_mutex_lock(&tx_sockets_mutex);
+    tx_sockets[interfaces_nr].fd      = -1;
+    tx_sockets[interfaces_nr].ifindex = 0;
+    _openTxSocket(interfaces_nr);
+    pthread_mutex_unlock(&tx_sockets_mutex);
+
     interfaces_nr++;
 
     return;
@@ -1182,27 +1389,29 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
         //
         if (strstr(local_interface_name, "wlan") != NULL)
         {
+            struct stationMetrics station;
+
+            // All the information is obtained from the nl80211 station
+            // counters of 'neighbor_interface_address' (the same ones
+            // displayed by "iw dev $INTERFACE station get $NEIGHBOR_MAC")
+            //
+            if (0 == metricsGetStation(local_interface_name, ret->neighbor_interface_address, &station))
+            {
+                memset(&station, 0, sizeof(station));
+            }
+
             // Obtain the amount of (correct and incorrect) packets transmitted
             // to 'neighbor_interface_address' in the last
             // 'ret->measures_window' seconds.
             //
-            // This is done by reading the response of the command
-            //
-            //   "iw dev $INTERFACE station get $NEIGHBOR_MAC | grep "tx packets"" and
-            //   "iw dev $INTERFACE station get $NEIGHBOR_MAC | grep "tx failed""
-            //
-            ret->tx_packet_ok     = (uint32_t)_readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"tx packets\"");
-            ret->tx_packet_errors = (uint32_t)_readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"tx failed\"");
+            ret->tx_packet_ok     = station.tx_packets;
+            ret->tx_packet_errors = station.tx_failed;
 
             // Obtain the estimated max MAC xput and PHY rate when transmitting
             // data from "A" to "B".
             //
-            // This is done by reading the response of the command
-            //
-            //   "iw dev $INTERFACE station get $NEIGHBOR_MAC | grep speed"
-            //
-            ret->tx_max_xput = (uint16_t)_readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"tx bitrate\"");
-            ret->tx_phy_rate = (uint16_t)_readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"tx bitrate\"");
+            ret->tx_max_xput = (uint16_t)station.tx_bitrate;
+            ret->tx_phy_rate = (uint16_t)station.tx_bitrate;
 
             // Obtain the estimated average percentage of time that the link is
             // available for transmission.
@@ -1215,15 +1424,10 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
             // from 'neighbor_interface_address' in the last
             // 'ret->measures_window' seconds.
             //
-            // This is done by reading the response of the command
-            //
-            //   "iw dev $INTERFACE station get $NEIGHBOR_MAC | grep "rx packets""
-            //
-            //   TODO: rx errors can't be obtained from this console command.
-            //   Right now it's assigned a zero value. Investigate how to
-            //   obtain this value.
+            //   TODO: rx errors are not reported by nl80211. Right now it's
+            //   assigned a zero value. Investigate how to obtain this value.
             //
-            ret->rx_packet_ok     = (uint32_t)_readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"rx packets\"");
+            ret->rx_packet_ok     = station.rx_packets;
             ret->rx_packet_errors = 0;
 
 
@@ -1244,7 +1448,7 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
             // Feel free to redefine this conversion formula. Maybe to a
             // logarithmical one.
             //
-            tmp = _readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"signal:\"");
+            tmp = station.signal;
 
             #define  SIGNAL_MAX  (-40)   // dBm
             #define  SIGNAL_MIN  (-70)
@@ -1264,6 +1468,17 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
         // Other interface types, probably ethernet
         else
         {
+            struct interfaceMetrics link;
+
+            // All the information is obtained from the counters of the local
+            // interface (the same ones found in
+            // "/sys/class/net/<interface_name>/statistics/") and its speed.
+            //
+            if (0 == metricsGetInterface(local_interface_name, &link))
+            {
+                memset(&link, 0, sizeof(link));
+            }
+
             // Obtain the amount of (correct and incorrect) packets transmitted
             // to 'neighbor_interface_address' in the last
             // 'ret->measures_window' seconds.
@@ -1276,13 +1491,8 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
             //   is connected to one single remote interface... however we
             //   better report this than nothing at all.
             //
-            // This is done by reading the contents of files
-            //
-            //   "/sys/class/net/<interface_name>/statistics/tx_packets" and
-            //   "/sys/class/net/<interface_name>/statistics/tx_errors"
-            //
-            ret->tx_packet_ok     = (uint32_t)_readInterfaceParameter(local_interface_name, "statistics/tx_packets");
-            ret->tx_packet_errors = (uint32_t)_readInterfaceParameter(local_interface_name, "statistics/tx_errors");
+            ret->tx_packet_ok     = link.tx_packets;
+            ret->tx_packet_errors = link.tx_errors;
 
             // Obtain the estimatid max MAC xput and PHY rate when transmitting
             // data from "A" to "B".
@@ -1290,15 +1500,11 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
             //   TODO: The same considerations as in the previous parameters
             //   apply here.
             //
-            // This is done by reading the contents of file
-            //
-            //   "/sys/class/net/<interface_name>/speed
-            //
             // NOTE: I'll set both parameters to the same value. Is there a
             // better way to do this?
             //
-            ret->tx_max_xput = (uint16_t)_readInterfaceParameter(local_interface_name, "speed");
-            ret->tx_phy_rate = (uint16_t)_readInterfaceParameter(local_interface_name, "speed");
+            ret->tx_max_xput = (uint16_t)link.speed;
+            ret->tx_phy_rate = (uint16_t)link.speed;
 
             // Obtain the estimated average percentage of time that the link is
             // available for transmission.
@@ -1318,13 +1524,8 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
             //   connected to one single remote interface... however we better
             //   report this than nothing at all.
             //
-            // This is done by reading the contents of files
-            //
-            //   "/sys/class/net/<interface_name>/statistics/rx_packets" and
-            //   "/sys/class/net/<interface_name>/statistics/rx_errors"
-            //
-            ret->rx_packet_ok     = (uint32_t)_readInterfaceParameter(local_interface_name, "statistics/rx_packets");
-            ret->rx_packet_errors = (uint32_t)_readInterfaceParameter(local_interface_name, "statistics/rx_errors");
+            ret->rx_packet_ok     = link.rx_packets;
+            ret->rx_packet_errors = link.rx_errors;
 
             // Obtain the estimated RX RSSI
             //
@@ -1371,137 +1572,59 @@ void free_LIST_OF_BRIDGES(struct bridge *x, uint8_t nr)
 
 uint8_t PLATFORM_SEND_RAW_PACKET(char *interface_name, uint8_t *dst_mac, uint8_t *src_mac, uint16_t eth_type, uint8_t *payload, uint16_t payload_len)
 {
-    int i, first_time;
-    char aux1[200];
-    char aux2[10];
+    struct rawPacket packet;
 
-    int                 s;
-    struct ifreq        ifr;
-    int                 ifindex;
-    struct sockaddr_ll  socket_address;
+    packet.interface_name = interface_name;
+    packet.dst_mac        = dst_mac;
+    packet.src_mac        = src_mac;
+    packet.eth_type       = eth_type;
+    packet.payload        = payload;
+    packet.payload_len    = payload_len;
 
-    uint8_t buffer[MAX_NETWORK_SEGMENT_SIZE];
-    struct ether_header *eh;
+    return PLATFORM_SEND_RAW_PACKETS(&packet, 1);
+}
 
-    // Print packet (used for debug purposes)
-    //
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Preparing to send RAW packet:\n");
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Interface name = %s\n", interface_name);
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - DST  MAC       = 0x%02x:0x%02x:0x%02x:0x%02x:0x%02x:0x%02x\n", dst_mac[0], dst_mac[1], dst_mac[2], dst_mac[3], dst_mac[4], dst_mac[5]);
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - SRC  MAC       = 0x%02x:0x%02x:0x%02x:0x%02x:0x%02x:0x%02x\n", src_mac[0], src_mac[1], src_mac[2], src_mac[3], src_mac[4], src_mac[5]);
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Ether type     = 0x%04x\n", eth_type);
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload length = %d\n", payload_len);
+uint8_t PLATFORM_SEND_RAW_PACKETS(struct rawPacket *packets, uint16_t packets_nr)
+{
+    uint16_t i, n;
+    int      idx;
+    uint8_t  ret;
 
-    aux1[0]    = 0x0;
-    aux2[0]    = 0x0;
-    first_time = 1;
-    for (i=0; i<payload_len; i++)
-    {
-        snprintf(aux2, 6, "0x%02x ", payload[i]);
-        strncat(aux1, aux2, 200-strlen(aux1)-1);
+    ret = 1;
 
-        if (0 != i && 0 == (i+1)%8)
+    pthread_mutex_lock(&tx_sockets_mutex);
+
+    i = 0;
+    while (i < packets_nr)
+    {
+        // Group together all consecutive packets that go out through the same
+        // interface, so that they can be handed to the kernel at once
+        //
+        for (n=1; i+n < packets_nr && n < MAX_RAW_PACKETS_PER_BATCH; n++)
         {
-            if (1 == first_time)
-            {
-                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload        = %s\n", aux1);
-                first_time = 0;
-            }
-            else
+            if (0 != strcmp(packets[i+n].interface_name, packets[i].interface_name))
             {
-                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]                      %s\n", aux1);
+                break;
             }
-            aux1[0] = 0x0;
         }
-    }
-    if (1 == first_time)
-    {
-        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload        = %s\n", aux1);
-    }
-    else
-    {
-        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]                      %s\n", aux1);
-    }
 
-    // Open RAW socket
-    //
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Opening RAW socket\n");
-    s = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
-    if (-1 == s)
-    {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] socket('%s') returned with errno=%d (%s) while opening a RAW socket\n", interface_name, errno, strerror(errno));
-        return 0;
-    }
+        idx = _findInterface(packets[i].interface_name);
+        if (-1 == idx)
+        {
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Interface %s is not a registered 1905 interface\n", packets[i].interface_name);
+            ret = 0;
+        }
+        else if (n != _sendRawPacketsBatch(idx, &packets[i], n))
+        {
+            ret = 0;
+        }
 
-    // Retrieve ethernet interface index
-    //
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Retrieving interface index\n");
-    strncpy(ifr.ifr_name, interface_name, IFNAMSIZ);
-    if (ioctl(s, SIOCGIFINDEX, &ifr) == -1)
-    {
-          PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] ioctl('%s',SIOCGIFINDEX) returned with errno=%d (%s) while opening a RAW socket\n", interface_name, errno, strerror(errno));
-          close(s);
-          return 0;
+        i += n;
     }
-    ifindex = ifr.ifr_ifindex;
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Successfully got interface index %d\n", ifindex);
-
-    // Empy buffer
-    //
-    memset(buffer, 0, MAX_NETWORK_SEGMENT_SIZE);
-
-    // Fill ethernet header
-    //
-    eh                 = (struct ether_header *)buffer;
-    eh->ether_dhost[0] = dst_mac[0];
-    eh->ether_dhost[1] = dst_mac[1];
-    eh->ether_dhost[2] = dst_mac[2];
-    eh->ether_dhost[3] = dst_mac[3];
-    eh->ether_dhost[4] = dst_mac[4];
-    eh->ether_dhost[5] = dst_mac[5];
-    eh->ether_shost[0] = src_mac[0];
-    eh->ether_shost[1] = src_mac[1];
-    eh->ether_shost[2] = src_mac[2];
-    eh->ether_shost[3] = src_mac[3];
-    eh->ether_shost[4] = src_mac[4];
-    eh->ether_shost[5] = src_mac[5];
-    eh->ether_type     = htons(eth_type);
-
-    // Fill buffer
-    //
-    memcpy(buffer + sizeof(*eh), payload, payload_len);
 
-    // Prepare sockaddr_ll
-    //
-    memset(&socket_address, 0, sizeof(socket_address));
-    socket_address.sll_ifindex  = ifindex;
-    socket_address.sll_halen    = ETH_ALEN;
-    socket_address.sll_addr[0]  = dst_mac[0];
-    socket_address.sll_addr[1]  = dst_mac[1];
-    socket_address.sll_addr[2]  = dst_mac[2];
-    socket_address.sll_addr[3]  = dst_mac[3];
-    socket_address.sll_addr[4]  = dst_mac[4];
-    socket_address.sll_addr[5]  = dst_mac[5];
-    socket_address.sll_addr[6]  = 0x00;
-    socket_address.sll_addr[7]  = 0x00;
-
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Sending data to RAW socket\n");
-    if (-1 == sendto(s,
-                     buffer,
-                     sizeof(*eh) + payload_len >= 60 ? sizeof(*eh) + payload_len : 60, // 60 is the minimum ethernet frame length
-                     0,
-                     (struct sockaddr*)&socket_address,
-                     sizeof(socket_address))
-       )
-    {
-          PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] sendto('%s') returned with errno=%d (%s)\n", interface_name, errno, strerror(errno));
-          close(s);
-          return 0;
-    }
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Data sent!\n");
+    pthread_mutex_unlock(&tx_sockets_mutex);
 
-    close(s);
-    return 1;
+    return ret;
 }
 
 uint8_t PLATFORM_START_PUSH_BUTTON_CONFIGURATION(char *interface_name, uint8_t queue_id, uint8_t *al_mac_address, uint16_t mid)
@@ -0,0 +1,598 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+#include "platform.h"
+#include "platform_metrics_priv.h"
+#include <platform_linux.h>
+
+#include <stdlib.h>               // malloc(), realloc(), free()
+#include <string.h>               // memcpy(), memcmp(), strncpy(), ...
+#include <errno.h>                // errno
+#include <unistd.h>               // close()
+#include <pthread.h>              // mutex functions
+#include <sys/socket.h>           // socket(), send(), recv()
+#include <sys/ioctl.h>            // ioctl()
+#include <net/if.h>               // struct ifreq, IFNAMSIZ
+#include <linux/netlink.h>        // struct nlmsghdr, NLMSG_*
+#include <linux/rtnetlink.h>      // RTM_GETLINK, IFLA_*
+#include <linux/if_link.h>        // struct rtnl_link_stats64
+#include <linux/genetlink.h>      // struct genlmsghdr, CTRL_*
+#include <linux/nl80211.h>        // NL80211_*
+#include <linux/ethtool.h>        // struct ethtool_cmd
+#include <linux/sockios.h>        // SIOCETHTOOL
+
+////////////////////////////////////////////////////////////////////////////////
+// Private functions, structures and macros
+////////////////////////////////////////////////////////////////////////////////
+
+#define NETLINK_BUFFER_SIZE  (32*1024)
+
+// Cached metrics of one interface
+//
+struct _metricsCacheEntry
+{
+    char                     interface_name[IFNAMSIZ];
+
+    uint8_t                  link_valid;
+    uint32_t                 link_timestamp;
+    struct interfaceMetrics  link;
+
+    uint8_t                  stations_valid;
+    uint32_t                 stations_timestamp;
+    struct stationMetrics   *stations;
+    uint16_t                 stations_nr;
+};
+
+static struct
+{
+    pthread_mutex_t             mutex;
+
+    uint32_t                    cache_window;
+
+    struct _metricsCacheEntry  *entries;
+    uint16_t                    entries_nr;
+
+    int                         rtnetlink_fd;
+    int                         genetlink_fd;
+    int                         nl80211_id;     // Generic netlink family ID
+    uint32_t                    seq;
+
+} metrics = {
+    .mutex        = PTHREAD_MUTEX_INITIALIZER,
+    .cache_window = PLATFORM_METRICS_CACHE_MS,
+    .rtnetlink_fd = -1,
+    .genetlink_fd = -1,
+    .nl80211_id   = -1,
+};
+
+// Append a netlink attribute to the message 'n' (which must have enough space)
+//
+static void _nlAddAttr(struct nlmsghdr *n, uint16_t type, const void *data, uint16_t len)
+{
+    struct nlattr *a;
+
+    a = (struct nlattr *)((uint8_t *)n + NLMSG_ALIGN(n->nlmsg_len));
+    a->nla_type = type;
+    a->nla_len  = NLA_HDRLEN + len;
+    memcpy((uint8_t *)a + NLA_HDRLEN, data, len);
+
+    n->nlmsg_len = NLMSG_ALIGN(n->nlmsg_len) + NLA_ALIGN(a->nla_len);
+}
+
+// Fill 'tb' (which has 'max'+1 elements) with pointers to the attributes found
+// in the 'len' bytes starting at 'a'. Missing attributes are set to NULL.
+//
+static void _nlParseAttrs(struct nlattr **tb, uint16_t max, struct nlattr *a, int len)
+{
+    memset(tb, 0, sizeof(struct nlattr *) * (max + 1));
+
+    while (len >= NLA_HDRLEN && a->nla_len >= NLA_HDRLEN && a->nla_len <= len)
+    {
+        uint16_t type = a->nla_type & NLA_TYPE_MASK;
+
+        if (type <= max)
+        {
+            tb[type] = a;
+        }
+        len -= NLA_ALIGN(a->nla_len);
+        a    = (struct nlattr *)((uint8_t *)a + NLA_ALIGN(a->nla_len));
+    }
+}
+
+#define NLA_DATA(a)      ((void *)((uint8_t *)(a) + NLA_HDRLEN))
+#define NLA_PAYLOAD(a)   ((a)->nla_len - NLA_HDRLEN)
+
+static int _nlOpen(int protocol)
+{
+    int                 fd;
+    struct sockaddr_nl  addr;
+
+    fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, protocol);
+    if (-1 == fd)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] netlink socket(%d) returned with errno=%d (%s)\n", protocol, errno, strerror(errno));
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+
+    if (-1 == bind(fd, (struct sockaddr *)&addr, sizeof(addr)))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] netlink bind(%d) returned with errno=%d (%s)\n", protocol, errno, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+// Send request 'req' and call 'callback' for each message of the response
+// until it is complete.
+//
+// Returns "0" if there was a problem, "1" otherwise
+//
+static uint8_t _nlTransaction(int fd, struct nlmsghdr *req, void (*callback)(struct nlmsghdr *n, void *data), void *data)
+{
+    uint8_t *buffer;
+    uint8_t  ret;
+    uint8_t  done;
+
+    req->nlmsg_seq = ++metrics.seq;
+    req->nlmsg_pid = 0;
+
+    if (-1 == send(fd, req, req->nlmsg_len, 0))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] netlink send() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return 0;
+    }
+
+    buffer = (uint8_t *)malloc(NETLINK_BUFFER_SIZE);
+    if (NULL == buffer)
+    {
+        return 0;
+    }
+
+    ret  = 1;
+    done = 0;
+    while (0 == done)
+    {
+        struct nlmsghdr *n;
+        ssize_t          len;
+
+        len = recv(fd, buffer, NETLINK_BUFFER_SIZE, 0);
+        if (len < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] netlink recv() returned with errno=%d (%s)\n", errno, strerror(errno));
+            ret = 0;
+            break;
+        }
+
+        for (n = (struct nlmsghdr *)buffer; NLMSG_OK(n, (size_t)len); n = NLMSG_NEXT(n, len))
+        {
+            if (n->nlmsg_seq != req->nlmsg_seq)
+            {
+                // Left over from a previous (failed) transaction
+                //
+                continue;
+            }
+
+            if (NLMSG_DONE == n->nlmsg_type)
+            {
+                done = 1;
+                break;
+            }
+            if (NLMSG_ERROR == n->nlmsg_type)
+            {
+                struct nlmsgerr *e = (struct nlmsgerr *)NLMSG_DATA(n);
+
+                if (0 != e->error)
+                {
+                    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] netlink request failed with error=%d (%s)\n", -e->error, strerror(-e->error));
+                    ret = 0;
+                }
+                done = 1;
+                break;
+            }
+
+            callback(n, data);
+
+            if (0 == (n->nlmsg_flags & NLM_F_MULTI))
+            {
+                done = 1;
+                break;
+            }
+        }
+    }
+
+    free(buffer);
+    return ret;
+}
+
+// *********** Interface counters (rtnetlink + ethtool) ************************
+
+static void _linkCallback(struct nlmsghdr *n, void *data)
+{
+    struct interfaceMetrics *m = (struct interfaceMetrics *)data;
+    struct rtattr           *a;
+    int                      len;
+
+    if (RTM_NEWLINK != n->nlmsg_type)
+    {
+        return;
+    }
+
+    len = IFLA_PAYLOAD(n);
+    for (a = IFLA_RTA(NLMSG_DATA(n)); RTA_OK(a, len); a = RTA_NEXT(a, len))
+    {
+        if (IFLA_STATS64 == a->rta_type && RTA_PAYLOAD(a) >= sizeof(struct rtnl_link_stats64))
+        {
+            struct rtnl_link_stats64 stats;
+
+            memcpy(&stats, RTA_DATA(a), sizeof(stats));
+
+            m->tx_packets = (uint32_t)stats.tx_packets;
+            m->tx_errors  = (uint32_t)stats.tx_errors;
+            m->rx_packets = (uint32_t)stats.rx_packets;
+            m->rx_errors  = (uint32_t)stats.rx_errors;
+        }
+    }
+}
+
+static uint8_t _queryInterface(char *interface_name, struct interfaceMetrics *m)
+{
+    struct
+    {
+        struct nlmsghdr   n;
+        struct ifinfomsg  i;
+    } req;
+
+    int                 ifindex;
+    int                 fd;
+    struct ifreq        ifr;
+    struct ethtool_cmd  ecmd;
+
+    memset(m, 0, sizeof(*m));
+
+    ifindex = if_nametoindex(interface_name);
+    if (0 == ifindex)
+    {
+        return 0;
+    }
+
+    if (-1 == metrics.rtnetlink_fd && -1 == (metrics.rtnetlink_fd = _nlOpen(NETLINK_ROUTE)))
+    {
+        return 0;
+    }
+
+    memset(&req, 0, sizeof(req));
+    req.n.nlmsg_len    = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    req.n.nlmsg_type   = RTM_GETLINK;
+    req.n.nlmsg_flags  = NLM_F_REQUEST;
+    req.i.ifi_family   = AF_UNSPEC;
+    req.i.ifi_index    = ifindex;
+
+    if (0 == _nlTransaction(metrics.rtnetlink_fd, &req.n, _linkCallback, m))
+    {
+        return 0;
+    }
+
+    // The link speed is not part of the rtnetlink information
+    //
+    fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (-1 != fd)
+    {
+        memset(&ifr,  0, sizeof(ifr));
+        memset(&ecmd, 0, sizeof(ecmd));
+
+        strncpy(ifr.ifr_name, interface_name, IFNAMSIZ-1);
+        ecmd.cmd     = ETHTOOL_GSET;
+        ifr.ifr_data = (char *)&ecmd;
+
+        if (0 == ioctl(fd, SIOCETHTOOL, &ifr) && SPEED_UNKNOWN != ethtool_cmd_speed(&ecmd))
+        {
+            m->speed = ethtool_cmd_speed(&ecmd);
+        }
+        close(fd);
+    }
+
+    return 1;
+}
+
+// *********** WiFi stations counters (nl80211) ********************************
+
+static void _familyCallback(struct nlmsghdr *n, void *data)
+{
+    struct nlattr *tb[CTRL_ATTR_MAX + 1];
+
+    _nlParseAttrs(tb, CTRL_ATTR_MAX, (struct nlattr *)((uint8_t *)NLMSG_DATA(n) + GENL_HDRLEN), n->nlmsg_len - NLMSG_LENGTH(GENL_HDRLEN));
+
+    if (NULL != tb[CTRL_ATTR_FAMILY_ID])
+    {
+        *(int *)data = *(uint16_t *)NLA_DATA(tb[CTRL_ATTR_FAMILY_ID]);
+    }
+}
+
+static void _stationCallback(struct nlmsghdr *n, void *data)
+{
+    struct _metricsCacheEntry *e = (struct _metricsCacheEntry *)data;
+
+    struct nlattr *tb[NL80211_ATTR_MAX + 1];
+    struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
+    struct nlattr *rinfo[NL80211_RATE_INFO_MAX + 1];
+
+    struct stationMetrics *s;
+    struct stationMetrics *aux;
+
+    _nlParseAttrs(tb, NL80211_ATTR_MAX, (struct nlattr *)((uint8_t *)NLMSG_DATA(n) + GENL_HDRLEN), n->nlmsg_len - NLMSG_LENGTH(GENL_HDRLEN));
+
+    if (NULL == tb[NL80211_ATTR_MAC] || 6 != NLA_PAYLOAD(tb[NL80211_ATTR_MAC]) || NULL == tb[NL80211_ATTR_STA_INFO])
+    {
+        return;
+    }
+
+    aux = (struct stationMetrics *)realloc(e->stations, sizeof(struct stationMetrics) * (e->stations_nr + 1));
+    if (NULL == aux)
+    {
+        return;
+    }
+    e->stations = aux;
+    s           = &e->stations[e->stations_nr++];
+
+    memset(s, 0, sizeof(*s));
+    memcpy(s->address, NLA_DATA(tb[NL80211_ATTR_MAC]), 6);
+
+    _nlParseAttrs(sinfo, NL80211_STA_INFO_MAX, (struct nlattr *)NLA_DATA(tb[NL80211_ATTR_STA_INFO]), NLA_PAYLOAD(tb[NL80211_ATTR_STA_INFO]));
+
+    if (NULL != sinfo[NL80211_STA_INFO_TX_PACKETS])
+    {
+        s->tx_packets = *(uint32_t *)NLA_DATA(sinfo[NL80211_STA_INFO_TX_PACKETS]);
+    }
+    if (NULL != sinfo[NL80211_STA_INFO_TX_FAILED])
+    {
+        s->tx_failed = *(uint32_t *)NLA_DATA(sinfo[NL80211_STA_INFO_TX_FAILED]);
+    }
+    if (NULL != sinfo[NL80211_STA_INFO_RX_PACKETS])
+    {
+        s->rx_packets = *(uint32_t *)NLA_DATA(sinfo[NL80211_STA_INFO_RX_PACKETS]);
+    }
+    if (NULL != sinfo[NL80211_STA_INFO_SIGNAL])
+    {
+        s->signal = *(int8_t *)NLA_DATA(sinfo[NL80211_STA_INFO_SIGNAL]);
+    }
+    if (NULL != sinfo[NL80211_STA_INFO_TX_BITRATE])
+    {
+        // Rates are given in units of 100 kbit/s
+        //
+        _nlParseAttrs(rinfo, NL80211_RATE_INFO_MAX, (struct nlattr *)NLA_DATA(sinfo[NL80211_STA_INFO_TX_BITRATE]), NLA_PAYLOAD(sinfo[NL80211_STA_INFO_TX_BITRATE]));
+
+        if (NULL != rinfo[NL80211_RATE_INFO_BITRATE32])
+        {
+            s->tx_bitrate = *(uint32_t *)NLA_DATA(rinfo[NL80211_RATE_INFO_BITRATE32]) / 10;
+        }
+        else if (NULL != rinfo[NL80211_RATE_INFO_BITRATE])
+        {
+            s->tx_bitrate = *(uint16_t *)NLA_DATA(rinfo[NL80211_RATE_INFO_BITRATE]) / 10;
+        }
+    }
+}
+
+static uint8_t _queryStations(struct _metricsCacheEntry *e)
+{
+    struct
+    {
+        struct nlmsghdr     n;
+        struct genlmsghdr   g;
+        uint8_t             attrs[64];
+    } req;
+
+    uint32_t ifindex;
+
+    e->stations_nr = 0;
+
+    ifindex = if_nametoindex(e->interface_name);
+    if (0 == ifindex)
+    {
+        return 0;
+    }
+
+    if (-1 == metrics.genetlink_fd && -1 == (metrics.genetlink_fd = _nlOpen(NETLINK_GENERIC)))
+    {
+        return 0;
+    }
+
+    // The "nl80211" generic netlink family ID is assigned dynamically by the
+    // kernel. Ask for it the first time.
+    //
+    if (-1 == metrics.nl80211_id)
+    {
+        memset(&req, 0, sizeof(req));
+        req.n.nlmsg_len   = NLMSG_LENGTH(GENL_HDRLEN);
+        req.n.nlmsg_type  = GENL_ID_CTRL;
+        req.n.nlmsg_flags = NLM_F_REQUEST;
+        req.g.cmd         = CTRL_CMD_GETFAMILY;
+        req.g.version     = 1;
+        _nlAddAttr(&req.n, CTRL_ATTR_FAMILY_NAME, NL80211_GENL_NAME, strlen(NL80211_GENL_NAME) + 1);
+
+        if (0 == _nlTransaction(metrics.genetlink_fd, &req.n, _familyCallback, &metrics.nl80211_id) || -1 == metrics.nl80211_id)
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] nl80211 is not available\n");
+            return 0;
+        }
+    }
+
+    memset(&req, 0, sizeof(req));
+    req.n.nlmsg_len   = NLMSG_LENGTH(GENL_HDRLEN);
+    req.n.nlmsg_type  = metrics.nl80211_id;
+    req.n.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req.g.cmd         = NL80211_CMD_GET_STATION;
+    req.g.version     = 0;
+    _nlAddAttr(&req.n, NL80211_ATTR_IFINDEX, &ifindex, sizeof(ifindex));
+
+    return _nlTransaction(metrics.genetlink_fd, &req.n, _stationCallback, e);
+}
+
+// Return the cache entry of 'interface_name' (creating it if needed)
+//
+static struct _metricsCacheEntry *_cacheEntry(char *interface_name)
+{
+    struct _metricsCacheEntry *aux;
+    uint16_t                   i;
+
+    for (i=0; i<metrics.entries_nr; i++)
+    {
+        if (0 == strncmp(metrics.entries[i].interface_name, interface_name, IFNAMSIZ))
+        {
+            return &metrics.entries[i];
+        }
+    }
+
+    aux = (struct _metricsCacheEntry *)realloc(metrics.entries, sizeof(struct _metricsCacheEntry) * (metrics.entries_nr + 1));
+    if (NULL == aux)
+    {
+        return NULL;
+    }
+    metrics.entries = aux;
+
+    memset(&metrics.entries[metrics.entries_nr], 0, sizeof(struct _metricsCacheEntry));
+    strncpy(metrics.entries[metrics.entries_nr].interface_name, interface_name, IFNAMSIZ-1);
+
+    return &metrics.entries[metrics.entries_nr++];
+}
+
+static uint8_t _isFresh(uint8_t valid, uint32_t timestamp)
+{
+    return 1 == valid && PLATFORM_GET_TIMESTAMP() - timestamp < metrics.cache_window ? 1 : 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Internal API: to be used by other platform-specific files (functions
+// declaration is found in "./platform_metrics_priv.h")
+////////////////////////////////////////////////////////////////////////////////
+
+uint8_t metricsGetInterface(char *interface_name, struct interfaceMetrics *m)
+{
+    struct _metricsCacheEntry *e;
+    uint8_t                    ret;
+
+    pthread_mutex_lock(&metrics.mutex);
+
+    e = _cacheEntry(interface_name);
+    if (NULL == e)
+    {
+        pthread_mutex_unlock(&metrics.mutex);
+        return 0;
+    }
+
+    if (0 == _isFresh(e->link_valid, e->link_timestamp))
+    {
+        e->link_valid     = _queryInterface(interface_name, &e->link);
+        e->link_timestamp = PLATFORM_GET_TIMESTAMP();
+    }
+
+    ret = e->link_valid;
+    if (1 == ret)
+    {
+        memcpy(m, &e->link, sizeof(*m));
+    }
+
+    pthread_mutex_unlock(&metrics.mutex);
+    return ret;
+}
+
+uint8_t metricsGetStation(char *interface_name, uint8_t *station_address, struct stationMetrics *m)
+{
+    struct _metricsCacheEntry *e;
+    uint8_t                    ret;
+    uint16_t                   i;
+
+    pthread_mutex_lock(&metrics.mutex);
+
+    e = _cacheEntry(interface_name);
+    if (NULL == e)
+    {
+        pthread_mutex_unlock(&metrics.mutex);
+        return 0;
+    }
+
+    if (0 == _isFresh(e->stations_valid, e->stations_timestamp))
+    {
+        e->stations_valid     = _queryStations(e);
+        e->stations_timestamp = PLATFORM_GET_TIMESTAMP();
+    }
+
+    ret = 0;
+    if (1 == e->stations_valid)
+    {
+        for (i=0; i<e->stations_nr; i++)
+        {
+            if (0 == memcmp(e->stations[i].address, station_address, 6))
+            {
+                memcpy(m, &e->stations[i], sizeof(*m));
+                ret = 1;
+                break;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&metrics.mutex);
+    return ret;
+}
+
+void metricsSetCacheWindow(uint32_t ms)
+{
+    pthread_mutex_lock(&metrics.mutex);
+    metrics.cache_window = ms;
+    pthread_mutex_unlock(&metrics.mutex);
+}
@@ -0,0 +1,115 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+#ifndef _PLATFORM_METRICS_PRIV_H_
+#define _PLATFORM_METRICS_PRIV_H_
+
+#include "platform.h"
+
+// Link metrics of regular (ie. not "special") interfaces are obtained from the
+// Linux kernel through netlink:
+//
+//   - Interface counters come from one "RTM_GETLINK" (rtnetlink) request and
+//     the link speed from one "ETHTOOL_GSET" ioctl.
+//
+//   - WiFi station counters come from one "NL80211_CMD_GET_STATION" (nl80211)
+//     dump, which returns all the stations associated to the interface at
+//     once.
+//
+// Results are cached (per interface) during PLATFORM_METRICS_CACHE_MS
+// milliseconds, so that building a response with the metrics of many
+// neighbors only queries the kernel once.
+//
+// The cache window can be changed at build time (ex: by adding
+// "-DPLATFORM_METRICS_CACHE_MS=500" to the compiler flags) or at run time with
+// "metricsSetCacheWindow()". A value of "0" disables the cache.
+//
+#ifndef PLATFORM_METRICS_CACHE_MS
+#  define PLATFORM_METRICS_CACHE_MS  (1000)
+#endif
+
+struct interfaceMetrics
+{
+    uint32_t  tx_packets;
+    uint32_t  tx_errors;
+    uint32_t  rx_packets;
+    uint32_t  rx_errors;
+    uint32_t  speed;        // Mbit/s ("0" if unknown)
+};
+
+struct stationMetrics
+{
+    uint8_t   address[6];
+    uint32_t  tx_packets;
+    uint32_t  tx_failed;
+    uint32_t  rx_packets;
+    int8_t    signal;       // dBm
+    uint32_t  tx_bitrate;   // Mbit/s
+};
+
+// Fill 'm' with the counters of interface 'interface_name'.
+//
+// Returns "0" if there was a problem, "1" otherwise
+//
+uint8_t metricsGetInterface(char *interface_name, struct interfaceMetrics *m);
+
+// Fill 'm' with the counters of the station whose MAC address is
+// 'station_address' and which is associated to WiFi interface
+// 'interface_name'.
+//
+// Returns "0" if there was a problem (or the station is not associated), "1"
+// otherwise
+//
+uint8_t metricsGetStation(char *interface_name, uint8_t *station_address, struct stationMetrics *m);
+
+// Change the cache window (see above)
+//
+void metricsSetCacheWindow(uint32_t ms);
+
+#endif
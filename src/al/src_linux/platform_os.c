@@ -60,12 +60,14 @@
 #include <stdio.h>       // fopen(), FILE, sprintf(), fwrite()
 #include <string.h>      // memcpy(), memcmp(), ...
 #include <pthread.h>     // threads and mutex functions
-#include <mqueue.h>      // mq_*() functions
+#include <semaphore.h>   // sem_*() functions
+#include <sched.h>       // sched_yield()
 #include <errno.h>       // errno
-#include <poll.h>        // poll()
+#include <fcntl.h>       // open(), O_NONBLOCK
+#include <sys/epoll.h>   // epoll_*()
+#include <sys/timerfd.h> // timerfd_*()
 #include <sys/inotify.h> // inotify_*()
 #include <unistd.h>      // read(), sleep()
-#include <signal.h>      // struct sigevent, SIGEV_*
 #include <sys/types.h>   // recv(), setsockopt()
 #include <sys/socket.h>  // recv(), setsockopt()
 #include <linux/if_packet.h> // packet_mreq
@@ -87,6 +89,9 @@ struct linux_interface_info {
     /** @brief File descriptor of the packet socket bound to the LLDP protocol. */
     int sock_lldp_fd;
 
+    /** @brief Buffer where the next packet will be received (see handlePacket()). */
+    uint8_t *rx_message;
+
     uint8_t     al_mac_address[6];
     uint8_t     queue_id;
 };
@@ -95,21 +100,498 @@ struct linux_interface_info {
 
 // Queue related function in the PLATFORM API return queue IDs that are uint8_t
 // elements.
-// However, in POSIX all queue related functions deal with a 'mqd_t' type.
-// The following global arrays are used to store the association between a
-// "PLATFORM uint8_t ID" and a "POSIX mqd_t ID"
+// Queues are in-process ring buffers of pointers to (heap allocated) messages:
+// producers (the reactor, ALME server, ... threads) hand over the ownership
+// of a message buffer to the queue and the consumer (the AL main
+// thread) takes it from there, so messages are never copied nor sent through
+// the kernel.
+//
+// There can be many producers but only one consumer per queue:
+//
+//   - Producers reserve a slot by atomically incrementing 'head' and then
+//     publish the message pointer in it.
+//
+//   - The consumer reads slots in order starting at 'tail'. A slot which has
+//     already been reserved but not yet published contains NULL, in which case
+//     the consumer waits for a moment.
+//
+//   - Two semaphores count the number of published and free slots so that the
+//     consumer sleeps while the queue is empty and producers wait (instead of
+//     dropping messages) while it is full.
+//
+//   - The reactor thread (see below) serves all packet sockets, timers and
+//     other event sources, so it never waits for a free slot:
+//
+//       - Packet sockets that find the queue full are paused (removed from the
+//         set of descriptors "epoll_wait()" monitors) and packets stay in the
+//         kernel socket buffers. The consumer resumes them once it has made
+//         enough room in the queue.
+//
+//       - Timer, push button and topology change events that find the queue
+//         full are "deferred": they are kept in a separate list which the
+//         consumer reads before the slots. While an event is waiting there,
+//         new occurrences of that same event are merged into it.
+//
+// The number of slots can be changed at build time (ex: by adding
+// "-DPLATFORM_QUEUE_DEPTH=4096" to the compiler flags). It must be a power of
+// two.
+//
+#ifndef PLATFORM_QUEUE_DEPTH
+#  define PLATFORM_QUEUE_DEPTH  (1024)
+#endif
+
+#if (PLATFORM_QUEUE_DEPTH & (PLATFORM_QUEUE_DEPTH - 1)) != 0
+#  error "PLATFORM_QUEUE_DEPTH must be a power of two"
+#endif
 
 #define MAX_QUEUE_IDS  256  // Number of values that fit in an uint8_t
 
-static mqd_t           queues_id[MAX_QUEUE_IDS] = {[ 0 ... MAX_QUEUE_IDS-1 ] = (mqd_t) -1};
-static pthread_mutex_t queues_id_mutex          = PTHREAD_MUTEX_INITIALIZER;
+struct _reactorSource;
+
+// A message that could not be posted to a full queue (see
+// "_postOrDeferMessage()")
+//
+struct _deferredMessage
+{
+    struct _deferredMessage *next;
+
+    uint8_t                 *pending;   // Flag of the event source, set while
+                                        // the message is waiting in the list
+                                        // (NULL if events are not merged)
+    uint8_t                 *message;
+};
+
+struct _eventQueue
+{
+    uint8_t   *slots[PLATFORM_QUEUE_DEPTH];
+    uint32_t   head;        // Next slot to reserve (shared by all producers)
+    uint32_t   tail;        // Next slot to read (only used by the consumer)
+
+    sem_t      used_slots;  // Number of published messages
+    sem_t      free_slots;  // Number of slots that can be reserved
+
+    uint8_t   *last;        // Message returned by the latest call to
+                            // "PLATFORM_READ_QUEUE_NOCOPY()". It is released
+                            // on the next read.
+
+    pthread_mutex_t           mutex;          // Protects the lists below
+
+    struct _reactorSource    *paused;         // Packet sources waiting for
+    uint32_t                  paused_nr;      // room in the queue
+
+    struct _deferredMessage  *deferred_head;  // Events waiting for room in
+    struct _deferredMessage  *deferred_tail;  // the queue. They are also
+    uint32_t                  deferred_nr;    // counted in 'used_slots'.
+};
+
+static struct _eventQueue *queues[MAX_QUEUE_IDS];
+static pthread_mutex_t     queues_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Reserve one slot of queue 'q' without waiting.
+//
+// Return "1" if a slot was reserved (and must then be used with
+// "_publishMessage()" or given back with "sem_post(&q->free_slots)"), "0" if
+// the queue is full.
+//
+static uint8_t _reserveSlot(struct _eventQueue *q)
+{
+    return 0 == sem_trywait(&q->free_slots) ? 1 : 0;
+}
+
+// Hand over 'message' (which must have been obtained with "malloc()" and must
+// follow the "message format" described in the documentation of function
+// "PLATFORM_REGISTER_QUEUE_EVENT()") to queue 'q', on a slot previously
+// reserved by the caller
+//
+static void _publishMessage(struct _eventQueue *q, uint8_t *message)
+{
+    uint32_t slot;
+
+    slot = __atomic_fetch_add(&q->head, 1, __ATOMIC_RELAXED) & (PLATFORM_QUEUE_DEPTH - 1);
+    __atomic_store_n(&q->slots[slot], message, __ATOMIC_RELEASE);
+
+    sem_post(&q->used_slots);
+}
+
+// Hand over 'message' (same requirements as in "_publishMessage()") to the
+// queue whose id is 'queue_id'. From this point on the queue owns the buffer
+// (even if this function fails).
+//
+// If the queue is full, this function waits until there is room for the
+// message, thus it must never be called from the reactor thread.
+//
+// Return "0" if there was a problem, "1" otherwise
+//
+static uint8_t _postMessageToAlQueue(uint8_t queue_id, uint8_t *message)
+{
+    struct _eventQueue *q;
+
+    q = queues[queue_id];
+    if (NULL == q)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Invalid queue ID\n");
+        free(message);
+        return 0;
+    }
+
+    while (0 != sem_wait(&q->free_slots))
+    {
+        if (EINTR != errno)
+        {
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] sem_wait('%d') returned with errno=%d (%s)\n", queue_id, errno, strerror(errno));
+            free(message);
+            return 0;
+        }
+    }
+
+    _publishMessage(q, message);
+
+    return 1;
+}
+
+// Same as "sendMessageToAlQueue()", but never waits: if the queue is full the
+// message is added to the list of deferred messages of the queue instead.
+//
+// 'pending' (if not NULL) is a flag owned by the event source. It is set while
+// a deferred message of that source is waiting and, in the meantime, new
+// messages of that same source are merged into it (ie. discarded).
+//
+// Return "0" if there was a problem, "1" otherwise
+//
+static uint8_t _postOrDeferMessage(uint8_t queue_id, uint8_t *message, uint16_t message_len, uint8_t *pending)
+{
+    struct _eventQueue      *q;
+    struct _deferredMessage *d;
+    uint8_t                 *copy;
+
+    q = queues[queue_id];
+    if (NULL == q)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Invalid queue ID\n");
+        return 0;
+    }
+
+    if (NULL != pending && 1 == __atomic_load_n(pending, __ATOMIC_ACQUIRE))
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Event 0x%02x merged with a deferred one in queue '%d'\n", message[0], queue_id);
+        return 1;
+    }
+
+    copy = (uint8_t *)malloc(message_len);
+    if (NULL == copy)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Out of memory while sending a message to queue '%d'\n", queue_id);
+        return 0;
+    }
+    memcpy(copy, message, message_len);
+
+    if (1 == _reserveSlot(q))
+    {
+        _publishMessage(q, copy);
+        return 1;
+    }
+
+    d = (struct _deferredMessage *)malloc(sizeof(struct _deferredMessage));
+    if (NULL == d)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Out of memory while sending a message to queue '%d'\n", queue_id);
+        free(copy);
+        return 0;
+    }
+    d->next    = NULL;
+    d->pending = pending;
+    d->message = copy;
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Queue '%d' is full. Deferring event 0x%02x\n", queue_id, message[0]);
+
+    pthread_mutex_lock(&q->mutex);
+    if (NULL != pending)
+    {
+        __atomic_store_n(pending, 1, __ATOMIC_RELEASE);
+    }
+    if (NULL == q->deferred_tail)
+    {
+        q->deferred_head = d;
+    }
+    else
+    {
+        q->deferred_tail->next = d;
+    }
+    q->deferred_tail = d;
+    __atomic_add_fetch(&q->deferred_nr, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&q->mutex);
+
+    sem_post(&q->used_slots);
+
+    return 1;
+}
+
+// Return the oldest deferred message of queue 'q' (or NULL if there is none).
+//
+// Only to be called by the consumer of the queue, once it has taken the
+// corresponding unit from 'used_slots'.
+//
+static uint8_t *_takeDeferredMessage(struct _eventQueue *q)
+{
+    struct _deferredMessage *d;
+    uint8_t                 *message;
+
+    if (0 == __atomic_load_n(&q->deferred_nr, __ATOMIC_SEQ_CST))
+    {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&q->mutex);
+    d                = q->deferred_head;
+    q->deferred_head = d->next;
+    if (NULL == q->deferred_head)
+    {
+        q->deferred_tail = NULL;
+    }
+    if (NULL != d->pending)
+    {
+        __atomic_store_n(d->pending, 0, __ATOMIC_RELEASE);
+    }
+    __atomic_sub_fetch(&q->deferred_nr, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&q->mutex);
+
+    message = d->message;
+    free(d);
+
+    return message;
+}
+
+
+// *********** Event loop ******************************************************
+
+// All the file descriptors the platform needs to monitor (packet sockets,
+// timers, inotify watches, ...) are handled by one single thread (the
+// "reactor") which waits for activity on all of them with "epoll_wait()" and
+// then calls the handler associated to the one that became ready.
+//
+// Handlers run on the reactor thread and must never block: they just consume
+// whatever is available on their file descriptor and post the resulting
+// message to the AL queue.
+
+#define REACTOR_MAX_EVENTS  (32)  // Events retrieved on each "epoll_wait()"
+
+struct _reactorSource
+{
+    int    fd;
+    void (*handler)(struct _reactorSource *source, uint32_t events);
+    void  *data;
+
+    uint32_t                events;       // What "epoll_wait()" monitors
+
+    uint8_t                 paused;       // See "_reserveSlotOrPause()"
+    struct _reactorSource  *next_paused;
+};
+
+static int             reactor_fd   = -1;
+static pthread_once_t  reactor_once = PTHREAD_ONCE_INIT;
+
+static void *_reactorThread(void *p)
+{
+    struct epoll_event events[REACTOR_MAX_EVENTS];
+
+    while (1)
+    {
+        int i, n;
+
+        n = epoll_wait(reactor_fd, events, REACTOR_MAX_EVENTS, -1);
+        if (n < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Reactor thread* epoll_wait() returned with errno=%d (%s)\n", errno, strerror(errno));
+            break;
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            struct _reactorSource *source = (struct _reactorSource *)events[i].data.ptr;
+
+            source->handler(source, events[i].events);
+        }
+    }
+
+    PLATFORM_PRINTF_DEBUG_INFO("[PLATFORM] *Reactor thread* Exiting...\n");
+    return NULL;
+}
+
+static void _reactorInit(void)
+{
+    pthread_t thread;
+
+    reactor_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (-1 == reactor_fd)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] epoll_create1() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return;
+    }
+
+    if (0 != pthread_create(&thread, NULL, _reactorThread, NULL))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Could not create the reactor thread\n");
+        close(reactor_fd);
+        reactor_fd = -1;
+    }
+}
+
+// Start monitoring 'fd' for 'events' ("EPOLLIN", "EPOLLPRI", ...), calling
+// 'handler' from the reactor thread each time one of them happens.
+//
+// Returns the new source (to be later used with "_reactorRemove()"), or NULL
+// if there was a problem.
+//
+static struct _reactorSource *_reactorAdd(int fd, uint32_t events, void (*handler)(struct _reactorSource *, uint32_t), void *data)
+{
+    struct _reactorSource *source;
+    struct epoll_event     ev;
+
+    pthread_once(&reactor_once, _reactorInit);
+    if (-1 == reactor_fd)
+    {
+        return NULL;
+    }
+
+    source = (struct _reactorSource *)malloc(sizeof(struct _reactorSource));
+    if (NULL == source)
+    {
+        return NULL;
+    }
+    source->fd          = fd;
+    source->handler     = handler;
+    source->data        = data;
+    source->events      = events;
+    source->paused      = 0;
+    source->next_paused = NULL;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = events;
+    ev.data.ptr = source;
+
+    if (-1 == epoll_ctl(reactor_fd, EPOLL_CTL_ADD, fd, &ev))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] epoll_ctl(%d) returned with errno=%d (%s)\n", fd, errno, strerror(errno));
+        free(source);
+        return NULL;
+    }
+
+    return source;
+}
+
+// Stop monitoring a source. Its file descriptor is *not* closed.
+//
+// Only to be called from the reactor thread (ie. from a handler, which can
+// remove its own source), or right after "_reactorAdd()" by the same thread to
+// undo a registration that could not be completed.
+//
+static void _reactorRemove(struct _reactorSource *source)
+{
+    epoll_ctl(reactor_fd, EPOLL_CTL_DEL, source->fd, NULL);
+    free(source);
+}
+
+// Temporarily stop ('pause' set to "1") or restart ('pause' set to "0")
+// monitoring a source. Events that take place in between are reported once it
+// is restarted.
+//
+// Can be called from any thread.
+//
+static void _reactorPause(struct _reactorSource *source, uint8_t pause)
+{
+    struct epoll_event ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = 1 == pause ? 0 : source->events;
+    ev.data.ptr = source;
+
+    if (-1 == epoll_ctl(reactor_fd, EPOLL_CTL_MOD, source->fd, &ev))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] epoll_ctl(%d) returned with errno=%d (%s)\n", source->fd, errno, strerror(errno));
+    }
+}
+
+// Reserve one slot of queue 'q' for a packet to be received from 'source'. If
+// the queue is full, 'source' is paused until the consumer makes room (see
+// "_resumePausedSources()").
+//
+// Return "1" if a slot was reserved, "0" otherwise.
+//
+static uint8_t _reserveSlotOrPause(struct _eventQueue *q, struct _reactorSource *source)
+{
+    if (1 == _reserveSlot(q))
+    {
+        return 1;
+    }
+
+    // Announce the pause *before* checking once more, so that the consumer
+    // either frees a slot we will find now or finds 'paused_nr' set and
+    // resumes us later
+    //
+    pthread_mutex_lock(&q->mutex);
+    __atomic_add_fetch(&q->paused_nr, 1, __ATOMIC_SEQ_CST);
+
+    if (1 == _reserveSlot(q))
+    {
+        __atomic_sub_fetch(&q->paused_nr, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&q->mutex);
+        return 1;
+    }
+
+    if (1 == source->paused)
+    {
+        // Already in the list (paused sources are still reported on errors)
+        //
+        __atomic_sub_fetch(&q->paused_nr, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&q->mutex);
+        return 0;
+    }
+
+    _reactorPause(source, 1);
+    source->paused      = 1;
+    source->next_paused = q->paused;
+    q->paused           = source;
+    pthread_mutex_unlock(&q->mutex);
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Queue is full. Pausing reception on fd %d\n", source->fd);
+
+    return 0;
+}
+
+// Restart all packet sources paused by "_reserveSlotOrPause()". Called by the
+// consumer of queue 'q' once there is enough room in it.
+//
+static void _resumePausedSources(struct _eventQueue *q)
+{
+    struct _reactorSource *source;
+
+    pthread_mutex_lock(&q->mutex);
+    while (NULL != (source = q->paused))
+    {
+        q->paused           = source->next_paused;
+        source->paused      = 0;
+        source->next_paused = NULL;
+
+        _reactorPause(source, 0);
+        __atomic_sub_fetch(&q->paused_nr, 1, __ATOMIC_SEQ_CST);
+    }
+    pthread_mutex_unlock(&q->mutex);
+}
 
 
 // *********** Receiving packets ********************************************
 
-static void handlePacket(uint8_t queue_id, const uint8_t *packet, size_t packet_len, mac_address interface_mac_address)
+// 'message' is a MAX_NETWORK_SEGMENT_SIZE+9 bytes long buffer (obtained with
+// "malloc()") where the packet has already been received starting at offset
+// '9'. This function fills the header and hands it over to queue 'q', on the
+// slot the caller has already reserved.
+//
+static void handlePacket(struct _eventQueue *q, uint8_t *message, size_t packet_len, mac_address interface_mac_address)
 {
-    uint8_t   message[9+MAX_NETWORK_SEGMENT_SIZE];
     uint16_t  message_len;
     uint8_t   message_len_msb;
     uint8_t   message_len_lsb;
@@ -118,7 +600,9 @@ static void handlePacket(uint8_t queue_id, const uint8_t *packet, size_t packet_
     {
         // This should never happen
         //
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Recv thread* Captured packet too big\n");
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Packet handler* Captured packet too big\n");
+        free(message);
+        sem_post(&q->free_slots);
         return;
     }
 
@@ -139,41 +623,28 @@ static void handlePacket(uint8_t queue_id, const uint8_t *packet, size_t packet_
     message[1] = message_len_msb;
     message[2] = message_len_lsb;
     memcpy(&message[3], interface_mac_address, 6);
-    memcpy(&message[9], packet, packet_len);
 
     // Now simply send the message.
     //
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Recv thread* Sending %d bytes to queue (0x%02x, 0x%02x, 0x%02x, ...)\n", 3+message_len, message[0], message[1], message[2]);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Packet handler* Sending %d bytes to queue (0x%02x, 0x%02x, 0x%02x, ...)\n", 3+message_len, message[0], message[1], message[2]);
 
-    if (0 == sendMessageToAlQueue(queue_id, message, 3 + message_len))
-    {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Receive thread* Error sending message to queue\n");
-        return;
-    }
+    _publishMessage(q, message);
 
     return;
 }
 
-static void *recvLoopThread(void *p)
+// Open (and configure) the two packet sockets of 'interface'
+//
+// Returns "0" if there was a problem, "1" otherwise
+//
+static uint8_t _openInterfaceSockets(struct linux_interface_info *interface)
 {
-    struct linux_interface_info *interface = (struct linux_interface_info *)p;
-
     struct packet_mreq multicast_request;
 
-    if (NULL == p)
-    {
-        // 'p' must point to a valid 'struct linux_interface_info'
-        //
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Recv thread* Invalid arguments in recvLoopThread()\n");
-
-        return NULL;
-    }
-
     interface->ifindex = getIfIndex(interface->interface.name);
     if (-1 == interface->ifindex)
     {
-        free(interface);
-        return NULL;
+        return 0;
     }
 
     memset(&multicast_request, 0, sizeof(multicast_request));
@@ -185,8 +656,7 @@ static void *recvLoopThread(void *p)
     {
         PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] socket('%s' protocol 1905) returned with errno=%d (%s) while opening a RAW socket\n",
                                     interface->interface.name, errno, strerror(errno));
-        free(interface);
-        return NULL;
+        return 0;
     }
 
     /* Add the AL address to this interface */
@@ -214,8 +684,7 @@ static void *recvLoopThread(void *p)
         PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] socket('%s' protocol 1905) returned with errno=%d (%s) while opening a RAW socket\n",
                                     interface->interface.name, errno, strerror(errno));
         close(interface->sock_1905_fd);
-        free(interface);
-        return NULL;
+        return 0;
     }
 
     /* Add the LLDP multicast address to this interface */
@@ -227,91 +696,91 @@ static void *recvLoopThread(void *p)
                                     interface->interface.name, errno, strerror(errno));
     }
 
+    return 1;
+}
 
-    PLATFORM_PRINTF_DEBUG_DETAIL("Starting recv on %s\n", interface->interface.name);
-    /** @todo move to libevent instead of threads + poll */
-    while(1)
-    {
-        struct pollfd fdset[2];
-        size_t i;
+// Reactor handler for both packet sockets of an interface
+//
+static void _packetHandler(struct _reactorSource *source, uint32_t events)
+{
+    struct linux_interface_info *interface = (struct linux_interface_info *)source->data;
+    struct _eventQueue          *q         = queues[interface->queue_id];
 
-        memset((void*)fdset, 0, sizeof(fdset));
+    ssize_t recv_length;
 
-        fdset[0].fd = interface->sock_1905_fd;
-        fdset[0].events = POLLIN;
-        fdset[1].fd = interface->sock_lldp_fd;
-        fdset[1].events = POLLIN;
-        if (0 > poll(fdset, 2, -1))
+    // Packets are received directly into the buffer that will be handed over
+    // to the AL queue
+    //
+    if (NULL == interface->rx_message)
+    {
+        interface->rx_message = (uint8_t *)malloc(9+MAX_NETWORK_SEGMENT_SIZE);
+        if (NULL == interface->rx_message)
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Interface %s receive thread* poll() returned with errno=%d (%s)\n",
-                                        interface->interface.name, errno, strerror(errno));
-            break;
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Interface %s* Out of memory\n", interface->interface.name);
+            return;
         }
+    }
 
-        for (i = 0; i < ARRAY_SIZE(fdset); i++)
+    // Never block the reactor thread on a full queue. Leave the packet in the
+    // socket instead (and stop listening on it until there is room)
+    //
+    if (0 == _reserveSlotOrPause(q, source))
+    {
+        return;
+    }
+
+    recv_length = recv(source->fd, &interface->rx_message[9], MAX_NETWORK_SEGMENT_SIZE, MSG_DONTWAIT);
+    if (recv_length < 0)
+    {
+        sem_post(&q->free_slots);
+
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
         {
-            if (fdset[i].revents & (POLLIN|POLLERR))
-            {
-                uint8_t packet[MAX_NETWORK_SEGMENT_SIZE];
-                ssize_t recv_length;
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Interface %s* recv failed with errno=%d (%s) \n",
+                                        interface->interface.name, errno, strerror(errno));
 
-                recv_length = recv(fdset[i].fd, packet, sizeof(packet), MSG_DONTWAIT);
-                if (recv_length < 0)
-                {
-                    if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
-                    {
-                        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Interface %s receive thread* recv failed with errno=%d (%s) \n",
-                                                    interface->interface.name, errno, strerror(errno));
-                        /* Probably not recoverable. */
-                        close(interface->sock_1905_fd);
-                        close(interface->sock_lldp_fd);
-                        free(interface);
-                        return NULL;
-                    }
-                }
-                else
-                {
-                    handlePacket(interface->queue_id, packet, (size_t)recv_length, interface->interface.addr);
-                }
-            }
+            // Probably not recoverable: stop listening on this socket.
+            //
+            close(source->fd);
+            _reactorRemove(source);
         }
+        return;
     }
 
-    // Unreachable
-    PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Recv thread* Exiting thread (interface %s)\n", interface->interface.name);
-    close(interface->sock_1905_fd);
-    close(interface->sock_lldp_fd);
-    free(interface);
-    return NULL;
+    handlePacket(q, interface->rx_message, (size_t)recv_length, interface->interface.addr);
+    interface->rx_message = NULL;
 }
 
 // *********** Timers stuff ****************************************************
 
-// We use the POSIX timers API to implement PLATFORM timers
+// We use Linux "timerfd" file descriptors to implement PLATFORM timers
 // It works like this:
 //
 //   - When the PLATFORM API user calls "PLATFORM_REGISTER_QUEUE_EVENT()" with
-//     'PLATFORM_QUEUE_EVENT_TIMEOUT*', a new POSIX timer is created.
+//     'PLATFORM_QUEUE_EVENT_TIMEOUT*', a new "timerfd" is created and added to
+//     the reactor.
 //
-//   - When the timer expires, the POSIX API creates a thread for us and makes
-//     it run function '_timerHandler()'
+//   - When the timer expires, its file descriptor becomes readable and the
+//     reactor thread runs function '_timerHandler()'
 //
-//   - '_timerHandler()' simply deletes (or reprograms, depending on the type
+//   - '_timerHandler()' simply deletes (or leaves armed, depending on the type
 //     of timer) the timer and sends a message to a queue so that the user can
 //     later be aware of the timer expiration with a call to
 //     "PLATFORM_QUEUE_READ()"
 
-struct _timerHandlerThreadData
+struct _timerHandlerData
 {
     uint8_t    queue_id;
     uint32_t   token;
     uint8_t    periodic;
-    timer_t  timer_id;
+    uint8_t    pending;     // See "_postOrDeferMessage()"
 };
 
-static void _timerHandler(union sigval s)
+static void _timerHandler(struct _reactorSource *source, uint32_t events)
 {
-    struct _timerHandlerThreadData *aux;
+    struct _timerHandlerData *aux;
+
+    uint64_t  expirations;
 
     uint8_t   message[3+4];
     uint16_t  packet_len;
@@ -322,7 +791,14 @@ static void _timerHandler(union sigval s)
     uint8_t   token_3rd_msb;
     uint8_t   token_lsb;
 
-    aux = (struct _timerHandlerThreadData *)s.sival_ptr;
+    aux = (struct _timerHandlerData *)source->data;
+
+    // Consume the expiration, or else the file descriptor will remain readable
+    //
+    if (sizeof(expirations) != read(source->fd, &expirations, sizeof(expirations)))
+    {
+        return;
+    }
 
     // In order to build the message that will be inserted into the queue, we
     // need to follow the "message format" defines in the documentation of
@@ -358,7 +834,10 @@ static void _timerHandler(union sigval s)
 
     PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Timer handler* Sending %d bytes to queue (%02x, %02x, %02x, ...)\n", 3+packet_len, message[0], message[1], message[2]);
 
-    if (0 == sendMessageToAlQueue(aux->queue_id, message, 3+packet_len))
+    // One-shot timers free 'aux' right below, so their (single) expiration is
+    // never merged with anything
+    //
+    if (0 == _postOrDeferMessage(aux->queue_id, message, 3+packet_len, 1 == aux->periodic ? &aux->pending : NULL))
     {
         PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Timer handler* Error sending message to queue from _timerHandler()\n");
     }
@@ -370,12 +849,11 @@ static void _timerHandler(union sigval s)
     }
     else
     {
-        // Delete the asociater timer
-        //
-        timer_delete(aux->timer_id);
-
-        // Free 'struct _timerHandlerThreadData', as we don't need it any more
+        // Delete the asociated timer and free 'struct _timerHandlerData', as
+        // we don't need them any more
         //
+        close(source->fd);
+        _reactorRemove(source);
         free(aux);
     }
 
@@ -399,19 +877,76 @@ static void _timerHandler(union sigval s)
 //
 #define PUSH_BUTTON_GPIO_NUMBER              "disable" //"26"
 
-#define PUSH_BUTTON_GPIO_EXPORT_FILENAME     "/sys/class/gpio/export"
-#define PUSH_BUTTON_GPIO_DIRECTION_FILENAME  "/sys/class/gpio/gpio"PUSH_BUTTON_GPIO_NUMBER"/direction"
-#define PUSH_BUTTON_GPIO_VALUE_FILENAME      "/sys/class/gpio/gpio"PUSH_BUTTON_GPIO_NUMBER"/direction"
+#define PUSH_BUTTON_GPIO_EXPORT_FILENAME     "/sys/class/gpio/export"
+#define PUSH_BUTTON_GPIO_DIRECTION_FILENAME  "/sys/class/gpio/gpio"PUSH_BUTTON_GPIO_NUMBER"/direction"
+#define PUSH_BUTTON_GPIO_VALUE_FILENAME      "/sys/class/gpio/gpio"PUSH_BUTTON_GPIO_NUMBER"/direction"
+
+// The only information that the handlers need is the "queue id" to later post
+// messages to the queue, and the GPIO file descriptor (if any).
+//
+struct _pushButtonData
+{
+    uint8_t     queue_id;
+    int         fdraw_gpio;
+    uint8_t     pending;        // See "_postOrDeferMessage()"
+};
+
+static void _pushButtonPressed(struct _pushButtonData *data)
+{
+    uint8_t   message[3];
+
+    message[0] = PLATFORM_QUEUE_EVENT_PUSH_BUTTON;
+    message[1] = 0x0;
+    message[2] = 0x0;
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button* Sending 3 bytes to queue (0x%02x, 0x%02x, 0x%02x)\n", message[0], message[1], message[2]);
+
+    if (0 == _postOrDeferMessage(data->queue_id, message, 3, &data->pending))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error sending message to queue from _pushButtonPressed()\n");
+    }
+}
+
+// Reactor handler for the "tmp" file inotify watch ("changes" are caused by
+// "attribute" changes -such as the timestamp-)
+//
+static void _pushButtonVirtualHandler(struct _reactorSource *source, uint32_t events)
+{
+    struct inotify_event event;
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button* Virtual button has been pressed!\n");
+
+    // We must "read()" from the "tmp" fd to "consume" the event, or else it
+    // will keep being reported as readable.
+    //
+    read(source->fd, &event, sizeof(event));
+
+    _pushButtonPressed((struct _pushButtonData *)source->data);
+}
 
-// The only information that needs to be sent to the new thread is the "queue
-// id" to later post messages to the queue.
+// Reactor handler for the GPIO ("changes" are caused by a value change in the
+// GPIO value)
 //
-struct _pushButtonThreadData
+static void _pushButtonGpioHandler(struct _reactorSource *source, uint32_t events)
 {
-    uint8_t     queue_id;
-};
+    char buf[3];
+
+    if (-1 == read(source->fd, buf, 3))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* read() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return;
+    }
+
+    if (buf[0] == '1')
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button* Physical button has been pressed!\n");
+        _pushButtonPressed((struct _pushButtonData *)source->data);
+    }
+}
 
-static void *_pushButtonThread(void *p)
+// Returns "0" if there was a problem, "1" otherwise
+//
+static uint8_t _pushButtonStart(uint8_t queue_id)
 {
     // In this implementation we will send the "push button" configuration
     // event message to the queue when either:
@@ -426,29 +961,35 @@ static void *_pushButtonThread(void *p)
     //      This is useful for debugging and for supporting the "push button"
     //      mechanism in those platforms without a physical button.
     //
-    // This thread will simply wait for activity on any of those two file
-    // descriptors and then send the "push button" configuration event to the
-    // AL queue.
+    // The reactor will simply wait for activity on any of those two file
+    // descriptors and then the handlers will send the "push button"
+    // configuration event to the AL queue.
     // How is this done?
     //
     //   1. Configure the GPIO as input.
     //   2. Create an "inotify" watch on the tmp file.
-    //   3. Use "poll()" to wait for either changes in the value of the GPIO or
-    //      timestamp updates in the tmp file.
+    //   3. Add both file descriptors to the reactor to wait for either changes
+    //      in the value of the GPIO or timestamp updates in the tmp file.
 
     int    gpio_enabled;
 
     FILE  *fd_gpio;
     FILE  *fd_tmp;
 
-    int  fdraw_gpio;
     int  fdraw_tmp;
 
-    struct pollfd fdset[2];
-
-    uint8_t queue_id;
+    struct _pushButtonData *data;
 
-    queue_id = ((struct _pushButtonThreadData *)p)->queue_id;;
+    data = (struct _pushButtonData *)malloc(sizeof(struct _pushButtonData));
+    if (NULL == data)
+    {
+        // Out of memory
+        //
+        return 0;
+    }
+    data->queue_id   = queue_id;
+    data->fdraw_gpio = -1;
+    data->pending    = 0;
 
     if (0 != strcmp(PUSH_BUTTON_GPIO_NUMBER, "disable"))
     {
@@ -472,14 +1013,16 @@ static void *_pushButtonThread(void *p)
         //
         if (NULL == (fd_gpio = fopen(PUSH_BUTTON_GPIO_EXPORT_FILENAME, "w")))
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_EXPORT_FILENAME);
-            return NULL;
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_EXPORT_FILENAME);
+            free(data);
+            return 0;
         }
         if (0 == fwrite(PUSH_BUTTON_GPIO_NUMBER, 1, strlen(PUSH_BUTTON_GPIO_NUMBER), fd_gpio))
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error writing '"PUSH_BUTTON_GPIO_NUMBER"' to %s\n", PUSH_BUTTON_GPIO_EXPORT_FILENAME);
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error writing '"PUSH_BUTTON_GPIO_NUMBER"' to %s\n", PUSH_BUTTON_GPIO_EXPORT_FILENAME);
             fclose(fd_gpio);
-            return NULL;
+            free(data);
+            return 0;
         }
         fclose(fd_gpio);
 
@@ -489,14 +1032,16 @@ static void *_pushButtonThread(void *p)
 
         if (NULL == (fd_gpio = fopen(PUSH_BUTTON_GPIO_DIRECTION_FILENAME, "w")))
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_DIRECTION_FILENAME);
-            return NULL;
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_DIRECTION_FILENAME);
+            free(data);
+            return 0;
         }
         if (0 == fwrite("in", 1, strlen("in"), fd_gpio))
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error writing 'in' to %s\n", PUSH_BUTTON_GPIO_DIRECTION_FILENAME);
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error writing 'in' to %s\n", PUSH_BUTTON_GPIO_DIRECTION_FILENAME);
             fclose(fd_gpio);
-            return NULL;
+            free(data);
+            return 0;
         }
         fclose(fd_gpio);
     }
@@ -506,9 +1051,14 @@ static void *_pushButtonThread(void *p)
     //
     if (gpio_enabled)
     {
-        if (-1  == (fdraw_gpio = open(PUSH_BUTTON_GPIO_VALUE_FILENAME, O_RDONLY | O_NONBLOCK)))
+        if (-1  == (data->fdraw_gpio = open(PUSH_BUTTON_GPIO_VALUE_FILENAME, O_RDONLY | O_NONBLOCK)))
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_VALUE_FILENAME);
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_VALUE_FILENAME);
+        }
+        else if (NULL == _reactorAdd(data->fdraw_gpio, EPOLLPRI, _pushButtonGpioHandler, data))
+        {
+            close(data->fdraw_gpio);
+            data->fdraw_gpio = -1;
         }
     }
 
@@ -517,117 +1067,35 @@ static void *_pushButtonThread(void *p)
     //
     if (NULL == (fd_tmp = fopen(PUSH_BUTTON_VIRTUAL_FILENAME, "w+")))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Could not create tmp file %s\n", PUSH_BUTTON_VIRTUAL_FILENAME);
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Could not create tmp file %s\n", PUSH_BUTTON_VIRTUAL_FILENAME);
+        return 0;
     }
     fclose(fd_tmp);
 
     // ...and then add a "watch" that triggers when its timestamp changes (ie.
     // when someone does a "touch" of the file or writes to it, for example).
     //
-    if (-1 == (fdraw_tmp = inotify_init()))
+    if (-1 == (fdraw_tmp = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* inotify_init() returned with errno=%d (%s)\n", errno, strerror(errno));
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* inotify_init() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return 0;
     }
     if (-1 == inotify_add_watch(fdraw_tmp, PUSH_BUTTON_VIRTUAL_FILENAME, IN_ATTRIB))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* inotify_add_watch() returned with errno=%d (%s)\n", errno, strerror(errno));
-        return NULL;
-    }
-
-    // At this point we have two file descriptors ("fdraw_gpio" and "fdraw_tmp")
-    // that we can monitor with a call to "poll()"
-    //
-    while(1)
-    {
-        int   nfds;
-        uint8_t button_pressed;
-
-        memset((void*)fdset, 0, sizeof(fdset));
-
-        fdset[0].fd     = fdraw_tmp;
-        fdset[0].events = POLLIN;
-        nfds            = 1;
-
-        if (gpio_enabled)
-        {
-            fdset[1].fd     = fdraw_gpio;
-            fdset[1].events = POLLPRI;
-            nfds            = 2;
-        }
-
-        // The thread will block here (forever, timeout = -1), until there is
-        // a change in one of the two file descriptors ("changes" in the "tmp"
-        // file fd are cause by "attribute" changes -such as the timestamp-,
-        // while "changes" in the GPIO fd are caused by a value change in the
-        // GPIO value).
-        //
-        if (0 > poll(fdset, nfds, -1))
-        {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* poll() returned with errno=%d (%s)\n", errno, strerror(errno));
-            break;
-        }
-
-        button_pressed = 0;
-
-        if (fdset[0].revents & POLLIN)
-        {
-            struct inotify_event event;
-
-            PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button thread* Virtual button has been pressed!\n");
-            button_pressed = 1;
-
-            // We must "read()" from the "tmp" fd to "consume" the event, or
-            // else the next call to "poll() won't block.
-            //
-            read(fdraw_tmp, &event, sizeof(event));
-        }
-        else if (gpio_enabled && (fdset[1].revents & POLLPRI))
-        {
-            char buf[3];
-
-            if (-1 == read(fdset[1].fd, buf, 3))
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* read() returned with errno=%d (%s)\n", errno, strerror(errno));
-                continue;
-            }
-
-            if (buf[0] == '1')
-            {
-                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button thread* Physical button has been pressed!\n");
-                button_pressed = 1;
-            }
-        }
-
-        if (1 == button_pressed)
-        {
-            uint8_t   message[3];
-
-            message[0] = PLATFORM_QUEUE_EVENT_PUSH_BUTTON;
-            message[1] = 0x0;
-            message[2] = 0x0;
-
-            PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button thread* Sending 3 bytes to queue (0x%02x, 0x%02x, 0x%02x)\n", message[0], message[1], message[2]);
-
-            if (0 == sendMessageToAlQueue(queue_id, message, 3))
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error sending message to queue from _pushButtonThread()\n");
-            }
-        }
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* inotify_add_watch() returned with errno=%d (%s)\n", errno, strerror(errno));
+        close(fdraw_tmp);
+        return 0;
     }
-
-    // Close file descriptors and exit
-    //
-    if (gpio_enabled)
+    if (NULL == _reactorAdd(fdraw_tmp, EPOLLIN, _pushButtonVirtualHandler, data))
     {
-        fclose(fd_gpio);
+        close(fdraw_tmp);
+        return 0;
     }
 
-    PLATFORM_PRINTF_DEBUG_INFO("[PLATFORM] *Push button thread* Exiting...\n");
+    // NOTE:
+    //   'data' is never released (it is used until the application exits).
 
-    free(p);
-    return NULL;
+    return 1;
 }
 
 // *********** Topology change notification stuff ******************************
@@ -637,114 +1105,197 @@ static void *_pushButtonThread(void *p)
 //
 #define TOPOLOGY_CHANGE_NOTIFICATION_FILENAME  "/tmp/topology_change"
 
-// The only information that needs to be sent to the new thread is the "queue
-// id" to later post messages to the queue.
+// The only information that the handler needs is the "queue id" to later post
+// messages to the queue.
 //
-struct _topologyMonitorThreadData
+struct _topologyMonitorData
 {
     uint8_t     queue_id;
+    uint8_t     pending;        // See "_postOrDeferMessage()"
 };
 
-static void *_topologyMonitorThread(void *p)
+static void _topologyMonitorHandler(struct _reactorSource *source, uint32_t events)
 {
-    FILE  *fd_tmp;
+    struct inotify_event event;
 
-    int  fdraw_tmp;
+    uint8_t  message[3];
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Topology change monitor* Virtual notification has been activated!\n");
+
+    // We must "read()" from the "tmp" fd to "consume" the event, or else it
+    // will keep being reported as readable.
+    //
+    read(source->fd, &event, sizeof(event));
+
+    message[0] = PLATFORM_QUEUE_EVENT_TOPOLOGY_CHANGE_NOTIFICATION;
+    message[1] = 0x0;
+    message[2] = 0x0;
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Topology change monitor* Sending 3 bytes to queue (0x%02x, 0x%02x, 0x%02x)\n", message[0], message[1], message[2]);
+
+    if (0 == _postOrDeferMessage(((struct _topologyMonitorData *)source->data)->queue_id, message, 3, &((struct _topologyMonitorData *)source->data)->pending))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* Error sending message to queue from _topologyMonitorHandler()\n");
+    }
+}
 
-    struct pollfd fdset[2];
+// Returns "0" if there was a problem, "1" otherwise
+//
+static uint8_t _topologyMonitorStart(uint8_t queue_id)
+{
+    FILE  *fd_tmp;
 
-    uint8_t  queue_id;
+    int  fdraw_tmp;
 
-    queue_id = ((struct _topologyMonitorThreadData *)p)->queue_id;
+    struct _topologyMonitorData *data;
 
     // Regarding the "virtual" notification system, first create the "tmp" file
     // in case it does not already exist...
     //
     if (NULL == (fd_tmp = fopen(TOPOLOGY_CHANGE_NOTIFICATION_FILENAME, "w+")))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor thread* Could not create tmp file %s\n", TOPOLOGY_CHANGE_NOTIFICATION_FILENAME);
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* Could not create tmp file %s\n", TOPOLOGY_CHANGE_NOTIFICATION_FILENAME);
+        return 0;
     }
     fclose(fd_tmp);
 
     // ...and then add a "watch" that triggers when its timestamp changes (ie.
     // when someone does a "touch" of the file or writes to it, for example).
     //
-    if (-1 == (fdraw_tmp = inotify_init()))
+    if (-1 == (fdraw_tmp = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* inotify_init() returned with errno=%d (%s)\n", errno, strerror(errno));
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* inotify_init() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return 0;
     }
     if (-1 == inotify_add_watch(fdraw_tmp, TOPOLOGY_CHANGE_NOTIFICATION_FILENAME, IN_ATTRIB))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* inotify_add_watch() returned with errno=%d (%s)\n", errno, strerror(errno));
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* inotify_add_watch() returned with errno=%d (%s)\n", errno, strerror(errno));
+        close(fdraw_tmp);
+        return 0;
     }
 
-    while (1)
+    // TODO: Other fd's to detect topoly changes would be added to the reactor
+    // here. One good idea would be to use a NETLINK socket that is notified by
+    // the Linux kernel when network "stuff" (routes, IPs, ...) change.
+
+    data = (struct _topologyMonitorData *)malloc(sizeof(struct _topologyMonitorData));
+    if (NULL == data)
+    {
+        close(fdraw_tmp);
+        return 0;
+    }
+    data->queue_id = queue_id;
+    data->pending  = 0;
+
+    if (NULL == _reactorAdd(fdraw_tmp, EPOLLIN, _topologyMonitorHandler, data))
     {
-        int   nfds;
-        uint8_t notification_activated;
+        close(fdraw_tmp);
+        free(data);
+        return 0;
+    }
 
-        memset((void*)fdset, 0, sizeof(fdset));
+    return 1;
+}
 
-        fdset[0].fd     = fdraw_tmp;
-        fdset[0].events = POLLIN;
-        nfds            = 1;
 
-        // TODO: Other fd's to detect topoly changes would be initialized here.
-        // One good idea would be to use a NETLINK socket that is notified by
-        // the Linux kernel when network "stuff" (routes, IPs, ...) change.
-        //
-        //fdset[0].fd     = ...;
-        //fdset[0].events = POLLIN;
-        //nfds            = 2;
+// *********** Background work *************************************************
 
-        // The thread will block here (forever, timeout = -1), until there is
-        // a change in one of the previous file descriptors .
-        //
-        if (0 > poll(fdset, nfds, -1))
-        {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor thread* poll() returned with errno=%d (%s)\n", errno, strerror(errno));
-            break;
-        }
+// Works handed over with "PLATFORM_RUN_IN_BACKGROUND()" are kept in a FIFO list
+// from which a small pool of worker threads (created the first time a work is
+// submitted) takes them. Once a work has finished, the worker posts the
+// "PLATFORM_QUEUE_EVENT_WORK_DONE" message to the queue of the submitter.
+//
+// The number of workers can be changed at build time (ex: by adding
+// "-DPLATFORM_WORKER_THREADS=4" to the compiler flags).
+//
+#ifndef PLATFORM_WORKER_THREADS
+#  define PLATFORM_WORKER_THREADS  (2)
+#endif
+
+struct _backgroundWork
+{
+    uint8_t                   queue_id;
+    void                    (*work)(void *data);
+    struct eventWorkDone      result;
+
+    struct _backgroundWork   *next;
+};
 
-        notification_activated = 0;
+static struct
+{
+    pthread_mutex_t           mutex;
+    pthread_cond_t            cond;
+
+    struct _backgroundWork   *head;
+    struct _backgroundWork   *tail;
+
+    uint8_t                   workers_nr;  // Threads successfully created
+
+} background = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL, 0};
+
+static pthread_once_t background_once = PTHREAD_ONCE_INIT;
+
+static void *_workerThread(void *p)
+{
+    while (1)
+    {
+        struct _backgroundWork *w;
+        uint8_t                *message;
 
-        if (fdset[0].revents & POLLIN)
+        pthread_mutex_lock(&background.mutex);
+        while (NULL == background.head)
+        {
+            pthread_cond_wait(&background.cond, &background.mutex);
+        }
+        w               = background.head;
+        background.head = w->next;
+        if (NULL == background.head)
         {
-            struct inotify_event event;
+            background.tail = NULL;
+        }
+        pthread_mutex_unlock(&background.mutex);
 
-            PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Topology change monitor thread* Virtual notification has been activated!\n");
-            notification_activated = 1;
+        w->work(w->result.data);
 
-            // We must "read()" from the "tmp" fd to "consume" the event, or
-            // else the next call to "poll() won't block.
+        message = (uint8_t *)malloc(3 + sizeof(struct eventWorkDone));
+        if (NULL == message)
+        {
+            // The submitter will never know... but there is nothing else we
+            // can do
             //
-            read(fdraw_tmp, &event, sizeof(event));
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Worker thread* Out of memory while sending a message to queue '%d'\n", w->queue_id);
+            free(w);
+            continue;
         }
+        message[0] = PLATFORM_QUEUE_EVENT_WORK_DONE;
+        message[1] = 0x00;
+        message[2] = sizeof(struct eventWorkDone);
+        memcpy(&message[3], &w->result, sizeof(struct eventWorkDone));
 
-        if (1 == notification_activated)
-        {
-            uint8_t  message[3];
+        _postMessageToAlQueue(w->queue_id, message);
+
+        free(w);
+    }
 
-            message[0] = PLATFORM_QUEUE_EVENT_TOPOLOGY_CHANGE_NOTIFICATION;
-            message[1] = 0x0;
-            message[2] = 0x0;
+    return NULL;
+}
 
-            PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Topology change monitor thread* Sending 3 bytes to queue (0x%02x, 0x%02x, 0x%02x)\n", message[0], message[1], message[2]);
+static void _backgroundInit(void)
+{
+    uint8_t i;
 
-            if (0 == sendMessageToAlQueue(queue_id, message, 3))
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor thread* Error sending message to queue from _pushButtonThread()\n");
-            }
+    for (i=0; i<PLATFORM_WORKER_THREADS; i++)
+    {
+        pthread_t thread;
+
+        if (0 != pthread_create(&thread, NULL, _workerThread, NULL))
+        {
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Could not create worker thread #%d\n", i);
+            break;
         }
+        pthread_detach(thread);
+        background.workers_nr++;
     }
-
-    PLATFORM_PRINTF_DEBUG_INFO("[PLATFORM] *Topology change monitor thread* Exiting...\n");
-
-    free(p);
-    return NULL;
 }
 
 
@@ -755,14 +1306,7 @@ static void *_topologyMonitorThread(void *p)
 
 uint8_t sendMessageToAlQueue(uint8_t queue_id, uint8_t *message, uint16_t message_len)
 {
-    mqd_t   mqdes;
-
-    mqdes = queues_id[queue_id];
-    if ((mqd_t) -1 == mqdes)
-    {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Invalid queue ID\n");
-        return 0;
-    }
+    uint8_t *copy;
 
     if (NULL == message)
     {
@@ -770,13 +1314,15 @@ uint8_t sendMessageToAlQueue(uint8_t queue_id, uint8_t *message, uint16_t messag
         return 0;
     }
 
-    if (0 !=  mq_send(mqdes, (const char *)message, message_len, 0))
+    copy = (uint8_t *)malloc(message_len);
+    if (NULL == copy)
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] mq_send('%d') returned with errno=%d (%s)\n", queue_id, errno, strerror(errno));
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Out of memory while sending a message to queue '%d'\n", queue_id);
         return 0;
     }
+    memcpy(copy, message, message_len);
 
-    return 1;
+    return _postMessageToAlQueue(queue_id, copy);
 }
 
 
@@ -809,16 +1355,14 @@ struct deviceInfo *PLATFORM_GET_DEVICE_INFO(void)
 
 uint8_t PLATFORM_CREATE_QUEUE(const char *name)
 {
-    mqd_t          mqdes;
-    struct mq_attr attr;
-    int            i;
-    char           name_tmp[20];
+    struct _eventQueue *q;
+    int                 i;
 
-    pthread_mutex_lock(&queues_id_mutex);
+    pthread_mutex_lock(&queues_mutex);
 
     for (i=1; i<MAX_QUEUE_IDS; i++)  // Note: "0" is not a valid "queue_id"
     {                                // according to the documentation of
-        if (-1 == queues_id[i])      // "PLATFORM_CREATE_QUEUE()". That's why we
+        if (NULL == queues[i])       // "PLATFORM_CREATE_QUEUE()". That's why we
         {                            // skip it
             // Empty slot found.
             //
@@ -829,48 +1373,35 @@ uint8_t PLATFORM_CREATE_QUEUE(const char *name)
     {
         // No more queue id slots available
         //
-        pthread_mutex_unlock(&queues_id_mutex);
+        pthread_mutex_unlock(&queues_mutex);
         return 0;
     }
 
-    if (!name)
-    {
-        name_tmp[0] = 0x0;
-        sprintf(name_tmp, "/queue_%03d", i);
-        name = name_tmp;
-    }
-    else if (name[0] != '/')
+    q = (struct _eventQueue *)calloc(1, sizeof(struct _eventQueue));
+    if (NULL == q)
     {
-        snprintf(name_tmp, 20, "/%s", name);
-        name = name_tmp;
+        pthread_mutex_unlock(&queues_mutex);
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Out of memory while creating queue '%s'\n", NULL == name ? "" : name);
+        return 0;
     }
 
-    // If a queue with this name already existed (maybe from a previous
-    // session), destroy and re-create it
-    //
-    mq_unlink(name);
-
-    attr.mq_flags   = 0;
-    attr.mq_maxmsg  = 100;
-    attr.mq_curmsgs = 0;
-    attr.mq_msgsize = MAX_NETWORK_SEGMENT_SIZE+3;
-      //
-      // NOTE: The biggest value in the queue is going to be a message from the
-      // "new packet" event, which is MAX_NETWORK_SEGMENT_SIZE+3 bytes long.
-      // The "PLATFORM_CREATE_QUEUE()" documentation mentions
+    pthread_mutex_init(&q->mutex, NULL);
 
-    if ((mqd_t) -1 == (mqdes = mq_open(name, O_RDWR | O_CREAT, 0666, &attr)))
+    if (0 != sem_init(&q->used_slots, 0, 0) || 0 != sem_init(&q->free_slots, 0, PLATFORM_QUEUE_DEPTH))
     {
         // Could not create queue
         //
-        pthread_mutex_unlock(&queues_id_mutex);
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] mq_open('%s') returned with errno=%d (%s)\n", name, errno, strerror(errno));
+        pthread_mutex_unlock(&queues_mutex);
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] sem_init('%s') returned with errno=%d (%s)\n", NULL == name ? "" : name, errno, strerror(errno));
+        free(q);
         return 0;
     }
 
-    queues_id[i] = mqdes;
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Queue '%s' created with id %d (%d slots)\n", NULL == name ? "" : name, i, PLATFORM_QUEUE_DEPTH);
+
+    queues[i] = q;
 
-    pthread_mutex_unlock(&queues_id_mutex);
+    pthread_mutex_unlock(&queues_mutex);
     return i;
 }
 
@@ -880,9 +1411,9 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
     {
         case PLATFORM_QUEUE_EVENT_NEW_1905_PACKET:
         {
-            pthread_t                         thread;
             struct event1905Packet           *p1;
             struct linux_interface_info      *interface;
+            struct _reactorSource            *source_1905;
 
             if (NULL == data)
             {
@@ -903,14 +1434,36 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
 
             interface->queue_id              = queue_id;
             interface->interface.name        = strdup(p1->interface_name);
+            interface->rx_message            = NULL;
             memcpy(interface->interface.addr,         p1->interface_mac_address, 6);
             memcpy(interface->al_mac_address,         p1->al_mac_address,        6);
 
-            pthread_create(&thread, NULL, recvLoopThread, (void *)interface);
-
-            /** @todo This is a horrible hack to make sure the addresses are configured on the interfaces before we
-             * start sending raw packets. */
-            usleep(30000);
+            // Sockets are opened (and addresses configured on them) right now,
+            // so that they are ready before we start sending raw packets.
+            // Packets are then received by the reactor thread.
+            //
+            if (0 == _openInterfaceSockets(interface))
+            {
+                free(interface->interface.name);
+                free(interface);
+                return 0;
+            }
+            source_1905 = _reactorAdd(interface->sock_1905_fd, EPOLLIN, _packetHandler, interface);
+            if (NULL == source_1905 ||
+                NULL == _reactorAdd(interface->sock_lldp_fd, EPOLLIN, _packetHandler, interface))
+            {
+                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Could not start receiving packets on interface %s\n", interface->interface.name);
+                if (NULL != source_1905)
+                {
+                    _reactorRemove(source_1905);
+                }
+                close(interface->sock_1905_fd);
+                close(interface->sock_lldp_fd);
+                free(interface->rx_message);
+                free(interface->interface.name);
+                free(interface);
+                return 0;
+            }
 
             // NOTE:
             //   The memory allocated by "interface" will be lost forever at this
@@ -958,12 +1511,11 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
         case PLATFORM_QUEUE_EVENT_TIMEOUT:
         case PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC:
         {
-            struct eventTimeOut             *p1;
-            struct _timerHandlerThreadData  *p2;
+            struct eventTimeOut       *p1;
+            struct _timerHandlerData  *p2;
 
-            struct sigevent      se;
             struct itimerspec    its;
-            timer_t              timer_id;
+            int                  timer_fd;
 
             p1 = (struct eventTimeOut *)data;
 
@@ -974,7 +1526,7 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
                 return 0;
             }
 
-            p2 = (struct _timerHandlerThreadData *)malloc(sizeof(struct _timerHandlerThreadData));
+            p2 = (struct _timerHandlerData *)malloc(sizeof(struct _timerHandlerData));
             if (NULL == p2)
             {
                 // Out of memory
@@ -985,23 +1537,18 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
             p2->queue_id = queue_id;
             p2->token    = p1->token;
             p2->periodic = PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC == event_type ? 1 : 0;
+            p2->pending  = 0;
 
             // Next, create the timer. Note that it will be automatically
-            // destroyed (by us) in the callback function
+            // destroyed (by us) in the handler function
             //
-            memset(&se, 0, sizeof(se));
-            se.sigev_notify          = SIGEV_THREAD;
-            se.sigev_notify_function = _timerHandler;
-            se.sigev_value.sival_ptr = (void *)p2;
-
-            if (-1 == timer_create(CLOCK_REALTIME, &se, &timer_id))
+            if (-1 == (timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)))
             {
                 // Failed to create a new timer
                 //
                 free(p2);
                 return 0;
             }
-            p2->timer_id = timer_id;
 
             // Finally, arm/start the timer
             //
@@ -1010,12 +1557,12 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
             its.it_interval.tv_sec  = PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC == event_type ? its.it_value.tv_sec  : 0;
             its.it_interval.tv_nsec = PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC == event_type ? its.it_value.tv_nsec : 0;
 
-            if (0 != timer_settime(timer_id, 0, &its, NULL))
+            if (0 != timerfd_settime(timer_fd, 0, &its, NULL) || NULL == _reactorAdd(timer_fd, EPOLLIN, _timerHandler, p2))
             {
                 // Problems arming the timer
                 //
                 free(p2);
-                timer_delete(timer_id);
+                close(timer_fd);
                 return 0;
             }
 
@@ -1027,22 +1574,14 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
             // The AL entity is telling us that it is capable of processing
             // "push button" configuration events.
             //
-            // Create the thread in charge of generating these events.
+            // Start monitoring the file descriptors that generate these
+            // events.
             //
-            pthread_t                      thread;
-            struct _pushButtonThreadData  *p;
-
-            p = (struct _pushButtonThreadData *)malloc(sizeof(struct _pushButtonThreadData));
-            if (NULL == p)
+            if (0 == _pushButtonStart(queue_id))
             {
-                // Out of memory
-                //
                 return 0;
             }
 
-            p->queue_id = queue_id;
-            pthread_create(&thread, NULL, _pushButtonThread, (void *)p);
-
             break;
         }
 
@@ -1063,24 +1602,14 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
             // The AL entity is telling us that it is capable of processing
             // "topology change" events.
             //
-            // We will create a new thread in charge of monitoring the local
-            // topology to generate these events.
+            // We will start monitoring the local topology to generate these
+            // events.
             //
-            pthread_t                           thread;
-            struct _topologyMonitorThreadData  *p;
-
-            p = (struct _topologyMonitorThreadData *)malloc(sizeof(struct _topologyMonitorThreadData));
-            if (NULL == p)
+            if (0 == _topologyMonitorStart(queue_id))
             {
-                // Out of memory
-                //
                 return 0;
             }
 
-            p->queue_id = queue_id;
-
-            pthread_create(&thread, NULL, _topologyMonitorThread, (void *)p);
-
             break;
         }
 
@@ -1095,50 +1624,148 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
     return 1;
 }
 
-uint8_t PLATFORM_READ_QUEUE(uint8_t queue_id, uint8_t *message_buffer)
+uint8_t *PLATFORM_READ_QUEUE_NOCOPY(uint8_t queue_id)
 {
-    mqd_t    mqdes;
-    ssize_t  len;
+    struct _eventQueue *q;
+    uint8_t            *message;
+    uint32_t            slot;
+    uint16_t            payload_len;
 
-    mqdes = queues_id[queue_id];
-    if ((mqd_t) -1 == mqdes)
+    q = queues[queue_id];
+    if (NULL == q)
     {
         // Invalid ID
-        return 1;
+        return NULL;
     }
 
-    len = mq_receive(mqdes, (char *)message_buffer, MAX_NETWORK_SEGMENT_SIZE+3, NULL);
+    // The previous message is no longer needed by the caller
+    //
+    free(q->last);
+    q->last = NULL;
 
-    if (-1 == len)
+    while (0 != sem_wait(&q->used_slots))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] mq_receive() returned with errno=%d (%s)\n", errno, strerror(errno));
-        return 0;
+        if (EINTR != errno)
+        {
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] sem_wait() returned with errno=%d (%s)\n", errno, strerror(errno));
+            return NULL;
+        }
     }
 
-    // All messages are TLVs where the second and third bytes indicate the
-    // total length of the payload. This value *must* match "len-3"
+    // Deferred events go first: they were generated while the queue was full
+    // and thus might already be late
     //
-    if ( len < 0 )
-    {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] mq_receive() returned than 3 bytes (minimum TLV size)\n");
-        return 0;
-    }
-    else
+    message = _takeDeferredMessage(q);
+    if (NULL == message)
     {
-        uint16_t payload_len;
+        int free_slots;
 
-        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Receiving %d bytes from queue (%02x, %02x, %02x, ...)\n", len, message_buffer[0], message_buffer[1], message_buffer[2]);
+        // The slot might have been reserved by a producer which has not
+        // finished publishing its message yet
+        //
+        slot = q->tail & (PLATFORM_QUEUE_DEPTH - 1);
+        while (NULL == (message = __atomic_load_n(&q->slots[slot], __ATOMIC_ACQUIRE)))
+        {
+            sched_yield();
+        }
+        q->slots[slot] = NULL;
+        q->tail++;
 
-        payload_len = *(((uint8_t *)message_buffer)+1) * 256 + *(((uint8_t *)message_buffer)+2);
+        sem_post(&q->free_slots);
 
-        if (payload_len != len-3)
+        // Restart the packet sockets paused because the queue was full once a
+        // quarter of it is free again (not right away, to avoid pausing and
+        // resuming them for each packet while the AL catches up)
+        //
+        if (0 != __atomic_load_n(&q->paused_nr, __ATOMIC_SEQ_CST))
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] mq_receive() returned %d bytes, but the TLV is %d bytes\n", len, payload_len+3);
-            return 0;
+            sem_getvalue(&q->free_slots, &free_slots);
+            if (free_slots >= PLATFORM_QUEUE_DEPTH / 4)
+            {
+                _resumePausedSources(q);
+            }
         }
     }
 
+    q->last = message;
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Receiving message from queue (%02x, %02x, %02x, ...)\n", message[0], message[1], message[2]);
+
+    // All messages are TLVs where the second and third bytes indicate the
+    // total length of the payload, which can never be bigger than a network
+    // packet plus the interface MAC address
+    //
+    payload_len = message[1] * 256 + message[2];
+    if (payload_len > 6 + MAX_NETWORK_SEGMENT_SIZE)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Invalid message length (%d bytes) found in queue\n", payload_len);
+        return NULL;
+    }
+
+    return message;
+}
+
+uint8_t PLATFORM_READ_QUEUE(uint8_t queue_id, uint8_t *message_buffer)
+{
+    uint8_t  *message;
+    uint16_t  payload_len;
+
+    message = PLATFORM_READ_QUEUE_NOCOPY(queue_id);
+    if (NULL == message)
+    {
+        return 0;
+    }
+
+    payload_len = message[1] * 256 + message[2];
+    if (payload_len > MAX_NETWORK_SEGMENT_SIZE)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Message (%d bytes) does not fit in the provided buffer\n", payload_len+3);
+        return 0;
+    }
+
+    memcpy(message_buffer, message, 3 + payload_len);
+
     return 1;
 }
 
+uint8_t PLATFORM_RUN_IN_BACKGROUND(uint8_t queue_id, void (*work)(void *data), void (*done)(void *data), void *data)
+{
+    struct _backgroundWork *w;
+
+    if (NULL == work || NULL == done || NULL == queues[queue_id])
+    {
+        return 0;
+    }
+
+    pthread_once(&background_once, _backgroundInit);
+    if (0 == background.workers_nr)
+    {
+        return 0;
+    }
+
+    w = (struct _backgroundWork *)malloc(sizeof(struct _backgroundWork));
+    if (NULL == w)
+    {
+        return 0;
+    }
+    w->queue_id    = queue_id;
+    w->work        = work;
+    w->result.done = done;
+    w->result.data = data;
+    w->next        = NULL;
+
+    pthread_mutex_lock(&background.mutex);
+    if (NULL == background.tail)
+    {
+        background.head = w;
+    }
+    else
+    {
+        background.tail->next = w;
+    }
+    background.tail = w;
+    pthread_cond_signal(&background.cond);
+    pthread_mutex_unlock(&background.mutex);
 
+    return 1;
+}
@@ -117,8 +117,26 @@ void PLATFORM_PRINTF_DEBUG_DETAIL(const char *format, ...);
 //   2 => Print ERROR, WARNING and INFO messages
 //   3 => Print ERROR, WARNING, INFO and DETAIL messages
 //
+#define PLATFORM_DEBUG_LEVEL_ERROR    (0)
+#define PLATFORM_DEBUG_LEVEL_WARNING  (1)
+#define PLATFORM_DEBUG_LEVEL_INFO     (2)
+#define PLATFORM_DEBUG_LEVEL_DETAIL   (3)
+
 void PLATFORM_PRINTF_DEBUG_SET_VERBOSITY_LEVEL(int level);
 
+// Returns "1" if messages of the given level (one of the
+// "PLATFORM_DEBUG_LEVEL_*" values) are currently being printed, "0" otherwise.
+//
+// Use it to skip expensive work (hex dumps, structure visits, ...) whose only
+// purpose is to generate debug messages that would be discarded anyway:
+//
+//   if (1 == PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+//   {
+//       visit_1905_CMDU_structure(c, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+//   }
+//
+uint8_t PLATFORM_PRINTF_DEBUG_ENABLED(int level);
+
 // Return the number of milliseconds ellapsed since the program started
 //
 uint32_t PLATFORM_GET_TIMESTAMP(void);
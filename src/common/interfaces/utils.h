@@ -62,6 +62,63 @@
 #define ARRAY_SIZE(a) (sizeof(a)/sizeof(*(a)))
 
 
+/** @brief Arena (bump) allocator.
+ *
+ * An arena hands out memory from a few big chunks by simply advancing a pointer. Individual allocations are never
+ * released: the whole arena is emptied at once with memArenaReset(). This is meant for objects which all share the
+ * same (short) lifetime, such as a received CMDU and all of its TLVs, and avoids lots of small malloc()/free() calls
+ * and the heap fragmentation that comes with them.
+ *
+ * Memory is taken from an arena either explicitly with memArenaAlloc(), or by code written for the heap (e.g. the
+ * factory parsers) while the arena is selected with memArenaSelect() in the calling thread. Only then do memalloc(),
+ * memrealloc() and memfree() look at it: memfree() leaves the memory of the selected arena alone and memrealloc()
+ * keeps it in the arena. With no arena selected they go straight to the heap.
+ *
+ * Arena memory is therefore only valid between memArenaSelect() and the next memArenaReset(), and must never be
+ * given to memfree() or memrealloc() once its arena is no longer selected (nor from any other thread). Only select
+ * an arena around code whose every allocation is released (or forgotten) before that, such as parsing and printing
+ * a CMDU. Hash tables never take their memory from an arena, so inserting into one while an arena is selected is
+ * safe.
+ */
+struct memArena;
+
+/** @brief The arena selected in the current thread (NULL: memalloc() uses the heap). Use memArenaSelect(). */
+extern __thread struct memArena *mem_arena_selected;
+
+/** @brief Create a new arena whose chunks are (at least) @a chunk_size bytes long.
+ *
+ * The first chunk is allocated immediately.
+ */
+struct memArena *memArenaCreate(size_t chunk_size);
+
+/** @brief Release all the memory of @a arena (it is deselected first if needed). */
+void memArenaDestroy(struct memArena *arena);
+
+/** @brief Release all the allocations of @a arena at once.
+ *
+ * If the last cycle needed more than one chunk, they are merged into a single bigger one, so that next time
+ * everything fits in one chunk again.
+ */
+void memArenaReset(struct memArena *arena);
+
+/** @brief Make memalloc() allocate from @a arena (NULL: back to the heap) and return the previously selected one. */
+struct memArena *memArenaSelect(struct memArena *arena);
+
+/** @brief Allocate @a size bytes from @a arena. Exits if no memory can be allocated. */
+void *memArenaAlloc(struct memArena *arena, size_t size);
+
+/** @brief Redimension an area obtained from @a arena.
+ *
+ * NULL @a ptr is a plain allocation from @a arena. Areas that do not belong to @a arena are reallocated on the heap.
+ */
+void *memArenaRealloc(struct memArena *arena, void *ptr, size_t size);
+
+/** @brief Return 1 if @a ptr was allocated from @a arena (since its last reset), 0 otherwise.
+ *
+ * This only walks the chunks of @a arena, which after a reset is a single one.
+ */
+uint8_t memArenaContains(const struct memArena *arena, const void *ptr);
+
 /** @ brief Allocate a chunk of 'n' bytes and return a pointer to it.
  *
  * If no memory can be allocated, this function exits immediately.
@@ -70,6 +127,11 @@ static inline void *memalloc(size_t size)
 {
     void *p;
 
+    if (NULL != mem_arena_selected)
+    {
+        return memArenaAlloc(mem_arena_selected, size);
+    }
+
     p = malloc(size);
 
     if (NULL == p)
@@ -84,11 +146,18 @@ static inline void *memalloc(size_t size)
 /** @brief Redimension a memory area previously obtained with memalloc().
  *
  * If no memory can be allocated, this function exits immediately.
+ *
+ * While an arena is selected, this is handled by memArenaRealloc(). Heap areas stay on the heap even then.
  */
 static inline void *memrealloc(void *ptr, size_t size)
 {
     void *p;
 
+    if (NULL != mem_arena_selected)
+    {
+        return memArenaRealloc(mem_arena_selected, ptr, size);
+    }
+
     p = realloc(ptr, size);
 
     if (NULL == p)
@@ -101,6 +170,50 @@ static inline void *memrealloc(void *ptr, size_t size)
 }
 
 
+/** @brief Release a memory area obtained with memalloc() or memrealloc().
+ *
+ * Areas allocated from the selected arena are left alone (they are released by memArenaReset()).
+ */
+static inline void memfree(void *ptr)
+{
+    if (NULL != mem_arena_selected && memArenaContains(mem_arena_selected, ptr))
+    {
+        return;
+    }
+    free(ptr);
+}
+
+
+/** @brief Hash table with fixed size binary keys.
+ *
+ * Keys are byte strings of the length given to hashTableCreate() (ex: 6 for MAC addresses), which are copied into
+ * the table. Values are opaque pointers owned by the caller. The number of buckets is doubled whenever the table
+ * holds more entries than buckets, so that lookups stay O(1) no matter how many entries are inserted.
+ */
+struct hashTable;
+
+/** @brief Create an empty table for keys of @a key_len bytes. @a buckets_nr is just a hint (0 for the default). */
+struct hashTable *hashTableCreate(uint8_t key_len, uint32_t buckets_nr);
+
+/** @brief Release the table itself (the values are not touched). */
+void hashTableDestroy(struct hashTable *table);
+
+/** @brief Remove all entries (the values are not touched). */
+void hashTableClear(struct hashTable *table);
+
+/** @brief Associate @a value to @a key. Returns 1 if the key is new, 2 if its previous value was replaced. */
+uint8_t hashTableInsert(struct hashTable *table, const uint8_t *key, void *value);
+
+/** @brief Return the value associated to @a key, or NULL if there is none. */
+void *hashTableFind(const struct hashTable *table, const uint8_t *key);
+
+/** @brief Remove @a key from the table and return the value it had (NULL if it was not there). */
+void *hashTableRemove(struct hashTable *table, const uint8_t *key);
+
+/** @brief Return the number of entries in the table. */
+uint32_t hashTableCount(const struct hashTable *table);
+
+
 typedef void (*visitor_callback) (void (*write_function)(const char *fmt, ...), const char *prefix, uint8_t size, const char *name, const char *fmt, const void *p);
 
 // This is an auxiliary function which is used when calling the "visit_*()"
@@ -50,13 +50,480 @@
 #include "platform.h"
 #include "utils.h"
 
-#include <string.h> // memcmp(), strncat()
+#include <string.h> // memcmp(), strncat(), memcpy(), memset()
 #include <stdio.h> // snprintf()
 
+////////////////////////////////////////////////////////////////////////////////
+// Private data and functions
+////////////////////////////////////////////////////////////////////////////////
+
+// All arena allocations (and the header in front of each of them) are aligned
+// to this many bytes, which is enough for any of the basic types.
+//
+#define ARENA_ALIGNMENT   (16)
+#define ARENA_ALIGN(x)    (((x) + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1))
+
+// Every allocation is preceded by a header containing its size, so that
+// memArenaRealloc() knows how many bytes to copy.
+//
+struct _memArenaHeader
+{
+    size_t    size;
+};
+
+#define ARENA_HEADER_SIZE ARENA_ALIGN(sizeof(struct _memArenaHeader))
+
+struct _memArenaChunk
+{
+    struct _memArenaChunk *next;   // Older (already full) chunk
+
+    size_t   size;                 // Usable bytes in 'data'
+    size_t   used;                 // Bytes already handed out
+    uint8_t *data;                 // Points after this header (aligned)
+};
+
+struct memArena
+{
+    struct _memArenaChunk *chunks; // The first one is the one being filled
+    size_t                 chunk_size;
+};
+
+__thread struct memArena *mem_arena_selected = NULL;
+
+// Create a new chunk with at least 'size' usable bytes. Linking it in its arena
+// is left to the caller.
+//
+static struct _memArenaChunk *_newChunk(size_t size)
+{
+    struct _memArenaChunk *c;
+    size_t                 header_size;
+
+    header_size = ARENA_ALIGN(sizeof(struct _memArenaChunk));
+    size        = ARENA_ALIGN(size);
+
+    c = (struct _memArenaChunk *)malloc(header_size + size);
+    if (NULL == c)
+    {
+        fprintf(stderr, "ERROR: Out of memory!\n");
+        exit(1);
+    }
+    c->next = NULL;
+    c->size = size;
+    c->used = 0;
+    c->data = (uint8_t *)c + header_size;
+
+    return c;
+}
+
+// Return the chunk of 'arena' whose data contains 'ptr' or NULL if there is
+// none. After a reset an arena has a single chunk, so this is typically one
+// comparison.
+//
+static struct _memArenaChunk *_findChunk(const struct memArena *arena, const void *ptr)
+{
+    struct _memArenaChunk *c;
+
+    for (c = arena->chunks; NULL != c; c = c->next)
+    {
+        if ((const uint8_t *)ptr >= c->data && (const uint8_t *)ptr < c->data + c->used)
+        {
+            return c;
+        }
+    }
+
+    return NULL;
+}
+
+// Memory for long lived objects (ex: hash table entries), which must never be
+// taken from an arena, even if one is selected at the time
+//
+static void *_heapAlloc(size_t size)
+{
+    void *p;
+
+    p = malloc(size);
+    if (NULL == p)
+    {
+        fprintf(stderr, "ERROR: Out of memory!\n");
+        exit(1);
+    }
+
+    return p;
+}
+
+// Hash tables start with this many buckets (unless told otherwise) and are
+// doubled every time they contain more entries than buckets.
+//
+#define HASH_TABLE_DEFAULT_BUCKETS  (16)
+
+struct _hashTableEntry
+{
+    struct _hashTableEntry *next;   // Next entry in the same bucket
+
+    void                   *value;
+    uint8_t                 key[];  // 'key_len' bytes
+};
+
+struct hashTable
+{
+    uint8_t                  key_len;
+
+    uint32_t                 entries_nr;
+    uint32_t                 buckets_nr;  // Always a power of 2
+    struct _hashTableEntry **buckets;
+};
+
+// FNV-1a hash of a 'len' bytes long 'key'
+//
+static uint32_t _hashKey(const uint8_t *key, uint8_t len)
+{
+    uint32_t h;
+    uint8_t  i;
+
+    h = 2166136261U;
+    for (i=0; i<len; i++)
+    {
+        h ^= key[i];
+        h *= 16777619U;
+    }
+
+    return h;
+}
+
+// Return a pointer to the "next" field pointing to the entry with the given
+// 'key' (or to the last "next" field of its bucket, which is NULL, if there is
+// no such entry)
+//
+static struct _hashTableEntry **_hashTableLookup(const struct hashTable *table, const uint8_t *key)
+{
+    struct _hashTableEntry **e;
+
+    e = &table->buckets[_hashKey(key, table->key_len) & (table->buckets_nr - 1)];
+    while (NULL != *e && 0 != memcmp((*e)->key, key, table->key_len))
+    {
+        e = &(*e)->next;
+    }
+
+    return e;
+}
+
+static void _hashTableGrow(struct hashTable *table)
+{
+    struct _hashTableEntry **old_buckets;
+    struct _hashTableEntry  *e;
+    uint32_t                 old_buckets_nr;
+    uint32_t                 i, b;
+
+    old_buckets    = table->buckets;
+    old_buckets_nr = table->buckets_nr;
+
+    table->buckets_nr = old_buckets_nr * 2;
+    table->buckets    = (struct _hashTableEntry **)_heapAlloc(sizeof(struct _hashTableEntry *) * table->buckets_nr);
+    memset(table->buckets, 0, sizeof(struct _hashTableEntry *) * table->buckets_nr);
+
+    for (i=0; i<old_buckets_nr; i++)
+    {
+        while (NULL != (e = old_buckets[i]))
+        {
+            old_buckets[i] = e->next;
+
+            b                 = _hashKey(e->key, table->key_len) & (table->buckets_nr - 1);
+            e->next           = table->buckets[b];
+            table->buckets[b] = e;
+        }
+    }
+    memfree(old_buckets);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Public API
 ////////////////////////////////////////////////////////////////////////////////
 //
+struct hashTable *hashTableCreate(uint8_t key_len, uint32_t buckets_nr)
+{
+    struct hashTable *table;
+    uint32_t          n;
+
+    n = HASH_TABLE_DEFAULT_BUCKETS;
+    while (n < buckets_nr)
+    {
+        n *= 2;
+    }
+
+    table = (struct hashTable *)_heapAlloc(sizeof(struct hashTable));
+
+    table->key_len    = key_len;
+    table->entries_nr = 0;
+    table->buckets_nr = n;
+    table->buckets    = (struct _hashTableEntry **)_heapAlloc(sizeof(struct _hashTableEntry *) * n);
+    memset(table->buckets, 0, sizeof(struct _hashTableEntry *) * n);
+
+    return table;
+}
+
+void hashTableDestroy(struct hashTable *table)
+{
+    if (NULL == table)
+    {
+        return;
+    }
+
+    hashTableClear(table);
+    memfree(table->buckets);
+    memfree(table);
+}
+
+void hashTableClear(struct hashTable *table)
+{
+    struct _hashTableEntry *e;
+    uint32_t                i;
+
+    for (i=0; i<table->buckets_nr; i++)
+    {
+        while (NULL != (e = table->buckets[i]))
+        {
+            table->buckets[i] = e->next;
+            memfree(e);
+        }
+    }
+    table->entries_nr = 0;
+}
+
+uint8_t hashTableInsert(struct hashTable *table, const uint8_t *key, void *value)
+{
+    struct _hashTableEntry **e;
+
+    e = _hashTableLookup(table, key);
+    if (NULL != *e)
+    {
+        (*e)->value = value;
+        return 2;
+    }
+
+    *e = (struct _hashTableEntry *)_heapAlloc(sizeof(struct _hashTableEntry) + table->key_len);
+    (*e)->next  = NULL;
+    (*e)->value = value;
+    memcpy((*e)->key, key, table->key_len);
+
+    table->entries_nr++;
+    if (table->entries_nr > table->buckets_nr)
+    {
+        _hashTableGrow(table);
+    }
+
+    return 1;
+}
+
+void *hashTableFind(const struct hashTable *table, const uint8_t *key)
+{
+    struct _hashTableEntry *e;
+
+    if (NULL == table || NULL == key)
+    {
+        return NULL;
+    }
+
+    e = *_hashTableLookup(table, key);
+
+    return NULL == e ? NULL : e->value;
+}
+
+void *hashTableRemove(struct hashTable *table, const uint8_t *key)
+{
+    struct _hashTableEntry **e;
+    struct _hashTableEntry  *aux;
+    void                    *value;
+
+    e = _hashTableLookup(table, key);
+    if (NULL == *e)
+    {
+        return NULL;
+    }
+
+    aux   = *e;
+    value = aux->value;
+    *e    = aux->next;
+    memfree(aux);
+
+    table->entries_nr--;
+
+    return value;
+}
+
+uint32_t hashTableCount(const struct hashTable *table)
+{
+    return table->entries_nr;
+}
+
+struct memArena *memArenaCreate(size_t chunk_size)
+{
+    struct memArena *a;
+
+    a = (struct memArena *)malloc(sizeof(struct memArena));
+    if (NULL == a)
+    {
+        fprintf(stderr, "ERROR: Out of memory!\n");
+        exit(1);
+    }
+
+    a->chunk_size = ARENA_ALIGN(chunk_size);
+    a->chunks     = _newChunk(a->chunk_size);
+
+    return a;
+}
+
+void memArenaDestroy(struct memArena *arena)
+{
+    struct _memArenaChunk  *c;
+
+    if (NULL == arena)
+    {
+        return;
+    }
+
+    if (mem_arena_selected == arena)
+    {
+        mem_arena_selected = NULL;
+    }
+
+    while (NULL != arena->chunks)
+    {
+        c             = arena->chunks;
+        arena->chunks = c->next;
+        free(c);
+    }
+    free(arena);
+}
+
+void memArenaReset(struct memArena *arena)
+{
+    struct _memArenaChunk *c;
+    size_t                 total;
+
+    if (NULL == arena->chunks->next)
+    {
+        arena->chunks->used = 0;
+        return;
+    }
+
+    // More than one chunk was needed: replace all of them by a single one
+    // big enough for the whole cycle.
+    //
+    total = 0;
+    while (NULL != arena->chunks)
+    {
+        c             = arena->chunks;
+        arena->chunks = c->next;
+        total        += c->size;
+        free(c);
+    }
+    arena->chunks = _newChunk(total);
+}
+
+struct memArena *memArenaSelect(struct memArena *arena)
+{
+    struct memArena *previous;
+
+    previous           = mem_arena_selected;
+    mem_arena_selected = arena;
+
+    return previous;
+}
+
+void *memArenaAlloc(struct memArena *arena, size_t size)
+{
+    struct _memArenaChunk  *c;
+    struct _memArenaHeader *h;
+    size_t                  needed;
+
+    // Zero-sized allocations still get their own byte, so that the returned
+    // pointer is recognized by memArenaContains()
+    //
+    if (0 == size)
+    {
+        size = 1;
+    }
+    needed = ARENA_HEADER_SIZE + ARENA_ALIGN(size);
+
+    c = arena->chunks;
+    if (c->used + needed > c->size)
+    {
+        c             = _newChunk(needed > arena->chunk_size ? needed : arena->chunk_size);
+        c->next       = arena->chunks;
+        arena->chunks = c;
+    }
+
+    h        = (struct _memArenaHeader *)(c->data + c->used);
+    c->used += needed;
+
+    h->size = size;
+
+    return (uint8_t *)h + ARENA_HEADER_SIZE;
+}
+
+void *memArenaRealloc(struct memArena *arena, void *ptr, size_t size)
+{
+    struct _memArenaChunk  *c;
+    struct _memArenaHeader *h;
+    size_t                  old_size;
+    uint8_t                *p;
+
+    if (NULL == ptr)
+    {
+        return memArenaAlloc(arena, size);
+    }
+
+    c = _findChunk(arena, ptr);
+    if (NULL == c)
+    {
+        // Heap areas stay on the heap
+        //
+        p = realloc(ptr, size);
+        if (NULL == p)
+        {
+            fprintf(stderr, "ERROR: Out of memory!\n");
+            exit(1);
+        }
+        return p;
+    }
+
+    h        = (struct _memArenaHeader *)((uint8_t *)ptr - ARENA_HEADER_SIZE);
+    old_size = h->size;
+
+    if (ARENA_ALIGN(size) <= ARENA_ALIGN(old_size))
+    {
+        h->size = size;
+        return ptr;
+    }
+
+    // If this is the last allocation of the chunk being filled (typical when
+    // growing a list) simply extend it in place.
+    //
+    if (c == arena->chunks                                                   &&
+        (uint8_t *)ptr + ARENA_ALIGN(old_size) == c->data + c->used          &&
+        c->used - ARENA_ALIGN(old_size) + ARENA_ALIGN(size) <= c->size)
+    {
+        c->used = c->used - ARENA_ALIGN(old_size) + ARENA_ALIGN(size);
+        h->size = size;
+        return ptr;
+    }
+
+    p = memArenaAlloc(arena, size);
+    memcpy(p, ptr, old_size);
+
+    return p;
+}
+
+uint8_t memArenaContains(const struct memArena *arena, const void *ptr)
+{
+    if (NULL == arena || NULL == ptr)
+    {
+        return 0;
+    }
+
+    return NULL == _findChunk(arena, ptr) ? 0 : 1;
+}
+
 void print_callback(void (*write_function)(const char *fmt, ...), const char *prefix, uint8_t size, const char *name, const char *fmt, const void *p)
 {
 
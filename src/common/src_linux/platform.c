@@ -66,7 +66,8 @@
 #include <unistd.h>           // close()
 
 #ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-#    include <pthread.h> // mutexes, pthread_self()
+#    include <pthread.h>   // mutexes, pthread_self()
+#    include <semaphore.h> // sem_*()
 #endif
 
 
@@ -93,11 +94,370 @@ static struct timeval tv_begin;
 //
 static int verbosity_level = 2;
 
-// Mutex to avoid STDOUT "overlaping" due to different threads writing at the
-// same time.
+// Special "level" for messages printed with "PLATFORM_PRINTF()" (ie. without
+// the timestamp and level prefix)
 //
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-pthread_mutex_t printf_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define LOG_LEVEL_RAW  (0xFF)
+
+#ifdef _FLAVOUR_X86_WINDOWS_MINGW_
+
+// No threads in this flavour: messages are printed right away
+//
+static void _logMessage(uint8_t level, const char *format, va_list arglist)
+{
+    static const char *prefixes[] = {"ERROR   : ", "WARNING : ", "INFO    : ", "DETAIL  : "};
+
+    if (LOG_LEVEL_RAW != level)
+    {
+        uint32_t ts;
+
+        ts = PLATFORM_GET_TIMESTAMP();
+        printf("[%03d.%03d] %s", ts/1000, ts%1000, prefixes[level]);
+    }
+    vprintf(format, arglist);
+}
+
+#else
+
+// Messages are not printed by the thread that generates them. Instead:
+//
+//   - Each thread formats its messages into its own ring buffer, which has one
+//     single producer (the thread) and one single consumer (the writer
+//     thread), and thus needs no locks.
+//     Each entry contains a small binary header (timestamp, level and length)
+//     followed by the already formatted text.
+//
+//   - A background writer thread drains all ring buffers to STDOUT, adding the
+//     "[timestamp] LEVEL : " prefix. It sleeps while there is nothing to print.
+//
+//   - If a ring buffer is full (ex: because STDOUT is a slow console) debug
+//     messages are discarded and counted. The writer reports how many messages
+//     were dropped as soon as it is able to.
+//     Messages printed with "PLATFORM_PRINTF()" are never discarded (they are
+//     not debug traces but actual output, such as the HLE ALME replies):
+//     instead, the calling thread prints everything pending itself to make
+//     room for them.
+//
+//   - Ring buffers are registered with a lock-free push and never freed: the
+//     ring of a thread that exits is adopted by the next thread that needs one.
+//
+// This way debug logging never blocks the calling thread.
+//
+// Pending messages are printed when the program exits (but not if it
+// crashes!)
+//
+// These parameters can be changed at build time (ex: by adding
+// "-DPLATFORM_LOG_RING_SIZE=262144" to the compiler flags):
+//
+//   - PLATFORM_LOG_RING_SIZE: size (in bytes, power of two) of each thread's
+//     ring buffer.
+//
+//   - PLATFORM_LOG_MAX_MESSAGE: longest message. Longer ones are truncated.
+//
+//   - PLATFORM_LOG_TIMESTAMPS: set to "0" to print messages without the
+//     "[timestamp]" prefix.
+//
+#ifndef PLATFORM_LOG_RING_SIZE
+#  define PLATFORM_LOG_RING_SIZE    (65536)
+#endif
+
+#ifndef PLATFORM_LOG_MAX_MESSAGE
+#  define PLATFORM_LOG_MAX_MESSAGE  (1024)
+#endif
+
+#ifndef PLATFORM_LOG_TIMESTAMPS
+#  define PLATFORM_LOG_TIMESTAMPS   (1)
+#endif
+
+#if (PLATFORM_LOG_RING_SIZE & (PLATFORM_LOG_RING_SIZE - 1)) != 0
+#  error "PLATFORM_LOG_RING_SIZE must be a power of two"
+#endif
+
+struct _logEntryHeader
+{
+    uint32_t  ts;
+    uint16_t  len;      // Length of the text that follows
+    uint8_t   level;
+    uint8_t   reserved;
+};
+
+struct _logRing
+{
+    struct _logRing  *next;
+
+    uint32_t          head;       // Only written by the owner thread
+    uint32_t          tail;       // Only written by the writer thread
+
+    uint32_t          dropped;    // Messages discarded by the owner thread
+    uint32_t          reported;   // ...and how many of those were reported
+
+    uint8_t           orphan;     // Set when the owner thread exits (and
+                                  // cleared by the thread that adopts it)
+
+    uint8_t           data[PLATFORM_LOG_RING_SIZE];
+};
+
+static __thread struct _logRing *log_ring;
+
+static struct _logRing  *log_rings;            // All ring buffers (only
+                                                 // ever pushed to its head)
+static pthread_mutex_t   log_drain_mutex     = PTHREAD_MUTEX_INITIALIZER;
+                                                 // Serializes consumers (the
+                                                 // writer thread, the exit
+                                                 // handler and producers
+                                                 // making room for a
+                                                 // "PLATFORM_PRINTF()")
+
+static pthread_once_t    log_once            = PTHREAD_ONCE_INIT;
+static pthread_key_t     log_key;
+static sem_t             log_wakeup;
+static uint8_t           log_writer_sleeping;
+
+static void _logRingCopyIn(struct _logRing *ring, uint32_t pos, const void *src, uint32_t len)
+{
+    uint32_t offset;
+    uint32_t first;
+
+    offset = pos & (PLATFORM_LOG_RING_SIZE - 1);
+    first  = PLATFORM_LOG_RING_SIZE - offset < len ? PLATFORM_LOG_RING_SIZE - offset : len;
+
+    memcpy(&ring->data[offset], src, first);
+    memcpy(&ring->data[0], (const uint8_t *)src + first, len - first);
+}
+
+static void _logRingCopyOut(struct _logRing *ring, uint32_t pos, void *dst, uint32_t len)
+{
+    uint32_t offset;
+    uint32_t first;
+
+    offset = pos & (PLATFORM_LOG_RING_SIZE - 1);
+    first  = PLATFORM_LOG_RING_SIZE - offset < len ? PLATFORM_LOG_RING_SIZE - offset : len;
+
+    memcpy(dst, &ring->data[offset], first);
+    memcpy((uint8_t *)dst + first, &ring->data[0], len - first);
+}
+
+// Print everything pending in all ring buffers. Returns "1" if something was
+// printed, "0" otherwise.
+//
+static uint8_t _logDrain(void)
+{
+    static const char *prefixes[] = {"ERROR   : ", "WARNING : ", "INFO    : ", "DETAIL  : "};
+
+    struct _logRing  *ring;
+    uint8_t           printed;
+
+    printed = 0;
+
+    pthread_mutex_lock(&log_drain_mutex);
+
+    for (ring = __atomic_load_n(&log_rings, __ATOMIC_ACQUIRE); NULL != ring; ring = ring->next)
+    {
+        uint32_t         head;
+        uint32_t         dropped;
+
+        head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+        while (ring->tail != head)
+        {
+            struct _logEntryHeader  hdr;
+            char                    text[PLATFORM_LOG_MAX_MESSAGE];
+
+            _logRingCopyOut(ring, ring->tail,               &hdr, sizeof(hdr));
+            _logRingCopyOut(ring, ring->tail + sizeof(hdr), text, hdr.len);
+
+            if (LOG_LEVEL_RAW != hdr.level)
+            {
+#if PLATFORM_LOG_TIMESTAMPS
+                printf("[%03d.%03d] ", hdr.ts/1000, hdr.ts%1000);
+#endif
+                fputs(prefixes[hdr.level], stdout);
+            }
+            fwrite(text, 1, hdr.len, stdout);
+
+            __atomic_store_n(&ring->tail, ring->tail + sizeof(hdr) + hdr.len, __ATOMIC_SEQ_CST);
+            printed = 1;
+        }
+
+        dropped = __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+        if (dropped != ring->reported)
+        {
+            printf("WARNING : %u log messages were dropped\n", dropped - ring->reported);
+            ring->reported = dropped;
+            printed        = 1;
+        }
+    }
+
+    if (1 == printed)
+    {
+        fflush(stdout);
+    }
+
+    pthread_mutex_unlock(&log_drain_mutex);
+
+    return printed;
+}
+
+static void *_logWriterThread(void *p)
+{
+    while (1)
+    {
+        if (1 == _logDrain())
+        {
+            continue;
+        }
+
+        // Nothing to print. Announce that we are going to sleep and check once
+        // more (a producer might have written something right before reading
+        // the flag)
+        //
+        __atomic_store_n(&log_writer_sleeping, 1, __ATOMIC_SEQ_CST);
+
+        if (1 == _logDrain())
+        {
+            if (0 == __atomic_exchange_n(&log_writer_sleeping, 0, __ATOMIC_SEQ_CST))
+            {
+                // A producer has already cleared the flag, which means it has
+                // posted (or is about to post) the semaphore. Consume it.
+                //
+                while (0 != sem_wait(&log_wakeup) && EINTR == errno);
+            }
+            continue;
+        }
+
+        while (0 != sem_wait(&log_wakeup) && EINTR == errno);
+    }
+
+    return NULL;
+}
+
+static void _logThreadExit(void *p)
+{
+    __atomic_store_n(&((struct _logRing *)p)->orphan, 1, __ATOMIC_RELEASE);
+}
+
+static void _logAtExit(void)
+{
+    _logDrain();
+}
+
+static void _logInit(void)
+{
+    pthread_t thread;
+
+    sem_init(&log_wakeup, 0, 0);
+    pthread_key_create(&log_key, _logThreadExit);
+
+    if (0 == pthread_create(&thread, NULL, _logWriterThread, NULL))
+    {
+        pthread_detach(thread);
+    }
+    atexit(_logAtExit);
+}
+
+// Return the ring buffer of the calling thread (adopting the one of a thread
+// that no longer exists or creating a new one if this is the first message of
+// the thread), or NULL if there is no memory for it
+//
+static struct _logRing *_logRingGet(void)
+{
+    struct _logRing *ring;
+
+    if (NULL == log_ring)
+    {
+        pthread_once(&log_once, _logInit);
+
+        for (ring = __atomic_load_n(&log_rings, __ATOMIC_ACQUIRE); NULL != ring; ring = ring->next)
+        {
+            uint8_t orphan = 1;
+
+            if (__atomic_compare_exchange_n(&ring->orphan, &orphan, 0, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            {
+                log_ring = ring;
+                break;
+            }
+        }
+
+        if (NULL == log_ring)
+        {
+            ring = (struct _logRing *)calloc(1, sizeof(struct _logRing));
+            if (NULL == ring)
+            {
+                return NULL;
+            }
+
+            ring->next = __atomic_load_n(&log_rings, __ATOMIC_RELAXED);
+            while (!__atomic_compare_exchange_n(&log_rings, &ring->next, ring, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+            log_ring = ring;
+        }
+        pthread_setspecific(log_key, log_ring);
+    }
+
+    return log_ring;
+}
+
+static void _logMessage(uint8_t level, const char *format, va_list arglist)
+{
+    struct _logRing        *ring;
+    struct _logEntryHeader  hdr;
+    char                    text[PLATFORM_LOG_MAX_MESSAGE];
+    int                     len;
+    uint32_t                tail;
+
+    len = vsnprintf(text, sizeof(text), format, arglist);
+    if (len < 0)
+    {
+        return;
+    }
+    if (len >= (int)sizeof(text))
+    {
+        len = sizeof(text) - 1;
+    }
+
+    ring = _logRingGet();
+    if (NULL == ring)
+    {
+        fwrite(text, 1, len, stdout);
+        return;
+    }
+
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    while (PLATFORM_LOG_RING_SIZE - (ring->head - tail) < sizeof(hdr) + len)
+    {
+        if (LOG_LEVEL_RAW != level)
+        {
+            // No space left. Discard the debug message.
+            //
+            __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+
+        // Print everything pending right now (in the same order it was
+        // generated) to make room for it
+        //
+        _logDrain();
+        tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    }
+
+    hdr.ts       = PLATFORM_GET_TIMESTAMP();
+    hdr.len      = len;
+    hdr.level    = level;
+    hdr.reserved = 0;
+
+    _logRingCopyIn(ring, ring->head,               &hdr, sizeof(hdr));
+    _logRingCopyIn(ring, ring->head + sizeof(hdr), text, len);
+
+    __atomic_store_n(&ring->head, ring->head + sizeof(hdr) + len, __ATOMIC_SEQ_CST);
+
+    // Wake up the writer thread (only if it is sleeping)
+    //
+    if (1 == __atomic_exchange_n(&log_writer_sleeping, 0, __ATOMIC_SEQ_CST))
+    {
+        sem_post(&log_wakeup);
+    }
+}
+
 #endif
 
 
@@ -110,18 +470,10 @@ void PLATFORM_PRINTF(const char *format, ...)
 {
     va_list arglist;
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_lock(&printf_mutex);
-#endif
-
     va_start( arglist, format );
-    vprintf( format, arglist );
+    _logMessage(LOG_LEVEL_RAW, format, arglist);
     va_end( arglist );
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_unlock(&printf_mutex);
-#endif
-
     return;
 }
 
@@ -130,119 +482,72 @@ void PLATFORM_PRINTF_DEBUG_SET_VERBOSITY_LEVEL(int level)
     verbosity_level = level;
 }
 
+uint8_t PLATFORM_PRINTF_DEBUG_ENABLED(int level)
+{
+    return verbosity_level >= level ? 1 : 0;
+}
+
 void PLATFORM_PRINTF_DEBUG_ERROR(const char *format, ...)
 {
     va_list arglist;
-    uint32_t ts;
 
-    if (verbosity_level < 0)
+    if (verbosity_level < PLATFORM_DEBUG_LEVEL_ERROR)
     {
         return;
     }
 
-    ts = PLATFORM_GET_TIMESTAMP();
-
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_lock(&printf_mutex);
-#endif
-
-    printf("[%03d.%03d] ", ts/1000, ts%1000);
-    printf("ERROR   : ");
     va_start( arglist, format );
-    vprintf( format, arglist );
+    _logMessage(PLATFORM_DEBUG_LEVEL_ERROR, format, arglist);
     va_end( arglist );
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_unlock(&printf_mutex);
-#endif
-
     return;
 }
 
 void PLATFORM_PRINTF_DEBUG_WARNING(const char *format, ...)
 {
     va_list arglist;
-    uint32_t ts;
 
-    if (verbosity_level < 1)
+    if (verbosity_level < PLATFORM_DEBUG_LEVEL_WARNING)
     {
         return;
     }
 
-    ts = PLATFORM_GET_TIMESTAMP();
-
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_lock(&printf_mutex);
-#endif
-
-    printf("[%03d.%03d] ", ts/1000, ts%1000);
-    printf("WARNING : ");
     va_start( arglist, format );
-    vprintf( format, arglist );
+    _logMessage(PLATFORM_DEBUG_LEVEL_WARNING, format, arglist);
     va_end( arglist );
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_unlock(&printf_mutex);
-#endif
-
     return;
 }
 
 void PLATFORM_PRINTF_DEBUG_INFO(const char *format, ...)
 {
     va_list arglist;
-    uint32_t ts;
 
-    if (verbosity_level < 2)
+    if (verbosity_level < PLATFORM_DEBUG_LEVEL_INFO)
     {
         return;
     }
 
-    ts = PLATFORM_GET_TIMESTAMP();
-
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_lock(&printf_mutex);
-#endif
-
-    printf("[%03d.%03d] ", ts/1000, ts%1000);
-    printf("INFO    : ");
     va_start( arglist, format );
-    vprintf( format, arglist );
+    _logMessage(PLATFORM_DEBUG_LEVEL_INFO, format, arglist);
     va_end( arglist );
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_unlock(&printf_mutex);
-#endif
-
     return;
 }
 
 void PLATFORM_PRINTF_DEBUG_DETAIL(const char *format, ...)
 {
     va_list arglist;
-    uint32_t ts;
 
-    if (verbosity_level < 3)
+    if (verbosity_level < PLATFORM_DEBUG_LEVEL_DETAIL)
     {
         return;
     }
 
-    ts = PLATFORM_GET_TIMESTAMP();
-
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_lock(&printf_mutex);
-#endif
-
-    printf("[%03d.%03d] ", ts/1000, ts%1000);
-    printf("DETAIL  : ");
     va_start( arglist, format );
-    vprintf( format, arglist );
+    _logMessage(PLATFORM_DEBUG_LEVEL_DETAIL, format, arglist);
     va_end( arglist );
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_unlock(&printf_mutex);
-#endif
-
     return;
 }
 
@@ -127,6 +127,40 @@ struct CMDU
 };
 
 
+// A "view" of a TLV contained in a received stream.
+//
+// Instead of a parsed (and dynamically allocated) TLV structure, it only
+// contains the TLV type and length and a pointer to where the TLV starts
+// inside the stream it was found in.
+//
+struct TLV_view
+{
+    uint8_t    type;                 // Any of the TLV_TYPE_* types
+
+    uint16_t   length;               // Length of the TLV value (ie. not
+                                   // counting the type and length fields)
+
+    uint8_t   *stream;               // Points to the first byte (ie. the type)
+                                   // of the TLV inside the received stream.
+                                   // It must be treated as read-only.
+};
+
+// A "view" of a received CMDU: same header fields as "struct CMDU", but
+// instead of a list of parsed TLVs it contains a list of TLV views that point
+// into the received streams (which must then outlive the view)
+//
+struct CMDU_view
+{
+    uint8_t   message_version;
+    uint16_t  message_type;
+    uint16_t  message_id;
+    uint8_t   relay_indicator;
+
+    uint16_t          tlvs_nr;       // Number of elements in 'tlvs'
+    struct TLV_view  *tlvs;          // The "end of message" TLV is not
+                                   // included in this list.
+};
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Main API functions
@@ -241,6 +275,48 @@ struct CMDU
 //
 struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams);
 
+// Same as "parse_1905_CMDU_from_packets()", but instead of parsing each TLV
+// into its own (dynamically allocated) structure, the returned "CMDU_view"
+// only contains the list of TLVs (type, length and position inside the
+// provided 'packet_streams').
+//
+// This is much cheaper than a full parse and it is enough to take decisions
+// based on the CMDU header or on the presence of some TLV (ex: to discard a
+// duplicated CMDU before doing anything else with it). Later, if needed, the
+// TLVs can be converted into regular structures with
+// "materialize_1905_TLV_view()" or "materialize_1905_CMDU_view()".
+//
+// Header checks (fragments consistency, 'relay_indicator' and
+// 'last_fragment_indicator' flags) are the same ones performed by
+// "parse_1905_CMDU_from_packets()". TLV contents (and the TLV rules of each
+// message type) are only checked when materializing.
+//
+// 'packet_streams' is *not* copied: it must not be freed (or modified) while
+// the returned view (or any of its TLV views) is still being used.
+//
+// If any type of error/inconsistency is found, a NULL pointer is returned
+// instead, otherwise remember to free the received structure once you don't
+// need it anymore (using the "free_1905_CMDU_view()" function)
+//
+struct CMDU_view *parse_1905_CMDU_view_from_packets(uint8_t **packet_streams);
+
+// Parses the TLV pointed by 'view' into a regular TLV structure (see
+// "parse_1905_TLV_from_packet()").
+//
+// Returns NULL if the TLV is malformed. Otherwise, the returned structure must
+// be freed with "free_1905_TLV_structure()".
+//
+uint8_t *materialize_1905_TLV_view(const struct TLV_view *view);
+
+// Converts a CMDU view into a regular CMDU structure, exactly as if the
+// streams 'view' was obtained from had been given to
+// "parse_1905_CMDU_from_packets()".
+//
+// Returns NULL in case of error. Otherwise, the returned structure must be
+// freed with "free_1905_CMDU_structure()". 'view' is not freed.
+//
+struct CMDU *materialize_1905_CMDU_view(const struct CMDU_view *view);
+
 
 // This is the opposite of "parse_1905_CMDU_from_packets()": it receives a
 // pointer to a TLV structure and then returns a list of pointers to fragmented
@@ -314,6 +390,18 @@ bool parse_1905_CMDU_header_from_packet(uint8_t *packet_buffer, size_t len, stru
 void free_1905_CMDU_structure(struct CMDU *memory_structure);
 
 
+// Returns a pointer to the first TLV view of type 'tlv_type' contained in
+// 'view', or NULL if there is no such TLV.
+//
+struct TLV_view *find_1905_TLV_view(const struct CMDU_view *view, uint8_t tlv_type);
+
+
+// Frees a view returned by "parse_1905_CMDU_view_from_packets()". The streams
+// it points to are not freed.
+//
+void free_1905_CMDU_view(struct CMDU_view *view);
+
+
 // This function receives a pointer to a list of streams (such as the one
 // returned by 'forge_1905_CMDU_from_structure()' and frees all the associated
 // structures
@@ -1042,6 +1042,24 @@ uint8_t *parse_1905_TLV_from_packet(uint8_t *packet_stream);
 //
 uint8_t *forge_1905_TLV_from_structure(uint8_t *memory_structure, uint16_t *len);
 
+// Same as "forge_1905_TLV_from_structure()", but instead of allocating a new
+// buffer, the TLV is forged directly into the first 'buffer_size' bytes of the
+// provided 'buffer'.
+//
+// The number of bytes written is returned in the "len" output argument.
+//
+// Returns '1' on success, '0' otherwise. If the only problem is that the TLV
+// does not fit in 'buffer_size' bytes, "len" is set to the number of bytes
+// that would be needed (ie. it will be greater than 'buffer_size'), so that the
+// caller can try again somewhere else (ex: in a new fragment).
+//
+uint8_t forge_1905_TLV_into_buffer(uint8_t *memory_structure, uint8_t *buffer, uint16_t buffer_size, uint16_t *len);
+
+// Metadata of all the 1905 TLV types, used both by the functions above and by
+// the generic TLV functions from "tlv.h" (ex: "tlv_parse()", "tlv_forge()").
+//
+extern tlv_defs_t tlv_1905_defs;
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
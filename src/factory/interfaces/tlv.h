@@ -269,6 +269,32 @@ const struct tlv_def *tlv_find_tlv_def(tlv_defs_t defs, const struct tlv *tlv);
  */
 bool tlv_add(tlv_defs_t defs, struct tlv_list *tlvs, struct tlv *tlv);
 
+/** @brief Reserve room in a list of TLVs.
+ *
+ * @param tlvs The TLV list.
+ *
+ * @param tlv_nr The total number of TLVs @a tlvs is expected to hold.
+ *
+ * Makes sure that tlv_add() does not have to reallocate until @a tlvs holds @a tlv_nr TLVs. Without a reservation,
+ * tlv_add() doubles the capacity whenever the list is full. It is never necessary to call this function, it's just a
+ * hint. tlv_parse() already calls it with the number of TLVs in the buffer.
+ */
+void tlv_reserve(struct tlv_list *tlvs, size_t tlv_nr);
+
+/** @brief Parse a single TLV.
+ *
+ * @param defs The TLV metadata.
+ *
+ * @param buffer The buffer to parse, starting at the type field of the TLV.
+ *
+ * @param length The length of @a buffer. It may be larger than the TLV.
+ *
+ * @return NULL in case of error, or the newly allocated TLV. Delete it with tlv_free_single().
+ *
+ * This is a direct jump through the tlv_def::parse entry of the TLV type: no ::tlv_list is allocated.
+ */
+struct tlv *tlv_parse_single(tlv_defs_t defs, const uint8_t *buffer, size_t length);
+
 /** @brief Parse a list of TLVs.
  *
  * @param defs The TLV metadata.
@@ -281,27 +307,81 @@ bool tlv_add(tlv_defs_t defs, struct tlv_list *tlvs, struct tlv *tlv);
  */
 struct tlv_list *tlv_parse(tlv_defs_t defs, const uint8_t *buffer, size_t length);
 
+/** @brief Length of a single forged TLV.
+ *
+ * @param defs The TLV metadata.
+ *
+ * @param tlv The TLV to forge.
+ *
+ * @return The number of bytes tlv_forge_single() will write, including the type and length fields. 0 if @a tlv can't
+ * be forged.
+ *
+ * Use this to size the buffer before forging.
+ */
+size_t tlv_length_single(tlv_defs_t defs, const struct tlv *tlv);
+
+/** @brief Forge a single TLV.
+ *
+ * @param defs The TLV metadata.
+ *
+ * @param tlv The TLV to forge.
+ *
+ * @param buf Buffer in which to forge, updated to point after the TLV.
+ *
+ * @param length Remaining length of @a buf, updated with the number of bytes written.
+ *
+ * @return true if successful, false if @a buf is too small or @a tlv can't be forged.
+ */
+bool tlv_forge_single(tlv_defs_t defs, const struct tlv *tlv, uint8_t **buf, size_t *length);
+
 /** @brief Forge a list of TLVs.
  *
  * @param defs The TLV metadata.
  *
  * @param tlvs The tlvs to forge.
  *
- * @param max_length The maximum length of a single packet.
+ * @param max_length The maximum number of TLV bytes in a single packet, i.e. without @a headroom and @a tailroom.
+ *
+ * @param headroom Number of bytes to reserve in front of the TLVs in each packet, e.g. for the Ethernet and CMDU
+ * headers.
  *
- * @param[out] buffer The forged packets.
+ * @param tailroom Number of bytes to reserve after the TLVs in each packet, e.g. for an end of message TLV.
  *
- * @param[out] length The lengths of the forged packets.
+ * @param[out] buffers Newly allocated array of @a buffers_nr packets. Each packet is @a headroom + its length +
+ * @a tailroom bytes long, and the TLVs start at offset @a headroom. The headroom and tailroom are left uninitialised
+ * for the caller to fill in, so the packet can be sent without copying it again.
  *
- * @return true if successful, false if not.
+ * @param[out] lengths Newly allocated array with the number of TLV bytes in each packet.
  *
- * If this function returns false, it's most likely a programming error.
+ * @param[out] buffers_nr The number of packets.
  *
- * @todo Fragmentation is not implemented at the moment.
+ * @return true if successful, false if not. Use tlv_forge_free() to delete @a buffers and @a lengths.
  *
- * @todo The allocated buffers should have some headroom, so they don't have to be copied again to from a full packet.
+ * TLVs are never split: when the next TLV doesn't fit in @a max_length, a new packet is started. Each TLV is forged
+ * only once, directly in its packet: the exact size of every TLV is computed up front with tlv_length_single().
+ *
+ * If this function returns false, either a single TLV is larger than @a max_length, or it's a programming error.
+ */
+bool tlv_forge(tlv_defs_t defs, const struct tlv_list *tlvs, size_t max_length, size_t headroom, size_t tailroom,
+               uint8_t ***buffers, size_t **lengths, size_t *buffers_nr);
+
+/** @brief Forge an array of TLVs.
+ *
+ * @param tlvs Array of @a tlv_nr TLVs to forge.
+ *
+ * Same as tlv_forge(), for TLVs that are not kept in a struct tlv_list (e.g. the list_of_TLVs of a struct CMDU).
  */
-bool tlv_forge(tlv_defs_t defs, const struct tlv_list *tlvs, size_t max_length, uint8_t **buffer, size_t *length);
+bool tlv_forge_array(tlv_defs_t defs, struct tlv * const *tlvs, size_t tlv_nr, size_t max_length, size_t headroom,
+                     size_t tailroom, uint8_t ***buffers, size_t **lengths, size_t *buffers_nr);
+
+/** @brief Delete the packets returned by tlv_forge(). */
+void tlv_forge_free(uint8_t **buffers, size_t *lengths, size_t buffers_nr);
+
+/** @brief Print a single TLV.
+ *
+ * Same as tlv_print(), for a TLV that is not part of a ::tlv_list.
+ */
+void tlv_print_single(tlv_defs_t defs, const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix);
 
 /** @brief Print a list of TLVs.
  *
@@ -315,6 +395,14 @@ bool tlv_forge(tlv_defs_t defs, const struct tlv_list *tlvs, size_t max_length,
  */
 void tlv_print(tlv_defs_t defs, const struct tlv_list *tlvs, void (*write_function)(const char *fmt, ...), const char *prefix);
 
+/** @brief Delete a single TLV.
+ *
+ * @param defs The TLV metadata.
+ *
+ * @param tlv The TLV to delete, including everything allocated by tlv_def::parse.
+ */
+void tlv_free_single(tlv_defs_t defs, struct tlv *tlv);
+
 /** @brief Delete a list of TLVs.
  *
  * @param defs The TLV metadata.
@@ -325,6 +413,12 @@ void tlv_print(tlv_defs_t defs, const struct tlv_list *tlvs, void (*write_functi
  */
 void tlv_free(tlv_defs_t defs, struct tlv_list *tlvs);
 
+/** @brief Compare two TLVs.
+ *
+ * @return true if @a tlv1 and @a tlv2 have the same type and are equal according to tlv_def::compare.
+ */
+bool tlv_compare_single(tlv_defs_t defs, const struct tlv *tlv1, const struct tlv *tlv2);
+
 /** @brief Compare two TLV lists.
  *
  * @param tlvs1 The left-hand side list of TLVs to compare.
@@ -752,8 +752,8 @@ uint8_t *parse_1905_ALME_from_packet(uint8_t *packet_stream)
                         {
                             free_1905_TLV_structure((uint8_t *)tx);
                         }
-                        free(ret->metrics);
-                        free(ret);
+                        memfree(ret->metrics);
+                        memfree(ret);
                         return NULL;
                     }
 
@@ -777,8 +777,8 @@ uint8_t *parse_1905_ALME_from_packet(uint8_t *packet_stream)
                         {
                             free_1905_TLV_structure((uint8_t *)rx);
                         }
-                        free(ret->metrics);
-                        free(ret);
+                        memfree(ret->metrics);
+                        memfree(ret);
                         return NULL;
                     }
 
@@ -1291,7 +1291,7 @@ uint8_t *forge_1905_ALME_from_structure(uint8_t *memory_structure, uint16_t *len
                     // Malformed packet
                     //
                     *len = 0;
-                    free(ret);
+                    memfree(ret);
                     return NULL;
                 }
 
@@ -1301,7 +1301,7 @@ uint8_t *forge_1905_ALME_from_structure(uint8_t *memory_structure, uint16_t *len
                     // Forging error
                     //
                     *len = 0;
-                    free(ret);
+                    memfree(ret);
                     return NULL;
                 }
                 _InB( metric_stream,  &p, metric_stream_len);
@@ -1313,7 +1313,7 @@ uint8_t *forge_1905_ALME_from_structure(uint8_t *memory_structure, uint16_t *len
                     // Forging error
                     //
                     *len = 0;
-                    free(ret);
+                    memfree(ret);
                     return NULL;
                 }
                 _InB( metric_stream,  &p, metric_stream_len);
@@ -1405,7 +1405,7 @@ void free_1905_ALME_structure(uint8_t *memory_structure)
         case ALME_TYPE_GET_METRIC_REQUEST:
         case ALME_TYPE_CUSTOM_COMMAND_REQUEST:
         {
-            free(memory_structure);
+            memfree(memory_structure);
 
             return;
         }
@@ -1427,15 +1427,15 @@ void free_1905_ALME_structure(uint8_t *memory_structure)
                         {
                             if (NULL != m->interface_descriptors[i].vendor_specific_info[j].vendor_si)
                             {
-                                free(m->interface_descriptors[i].vendor_specific_info[j].vendor_si);
+                                memfree(m->interface_descriptors[i].vendor_specific_info[j].vendor_si);
                             }
                         }
-                        free(m->interface_descriptors[i].vendor_specific_info);
+                        memfree(m->interface_descriptors[i].vendor_specific_info);
                     }
                 }
-                free(m->interface_descriptors);
+                memfree(m->interface_descriptors);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -1448,9 +1448,9 @@ void free_1905_ALME_structure(uint8_t *memory_structure)
 
             if (m->addresses_nr >0 && NULL != m->addresses)
             {
-                free(m->addresses);
+                memfree(m->addresses);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -1468,12 +1468,12 @@ void free_1905_ALME_structure(uint8_t *memory_structure)
                 {
                     if (m->rules[i].addresses)
                     {
-                        free(m->rules[i].addresses);
+                        memfree(m->rules[i].addresses);
                     }
                 }
-                free(m->rules);
+                memfree(m->rules);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -1486,9 +1486,9 @@ void free_1905_ALME_structure(uint8_t *memory_structure)
 
             if (m->addresses_nr > 0 && NULL != m->addresses)
             {
-                free(m->addresses);
+                memfree(m->addresses);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -1507,9 +1507,9 @@ void free_1905_ALME_structure(uint8_t *memory_structure)
                     free_1905_TLV_structure((uint8_t *)m->metrics[i].tx_metric);
                     free_1905_TLV_structure((uint8_t *)m->metrics[i].rx_metric);
                 }
-                free(m->metrics);
+                memfree(m->metrics);
             }
-            free(m);
+            memfree(m);
 
 
             return;
@@ -1523,9 +1523,9 @@ void free_1905_ALME_structure(uint8_t *memory_structure)
 
             if (m->bytes_nr > 0 && NULL != m->bytes)
             {
-                free(m->bytes);
+                memfree(m->bytes);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
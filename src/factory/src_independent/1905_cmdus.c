@@ -512,14 +512,13 @@ static uint8_t _check_CMDU_rules(const struct CMDU *p, uint8_t rules_type)
 // Actual API functions
 ////////////////////////////////////////////////////////////////////////////////
 
-struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
+struct CMDU_view *parse_1905_CMDU_view_from_packets(uint8_t **packet_streams)
 {
-    struct CMDU *ret;
+    struct CMDU_view *ret;
 
     uint8_t  fragments_nr;
     uint8_t  current_fragment;
-
-    uint8_t  tlvs_nr;
+    uint16_t tlvs_max;
 
     uint8_t  error;
 
@@ -547,13 +546,13 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
     }
 
     // Allocate the return structure.
-    // Initially it will contain an empty list of TLVs that we will later
+    // Initially it will contain an empty list of TLV views that we will later
     // re-allocate and fill.
     //
-    ret = (struct CMDU *)memalloc(sizeof(struct CMDU) * 1);
-    ret->list_of_TLVs = (uint8_t **)memalloc(sizeof(uint8_t *) * 1);
-    ret->list_of_TLVs[0] = NULL;
-    tlvs_nr = 0;
+    ret = (struct CMDU_view *)memalloc(sizeof(struct CMDU_view) * 1);
+    ret->tlvs    = NULL;
+    ret->tlvs_nr = 0;
+    tlvs_max     = 0;
 
     // Next, parse each fragment
     //
@@ -573,8 +572,6 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
         uint8_t   relay_indicator;
         uint8_t   last_fragment_indicator;
 
-        uint8_t *parsed;
-
         // We want to traverse fragments in order, thus lets search for the
         // fragment whose 'fragment_id' matches 'current_fragment' (which will
         // monotonically increase starting at '0')
@@ -683,63 +680,64 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
             break;
         }
 
-        // We can now parse the TLVs. 'p' is pointing to the first one at this
-        // moment
+        // We can now find where each TLV starts. 'p' is pointing to the first
+        // one at this moment. TLVs are *not* parsed here (see
+        // "materialize_1905_CMDU_view()")
         //
         while (1)
         {
-            parsed = parse_1905_TLV_from_packet(p);
-            if (NULL == parsed)
-            {
-                // Error while parsing a TLV
-                // Dump TLV for visual inspection
-
-                uint8_t *p2 = p;
-                uint16_t len;
-                uint8_t  aux;
+            uint8_t  *tlv_start;
+            uint8_t   tlv_type;
+            uint16_t  tlv_len;
 
-                _E1B(&p2, &aux);
-                _E2B(&p2, &len);
+            tlv_start = p;
 
-                PLATFORM_PRINTF_DEBUG_WARNING("Parsing error TLV type %u. Dumping bytes: \n", aux);
-
-                // Limit dump length
-                //
-                if (len > 200)
-                {
-                    len = 200;
-                }
-
-                print_callback(PLATFORM_PRINTF_DEBUG_WARNING, "", len, "Payload", "%02x", p2);
-                error = 6;
-                break;
-            }
+            _E1B(&p, &tlv_type);
+            _E2B(&p, &tlv_len);
 
-            if (TLV_TYPE_END_OF_MESSAGE == *parsed)
+            if (TLV_TYPE_END_OF_MESSAGE == tlv_type)
             {
                 // No more TLVs
                 //
-                free_1905_TLV_structure(parsed);
                 break;
             }
 
             // Advance 'p' to the next TLV.
             //
-            uint8_t  tlv_type;
-            uint16_t tlv_len;
-
-            _E1B(&p, &tlv_type);
-            _E2B(&p, &tlv_len);
-
             p += tlv_len;
 
-            // Add this new TLV to the list (the list needs to be re-allocated
-            // with more space first)
+            // Add this new TLV to the list (when the list is full, its
+            // capacity is doubled so that CMDUs with hundreds of TLVs are not
+            // copied over and over again)
             //
-            tlvs_nr++;
-            ret->list_of_TLVs = (uint8_t **)memrealloc(ret->list_of_TLVs, sizeof(uint8_t *) * (tlvs_nr+1));
-            ret->list_of_TLVs[tlvs_nr-1] = parsed;
-            ret->list_of_TLVs[tlvs_nr]   = NULL;
+            if (ret->tlvs_nr == tlvs_max)
+            {
+                if (UINT16_MAX == tlvs_max)
+                {
+                    // 'tlvs_nr' cannot count any more TLVs (this can only
+                    // happen with a huge number of tiny fragmented TLVs)
+                    //
+                    error = 6;
+                    break;
+                }
+                else if (0 == tlvs_max)
+                {
+                    tlvs_max = 8;
+                }
+                else if (tlvs_max > UINT16_MAX / 2)
+                {
+                    tlvs_max = UINT16_MAX;
+                }
+                else
+                {
+                    tlvs_max = 2 * tlvs_max;
+                }
+                ret->tlvs = (struct TLV_view *)memrealloc(ret->tlvs, sizeof(struct TLV_view) * tlvs_max);
+            }
+            ret->tlvs_nr++;
+            ret->tlvs[ret->tlvs_nr-1].type   = tlv_type;
+            ret->tlvs[ret->tlvs_nr-1].length = tlv_len;
+            ret->tlvs[ret->tlvs_nr-1].stream = tlv_start;
         }
         if (0 != error)
         {
@@ -747,6 +745,82 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
         }
     }
 
+    if (0 != error)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Parsing error %d\n", error);
+        free_1905_CMDU_view(ret);
+        return NULL;
+    }
+
+    return ret;
+}
+
+uint8_t *materialize_1905_TLV_view(const struct TLV_view *view)
+{
+    if (NULL == view)
+    {
+        return NULL;
+    }
+
+    return parse_1905_TLV_from_packet(view->stream);
+}
+
+struct CMDU *materialize_1905_CMDU_view(const struct CMDU_view *view)
+{
+    struct CMDU *ret;
+
+    uint16_t  i;
+
+    uint8_t  error;
+
+    if (NULL == view)
+    {
+        return NULL;
+    }
+
+    // Allocate the return structure. The number of TLVs is already known, thus
+    // the list can be allocated at once.
+    //
+    ret = (struct CMDU *)memalloc(sizeof(struct CMDU) * 1);
+    ret->message_version = view->message_version;
+    ret->message_type    = view->message_type;
+    ret->message_id      = view->message_id;
+    ret->relay_indicator = view->relay_indicator;
+    ret->list_of_TLVs    = (uint8_t **)memalloc(sizeof(uint8_t *) * (view->tlvs_nr + 1));
+    ret->list_of_TLVs[0] = NULL;
+
+    error = 0;
+    for (i=0; i<view->tlvs_nr; i++)
+    {
+        uint8_t *parsed;
+
+        parsed = parse_1905_TLV_from_packet(view->tlvs[i].stream);
+        if (NULL == parsed)
+        {
+            // Error while parsing a TLV
+            // Dump TLV for visual inspection
+
+            uint16_t len;
+
+            PLATFORM_PRINTF_DEBUG_WARNING("Parsing error TLV type %u. Dumping bytes: \n", view->tlvs[i].type);
+
+            // Limit dump length
+            //
+            len = view->tlvs[i].length;
+            if (len > 200)
+            {
+                len = 200;
+            }
+
+            print_callback(PLATFORM_PRINTF_DEBUG_WARNING, "", len, "Payload", "%02x", view->tlvs[i].stream + 3);
+            error = 6;
+            break;
+        }
+
+        ret->list_of_TLVs[i]   = parsed;
+        ret->list_of_TLVs[i+1] = NULL;
+    }
+
     if (0 == error)
     {
         // Ok then... we now have our output structure properly filled.
@@ -784,8 +858,6 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
 
                     if (NULL != ret->list_of_TLVs)
                     {
-                        uint8_t i;
-
                         i = 0;
                         while (ret->list_of_TLVs[i])
                         {
@@ -841,20 +913,35 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
 }
 
 
-uint8_t **forge_1905_CMDU_from_structure(const struct CMDU *memory_structure, uint16_t **lens)
+
+struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
 {
-    uint8_t **ret;
+    struct CMDU      *ret;
+    struct CMDU_view *view;
 
-    uint8_t tlv_start;
-    uint8_t tlv_stop;
+    view = parse_1905_CMDU_view_from_packets(packet_streams);
+    if (NULL == view)
+    {
+        return NULL;
+    }
 
-    uint8_t fragments_nr;
+    ret = materialize_1905_CMDU_view(view);
 
-    uint32_t max_tlvs_block_size;
+    free_1905_CMDU_view(view);
 
-    uint8_t error;
+    return ret;
+}
 
-    error = 0;
+
+uint8_t **forge_1905_CMDU_from_structure(const struct CMDU *memory_structure, uint16_t **lens)
+{
+    uint8_t **ret;
+    size_t   *tlvs_lengths;
+    size_t    fragments_nr;
+    size_t    tlvs_nr;
+    size_t    i;
+
+    uint32_t max_tlvs_block_size;
 
     if (NULL == memory_structure || NULL == lens)
     {
@@ -878,18 +965,6 @@ uint8_t **forge_1905_CMDU_from_structure(const struct CMDU *memory_structure, ui
         return NULL;
     }
 
-    // Allocate the return streams.
-    // Initially we will just have an empty list (ie. it contains a single
-    // element marking the end-of-list: a NULL pointer)
-    //
-    ret = (uint8_t **)memalloc(sizeof(uint8_t *) * 1);
-    ret[0] = NULL;
-
-    *lens = (uint16_t *)memalloc(sizeof(uint16_t) * 1);
-    (*lens)[0] = 0;
-
-    fragments_nr = 0;
-
     // Let's create as many streams as needed so that all of them fit in
     // MAX_NETWORK_SEGMENT_SIZE bytes.
     //
@@ -913,95 +988,56 @@ uint8_t **forge_1905_CMDU_from_structure(const struct CMDU *memory_structure, ui
     // 2 - 1 - 1 - 2 - 2 - 1 - 1 - 3 = MAX_NETWORK_SEGMENT_SIZE - 25 bytes.
     //
     max_tlvs_block_size = MAX_NETWORK_SEGMENT_SIZE - 25;
-    tlv_start           = 0;
-    tlv_stop            = 0;
-    do
-    {
-        uint8_t *s;
-        uint8_t  i;
-
-        uint16_t current_X_size;
-
-        uint8_t reserved_field;
-        uint8_t fragment_id;
-        uint8_t indicators;
-
-        uint8_t no_space;
 
-        current_X_size = 0;
-        no_space       = 0;
-        while(memory_structure->list_of_TLVs[tlv_stop])
-        {
-            uint8_t  *p;
-            uint8_t  *tlv_stream;
-            uint16_t  tlv_stream_size;
-
-            p = memory_structure->list_of_TLVs[tlv_stop];
-
-            tlv_stream = forge_1905_TLV_from_structure(p, &tlv_stream_size);
-            free(tlv_stream);
+    // "tlv_forge_array()" decides where each fragment starts and forges every
+    // TLV (only once) directly into its fragment, leaving room for the 8 bytes
+    // of the CMDU header in front and for the end of message TLV at the end.
+    // Note that the X size must be *strictly* smaller than
+    // 'max_tlvs_block_size'.
+    //
+    tlvs_nr = 0;
+    while (NULL != memory_structure->list_of_TLVs[tlvs_nr])
+    {
+        tlvs_nr++;
+    }
 
-            if (current_X_size + tlv_stream_size < max_tlvs_block_size)
-            {
-                tlv_stop++;
-            }
-            else
-            {
-                // There is no space for more TLVs
-                //
-                no_space = 1;
-                break;
-            }
+    if (!tlv_forge_array(tlv_1905_defs, (struct tlv * const *)memory_structure->list_of_TLVs, tlvs_nr,
+                         max_tlvs_block_size - 1, 8, 3, &ret, &tlvs_lengths, &fragments_nr))
+    {
+        return NULL;
+    }
+    if (fragments_nr > 0xff)
+    {
+        // The fragment ID is a single byte
+        //
+        PLATFORM_PRINTF_DEBUG_ERROR("CMDU needs %u fragments\n", (unsigned)fragments_nr);
+        tlv_forge_free(ret, tlvs_lengths, fragments_nr);
+        return NULL;
+    }
 
-            current_X_size += tlv_stream_size;
-        }
-        if (tlv_start == tlv_stop)
-        {
-            if (1 == no_space)
-            {
-                // One *single* TLV does not fit in a fragment!
-                // This is an error... there is no way to split one single TLV into
-                // several fragments according to the standard.
-                //
-                error = 1;
-                break;
-            }
-            else
-            {
-                // If we end up here, it means tlv_start = tlv_stop = 0 --> this
-                // CMDU contains no TLVs (which is something that can happen...
-                // for example, in the "topology query" CMDU).
-                // Just keep executing...
-            }
-        }
+    // The returned list of streams ends with a NULL pointer (and the list of
+    // lengths with a 0)
+    //
+    ret   = (uint8_t **)memrealloc(ret, sizeof(uint8_t *) * (fragments_nr + 1));
+    *lens = (uint16_t *)memalloc(sizeof(uint16_t) * (fragments_nr + 1));
 
-        // Now that we know how many TLVs are going to be embedded inside this
-        // fragment (from 'tlv_start' up to -and not including- 'tlv_stop'),
-        // let's build it
-        //
-        fragments_nr++;
+    ret[fragments_nr]     = NULL;
+    (*lens)[fragments_nr] = 0;
 
-        ret = (uint8_t **)memrealloc(ret, sizeof(uint8_t *) * (fragments_nr + 1));
-        ret[fragments_nr-1] = (uint8_t *)memalloc(MAX_NETWORK_SEGMENT_SIZE);
-        ret[fragments_nr]   = NULL;
+    for (i=0; i<fragments_nr; i++)
+    {
+        uint8_t *s;
 
-        *lens = (uint16_t *)memrealloc(*lens, sizeof(uint16_t *) * (fragments_nr + 1));
-        (*lens)[fragments_nr-1] = 0; // To be updated a few lines later
-        (*lens)[fragments_nr]   = 0;
+        uint8_t reserved_field;
+        uint8_t fragment_id;
+        uint8_t indicators;
 
-        s = ret[fragments_nr-1];
+        s = ret[i];
 
         reserved_field = 0;
-        fragment_id    = fragments_nr-1;
+        fragment_id    = i;
         indicators     = 0;
 
-        // Set 'last_fragment_indicator' flag (bit #7)
-        //
-        if (NULL == memory_structure->list_of_TLVs[tlv_stop])
-        {
-            indicators |= 1 << 7;
-        }
-
         // Set 'relay_indicator' flag (bit #6)
         //
         if (0xff == _relayed_CMDU[memory_structure->message_type])
@@ -1018,6 +1054,13 @@ uint8_t **forge_1905_CMDU_from_structure(const struct CMDU *memory_structure, ui
             indicators |= _relayed_CMDU[memory_structure->message_type] << 6;
         }
 
+        // Set 'last_fragment_indicator' flag (bit #7)
+        //
+        if (i == fragments_nr - 1)
+        {
+            indicators |= 1 << 7;
+        }
+
         _I1B(&memory_structure->message_version, &s);
         _I1B(&reserved_field,                    &s);
         _I2B(&memory_structure->message_type,    &s);
@@ -1025,47 +1068,22 @@ uint8_t **forge_1905_CMDU_from_structure(const struct CMDU *memory_structure, ui
         _I1B(&fragment_id,                       &s);
         _I1B(&indicators,                        &s);
 
-        for (i=tlv_start; i<tlv_stop; i++)
-        {
-            uint8_t  *tlv_stream;
-            uint16_t  tlv_stream_size;
-
-            tlv_stream = forge_1905_TLV_from_structure(memory_structure->list_of_TLVs[i], &tlv_stream_size);
-
-            memcpy(s, tlv_stream, tlv_stream_size);
-            free(tlv_stream);
-
-            s += tlv_stream_size;
-        }
-
-        // Don't forget to add the last three octects representing the
-        // TLV_TYPE_END_OF_MESSAGE message
+        // The TLVs are already there. Don't forget to add the last three
+        // octects representing the TLV_TYPE_END_OF_MESSAGE message
         //
+        s += tlvs_lengths[i];
+
         *s = 0x0; s++;
         *s = 0x0; s++;
         *s = 0x0; s++;
 
         // Update the length return value
         //
-        (*lens)[fragments_nr-1] = s - ret[fragments_nr-1];
-
-        // And advance the TLV pointer so that, if more fragments are needed,
-        // the next one starts where we have stopped.
-        //
-        tlv_start = tlv_stop;
-
-    } while(memory_structure->list_of_TLVs[tlv_start]);
-
-    // Finally! If we get this far without errors we are already done, otherwise
-    // free everything and return NULL
-    //
-    if (0 != error)
-    {
-        free_1905_CMDU_packets(ret);
-        free(*lens);
-        return NULL;
+        (*lens)[i] = s - ret[i];
     }
 
+    memfree(tlvs_lengths);
+
     return ret;
 }
 
@@ -1114,6 +1132,37 @@ bool parse_1905_CMDU_header_from_packet(uint8_t *packet_buffer, size_t len, stru
 }
 
 
+struct TLV_view *find_1905_TLV_view(const struct CMDU_view *view, uint8_t tlv_type)
+{
+    uint16_t i;
+
+    if (NULL == view)
+    {
+        return NULL;
+    }
+
+    for (i=0; i<view->tlvs_nr; i++)
+    {
+        if (tlv_type == view->tlvs[i].type)
+        {
+            return &view->tlvs[i];
+        }
+    }
+
+    return NULL;
+}
+
+void free_1905_CMDU_view(struct CMDU_view *view)
+{
+    if (NULL == view)
+    {
+        return;
+    }
+
+    memfree(view->tlvs);
+    memfree(view);
+}
+
 void free_1905_CMDU_structure(struct CMDU *memory_structure)
 {
 
@@ -1127,10 +1176,10 @@ void free_1905_CMDU_structure(struct CMDU *memory_structure)
             free_1905_TLV_structure(memory_structure->list_of_TLVs[i]);
             i++;
         }
-        free(memory_structure->list_of_TLVs);
+        memfree(memory_structure->list_of_TLVs);
     }
 
-    free(memory_structure);
+    memfree(memory_structure);
 
     return;
 }
@@ -1148,10 +1197,10 @@ void free_1905_CMDU_packets(uint8_t **packet_streams)
     i = 0;
     while (packet_streams[i])
     {
-        free(packet_streams[i]);
+        memfree(packet_streams[i]);
         i++;
     }
-    free(packet_streams);
+    memfree(packet_streams);
 
     return;
 }
@@ -58,36 +58,6 @@
 #include <stdio.h>  // snprintf
 
 
-
-/** This is a hack to get access to the internals of tlv_list, as a backward-compatibility measure until all of
- * 1905_tlvs supports the new tlv definition interface.
- * @{
- */
-struct tlv_list
-{
-    size_t tlv_nr;
-    struct tlv **tlvs;
-};
-
-static struct tlv_list *alloc_dummy_tlv_list(uint8_t *tlv)
-{
-    struct tlv_list *tlvs = memalloc(sizeof(struct tlv_list));
-    tlvs->tlvs = memalloc(sizeof(struct tlv *));
-    tlvs->tlv_nr = 1;
-    tlvs->tlvs[0] = (struct tlv*)tlv;
-    return tlvs;
-}
-
-static uint8_t *free_dummy_tlv_list(struct tlv_list *tlvs)
-{
-    struct tlv *ret = tlvs->tlvs[0];
-    free(tlvs->tlvs);
-    free(tlvs);
-    return (uint8_t *)ret;
-}
-
-/** @} */
-
 // Buffer size to store a prefix string that will be used to show each
 // element of a structure on screen
 //
@@ -178,7 +148,7 @@ static void tlv_print_field2_supportedService(const struct supportedServiceTLV *
 
 static void tlv_free_body_supportedService(const struct supportedServiceTLV *self)
 {
-    free(self->supported_service);
+    memfree(self->supported_service);
 }
 
 static bool tlv_compare_field2_supportedService(const struct supportedServiceTLV *self1,
@@ -389,7 +359,7 @@ static bool tlv_forge_field2_vendorSpecific(const struct vendorSpecificTLV *self
 
 static void tlv_free_body_vendorSpecific(const struct vendorSpecificTLV *self)
 {
-    free(self->m);
+    memfree(self->m);
 }
 
 static void tlv_print_field2_vendorSpecific(const struct vendorSpecificTLV *self,
@@ -443,6 +413,391 @@ static bool tlv_compare_field2_vendorSpecific(const struct vendorSpecificTLV *se
 
 /** @} */
 
+/** @brief Support functions for linkMetricResultCode TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.13
+ *
+ * @{
+ */
+
+#define TLV_NAME          linkMetricResultCode
+#define TLV_FIELD1_NAME   result_code
+#define TLV_FIELD1_LENGTH 1
+#define TLV_FORGE         1
+
+static bool tlv_forge_field1_linkMetricResultCode(const struct linkMetricResultCodeTLV *self,
+                                                  uint8_t **buf,
+                                                  size_t *length)
+{
+    if (self->result_code != LINK_METRIC_RESULT_CODE_TLV_INVALID_NEIGHBOR)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("Invalid link metric result code 0x%02x\n", self->result_code);
+        return false;
+    }
+    return _I1BL(&self->result_code, buf, length);
+}
+
+#include <tlv_template.h>
+
+/** @} */
+
+/** Forge a role that is only allowed to be IEEE80211_ROLE_REGISTRAR, shared by searchedRole and supportedRole. */
+static bool _forgeRegistrarRole(const uint8_t *role, uint8_t **buf, size_t *length)
+{
+    if (*role != IEEE80211_ROLE_REGISTRAR)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("Invalid role 0x%02x\n", *role);
+        return false;
+    }
+    return _I1BL(role, buf, length);
+}
+
+/** Forge one of the IEEE80211_FREQUENCY_BAND_* values, shared by autoconfigFreqBand and supportedFreqBand. */
+static bool _forgeFreqBand(const uint8_t *freq_band, uint8_t **buf, size_t *length)
+{
+    if (
+         (*freq_band != IEEE80211_FREQUENCY_BAND_2_4_GHZ) &&
+         (*freq_band != IEEE80211_FREQUENCY_BAND_5_GHZ)   &&
+         (*freq_band != IEEE80211_FREQUENCY_BAND_60_GHZ)
+       )
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("Invalid frequency band 0x%02x\n", *freq_band);
+        return false;
+    }
+    return _I1BL(freq_band, buf, length);
+}
+
+/** @brief Support functions for searchedRole TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.14
+ *
+ * @{
+ */
+
+#define TLV_NAME          searchedRole
+#define TLV_FIELD1_NAME   role
+#define TLV_FIELD1_LENGTH 1
+#define TLV_FORGE         1
+
+static bool tlv_forge_field1_searchedRole(const struct searchedRoleTLV *self,
+                                          uint8_t **buf,
+                                          size_t *length)
+{
+    return _forgeRegistrarRole(&self->role, buf, length);
+}
+
+#include <tlv_template.h>
+
+/** @} */
+
+/** @brief Support functions for autoconfigFreqBand TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.15
+ *
+ * @{
+ */
+
+#define TLV_NAME          autoconfigFreqBand
+#define TLV_FIELD1_NAME   freq_band
+#define TLV_FIELD1_LENGTH 1
+#define TLV_FORGE         1
+
+static bool tlv_forge_field1_autoconfigFreqBand(const struct autoconfigFreqBandTLV *self,
+                                                uint8_t **buf,
+                                                size_t *length)
+{
+    return _forgeFreqBand(&self->freq_band, buf, length);
+}
+
+#include <tlv_template.h>
+
+/** @} */
+
+/** @brief Support functions for supportedRole TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.16
+ *
+ * @{
+ */
+
+#define TLV_NAME          supportedRole
+#define TLV_FIELD1_NAME   role
+#define TLV_FIELD1_LENGTH 1
+#define TLV_FORGE         1
+
+static bool tlv_forge_field1_supportedRole(const struct supportedRoleTLV *self,
+                                           uint8_t **buf,
+                                           size_t *length)
+{
+    return _forgeRegistrarRole(&self->role, buf, length);
+}
+
+#include <tlv_template.h>
+
+/** @} */
+
+/** @brief Support functions for supportedFreqBand TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.17
+ *
+ * @{
+ */
+
+#define TLV_NAME          supportedFreqBand
+#define TLV_FIELD1_NAME   freq_band
+#define TLV_FIELD1_LENGTH 1
+#define TLV_FORGE         1
+
+static bool tlv_forge_field1_supportedFreqBand(const struct supportedFreqBandTLV *self,
+                                               uint8_t **buf,
+                                               size_t *length)
+{
+    return _forgeFreqBand(&self->freq_band, buf, length);
+}
+
+#include <tlv_template.h>
+
+/** @} */
+
+/** @brief Support functions for wsc TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.18
+ *
+ * The frame size is not on the wire: it is the length of the TLV.
+ *
+ * @{
+ */
+
+#define TLV_NAME          wsc
+#define TLV_FIELD1_NAME   wsc_frame
+#define TLV_PARSE         1
+#define TLV_FORGE         1
+#define TLV_PRINT         1
+#define TLV_COMPARE       1
+#define TLV_LENGTH_BODY
+#define TLV_FREE_BODY
+
+static bool tlv_parse_field1_wsc(const struct tlv_def *def __attribute__((unused)),
+                                 struct wscTLV *self,
+                                 const uint8_t **buf,
+                                 size_t *length)
+{
+    self->wsc_frame_size = *length;
+    if (0 == self->wsc_frame_size)
+    {
+        return true;
+    }
+    self->wsc_frame = memalloc(self->wsc_frame_size);
+    return _EnBL(buf, self->wsc_frame, self->wsc_frame_size, length);
+}
+
+static uint16_t tlv_length_body_wsc(const struct wscTLV *self)
+{
+    return self->wsc_frame_size;
+}
+
+static bool tlv_forge_field1_wsc(const struct wscTLV *self,
+                                 uint8_t **buf,
+                                 size_t *length)
+{
+    return _InBL(self->wsc_frame, buf, self->wsc_frame_size, length);
+}
+
+static void tlv_free_body_wsc(const struct wscTLV *self)
+{
+    memfree(self->wsc_frame);
+}
+
+static void tlv_print_field1_wsc(const struct wscTLV *self,
+                                 void (*write_function)(const char *fmt, ...),
+                                 const char *prefix)
+{
+    print_callback(write_function, prefix, sizeof(self->wsc_frame_size), "wsc_frame_size", "%d", &self->wsc_frame_size);
+    print_callback(write_function, prefix, self->wsc_frame_size, "wsc_frame", "0x%02x", self->wsc_frame);
+}
+
+static bool tlv_compare_field1_wsc(const struct wscTLV *self1,
+                                   const struct wscTLV *self2)
+{
+    if (self1->wsc_frame_size != self2->wsc_frame_size)
+        return false;
+    else if (memcmp(self1->wsc_frame, self2->wsc_frame, self1->wsc_frame_size) != 0)
+        return false;
+    else
+        return true;
+}
+
+#include <tlv_template.h>
+
+/** @} */
+
+/** @brief Support functions for pushButtonJoinNotification TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.20
+ *
+ * @{
+ */
+
+#define TLV_NAME          pushButtonJoinNotification
+#define TLV_FIELD1_NAME   al_mac_address
+#define TLV_FIELD2_NAME   message_identifier
+#define TLV_FIELD2_LENGTH 2
+#define TLV_FIELD3_NAME   mac_address
+#define TLV_FIELD4_NAME   new_mac_address
+
+#include <tlv_template.h>
+
+/** @} */
+
+/** @brief Support functions for deviceIdentificationType TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.22
+ *
+ * The fields are fixed-size, so only printing needs to be customised.
+ *
+ * @{
+ */
+
+#define TLV_NAME          deviceIdentificationType
+#define TLV_FIELD1_NAME   friendly_name
+#define TLV_FIELD2_NAME   manufacturer_name
+#define TLV_FIELD3_NAME   manufacturer_model
+#define TLV_PRINT         0b111
+
+static void tlv_print_field1_deviceIdentificationType(const struct deviceIdentificationTypeTLV *self,
+                                                      void (*write_function)(const char *fmt, ...),
+                                                      const char *prefix)
+{
+    print_callback(write_function, prefix, sizeof(self->friendly_name), "friendly_name", "%s", self->friendly_name);
+}
+
+static void tlv_print_field2_deviceIdentificationType(const struct deviceIdentificationTypeTLV *self,
+                                                      void (*write_function)(const char *fmt, ...),
+                                                      const char *prefix)
+{
+    print_callback(write_function, prefix, sizeof(self->manufacturer_name), "manufacturer_name", "%s",
+                   self->manufacturer_name);
+}
+
+static void tlv_print_field3_deviceIdentificationType(const struct deviceIdentificationTypeTLV *self,
+                                                      void (*write_function)(const char *fmt, ...),
+                                                      const char *prefix)
+{
+    print_callback(write_function, prefix, sizeof(self->manufacturer_model), "manufacturer_model", "%s",
+                   self->manufacturer_model);
+}
+
+#include <tlv_template.h>
+
+/** @} */
+
+/** @brief Support functions for controlUrlType TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.23
+ *
+ * The URL is forged including its terminating NUL character.
+ *
+ * @{
+ */
+
+#define TLV_NAME          controlUrlType
+#define TLV_FIELD1_NAME   url
+#define TLV_PARSE         1
+#define TLV_FORGE         1
+#define TLV_PRINT         1
+#define TLV_COMPARE       1
+#define TLV_LENGTH_BODY
+#define TLV_FREE_BODY
+
+static bool tlv_parse_field1_controlUrlType(const struct tlv_def *def __attribute__((unused)),
+                                            struct controlUrlTypeTLV *self,
+                                            const uint8_t **buf,
+                                            size_t *length)
+{
+    size_t url_len = *length;
+
+    if (0 == url_len)
+    {
+        return true;
+    }
+    /* Always NUL-terminate, even if the sender didn't. */
+    self->url = memalloc(url_len + 1);
+    self->url[url_len] = '\0';
+    return _EnBL(buf, self->url, url_len, length);
+}
+
+static uint16_t tlv_length_body_controlUrlType(const struct controlUrlTypeTLV *self)
+{
+    return NULL == self->url ? 0 : strlen(self->url) + 1;
+}
+
+static bool tlv_forge_field1_controlUrlType(const struct controlUrlTypeTLV *self,
+                                            uint8_t **buf,
+                                            size_t *length)
+{
+    if (NULL == self->url)
+    {
+        return true;
+    }
+    return _InBL(self->url, buf, strlen(self->url) + 1, length);
+}
+
+static void tlv_free_body_controlUrlType(const struct controlUrlTypeTLV *self)
+{
+    memfree(self->url);
+}
+
+static void tlv_print_field1_controlUrlType(const struct controlUrlTypeTLV *self,
+                                            void (*write_function)(const char *fmt, ...),
+                                            const char *prefix)
+{
+    if (NULL != self->url)
+    {
+        print_callback(write_function, prefix, strlen(self->url) + 1, "url", "%s", self->url);
+    }
+}
+
+static bool tlv_compare_field1_controlUrlType(const struct controlUrlTypeTLV *self1,
+                                              const struct controlUrlTypeTLV *self2)
+{
+    if (NULL == self1->url || NULL == self2->url)
+        return self1->url == self2->url;
+    else
+        return strcmp(self1->url, self2->url) == 0;
+}
+
+#include <tlv_template.h>
+
+/** @} */
+
+/** @brief Support functions for x1905ProfileVersion TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.27
+ *
+ * @{
+ */
+
+#define TLV_NAME          x1905ProfileVersion
+#define TLV_FIELD1_NAME   profile
+#define TLV_FIELD1_LENGTH 1
+#define TLV_FORGE         1
+
+static bool tlv_forge_field1_x1905ProfileVersion(const struct x1905ProfileVersionTLV *self,
+                                                 uint8_t **buf,
+                                                 size_t *length)
+{
+    if (self->profile != PROFILE_1905_1 && self->profile != PROFILE_1905_1A)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("Invalid 1905 profile 0x%02x\n", self->profile);
+        return false;
+    }
+    return _I1BL(&self->profile, buf, length);
+}
+
+#include <tlv_template.h>
+
+/** @} */
+
 /** @brief Support functions for apOperationalBss TLV.
  *
  * See "Multi-AP Specification Version 1.0" Section 17.2.1
@@ -570,9 +925,9 @@ static void tlv_free_body_apOperationalBss(const struct apOperationalBssTLV *sel
     uint8_t i;
     for (i = 0; i < self->radio_nr; i++)
     {
-        free(self->radio[i].bss);
+        memfree(self->radio[i].bss);
     }
-    free(self->radio);
+    memfree(self->radio);
 }
 
 static bool tlv_compare_field2_apOperationalBss(const struct apOperationalBssTLV *self1,
@@ -715,9 +1070,9 @@ static void tlv_free_body_associatedClients(const struct associatedClientsTLV *s
     uint8_t i;
     for (i = 0; i < self->bss_nr; i++)
     {
-        free(self->bss[i].client);
+        memfree(self->bss[i].client);
     }
-    free(self->bss);
+    memfree(self->bss);
 }
 
 static bool tlv_compare_field2_associatedClients(const struct associatedClientsTLV *self1,
@@ -746,4534 +1101,3934 @@ static bool tlv_compare_field2_associatedClients(const struct associatedClientsT
 
 /** @} */
 
+/** @brief Support functions for deviceInformationType TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.5
+ *
+ * @{
+ */
 
-static tlv_defs_t tlv_1905_defs = {
-    [TLV_TYPE_END_OF_MESSAGE] = {
-        .type = TLV_TYPE_END_OF_MESSAGE,
-        .name = "endOfMessage",
-    },
-    TLV_DEF_ENTRY(vendorSpecific,TLV_TYPE_VENDOR_SPECIFIC),
-    TLV_DEF_ENTRY(alMacAddressType,TLV_TYPE_AL_MAC_ADDRESS_TYPE),
-    TLV_DEF_ENTRY(macAddressType,TLV_TYPE_MAC_ADDRESS_TYPE),
-    TLV_DEF_ENTRY(linkMetricQuery,TLV_TYPE_LINK_METRIC_QUERY),
-    TLV_DEF_ENTRY(supportedService,TLV_TYPE_SUPPORTED_SERVICE),
-    /* Searched service is exactly the same as supported service, so reuse the functions. */
-    [TLV_TYPE_SEARCHED_SERVICE] = {
-        .type = TLV_TYPE_SEARCHED_SERVICE,
-        .name = "searchedService",
-        .parse = tlv_parse_supportedService,
-        .length = tlv_length_supportedService,
-        .forge = tlv_forge_supportedService,
-        .print = tlv_print_supportedService,
-        .free = tlv_free_supportedService,
-        .compare = tlv_compare_supportedService,
-    },
-    TLV_DEF_ENTRY(apOperationalBss,TLV_TYPE_AP_OPERATIONAL_BSS),
-    TLV_DEF_ENTRY(associatedClients,TLV_TYPE_ASSOCIATED_CLIENTS),
-};
-
-////////////////////////////////////////////////////////////////////////////////
-// Actual API functions
-////////////////////////////////////////////////////////////////////////////////
-
-uint8_t *parse_1905_TLV_from_packet(uint8_t *packet_stream)
+static struct tlv *tlv_parse_deviceInformationType(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
 {
-    if (NULL == packet_stream)
-    {
-        return NULL;
-    }
-
-    // The first byte of the stream is the "Type" field from the TLV structure.
-    // Valid values for this byte are the following ones...
-    //
-    switch (*packet_stream)
-    {
-        case TLV_TYPE_DEVICE_INFORMATION_TYPE:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.5"
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.5"
 
-            struct deviceInformationTypeTLV  *ret;
+    struct deviceInformationTypeTLV  *ret;
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i;
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i;
 
-            ret = (struct deviceInformationTypeTLV *)memalloc(sizeof(struct deviceInformationTypeTLV));
+    ret = (struct deviceInformationTypeTLV *)memalloc(sizeof(struct deviceInformationTypeTLV));
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    p   = (uint8_t *)buffer;
+    len = length;
 
-            ret->tlv.type = TLV_TYPE_DEVICE_INFORMATION_TYPE;
+    ret->tlv.type = TLV_TYPE_DEVICE_INFORMATION_TYPE;
 
-            _EnB(&p,  ret->al_mac_address, 6);
-            _E1B(&p, &ret->local_interfaces_nr);
+    _EnB(&p,  ret->al_mac_address, 6);
+    _E1B(&p, &ret->local_interfaces_nr);
 
-            ret->local_interfaces = (struct _localInterfaceEntries *)memalloc(sizeof(struct _localInterfaceEntries) * ret->local_interfaces_nr);
+    ret->local_interfaces = (struct _localInterfaceEntries *)memalloc(sizeof(struct _localInterfaceEntries) * ret->local_interfaces_nr);
 
-            for (i=0; i < ret->local_interfaces_nr; i++)
-            {
-                _EnB(&p,  ret->local_interfaces[i].mac_address, 6);
-                _E2B(&p, &ret->local_interfaces[i].media_type);
-                _E1B(&p, &ret->local_interfaces[i].media_specific_data_size);
+    for (i=0; i < ret->local_interfaces_nr; i++)
+    {
+        _EnB(&p,  ret->local_interfaces[i].mac_address, 6);
+        _E2B(&p, &ret->local_interfaces[i].media_type);
+        _E1B(&p, &ret->local_interfaces[i].media_specific_data_size);
 
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == ret->local_interfaces[i].media_type)
-                   )
-                {
-                    uint8_t aux;
+        if (
+             (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == ret->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == ret->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == ret->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == ret->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == ret->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == ret->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == ret->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AF_GHZ    == ret->local_interfaces[i].media_type)
+           )
+        {
+            uint8_t aux;
 
-                    if (10 != ret->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed packet
-                        //
-                        free(ret->local_interfaces);
-                        free(ret);
-                        return NULL;
-                    }
+            if (10 != ret->local_interfaces[i].media_specific_data_size)
+            {
+                // Malformed packet
+                //
+                memfree(ret->local_interfaces);
+                memfree(ret);
+                return NULL;
+            }
 
-                    _EnB(&p, ret->local_interfaces[i].media_specific_data.ieee80211.network_membership, 6);
-                    _E1B(&p, &aux);
-                    ret->local_interfaces[i].media_specific_data.ieee80211.role = aux >> 4;
-                    _E1B(&p, &ret->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band);
-                    _E1B(&p, &ret->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
-                    _E1B(&p, &ret->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
+            _EnB(&p, ret->local_interfaces[i].media_specific_data.ieee80211.network_membership, 6);
+            _E1B(&p, &aux);
+            ret->local_interfaces[i].media_specific_data.ieee80211.role = aux >> 4;
+            _E1B(&p, &ret->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band);
+            _E1B(&p, &ret->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
+            _E1B(&p, &ret->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
 
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == ret->local_interfaces[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == ret->local_interfaces[i].media_type)
-                        )
-                {
-                    if (7 != ret->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed packet
-                        //
-                        free(ret->local_interfaces);
-                        free(ret);
-                        return NULL;
-                    }
-                    _EnB(&p, ret->local_interfaces[i].media_specific_data.ieee1901.network_identifier, 7);
-                }
-                else
-                {
-                    if (0 != ret->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed packet
-                        //
-                        free(ret->local_interfaces);
-                        free(ret);
-                        return NULL;
-                    }
-                }
+        }
+        else if (
+                  (MEDIA_TYPE_IEEE_1901_WAVELET == ret->local_interfaces[i].media_type) ||
+                  (MEDIA_TYPE_IEEE_1901_FFT     == ret->local_interfaces[i].media_type)
+                )
+        {
+            if (7 != ret->local_interfaces[i].media_specific_data_size)
+            {
+                // Malformed packet
+                //
+                memfree(ret->local_interfaces);
+                memfree(ret);
+                return NULL;
             }
-
-            if (p - (packet_stream+3) != len)
+            _EnB(&p, ret->local_interfaces[i].media_specific_data.ieee1901.network_identifier, 7);
+        }
+        else
+        {
+            if (0 != ret->local_interfaces[i].media_specific_data_size)
             {
                 // Malformed packet
                 //
-                free(ret->local_interfaces);
-                free(ret);
+                memfree(ret->local_interfaces);
+                memfree(ret);
                 return NULL;
             }
-
-            return (uint8_t *)ret;
         }
+    }
 
-        case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.6"
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        memfree(ret->local_interfaces);
+        memfree(ret);
+        return NULL;
+    }
 
-            struct deviceBridgingCapabilityTLV  *ret;
+    return (struct tlv *)ret;
+}
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i, j;
+static uint16_t tlv_length_deviceInformationType(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.5"
 
-            ret = (struct deviceBridgingCapabilityTLV *)memalloc(sizeof(struct deviceBridgingCapabilityTLV));
+    struct deviceInformationTypeTLV *m;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    uint16_t tlv_length;
 
-            ret->tlv.type = TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES;
+    uint8_t i;
 
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // length should be "1" (which is the length of the next field,
-                // that would containing a "zero", indicating the number of
-                // bridging tuples).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no bridging tuples", we
-                // will also accept this type of "malformed" packet.
-                //
-                ret->bridging_tuples_nr = 0;
-                return (uint8_t *)ret;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
+    m = (struct deviceInformationTypeTLV *)tlv;
 
-            _E1B(&p, &ret->bridging_tuples_nr);
+    tlv_length = 7;  // AL MAC (6 bytes) + number of ifaces (1 bytes)
+    for (i=0; i<m->local_interfaces_nr; i++)
+    {
+        tlv_length += 6 + 2 + 1;  // MAC (6 bytes) + media type (2
+                                  // bytes) + number of octets (1 byte)
 
-            if (ret->bridging_tuples_nr > 0)
-            {
-                ret->bridging_tuples = (struct _bridgingTupleEntries *)memalloc(sizeof(struct _bridgingTupleEntries) * ret->bridging_tuples_nr);
+        tlv_length += m->local_interfaces[i].media_specific_data_size;
+    }
 
-                for (i=0; i < ret->bridging_tuples_nr; i++)
-                {
-                    _E1B(&p, &ret->bridging_tuples[i].bridging_tuple_macs_nr);
+    return tlv_length;
+}
 
-                    if (ret->bridging_tuples[i].bridging_tuple_macs_nr > 0)
-                    {
-                        ret->bridging_tuples[i].bridging_tuple_macs = (struct _bridgingTupleMacEntries *)memalloc(sizeof(struct _bridgingTupleMacEntries) * ret->bridging_tuples[i].bridging_tuple_macs_nr);
+static bool tlv_forge_deviceInformationType(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.5"
 
-                        for (j=0; j < ret->bridging_tuples[i].bridging_tuple_macs_nr; j++)
-                        {
-                            _EnB(&p, ret->bridging_tuples[i].bridging_tuple_macs[j].mac_address, 6);
-                        }
-                    }
-                }
-            }
+    uint8_t *p;
+    struct deviceInformationTypeTLV *m;
 
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                for (i=0; i < ret->bridging_tuples_nr; i++)
-                {
-                    free(ret->bridging_tuples[i].bridging_tuple_macs);
-                }
-                free(ret->bridging_tuples);
-                free(ret);
-                return NULL;
-            }
+    uint16_t tlv_length;
 
-            return (uint8_t *)ret;
-        }
+    uint8_t i;
 
-        case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.8"
+    m = (struct deviceInformationTypeTLV *)tlv;
+    tlv_length = tlv_length_deviceInformationType(tlv);
 
-            struct non1905NeighborDeviceListTLV  *ret;
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i;
+    _InB( m->al_mac_address,      &p, 6);
+    _I1B(&m->local_interfaces_nr, &p);
 
-            ret = (struct non1905NeighborDeviceListTLV *)memalloc(sizeof(struct non1905NeighborDeviceListTLV));
+    for (i=0; i<m->local_interfaces_nr; i++)
+    {
+        _InB( m->local_interfaces[i].mac_address,              &p, 6);
+        _I2B(&m->local_interfaces[i].media_type,               &p);
+        _I1B(&m->local_interfaces[i].media_specific_data_size, &p);
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+        if (
+             (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == m->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == m->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == m->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == m->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == m->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == m->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == m->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AF_GHZ    == m->local_interfaces[i].media_type)
+           )
+        {
+            uint8_t aux;
 
-            // According to the standard, the length *must* be "6 + 6*n"
-            //
-            if (0 != ((len-6)%6))
+            if (10 != m->local_interfaces[i].media_specific_data_size)
             {
-                // Malformed packet
+                // Malformed structure
                 //
-                free(ret);
-                return NULL;
+                return false;
             }
-            ret->tlv.type = TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST;
-
-            _EnB(&p,  ret->local_mac_address, 6);
 
-            ret->non_1905_neighbors_nr = (len-6)/6;
+            _InB(m->local_interfaces[i].media_specific_data.ieee80211.network_membership,                   &p, 6);
+            aux = m->local_interfaces[i].media_specific_data.ieee80211.role << 4;
+            _I1B(&aux,                                                                                      &p);
+            _I1B(&m->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band,                     &p);
+            _I1B(&m->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1, &p);
+            _I1B(&m->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2, &p);
 
-            ret->non_1905_neighbors = (struct _non1905neighborEntries *)memalloc(sizeof(struct _non1905neighborEntries) * ret->non_1905_neighbors_nr);
-
-            for (i=0; i < ret->non_1905_neighbors_nr; i++)
+        }
+        else if (
+                  (MEDIA_TYPE_IEEE_1901_WAVELET == m->local_interfaces[i].media_type) ||
+                  (MEDIA_TYPE_IEEE_1901_FFT     == m->local_interfaces[i].media_type)
+                )
+        {
+            if (7 != m->local_interfaces[i].media_specific_data_size)
             {
-                _EnB(&p,  ret->non_1905_neighbors[i].mac_address, 6);
+                // Malformed structure
+                //
+                return false;
             }
-
-            return (uint8_t *)ret;
+            _InB(m->local_interfaces[i].media_specific_data.ieee1901.network_identifier, &p, 7);
         }
-
-        case TLV_TYPE_NEIGHBOR_DEVICE_LIST:
+        else
         {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.9"
-
-            struct neighborDeviceListTLV  *ret;
-
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i;
-
-            ret = (struct neighborDeviceListTLV *)memalloc(sizeof(struct neighborDeviceListTLV));
-
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-
-            // According to the standard, the length *must* be "6 + 7*n"
-            // "6+1"
-            //
-            if (0 != ((len-6)%7))
+            if (0 != m->local_interfaces[i].media_specific_data_size)
             {
-                // Malformed packet
+                // Malformed structure
                 //
-                free(ret);
-                return NULL;
+                return false;
             }
-            ret->tlv.type = TLV_TYPE_NEIGHBOR_DEVICE_LIST;
+        }
+    }
 
-            _EnB(&p,  ret->local_mac_address, 6);
+    *buf     = p;
+    *length -= tlv_length;
 
-            ret->neighbors_nr = (len-6)/7;
+    return true;
+}
 
-            ret->neighbors = (struct _neighborEntries *)memalloc(sizeof(struct _neighborEntries) * ret->neighbors_nr);
+static void tlv_print_deviceInformationType(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct deviceInformationTypeTLV *p;
+    uint8_t i;
 
-            for (i=0; i < ret->neighbors_nr; i++)
-            {
-                uint8_t aux;
+    p = (struct deviceInformationTypeTLV *)tlv;
 
-                _EnB(&p,  ret->neighbors[i].mac_address, 6);
-                _E1B(&p, &aux);
+    print_callback(write_function, prefix, sizeof(p->al_mac_address),      "al_mac_address",       "0x%02x",   p->al_mac_address);
+    print_callback(write_function, prefix, sizeof(p->local_interfaces_nr), "local_interfaces_nr",  "%d",       &p->local_interfaces_nr);
+    for (i=0; i < p->local_interfaces_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-                if (aux & 0x80)
-                {
-                    ret->neighbors[i].bridge_flag = 1;
-                }
-                else
-                {
-                    ret->neighbors[i].bridge_flag = 0;
-                }
-            }
+        snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            return (uint8_t *)ret;
-        }
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].mac_address),              "mac_address",              "0x%02x",   p->local_interfaces[i].mac_address);
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_type),               "media_type",               "0x%04x",  &p->local_interfaces[i].media_type);
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data_size), "media_specific_data_size", "%d",      &p->local_interfaces[i].media_specific_data_size);
 
-        case TLV_TYPE_TRANSMITTER_LINK_METRIC:
+        if (
+             (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == p->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == p->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == p->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == p->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == p->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == p->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == p->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AF_GHZ    == p->local_interfaces[i].media_type)
+           )
+        {
+            print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.network_membership),                  "network_membership",                   "0x%02x",   p->local_interfaces[i].media_specific_data.ieee80211.network_membership);
+            print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.role),                                "role",                                 "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.role);
+            print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band),                     "ap_channel_band",                      "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band);
+            print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1), "ap_channel_center_frequency_index_1",  "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
+            print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2), "ap_channel_center_frequency_index_2",  "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
+        }
+        else if (
+                  (MEDIA_TYPE_IEEE_1901_WAVELET == p->local_interfaces[i].media_type) ||
+                  (MEDIA_TYPE_IEEE_1901_FFT     == p->local_interfaces[i].media_type)
+                )
         {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.11"
+            print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee1901.network_identifier), "network_identifier", "0x%02x", p->local_interfaces[i].media_specific_data.ieee1901.network_identifier);
+        }
 
-            struct transmitterLinkMetricTLV  *ret;
+    }
+}
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i;
+static void tlv_free_deviceInformationType(struct tlv *tlv)
+{
+    struct deviceInformationTypeTLV *m;
 
-            ret = (struct transmitterLinkMetricTLV *)memalloc(sizeof(struct transmitterLinkMetricTLV));
+    m = (struct deviceInformationTypeTLV *)tlv;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
+    {
+        memfree(m->local_interfaces);
+    }
+    memfree(m);
+}
 
-            // According to the standard, the length *must* be "12+29*n" where
-            // "n" is "1" or greater
-            //
-            if ((12+29*1) > len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
-            if (0 != (len-12)%29)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
+static bool tlv_compare_deviceInformationType(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct deviceInformationTypeTLV *p1, *p2;
+    uint8_t i;
 
-            ret->tlv.type = TLV_TYPE_TRANSMITTER_LINK_METRIC;
+    p1 = (struct deviceInformationTypeTLV *)tlv1;
+    p2 = (struct deviceInformationTypeTLV *)tlv2;
 
-            _EnB(&p, ret->local_al_address,    6);
-            _EnB(&p, ret->neighbor_al_address, 6);
+    if (
+         memcmp(p1->al_mac_address,         p2->al_mac_address, 6) !=0  ||
+                         p1->local_interfaces_nr !=  p2->local_interfaces_nr
+       )
+    {
+        return false;
+    }
 
-            ret->transmitter_link_metrics_nr = (len-12)/29;
+    if (p1->local_interfaces_nr > 0 && (NULL == p1->local_interfaces || NULL == p2->local_interfaces))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
 
-            ret->transmitter_link_metrics = (struct _transmitterLinkMetricEntries *)memalloc(sizeof(struct _transmitterLinkMetricEntries) * ret->transmitter_link_metrics_nr);
+    for (i=0; i<p1->local_interfaces_nr; i++)
+    {
+        if (
+             memcmp(p1->local_interfaces[i].mac_address,                 p2->local_interfaces[i].mac_address, 6) !=0      ||
+                             p1->local_interfaces[i].media_type               !=  p2->local_interfaces[i].media_type               ||
+                             p1->local_interfaces[i].media_specific_data_size !=  p2->local_interfaces[i].media_specific_data_size
+           )
+        {
+            return false;
+        }
 
-            for (i=0; i < ret->transmitter_link_metrics_nr; i++)
+        if (
+             (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == p1->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == p1->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == p1->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == p1->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == p1->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == p1->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == p1->local_interfaces[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AF_GHZ    == p1->local_interfaces[i].media_type)
+           )
+        {
+            if (
+                 memcmp(p1->local_interfaces[i].media_specific_data.ieee80211.network_membership,                     p2->local_interfaces[i].media_specific_data.ieee80211.network_membership,  6) !=0          ||
+                                 p1->local_interfaces[i].media_specific_data.ieee80211.role                                !=  p2->local_interfaces[i].media_specific_data.ieee80211.role                                 ||
+                                 p1->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band                     !=  p2->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band                      ||
+                                 p1->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1 !=  p2->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1
+               )
             {
-                _EnB(&p,  ret->transmitter_link_metrics[i].local_interface_address,    6);
-                _EnB(&p,  ret->transmitter_link_metrics[i].neighbor_interface_address, 6);
-
-                _E2B(&p, &ret->transmitter_link_metrics[i].intf_type);
-                _E1B(&p, &ret->transmitter_link_metrics[i].bridge_flag);
-                _E4B(&p, &ret->transmitter_link_metrics[i].packet_errors);
-                _E4B(&p, &ret->transmitter_link_metrics[i].transmitted_packets);
-                _E2B(&p, &ret->transmitter_link_metrics[i].mac_throughput_capacity);
-                _E2B(&p, &ret->transmitter_link_metrics[i].link_availability);
-                _E2B(&p, &ret->transmitter_link_metrics[i].phy_rate);
+                return false;
             }
 
-            if (p - (packet_stream+3) != len)
+        }
+        else if (
+                  (MEDIA_TYPE_IEEE_1901_WAVELET == p1->local_interfaces[i].media_type) ||
+                  (MEDIA_TYPE_IEEE_1901_FFT     == p1->local_interfaces[i].media_type)
+                )
+        {
+            if (
+                 memcmp(p1->local_interfaces[i].media_specific_data.ieee1901.network_identifier,  p2->local_interfaces[i].media_specific_data.ieee1901.network_identifier,  6) !=0
+               )
             {
-                // Malformed packet
-                //
-                free(ret->transmitter_link_metrics);
-                free(ret);
-                return NULL;
+                return false;
             }
-
-            return (uint8_t *)ret;
         }
+    }
 
-        case TLV_TYPE_RECEIVER_LINK_METRIC:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.12"
+    return true;
+}
 
-            struct receiverLinkMetricTLV  *ret;
+/** @} */
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i;
+/** @brief Support functions for deviceBridgingCapability TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.6
+ *
+ * @{
+ */
 
-            ret = (struct receiverLinkMetricTLV *)memalloc(sizeof(struct receiverLinkMetricTLV));
+static struct tlv *tlv_parse_deviceBridgingCapability(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.6"
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    struct deviceBridgingCapabilityTLV  *ret;
 
-            // According to the standard, the length *must* be "12+23*n" where
-            // "n" is "1" or greater
-            //
-            if ((12+23*1) > len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
-            if (0 != (len-12)%23)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i, j;
 
-            ret->tlv.type = TLV_TYPE_RECEIVER_LINK_METRIC;
+    ret = (struct deviceBridgingCapabilityTLV *)memalloc(sizeof(struct deviceBridgingCapabilityTLV));
 
-            _EnB(&p, ret->local_al_address,    6);
-            _EnB(&p, ret->neighbor_al_address, 6);
+    p   = (uint8_t *)buffer;
+    len = length;
 
-            ret->receiver_link_metrics_nr = (len-12)/23;
+    ret->tlv.type = TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES;
 
-            ret->receiver_link_metrics = (struct _receiverLinkMetricEntries *)memalloc(sizeof(struct _receiverLinkMetricEntries) * ret->receiver_link_metrics_nr);
+    if (0 == len)
+    {
+#ifdef FIX_BROKEN_TLVS
+        // Malformed packet. Even if there are NO bridging tuples, the
+        // length should be "1" (which is the length of the next field,
+        // that would containing a "zero", indicating the number of
+        // bridging tuples).
+        // *However*, because at least one other implementation sets
+        // the 'length' to zero to indicate "no bridging tuples", we
+        // will also accept this type of "malformed" packet.
+        //
+        ret->bridging_tuples_nr = 0;
+        return (struct tlv *)ret;
+#else
+        memfree(ret);
+        return NULL;
+#endif
+    }
 
-            for (i=0; i < ret->receiver_link_metrics_nr; i++)
-            {
-                _EnB(&p,  ret->receiver_link_metrics[i].local_interface_address,    6);
-                _EnB(&p,  ret->receiver_link_metrics[i].neighbor_interface_address, 6);
+    _E1B(&p, &ret->bridging_tuples_nr);
 
-                _E2B(&p, &ret->receiver_link_metrics[i].intf_type);
-                _E4B(&p, &ret->receiver_link_metrics[i].packet_errors);
-                _E4B(&p, &ret->receiver_link_metrics[i].packets_received);
-                _E1B(&p, &ret->receiver_link_metrics[i].rssi);
-            }
+    if (ret->bridging_tuples_nr > 0)
+    {
+        ret->bridging_tuples = (struct _bridgingTupleEntries *)memalloc(sizeof(struct _bridgingTupleEntries) * ret->bridging_tuples_nr);
+
+        for (i=0; i < ret->bridging_tuples_nr; i++)
+        {
+            _E1B(&p, &ret->bridging_tuples[i].bridging_tuple_macs_nr);
 
-            if (p - (packet_stream+3) != len)
+            if (ret->bridging_tuples[i].bridging_tuple_macs_nr > 0)
             {
-                // Malformed packet
-                //
-                free(ret->receiver_link_metrics);
-                free(ret);
-                return NULL;
-            }
+                ret->bridging_tuples[i].bridging_tuple_macs = (struct _bridgingTupleMacEntries *)memalloc(sizeof(struct _bridgingTupleMacEntries) * ret->bridging_tuples[i].bridging_tuple_macs_nr);
 
-            return (uint8_t *)ret;
+                for (j=0; j < ret->bridging_tuples[i].bridging_tuple_macs_nr; j++)
+                {
+                    _EnB(&p, ret->bridging_tuples[i].bridging_tuple_macs[j].mac_address, 6);
+                }
+            }
         }
+    }
 
-        case TLV_TYPE_LINK_METRIC_RESULT_CODE:
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        for (i=0; i < ret->bridging_tuples_nr; i++)
         {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.13"
+            memfree(ret->bridging_tuples[i].bridging_tuple_macs);
+        }
+        memfree(ret->bridging_tuples);
+        memfree(ret);
+        return NULL;
+    }
 
-            struct linkMetricResultCodeTLV  *ret;
+    return (struct tlv *)ret;
+}
 
-            uint8_t *p;
-            uint16_t len;
+static uint16_t tlv_length_deviceBridgingCapability(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.6"
 
-            ret = (struct linkMetricResultCodeTLV *)memalloc(sizeof(struct linkMetricResultCodeTLV));
+    struct deviceBridgingCapabilityTLV *m;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    uint16_t tlv_length;
 
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
+    uint8_t i;
 
-            ret->tlv.type = TLV_TYPE_LINK_METRIC_RESULT_CODE;
+    m = (struct deviceBridgingCapabilityTLV *)tlv;
 
-            _E1B(&p, &ret->result_code);
+    tlv_length = 1;  // number of bridging tuples (1 bytes)
+    for (i=0; i<m->bridging_tuples_nr; i++)
+    {
+        tlv_length += 1;  // number of MAC addresses (1 bytes)
+        tlv_length += 6 * m->bridging_tuples[i].bridging_tuple_macs_nr;
+    }
 
-            return (uint8_t *)ret;
-        }
+    return tlv_length;
+}
 
-        case TLV_TYPE_SEARCHED_ROLE:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.14"
+static bool tlv_forge_deviceBridgingCapability(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.6"
 
-            struct searchedRoleTLV  *ret;
+    uint8_t *p;
+    struct deviceBridgingCapabilityTLV *m;
 
-            uint8_t *p;
-            uint16_t len;
+    uint16_t tlv_length;
 
-            ret = (struct searchedRoleTLV *)memalloc(sizeof(struct searchedRoleTLV));
+    uint8_t i, j;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    m = (struct deviceBridgingCapabilityTLV *)tlv;
+    tlv_length = tlv_length_deviceBridgingCapability(tlv);
 
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            ret->tlv.type = TLV_TYPE_SEARCHED_ROLE;
+    _I1B(&m->bridging_tuples_nr, &p);
 
-            _E1B(&p, &ret->role);
+    for (i=0; i<m->bridging_tuples_nr; i++)
+    {
+        _I1B(&m->bridging_tuples[i].bridging_tuple_macs_nr, &p);
 
-            return (uint8_t *)ret;
+        for (j=0; j<m->bridging_tuples[i].bridging_tuple_macs_nr; j++)
+        {
+            _InB(m->bridging_tuples[i].bridging_tuple_macs[j].mac_address,  &p, 6);
         }
+    }
 
-        case TLV_TYPE_AUTOCONFIG_FREQ_BAND:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.15"
+    *buf     = p;
+    *length -= tlv_length;
 
-            struct autoconfigFreqBandTLV  *ret;
+    return true;
+}
 
-            uint8_t *p;
-            uint16_t len;
+static void tlv_print_deviceBridgingCapability(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct deviceBridgingCapabilityTLV *p;
+    uint8_t i, j;
 
-            ret = (struct autoconfigFreqBandTLV *)memalloc(sizeof(struct autoconfigFreqBandTLV));
+    p = (struct deviceBridgingCapabilityTLV *)tlv;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    print_callback(write_function, prefix, sizeof(p->bridging_tuples_nr), "bridging_tuples_nr", "%d",  &p->bridging_tuples_nr);
+    for (i=0; i < p->bridging_tuples_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
+        snprintf(new_prefix, MAX_PREFIX-1, "%sbridging_tuples[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            ret->tlv.type = TLV_TYPE_AUTOCONFIG_FREQ_BAND;
+        print_callback(write_function, new_prefix, sizeof(p->bridging_tuples[i].bridging_tuple_macs_nr), "bridging_tuple_macs_nr", "%d",  &p->bridging_tuples[i].bridging_tuple_macs_nr);
 
-            _E1B(&p, &ret->freq_band);
+        for (j=0; j < p->bridging_tuples[i].bridging_tuple_macs_nr; j++)
+        {
+            snprintf(new_prefix, MAX_PREFIX-1, "%sbridging_tuples[%d]->bridging_tuple_macs[%d]->", prefix, i, j);
+            new_prefix[MAX_PREFIX-1] = 0x0;
 
-            return (uint8_t *)ret;
+            print_callback(write_function, new_prefix, sizeof(p->bridging_tuples[i].bridging_tuple_macs[j].mac_address), "mac_address", "0x%02x",  p->bridging_tuples[i].bridging_tuple_macs[j].mac_address);
         }
+    }
+}
 
-        case TLV_TYPE_SUPPORTED_ROLE:
+static void tlv_free_deviceBridgingCapability(struct tlv *tlv)
+{
+    struct deviceBridgingCapabilityTLV *m;
+    uint8_t i;
+
+    m = (struct deviceBridgingCapabilityTLV *)tlv;
+
+    for (i=0; i < m->bridging_tuples_nr; i++)
+    {
+        if (m->bridging_tuples[i].bridging_tuple_macs_nr > 0 && NULL != m->bridging_tuples[i].bridging_tuple_macs)
         {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.16"
+            memfree(m->bridging_tuples[i].bridging_tuple_macs);
+        }
+    }
+    if (m->bridging_tuples_nr > 0 && NULL != m->bridging_tuples)
+    {
+        memfree(m->bridging_tuples);
+    }
+    memfree(m);
+}
+
+static bool tlv_compare_deviceBridgingCapability(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct deviceBridgingCapabilityTLV *p1, *p2;
+    uint8_t i, j;
 
-            struct supportedRoleTLV  *ret;
+    p1 = (struct deviceBridgingCapabilityTLV *)tlv1;
+    p2 = (struct deviceBridgingCapabilityTLV *)tlv2;
 
-            uint8_t *p;
-            uint16_t len;
+    if (
+         p1->bridging_tuples_nr != p2->bridging_tuples_nr
+       )
+    {
+        return false;
+    }
 
-            ret = (struct supportedRoleTLV *)memalloc(sizeof(struct supportedRoleTLV));
+    if (p1->bridging_tuples_nr > 0 && (NULL == p1->bridging_tuples || NULL == p2->bridging_tuples))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    for (i=0; i<p1->bridging_tuples_nr; i++)
+    {
+        if (
+             p1->bridging_tuples[i].bridging_tuple_macs_nr  !=  p2->bridging_tuples[i].bridging_tuple_macs_nr
+           )
+        {
+            return false;
+        }
 
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
+        for (j=0; j<p1->bridging_tuples[i].bridging_tuple_macs_nr; j++)
+        {
+            if (
+                 memcmp(p1->bridging_tuples[i].bridging_tuple_macs[j].mac_address,  p2->bridging_tuples[i].bridging_tuple_macs[j].mac_address, 6) !=0
+               )
             {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
+                return false;
             }
+        }
+    }
 
-            ret->tlv.type = TLV_TYPE_SUPPORTED_ROLE;
-
-            _E1B(&p, &ret->role);
+    return true;
+}
 
-            return (uint8_t *)ret;
-        }
+/** @} */
 
-        case TLV_TYPE_SUPPORTED_FREQ_BAND:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.17"
+/** @brief Support functions for non1905NeighborDeviceList TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.8
+ *
+ * @{
+ */
 
-            struct supportedFreqBandTLV  *ret;
+static struct tlv *tlv_parse_non1905NeighborDeviceList(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.8"
 
-            uint8_t *p;
-            uint16_t len;
+    struct non1905NeighborDeviceListTLV  *ret;
 
-            ret = (struct supportedFreqBandTLV *)memalloc(sizeof(struct supportedFreqBandTLV));
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    ret = (struct non1905NeighborDeviceListTLV *)memalloc(sizeof(struct non1905NeighborDeviceListTLV));
 
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
+    p   = (uint8_t *)buffer;
+    len = length;
 
-            ret->tlv.type = TLV_TYPE_SUPPORTED_FREQ_BAND;
+    // According to the standard, the length *must* be "6 + 6*n"
+    //
+    if (0 != ((len-6)%6))
+    {
+        // Malformed packet
+        //
+        memfree(ret);
+        return NULL;
+    }
+    ret->tlv.type = TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST;
 
-            _E1B(&p, &ret->freq_band);
+    _EnB(&p,  ret->local_mac_address, 6);
 
-            return (uint8_t *)ret;
-        }
+    ret->non_1905_neighbors_nr = (len-6)/6;
 
-        case TLV_TYPE_WSC:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.18"
+    ret->non_1905_neighbors = (struct _non1905neighborEntries *)memalloc(sizeof(struct _non1905neighborEntries) * ret->non_1905_neighbors_nr);
 
-            struct wscTLV  *ret;
+    for (i=0; i < ret->non_1905_neighbors_nr; i++)
+    {
+        _EnB(&p,  ret->non_1905_neighbors[i].mac_address, 6);
+    }
 
-            uint8_t *p;
-            uint16_t len;
+    return (struct tlv *)ret;
+}
 
-            ret = (struct wscTLV *)memalloc(sizeof(struct wscTLV));
+static uint16_t tlv_length_non1905NeighborDeviceList(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.8"
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    struct non1905NeighborDeviceListTLV *m;
 
-            ret->tlv.type       = TLV_TYPE_WSC;
-            ret->wsc_frame_size = len;
+    uint16_t tlv_length;
 
-            if (len>0)
-            {
-                ret->wsc_frame      = (uint8_t *)memalloc(len);
-                _EnB(&p, ret->wsc_frame, len);
-            }
+    m = (struct non1905NeighborDeviceListTLV *)tlv;
 
-            return (uint8_t *)ret;
-        }
+    tlv_length = 6 + 6*m->non_1905_neighbors_nr;
 
-        case TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.19"
+    return tlv_length;
+}
 
-            struct pushButtonEventNotificationTLV  *ret;
+static bool tlv_forge_non1905NeighborDeviceList(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.8"
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t i;
+    uint8_t *p;
+    struct non1905NeighborDeviceListTLV *m;
 
-            ret = (struct pushButtonEventNotificationTLV *)memalloc(sizeof(struct pushButtonEventNotificationTLV));
+    uint16_t tlv_length;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    uint8_t i;
 
-            ret->tlv.type = TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION;
+    m = (struct non1905NeighborDeviceListTLV *)tlv;
+    tlv_length = tlv_length_non1905NeighborDeviceList(tlv);
 
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO media types, the
-                // length should be "1" (which is the length of the next field,
-                // that would containing a "zero", indicating the number of
-                // media types).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no media types", we will
-                // also accept this type of "malformed" packet.
-                //
-                ret->media_types_nr = 0;
-                return (uint8_t *)ret;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            _E1B(&p, &ret->media_types_nr);
+    _InB( m->local_mac_address,   &p, 6);
 
-            ret->media_types = (struct _mediaTypeEntries *)memalloc(sizeof(struct _mediaTypeEntries) * ret->media_types_nr);
+    for (i=0; i<m->non_1905_neighbors_nr; i++)
+    {
+        _InB(m->non_1905_neighbors[i].mac_address, &p, 6);
+    }
 
-            for (i=0; i < ret->media_types_nr; i++)
-            {
-                _E2B(&p, &ret->media_types[i].media_type);
-                _E1B(&p, &ret->media_types[i].media_specific_data_size);
+    *buf     = p;
+    *length -= tlv_length;
 
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == ret->media_types[i].media_type)
-                   )
-                {
-                    uint8_t aux;
+    return true;
+}
 
-                    if (10 != ret->media_types[i].media_specific_data_size)
-                    {
-                        // Malformed packet
-                        //
-                        free(ret->media_types);
-                        free(ret);
-                        return NULL;
-                    }
+static void tlv_print_non1905NeighborDeviceList(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct non1905NeighborDeviceListTLV *p;
+    uint8_t i;
 
-                    _EnB(&p, ret->media_types[i].media_specific_data.ieee80211.network_membership, 6);
-                    _E1B(&p, &aux);
-                    ret->media_types[i].media_specific_data.ieee80211.role = aux >> 4;
-                    _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_band);
-                    _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
-                    _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
+    p = (struct non1905NeighborDeviceListTLV *)tlv;
 
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == ret->media_types[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == ret->media_types[i].media_type)
-                        )
-                {
-                    if (7 != ret->media_types[i].media_specific_data_size)
-                    {
-                        // Malformed packet
-                        //
-                        free(ret->media_types);
-                        free(ret);
-                        return NULL;
-                    }
-                    _EnB(&p, ret->media_types[i].media_specific_data.ieee1901.network_identifier, 7);
-                }
-                else
-                {
-                    if (0 != ret->media_types[i].media_specific_data_size)
-                    {
-                        // Malformed packet
-                        //
-                        free(ret->media_types);
-                        free(ret);
-                        return NULL;
-                    }
-                }
-            }
+    if (p->non_1905_neighbors_nr > 0 && NULL == p->non_1905_neighbors)
+    {
+        // Malformed structure
+        return;
+    }
 
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                free(ret->media_types);
-                free(ret);
-                return NULL;
-            }
+    print_callback(write_function, prefix, sizeof(p->local_mac_address),     "local_mac_address",     "0x%02x",   p->local_mac_address);
+    print_callback(write_function, prefix, sizeof(p->non_1905_neighbors_nr), "non_1905_neighbors_nr", "%d",      &p->non_1905_neighbors_nr);
+    for (i=0; i < p->non_1905_neighbors_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-            return (uint8_t *)ret;
-        }
+        snprintf(new_prefix, MAX_PREFIX-1, "%snon_1905_neighbors[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-        case TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.20"
+        print_callback(write_function, new_prefix, sizeof(p->non_1905_neighbors[i].mac_address), "mac_address", "0x%02x", p->non_1905_neighbors[i].mac_address);
+    }
+}
 
-            struct pushButtonJoinNotificationTLV  *ret;
+static void tlv_free_non1905NeighborDeviceList(struct tlv *tlv)
+{
+    struct non1905NeighborDeviceListTLV *m;
 
-            uint8_t *p;
-            uint16_t len;
+    m = (struct non1905NeighborDeviceListTLV *)tlv;
 
-            ret = (struct pushButtonJoinNotificationTLV *)memalloc(sizeof(struct pushButtonJoinNotificationTLV));
+    if (m->non_1905_neighbors_nr > 0 && NULL != m->non_1905_neighbors)
+    {
+        memfree(m->non_1905_neighbors);
+    }
+    memfree(m);
+}
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+static bool tlv_compare_non1905NeighborDeviceList(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct non1905NeighborDeviceListTLV *p1, *p2;
+    uint8_t i;
 
-            // According to the standard, the length *must* be 20
-            //
-            if (20 != len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
+    p1 = (struct non1905NeighborDeviceListTLV *)tlv1;
+    p2 = (struct non1905NeighborDeviceListTLV *)tlv2;
 
-            ret->tlv.type = TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION;
+    if (
+         memcmp(p1->local_mac_address,        p2->local_mac_address, 6) !=0  ||
+                         p1->non_1905_neighbors_nr !=  p2->non_1905_neighbors_nr
+       )
+    {
+        return false;
+    }
 
-            _EnB(&p,  ret->al_mac_address, 6);
-            _E2B(&p, &ret->message_identifier);
-            _EnB(&p,  ret->mac_address, 6);
-            _EnB(&p,  ret->new_mac_address, 6);
+    if (p1->non_1905_neighbors_nr > 0 && (NULL == p1->non_1905_neighbors || NULL == p2->non_1905_neighbors))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
 
-            return (uint8_t *)ret;
+    for (i=0; i<p1->non_1905_neighbors_nr; i++)
+    {
+        if (
+             memcmp(p1->non_1905_neighbors[i].mac_address,     p2->non_1905_neighbors[i].mac_address, 6) !=0
+           )
+        {
+            return false;
         }
+    }
 
-        case TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.21"
+    return true;
+}
+
+/** @} */
+
+/** @brief Support functions for neighborDeviceList TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.9
+ *
+ * @{
+ */
 
-            struct genericPhyDeviceInformationTypeTLV  *ret;
+static struct tlv *tlv_parse_neighborDeviceList(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.9"
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i;
+    struct neighborDeviceListTLV  *ret;
 
-            ret = (struct genericPhyDeviceInformationTypeTLV *)memalloc(sizeof(struct genericPhyDeviceInformationTypeTLV));
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    ret = (struct neighborDeviceListTLV *)memalloc(sizeof(struct neighborDeviceListTLV));
 
-            ret->tlv.type = TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION;
+    p   = (uint8_t *)buffer;
+    len = length;
 
-            _EnB(&p,  ret->al_mac_address, 6);
-            _E1B(&p, &ret->local_interfaces_nr);
+    // According to the standard, the length *must* be "6 + 7*n"
+    // "6+1"
+    //
+    if (0 != ((len-6)%7))
+    {
+        // Malformed packet
+        //
+        memfree(ret);
+        return NULL;
+    }
+    ret->tlv.type = TLV_TYPE_NEIGHBOR_DEVICE_LIST;
 
-            if (ret->local_interfaces_nr > 0)
-            {
-                ret->local_interfaces = (struct _genericPhyDeviceEntries *)memalloc(sizeof(struct _genericPhyDeviceEntries) * ret->local_interfaces_nr);
+    _EnB(&p,  ret->local_mac_address, 6);
 
-                for (i=0; i < ret->local_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->local_interfaces[i].local_interface_address,                 6);
-                    _EnB(&p,  ret->local_interfaces[i].generic_phy_common_data.oui,             3);
-                    _E1B(&p, &ret->local_interfaces[i].generic_phy_common_data.variant_index);
-                    _EnB(&p,  ret->local_interfaces[i].variant_name,                           32);
-                    _E1B(&p, &ret->local_interfaces[i].generic_phy_description_xml_url_len);
-                    _E1B(&p, &ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-
-                    if (ret->local_interfaces[i].generic_phy_description_xml_url_len > 0)
-                    {
-                        ret->local_interfaces[i].generic_phy_description_xml_url = (char *)memalloc(ret->local_interfaces[i].generic_phy_description_xml_url_len);
-                        _EnB(&p, ret->local_interfaces[i].generic_phy_description_xml_url, ret->local_interfaces[i].generic_phy_description_xml_url_len);
-                    }
+    ret->neighbors_nr = (len-6)/7;
 
-                    if (ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
-                    {
-                        ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes = (uint8_t *)memalloc(ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                        _EnB(&p, ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes, ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                    }
-                }
-            }
+    ret->neighbors = (struct _neighborEntries *)memalloc(sizeof(struct _neighborEntries) * ret->neighbors_nr);
 
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                for (i=0; i < ret->local_interfaces_nr; i++)
-                {
-                    if (ret->local_interfaces[i].generic_phy_description_xml_url_len > 0)
-                    {
-                        free(ret->local_interfaces[i].generic_phy_description_xml_url);
-                    }
+    for (i=0; i < ret->neighbors_nr; i++)
+    {
+        uint8_t aux;
 
-                    if (ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
-                    {
-                        free(ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes);
-                    }
-                }
-                free(ret->local_interfaces);
-                free(ret);
-                return NULL;
-            }
+        _EnB(&p,  ret->neighbors[i].mac_address, 6);
+        _E1B(&p, &aux);
 
-            return (uint8_t *)ret;
+        if (aux & 0x80)
+        {
+            ret->neighbors[i].bridge_flag = 1;
         }
-
-        case TLV_TYPE_DEVICE_IDENTIFICATION:
+        else
         {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.22"
+            ret->neighbors[i].bridge_flag = 0;
+        }
+    }
 
-            struct deviceIdentificationTypeTLV  *ret;
+    return (struct tlv *)ret;
+}
 
-            uint8_t *p;
-            uint16_t len;
+static uint16_t tlv_length_neighborDeviceList(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.9"
 
-            ret = (struct deviceIdentificationTypeTLV *)memalloc(sizeof(struct deviceIdentificationTypeTLV));
+    struct neighborDeviceListTLV *m;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    uint16_t tlv_length;
 
-            // According to the standard, the length *must* be 20
-            //
-            if (192 != len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
+    m = (struct neighborDeviceListTLV *)tlv;
 
-            ret->tlv.type = TLV_TYPE_DEVICE_IDENTIFICATION;
+    tlv_length = 6 + 7*m->neighbors_nr;
 
-            _EnB(&p,  ret->friendly_name,      64);
-            _EnB(&p,  ret->manufacturer_name,  64);
-            _EnB(&p,  ret->manufacturer_model, 64);
+    return tlv_length;
+}
 
-            return (uint8_t *)ret;
-        }
+static bool tlv_forge_neighborDeviceList(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.9"
 
-        case TLV_TYPE_CONTROL_URL:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.23"
+    uint8_t *p;
+    struct neighborDeviceListTLV *m;
+
+    uint16_t tlv_length;
 
-            struct controlUrlTypeTLV  *ret;
+    uint8_t i;
 
-            uint8_t *p;
-            uint16_t len;
+    m = (struct neighborDeviceListTLV *)tlv;
+    tlv_length = tlv_length_neighborDeviceList(tlv);
 
-            ret = (struct controlUrlTypeTLV *)memalloc(sizeof(struct controlUrlTypeTLV));
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    _InB( m->local_mac_address,   &p, 6);
 
-            ret->tlv.type       = TLV_TYPE_CONTROL_URL;
+    for (i=0; i<m->neighbors_nr; i++)
+    {
+        uint8_t aux;
 
-            if (len>0)
-            {
-                ret->url            = (char *)memalloc(len);
-                _EnB(&p, ret->url, len);
-            }
+        _InB(m->neighbors[i].mac_address, &p, 6);
 
-            return (uint8_t *)ret;
+        if (1 == m->neighbors[i].bridge_flag)
+        {
+            aux = 1 << 7;
+            _I1B(&aux, &p);
         }
-
-        case TLV_TYPE_IPV4:
+        else
         {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.24"
+            aux = 0;
+            _I1B(&aux, &p);
+        }
+    }
 
-            struct ipv4TypeTLV  *ret;
+    *buf     = p;
+    *length -= tlv_length;
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i, j;
+    return true;
+}
 
-            ret = (struct ipv4TypeTLV *)memalloc(sizeof(struct ipv4TypeTLV));
+static void tlv_print_neighborDeviceList(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct neighborDeviceListTLV *p;
+    uint8_t i;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    p = (struct neighborDeviceListTLV *)tlv;
 
-            ret->tlv.type = TLV_TYPE_IPV4;
+    if (p->neighbors_nr > 0 && NULL == p->neighbors)
+    {
+        // Malformed structure
+        return;
+    }
 
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO entris, the length
-                // should be "1" (which is the length of the next field, that
-                // would containing a "zero", indicating the number of
-                // entries).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no entries", we will also
-                // accept this type of "malformed" packet.
-                //
-                ret->ipv4_interfaces_nr = 0;
-                return (uint8_t *)ret;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
+    print_callback(write_function, prefix, sizeof(p->local_mac_address), "local_mac_address",  "0x%02x",   p->local_mac_address);
+    print_callback(write_function, prefix, sizeof(p->neighbors_nr),      "neighbors_nr",       "%d",      &p->neighbors_nr);
+    for (i=0; i < p->neighbors_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-            _E1B(&p, &ret->ipv4_interfaces_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "%sneighbors[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            if (ret->ipv4_interfaces_nr > 0)
-            {
-                ret->ipv4_interfaces = (struct _ipv4InterfaceEntries *)memalloc(sizeof(struct _ipv4InterfaceEntries) * ret->ipv4_interfaces_nr);
+        print_callback(write_function, new_prefix, sizeof(p->neighbors[i].mac_address), "mac_address", "0x%02x",  p->neighbors[i].mac_address);
+        print_callback(write_function, new_prefix, sizeof(p->neighbors[i].bridge_flag), "bridge_flag", "%d",     &p->neighbors[i].bridge_flag);
+    }
+}
 
-                for (i=0; i < ret->ipv4_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->ipv4_interfaces[i].mac_address, 6);
-                    _E1B(&p, &ret->ipv4_interfaces[i].ipv4_nr);
+static void tlv_free_neighborDeviceList(struct tlv *tlv)
+{
+    struct neighborDeviceListTLV *m;
 
-                    if (ret->ipv4_interfaces[i].ipv4_nr > 0)
-                    {
-                        ret->ipv4_interfaces[i].ipv4 = (struct _ipv4Entries *)memalloc(sizeof(struct _ipv4Entries) * ret->ipv4_interfaces[i].ipv4_nr);
+    m = (struct neighborDeviceListTLV *)tlv;
 
-                        for (j=0; j < ret->ipv4_interfaces[i].ipv4_nr; j++)
-                        {
-                            _E1B(&p, &ret->ipv4_interfaces[i].ipv4[j].type);
-                            _EnB(&p,  ret->ipv4_interfaces[i].ipv4[j].ipv4_address,     4);
-                            _EnB(&p,  ret->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server, 4);
-                        }
-                    }
-                }
-            }
+    if (m->neighbors_nr > 0 && NULL != m->neighbors)
+    {
+        memfree(m->neighbors);
+    }
+    memfree(m);
+}
 
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                for (i=0; i < ret->ipv4_interfaces_nr; i++)
-                {
-                    if (ret->ipv4_interfaces[i].ipv4_nr > 0)
-                    {
-                        free(ret->ipv4_interfaces[i].ipv4);
-                    }
-                }
-                free(ret->ipv4_interfaces);
-                free(ret);
-                return NULL;
-            }
+static bool tlv_compare_neighborDeviceList(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct neighborDeviceListTLV *p1, *p2;
+    uint8_t i;
 
-            return (uint8_t *)ret;
-        }
+    p1 = (struct neighborDeviceListTLV *)tlv1;
+    p2 = (struct neighborDeviceListTLV *)tlv2;
 
-        case TLV_TYPE_IPV6:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.25"
+    if (
+         memcmp(p1->local_mac_address,     p2->local_mac_address, 6) !=0  ||
+                         p1->neighbors_nr       !=  p2->neighbors_nr
+       )
+    {
+        return false;
+    }
 
-            struct ipv6TypeTLV  *ret;
+    if (p1->neighbors_nr > 0 && (NULL == p1->neighbors || NULL == p2->neighbors))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i, j;
+    for (i=0; i<p1->neighbors_nr; i++)
+    {
+        if (
+             memcmp(p1->neighbors[i].mac_address,     p2->neighbors[i].mac_address, 6) !=0  ||
+                             p1->neighbors[i].bridge_flag  !=  p2->neighbors[i].bridge_flag
+           )
+        {
+            return false;
+        }
+    }
 
-            ret = (struct ipv6TypeTLV *)memalloc(sizeof(struct ipv6TypeTLV));
+    return true;
+}
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+/** @} */
 
-            ret->tlv.type = TLV_TYPE_IPV6;
+/** @brief Support functions for transmitterLinkMetric TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.11
+ *
+ * @{
+ */
 
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO entris, the length
-                // should be "1" (which is the length of the next field, that
-                // would containing a "zero", indicating the number of
-                // entries).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no entries", we will also
-                // accept this type of "malformed" packet.
-                //
-                ret->ipv6_interfaces_nr = 0;
-                return (uint8_t *)ret;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
+static struct tlv *tlv_parse_transmitterLinkMetric(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.11"
 
-            _E1B(&p, &ret->ipv6_interfaces_nr);
+    struct transmitterLinkMetricTLV  *ret;
 
-            if (ret->ipv6_interfaces_nr > 0)
-            {
-                ret->ipv6_interfaces = (struct _ipv6InterfaceEntries *)memalloc(sizeof(struct _ipv6InterfaceEntries) * ret->ipv6_interfaces_nr);
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i;
 
-                for (i=0; i < ret->ipv6_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->ipv6_interfaces[i].mac_address,              6);
-                    _EnB(&p,  ret->ipv6_interfaces[i].ipv6_link_local_address, 16);
-                    _E1B(&p, &ret->ipv6_interfaces[i].ipv6_nr);
+    ret = (struct transmitterLinkMetricTLV *)memalloc(sizeof(struct transmitterLinkMetricTLV));
 
-                    if (ret->ipv6_interfaces[i].ipv6_nr > 0)
-                    {
-                        ret->ipv6_interfaces[i].ipv6 = (struct _ipv6Entries *)memalloc(sizeof(struct _ipv6Entries) * ret->ipv6_interfaces[i].ipv6_nr);
+    p   = (uint8_t *)buffer;
+    len = length;
 
-                        for (j=0; j < ret->ipv6_interfaces[i].ipv6_nr; j++)
-                        {
-                            _E1B(&p, &ret->ipv6_interfaces[i].ipv6[j].type);
-                            _EnB(&p,  ret->ipv6_interfaces[i].ipv6[j].ipv6_address,        16);
-                            _EnB(&p,  ret->ipv6_interfaces[i].ipv6[j].ipv6_address_origin, 16);
-                        }
-                    }
-                }
-            }
+    // According to the standard, the length *must* be "12+29*n" where
+    // "n" is "1" or greater
+    //
+    if ((12+29*1) > len)
+    {
+        // Malformed packet
+        //
+        memfree(ret);
+        return NULL;
+    }
+    if (0 != (len-12)%29)
+    {
+        // Malformed packet
+        //
+        memfree(ret);
+        return NULL;
+    }
 
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                for (i=0; i < ret->ipv6_interfaces_nr; i++)
-                {
-                    if (ret->ipv6_interfaces[i].ipv6_nr > 0)
-                    {
-                        free(ret->ipv6_interfaces[i].ipv6);
-                    }
-                }
-                free(ret->ipv6_interfaces);
-                free(ret);
-                return NULL;
-            }
+    ret->tlv.type = TLV_TYPE_TRANSMITTER_LINK_METRIC;
 
-            return (uint8_t *)ret;
-        }
+    _EnB(&p, ret->local_al_address,    6);
+    _EnB(&p, ret->neighbor_al_address, 6);
 
-        case TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.26"
+    ret->transmitter_link_metrics_nr = (len-12)/29;
 
-            struct pushButtonGenericPhyEventNotificationTLV  *ret;
+    ret->transmitter_link_metrics = (struct _transmitterLinkMetricEntries *)memalloc(sizeof(struct _transmitterLinkMetricEntries) * ret->transmitter_link_metrics_nr);
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i;
+    for (i=0; i < ret->transmitter_link_metrics_nr; i++)
+    {
+        _EnB(&p,  ret->transmitter_link_metrics[i].local_interface_address,    6);
+        _EnB(&p,  ret->transmitter_link_metrics[i].neighbor_interface_address, 6);
+
+        _E2B(&p, &ret->transmitter_link_metrics[i].intf_type);
+        _E1B(&p, &ret->transmitter_link_metrics[i].bridge_flag);
+        _E4B(&p, &ret->transmitter_link_metrics[i].packet_errors);
+        _E4B(&p, &ret->transmitter_link_metrics[i].transmitted_packets);
+        _E2B(&p, &ret->transmitter_link_metrics[i].mac_throughput_capacity);
+        _E2B(&p, &ret->transmitter_link_metrics[i].link_availability);
+        _E2B(&p, &ret->transmitter_link_metrics[i].phy_rate);
+    }
 
-            ret = (struct pushButtonGenericPhyEventNotificationTLV *)memalloc(sizeof(struct pushButtonGenericPhyEventNotificationTLV));
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        memfree(ret->transmitter_link_metrics);
+        memfree(ret);
+        return NULL;
+    }
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    return (struct tlv *)ret;
+}
 
-            ret->tlv.type = TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION;
+static uint16_t tlv_length_transmitterLinkMetric(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.11"
 
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO interfaces, the length
-                // should be "1" (which is the length of the next field, that
-                // would containing a "zero", indicating the number of
-                // interfaces).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no interfaces", we will
-                // also accept this type of "malformed" packet.
-                //
-                ret->local_interfaces_nr = 0;
-                return (uint8_t *)ret;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
+    struct transmitterLinkMetricTLV *m;
 
-            _E1B(&p, &ret->local_interfaces_nr);
+    uint16_t tlv_length;
 
-            if (ret->local_interfaces_nr > 0)
-            {
-                ret->local_interfaces = (struct _genericPhyCommonData *)memalloc(sizeof(struct _genericPhyCommonData) * ret->local_interfaces_nr);
+    m = (struct transmitterLinkMetricTLV *)tlv;
 
-                for (i=0; i < ret->local_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->local_interfaces[i].oui, 3);
-                    _E1B(&p, &ret->local_interfaces[i].variant_index);
-                    _E1B(&p, &ret->local_interfaces[i].media_specific_bytes_nr);
+    tlv_length = 12 + 29*m->transmitter_link_metrics_nr;
 
-                    if (ret->local_interfaces[i].media_specific_bytes_nr > 0)
-                    {
-                        ret->local_interfaces[i].media_specific_bytes = (uint8_t *)memalloc(ret->local_interfaces[i].media_specific_bytes_nr);
-                        _EnB(&p, ret->local_interfaces[i].media_specific_bytes, ret->local_interfaces[i].media_specific_bytes_nr);
-                    }
-                }
-            }
+    return tlv_length;
+}
 
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                for (i=0; i < ret->local_interfaces_nr; i++)
-                {
-                    if (ret->local_interfaces[i].media_specific_bytes_nr > 0)
-                    {
-                        free(ret->local_interfaces[i].media_specific_bytes);
-                    }
-                }
-                free(ret->local_interfaces);
-                free(ret);
-                return NULL;
-            }
+static bool tlv_forge_transmitterLinkMetric(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.11"
 
-            return (uint8_t *)ret;
-        }
+    uint8_t *p;
+    struct transmitterLinkMetricTLV *m;
 
-        case TLV_TYPE_1905_PROFILE_VERSION:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.27"
+    uint16_t tlv_length;
 
-            struct x1905ProfileVersionTLV  *ret;
+    uint8_t i;
 
-            uint8_t *p;
-            uint16_t len;
+    m = (struct transmitterLinkMetricTLV *)tlv;
+    tlv_length = tlv_length_transmitterLinkMetric(tlv);
 
-            ret = (struct x1905ProfileVersionTLV *)memalloc(sizeof(struct x1905ProfileVersionTLV));
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    _InB( m->local_al_address,    &p, 6);
+    _InB( m->neighbor_al_address, &p, 6);
 
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
+    for (i=0; i<m->transmitter_link_metrics_nr; i++)
+    {
+        _InB( m->transmitter_link_metrics[i].local_interface_address,    &p, 6);
+        _InB( m->transmitter_link_metrics[i].neighbor_interface_address, &p, 6);
+        _I2B(&m->transmitter_link_metrics[i].intf_type,                  &p);
+        _I1B(&m->transmitter_link_metrics[i].bridge_flag,                &p);
+        _I4B(&m->transmitter_link_metrics[i].packet_errors,              &p);
+        _I4B(&m->transmitter_link_metrics[i].transmitted_packets,        &p);
+        _I2B(&m->transmitter_link_metrics[i].mac_throughput_capacity,    &p);
+        _I2B(&m->transmitter_link_metrics[i].link_availability,          &p);
+        _I2B(&m->transmitter_link_metrics[i].phy_rate,                   &p);
+    }
 
-            ret->tlv.type = TLV_TYPE_1905_PROFILE_VERSION;
+    *buf     = p;
+    *length -= tlv_length;
 
-            _E1B(&p, &ret->profile);
+    return true;
+}
 
-            return (uint8_t *)ret;
-        }
+static void tlv_print_transmitterLinkMetric(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct transmitterLinkMetricTLV *p;
+    uint8_t i;
 
-        case TLV_TYPE_POWER_OFF_INTERFACE:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.28"
+    p = (struct transmitterLinkMetricTLV *)tlv;
 
-            struct powerOffInterfaceTLV  *ret;
+    if (NULL == p->transmitter_link_metrics)
+    {
+        // Malformed structure
+        return;
+    }
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i;
+    print_callback(write_function, prefix, sizeof(p->local_al_address),            "local_al_address",            "0x%02x",   p->local_al_address);
+    print_callback(write_function, prefix, sizeof(p->neighbor_al_address),         "neighbor_al_address",         "0x%02x",   p->neighbor_al_address);
+    print_callback(write_function, prefix, sizeof(p->transmitter_link_metrics_nr), "transmitter_link_metrics_nr", "%d",      &p->transmitter_link_metrics_nr);
+    for (i=0; i < p->transmitter_link_metrics_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
+
+        snprintf(new_prefix, MAX_PREFIX-1, "%stransmitter_link_metrics[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
+
+        print_callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].local_interface_address),    "local_interface_address",    "0x%02x",   p->transmitter_link_metrics[i].local_interface_address);
+        print_callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].neighbor_interface_address), "neighbor_interface_address", "0x%02x",   p->transmitter_link_metrics[i].neighbor_interface_address);
+        print_callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].intf_type),                  "intf_type",                  "0x%04x",  &p->transmitter_link_metrics[i].intf_type);
+        print_callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].bridge_flag),                "bridge_flag",                "%d",      &p->transmitter_link_metrics[i].bridge_flag);
+        print_callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].packet_errors),              "packet_errors",              "%d",      &p->transmitter_link_metrics[i].packet_errors);
+        print_callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].transmitted_packets),        "transmitted_packets",        "%d",      &p->transmitter_link_metrics[i].transmitted_packets);
+        print_callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].mac_throughput_capacity),    "mac_throughput_capacity",    "%d",      &p->transmitter_link_metrics[i].mac_throughput_capacity);
+        print_callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].link_availability),          "link_availability",          "%d",      &p->transmitter_link_metrics[i].link_availability);
+        print_callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].phy_rate),                   "phy_rate",                   "%d",      &p->transmitter_link_metrics[i].phy_rate);
+    }
+}
 
-            ret = (struct powerOffInterfaceTLV *)memalloc(sizeof(struct powerOffInterfaceTLV));
+static void tlv_free_transmitterLinkMetric(struct tlv *tlv)
+{
+    struct transmitterLinkMetricTLV *m;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    m = (struct transmitterLinkMetricTLV *)tlv;
 
-            ret->tlv.type = TLV_TYPE_POWER_OFF_INTERFACE;
+    if (m->transmitter_link_metrics_nr > 0 && NULL != m->transmitter_link_metrics)
+    {
+        memfree(m->transmitter_link_metrics);
+    }
+    memfree(m);
+}
 
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO interfaces, the length
-                // should be "1" (which is the length of the next field, that
-                // would contain a "zero", indicating the number of interfaces)
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no interfaces", we will
-                // also accept this type of "malformed" packet.
-                //
-                ret->power_off_interfaces_nr = 0;
-                return (uint8_t *)ret;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
+static bool tlv_compare_transmitterLinkMetric(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct transmitterLinkMetricTLV *p1, *p2;
+    uint8_t i;
 
-            _E1B(&p, &ret->power_off_interfaces_nr);
+    p1 = (struct transmitterLinkMetricTLV *)tlv1;
+    p2 = (struct transmitterLinkMetricTLV *)tlv2;
 
-            if (ret->power_off_interfaces_nr > 0)
-            {
-                ret->power_off_interfaces = (struct _powerOffInterfaceEntries *)memalloc(sizeof(struct _powerOffInterfaceEntries) * ret->power_off_interfaces_nr);
+    if (
+         memcmp(p1->local_al_address,              p2->local_al_address,    6) !=0  ||
+         memcmp(p1->neighbor_al_address,           p2->neighbor_al_address, 6) !=0  ||
+                         p1->transmitter_link_metrics_nr != p2->transmitter_link_metrics_nr
+       )
+    {
+        return false;
+    }
 
-                for (i=0; i < ret->power_off_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->power_off_interfaces[i].interface_address, 6);
-                    _E2B(&p, &ret->power_off_interfaces[i].media_type);
-                    _EnB(&p,  ret->power_off_interfaces[i].generic_phy_common_data.oui, 3);
-                    _E1B(&p, &ret->power_off_interfaces[i].generic_phy_common_data.variant_index);
-                    _E1B(&p, &ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
+    if (p1->transmitter_link_metrics_nr > 0 && (NULL == p1->transmitter_link_metrics || NULL == p2->transmitter_link_metrics))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
 
-                    if (ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
-                    {
-                        ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes = (uint8_t *)memalloc(ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                        _EnB(&p, ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes, ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                    }
-                }
-            }
+    for (i=0; i<p1->transmitter_link_metrics_nr; i++)
+    {
+        if (
+             memcmp(p1->transmitter_link_metrics[i].local_interface_address,       p2->transmitter_link_metrics[i].local_interface_address,    6) !=0  ||
+             memcmp(p1->transmitter_link_metrics[i].neighbor_interface_address,    p2->transmitter_link_metrics[i].neighbor_interface_address, 6) !=0  ||
+                             p1->transmitter_link_metrics[i].intf_type                  !=  p2->transmitter_link_metrics[i].intf_type                           ||
+                             p1->transmitter_link_metrics[i].bridge_flag                !=  p2->transmitter_link_metrics[i].bridge_flag                         ||
+                             p1->transmitter_link_metrics[i].packet_errors              !=  p2->transmitter_link_metrics[i].packet_errors                       ||
+                             p1->transmitter_link_metrics[i].transmitted_packets        !=  p2->transmitter_link_metrics[i].transmitted_packets                 ||
+                             p1->transmitter_link_metrics[i].mac_throughput_capacity    !=  p2->transmitter_link_metrics[i].mac_throughput_capacity             ||
+                             p1->transmitter_link_metrics[i].link_availability          !=  p2->transmitter_link_metrics[i].link_availability                   ||
+                             p1->transmitter_link_metrics[i].phy_rate                   !=  p2->transmitter_link_metrics[i].phy_rate
+           )
+        {
+            return false;
+        }
+    }
 
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                for (i=0; i < ret->power_off_interfaces_nr; i++)
-                {
-                    if (ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
-                    {
-                        free(ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes);
-                    }
-                }
-                free(ret->power_off_interfaces);
-                free(ret);
-                return NULL;
-            }
+    return true;
+}
 
-            return (uint8_t *)ret;
-        }
+/** @} */
 
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.29"
+/** @brief Support functions for receiverLinkMetric TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.12
+ *
+ * @{
+ */
 
-            struct interfacePowerChangeInformationTLV  *ret;
+static struct tlv *tlv_parse_receiverLinkMetric(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.12"
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i;
+    struct receiverLinkMetricTLV  *ret;
 
-            ret = (struct interfacePowerChangeInformationTLV *)memalloc(sizeof(struct interfacePowerChangeInformationTLV));
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i;
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    ret = (struct receiverLinkMetricTLV *)memalloc(sizeof(struct receiverLinkMetricTLV));
 
-            ret->tlv.type = TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION;
+    p   = (uint8_t *)buffer;
+    len = length;
 
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO interfaces, the length
-                // should be "1" (which is the length of the next field, that
-                // would containing a "zero", indicating the number of
-                // interfaces).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no interfaces", we will
-                // also accept this type of "malformed" packet.
-                //
-                ret->power_change_interfaces_nr = 0;
-                return (uint8_t *)ret;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
+    // According to the standard, the length *must* be "12+23*n" where
+    // "n" is "1" or greater
+    //
+    if ((12+23*1) > len)
+    {
+        // Malformed packet
+        //
+        memfree(ret);
+        return NULL;
+    }
+    if (0 != (len-12)%23)
+    {
+        // Malformed packet
+        //
+        memfree(ret);
+        return NULL;
+    }
 
-            _E1B(&p, &ret->power_change_interfaces_nr);
+    ret->tlv.type = TLV_TYPE_RECEIVER_LINK_METRIC;
 
-            if (ret->power_change_interfaces_nr > 0)
-            {
-                ret->power_change_interfaces = (struct _powerChangeInformationEntries *)memalloc(sizeof(struct _powerChangeInformationEntries) * ret->power_change_interfaces_nr);
+    _EnB(&p, ret->local_al_address,    6);
+    _EnB(&p, ret->neighbor_al_address, 6);
 
-                for (i=0; i < ret->power_change_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->power_change_interfaces[i].interface_address, 6);
-                    _E1B(&p, &ret->power_change_interfaces[i].requested_power_state);
-                }
-            }
+    ret->receiver_link_metrics_nr = (len-12)/23;
 
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                free(ret->power_change_interfaces);
-                free(ret);
-                return NULL;
-            }
+    ret->receiver_link_metrics = (struct _receiverLinkMetricEntries *)memalloc(sizeof(struct _receiverLinkMetricEntries) * ret->receiver_link_metrics_nr);
 
-            return (uint8_t *)ret;
-        }
+    for (i=0; i < ret->receiver_link_metrics_nr; i++)
+    {
+        _EnB(&p,  ret->receiver_link_metrics[i].local_interface_address,    6);
+        _EnB(&p,  ret->receiver_link_metrics[i].neighbor_interface_address, 6);
 
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.30"
+        _E2B(&p, &ret->receiver_link_metrics[i].intf_type);
+        _E4B(&p, &ret->receiver_link_metrics[i].packet_errors);
+        _E4B(&p, &ret->receiver_link_metrics[i].packets_received);
+        _E1B(&p, &ret->receiver_link_metrics[i].rssi);
+    }
 
-            struct interfacePowerChangeStatusTLV  *ret;
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        memfree(ret->receiver_link_metrics);
+        memfree(ret);
+        return NULL;
+    }
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i;
+    return (struct tlv *)ret;
+}
 
-            ret = (struct interfacePowerChangeStatusTLV *)memalloc(sizeof(struct interfacePowerChangeStatusTLV));
+static uint16_t tlv_length_receiverLinkMetric(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.12"
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    struct receiverLinkMetricTLV *m;
 
-            ret->tlv.type = TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS;
+    uint16_t tlv_length;
 
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO interfaces, the length
-                // should be "1" (which is the length of the next field, that
-                // would containing a "zero", indicating the number of
-                // interfaces).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no interfaces", we will
-                // also accept this type of "malformed" packet.
-                //
-                ret->power_change_interfaces_nr = 0;
-                return (uint8_t *)ret;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
+    m = (struct receiverLinkMetricTLV *)tlv;
 
-            _E1B(&p, &ret->power_change_interfaces_nr);
+    tlv_length = 12 + 23*m->receiver_link_metrics_nr;
 
-            if (ret->power_change_interfaces_nr > 0)
-            {
-                ret->power_change_interfaces = (struct _powerChangeStatusEntries *)memalloc(sizeof(struct _powerChangeStatusEntries) * ret->power_change_interfaces_nr);
+    return tlv_length;
+}
 
-                for (i=0; i < ret->power_change_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->power_change_interfaces[i].interface_address, 6);
-                    _E1B(&p, &ret->power_change_interfaces[i].result);
-                }
-            }
+static bool tlv_forge_receiverLinkMetric(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.12"
 
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                if (ret->power_change_interfaces_nr > 0)
-                {
-                    free(ret->power_change_interfaces);
-                }
-                free(ret);
-                return NULL;
-            }
+    uint8_t *p;
+    struct receiverLinkMetricTLV *m;
 
-            return (uint8_t *)ret;
-        }
+    uint16_t tlv_length;
 
-        case TLV_TYPE_L2_NEIGHBOR_DEVICE:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.31"
+    uint8_t i;
 
-            struct l2NeighborDeviceTLV  *ret;
+    m = (struct receiverLinkMetricTLV *)tlv;
+    tlv_length = tlv_length_receiverLinkMetric(tlv);
 
-            uint8_t *p;
-            uint16_t len;
-            uint8_t  i, j, k;
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            ret = (struct l2NeighborDeviceTLV *)memalloc(sizeof(struct l2NeighborDeviceTLV));
+    _InB( m->local_al_address,    &p, 6);
+    _InB( m->neighbor_al_address, &p, 6);
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+    for (i=0; i<m->receiver_link_metrics_nr; i++)
+    {
+        _InB( m->receiver_link_metrics[i].local_interface_address,    &p, 6);
+        _InB( m->receiver_link_metrics[i].neighbor_interface_address, &p, 6);
+        _I2B(&m->receiver_link_metrics[i].intf_type,                  &p);
+        _I4B(&m->receiver_link_metrics[i].packet_errors,              &p);
+        _I4B(&m->receiver_link_metrics[i].packets_received,           &p);
+        _I1B(&m->receiver_link_metrics[i].rssi,                       &p);
+    }
 
-            ret->tlv.type = TLV_TYPE_L2_NEIGHBOR_DEVICE;
+    *buf     = p;
+    *length -= tlv_length;
 
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO interfaces, the length
-                // should be "1" (which is the length of the next field, that
-                // would containing a "zero", indicating the number of
-                // interfaces).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no interfaces", we will
-                // also accept this type of "malformed" packet.
-                //
-                ret->local_interfaces_nr = 0;
-                return (uint8_t *)ret;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
+    return true;
+}
 
-            _E1B(&p, &ret->local_interfaces_nr);
+static void tlv_print_receiverLinkMetric(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct receiverLinkMetricTLV *p;
+    uint8_t i;
 
-            if (ret->local_interfaces_nr > 0)
-            {
-                ret->local_interfaces = (struct _l2InterfacesEntries *)memalloc(sizeof(struct _l2InterfacesEntries) * ret->local_interfaces_nr);
+    p = (struct receiverLinkMetricTLV *)tlv;
 
-                for (i=0; i < ret->local_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->local_interfaces[i].local_mac_address, 6);
-                    _E2B(&p, &ret->local_interfaces[i].l2_neighbors_nr);
+    if (NULL == p->receiver_link_metrics)
+    {
+        // Malformed structure
+        return;
+    }
 
-                    if (ret->local_interfaces[i].l2_neighbors_nr > 0)
-                    {
-                        ret->local_interfaces[i].l2_neighbors = (struct _l2NeighborsEntries *)memalloc(sizeof(struct _l2NeighborsEntries) * ret->local_interfaces[i].l2_neighbors_nr);
+    print_callback(write_function, prefix, sizeof(p->local_al_address),         "local_al_address",         "0x%02x",   p->local_al_address);
+    print_callback(write_function, prefix, sizeof(p->neighbor_al_address),      "neighbor_al_address",      "0x%02x",   p->neighbor_al_address);
+    print_callback(write_function, prefix, sizeof(p->receiver_link_metrics_nr), "receiver_link_metrics_nr", "%d",      &p->receiver_link_metrics_nr);
+    for (i=0; i < p->receiver_link_metrics_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-                        for (j=0; j < ret->local_interfaces[i].l2_neighbors_nr; j++)
-                        {
-                            _EnB(&p,  ret->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address, 6);
-                            _E2B(&p, &ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr);
-
-                            if (ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr > 0)
-                            {
-                                ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses = (uint8_t (*)[6])memalloc(sizeof(uint8_t[6]) * ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr);
-
-                                for (k=0; k < ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr; k++)
-                                {
-                                    _EnB(&p,  ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k], 6);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+        snprintf(new_prefix, MAX_PREFIX-1, "%sreceiver_link_metrics[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                for (i=0; i < ret->local_interfaces_nr; i++)
-                {
-                    for (j=0; j < ret->local_interfaces[i].l2_neighbors_nr; j++)
-                    {
-                        free(ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses);
-                    }
-                    free(ret->local_interfaces[i].l2_neighbors);
-                }
-                free(ret->local_interfaces);
-                free(ret);
-                return NULL;
-            }
+        print_callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].local_interface_address),    "local_interface_address",    "0x%02x",   p->receiver_link_metrics[i].local_interface_address);
+        print_callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].neighbor_interface_address), "neighbor_interface_address", "0x%02x",   p->receiver_link_metrics[i].neighbor_interface_address);
+        print_callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].intf_type),                  "intf_type",                  "0x%04x",  &p->receiver_link_metrics[i].intf_type);
+        print_callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].packet_errors),              "packet_errors",              "%d",      &p->receiver_link_metrics[i].packet_errors);
+        print_callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].packets_received),           "packets_received",           "%d",      &p->receiver_link_metrics[i].packets_received);
+        print_callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].rssi),                       "rssi",                       "%d",      &p->receiver_link_metrics[i].rssi);
+    }
+}
 
-            return (uint8_t *)ret;
-        }
+static void tlv_free_receiverLinkMetric(struct tlv *tlv)
+{
+    struct receiverLinkMetricTLV *m;
 
-        default:
-        {
-            uint8_t *p;
-            uint16_t len;
-            struct tlv_list *parsed;
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-            parsed = tlv_parse(tlv_1905_defs, packet_stream, len + 3);
-            if (parsed == NULL)
-            {
-                // Ignore
-                //
-                return NULL;
-            }
-            else
-            {
-                /* Don't leak tlv_list */
-                return free_dummy_tlv_list(parsed);
-            }
-        }
+    m = (struct receiverLinkMetricTLV *)tlv;
 
+    if (m->receiver_link_metrics_nr > 0 && NULL != m->receiver_link_metrics)
+    {
+        memfree(m->receiver_link_metrics);
     }
-
-    // This code cannot be reached
-    //
-    return NULL;
+    memfree(m);
 }
 
-
-uint8_t *forge_1905_TLV_from_structure(uint8_t *memory_structure, uint16_t *len)
+static bool tlv_compare_receiverLinkMetric(const struct tlv *tlv1, const struct tlv *tlv2)
 {
-    if (NULL == memory_structure)
+    struct receiverLinkMetricTLV *p1, *p2;
+    uint8_t i;
+
+    p1 = (struct receiverLinkMetricTLV *)tlv1;
+    p2 = (struct receiverLinkMetricTLV *)tlv2;
+
+    if (
+         memcmp(p1->local_al_address,           p2->local_al_address,    6) !=0  ||
+         memcmp(p1->neighbor_al_address,        p2->neighbor_al_address, 6) !=0  ||
+                         p1->receiver_link_metrics_nr != p2->receiver_link_metrics_nr
+       )
     {
-        return NULL;
+        return false;
     }
 
-    // The first byte of any of the valid structures is always the "tlv.type"
-    // field.
-    //
-    switch (*memory_structure)
+    if (p1->receiver_link_metrics_nr > 0 && (NULL == p1->receiver_link_metrics || NULL == p2->receiver_link_metrics))
     {
-        case TLV_TYPE_DEVICE_INFORMATION_TYPE:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.5"
+        // Malformed structure
+        //
+        return false;
+    }
 
-            uint8_t *ret, *p;
-            struct deviceInformationTypeTLV *m;
+    for (i=0; i<p1->receiver_link_metrics_nr; i++)
+    {
+        if (
+             memcmp(p1->receiver_link_metrics[i].local_interface_address,       p2->receiver_link_metrics[i].local_interface_address,    6) !=0  ||
+             memcmp(p1->receiver_link_metrics[i].neighbor_interface_address,    p2->receiver_link_metrics[i].neighbor_interface_address, 6) !=0  ||
+                             p1->receiver_link_metrics[i].intf_type                  !=  p2->receiver_link_metrics[i].intf_type                           ||
+                             p1->receiver_link_metrics[i].packet_errors              !=  p2->receiver_link_metrics[i].packet_errors                       ||
+                             p1->receiver_link_metrics[i].packets_received           !=  p2->receiver_link_metrics[i].packets_received                    ||
+                             p1->receiver_link_metrics[i].rssi                       !=  p2->receiver_link_metrics[i].rssi
+           )
+        {
+            return false;
+        }
+    }
 
-            uint16_t tlv_length;
+    return true;
+}
 
-            uint8_t i;
+/** @} */
 
-            m = (struct deviceInformationTypeTLV *)memory_structure;
+/** @brief Support functions for pushButtonEventNotification TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.18
+ *
+ * @{
+ */
 
-            tlv_length = 7;  // AL MAC (6 bytes) + number of ifaces (1 bytes)
-            for (i=0; i<m->local_interfaces_nr; i++)
-            {
-                tlv_length += 6 + 2 + 1;  // MAC (6 bytes) + media type (2
-                                          // bytes) + number of octets (1 byte)
+static struct tlv *tlv_parse_pushButtonEventNotification(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.19"
 
-                tlv_length += m->local_interfaces[i].media_specific_data_size;
-            }
-            *len = 1 + 2 + tlv_length;
+    struct pushButtonEventNotificationTLV  *ret;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    uint8_t *p;
+    uint16_t len;
+    uint8_t i;
 
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->al_mac_address,      &p, 6);
-            _I1B(&m->local_interfaces_nr, &p);
+    ret = (struct pushButtonEventNotificationTLV *)memalloc(sizeof(struct pushButtonEventNotificationTLV));
 
-            for (i=0; i<m->local_interfaces_nr; i++)
-            {
-                _InB( m->local_interfaces[i].mac_address,              &p, 6);
-                _I2B(&m->local_interfaces[i].media_type,               &p);
-                _I1B(&m->local_interfaces[i].media_specific_data_size, &p);
+    p   = (uint8_t *)buffer;
+    len = length;
 
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == m->local_interfaces[i].media_type)
-                   )
-                {
-                    uint8_t aux;
+    ret->tlv.type = TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION;
 
-                    if (10 != m->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed structure
-                        //
-                        free(ret);
-                        return NULL;
-                    }
+    if (0 == len)
+    {
+#ifdef FIX_BROKEN_TLVS
+        // Malformed packet. Even if there are NO bridging tuples, the
+        // Malformed packet. Even if there are NO media types, the
+        // length should be "1" (which is the length of the next field,
+        // that would containing a "zero", indicating the number of
+        // media types).
+        // *However*, because at least one other implementation sets
+        // the 'length' to zero to indicate "no media types", we will
+        // also accept this type of "malformed" packet.
+        //
+        ret->media_types_nr = 0;
+        return (struct tlv *)ret;
+#else
+        memfree(ret);
+        return NULL;
+#endif
+    }
 
-                    _InB(m->local_interfaces[i].media_specific_data.ieee80211.network_membership,                   &p, 6);
-                    aux = m->local_interfaces[i].media_specific_data.ieee80211.role << 4;
-                    _I1B(&aux,                                                                                      &p);
-                    _I1B(&m->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band,                     &p);
-                    _I1B(&m->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1, &p);
-                    _I1B(&m->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2, &p);
+    _E1B(&p, &ret->media_types_nr);
 
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == m->local_interfaces[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == m->local_interfaces[i].media_type)
-                        )
-                {
-                    if (7 != m->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed structure
-                        //
-                        free(ret);
-                        return NULL;
-                    }
-                    _InB(m->local_interfaces[i].media_specific_data.ieee1901.network_identifier, &p, 7);
-                }
-                else
-                {
-                    if (0 != m->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed structure
-                        //
-                        free(ret);
-                        return NULL;
-                    }
-                }
-            }
+    ret->media_types = (struct _mediaTypeEntries *)memalloc(sizeof(struct _mediaTypeEntries) * ret->media_types_nr);
 
-            return ret;
-        }
+    for (i=0; i < ret->media_types_nr; i++)
+    {
+        _E2B(&p, &ret->media_types[i].media_type);
+        _E1B(&p, &ret->media_types[i].media_specific_data_size);
 
-        case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
+        if (
+             (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == ret->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == ret->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == ret->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == ret->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == ret->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == ret->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == ret->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AF_GHZ    == ret->media_types[i].media_type)
+           )
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.6"
-
-            uint8_t *ret, *p;
-            struct deviceBridgingCapabilityTLV *m;
+            uint8_t aux;
 
-            uint16_t tlv_length;
-
-            uint8_t i, j;
-
-            m = (struct deviceBridgingCapabilityTLV *)memory_structure;
-
-            tlv_length = 1;  // number of bridging tuples (1 bytes)
-            for (i=0; i<m->bridging_tuples_nr; i++)
+            if (10 != ret->media_types[i].media_specific_data_size)
             {
-                tlv_length += 1;  // number of MAC addresses (1 bytes)
-                tlv_length += 6 * m->bridging_tuples[i].bridging_tuple_macs_nr;
+                // Malformed packet
+                //
+                memfree(ret->media_types);
+                memfree(ret);
+                return NULL;
             }
-            *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _EnB(&p, ret->media_types[i].media_specific_data.ieee80211.network_membership, 6);
+            _E1B(&p, &aux);
+            ret->media_types[i].media_specific_data.ieee80211.role = aux >> 4;
+            _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_band);
+            _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
+            _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
 
-            _I1B(&m->tlv.type,           &p);
-            _I2B(&tlv_length,            &p);
-            _I1B(&m->bridging_tuples_nr, &p);
-
-            for (i=0; i<m->bridging_tuples_nr; i++)
+        }
+        else if (
+                  (MEDIA_TYPE_IEEE_1901_WAVELET == ret->media_types[i].media_type) ||
+                  (MEDIA_TYPE_IEEE_1901_FFT     == ret->media_types[i].media_type)
+                )
+        {
+            if (7 != ret->media_types[i].media_specific_data_size)
             {
-                _I1B(&m->bridging_tuples[i].bridging_tuple_macs_nr, &p);
-
-                for (j=0; j<m->bridging_tuples[i].bridging_tuple_macs_nr; j++)
-                {
-                    _InB(m->bridging_tuples[i].bridging_tuple_macs[j].mac_address,  &p, 6);
-                }
+                // Malformed packet
+                //
+                memfree(ret->media_types);
+                memfree(ret);
+                return NULL;
             }
-
-            return ret;
+            _EnB(&p, ret->media_types[i].media_specific_data.ieee1901.network_identifier, 7);
         }
-
-        case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:
+        else
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.8"
+            if (0 != ret->media_types[i].media_specific_data_size)
+            {
+                // Malformed packet
+                //
+                memfree(ret->media_types);
+                memfree(ret);
+                return NULL;
+            }
+        }
+    }
 
-            uint8_t *ret, *p;
-            struct non1905NeighborDeviceListTLV *m;
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        memfree(ret->media_types);
+        memfree(ret);
+        return NULL;
+    }
 
-            uint16_t tlv_length;
+    return (struct tlv *)ret;
+}
 
-            uint8_t i;
+static uint16_t tlv_length_pushButtonEventNotification(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.19"
 
-            m = (struct non1905NeighborDeviceListTLV *)memory_structure;
+    struct pushButtonEventNotificationTLV *m;
 
-            tlv_length = 6 + 6*m->non_1905_neighbors_nr;
-            *len = 1 + 2 + tlv_length;
+    uint16_t tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    uint8_t i;
 
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->local_mac_address,   &p, 6);
+    m = (struct pushButtonEventNotificationTLV *)tlv;
 
-            for (i=0; i<m->non_1905_neighbors_nr; i++)
-            {
-                _InB(m->non_1905_neighbors[i].mac_address, &p, 6);
-            }
+    tlv_length = 1;  // number of media types (1 byte)
+    for (i=0; i<m->media_types_nr; i++)
+    {
+        tlv_length += 2 + 1;  //  media type (2 bytes) +
+                              //  number of octets (1 byte)
 
-            return ret;
-        }
+        tlv_length += m->media_types[i].media_specific_data_size;
+    }
 
-        case TLV_TYPE_NEIGHBOR_DEVICE_LIST:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.9"
+    return tlv_length;
+}
 
-            uint8_t *ret, *p;
-            struct neighborDeviceListTLV *m;
+static bool tlv_forge_pushButtonEventNotification(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.19"
 
-            uint16_t tlv_length;
+    uint8_t *p;
+    struct pushButtonEventNotificationTLV *m;
 
-            uint8_t i;
+    uint16_t tlv_length;
 
-            m = (struct neighborDeviceListTLV *)memory_structure;
+    uint8_t i;
 
-            tlv_length = 6 + 7*m->neighbors_nr;
-            *len = 1 + 2 + tlv_length;
+    m = (struct pushButtonEventNotificationTLV *)tlv;
+    tlv_length = tlv_length_pushButtonEventNotification(tlv);
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->local_mac_address,   &p, 6);
+    _I1B(&m->media_types_nr,  &p);
 
-            for (i=0; i<m->neighbors_nr; i++)
-            {
-                uint8_t aux;
+    for (i=0; i<m->media_types_nr; i++)
+    {
+        _I2B(&m->media_types[i].media_type,               &p);
+        _I1B(&m->media_types[i].media_specific_data_size, &p);
 
-                _InB(m->neighbors[i].mac_address, &p, 6);
+        if (
+             (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == m->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == m->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == m->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == m->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == m->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == m->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == m->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AF_GHZ    == m->media_types[i].media_type)
+           )
+        {
+            uint8_t aux;
 
-                if (1 == m->neighbors[i].bridge_flag)
-                {
-                    aux = 1 << 7;
-                    _I1B(&aux, &p);
-                }
-                else
-                {
-                    aux = 0;
-                    _I1B(&aux, &p);
-                }
+            if (10 != m->media_types[i].media_specific_data_size)
+            {
+                // Malformed structure
+                //
+                return false;
             }
 
-            return ret;
-        }
+            _InB(m->media_types[i].media_specific_data.ieee80211.network_membership,                   &p, 6);
+            aux = m->media_types[i].media_specific_data.ieee80211.role << 4;
+            _I1B(&aux,                                                                                 &p);
+            _I1B(&m->media_types[i].media_specific_data.ieee80211.ap_channel_band,                     &p);
+            _I1B(&m->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1, &p);
+            _I1B(&m->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2, &p);
 
-        case TLV_TYPE_TRANSMITTER_LINK_METRIC:
+        }
+        else if (
+                  (MEDIA_TYPE_IEEE_1901_WAVELET == m->media_types[i].media_type) ||
+                  (MEDIA_TYPE_IEEE_1901_FFT     == m->media_types[i].media_type)
+                )
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.11"
-
-            uint8_t *ret, *p;
-            struct transmitterLinkMetricTLV *m;
+            if (7 != m->media_types[i].media_specific_data_size)
+            {
+                // Malformed structure
+                //
+                return false;
+            }
+            _InB(m->media_types[i].media_specific_data.ieee1901.network_identifier, &p, 7);
+        }
+        else
+        {
+            if (0 != m->media_types[i].media_specific_data_size)
+            {
+                // Malformed structure
+                //
+                return false;
+            }
+        }
+    }
 
-            uint16_t tlv_length;
+    *buf     = p;
+    *length -= tlv_length;
 
-            uint8_t i;
+    return true;
+}
 
-            m = (struct transmitterLinkMetricTLV *)memory_structure;
+static void tlv_print_pushButtonEventNotification(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct pushButtonEventNotificationTLV *p;
+    uint8_t i;
 
-            tlv_length = 12 + 29*m->transmitter_link_metrics_nr;
-            *len = 1 + 2 + tlv_length;
+    p = (struct pushButtonEventNotificationTLV *)tlv;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    print_callback(write_function, prefix, sizeof(p->media_types_nr), "media_types_nr",  "0x%02x",  &p->media_types_nr);
+    for (i=0; i < p->media_types_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->local_al_address,    &p, 6);
-            _InB( m->neighbor_al_address, &p, 6);
+        snprintf(new_prefix, MAX_PREFIX-1, "%smedia_types[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            for (i=0; i<m->transmitter_link_metrics_nr; i++)
-            {
-                _InB( m->transmitter_link_metrics[i].local_interface_address,    &p, 6);
-                _InB( m->transmitter_link_metrics[i].neighbor_interface_address, &p, 6);
-                _I2B(&m->transmitter_link_metrics[i].intf_type,                  &p);
-                _I1B(&m->transmitter_link_metrics[i].bridge_flag,                &p);
-                _I4B(&m->transmitter_link_metrics[i].packet_errors,              &p);
-                _I4B(&m->transmitter_link_metrics[i].transmitted_packets,        &p);
-                _I2B(&m->transmitter_link_metrics[i].mac_throughput_capacity,    &p);
-                _I2B(&m->transmitter_link_metrics[i].link_availability,          &p);
-                _I2B(&m->transmitter_link_metrics[i].phy_rate,                   &p);
-            }
+        print_callback(write_function, new_prefix, sizeof(p->media_types[i].media_type),               "media_type",               "0x%04x",  &p->media_types[i].media_type);
+        print_callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data_size), "media_specific_data_size", "%d",      &p->media_types[i].media_specific_data_size);
 
-            return ret;
+        if (
+             (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == p->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == p->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == p->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == p->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == p->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == p->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == p->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AF_GHZ    == p->media_types[i].media_type)
+           )
+        {
+            print_callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee80211.network_membership),                  "network_membership",                   "0x%02x",   p->media_types[i].media_specific_data.ieee80211.network_membership);
+            print_callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee80211.role),                                "role",                                 "%d",      &p->media_types[i].media_specific_data.ieee80211.role);
+            print_callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee80211.ap_channel_band),                     "ap_channel_band",                      "%d",      &p->media_types[i].media_specific_data.ieee80211.ap_channel_band);
+            print_callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1), "ap_channel_center_frequency_index_1",  "%d",      &p->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
+            print_callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2), "ap_channel_center_frequency_index_2",  "%d",      &p->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
         }
-
-        case TLV_TYPE_RECEIVER_LINK_METRIC:
+        else if (
+                  (MEDIA_TYPE_IEEE_1901_WAVELET == p->media_types[i].media_type) ||
+                  (MEDIA_TYPE_IEEE_1901_FFT     == p->media_types[i].media_type)
+                )
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.12"
+            print_callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee1901.network_identifier), "network_identifier", "0x%02x", p->media_types[i].media_specific_data.ieee1901.network_identifier);
+        }
 
-            uint8_t *ret, *p;
-            struct receiverLinkMetricTLV *m;
+    }
+}
 
-            uint16_t tlv_length;
+static void tlv_free_pushButtonEventNotification(struct tlv *tlv)
+{
+    struct pushButtonEventNotificationTLV *m;
 
-            uint8_t i;
+    m = (struct pushButtonEventNotificationTLV *)tlv;
 
-            m = (struct receiverLinkMetricTLV *)memory_structure;
+    if (m->media_types_nr > 0 && NULL != m->media_types)
+    {
+        memfree(m->media_types);
+    }
+    memfree(m);
+}
 
-            tlv_length = 12 + 23*m->receiver_link_metrics_nr;
-            *len = 1 + 2 + tlv_length;
+static bool tlv_compare_pushButtonEventNotification(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct pushButtonEventNotificationTLV *p1, *p2;
+    uint8_t i;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    p1 = (struct pushButtonEventNotificationTLV *)tlv1;
+    p2 = (struct pushButtonEventNotificationTLV *)tlv2;
 
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->local_al_address,    &p, 6);
-            _InB( m->neighbor_al_address, &p, 6);
+    if (p1->media_types_nr !=  p2->media_types_nr)
+    {
+        return false;
+    }
 
-            for (i=0; i<m->receiver_link_metrics_nr; i++)
-            {
-                _InB( m->receiver_link_metrics[i].local_interface_address,    &p, 6);
-                _InB( m->receiver_link_metrics[i].neighbor_interface_address, &p, 6);
-                _I2B(&m->receiver_link_metrics[i].intf_type,                  &p);
-                _I4B(&m->receiver_link_metrics[i].packet_errors,              &p);
-                _I4B(&m->receiver_link_metrics[i].packets_received,           &p);
-                _I1B(&m->receiver_link_metrics[i].rssi,                       &p);
-            }
+    if (p1->media_types_nr > 0 && (NULL == p1->media_types || NULL == p2->media_types))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
 
-            return ret;
+    for (i=0; i<p1->media_types_nr; i++)
+    {
+        if (
+             p1->media_types[i].media_type               !=  p2->media_types[i].media_type               ||
+             p1->media_types[i].media_specific_data_size !=  p2->media_types[i].media_specific_data_size
+           )
+        {
+            return false;
         }
 
-        case TLV_TYPE_LINK_METRIC_RESULT_CODE:
+        if (
+             (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == p1->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == p1->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == p1->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == p1->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == p1->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == p1->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == p1->media_types[i].media_type) ||
+             (MEDIA_TYPE_IEEE_802_11AF_GHZ    == p1->media_types[i].media_type)
+           )
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.13"
-
-            uint8_t *ret, *p;
-            struct linkMetricResultCodeTLV *m;
-
-            uint16_t tlv_length;
-
-            m = (struct linkMetricResultCodeTLV *)memory_structure;
+            if (
+                 memcmp(p1->media_types[i].media_specific_data.ieee80211.network_membership,                     p2->media_types[i].media_specific_data.ieee80211.network_membership,  6) !=0          ||
+                                 p1->media_types[i].media_specific_data.ieee80211.role                                !=  p2->media_types[i].media_specific_data.ieee80211.role                                 ||
+                                 p1->media_types[i].media_specific_data.ieee80211.ap_channel_band                     !=  p2->media_types[i].media_specific_data.ieee80211.ap_channel_band                      ||
+                                 p1->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1 !=  p2->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1
+               )
+            {
+                return false;
+            }
 
-            tlv_length = 1;
-            *len = 1 + 2 + tlv_length;
+        }
+        else if (
+                  (MEDIA_TYPE_IEEE_1901_WAVELET == p1->media_types[i].media_type) ||
+                  (MEDIA_TYPE_IEEE_1901_FFT     == p1->media_types[i].media_type)
+                )
+        {
+            if (
+                 memcmp(p1->media_types[i].media_specific_data.ieee1901.network_identifier,  p2->media_types[i].media_specific_data.ieee1901.network_identifier,  6) !=0
+               )
+            {
+                return false;
+            }
+        }
+    }
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    return true;
+}
 
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
+/** @} */
 
-            if (m->result_code != LINK_METRIC_RESULT_CODE_TLV_INVALID_NEIGHBOR)
-            {
-                // Malformed structure
-                //
-                free(ret);
-                return NULL;
-            }
+/** @brief Support functions for genericPhyDeviceInformationType TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.21
+ *
+ * @{
+ */
 
-            _I1B(&m->result_code,  &p);
+static struct tlv *tlv_parse_genericPhyDeviceInformationType(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.21"
 
-            return ret;
-        }
+    struct genericPhyDeviceInformationTypeTLV  *ret;
 
-        case TLV_TYPE_SEARCHED_ROLE:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.14"
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i;
 
-            uint8_t *ret, *p;
-            struct searchedRoleTLV *m;
+    ret = (struct genericPhyDeviceInformationTypeTLV *)memalloc(sizeof(struct genericPhyDeviceInformationTypeTLV));
 
-            uint16_t tlv_length;
+    p   = (uint8_t *)buffer;
+    len = length;
 
-            m = (struct searchedRoleTLV *)memory_structure;
+    ret->tlv.type = TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION;
 
-            tlv_length = 1;
-            *len = 1 + 2 + tlv_length;
+    _EnB(&p,  ret->al_mac_address, 6);
+    _E1B(&p, &ret->local_interfaces_nr);
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    if (ret->local_interfaces_nr > 0)
+    {
+        ret->local_interfaces = (struct _genericPhyDeviceEntries *)memalloc(sizeof(struct _genericPhyDeviceEntries) * ret->local_interfaces_nr);
 
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
+        for (i=0; i < ret->local_interfaces_nr; i++)
+        {
+            _EnB(&p,  ret->local_interfaces[i].local_interface_address,                 6);
+            _EnB(&p,  ret->local_interfaces[i].generic_phy_common_data.oui,             3);
+            _E1B(&p, &ret->local_interfaces[i].generic_phy_common_data.variant_index);
+            _EnB(&p,  ret->local_interfaces[i].variant_name,                           32);
+            _E1B(&p, &ret->local_interfaces[i].generic_phy_description_xml_url_len);
+            _E1B(&p, &ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
 
-            if (m->role != IEEE80211_ROLE_REGISTRAR)
+            if (ret->local_interfaces[i].generic_phy_description_xml_url_len > 0)
             {
-                // Malformed structure
-                //
-                free(ret);
-                return NULL;
+                ret->local_interfaces[i].generic_phy_description_xml_url = (char *)memalloc(ret->local_interfaces[i].generic_phy_description_xml_url_len);
+                _EnB(&p, ret->local_interfaces[i].generic_phy_description_xml_url, ret->local_interfaces[i].generic_phy_description_xml_url_len);
             }
 
-            _I1B(&m->role,  &p);
-
-            return ret;
+            if (ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
+            {
+                ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes = (uint8_t *)memalloc(ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
+                _EnB(&p, ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes, ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
+            }
         }
+    }
 
-        case TLV_TYPE_AUTOCONFIG_FREQ_BAND:
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        for (i=0; i < ret->local_interfaces_nr; i++)
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.14"
+            if (ret->local_interfaces[i].generic_phy_description_xml_url_len > 0)
+            {
+                memfree(ret->local_interfaces[i].generic_phy_description_xml_url);
+            }
 
-            uint8_t *ret, *p;
-            struct autoconfigFreqBandTLV *m;
+            if (ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
+            {
+                memfree(ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes);
+            }
+        }
+        memfree(ret->local_interfaces);
+        memfree(ret);
+        return NULL;
+    }
 
-            uint16_t tlv_length;
+    return (struct tlv *)ret;
+}
 
-            m = (struct autoconfigFreqBandTLV *)memory_structure;
+static uint16_t tlv_length_genericPhyDeviceInformationType(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.21"
 
-            tlv_length = 1;
-            *len = 1 + 2 + tlv_length;
+    struct genericPhyDeviceInformationTypeTLV *m;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    uint16_t tlv_length;
 
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
+    uint8_t i;
 
-            if (
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_2_4_GHZ) &&
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_5_GHZ)   &&
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_60_GHZ)
-               )
-            {
-                // Malformed structure
-                //
-                free(ret);
-                return NULL;
-            }
+    m = (struct genericPhyDeviceInformationTypeTLV *)tlv;
 
-            _I1B(&m->freq_band,  &p);
+    tlv_length  = 6;  // AL MAC address (6 bytes)
+    tlv_length += 1;  // number of local interfaces (1 bytes)
+    for (i=0; i<m->local_interfaces_nr; i++)
+    {
+        tlv_length += 6;  // local interface MAC address (6 bytes)
+        tlv_length += 3;  // OUI (2 bytes)
+        tlv_length += 1;  // variant_index (1 byte)
+        tlv_length += 32; // variant_name (32 bytes)
+        tlv_length += 1;  // URL len (1 byte)
+        tlv_length += 1;  // media specific bytes number (1 bytes)
+        tlv_length += m->local_interfaces[i].generic_phy_description_xml_url_len;
+                          // URL bytes
+        tlv_length += m->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr;
+                          // media specific bytes
+    }
 
-            return ret;
-        }
+    return tlv_length;
+}
 
-        case TLV_TYPE_SUPPORTED_ROLE:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.16"
+static bool tlv_forge_genericPhyDeviceInformationType(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.21"
 
-            uint8_t *ret, *p;
-            struct supportedRoleTLV *m;
+    uint8_t *p;
+    struct genericPhyDeviceInformationTypeTLV *m;
 
-            uint16_t tlv_length;
+    uint16_t tlv_length;
 
-            m = (struct supportedRoleTLV *)memory_structure;
+    uint8_t i;
 
-            tlv_length = 1;
-            *len = 1 + 2 + tlv_length;
+    m = (struct genericPhyDeviceInformationTypeTLV *)tlv;
+    tlv_length = tlv_length_genericPhyDeviceInformationType(tlv);
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
+    _InB( m->al_mac_address,      &p,  6);
+    _I1B(&m->local_interfaces_nr, &p);
 
-            if (m->role != IEEE80211_ROLE_REGISTRAR)
-            {
-                // Malformed structure
-                //
-                free(ret);
-                return NULL;
-            }
-
-            _I1B(&m->role,  &p);
-
-            return ret;
+    for (i=0; i<m->local_interfaces_nr; i++)
+    {
+        _InB( m->local_interfaces[i].local_interface_address,                         &p, 6);
+        _InB( m->local_interfaces[i].generic_phy_common_data.oui,                     &p, 3);
+        _I1B(&m->local_interfaces[i].generic_phy_common_data.variant_index,           &p);
+        _InB( m->local_interfaces[i].variant_name,                                    &p, 32);
+        _I1B(&m->local_interfaces[i].generic_phy_description_xml_url_len,             &p);
+        _I1B(&m->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr, &p);
+        if (m->local_interfaces[i].generic_phy_description_xml_url_len > 0)
+        {
+            _InB( m->local_interfaces[i].generic_phy_description_xml_url, &p, m->local_interfaces[i].generic_phy_description_xml_url_len);
         }
-
-        case TLV_TYPE_SUPPORTED_FREQ_BAND:
+        if (m->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.17"
-
-            uint8_t *ret, *p;
-            struct supportedFreqBandTLV *m;
+            _InB( m->local_interfaces[i].generic_phy_common_data.media_specific_bytes, &p, m->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
+        }
+    }
 
-            uint16_t tlv_length;
+    *buf     = p;
+    *length -= tlv_length;
 
-            m = (struct supportedFreqBandTLV *)memory_structure;
+    return true;
+}
 
-            tlv_length = 1;
-            *len = 1 + 2 + tlv_length;
+static void tlv_print_genericPhyDeviceInformationType(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct genericPhyDeviceInformationTypeTLV *p;
+    uint8_t i;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    p = (struct genericPhyDeviceInformationTypeTLV *)tlv;
 
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
+    print_callback(write_function, prefix, sizeof(p->al_mac_address),      "al_mac_address",      "0x%02x",  &p->al_mac_address);
+    print_callback(write_function, prefix, sizeof(p->local_interfaces_nr), "local_interfaces_nr", "%d",      &p->local_interfaces_nr);
+    for (i=0; i < p->local_interfaces_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
+
+        snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
+
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].local_interface_address),                         "local_interface_address",             "0x%02x",   p->local_interfaces[i].local_interface_address);
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].generic_phy_common_data.oui),                     "oui",                                 "0x%02x",   p->local_interfaces[i].generic_phy_common_data.oui);
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].generic_phy_common_data.variant_index),           "variant_index",                       "%d",      &p->local_interfaces[i].generic_phy_common_data.variant_index);
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].variant_name),                                    "variant_name",                        "%s",       p->local_interfaces[i].variant_name);
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].generic_phy_description_xml_url_len),             "generic_phy_description_xml_url_len", "%d",      &p->local_interfaces[i].generic_phy_description_xml_url_len);
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr), "media_specific_bytes_nr",             "%d",      &p->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
+        print_callback(write_function, new_prefix, p->local_interfaces[i].generic_phy_description_xml_url_len,                     "generic_phy_description_xml_url",     "%s",       p->local_interfaces[i].generic_phy_description_xml_url);
+        print_callback(write_function, new_prefix, p->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr,         "media_specific_bytes",                "0x%02x",   p->local_interfaces[i].generic_phy_common_data.media_specific_bytes);
+    }
+}
 
-            if (
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_2_4_GHZ) &&
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_5_GHZ)   &&
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_60_GHZ)
-               )
-            {
-                // Malformed structure
-                //
-                free(ret);
-                return NULL;
-            }
+static void tlv_free_genericPhyDeviceInformationType(struct tlv *tlv)
+{
+    struct genericPhyDeviceInformationTypeTLV *m;
+    uint8_t i;
 
-            _I1B(&m->freq_band,  &p);
+    m = (struct genericPhyDeviceInformationTypeTLV *)tlv;
 
-            return ret;
+    for (i=0; i < m->local_interfaces_nr; i++)
+    {
+        if (m->local_interfaces[i].generic_phy_description_xml_url_len > 0 && NULL != m->local_interfaces[i].generic_phy_description_xml_url)
+        {
+            memfree(m->local_interfaces[i].generic_phy_description_xml_url);
         }
 
-        case TLV_TYPE_WSC:
+        if (m->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0 && NULL != m->local_interfaces[i].generic_phy_common_data.media_specific_bytes)
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.18"
-
-            uint8_t *ret, *p;
-            struct wscTLV *m;
-
-            uint16_t tlv_length;
+            memfree(m->local_interfaces[i].generic_phy_common_data.media_specific_bytes);
+        }
+    }
+    if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
+    {
+        memfree(m->local_interfaces);
+    }
+    memfree(m);
+}
 
-            m = (struct wscTLV *)memory_structure;
+static bool tlv_compare_genericPhyDeviceInformationType(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct genericPhyDeviceInformationTypeTLV *p1, *p2;
+    uint8_t i;
 
-            tlv_length = m->wsc_frame_size;
-            *len = 1 + 2 + tlv_length;
+    p1 = (struct genericPhyDeviceInformationTypeTLV *)tlv1;
+    p2 = (struct genericPhyDeviceInformationTypeTLV *)tlv2;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    if (
+         memcmp(p1->al_mac_address,        p2->al_mac_address,     6) !=0  ||
+                         p1->local_interfaces_nr != p2->local_interfaces_nr
+       )
+    {
+        return false;
+    }
 
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
-            _InB( m->wsc_frame,    &p, m->wsc_frame_size);
+    if (p1->local_interfaces_nr > 0 && (NULL == p1->local_interfaces || NULL == p2->local_interfaces))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
 
-            return ret;
+    for (i=0; i<p1->local_interfaces_nr; i++)
+    {
+        if (
+             memcmp(p1->local_interfaces[i].local_interface_address,                             p2->local_interfaces[i].local_interface_address,                      6) !=0  ||
+             memcmp(p1->local_interfaces[i].generic_phy_common_data.oui,                         p2->local_interfaces[i].generic_phy_common_data.oui,                  3) !=0  ||
+                             p1->local_interfaces[i].generic_phy_common_data.variant_index            !=  p2->local_interfaces[i].generic_phy_common_data.variant_index                 ||
+             memcmp(p1->local_interfaces[i].variant_name,                                        p2->local_interfaces[i].variant_name,                                32) !=0  ||
+                             p1->local_interfaces[i].generic_phy_description_xml_url_len              !=  p2->local_interfaces[i].generic_phy_description_xml_url_len                   ||
+                             p1->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr  !=  p2->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr       ||
+             memcmp(p1->local_interfaces[i].generic_phy_description_xml_url,                     p2->local_interfaces[i].generic_phy_description_xml_url,              p1->local_interfaces[i].generic_phy_description_xml_url_len) !=0  ||
+             memcmp(p1->local_interfaces[i].generic_phy_common_data.media_specific_bytes,        p2->local_interfaces[i].generic_phy_common_data.media_specific_bytes, p1->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr) !=0
+           )
+        {
+            return false;
         }
+    }
 
-        case TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.19"
+    return true;
+}
 
-            uint8_t *ret, *p;
-            struct pushButtonEventNotificationTLV *m;
+/** @} */
 
-            uint16_t tlv_length;
+/** @brief Support functions for ipv4Type TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.24
+ *
+ * @{
+ */
 
-            uint8_t i;
+static struct tlv *tlv_parse_ipv4Type(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.24"
 
-            m = (struct pushButtonEventNotificationTLV *)memory_structure;
+    struct ipv4TypeTLV  *ret;
 
-            tlv_length = 1;  // number of media types (1 byte)
-            for (i=0; i<m->media_types_nr; i++)
-            {
-                tlv_length += 2 + 1;  //  media type (2 bytes) +
-                                      //  number of octets (1 byte)
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i, j;
 
-                tlv_length += m->media_types[i].media_specific_data_size;
-            }
-            *len = 1 + 2 + tlv_length;
+    ret = (struct ipv4TypeTLV *)memalloc(sizeof(struct ipv4TypeTLV));
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    p   = (uint8_t *)buffer;
+    len = length;
 
-            _I1B(&m->tlv.type,        &p);
-            _I2B(&tlv_length,         &p);
-            _I1B(&m->media_types_nr,  &p);
+    ret->tlv.type = TLV_TYPE_IPV4;
 
-            for (i=0; i<m->media_types_nr; i++)
-            {
-                _I2B(&m->media_types[i].media_type,               &p);
-                _I1B(&m->media_types[i].media_specific_data_size, &p);
+    if (0 == len)
+    {
+#ifdef FIX_BROKEN_TLVS
+        // Malformed packet. Even if there are NO bridging tuples, the
+        // Malformed packet. Even if there are NO entris, the length
+        // should be "1" (which is the length of the next field, that
+        // would containing a "zero", indicating the number of
+        // entries).
+        // *However*, because at least one other implementation sets
+        // the 'length' to zero to indicate "no entries", we will also
+        // accept this type of "malformed" packet.
+        //
+        ret->ipv4_interfaces_nr = 0;
+        return (struct tlv *)ret;
+#else
+        memfree(ret);
+        return NULL;
+#endif
+    }
 
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == m->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == m->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == m->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == m->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == m->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == m->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == m->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == m->media_types[i].media_type)
-                   )
-                {
-                    uint8_t aux;
+    _E1B(&p, &ret->ipv4_interfaces_nr);
 
-                    if (10 != m->media_types[i].media_specific_data_size)
-                    {
-                        // Malformed structure
-                        //
-                        free(ret);
-                        return NULL;
-                    }
+    if (ret->ipv4_interfaces_nr > 0)
+    {
+        ret->ipv4_interfaces = (struct _ipv4InterfaceEntries *)memalloc(sizeof(struct _ipv4InterfaceEntries) * ret->ipv4_interfaces_nr);
 
-                    _InB(m->media_types[i].media_specific_data.ieee80211.network_membership,                   &p, 6);
-                    aux = m->media_types[i].media_specific_data.ieee80211.role << 4;
-                    _I1B(&aux,                                                                                 &p);
-                    _I1B(&m->media_types[i].media_specific_data.ieee80211.ap_channel_band,                     &p);
-                    _I1B(&m->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1, &p);
-                    _I1B(&m->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2, &p);
+        for (i=0; i < ret->ipv4_interfaces_nr; i++)
+        {
+            _EnB(&p,  ret->ipv4_interfaces[i].mac_address, 6);
+            _E1B(&p, &ret->ipv4_interfaces[i].ipv4_nr);
 
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == m->media_types[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == m->media_types[i].media_type)
-                        )
-                {
-                    if (7 != m->media_types[i].media_specific_data_size)
-                    {
-                        // Malformed structure
-                        //
-                        free(ret);
-                        return NULL;
-                    }
-                    _InB(m->media_types[i].media_specific_data.ieee1901.network_identifier, &p, 7);
-                }
-                else
+            if (ret->ipv4_interfaces[i].ipv4_nr > 0)
+            {
+                ret->ipv4_interfaces[i].ipv4 = (struct _ipv4Entries *)memalloc(sizeof(struct _ipv4Entries) * ret->ipv4_interfaces[i].ipv4_nr);
+
+                for (j=0; j < ret->ipv4_interfaces[i].ipv4_nr; j++)
                 {
-                    if (0 != m->media_types[i].media_specific_data_size)
-                    {
-                        // Malformed structure
-                        //
-                        free(ret);
-                        return NULL;
-                    }
+                    _E1B(&p, &ret->ipv4_interfaces[i].ipv4[j].type);
+                    _EnB(&p,  ret->ipv4_interfaces[i].ipv4[j].ipv4_address,     4);
+                    _EnB(&p,  ret->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server, 4);
                 }
             }
-
-            return ret;
         }
+    }
 
-        case TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION:
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        for (i=0; i < ret->ipv4_interfaces_nr; i++)
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.20"
-
-            uint8_t *ret, *p;
-            struct pushButtonJoinNotificationTLV *m;
+            if (ret->ipv4_interfaces[i].ipv4_nr > 0)
+            {
+                memfree(ret->ipv4_interfaces[i].ipv4);
+            }
+        }
+        memfree(ret->ipv4_interfaces);
+        memfree(ret);
+        return NULL;
+    }
 
-            uint16_t tlv_length;
+    return (struct tlv *)ret;
+}
 
-            m = (struct pushButtonJoinNotificationTLV *)memory_structure;
+static uint16_t tlv_length_ipv4Type(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.24"
 
-            tlv_length = 20;
-            *len = 1 + 2 + tlv_length;
+    struct ipv4TypeTLV *m;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    uint16_t tlv_length;
 
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->al_mac_address,      &p, 6);
-            _I2B(&m->message_identifier,  &p);
-            _InB( m->mac_address,         &p, 6);
-            _InB( m->new_mac_address,     &p, 6);
+    uint8_t i;
 
-            return ret;
-        }
+    m = (struct ipv4TypeTLV *)tlv;
 
-        case TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.21"
+    tlv_length = 1;  // number of entries (1 bytes)
+    for (i=0; i<m->ipv4_interfaces_nr; i++)
+    {
+        tlv_length += 6;  // interface MAC address (6 bytes)
+        tlv_length += 1;  // number of IPv4s (1 bytes)
+        tlv_length += (1+4+4) * m->ipv4_interfaces[i].ipv4_nr;
+    }
 
-            uint8_t *ret, *p;
-            struct genericPhyDeviceInformationTypeTLV *m;
+    return tlv_length;
+}
 
-            uint16_t tlv_length;
+static bool tlv_forge_ipv4Type(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.24"
 
-            uint8_t i;
+    uint8_t *p;
+    struct ipv4TypeTLV *m;
 
-            m = (struct genericPhyDeviceInformationTypeTLV *)memory_structure;
+    uint16_t tlv_length;
 
-            tlv_length  = 6;  // AL MAC address (6 bytes)
-            tlv_length += 1;  // number of local interfaces (1 bytes)
-            for (i=0; i<m->local_interfaces_nr; i++)
-            {
-                tlv_length += 6;  // local interface MAC address (6 bytes)
-                tlv_length += 3;  // OUI (2 bytes)
-                tlv_length += 1;  // variant_index (1 byte)
-                tlv_length += 32; // variant_name (32 bytes)
-                tlv_length += 1;  // URL len (1 byte)
-                tlv_length += 1;  // media specific bytes number (1 bytes)
-                tlv_length += m->local_interfaces[i].generic_phy_description_xml_url_len;
-                                  // URL bytes
-                tlv_length += m->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr;
-                                  // media specific bytes
-            }
-            *len = 1 + 2 + tlv_length;
+    uint8_t i, j;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    m = (struct ipv4TypeTLV *)tlv;
+    tlv_length = tlv_length_ipv4Type(tlv);
 
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->al_mac_address,      &p,  6);
-            _I1B(&m->local_interfaces_nr, &p);
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            for (i=0; i<m->local_interfaces_nr; i++)
-            {
-                _InB( m->local_interfaces[i].local_interface_address,                         &p, 6);
-                _InB( m->local_interfaces[i].generic_phy_common_data.oui,                     &p, 3);
-                _I1B(&m->local_interfaces[i].generic_phy_common_data.variant_index,           &p);
-                _InB( m->local_interfaces[i].variant_name,                                    &p, 32);
-                _I1B(&m->local_interfaces[i].generic_phy_description_xml_url_len,             &p);
-                _I1B(&m->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr, &p);
-                if (m->local_interfaces[i].generic_phy_description_xml_url_len > 0)
-                {
-                    _InB( m->local_interfaces[i].generic_phy_description_xml_url, &p, m->local_interfaces[i].generic_phy_description_xml_url_len);
-                }
-                if (m->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
-                {
-                    _InB( m->local_interfaces[i].generic_phy_common_data.media_specific_bytes, &p, m->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                }
-            }
+    _I1B(&m->ipv4_interfaces_nr, &p);
 
-            return ret;
-        }
+    for (i=0; i<m->ipv4_interfaces_nr; i++)
+    {
+        _InB( m->ipv4_interfaces[i].mac_address, &p, 6);
+        _I1B(&m->ipv4_interfaces[i].ipv4_nr,     &p);
 
-        case TLV_TYPE_DEVICE_IDENTIFICATION:
+        for (j=0; j<m->ipv4_interfaces[i].ipv4_nr; j++)
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.21"
+            _I1B(&m->ipv4_interfaces[i].ipv4[j].type,             &p);
+            _InB( m->ipv4_interfaces[i].ipv4[j].ipv4_address,     &p, 4);
+            _InB( m->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server, &p, 4);
+        }
+    }
 
-            uint8_t *ret, *p;
-            struct deviceIdentificationTypeTLV *m;
+    *buf     = p;
+    *length -= tlv_length;
 
-            uint16_t tlv_length;
+    return true;
+}
 
-            m = (struct deviceIdentificationTypeTLV *)memory_structure;
+static void tlv_print_ipv4Type(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct ipv4TypeTLV *p;
+    uint8_t i, j;
 
-            tlv_length = 192;
-            *len = 1 + 2 + tlv_length;
+    p = (struct ipv4TypeTLV *)tlv;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    print_callback(write_function, prefix, sizeof(p->ipv4_interfaces_nr), "ipv4_interfaces_nr", "%d",  &p->ipv4_interfaces_nr);
+    for (i=0; i < p->ipv4_interfaces_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-            _I1B(&m->tlv.type,           &p);
-            _I2B(&tlv_length,            &p);
-            _InB( m->friendly_name,      &p, 64);
-            _InB( m->manufacturer_name,  &p, 64);
-            _InB( m->manufacturer_model, &p, 64);
+        snprintf(new_prefix, MAX_PREFIX-1, "%sipv4_interfaces[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            return ret;
-        }
+        print_callback(write_function, new_prefix, sizeof(p->ipv4_interfaces[i].mac_address), "mac_address", "0x%02x",   p->ipv4_interfaces[i].mac_address);
+        print_callback(write_function, new_prefix, sizeof(p->ipv4_interfaces[i].ipv4_nr),     "ipv4_nr",     "%d",      &p->ipv4_interfaces[i].ipv4_nr);
 
-        case TLV_TYPE_CONTROL_URL:
+        for (j=0; j < p->ipv4_interfaces[i].ipv4_nr; j++)
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.23"
-
-            uint8_t *ret, *p;
-            struct controlUrlTypeTLV *m;
+            snprintf(new_prefix, MAX_PREFIX-1, "%sipv4_interfaces[%d]->ipv4[%d]->", prefix, i, j);
+            new_prefix[MAX_PREFIX-1] = 0x0;
 
-            uint16_t tlv_length;
-
-            m = (struct controlUrlTypeTLV *)memory_structure;
-
-            tlv_length = strlen(m->url)+1;
-            *len = 1 + 2 + tlv_length;
+            print_callback(write_function, new_prefix, sizeof(p->ipv4_interfaces[i].ipv4[j].type),             "type",             "%d",     &p->ipv4_interfaces[i].ipv4[j].type);
+            print_callback(write_function, new_prefix, sizeof(p->ipv4_interfaces[i].ipv4[j].ipv4_address),     "ipv4_address",     "%ipv4",   p->ipv4_interfaces[i].ipv4[j].ipv4_address);
+            print_callback(write_function, new_prefix, sizeof(p->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server), "ipv4_dhcp_server", "%ipv4",   p->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server);
+        }
+    }
+}
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+static void tlv_free_ipv4Type(struct tlv *tlv)
+{
+    struct ipv4TypeTLV *m;
+    uint8_t i;
 
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
-            _InB( m->url,          &p, tlv_length);
+    m = (struct ipv4TypeTLV *)tlv;
 
-            return ret;
+    for (i=0; i < m->ipv4_interfaces_nr; i++)
+    {
+        if (m->ipv4_interfaces[i].ipv4_nr > 0 && NULL != m->ipv4_interfaces[i].ipv4)
+        {
+            memfree(m->ipv4_interfaces[i].ipv4);
         }
+    }
+    if (m->ipv4_interfaces_nr > 0 && NULL != m->ipv4_interfaces)
+    {
+        memfree(m->ipv4_interfaces);
+    }
+    memfree(m);
+}
 
-        case TLV_TYPE_IPV4:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.24"
+static bool tlv_compare_ipv4Type(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct ipv4TypeTLV *p1, *p2;
+    uint8_t i, j;
 
-            uint8_t *ret, *p;
-            struct ipv4TypeTLV *m;
+    p1 = (struct ipv4TypeTLV *)tlv1;
+    p2 = (struct ipv4TypeTLV *)tlv2;
 
-            uint16_t tlv_length;
+    if (
+         p1->ipv4_interfaces_nr != p2->ipv4_interfaces_nr
+       )
+    {
+        return false;
+    }
 
-            uint8_t i, j;
+    if (p1->ipv4_interfaces_nr > 0 && (NULL == p1->ipv4_interfaces || NULL == p2->ipv4_interfaces))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
 
-            m = (struct ipv4TypeTLV *)memory_structure;
+    for (i=0; i<p1->ipv4_interfaces_nr; i++)
+    {
+        if (
+             memcmp(p1->ipv4_interfaces[i].mac_address,     p2->ipv4_interfaces[i].mac_address, 6) !=0   ||
+                             p1->ipv4_interfaces[i].ipv4_nr      !=  p2->ipv4_interfaces[i].ipv4_nr
+           )
+        {
+            return false;
+        }
 
-            tlv_length = 1;  // number of entries (1 bytes)
-            for (i=0; i<m->ipv4_interfaces_nr; i++)
+        for (j=0; j<p1->ipv4_interfaces[i].ipv4_nr; j++)
+        {
+            if (
+                                 p1->ipv4_interfaces[i].ipv4[j].type              !=  p2->ipv4_interfaces[i].ipv4[j].type                       ||
+                 memcmp(p1->ipv4_interfaces[i].ipv4[j].ipv4_address,         p2->ipv4_interfaces[i].ipv4[j].ipv4_address,     4) !=0   ||
+                 memcmp(p1->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server,     p2->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server, 4) !=0
+               )
             {
-                tlv_length += 6;  // interface MAC address (6 bytes)
-                tlv_length += 1;  // number of IPv4s (1 bytes)
-                tlv_length += (1+4+4) * m->ipv4_interfaces[i].ipv4_nr;
+                return false;
             }
-            *len = 1 + 2 + tlv_length;
+        }
+    }
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    return true;
+}
 
-            _I1B(&m->tlv.type,           &p);
-            _I2B(&tlv_length,            &p);
-            _I1B(&m->ipv4_interfaces_nr, &p);
+/** @} */
 
-            for (i=0; i<m->ipv4_interfaces_nr; i++)
-            {
-                _InB( m->ipv4_interfaces[i].mac_address, &p, 6);
-                _I1B(&m->ipv4_interfaces[i].ipv4_nr,     &p);
+/** @brief Support functions for ipv6Type TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.25
+ *
+ * @{
+ */
 
-                for (j=0; j<m->ipv4_interfaces[i].ipv4_nr; j++)
-                {
-                    _I1B(&m->ipv4_interfaces[i].ipv4[j].type,             &p);
-                    _InB( m->ipv4_interfaces[i].ipv4[j].ipv4_address,     &p, 4);
-                    _InB( m->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server, &p, 4);
-                }
-            }
+static struct tlv *tlv_parse_ipv6Type(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.25"
 
-            return ret;
-        }
+    struct ipv6TypeTLV  *ret;
 
-        case TLV_TYPE_IPV6:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.25"
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i, j;
 
-            uint8_t *ret, *p;
-            struct ipv6TypeTLV *m;
+    ret = (struct ipv6TypeTLV *)memalloc(sizeof(struct ipv6TypeTLV));
 
-            uint16_t tlv_length;
+    p   = (uint8_t *)buffer;
+    len = length;
 
-            uint8_t i, j;
+    ret->tlv.type = TLV_TYPE_IPV6;
 
-            m = (struct ipv6TypeTLV *)memory_structure;
+    if (0 == len)
+    {
+#ifdef FIX_BROKEN_TLVS
+        // Malformed packet. Even if there are NO bridging tuples, the
+        // Malformed packet. Even if there are NO entris, the length
+        // should be "1" (which is the length of the next field, that
+        // would containing a "zero", indicating the number of
+        // entries).
+        // *However*, because at least one other implementation sets
+        // the 'length' to zero to indicate "no entries", we will also
+        // accept this type of "malformed" packet.
+        //
+        ret->ipv6_interfaces_nr = 0;
+        return (struct tlv *)ret;
+#else
+        memfree(ret);
+        return NULL;
+#endif
+    }
 
-            tlv_length = 1;  // number of entries (1 bytes)
-            for (i=0; i<m->ipv6_interfaces_nr; i++)
-            {
-                tlv_length += 6;  // interface MAC address (6 bytes)
-                tlv_length += 16; // interface ipv6 local link address (16 bytes)
-                tlv_length += 1;  // number of ipv6s (1 bytes)
-                tlv_length += (1+16+16) * m->ipv6_interfaces[i].ipv6_nr;
-            }
-            *len = 1 + 2 + tlv_length;
+    _E1B(&p, &ret->ipv6_interfaces_nr);
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    if (ret->ipv6_interfaces_nr > 0)
+    {
+        ret->ipv6_interfaces = (struct _ipv6InterfaceEntries *)memalloc(sizeof(struct _ipv6InterfaceEntries) * ret->ipv6_interfaces_nr);
 
-            _I1B(&m->tlv.type,           &p);
-            _I2B(&tlv_length,            &p);
-            _I1B(&m->ipv6_interfaces_nr, &p);
+        for (i=0; i < ret->ipv6_interfaces_nr; i++)
+        {
+            _EnB(&p,  ret->ipv6_interfaces[i].mac_address,              6);
+            _EnB(&p,  ret->ipv6_interfaces[i].ipv6_link_local_address, 16);
+            _E1B(&p, &ret->ipv6_interfaces[i].ipv6_nr);
 
-            for (i=0; i<m->ipv6_interfaces_nr; i++)
+            if (ret->ipv6_interfaces[i].ipv6_nr > 0)
             {
-                _InB( m->ipv6_interfaces[i].mac_address,             &p,  6);
-                _InB( m->ipv6_interfaces[i].ipv6_link_local_address, &p, 16);
-                _I1B(&m->ipv6_interfaces[i].ipv6_nr,                 &p);
+                ret->ipv6_interfaces[i].ipv6 = (struct _ipv6Entries *)memalloc(sizeof(struct _ipv6Entries) * ret->ipv6_interfaces[i].ipv6_nr);
 
-                for (j=0; j<m->ipv6_interfaces[i].ipv6_nr; j++)
+                for (j=0; j < ret->ipv6_interfaces[i].ipv6_nr; j++)
                 {
-                    _I1B(&m->ipv6_interfaces[i].ipv6[j].type,                &p);
-                    _InB( m->ipv6_interfaces[i].ipv6[j].ipv6_address,        &p, 16);
-                    _InB( m->ipv6_interfaces[i].ipv6[j].ipv6_address_origin, &p, 16);
+                    _E1B(&p, &ret->ipv6_interfaces[i].ipv6[j].type);
+                    _EnB(&p,  ret->ipv6_interfaces[i].ipv6[j].ipv6_address,        16);
+                    _EnB(&p,  ret->ipv6_interfaces[i].ipv6[j].ipv6_address_origin, 16);
                 }
             }
-
-            return ret;
         }
+    }
 
-        case TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION:
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        for (i=0; i < ret->ipv6_interfaces_nr; i++)
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.26"
-
-            uint8_t *ret, *p;
-            struct pushButtonGenericPhyEventNotificationTLV *m;
-
-            uint16_t tlv_length;
-
-            uint8_t i;
-
-            m = (struct pushButtonGenericPhyEventNotificationTLV *)memory_structure;
-
-            tlv_length = 1;  // number of local interfaces (1 bytes)
-            for (i=0; i<m->local_interfaces_nr; i++)
-            {
-                tlv_length += 3;  // OUI (2 bytes)
-                tlv_length += 1;  // variant_index (1 byte)
-                tlv_length += 1;  // media specific bytes number (1 bytes)
-                tlv_length += m->local_interfaces[i].media_specific_bytes_nr;
-                                  // media specific bytes
-            }
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,                &p);
-            _I2B(&tlv_length,                 &p);
-            _I1B(&m->local_interfaces_nr, &p);
-
-            for (i=0; i<m->local_interfaces_nr; i++)
+            if (ret->ipv6_interfaces[i].ipv6_nr > 0)
             {
-                _InB( m->local_interfaces[i].oui,                     &p, 3);
-                _I1B(&m->local_interfaces[i].variant_index,           &p);
-                _I1B(&m->local_interfaces[i].media_specific_bytes_nr, &p);
-                if (m->local_interfaces[i].media_specific_bytes_nr > 0)
-                {
-                    _InB( m->local_interfaces[i].media_specific_bytes, &p, m->local_interfaces[i].media_specific_bytes_nr);
-                }
+                memfree(ret->ipv6_interfaces[i].ipv6);
             }
-
-            return ret;
         }
+        memfree(ret->ipv6_interfaces);
+        memfree(ret);
+        return NULL;
+    }
 
-        case TLV_TYPE_1905_PROFILE_VERSION:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.27"
+    return (struct tlv *)ret;
+}
 
-            uint8_t *ret, *p;
-            struct x1905ProfileVersionTLV *m;
+static uint16_t tlv_length_ipv6Type(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.25"
 
-            uint16_t tlv_length;
+    struct ipv6TypeTLV *m;
 
-            m = (struct x1905ProfileVersionTLV *)memory_structure;
+    uint16_t tlv_length;
 
-            tlv_length = 1;
-            *len = 1 + 2 + tlv_length;
+    uint8_t i;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    m = (struct ipv6TypeTLV *)tlv;
 
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
+    tlv_length = 1;  // number of entries (1 bytes)
+    for (i=0; i<m->ipv6_interfaces_nr; i++)
+    {
+        tlv_length += 6;  // interface MAC address (6 bytes)
+        tlv_length += 16; // interface ipv6 local link address (16 bytes)
+        tlv_length += 1;  // number of ipv6s (1 bytes)
+        tlv_length += (1+16+16) * m->ipv6_interfaces[i].ipv6_nr;
+    }
 
-            if (
-                 m->profile != PROFILE_1905_1 &&
-                 m->profile != PROFILE_1905_1A
-               )
-            {
-                // Malformed structure
-                //
-                free(ret);
-                return NULL;
-            }
+    return tlv_length;
+}
 
-            _I1B(&m->profile,  &p);
+static bool tlv_forge_ipv6Type(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.25"
 
-            return ret;
-        }
+    uint8_t *p;
+    struct ipv6TypeTLV *m;
 
-        case TLV_TYPE_POWER_OFF_INTERFACE:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.28"
+    uint16_t tlv_length;
 
-            uint8_t *ret, *p;
-            struct powerOffInterfaceTLV *m;
+    uint8_t i, j;
 
-            uint16_t tlv_length;
+    m = (struct ipv6TypeTLV *)tlv;
+    tlv_length = tlv_length_ipv6Type(tlv);
 
-            uint8_t i;
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            m = (struct powerOffInterfaceTLV *)memory_structure;
+    _I1B(&m->ipv6_interfaces_nr, &p);
 
-            tlv_length = 1;  // number of power off interfaces (1 bytes)
-            for (i=0; i<m->power_off_interfaces_nr; i++)
-            {
-                tlv_length += 6;  // interface MAC address (6 bytes)
-                tlv_length += 2;  // media type (2 bytes)
-                tlv_length += 3;  // OUI (2 bytes)
-                tlv_length += 1;  // variant_index (1 byte)
-                tlv_length += 1;  // media specific bytes number (1 bytes)
-                tlv_length += m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr;
-                                  // media specific bytes
-            }
-            *len = 1 + 2 + tlv_length;
+    for (i=0; i<m->ipv6_interfaces_nr; i++)
+    {
+        _InB( m->ipv6_interfaces[i].mac_address,             &p,  6);
+        _InB( m->ipv6_interfaces[i].ipv6_link_local_address, &p, 16);
+        _I1B(&m->ipv6_interfaces[i].ipv6_nr,                 &p);
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+        for (j=0; j<m->ipv6_interfaces[i].ipv6_nr; j++)
+        {
+            _I1B(&m->ipv6_interfaces[i].ipv6[j].type,                &p);
+            _InB( m->ipv6_interfaces[i].ipv6[j].ipv6_address,        &p, 16);
+            _InB( m->ipv6_interfaces[i].ipv6[j].ipv6_address_origin, &p, 16);
+        }
+    }
 
-            _I1B(&m->tlv.type,                &p);
-            _I2B(&tlv_length,                 &p);
-            _I1B(&m->power_off_interfaces_nr, &p);
+    *buf     = p;
+    *length -= tlv_length;
 
-            for (i=0; i<m->power_off_interfaces_nr; i++)
-            {
-                _InB( m->power_off_interfaces[i].interface_address,                               &p, 6);
-                _I2B(&m->power_off_interfaces[i].media_type,                                      &p);
-                _InB( m->power_off_interfaces[i].generic_phy_common_data.oui,                     &p, 3);
-                _I1B(&m->power_off_interfaces[i].generic_phy_common_data.variant_index,           &p);
-                _I1B(&m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr, &p);
-                if (m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
-                {
-                    _InB( m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes, &p, m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                }
-            }
+    return true;
+}
 
-            return ret;
-        }
+static void tlv_print_ipv6Type(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct ipv6TypeTLV *p;
+    uint8_t i, j;
 
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.29"
+    p = (struct ipv6TypeTLV *)tlv;
 
-            uint8_t *ret, *p;
-            struct interfacePowerChangeInformationTLV *m;
+    print_callback(write_function, prefix, sizeof(p->ipv6_interfaces_nr), "ipv6_interfaces_nr", "%d",  &p->ipv6_interfaces_nr);
+    for (i=0; i < p->ipv6_interfaces_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-            uint16_t tlv_length;
+        snprintf(new_prefix, MAX_PREFIX-1, "%sipv6_interfaces[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            uint8_t i;
+        print_callback(write_function, new_prefix, sizeof(p->ipv6_interfaces[i].mac_address), "mac_address", "0x%02x",   p->ipv6_interfaces[i].mac_address);
+        print_callback(write_function, new_prefix, sizeof(p->ipv6_interfaces[i].ipv6_nr),     "ipv6_nr",     "%d",      &p->ipv6_interfaces[i].ipv6_nr);
 
-            m = (struct interfacePowerChangeInformationTLV *)memory_structure;
+        for (j=0; j < p->ipv6_interfaces[i].ipv6_nr; j++)
+        {
+            snprintf(new_prefix, MAX_PREFIX-1, "%sipv6_interfaces[%d]->ipv6[%d]->", prefix, i, j);
+            new_prefix[MAX_PREFIX-1] = 0x0;
 
-            tlv_length  = 1;  // number of interfaces (1 bytes)
-            tlv_length += (6+1) * m->power_change_interfaces_nr;
+            print_callback(write_function, new_prefix, sizeof(p->ipv6_interfaces[i].ipv6[j].type),                "type",                "%d",      &p->ipv6_interfaces[i].ipv6[j].type);
+            print_callback(write_function, new_prefix, sizeof(p->ipv6_interfaces[i].ipv6[j].ipv6_address),        "ipv6_address",        "0x%02x",   p->ipv6_interfaces[i].ipv6[j].ipv6_address);
+            print_callback(write_function, new_prefix, sizeof(p->ipv6_interfaces[i].ipv6[j].ipv6_address_origin), "ipv6_address_origin", "0x%02x",   p->ipv6_interfaces[i].ipv6[j].ipv6_address_origin);
+        }
+    }
+}
 
-            *len = 1 + 2 + tlv_length;
+static void tlv_free_ipv6Type(struct tlv *tlv)
+{
+    struct ipv6TypeTLV *m;
+    uint8_t i;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    m = (struct ipv6TypeTLV *)tlv;
 
-            _I1B(&m->tlv.type,                   &p);
-            _I2B(&tlv_length,                    &p);
-            _I1B(&m->power_change_interfaces_nr, &p);
-
-            for (i=0; i<m->power_change_interfaces_nr; i++)
-            {
-                _InB( m->power_change_interfaces[i].interface_address,     &p, 6);
-                _I1B(&m->power_change_interfaces[i].requested_power_state, &p);
-            }
-
-            return ret;
-        }
-
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS:
+    for (i=0; i < m->ipv6_interfaces_nr; i++)
+    {
+        if (m->ipv6_interfaces[i].ipv6_nr > 0 && NULL != m->ipv6_interfaces[i].ipv6)
         {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.30"
-
-            uint8_t *ret, *p;
-            struct interfacePowerChangeStatusTLV *m;
-
-            uint16_t tlv_length;
-
-            uint8_t i;
+            memfree(m->ipv6_interfaces[i].ipv6);
+        }
+    }
+    if (m->ipv6_interfaces_nr > 0 && NULL != m->ipv6_interfaces)
+    {
+        memfree(m->ipv6_interfaces);
+    }
+    memfree(m);
+}
 
-            m = (struct interfacePowerChangeStatusTLV *)memory_structure;
+static bool tlv_compare_ipv6Type(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct ipv6TypeTLV *p1, *p2;
+    uint8_t i, j;
 
-            tlv_length  = 1;  // number of interfaces (1 bytes)
-            tlv_length += (6+1) * m->power_change_interfaces_nr;
+    p1 = (struct ipv6TypeTLV *)tlv1;
+    p2 = (struct ipv6TypeTLV *)tlv2;
 
-            *len = 1 + 2 + tlv_length;
+    if (
+         p1->ipv6_interfaces_nr != p2->ipv6_interfaces_nr
+       )
+    {
+        return false;
+    }
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    if (p1->ipv6_interfaces_nr > 0 && (NULL == p1->ipv6_interfaces || NULL == p2->ipv6_interfaces))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
 
-            _I1B(&m->tlv.type,                   &p);
-            _I2B(&tlv_length,                    &p);
-            _I1B(&m->power_change_interfaces_nr, &p);
+    for (i=0; i<p1->ipv6_interfaces_nr; i++)
+    {
+        if (
+             memcmp(p1->ipv6_interfaces[i].mac_address,     p2->ipv6_interfaces[i].mac_address, 6) !=0   ||
+                             p1->ipv6_interfaces[i].ipv6_nr      !=  p2->ipv6_interfaces[i].ipv6_nr
+           )
+        {
+            return false;
+        }
 
-            for (i=0; i<m->power_change_interfaces_nr; i++)
+        for (j=0; j<p1->ipv6_interfaces[i].ipv6_nr; j++)
+        {
+            if (
+                                 p1->ipv6_interfaces[i].ipv6[j].type                 !=  p2->ipv6_interfaces[i].ipv6[j].type                       ||
+                 memcmp(p1->ipv6_interfaces[i].ipv6[j].ipv6_address,            p2->ipv6_interfaces[i].ipv6[j].ipv6_address,        16) !=0   ||
+                 memcmp(p1->ipv6_interfaces[i].ipv6[j].ipv6_address_origin,     p2->ipv6_interfaces[i].ipv6[j].ipv6_address_origin, 16) !=0
+               )
             {
-                _InB( m->power_change_interfaces[i].interface_address, &p, 6);
-                _I1B(&m->power_change_interfaces[i].result,            &p);
+                return false;
             }
-
-            return ret;
         }
+    }
 
-        case TLV_TYPE_L2_NEIGHBOR_DEVICE:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.31"
+    return true;
+}
 
-            uint8_t *ret, *p;
-            struct l2NeighborDeviceTLV *m;
+/** @} */
 
-            uint16_t tlv_length;
+/** @brief Support functions for pushButtonGenericPhyEventNotification TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.26
+ *
+ * @{
+ */
 
-            uint8_t i, j, k;
+static struct tlv *tlv_parse_pushButtonGenericPhyEventNotification(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.26"
 
-            m = (struct l2NeighborDeviceTLV *)memory_structure;
+    struct pushButtonGenericPhyEventNotificationTLV  *ret;
 
-            tlv_length = 1;  // number of entries (1 bytes)
-            for (i=0; i<m->local_interfaces_nr; i++)
-            {
-                tlv_length += 6;  // interface MAC address (6 bytes)
-                tlv_length += 2;  // number of neighbors (2 bytes)
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i;
 
-                for (j=0; j<m->local_interfaces[i].l2_neighbors_nr; j++)
-                {
-                    tlv_length += 6;  // neighbor MAC address (6 bytes)
-                    tlv_length += 2;  // number of "behind" MACs (1 bytes)
-                    tlv_length += 6 * m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr;
-                }
-            }
-            *len = 1 + 2 + tlv_length;
+    ret = (struct pushButtonGenericPhyEventNotificationTLV *)memalloc(sizeof(struct pushButtonGenericPhyEventNotificationTLV));
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+    p   = (uint8_t *)buffer;
+    len = length;
 
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _I1B(&m->local_interfaces_nr, &p);
+    ret->tlv.type = TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION;
 
-            for (i=0; i<m->local_interfaces_nr; i++)
-            {
-                _InB( m->local_interfaces[i].local_mac_address, &p, 6);
-                _I2B(&m->local_interfaces[i].l2_neighbors_nr,   &p);
+    if (0 == len)
+    {
+#ifdef FIX_BROKEN_TLVS
+        // Malformed packet. Even if there are NO bridging tuples, the
+        // Malformed packet. Even if there are NO interfaces, the length
+        // should be "1" (which is the length of the next field, that
+        // would containing a "zero", indicating the number of
+        // interfaces).
+        // *However*, because at least one other implementation sets
+        // the 'length' to zero to indicate "no interfaces", we will
+        // also accept this type of "malformed" packet.
+        //
+        ret->local_interfaces_nr = 0;
+        return (struct tlv *)ret;
+#else
+        memfree(ret);
+        return NULL;
+#endif
+    }
 
-                for (j=0; j<m->local_interfaces[i].l2_neighbors_nr; j++)
-                {
-                    _InB( m->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address, &p, 6);
-                    _I2B(&m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr, &p);
+    _E1B(&p, &ret->local_interfaces_nr);
 
-                    for (k=0; k<m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr; k++)
-                    {
-                        _InB( m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k], &p, 6);
-                    }
-                }
-            }
+    if (ret->local_interfaces_nr > 0)
+    {
+        ret->local_interfaces = (struct _genericPhyCommonData *)memalloc(sizeof(struct _genericPhyCommonData) * ret->local_interfaces_nr);
+
+        for (i=0; i < ret->local_interfaces_nr; i++)
+        {
+            _EnB(&p,  ret->local_interfaces[i].oui, 3);
+            _E1B(&p, &ret->local_interfaces[i].variant_index);
+            _E1B(&p, &ret->local_interfaces[i].media_specific_bytes_nr);
 
-            return ret;
+            if (ret->local_interfaces[i].media_specific_bytes_nr > 0)
+            {
+                ret->local_interfaces[i].media_specific_bytes = (uint8_t *)memalloc(ret->local_interfaces[i].media_specific_bytes_nr);
+                _EnB(&p, ret->local_interfaces[i].media_specific_bytes, ret->local_interfaces[i].media_specific_bytes_nr);
+            }
         }
+    }
 
-        default:
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        for (i=0; i < ret->local_interfaces_nr; i++)
         {
-            uint8_t *ret = NULL;
-            size_t length;
-            struct tlv_list *dummy = alloc_dummy_tlv_list(memory_structure);
-            if (!tlv_forge(tlv_1905_defs, dummy, MAX_NETWORK_SEGMENT_SIZE, &ret, &length))
+            if (ret->local_interfaces[i].media_specific_bytes_nr > 0)
             {
-                PLATFORM_PRINTF_DEBUG_ERROR("Failed to forge TLV %s\n",
-                                            convert_1905_TLV_type_to_string(*memory_structure));
-                ret = NULL;
+                memfree(ret->local_interfaces[i].media_specific_bytes);
             }
-            free_dummy_tlv_list(dummy);
-            *len = length;
-            return ret;
         }
-
+        memfree(ret->local_interfaces);
+        memfree(ret);
+        return NULL;
     }
 
-    // This code cannot be reached
-    //
-    return NULL;
+    return (struct tlv *)ret;
 }
 
-
-void free_1905_TLV_structure(uint8_t *memory_structure)
+static uint16_t tlv_length_pushButtonGenericPhyEventNotification(const struct tlv *tlv)
 {
-    if (NULL == memory_structure)
-    {
-        return;
-    }
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.26"
 
-    // The first byte of any of the valid structures is always the "tlv_type"
-    // field.
-    //
-    switch (*memory_structure)
-    {
-        case TLV_TYPE_DEVICE_INFORMATION_TYPE:
-        {
-            struct deviceInformationTypeTLV *m;
+    struct pushButtonGenericPhyEventNotificationTLV *m;
 
-            m = (struct deviceInformationTypeTLV *)memory_structure;
+    uint16_t tlv_length;
 
-            if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
-            {
-                free(m->local_interfaces);
-            }
-            free(m);
+    uint8_t i;
 
-            return;
-        }
+    m = (struct pushButtonGenericPhyEventNotificationTLV *)tlv;
 
-        case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
-        {
-            struct deviceBridgingCapabilityTLV *m;
-            uint8_t i;
+    tlv_length = 1;  // number of local interfaces (1 bytes)
+    for (i=0; i<m->local_interfaces_nr; i++)
+    {
+        tlv_length += 3;  // OUI (2 bytes)
+        tlv_length += 1;  // variant_index (1 byte)
+        tlv_length += 1;  // media specific bytes number (1 bytes)
+        tlv_length += m->local_interfaces[i].media_specific_bytes_nr;
+                          // media specific bytes
+    }
 
-            m = (struct deviceBridgingCapabilityTLV *)memory_structure;
+    return tlv_length;
+}
 
-            for (i=0; i < m->bridging_tuples_nr; i++)
-            {
-                if (m->bridging_tuples[i].bridging_tuple_macs_nr > 0 && NULL != m->bridging_tuples[i].bridging_tuple_macs)
-                {
-                    free(m->bridging_tuples[i].bridging_tuple_macs);
-                }
-            }
-            if (m->bridging_tuples_nr > 0 && NULL != m->bridging_tuples)
-            {
-                free(m->bridging_tuples);
-            }
-            free(m);
+static bool tlv_forge_pushButtonGenericPhyEventNotification(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.26"
 
-            return;
-        }
+    uint8_t *p;
+    struct pushButtonGenericPhyEventNotificationTLV *m;
 
-        case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:
-        {
-            struct non1905NeighborDeviceListTLV *m;
+    uint16_t tlv_length;
 
-            m = (struct non1905NeighborDeviceListTLV *)memory_structure;
+    uint8_t i;
 
-            if (m->non_1905_neighbors_nr > 0 && NULL != m->non_1905_neighbors)
-            {
-                free(m->non_1905_neighbors);
-            }
-            free(m);
+    m = (struct pushButtonGenericPhyEventNotificationTLV *)tlv;
+    tlv_length = tlv_length_pushButtonGenericPhyEventNotification(tlv);
 
-            return;
-        }
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-        case TLV_TYPE_NEIGHBOR_DEVICE_LIST:
+    _I1B(&m->local_interfaces_nr, &p);
+
+    for (i=0; i<m->local_interfaces_nr; i++)
+    {
+        _InB( m->local_interfaces[i].oui,                     &p, 3);
+        _I1B(&m->local_interfaces[i].variant_index,           &p);
+        _I1B(&m->local_interfaces[i].media_specific_bytes_nr, &p);
+        if (m->local_interfaces[i].media_specific_bytes_nr > 0)
         {
-            struct neighborDeviceListTLV *m;
+            _InB( m->local_interfaces[i].media_specific_bytes, &p, m->local_interfaces[i].media_specific_bytes_nr);
+        }
+    }
 
-            m = (struct neighborDeviceListTLV *)memory_structure;
+    *buf     = p;
+    *length -= tlv_length;
 
-            if (m->neighbors_nr > 0 && NULL != m->neighbors)
-            {
-                free(m->neighbors);
-            }
-            free(m);
+    return true;
+}
 
-            return;
-        }
+static void tlv_print_pushButtonGenericPhyEventNotification(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct pushButtonGenericPhyEventNotificationTLV *p;
+    uint8_t i;
 
+    p = (struct pushButtonGenericPhyEventNotificationTLV *)tlv;
 
-        case TLV_TYPE_TRANSMITTER_LINK_METRIC:
-        {
-            struct transmitterLinkMetricTLV *m;
+    print_callback(write_function, prefix, sizeof(p->local_interfaces_nr), "local_interfaces_nr", "%d",  &p->local_interfaces_nr);
+    for (i=0; i < p->local_interfaces_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-            m = (struct transmitterLinkMetricTLV *)memory_structure;
+        snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            if (m->transmitter_link_metrics_nr > 0 && NULL != m->transmitter_link_metrics)
-            {
-                free(m->transmitter_link_metrics);
-            }
-            free(m);
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].oui),                     "oui",                     "0x%02x",   p->local_interfaces[i].oui);
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].variant_index),           "variant_index",           "%d",      &p->local_interfaces[i].variant_index);
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_bytes_nr), "media_specific_bytes_nr", "%d",      &p->local_interfaces[i].media_specific_bytes_nr);
+        print_callback(write_function, new_prefix, p->local_interfaces[i].media_specific_bytes_nr,         "media_specific_bytes",    "0x%02x",   p->local_interfaces[i].media_specific_bytes);
+    }
+}
 
-            return;
-        }
+static void tlv_free_pushButtonGenericPhyEventNotification(struct tlv *tlv)
+{
+    struct pushButtonGenericPhyEventNotificationTLV *m;
 
-        case TLV_TYPE_RECEIVER_LINK_METRIC:
-        {
-            struct receiverLinkMetricTLV *m;
+    m = (struct pushButtonGenericPhyEventNotificationTLV *)tlv;
 
-            m = (struct receiverLinkMetricTLV *)memory_structure;
+    if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
+    {
+        memfree(m->local_interfaces);
+    }
+    memfree(m);
+}
 
-            if (m->receiver_link_metrics_nr > 0 && NULL != m->receiver_link_metrics)
-            {
-                free(m->receiver_link_metrics);
-            }
-            free(m);
+static bool tlv_compare_pushButtonGenericPhyEventNotification(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct pushButtonGenericPhyEventNotificationTLV *p1, *p2;
+    uint8_t i;
 
-            return;
-        }
+    p1 = (struct pushButtonGenericPhyEventNotificationTLV *)tlv1;
+    p2 = (struct pushButtonGenericPhyEventNotificationTLV *)tlv2;
 
-        case TLV_TYPE_WSC:
+    if (
+         p1->local_interfaces_nr != p2->local_interfaces_nr
+       )
+    {
+        return false;
+    }
+
+    if (p1->local_interfaces_nr > 0 && (NULL == p1->local_interfaces || NULL == p2->local_interfaces))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
+
+    for (i=0; i<p1->local_interfaces_nr; i++)
+    {
+        if (
+             memcmp(p1->local_interfaces[i].oui,                         p2->local_interfaces[i].oui,                  3) !=0  ||
+                             p1->local_interfaces[i].variant_index            !=  p2->local_interfaces[i].variant_index                 ||
+                             p1->local_interfaces[i].media_specific_bytes_nr  !=  p2->local_interfaces[i].media_specific_bytes_nr       ||
+             memcmp(p1->local_interfaces[i].media_specific_bytes,        p2->local_interfaces[i].media_specific_bytes, p1->local_interfaces[i].media_specific_bytes_nr) !=0
+           )
         {
-            struct wscTLV *m;
+            return false;
+        }
+    }
 
-            m = (struct wscTLV *)memory_structure;
+    return true;
+}
 
-            if (m->wsc_frame_size >0 && NULL != m->wsc_frame)
-            {
-                free(m->wsc_frame);
-            }
-            free(m);
+/** @} */
 
-            return;
-        }
+/** @brief Support functions for powerOffInterface TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.28
+ *
+ * @{
+ */
 
-        case TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION:
-        {
-            struct pushButtonEventNotificationTLV *m;
+static struct tlv *tlv_parse_powerOffInterface(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.28"
 
-            m = (struct pushButtonEventNotificationTLV *)memory_structure;
+    struct powerOffInterfaceTLV  *ret;
 
-            if (m->media_types_nr > 0 && NULL != m->media_types)
-            {
-                free(m->media_types);
-            }
-            free(m);
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i;
 
-            return;
-        }
+    ret = (struct powerOffInterfaceTLV *)memalloc(sizeof(struct powerOffInterfaceTLV));
 
-        case TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION:
-        {
-            struct genericPhyDeviceInformationTypeTLV *m;
-            uint8_t i;
+    p   = (uint8_t *)buffer;
+    len = length;
 
-            m = (struct genericPhyDeviceInformationTypeTLV *)memory_structure;
+    ret->tlv.type = TLV_TYPE_POWER_OFF_INTERFACE;
 
-            for (i=0; i < m->local_interfaces_nr; i++)
-            {
-                if (m->local_interfaces[i].generic_phy_description_xml_url_len > 0 && NULL != m->local_interfaces[i].generic_phy_description_xml_url)
-                {
-                    free(m->local_interfaces[i].generic_phy_description_xml_url);
-                }
+    if (0 == len)
+    {
+#ifdef FIX_BROKEN_TLVS
+        // Malformed packet. Even if there are NO interfaces, the length
+        // should be "1" (which is the length of the next field, that
+        // would contain a "zero", indicating the number of interfaces)
+        // *However*, because at least one other implementation sets
+        // the 'length' to zero to indicate "no interfaces", we will
+        // also accept this type of "malformed" packet.
+        //
+        ret->power_off_interfaces_nr = 0;
+        return (struct tlv *)ret;
+#else
+        memfree(ret);
+        return NULL;
+#endif
+    }
 
-                if (m->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0 && NULL != m->local_interfaces[i].generic_phy_common_data.media_specific_bytes)
-                {
-                    free(m->local_interfaces[i].generic_phy_common_data.media_specific_bytes);
-                }
-            }
-            if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
-            {
-                free(m->local_interfaces);
-            }
-            free(m);
+    _E1B(&p, &ret->power_off_interfaces_nr);
 
-            return;
-        }
+    if (ret->power_off_interfaces_nr > 0)
+    {
+        ret->power_off_interfaces = (struct _powerOffInterfaceEntries *)memalloc(sizeof(struct _powerOffInterfaceEntries) * ret->power_off_interfaces_nr);
 
-        case TLV_TYPE_CONTROL_URL:
+        for (i=0; i < ret->power_off_interfaces_nr; i++)
         {
-            struct controlUrlTypeTLV *m;
-
-            m = (struct controlUrlTypeTLV *)memory_structure;
+            _EnB(&p,  ret->power_off_interfaces[i].interface_address, 6);
+            _E2B(&p, &ret->power_off_interfaces[i].media_type);
+            _EnB(&p,  ret->power_off_interfaces[i].generic_phy_common_data.oui, 3);
+            _E1B(&p, &ret->power_off_interfaces[i].generic_phy_common_data.variant_index);
+            _E1B(&p, &ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
 
-            if (NULL != m->url)
+            if (ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
             {
-                free(m->url);
+                ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes = (uint8_t *)memalloc(ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
+                _EnB(&p, ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes, ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
             }
-            free(m);
-
-            return;
         }
+    }
 
-        case TLV_TYPE_IPV4:
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        for (i=0; i < ret->power_off_interfaces_nr; i++)
         {
-            struct ipv4TypeTLV *m;
-            uint8_t i;
-
-            m = (struct ipv4TypeTLV *)memory_structure;
-
-            for (i=0; i < m->ipv4_interfaces_nr; i++)
-            {
-                if (m->ipv4_interfaces[i].ipv4_nr > 0 && NULL != m->ipv4_interfaces[i].ipv4)
-                {
-                    free(m->ipv4_interfaces[i].ipv4);
-                }
-            }
-            if (m->ipv4_interfaces_nr > 0 && NULL != m->ipv4_interfaces)
+            if (ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
             {
-                free(m->ipv4_interfaces);
+                memfree(ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes);
             }
-            free(m);
-
-            return;
         }
+        memfree(ret->power_off_interfaces);
+        memfree(ret);
+        return NULL;
+    }
 
-        case TLV_TYPE_IPV6:
-        {
-            struct ipv6TypeTLV *m;
-            uint8_t i;
+    return (struct tlv *)ret;
+}
 
-            m = (struct ipv6TypeTLV *)memory_structure;
+static uint16_t tlv_length_powerOffInterface(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.28"
 
-            for (i=0; i < m->ipv6_interfaces_nr; i++)
-            {
-                if (m->ipv6_interfaces[i].ipv6_nr > 0 && NULL != m->ipv6_interfaces[i].ipv6)
-                {
-                    free(m->ipv6_interfaces[i].ipv6);
-                }
-            }
-            if (m->ipv6_interfaces_nr > 0 && NULL != m->ipv6_interfaces)
-            {
-                free(m->ipv6_interfaces);
-            }
-            free(m);
+    struct powerOffInterfaceTLV *m;
 
-            return;
-        }
+    uint16_t tlv_length;
 
-        case TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION:
-        {
-            struct pushButtonGenericPhyEventNotificationTLV *m;
+    uint8_t i;
 
-            m = (struct pushButtonGenericPhyEventNotificationTLV *)memory_structure;
+    m = (struct powerOffInterfaceTLV *)tlv;
 
-            if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
-            {
-                free(m->local_interfaces);
-            }
-            free(m);
+    tlv_length = 1;  // number of power off interfaces (1 bytes)
+    for (i=0; i<m->power_off_interfaces_nr; i++)
+    {
+        tlv_length += 6;  // interface MAC address (6 bytes)
+        tlv_length += 2;  // media type (2 bytes)
+        tlv_length += 3;  // OUI (2 bytes)
+        tlv_length += 1;  // variant_index (1 byte)
+        tlv_length += 1;  // media specific bytes number (1 bytes)
+        tlv_length += m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr;
+                          // media specific bytes
+    }
 
-            return;
-        }
+    return tlv_length;
+}
 
-        case TLV_TYPE_POWER_OFF_INTERFACE:
-        {
-            struct powerOffInterfaceTLV *m;
-            uint8_t i;
+static bool tlv_forge_powerOffInterface(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.28"
 
-            m = (struct powerOffInterfaceTLV *)memory_structure;
+    uint8_t *p;
+    struct powerOffInterfaceTLV *m;
 
-            for (i=0; i < m->power_off_interfaces_nr; i++)
-            {
-                if (m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0 && NULL != m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes)
-                {
-                    free(m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes);
-                }
-            }
-            if (m->power_off_interfaces_nr > 0 && NULL != m->power_off_interfaces)
-            {
-                free(m->power_off_interfaces);
-            }
-            free(m);
+    uint16_t tlv_length;
 
-            return;
-        }
+    uint8_t i;
 
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION:
-        {
-            struct interfacePowerChangeInformationTLV *m;
+    m = (struct powerOffInterfaceTLV *)tlv;
+    tlv_length = tlv_length_powerOffInterface(tlv);
 
-            m = (struct interfacePowerChangeInformationTLV *)memory_structure;
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            if (m->power_change_interfaces_nr > 0 && NULL != m->power_change_interfaces)
-            {
-                free(m->power_change_interfaces);
-            }
-            free(m);
+    _I1B(&m->power_off_interfaces_nr, &p);
 
-            return;
+    for (i=0; i<m->power_off_interfaces_nr; i++)
+    {
+        _InB( m->power_off_interfaces[i].interface_address,                               &p, 6);
+        _I2B(&m->power_off_interfaces[i].media_type,                                      &p);
+        _InB( m->power_off_interfaces[i].generic_phy_common_data.oui,                     &p, 3);
+        _I1B(&m->power_off_interfaces[i].generic_phy_common_data.variant_index,           &p);
+        _I1B(&m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr, &p);
+        if (m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
+        {
+            _InB( m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes, &p, m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
         }
+    }
 
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS:
-        {
-            struct interfacePowerChangeStatusTLV *m;
+    *buf     = p;
+    *length -= tlv_length;
 
-            m = (struct interfacePowerChangeStatusTLV *)memory_structure;
+    return true;
+}
 
-            if (m->power_change_interfaces_nr > 0 && NULL != m->power_change_interfaces)
-            {
-                free(m->power_change_interfaces);
-            }
-            free(m);
+static void tlv_print_powerOffInterface(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct powerOffInterfaceTLV *p;
+    uint8_t i;
 
-            return;
-        }
+    p = (struct powerOffInterfaceTLV *)tlv;
 
-        case TLV_TYPE_L2_NEIGHBOR_DEVICE:
-        {
-            struct l2NeighborDeviceTLV *m;
-            uint8_t i, j;
+    print_callback(write_function, prefix, sizeof(p->power_off_interfaces_nr), "power_off_interfaces_nr", "%d",  &p->power_off_interfaces_nr);
+    for (i=0; i < p->power_off_interfaces_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-            m = (struct l2NeighborDeviceTLV *)memory_structure;
+        snprintf(new_prefix, MAX_PREFIX-1, "%spower_off_interfaces[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            for (i=0; i < m->local_interfaces_nr; i++)
-            {
-                if (m->local_interfaces[i].l2_neighbors_nr > 0 && NULL != m->local_interfaces[i].l2_neighbors)
-                {
-                    for (j=0; j < m->local_interfaces[i].l2_neighbors_nr; j++)
-                    {
-                        if (m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr > 0 && NULL != m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses)
-                        {
-                            free(m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses);
-                        }
-                    }
-                    free(m->local_interfaces[i].l2_neighbors);
-                }
-            }
-            if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
-            {
-                free(m->local_interfaces);
-            }
-            free(m);
+        print_callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].interface_address),                               "interface_address",       "0x%02x",   p->power_off_interfaces[i].interface_address);
+        print_callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].media_type),                                      "media_type",              "0x%04x",  &p->power_off_interfaces[i].media_type);
+        print_callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].generic_phy_common_data.oui),                     "oui",                     "0x%02x",   p->power_off_interfaces[i].generic_phy_common_data.oui);
+        print_callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].generic_phy_common_data.variant_index),           "variant_index",           "%d",      &p->power_off_interfaces[i].generic_phy_common_data.variant_index);
+        print_callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr), "media_specific_bytes_nr", "%d",      &p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
+        print_callback(write_function, new_prefix, p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr,         "media_specific_bytes",    "0x%02x",   p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes);
+    }
+}
 
-            return;
-        }
+static void tlv_free_powerOffInterface(struct tlv *tlv)
+{
+    struct powerOffInterfaceTLV *m;
+    uint8_t i;
 
+    m = (struct powerOffInterfaceTLV *)tlv;
 
-        default:
+    for (i=0; i < m->power_off_interfaces_nr; i++)
+    {
+        if (m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0 && NULL != m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes)
         {
-            tlv_free(tlv_1905_defs, alloc_dummy_tlv_list(memory_structure));
-            return;
+            memfree(m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes);
         }
     }
-
-    // This code cannot be reached
-    //
-    return;
+    if (m->power_off_interfaces_nr > 0 && NULL != m->power_off_interfaces)
+    {
+        memfree(m->power_off_interfaces);
+    }
+    memfree(m);
 }
 
-
-uint8_t compare_1905_TLV_structures(uint8_t *memory_structure_1, uint8_t *memory_structure_2)
+static bool tlv_compare_powerOffInterface(const struct tlv *tlv1, const struct tlv *tlv2)
 {
-    if (NULL == memory_structure_1 || NULL == memory_structure_2)
+    struct powerOffInterfaceTLV *p1, *p2;
+    uint8_t i;
+
+    p1 = (struct powerOffInterfaceTLV *)tlv1;
+    p2 = (struct powerOffInterfaceTLV *)tlv2;
+
+    if (
+         p1->power_off_interfaces_nr != p2->power_off_interfaces_nr
+       )
     {
-        return 1;
+        return false;
     }
 
-    // The first byte of any of the valid structures is always the "tlv_type"
-    // field.
-    //
-    if (*memory_structure_1 != *memory_structure_2)
+    if (p1->power_off_interfaces_nr > 0 && (NULL == p1->power_off_interfaces || NULL == p2->power_off_interfaces))
     {
-        return 1;
+        // Malformed structure
+        //
+        return false;
     }
-    switch (*memory_structure_1)
-    {
-        case TLV_TYPE_DEVICE_INFORMATION_TYPE:
-        {
-            struct deviceInformationTypeTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct deviceInformationTypeTLV *)memory_structure_1;
-            p2 = (struct deviceInformationTypeTLV *)memory_structure_2;
-
-            if (
-                 memcmp(p1->al_mac_address,         p2->al_mac_address, 6) !=0  ||
-                                 p1->local_interfaces_nr !=  p2->local_interfaces_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->local_interfaces_nr > 0 && (NULL == p1->local_interfaces || NULL == p2->local_interfaces))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->local_interfaces_nr; i++)
-            {
-                if (
-                     memcmp(p1->local_interfaces[i].mac_address,                 p2->local_interfaces[i].mac_address, 6) !=0      ||
-                                     p1->local_interfaces[i].media_type               !=  p2->local_interfaces[i].media_type               ||
-                                     p1->local_interfaces[i].media_specific_data_size !=  p2->local_interfaces[i].media_specific_data_size
-                   )
-                {
-                    return 1;
-                }
-
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == p1->local_interfaces[i].media_type)
-                   )
-                {
-                    if (
-                         memcmp(p1->local_interfaces[i].media_specific_data.ieee80211.network_membership,                     p2->local_interfaces[i].media_specific_data.ieee80211.network_membership,  6) !=0          ||
-                                         p1->local_interfaces[i].media_specific_data.ieee80211.role                                !=  p2->local_interfaces[i].media_specific_data.ieee80211.role                                 ||
-                                         p1->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band                     !=  p2->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band                      ||
-                                         p1->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1 !=  p2->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1
-                       )
-                    {
-                        return 1;
-                    }
-
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == p1->local_interfaces[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == p1->local_interfaces[i].media_type)
-                        )
-                {
-                    if (
-                         memcmp(p1->local_interfaces[i].media_specific_data.ieee1901.network_identifier,  p2->local_interfaces[i].media_specific_data.ieee1901.network_identifier,  6) !=0
-                       )
-                    {
-                        return 1;
-                    }
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
-        {
-            struct deviceBridgingCapabilityTLV *p1, *p2;
-            uint8_t i, j;
-
-            p1 = (struct deviceBridgingCapabilityTLV *)memory_structure_1;
-            p2 = (struct deviceBridgingCapabilityTLV *)memory_structure_2;
-
-            if (
-                 p1->bridging_tuples_nr != p2->bridging_tuples_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->bridging_tuples_nr > 0 && (NULL == p1->bridging_tuples || NULL == p2->bridging_tuples))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->bridging_tuples_nr; i++)
-            {
-                if (
-                     p1->bridging_tuples[i].bridging_tuple_macs_nr  !=  p2->bridging_tuples[i].bridging_tuple_macs_nr
-                   )
-                {
-                    return 1;
-                }
-
-                for (j=0; j<p1->bridging_tuples[i].bridging_tuple_macs_nr; j++)
-                {
-                    if (
-                         memcmp(p1->bridging_tuples[i].bridging_tuple_macs[j].mac_address,  p2->bridging_tuples[i].bridging_tuple_macs[j].mac_address, 6) !=0
-                       )
-                    {
-                        return 1;
-                    }
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:
-        {
-            struct non1905NeighborDeviceListTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct non1905NeighborDeviceListTLV *)memory_structure_1;
-            p2 = (struct non1905NeighborDeviceListTLV *)memory_structure_2;
-
-            if (
-                 memcmp(p1->local_mac_address,        p2->local_mac_address, 6) !=0  ||
-                                 p1->non_1905_neighbors_nr !=  p2->non_1905_neighbors_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->non_1905_neighbors_nr > 0 && (NULL == p1->non_1905_neighbors || NULL == p2->non_1905_neighbors))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->non_1905_neighbors_nr; i++)
-            {
-                if (
-                     memcmp(p1->non_1905_neighbors[i].mac_address,     p2->non_1905_neighbors[i].mac_address, 6) !=0
-                   )
-                {
-                    return 1;
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_NEIGHBOR_DEVICE_LIST:
-        {
-            struct neighborDeviceListTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct neighborDeviceListTLV *)memory_structure_1;
-            p2 = (struct neighborDeviceListTLV *)memory_structure_2;
-
-            if (
-                 memcmp(p1->local_mac_address,     p2->local_mac_address, 6) !=0  ||
-                                 p1->neighbors_nr       !=  p2->neighbors_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->neighbors_nr > 0 && (NULL == p1->neighbors || NULL == p2->neighbors))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->neighbors_nr; i++)
-            {
-                if (
-                     memcmp(p1->neighbors[i].mac_address,     p2->neighbors[i].mac_address, 6) !=0  ||
-                                     p1->neighbors[i].bridge_flag  !=  p2->neighbors[i].bridge_flag
-                   )
-                {
-                    return 1;
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_TRANSMITTER_LINK_METRIC:
-        {
-            struct transmitterLinkMetricTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct transmitterLinkMetricTLV *)memory_structure_1;
-            p2 = (struct transmitterLinkMetricTLV *)memory_structure_2;
-
-            if (
-                 memcmp(p1->local_al_address,              p2->local_al_address,    6) !=0  ||
-                 memcmp(p1->neighbor_al_address,           p2->neighbor_al_address, 6) !=0  ||
-                                 p1->transmitter_link_metrics_nr != p2->transmitter_link_metrics_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->transmitter_link_metrics_nr > 0 && (NULL == p1->transmitter_link_metrics || NULL == p2->transmitter_link_metrics))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->transmitter_link_metrics_nr; i++)
-            {
-                if (
-                     memcmp(p1->transmitter_link_metrics[i].local_interface_address,       p2->transmitter_link_metrics[i].local_interface_address,    6) !=0  ||
-                     memcmp(p1->transmitter_link_metrics[i].neighbor_interface_address,    p2->transmitter_link_metrics[i].neighbor_interface_address, 6) !=0  ||
-                                     p1->transmitter_link_metrics[i].intf_type                  !=  p2->transmitter_link_metrics[i].intf_type                           ||
-                                     p1->transmitter_link_metrics[i].bridge_flag                !=  p2->transmitter_link_metrics[i].bridge_flag                         ||
-                                     p1->transmitter_link_metrics[i].packet_errors              !=  p2->transmitter_link_metrics[i].packet_errors                       ||
-                                     p1->transmitter_link_metrics[i].transmitted_packets        !=  p2->transmitter_link_metrics[i].transmitted_packets                 ||
-                                     p1->transmitter_link_metrics[i].mac_throughput_capacity    !=  p2->transmitter_link_metrics[i].mac_throughput_capacity             ||
-                                     p1->transmitter_link_metrics[i].link_availability          !=  p2->transmitter_link_metrics[i].link_availability                   ||
-                                     p1->transmitter_link_metrics[i].phy_rate                   !=  p2->transmitter_link_metrics[i].phy_rate
-                   )
-                {
-                    return 1;
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_RECEIVER_LINK_METRIC:
-        {
-            struct receiverLinkMetricTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct receiverLinkMetricTLV *)memory_structure_1;
-            p2 = (struct receiverLinkMetricTLV *)memory_structure_2;
-
-            if (
-                 memcmp(p1->local_al_address,           p2->local_al_address,    6) !=0  ||
-                 memcmp(p1->neighbor_al_address,        p2->neighbor_al_address, 6) !=0  ||
-                                 p1->receiver_link_metrics_nr != p2->receiver_link_metrics_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->receiver_link_metrics_nr > 0 && (NULL == p1->receiver_link_metrics || NULL == p2->receiver_link_metrics))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->receiver_link_metrics_nr; i++)
-            {
-                if (
-                     memcmp(p1->receiver_link_metrics[i].local_interface_address,       p2->receiver_link_metrics[i].local_interface_address,    6) !=0  ||
-                     memcmp(p1->receiver_link_metrics[i].neighbor_interface_address,    p2->receiver_link_metrics[i].neighbor_interface_address, 6) !=0  ||
-                                     p1->receiver_link_metrics[i].intf_type                  !=  p2->receiver_link_metrics[i].intf_type                           ||
-                                     p1->receiver_link_metrics[i].packet_errors              !=  p2->receiver_link_metrics[i].packet_errors                       ||
-                                     p1->receiver_link_metrics[i].packets_received           !=  p2->receiver_link_metrics[i].packets_received                    ||
-                                     p1->receiver_link_metrics[i].rssi                       !=  p2->receiver_link_metrics[i].rssi
-                   )
-                {
-                    return 1;
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_LINK_METRIC_RESULT_CODE:
-        {
-            struct linkMetricResultCodeTLV *p1, *p2;
-
-            p1 = (struct linkMetricResultCodeTLV *)memory_structure_1;
-            p2 = (struct linkMetricResultCodeTLV *)memory_structure_2;
-
-            if (
-                 p1->result_code != p2->result_code
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_SEARCHED_ROLE:
-        {
-            struct searchedRoleTLV *p1, *p2;
-
-            p1 = (struct searchedRoleTLV *)memory_structure_1;
-            p2 = (struct searchedRoleTLV *)memory_structure_2;
-
-            if (
-                 p1->role != p2->role
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_AUTOCONFIG_FREQ_BAND:
-        {
-            struct autoconfigFreqBandTLV *p1, *p2;
-
-            p1 = (struct autoconfigFreqBandTLV *)memory_structure_1;
-            p2 = (struct autoconfigFreqBandTLV *)memory_structure_2;
-
-            if (
-                 p1->freq_band != p2->freq_band
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_SUPPORTED_ROLE:
-        {
-            struct supportedRoleTLV *p1, *p2;
-
-            p1 = (struct supportedRoleTLV *)memory_structure_1;
-            p2 = (struct supportedRoleTLV *)memory_structure_2;
-
-            if (
-                 p1->role != p2->role
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_SUPPORTED_FREQ_BAND:
-        {
-            struct supportedFreqBandTLV *p1, *p2;
-
-            p1 = (struct supportedFreqBandTLV *)memory_structure_1;
-            p2 = (struct supportedFreqBandTLV *)memory_structure_2;
-
-            if (
-                 p1->freq_band != p2->freq_band
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_WSC:
-        {
-            struct wscTLV *p1, *p2;
-
-            p1 = (struct wscTLV *)memory_structure_1;
-            p2 = (struct wscTLV *)memory_structure_2;
-
-            if(
-                                p1->wsc_frame_size  !=  p2->wsc_frame_size                     ||
-                memcmp(p1->wsc_frame,          p2->wsc_frame,       p1->wsc_frame_size) !=0
-              )
-            {
-                return 1;
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION:
-        {
-            struct pushButtonEventNotificationTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct pushButtonEventNotificationTLV *)memory_structure_1;
-            p2 = (struct pushButtonEventNotificationTLV *)memory_structure_2;
-
-            if (p1->media_types_nr !=  p2->media_types_nr)
-            {
-                return 1;
-            }
-
-            if (p1->media_types_nr > 0 && (NULL == p1->media_types || NULL == p2->media_types))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->media_types_nr; i++)
-            {
-                if (
-                     p1->media_types[i].media_type               !=  p2->media_types[i].media_type               ||
-                     p1->media_types[i].media_specific_data_size !=  p2->media_types[i].media_specific_data_size
-                   )
-                {
-                    return 1;
-                }
-
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == p1->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == p1->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == p1->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == p1->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == p1->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == p1->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == p1->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == p1->media_types[i].media_type)
-                   )
-                {
-                    if (
-                         memcmp(p1->media_types[i].media_specific_data.ieee80211.network_membership,                     p2->media_types[i].media_specific_data.ieee80211.network_membership,  6) !=0          ||
-                                         p1->media_types[i].media_specific_data.ieee80211.role                                !=  p2->media_types[i].media_specific_data.ieee80211.role                                 ||
-                                         p1->media_types[i].media_specific_data.ieee80211.ap_channel_band                     !=  p2->media_types[i].media_specific_data.ieee80211.ap_channel_band                      ||
-                                         p1->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1 !=  p2->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1
-                       )
-                    {
-                        return 1;
-                    }
-
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == p1->media_types[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == p1->media_types[i].media_type)
-                        )
-                {
-                    if (
-                         memcmp(p1->media_types[i].media_specific_data.ieee1901.network_identifier,  p2->media_types[i].media_specific_data.ieee1901.network_identifier,  6) !=0
-                       )
-                    {
-                        return 1;
-                    }
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION:
-        {
-            struct pushButtonJoinNotificationTLV *p1, *p2;
-
-            p1 = (struct pushButtonJoinNotificationTLV *)memory_structure_1;
-            p2 = (struct pushButtonJoinNotificationTLV *)memory_structure_2;
-
-            if (
-                 memcmp(p1->al_mac_address,       p2->al_mac_address, 6) !=0  ||
-                                 p1->message_identifier != p2->message_identifier      ||
-                 memcmp(p1->mac_address,          p2->al_mac_address, 6) !=0  ||
-                 memcmp(p1->new_mac_address,      p2->al_mac_address, 6) !=0
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_DEVICE_IDENTIFICATION:
-        {
-            struct deviceIdentificationTypeTLV *p1, *p2;
-
-            p1 = (struct deviceIdentificationTypeTLV *)memory_structure_1;
-            p2 = (struct deviceIdentificationTypeTLV *)memory_structure_2;
-
-            if (
-                 memcmp(p1->friendly_name,       p2->friendly_name,      64) !=0  ||
-                 memcmp(p1->manufacturer_name,   p2->manufacturer_name,  64) !=0  ||
-                 memcmp(p1->manufacturer_model,  p2->manufacturer_model, 64) !=0
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_CONTROL_URL:
-        {
-            struct controlUrlTypeTLV *p1, *p2;
-
-            p1 = (struct controlUrlTypeTLV *)memory_structure_1;
-            p2 = (struct controlUrlTypeTLV *)memory_structure_2;
-
-            if(
-                memcmp(p1->url, p2->url, strlen(p1->url)+1) !=0
-              )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_IPV4:
-        {
-            struct ipv4TypeTLV *p1, *p2;
-            uint8_t i, j;
-
-            p1 = (struct ipv4TypeTLV *)memory_structure_1;
-            p2 = (struct ipv4TypeTLV *)memory_structure_2;
-
-            if (
-                 p1->ipv4_interfaces_nr != p2->ipv4_interfaces_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->ipv4_interfaces_nr > 0 && (NULL == p1->ipv4_interfaces || NULL == p2->ipv4_interfaces))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->ipv4_interfaces_nr; i++)
-            {
-                if (
-                     memcmp(p1->ipv4_interfaces[i].mac_address,     p2->ipv4_interfaces[i].mac_address, 6) !=0   ||
-                                     p1->ipv4_interfaces[i].ipv4_nr      !=  p2->ipv4_interfaces[i].ipv4_nr
-                   )
-                {
-                    return 1;
-                }
-
-                for (j=0; j<p1->ipv4_interfaces[i].ipv4_nr; j++)
-                {
-                    if (
-                                         p1->ipv4_interfaces[i].ipv4[j].type              !=  p2->ipv4_interfaces[i].ipv4[j].type                       ||
-                         memcmp(p1->ipv4_interfaces[i].ipv4[j].ipv4_address,         p2->ipv4_interfaces[i].ipv4[j].ipv4_address,     4) !=0   ||
-                         memcmp(p1->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server,     p2->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server, 4) !=0
-                       )
-                    {
-                        return 1;
-                    }
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_IPV6:
-        {
-            struct ipv6TypeTLV *p1, *p2;
-            uint8_t i, j;
-
-            p1 = (struct ipv6TypeTLV *)memory_structure_1;
-            p2 = (struct ipv6TypeTLV *)memory_structure_2;
-
-            if (
-                 p1->ipv6_interfaces_nr != p2->ipv6_interfaces_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->ipv6_interfaces_nr > 0 && (NULL == p1->ipv6_interfaces || NULL == p2->ipv6_interfaces))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
 
-            for (i=0; i<p1->ipv6_interfaces_nr; i++)
-            {
-                if (
-                     memcmp(p1->ipv6_interfaces[i].mac_address,     p2->ipv6_interfaces[i].mac_address, 6) !=0   ||
-                                     p1->ipv6_interfaces[i].ipv6_nr      !=  p2->ipv6_interfaces[i].ipv6_nr
-                   )
-                {
-                    return 1;
-                }
-
-                for (j=0; j<p1->ipv6_interfaces[i].ipv6_nr; j++)
-                {
-                    if (
-                                         p1->ipv6_interfaces[i].ipv6[j].type                 !=  p2->ipv6_interfaces[i].ipv6[j].type                       ||
-                         memcmp(p1->ipv6_interfaces[i].ipv6[j].ipv6_address,            p2->ipv6_interfaces[i].ipv6[j].ipv6_address,        16) !=0   ||
-                         memcmp(p1->ipv6_interfaces[i].ipv6[j].ipv6_address_origin,     p2->ipv6_interfaces[i].ipv6[j].ipv6_address_origin, 16) !=0
-                       )
-                    {
-                        return 1;
-                    }
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION:
+    for (i=0; i<p1->power_off_interfaces_nr; i++)
+    {
+        if (
+             memcmp(p1->power_off_interfaces[i].interface_address,                                   p2->power_off_interfaces[i].interface_address,                            6) !=0  ||
+                             p1->power_off_interfaces[i].media_type                                       !=  p2->power_off_interfaces[i].media_type                                            ||
+             memcmp(p1->power_off_interfaces[i].generic_phy_common_data.oui,                         p2->power_off_interfaces[i].generic_phy_common_data.oui,                  3) !=0  ||
+                             p1->power_off_interfaces[i].generic_phy_common_data.variant_index            !=  p2->power_off_interfaces[i].generic_phy_common_data.variant_index                 ||
+                             p1->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr  !=  p2->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr       ||
+             memcmp(p1->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes,        p2->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes, p1->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr) !=0
+           )
         {
-            struct genericPhyDeviceInformationTypeTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct genericPhyDeviceInformationTypeTLV *)memory_structure_1;
-            p2 = (struct genericPhyDeviceInformationTypeTLV *)memory_structure_2;
-
-            if (
-                 memcmp(p1->al_mac_address,        p2->al_mac_address,     6) !=0  ||
-                                 p1->local_interfaces_nr != p2->local_interfaces_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->local_interfaces_nr > 0 && (NULL == p1->local_interfaces || NULL == p2->local_interfaces))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->local_interfaces_nr; i++)
-            {
-                if (
-                     memcmp(p1->local_interfaces[i].local_interface_address,                             p2->local_interfaces[i].local_interface_address,                      6) !=0  ||
-                     memcmp(p1->local_interfaces[i].generic_phy_common_data.oui,                         p2->local_interfaces[i].generic_phy_common_data.oui,                  3) !=0  ||
-                                     p1->local_interfaces[i].generic_phy_common_data.variant_index            !=  p2->local_interfaces[i].generic_phy_common_data.variant_index                 ||
-                     memcmp(p1->local_interfaces[i].variant_name,                                        p2->local_interfaces[i].variant_name,                                32) !=0  ||
-                                     p1->local_interfaces[i].generic_phy_description_xml_url_len              !=  p2->local_interfaces[i].generic_phy_description_xml_url_len                   ||
-                                     p1->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr  !=  p2->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr       ||
-                     memcmp(p1->local_interfaces[i].generic_phy_description_xml_url,                     p2->local_interfaces[i].generic_phy_description_xml_url,              p1->local_interfaces[i].generic_phy_description_xml_url_len) !=0  ||
-                     memcmp(p1->local_interfaces[i].generic_phy_common_data.media_specific_bytes,        p2->local_interfaces[i].generic_phy_common_data.media_specific_bytes, p1->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr) !=0
-                   )
-                {
-                    return 1;
-                }
-            }
-
-            return 0;
+            return false;
         }
+    }
 
-        case TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION:
-        {
-            struct pushButtonGenericPhyEventNotificationTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct pushButtonGenericPhyEventNotificationTLV *)memory_structure_1;
-            p2 = (struct pushButtonGenericPhyEventNotificationTLV *)memory_structure_2;
-
-            if (
-                 p1->local_interfaces_nr != p2->local_interfaces_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->local_interfaces_nr > 0 && (NULL == p1->local_interfaces || NULL == p2->local_interfaces))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->local_interfaces_nr; i++)
-            {
-                if (
-                     memcmp(p1->local_interfaces[i].oui,                         p2->local_interfaces[i].oui,                  3) !=0  ||
-                                     p1->local_interfaces[i].variant_index            !=  p2->local_interfaces[i].variant_index                 ||
-                                     p1->local_interfaces[i].media_specific_bytes_nr  !=  p2->local_interfaces[i].media_specific_bytes_nr       ||
-                     memcmp(p1->local_interfaces[i].media_specific_bytes,        p2->local_interfaces[i].media_specific_bytes, p1->local_interfaces[i].media_specific_bytes_nr) !=0
-                   )
-                {
-                    return 1;
-                }
-            }
+    return true;
+}
 
-            return 0;
-        }
+/** @} */
 
-        case TLV_TYPE_1905_PROFILE_VERSION:
-        {
-            struct x1905ProfileVersionTLV *p1, *p2;
+/** @brief Support functions for interfacePowerChangeInformation TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.29
+ *
+ * @{
+ */
 
-            p1 = (struct x1905ProfileVersionTLV *)memory_structure_1;
-            p2 = (struct x1905ProfileVersionTLV *)memory_structure_2;
+static struct tlv *tlv_parse_interfacePowerChangeInformation(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.29"
 
-            if (
-                 p1->profile != p2->profile
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
+    struct interfacePowerChangeInformationTLV  *ret;
 
-        case TLV_TYPE_POWER_OFF_INTERFACE:
-        {
-            struct powerOffInterfaceTLV *p1, *p2;
-            uint8_t i;
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i;
 
-            p1 = (struct powerOffInterfaceTLV *)memory_structure_1;
-            p2 = (struct powerOffInterfaceTLV *)memory_structure_2;
+    ret = (struct interfacePowerChangeInformationTLV *)memalloc(sizeof(struct interfacePowerChangeInformationTLV));
 
-            if (
-                 p1->power_off_interfaces_nr != p2->power_off_interfaces_nr
-               )
-            {
-                return 1;
-            }
+    p   = (uint8_t *)buffer;
+    len = length;
 
-            if (p1->power_off_interfaces_nr > 0 && (NULL == p1->power_off_interfaces || NULL == p2->power_off_interfaces))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
+    ret->tlv.type = TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION;
 
-            for (i=0; i<p1->power_off_interfaces_nr; i++)
-            {
-                if (
-                     memcmp(p1->power_off_interfaces[i].interface_address,                                   p2->power_off_interfaces[i].interface_address,                            6) !=0  ||
-                                     p1->power_off_interfaces[i].media_type                                       !=  p2->power_off_interfaces[i].media_type                                            ||
-                     memcmp(p1->power_off_interfaces[i].generic_phy_common_data.oui,                         p2->power_off_interfaces[i].generic_phy_common_data.oui,                  3) !=0  ||
-                                     p1->power_off_interfaces[i].generic_phy_common_data.variant_index            !=  p2->power_off_interfaces[i].generic_phy_common_data.variant_index                 ||
-                                     p1->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr  !=  p2->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr       ||
-                     memcmp(p1->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes,        p2->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes, p1->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr) !=0
-                   )
-                {
-                    return 1;
-                }
-            }
+    if (0 == len)
+    {
+#ifdef FIX_BROKEN_TLVS
+        // Malformed packet. Even if there are NO bridging tuples, the
+        // Malformed packet. Even if there are NO interfaces, the length
+        // should be "1" (which is the length of the next field, that
+        // would containing a "zero", indicating the number of
+        // interfaces).
+        // *However*, because at least one other implementation sets
+        // the 'length' to zero to indicate "no interfaces", we will
+        // also accept this type of "malformed" packet.
+        //
+        ret->power_change_interfaces_nr = 0;
+        return (struct tlv *)ret;
+#else
+        memfree(ret);
+        return NULL;
+#endif
+    }
 
-            return 0;
-        }
+    _E1B(&p, &ret->power_change_interfaces_nr);
 
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION:
+    if (ret->power_change_interfaces_nr > 0)
+    {
+        ret->power_change_interfaces = (struct _powerChangeInformationEntries *)memalloc(sizeof(struct _powerChangeInformationEntries) * ret->power_change_interfaces_nr);
+
+        for (i=0; i < ret->power_change_interfaces_nr; i++)
         {
-            struct interfacePowerChangeInformationTLV *p1, *p2;
-            uint8_t i;
+            _EnB(&p,  ret->power_change_interfaces[i].interface_address, 6);
+            _E1B(&p, &ret->power_change_interfaces[i].requested_power_state);
+        }
+    }
 
-            p1 = (struct interfacePowerChangeInformationTLV *)memory_structure_1;
-            p2 = (struct interfacePowerChangeInformationTLV *)memory_structure_2;
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        memfree(ret->power_change_interfaces);
+        memfree(ret);
+        return NULL;
+    }
 
-            if (
-                 p1->power_change_interfaces_nr != p2->power_change_interfaces_nr
-               )
-            {
-                return 1;
-            }
+    return (struct tlv *)ret;
+}
 
-            if (p1->power_change_interfaces_nr > 0 && (NULL == p1->power_change_interfaces || NULL == p2->power_change_interfaces))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
+static uint16_t tlv_length_interfacePowerChangeInformation(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.29"
 
-            for (i=0; i<p1->power_change_interfaces_nr; i++)
-            {
-                if (
-                     memcmp(p1->power_change_interfaces[i].interface_address,        p2->power_change_interfaces[i].interface_address,     6) !=0  ||
-                                     p1->power_change_interfaces[i].requested_power_state !=  p2->power_change_interfaces[i].requested_power_state
-                   )
-                {
-                    return 1;
-                }
-            }
+    struct interfacePowerChangeInformationTLV *m;
 
-            return 0;
-        }
+    uint16_t tlv_length;
 
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS:
-        {
-            struct interfacePowerChangeStatusTLV *p1, *p2;
-            uint8_t i;
+    m = (struct interfacePowerChangeInformationTLV *)tlv;
 
-            p1 = (struct interfacePowerChangeStatusTLV *)memory_structure_1;
-            p2 = (struct interfacePowerChangeStatusTLV *)memory_structure_2;
+    tlv_length  = 1;  // number of interfaces (1 bytes)
+    tlv_length += (6+1) * m->power_change_interfaces_nr;
 
-            if (
-                 p1->power_change_interfaces_nr != p2->power_change_interfaces_nr
-               )
-            {
-                return 1;
-            }
+    return tlv_length;
+}
 
-            if (p1->power_change_interfaces_nr > 0 && (NULL == p1->power_change_interfaces || NULL == p2->power_change_interfaces))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
+static bool tlv_forge_interfacePowerChangeInformation(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.29"
 
-            for (i=0; i<p1->power_change_interfaces_nr; i++)
-            {
-                if (
-                     memcmp(p1->power_change_interfaces[i].interface_address,     p2->power_change_interfaces[i].interface_address,  6) !=0  ||
-                                     p1->power_change_interfaces[i].result             !=  p2->power_change_interfaces[i].result
-                   )
-                {
-                    return 1;
-                }
-            }
+    uint8_t *p;
+    struct interfacePowerChangeInformationTLV *m;
 
-            return 0;
-        }
+    uint16_t tlv_length;
 
-        case TLV_TYPE_L2_NEIGHBOR_DEVICE:
-        {
-            struct l2NeighborDeviceTLV *p1, *p2;
-            uint8_t i, j, k;
+    uint8_t i;
 
-            p1 = (struct l2NeighborDeviceTLV *)memory_structure_1;
-            p2 = (struct l2NeighborDeviceTLV *)memory_structure_2;
+    m = (struct interfacePowerChangeInformationTLV *)tlv;
+    tlv_length = tlv_length_interfacePowerChangeInformation(tlv);
 
-            if (
-                 p1->local_interfaces_nr != p2->local_interfaces_nr
-               )
-            {
-                return 1;
-            }
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            if (p1->local_interfaces_nr > 0 && (NULL == p1->local_interfaces || NULL == p2->local_interfaces))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
+    _I1B(&m->power_change_interfaces_nr, &p);
 
-            for (i=0; i<p1->local_interfaces_nr; i++)
-            {
-                if (
-                     memcmp(p1->local_interfaces[i].local_mac_address,     p2->local_interfaces[i].local_mac_address, 6) !=0   ||
-                                     p1->local_interfaces[i].l2_neighbors_nr    !=  p2->local_interfaces[i].l2_neighbors_nr
-                   )
-                {
-                    return 1;
-                }
+    for (i=0; i<m->power_change_interfaces_nr; i++)
+    {
+        _InB( m->power_change_interfaces[i].interface_address,     &p, 6);
+        _I1B(&m->power_change_interfaces[i].requested_power_state, &p);
+    }
 
-                if (p1->local_interfaces[i].l2_neighbors_nr > 0 && (NULL == p1->local_interfaces[i].l2_neighbors || NULL == p2->local_interfaces[i].l2_neighbors))
-                {
-                    // Malformed structure
-                    //
-                    return 1;
-                }
+    *buf     = p;
+    *length -= tlv_length;
 
-                for (j=0; j<p1->local_interfaces[i].l2_neighbors_nr; j++)
-                {
-                    if (
-                         memcmp(p1->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address,     p2->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address,        6) !=0   ||
-                                         p1->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr  !=  p2->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr
-                       )
-                    {
-                        return 1;
-                    }
+    return true;
+}
 
-                    if (p1->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr > 0 && (NULL == p1->local_interfaces[i].l2_neighbors[j].behind_mac_addresses || NULL == p2->local_interfaces[i].l2_neighbors[j].behind_mac_addresses))
-                    {
-                        // Malformed structure
-                        //
-                        return 1;
-                    }
+static void tlv_print_interfacePowerChangeInformation(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct interfacePowerChangeInformationTLV *p;
+    uint8_t i;
 
-                    for (k=0; k<p1->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr; k++)
-                    {
-                        if (
-                             memcmp(p1->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k], p2->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k], 6) !=0
-                           )
-                        {
-                            return 1;
-                        }
-                    }
-                }
-            }
+    p = (struct interfacePowerChangeInformationTLV *)tlv;
 
-            return 0;
-        }
+    print_callback(write_function, prefix, sizeof(p->power_change_interfaces_nr), "power_change_interfaces_nr", "%d",  &p->power_change_interfaces_nr);
+    for (i=0; i < p->power_change_interfaces_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-        default:
-        {
-            uint8_t ret;
-            struct tlv_list *dummy1 = alloc_dummy_tlv_list(memory_structure_1);
-            struct tlv_list *dummy2 = alloc_dummy_tlv_list(memory_structure_2);
-            if (tlv_compare(tlv_1905_defs, dummy1, dummy2))
-            {
-                ret = 0;
-            }
-            else
-            {
-                ret = 1;
-            }
-            free_dummy_tlv_list(dummy1);
-            free_dummy_tlv_list(dummy2);
+        snprintf(new_prefix, MAX_PREFIX-1, "%spower_change_interfaces[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            return ret;
-        }
+        print_callback(write_function, new_prefix, sizeof(p->power_change_interfaces[i].interface_address),     "interface_address",       "0x%02x",   p->power_change_interfaces[i].interface_address);
+        print_callback(write_function, new_prefix, sizeof(p->power_change_interfaces[i].requested_power_state), "requested_power_state",   "0x%02x",  &p->power_change_interfaces[i].requested_power_state);
     }
-
-    // This code cannot be reached
-    //
-    return 1;
 }
 
-
-void visit_1905_TLV_structure(uint8_t *memory_structure, visitor_callback callback, void (*write_function)(const char *fmt, ...), const char *prefix)
+static void tlv_free_interfacePowerChangeInformation(struct tlv *tlv)
 {
-    // In order to make it easier for the callback() function to present
-    // useful information, append the type of the TLV to the prefix
-    //
-    char tlv_prefix[MAX_PREFIX];
+    struct interfacePowerChangeInformationTLV *m;
 
-    if (NULL == memory_structure)
+    m = (struct interfacePowerChangeInformationTLV *)tlv;
+
+    if (m->power_change_interfaces_nr > 0 && NULL != m->power_change_interfaces)
     {
-        return;
+        memfree(m->power_change_interfaces);
     }
+    memfree(m);
+}
+
+static bool tlv_compare_interfacePowerChangeInformation(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct interfacePowerChangeInformationTLV *p1, *p2;
+    uint8_t i;
 
-    snprintf(tlv_prefix, MAX_PREFIX-1, "%sTLV(%s)->",
-                      prefix,
-                      convert_1905_TLV_type_to_string(*memory_structure));
-    tlv_prefix[MAX_PREFIX-1] = 0x0;
+    p1 = (struct interfacePowerChangeInformationTLV *)tlv1;
+    p2 = (struct interfacePowerChangeInformationTLV *)tlv2;
 
-    // The first byte of any of the valid structures is always the "tlv_type"
-    // field.
-    //
-    switch (*memory_structure)
+    if (
+         p1->power_change_interfaces_nr != p2->power_change_interfaces_nr
+       )
     {
-        case TLV_TYPE_DEVICE_INFORMATION_TYPE:
-        {
-            struct deviceInformationTypeTLV *p;
-            uint8_t i;
+        return false;
+    }
 
-            p = (struct deviceInformationTypeTLV *)memory_structure;
+    if (p1->power_change_interfaces_nr > 0 && (NULL == p1->power_change_interfaces || NULL == p2->power_change_interfaces))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
 
-            callback(write_function, tlv_prefix, sizeof(p->al_mac_address),      "al_mac_address",       "0x%02x",   p->al_mac_address);
-            callback(write_function, tlv_prefix, sizeof(p->local_interfaces_nr), "local_interfaces_nr",  "%d",       &p->local_interfaces_nr);
-            for (i=0; i < p->local_interfaces_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
+    for (i=0; i<p1->power_change_interfaces_nr; i++)
+    {
+        if (
+             memcmp(p1->power_change_interfaces[i].interface_address,        p2->power_change_interfaces[i].interface_address,     6) !=0  ||
+                             p1->power_change_interfaces[i].requested_power_state !=  p2->power_change_interfaces[i].requested_power_state
+           )
+        {
+            return false;
+        }
+    }
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
+    return true;
+}
 
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].mac_address),              "mac_address",              "0x%02x",   p->local_interfaces[i].mac_address);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_type),               "media_type",               "0x%04x",  &p->local_interfaces[i].media_type);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data_size), "media_specific_data_size", "%d",      &p->local_interfaces[i].media_specific_data_size);
+/** @} */
 
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == p->local_interfaces[i].media_type)
-                   )
-                {
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.network_membership),                  "network_membership",                   "0x%02x",   p->local_interfaces[i].media_specific_data.ieee80211.network_membership);
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.role),                                "role",                                 "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.role);
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band),                     "ap_channel_band",                      "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band);
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1), "ap_channel_center_frequency_index_1",  "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2), "ap_channel_center_frequency_index_2",  "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == p->local_interfaces[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == p->local_interfaces[i].media_type)
-                        )
-                {
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee1901.network_identifier), "network_identifier", "0x%02x", p->local_interfaces[i].media_specific_data.ieee1901.network_identifier);
-                }
+/** @brief Support functions for interfacePowerChangeStatus TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.30
+ *
+ * @{
+ */
 
-            }
+static struct tlv *tlv_parse_interfacePowerChangeStatus(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.30"
 
-            return;
-        }
+    struct interfacePowerChangeStatusTLV  *ret;
 
-        case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
-        {
-            struct deviceBridgingCapabilityTLV *p;
-            uint8_t i, j;
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i;
 
-            p = (struct deviceBridgingCapabilityTLV *)memory_structure;
+    ret = (struct interfacePowerChangeStatusTLV *)memalloc(sizeof(struct interfacePowerChangeStatusTLV));
 
-            callback(write_function, tlv_prefix, sizeof(p->bridging_tuples_nr), "bridging_tuples_nr", "%d",  &p->bridging_tuples_nr);
-            for (i=0; i < p->bridging_tuples_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
+    p   = (uint8_t *)buffer;
+    len = length;
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%sbridging_tuples[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
+    ret->tlv.type = TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS;
 
-                callback(write_function, new_prefix, sizeof(p->bridging_tuples[i].bridging_tuple_macs_nr), "bridging_tuple_macs_nr", "%d",  &p->bridging_tuples[i].bridging_tuple_macs_nr);
+    if (0 == len)
+    {
+#ifdef FIX_BROKEN_TLVS
+        // Malformed packet. Even if there are NO bridging tuples, the
+        // Malformed packet. Even if there are NO interfaces, the length
+        // should be "1" (which is the length of the next field, that
+        // would containing a "zero", indicating the number of
+        // interfaces).
+        // *However*, because at least one other implementation sets
+        // the 'length' to zero to indicate "no interfaces", we will
+        // also accept this type of "malformed" packet.
+        //
+        ret->power_change_interfaces_nr = 0;
+        return (struct tlv *)ret;
+#else
+        memfree(ret);
+        return NULL;
+#endif
+    }
 
-                for (j=0; j < p->bridging_tuples[i].bridging_tuple_macs_nr; j++)
-                {
-                    snprintf(new_prefix, MAX_PREFIX-1, "%sbridging_tuples[%d]->bridging_tuple_macs[%d]->", tlv_prefix, i, j);
-                    new_prefix[MAX_PREFIX-1] = 0x0;
+    _E1B(&p, &ret->power_change_interfaces_nr);
 
-                    callback(write_function, new_prefix, sizeof(p->bridging_tuples[i].bridging_tuple_macs[j].mac_address), "mac_address", "0x%02x",  p->bridging_tuples[i].bridging_tuple_macs[j].mac_address);
-                }
-            }
+    if (ret->power_change_interfaces_nr > 0)
+    {
+        ret->power_change_interfaces = (struct _powerChangeStatusEntries *)memalloc(sizeof(struct _powerChangeStatusEntries) * ret->power_change_interfaces_nr);
 
-            return;
+        for (i=0; i < ret->power_change_interfaces_nr; i++)
+        {
+            _EnB(&p,  ret->power_change_interfaces[i].interface_address, 6);
+            _E1B(&p, &ret->power_change_interfaces[i].result);
         }
+    }
 
-        case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        if (ret->power_change_interfaces_nr > 0)
         {
-            struct non1905NeighborDeviceListTLV *p;
-            uint8_t i;
+            memfree(ret->power_change_interfaces);
+        }
+        memfree(ret);
+        return NULL;
+    }
 
-            p = (struct non1905NeighborDeviceListTLV *)memory_structure;
+    return (struct tlv *)ret;
+}
 
-            if (p->non_1905_neighbors_nr > 0 && NULL == p->non_1905_neighbors)
-            {
-                // Malformed structure
-                return;
-            }
+static uint16_t tlv_length_interfacePowerChangeStatus(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.30"
 
-            callback(write_function, tlv_prefix, sizeof(p->local_mac_address),     "local_mac_address",     "0x%02x",   p->local_mac_address);
-            callback(write_function, tlv_prefix, sizeof(p->non_1905_neighbors_nr), "non_1905_neighbors_nr", "%d",      &p->non_1905_neighbors_nr);
-            for (i=0; i < p->non_1905_neighbors_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
+    struct interfacePowerChangeStatusTLV *m;
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%snon_1905_neighbors[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
+    uint16_t tlv_length;
 
-                callback(write_function, new_prefix, sizeof(p->non_1905_neighbors[i].mac_address), "mac_address", "0x%02x", p->non_1905_neighbors[i].mac_address);
-            }
+    m = (struct interfacePowerChangeStatusTLV *)tlv;
 
-            return;
-        }
+    tlv_length  = 1;  // number of interfaces (1 bytes)
+    tlv_length += (6+1) * m->power_change_interfaces_nr;
 
-        case TLV_TYPE_NEIGHBOR_DEVICE_LIST:
-        {
-            struct neighborDeviceListTLV *p;
-            uint8_t i;
+    return tlv_length;
+}
 
-            p = (struct neighborDeviceListTLV *)memory_structure;
+static bool tlv_forge_interfacePowerChangeStatus(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.30"
 
-            if (p->neighbors_nr > 0 && NULL == p->neighbors)
-            {
-                // Malformed structure
-                return;
-            }
+    uint8_t *p;
+    struct interfacePowerChangeStatusTLV *m;
 
-            callback(write_function, tlv_prefix, sizeof(p->local_mac_address), "local_mac_address",  "0x%02x",   p->local_mac_address);
-            callback(write_function, tlv_prefix, sizeof(p->neighbors_nr),      "neighbors_nr",       "%d",      &p->neighbors_nr);
-            for (i=0; i < p->neighbors_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
+    uint16_t tlv_length;
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%sneighbors[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
+    uint8_t i;
 
-                callback(write_function, new_prefix, sizeof(p->neighbors[i].mac_address), "mac_address", "0x%02x",  p->neighbors[i].mac_address);
-                callback(write_function, new_prefix, sizeof(p->neighbors[i].bridge_flag), "bridge_flag", "%d",     &p->neighbors[i].bridge_flag);
-            }
+    m = (struct interfacePowerChangeStatusTLV *)tlv;
+    tlv_length = tlv_length_interfacePowerChangeStatus(tlv);
 
-            return;
-        }
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-        case TLV_TYPE_TRANSMITTER_LINK_METRIC:
-        {
-            struct transmitterLinkMetricTLV *p;
-            uint8_t i;
+    _I1B(&m->power_change_interfaces_nr, &p);
 
-            p = (struct transmitterLinkMetricTLV *)memory_structure;
+    for (i=0; i<m->power_change_interfaces_nr; i++)
+    {
+        _InB( m->power_change_interfaces[i].interface_address, &p, 6);
+        _I1B(&m->power_change_interfaces[i].result,            &p);
+    }
 
-            if (NULL == p->transmitter_link_metrics)
-            {
-                // Malformed structure
-                return;
-            }
+    *buf     = p;
+    *length -= tlv_length;
 
-            callback(write_function, tlv_prefix, sizeof(p->local_al_address),            "local_al_address",            "0x%02x",   p->local_al_address);
-            callback(write_function, tlv_prefix, sizeof(p->neighbor_al_address),         "neighbor_al_address",         "0x%02x",   p->neighbor_al_address);
-            callback(write_function, tlv_prefix, sizeof(p->transmitter_link_metrics_nr), "transmitter_link_metrics_nr", "%d",      &p->transmitter_link_metrics_nr);
-            for (i=0; i < p->transmitter_link_metrics_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
+    return true;
+}
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%stransmitter_link_metrics[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
+static void tlv_print_interfacePowerChangeStatus(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct interfacePowerChangeStatusTLV *p;
+    uint8_t i;
 
-                callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].local_interface_address),    "local_interface_address",    "0x%02x",   p->transmitter_link_metrics[i].local_interface_address);
-                callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].neighbor_interface_address), "neighbor_interface_address", "0x%02x",   p->transmitter_link_metrics[i].neighbor_interface_address);
-                callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].intf_type),                  "intf_type",                  "0x%04x",  &p->transmitter_link_metrics[i].intf_type);
-                callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].bridge_flag),                "bridge_flag",                "%d",      &p->transmitter_link_metrics[i].bridge_flag);
-                callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].packet_errors),              "packet_errors",              "%d",      &p->transmitter_link_metrics[i].packet_errors);
-                callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].transmitted_packets),        "transmitted_packets",        "%d",      &p->transmitter_link_metrics[i].transmitted_packets);
-                callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].mac_throughput_capacity),    "mac_throughput_capacity",    "%d",      &p->transmitter_link_metrics[i].mac_throughput_capacity);
-                callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].link_availability),          "link_availability",          "%d",      &p->transmitter_link_metrics[i].link_availability);
-                callback(write_function, new_prefix, sizeof(p->transmitter_link_metrics[i].phy_rate),                   "phy_rate",                   "%d",      &p->transmitter_link_metrics[i].phy_rate);
-            }
+    p = (struct interfacePowerChangeStatusTLV *)tlv;
 
-            return;
-        }
+    print_callback(write_function, prefix, sizeof(p->power_change_interfaces_nr), "power_change_interfaces_nr", "%d",  &p->power_change_interfaces_nr);
+    for (i=0; i < p->power_change_interfaces_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-        case TLV_TYPE_RECEIVER_LINK_METRIC:
-        {
-            struct receiverLinkMetricTLV *p;
-            uint8_t i;
+        snprintf(new_prefix, MAX_PREFIX-1, "%spower_change_interfaces[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            p = (struct receiverLinkMetricTLV *)memory_structure;
+        print_callback(write_function, new_prefix, sizeof(p->power_change_interfaces[i].interface_address), "interface_address",  "0x%02x",  p->power_change_interfaces[i].interface_address);
+        print_callback(write_function, new_prefix, sizeof(p->power_change_interfaces[i].result),            "result",             "%d",     &p->power_change_interfaces[i].result);
+    }
+}
 
-            if (NULL == p->receiver_link_metrics)
-            {
-                // Malformed structure
-                return;
-            }
+static void tlv_free_interfacePowerChangeStatus(struct tlv *tlv)
+{
+    struct interfacePowerChangeStatusTLV *m;
 
-            callback(write_function, tlv_prefix, sizeof(p->local_al_address),         "local_al_address",         "0x%02x",   p->local_al_address);
-            callback(write_function, tlv_prefix, sizeof(p->neighbor_al_address),      "neighbor_al_address",      "0x%02x",   p->neighbor_al_address);
-            callback(write_function, tlv_prefix, sizeof(p->receiver_link_metrics_nr), "receiver_link_metrics_nr", "%d",      &p->receiver_link_metrics_nr);
-            for (i=0; i < p->receiver_link_metrics_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
+    m = (struct interfacePowerChangeStatusTLV *)tlv;
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%sreceiver_link_metrics[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
+    if (m->power_change_interfaces_nr > 0 && NULL != m->power_change_interfaces)
+    {
+        memfree(m->power_change_interfaces);
+    }
+    memfree(m);
+}
 
-                callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].local_interface_address),    "local_interface_address",    "0x%02x",   p->receiver_link_metrics[i].local_interface_address);
-                callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].neighbor_interface_address), "neighbor_interface_address", "0x%02x",   p->receiver_link_metrics[i].neighbor_interface_address);
-                callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].intf_type),                  "intf_type",                  "0x%04x",  &p->receiver_link_metrics[i].intf_type);
-                callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].packet_errors),              "packet_errors",              "%d",      &p->receiver_link_metrics[i].packet_errors);
-                callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].packets_received),           "packets_received",           "%d",      &p->receiver_link_metrics[i].packets_received);
-                callback(write_function, new_prefix, sizeof(p->receiver_link_metrics[i].rssi),                       "rssi",                       "%d",      &p->receiver_link_metrics[i].rssi);
-            }
+static bool tlv_compare_interfacePowerChangeStatus(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct interfacePowerChangeStatusTLV *p1, *p2;
+    uint8_t i;
 
-            return;
-        }
+    p1 = (struct interfacePowerChangeStatusTLV *)tlv1;
+    p2 = (struct interfacePowerChangeStatusTLV *)tlv2;
 
-        case TLV_TYPE_LINK_METRIC_RESULT_CODE:
+    if (
+         p1->power_change_interfaces_nr != p2->power_change_interfaces_nr
+       )
+    {
+        return false;
+    }
+
+    if (p1->power_change_interfaces_nr > 0 && (NULL == p1->power_change_interfaces || NULL == p2->power_change_interfaces))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
+
+    for (i=0; i<p1->power_change_interfaces_nr; i++)
+    {
+        if (
+             memcmp(p1->power_change_interfaces[i].interface_address,     p2->power_change_interfaces[i].interface_address,  6) !=0  ||
+                             p1->power_change_interfaces[i].result             !=  p2->power_change_interfaces[i].result
+           )
         {
-            struct linkMetricResultCodeTLV *p;
+            return false;
+        }
+    }
 
-            p = (struct linkMetricResultCodeTLV *)memory_structure;
+    return true;
+}
 
-            callback(write_function, tlv_prefix, sizeof(p->result_code), "result_code",  "%d",  &p->result_code);
+/** @} */
 
-            return;
-        }
+/** @brief Support functions for l2NeighborDevice TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.31
+ *
+ * @{
+ */
 
-        case TLV_TYPE_SEARCHED_ROLE:
-        {
-            struct searchedRoleTLV *p;
+static struct tlv *tlv_parse_l2NeighborDevice(const struct tlv_def *def __attribute__((unused)), const uint8_t *buffer, size_t length)
+{
+    // This parsing is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.31"
 
-            p = (struct searchedRoleTLV *)memory_structure;
+    struct l2NeighborDeviceTLV  *ret;
 
-            callback(write_function, tlv_prefix, sizeof(p->role), "role",  "%d",  &p->role);
+    uint8_t *p;
+    uint16_t len;
+    uint8_t  i, j, k;
 
-            return;
-        }
+    ret = (struct l2NeighborDeviceTLV *)memalloc(sizeof(struct l2NeighborDeviceTLV));
 
-        case TLV_TYPE_AUTOCONFIG_FREQ_BAND:
-        {
-            struct autoconfigFreqBandTLV *p;
+    p   = (uint8_t *)buffer;
+    len = length;
+
+    ret->tlv.type = TLV_TYPE_L2_NEIGHBOR_DEVICE;
 
-            p = (struct autoconfigFreqBandTLV *)memory_structure;
+    if (0 == len)
+    {
+#ifdef FIX_BROKEN_TLVS
+        // Malformed packet. Even if there are NO bridging tuples, the
+        // Malformed packet. Even if there are NO interfaces, the length
+        // should be "1" (which is the length of the next field, that
+        // would containing a "zero", indicating the number of
+        // interfaces).
+        // *However*, because at least one other implementation sets
+        // the 'length' to zero to indicate "no interfaces", we will
+        // also accept this type of "malformed" packet.
+        //
+        ret->local_interfaces_nr = 0;
+        return (struct tlv *)ret;
+#else
+        memfree(ret);
+        return NULL;
+#endif
+    }
 
-            callback(write_function, tlv_prefix, sizeof(p->freq_band), "freq_band",  "%d",  &p->freq_band);
+    _E1B(&p, &ret->local_interfaces_nr);
 
-            return;
-        }
+    if (ret->local_interfaces_nr > 0)
+    {
+        ret->local_interfaces = (struct _l2InterfacesEntries *)memalloc(sizeof(struct _l2InterfacesEntries) * ret->local_interfaces_nr);
 
-        case TLV_TYPE_SUPPORTED_ROLE:
+        for (i=0; i < ret->local_interfaces_nr; i++)
         {
-            struct supportedRoleTLV *p;
+            _EnB(&p,  ret->local_interfaces[i].local_mac_address, 6);
+            _E2B(&p, &ret->local_interfaces[i].l2_neighbors_nr);
+
+            if (ret->local_interfaces[i].l2_neighbors_nr > 0)
+            {
+                ret->local_interfaces[i].l2_neighbors = (struct _l2NeighborsEntries *)memalloc(sizeof(struct _l2NeighborsEntries) * ret->local_interfaces[i].l2_neighbors_nr);
 
-            p = (struct supportedRoleTLV *)memory_structure;
+                for (j=0; j < ret->local_interfaces[i].l2_neighbors_nr; j++)
+                {
+                    _EnB(&p,  ret->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address, 6);
+                    _E2B(&p, &ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr);
 
-            callback(write_function, tlv_prefix, sizeof(p->role), "role",  "%d",  &p->role);
+                    if (ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr > 0)
+                    {
+                        ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses = (uint8_t (*)[6])memalloc(sizeof(uint8_t[6]) * ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr);
 
-            return;
+                        for (k=0; k < ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr; k++)
+                        {
+                            _EnB(&p,  ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k], 6);
+                        }
+                    }
+                }
+            }
         }
+    }
 
-        case TLV_TYPE_SUPPORTED_FREQ_BAND:
+    if (p - buffer != len)
+    {
+        // Malformed packet
+        //
+        for (i=0; i < ret->local_interfaces_nr; i++)
         {
-            struct supportedFreqBandTLV *p;
+            for (j=0; j < ret->local_interfaces[i].l2_neighbors_nr; j++)
+            {
+                memfree(ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses);
+            }
+            memfree(ret->local_interfaces[i].l2_neighbors);
+        }
+        memfree(ret->local_interfaces);
+        memfree(ret);
+        return NULL;
+    }
 
-            p = (struct supportedFreqBandTLV *)memory_structure;
+    return (struct tlv *)ret;
+}
 
-            callback(write_function, tlv_prefix, sizeof(p->freq_band), "freq_band",  "%d",  &p->freq_band);
+static uint16_t tlv_length_l2NeighborDevice(const struct tlv *tlv)
+{
+    // The length is computed according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.31"
 
-            return;
-        }
+    struct l2NeighborDeviceTLV *m;
 
-        case TLV_TYPE_WSC:
-        {
-            struct wscTLV *p;
+    uint16_t tlv_length;
 
-            p = (struct wscTLV *)memory_structure;
+    uint8_t i, j;
 
-            callback(write_function, tlv_prefix, sizeof(p->wsc_frame_size), "wsc_frame_size",  "%d",      &p->wsc_frame_size);
-            callback(write_function, tlv_prefix, p->wsc_frame_size,         "wsc_frame",       "0x%02x",   p->wsc_frame);
+    m = (struct l2NeighborDeviceTLV *)tlv;
 
-            return;
-        }
+    tlv_length = 1;  // number of entries (1 bytes)
+    for (i=0; i<m->local_interfaces_nr; i++)
+    {
+        tlv_length += 6;  // interface MAC address (6 bytes)
+        tlv_length += 2;  // number of neighbors (2 bytes)
 
-        case TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION:
+        for (j=0; j<m->local_interfaces[i].l2_neighbors_nr; j++)
         {
-            struct pushButtonEventNotificationTLV *p;
-            uint8_t i;
-
-            p = (struct pushButtonEventNotificationTLV *)memory_structure;
+            tlv_length += 6;  // neighbor MAC address (6 bytes)
+            tlv_length += 2;  // number of "behind" MACs (1 bytes)
+            tlv_length += 6 * m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr;
+        }
+    }
 
-            callback(write_function, tlv_prefix, sizeof(p->media_types_nr), "media_types_nr",  "0x%02x",  &p->media_types_nr);
-            for (i=0; i < p->media_types_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
+    return tlv_length;
+}
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%smedia_types[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
+static bool tlv_forge_l2NeighborDevice(const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    // This forging is done according to the information detailed in
+    // "IEEE Std 1905.1-2013 Section 6.4.31"
 
-                callback(write_function, new_prefix, sizeof(p->media_types[i].media_type),               "media_type",               "0x%04x",  &p->media_types[i].media_type);
-                callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data_size), "media_specific_data_size", "%d",      &p->media_types[i].media_specific_data_size);
+    uint8_t *p;
+    struct l2NeighborDeviceTLV *m;
 
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == p->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == p->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == p->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == p->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == p->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == p->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == p->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == p->media_types[i].media_type)
-                   )
-                {
-                    callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee80211.network_membership),                  "network_membership",                   "0x%02x",   p->media_types[i].media_specific_data.ieee80211.network_membership);
-                    callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee80211.role),                                "role",                                 "%d",      &p->media_types[i].media_specific_data.ieee80211.role);
-                    callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee80211.ap_channel_band),                     "ap_channel_band",                      "%d",      &p->media_types[i].media_specific_data.ieee80211.ap_channel_band);
-                    callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1), "ap_channel_center_frequency_index_1",  "%d",      &p->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
-                    callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2), "ap_channel_center_frequency_index_2",  "%d",      &p->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == p->media_types[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == p->media_types[i].media_type)
-                        )
-                {
-                    callback(write_function, new_prefix, sizeof(p->media_types[i].media_specific_data.ieee1901.network_identifier), "network_identifier", "0x%02x", p->media_types[i].media_specific_data.ieee1901.network_identifier);
-                }
+    uint16_t tlv_length;
 
-            }
+    uint8_t i, j, k;
 
-            return;
-        }
+    m = (struct l2NeighborDeviceTLV *)tlv;
+    tlv_length = tlv_length_l2NeighborDevice(tlv);
 
-        case TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION:
-        {
-            struct pushButtonJoinNotificationTLV *p;
+    if (*length < tlv_length)
+    {
+        return false;
+    }
+    p = *buf;
 
-            p = (struct pushButtonJoinNotificationTLV *)memory_structure;
+    _I1B(&m->local_interfaces_nr, &p);
 
-            callback(write_function, tlv_prefix, sizeof(p->al_mac_address),     "al_mac_address",      "0x%02x",   p->al_mac_address);
-            callback(write_function, tlv_prefix, sizeof(p->message_identifier), "message_identifier",  "%d",      &p->message_identifier);
-            callback(write_function, tlv_prefix, sizeof(p->mac_address),        "mac_address",         "0x%02x",   p->mac_address);
-            callback(write_function, tlv_prefix, sizeof(p->new_mac_address),    "new_mac_address",     "0x%02x",   p->new_mac_address);
-            return;
-        }
+    for (i=0; i<m->local_interfaces_nr; i++)
+    {
+        _InB( m->local_interfaces[i].local_mac_address, &p, 6);
+        _I2B(&m->local_interfaces[i].l2_neighbors_nr,   &p);
 
-        case TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION:
+        for (j=0; j<m->local_interfaces[i].l2_neighbors_nr; j++)
         {
-            struct genericPhyDeviceInformationTypeTLV *p;
-            uint8_t i;
+            _InB( m->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address, &p, 6);
+            _I2B(&m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr, &p);
 
-            p = (struct genericPhyDeviceInformationTypeTLV *)memory_structure;
-
-            callback(write_function, tlv_prefix, sizeof(p->al_mac_address),      "al_mac_address",      "0x%02x",  &p->al_mac_address);
-            callback(write_function, tlv_prefix, sizeof(p->local_interfaces_nr), "local_interfaces_nr", "%d",      &p->local_interfaces_nr);
-            for (i=0; i < p->local_interfaces_nr; i++)
+            for (k=0; k<m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr; k++)
             {
-                char new_prefix[MAX_PREFIX];
-
-                snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
-
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].local_interface_address),                         "local_interface_address",             "0x%02x",   p->local_interfaces[i].local_interface_address);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].generic_phy_common_data.oui),                     "oui",                                 "0x%02x",   p->local_interfaces[i].generic_phy_common_data.oui);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].generic_phy_common_data.variant_index),           "variant_index",                       "%d",      &p->local_interfaces[i].generic_phy_common_data.variant_index);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].variant_name),                                    "variant_name",                        "%s",       p->local_interfaces[i].variant_name);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].generic_phy_description_xml_url_len),             "generic_phy_description_xml_url_len", "%d",      &p->local_interfaces[i].generic_phy_description_xml_url_len);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr), "media_specific_bytes_nr",             "%d",      &p->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                callback(write_function, new_prefix, p->local_interfaces[i].generic_phy_description_xml_url_len,                     "generic_phy_description_xml_url",     "%s",       p->local_interfaces[i].generic_phy_description_xml_url);
-                callback(write_function, new_prefix, p->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr,         "media_specific_bytes",                "0x%02x",   p->local_interfaces[i].generic_phy_common_data.media_specific_bytes);
+                _InB( m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k], &p, 6);
             }
-
-            return;
         }
+    }
 
-        case TLV_TYPE_DEVICE_IDENTIFICATION:
-        {
-            struct deviceIdentificationTypeTLV *p;
+    *buf     = p;
+    *length -= tlv_length;
 
-            p = (struct deviceIdentificationTypeTLV *)memory_structure;
+    return true;
+}
 
-            callback(write_function, tlv_prefix, sizeof(p->friendly_name),      "friendly_name",       "%s",   p->friendly_name);
-            callback(write_function, tlv_prefix, sizeof(p->manufacturer_name),  "manufacturer_name",   "%s",   p->manufacturer_name);
-            callback(write_function, tlv_prefix, sizeof(p->manufacturer_model), "manufacturer_model",  "%s",   p->manufacturer_model);
-            return;
-        }
+static void tlv_print_l2NeighborDevice(const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    struct l2NeighborDeviceTLV *p;
+    uint8_t i, j, k;
 
-        case TLV_TYPE_CONTROL_URL:
-        {
-            struct controlUrlTypeTLV *p;
+    p = (struct l2NeighborDeviceTLV *)tlv;
 
-            p = (struct controlUrlTypeTLV *)memory_structure;
+    print_callback(write_function, prefix, sizeof(p->local_interfaces_nr), "local_interfaces_nr", "%d",  &p->local_interfaces_nr);
+    for (i=0; i < p->local_interfaces_nr; i++)
+    {
+        char new_prefix[MAX_PREFIX];
 
-            callback(write_function, tlv_prefix, strlen(p->url)+1, "url", "%s", p->url);
+        snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->", prefix, i);
+        new_prefix[MAX_PREFIX-1] = 0x0;
 
-            return;
-        }
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].local_mac_address), "local_mac_address", "0x%02x",   p->local_interfaces[i].local_mac_address);
+        print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].l2_neighbors_nr),   "l2_neighbors_nr",   "%d",      &p->local_interfaces[i].l2_neighbors_nr);
 
-        case TLV_TYPE_IPV4:
+        for (j=0; j < p->local_interfaces[i].l2_neighbors_nr; j++)
         {
-            struct ipv4TypeTLV *p;
-            uint8_t i, j;
+            snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->l2_neighbors[%d]->", prefix, i, j);
+            new_prefix[MAX_PREFIX-1] = 0x0;
 
-            p = (struct ipv4TypeTLV *)memory_structure;
+            print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address), "l2_neighbor_mac_address", "0x%02x",   p->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address);
+            print_callback(write_function, new_prefix, sizeof(p->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr), "behind_mac_addresses_nr", "%d",      &p->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr);
 
-            callback(write_function, tlv_prefix, sizeof(p->ipv4_interfaces_nr), "ipv4_interfaces_nr", "%d",  &p->ipv4_interfaces_nr);
-            for (i=0; i < p->ipv4_interfaces_nr; i++)
+            for (k=0; k < p->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr; k++)
             {
-                char new_prefix[MAX_PREFIX];
-
-                snprintf(new_prefix, MAX_PREFIX-1, "%sipv4_interfaces[%d]->", tlv_prefix, i);
+                snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->l2_neighbors[%d]->behind_mac_addresses[%d]", prefix, i, j, k);
                 new_prefix[MAX_PREFIX-1] = 0x0;
 
-                callback(write_function, new_prefix, sizeof(p->ipv4_interfaces[i].mac_address), "mac_address", "0x%02x",   p->ipv4_interfaces[i].mac_address);
-                callback(write_function, new_prefix, sizeof(p->ipv4_interfaces[i].ipv4_nr),     "ipv4_nr",     "%d",      &p->ipv4_interfaces[i].ipv4_nr);
-
-                for (j=0; j < p->ipv4_interfaces[i].ipv4_nr; j++)
-                {
-                    snprintf(new_prefix, MAX_PREFIX-1, "%sipv4_interfaces[%d]->ipv4[%d]->", tlv_prefix, i, j);
-                    new_prefix[MAX_PREFIX-1] = 0x0;
-
-                    callback(write_function, new_prefix, sizeof(p->ipv4_interfaces[i].ipv4[j].type),             "type",             "%d",     &p->ipv4_interfaces[i].ipv4[j].type);
-                    callback(write_function, new_prefix, sizeof(p->ipv4_interfaces[i].ipv4[j].ipv4_address),     "ipv4_address",     "%ipv4",   p->ipv4_interfaces[i].ipv4[j].ipv4_address);
-                    callback(write_function, new_prefix, sizeof(p->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server), "ipv4_dhcp_server", "%ipv4",   p->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server);
-                }
+                print_callback(write_function, new_prefix, 6, "behind_mac_addresses", "0x%02x", p->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k]);
             }
-
-            return;
         }
+    }
+}
 
-        case TLV_TYPE_IPV6:
-        {
-            struct ipv6TypeTLV *p;
-            uint8_t i, j;
+static void tlv_free_l2NeighborDevice(struct tlv *tlv)
+{
+    struct l2NeighborDeviceTLV *m;
+    uint8_t i, j;
 
-            p = (struct ipv6TypeTLV *)memory_structure;
+    m = (struct l2NeighborDeviceTLV *)tlv;
 
-            callback(write_function, tlv_prefix, sizeof(p->ipv6_interfaces_nr), "ipv6_interfaces_nr", "%d",  &p->ipv6_interfaces_nr);
-            for (i=0; i < p->ipv6_interfaces_nr; i++)
+    for (i=0; i < m->local_interfaces_nr; i++)
+    {
+        if (m->local_interfaces[i].l2_neighbors_nr > 0 && NULL != m->local_interfaces[i].l2_neighbors)
+        {
+            for (j=0; j < m->local_interfaces[i].l2_neighbors_nr; j++)
             {
-                char new_prefix[MAX_PREFIX];
-
-                snprintf(new_prefix, MAX_PREFIX-1, "%sipv6_interfaces[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
-
-                callback(write_function, new_prefix, sizeof(p->ipv6_interfaces[i].mac_address), "mac_address", "0x%02x",   p->ipv6_interfaces[i].mac_address);
-                callback(write_function, new_prefix, sizeof(p->ipv6_interfaces[i].ipv6_nr),     "ipv6_nr",     "%d",      &p->ipv6_interfaces[i].ipv6_nr);
-
-                for (j=0; j < p->ipv6_interfaces[i].ipv6_nr; j++)
+                if (m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr > 0 && NULL != m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses)
                 {
-                    snprintf(new_prefix, MAX_PREFIX-1, "%sipv6_interfaces[%d]->ipv6[%d]->", tlv_prefix, i, j);
-                    new_prefix[MAX_PREFIX-1] = 0x0;
-
-                    callback(write_function, new_prefix, sizeof(p->ipv6_interfaces[i].ipv6[j].type),                "type",                "%d",      &p->ipv6_interfaces[i].ipv6[j].type);
-                    callback(write_function, new_prefix, sizeof(p->ipv6_interfaces[i].ipv6[j].ipv6_address),        "ipv6_address",        "0x%02x",   p->ipv6_interfaces[i].ipv6[j].ipv6_address);
-                    callback(write_function, new_prefix, sizeof(p->ipv6_interfaces[i].ipv6[j].ipv6_address_origin), "ipv6_address_origin", "0x%02x",   p->ipv6_interfaces[i].ipv6[j].ipv6_address_origin);
+                    memfree(m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses);
                 }
             }
-
-            return;
+            memfree(m->local_interfaces[i].l2_neighbors);
         }
+    }
+    if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
+    {
+        memfree(m->local_interfaces);
+    }
+    memfree(m);
+}
 
-        case TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION:
-        {
-            struct pushButtonGenericPhyEventNotificationTLV *p;
-            uint8_t i;
-
-            p = (struct pushButtonGenericPhyEventNotificationTLV *)memory_structure;
+static bool tlv_compare_l2NeighborDevice(const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    struct l2NeighborDeviceTLV *p1, *p2;
+    uint8_t i, j, k;
 
-            callback(write_function, tlv_prefix, sizeof(p->local_interfaces_nr), "local_interfaces_nr", "%d",  &p->local_interfaces_nr);
-            for (i=0; i < p->local_interfaces_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
+    p1 = (struct l2NeighborDeviceTLV *)tlv1;
+    p2 = (struct l2NeighborDeviceTLV *)tlv2;
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
+    if (
+         p1->local_interfaces_nr != p2->local_interfaces_nr
+       )
+    {
+        return false;
+    }
 
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].oui),                     "oui",                     "0x%02x",   p->local_interfaces[i].oui);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].variant_index),           "variant_index",           "%d",      &p->local_interfaces[i].variant_index);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_bytes_nr), "media_specific_bytes_nr", "%d",      &p->local_interfaces[i].media_specific_bytes_nr);
-                callback(write_function, new_prefix, p->local_interfaces[i].media_specific_bytes_nr,         "media_specific_bytes",    "0x%02x",   p->local_interfaces[i].media_specific_bytes);
-            }
+    if (p1->local_interfaces_nr > 0 && (NULL == p1->local_interfaces || NULL == p2->local_interfaces))
+    {
+        // Malformed structure
+        //
+        return false;
+    }
 
-            return;
+    for (i=0; i<p1->local_interfaces_nr; i++)
+    {
+        if (
+             memcmp(p1->local_interfaces[i].local_mac_address,     p2->local_interfaces[i].local_mac_address, 6) !=0   ||
+                             p1->local_interfaces[i].l2_neighbors_nr    !=  p2->local_interfaces[i].l2_neighbors_nr
+           )
+        {
+            return false;
         }
 
-        case TLV_TYPE_1905_PROFILE_VERSION:
+        if (p1->local_interfaces[i].l2_neighbors_nr > 0 && (NULL == p1->local_interfaces[i].l2_neighbors || NULL == p2->local_interfaces[i].l2_neighbors))
         {
-            struct x1905ProfileVersionTLV *p;
+            // Malformed structure
+            //
+            return false;
+        }
 
-            p = (struct x1905ProfileVersionTLV *)memory_structure;
+        for (j=0; j<p1->local_interfaces[i].l2_neighbors_nr; j++)
+        {
+            if (
+                 memcmp(p1->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address,     p2->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address,        6) !=0   ||
+                                 p1->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr  !=  p2->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr
+               )
+            {
+                return false;
+            }
 
-            callback(write_function, tlv_prefix, sizeof(p->profile), "profile",  "%d",  &p->profile);
+            if (p1->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr > 0 && (NULL == p1->local_interfaces[i].l2_neighbors[j].behind_mac_addresses || NULL == p2->local_interfaces[i].l2_neighbors[j].behind_mac_addresses))
+            {
+                // Malformed structure
+                //
+                return false;
+            }
 
-            return;
+            for (k=0; k<p1->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr; k++)
+            {
+                if (
+                     memcmp(p1->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k], p2->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k], 6) !=0
+                   )
+                {
+                    return false;
+                }
+            }
         }
+    }
 
-        case TLV_TYPE_POWER_OFF_INTERFACE:
-        {
-            struct powerOffInterfaceTLV *p;
-            uint8_t i;
+    return true;
+}
 
-            p = (struct powerOffInterfaceTLV *)memory_structure;
+/** @} */
 
-            callback(write_function, tlv_prefix, sizeof(p->power_off_interfaces_nr), "power_off_interfaces_nr", "%d",  &p->power_off_interfaces_nr);
-            for (i=0; i < p->power_off_interfaces_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%spower_off_interfaces[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
+/** @brief Metadata of all the 1905 TLV types.
+ *
+ * TLVs made of fixed size fields (or of a single trailing variable length field) are generated with tlv_template.h.
+ * The ones that carry counted lists of sub-structures have hand-written callbacks.
+ */
+tlv_defs_t tlv_1905_defs = {
+    [TLV_TYPE_END_OF_MESSAGE] = {
+        .type = TLV_TYPE_END_OF_MESSAGE,
+        .name = "endOfMessage",
+    },
+    TLV_DEF_ENTRY(vendorSpecific,TLV_TYPE_VENDOR_SPECIFIC),
+    TLV_DEF_ENTRY(alMacAddressType,TLV_TYPE_AL_MAC_ADDRESS_TYPE),
+    TLV_DEF_ENTRY(macAddressType,TLV_TYPE_MAC_ADDRESS_TYPE),
+    TLV_DEF_ENTRY(linkMetricQuery,TLV_TYPE_LINK_METRIC_QUERY),
+    TLV_DEF_ENTRY(supportedService,TLV_TYPE_SUPPORTED_SERVICE),
+    /* Searched service is exactly the same as supported service, so reuse the functions. */
+    [TLV_TYPE_SEARCHED_SERVICE] = {
+        .type = TLV_TYPE_SEARCHED_SERVICE,
+        .name = "searchedService",
+        .parse = tlv_parse_supportedService,
+        .length = tlv_length_supportedService,
+        .forge = tlv_forge_supportedService,
+        .print = tlv_print_supportedService,
+        .free = tlv_free_supportedService,
+        .compare = tlv_compare_supportedService,
+    },
+    TLV_DEF_ENTRY(linkMetricResultCode,TLV_TYPE_LINK_METRIC_RESULT_CODE),
+    TLV_DEF_ENTRY(searchedRole,TLV_TYPE_SEARCHED_ROLE),
+    TLV_DEF_ENTRY(autoconfigFreqBand,TLV_TYPE_AUTOCONFIG_FREQ_BAND),
+    TLV_DEF_ENTRY(supportedRole,TLV_TYPE_SUPPORTED_ROLE),
+    TLV_DEF_ENTRY(supportedFreqBand,TLV_TYPE_SUPPORTED_FREQ_BAND),
+    TLV_DEF_ENTRY(wsc,TLV_TYPE_WSC),
+    TLV_DEF_ENTRY(pushButtonJoinNotification,TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION),
+    TLV_DEF_ENTRY(deviceIdentificationType,TLV_TYPE_DEVICE_IDENTIFICATION),
+    TLV_DEF_ENTRY(controlUrlType,TLV_TYPE_CONTROL_URL),
+    TLV_DEF_ENTRY(x1905ProfileVersion,TLV_TYPE_1905_PROFILE_VERSION),
+    TLV_DEF_ENTRY(apOperationalBss,TLV_TYPE_AP_OPERATIONAL_BSS),
+    TLV_DEF_ENTRY(associatedClients,TLV_TYPE_ASSOCIATED_CLIENTS),
+    TLV_DEF_ENTRY(deviceInformationType,TLV_TYPE_DEVICE_INFORMATION_TYPE),
+    TLV_DEF_ENTRY(deviceBridgingCapability,TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES),
+    TLV_DEF_ENTRY(non1905NeighborDeviceList,TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST),
+    TLV_DEF_ENTRY(neighborDeviceList,TLV_TYPE_NEIGHBOR_DEVICE_LIST),
+    TLV_DEF_ENTRY(transmitterLinkMetric,TLV_TYPE_TRANSMITTER_LINK_METRIC),
+    TLV_DEF_ENTRY(receiverLinkMetric,TLV_TYPE_RECEIVER_LINK_METRIC),
+    TLV_DEF_ENTRY(pushButtonEventNotification,TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION),
+    TLV_DEF_ENTRY(genericPhyDeviceInformationType,TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION),
+    TLV_DEF_ENTRY(ipv4Type,TLV_TYPE_IPV4),
+    TLV_DEF_ENTRY(ipv6Type,TLV_TYPE_IPV6),
+    TLV_DEF_ENTRY(pushButtonGenericPhyEventNotification,TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION),
+    TLV_DEF_ENTRY(powerOffInterface,TLV_TYPE_POWER_OFF_INTERFACE),
+    TLV_DEF_ENTRY(interfacePowerChangeInformation,TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION),
+    TLV_DEF_ENTRY(interfacePowerChangeStatus,TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS),
+    TLV_DEF_ENTRY(l2NeighborDevice,TLV_TYPE_L2_NEIGHBOR_DEVICE),
+};
 
-                callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].interface_address),                               "interface_address",       "0x%02x",   p->power_off_interfaces[i].interface_address);
-                callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].media_type),                                      "media_type",              "0x%04x",  &p->power_off_interfaces[i].media_type);
-                callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].generic_phy_common_data.oui),                     "oui",                     "0x%02x",   p->power_off_interfaces[i].generic_phy_common_data.oui);
-                callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].generic_phy_common_data.variant_index),           "variant_index",           "%d",      &p->power_off_interfaces[i].generic_phy_common_data.variant_index);
-                callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr), "media_specific_bytes_nr", "%d",      &p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                callback(write_function, new_prefix, p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr,         "media_specific_bytes",    "0x%02x",   p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes);
-            }
+////////////////////////////////////////////////////////////////////////////////
+// Actual API functions
+////////////////////////////////////////////////////////////////////////////////
 
-            return;
-        }
+uint8_t *parse_1905_TLV_from_packet(uint8_t *packet_stream)
+{
+    uint8_t *p;
+    uint16_t len;
 
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION:
-        {
-            struct interfacePowerChangeInformationTLV *p;
-            uint8_t i;
+    if (NULL == packet_stream)
+    {
+        return NULL;
+    }
 
-            p = (struct interfacePowerChangeInformationTLV *)memory_structure;
+    // The first byte of the stream is the "Type" field from the TLV structure
+    // and the next two its "Length". Every type is parsed through its
+    // "tlv_1905_defs" entry.
+    //
+    p = packet_stream + 1;
+    _E2B(&p, &len);
 
-            callback(write_function, tlv_prefix, sizeof(p->power_change_interfaces_nr), "power_change_interfaces_nr", "%d",  &p->power_change_interfaces_nr);
-            for (i=0; i < p->power_change_interfaces_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
+    return (uint8_t *)tlv_parse_single(tlv_1905_defs, packet_stream, len + 3);
+}
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%spower_change_interfaces[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
 
-                callback(write_function, new_prefix, sizeof(p->power_change_interfaces[i].interface_address),     "interface_address",       "0x%02x",   p->power_change_interfaces[i].interface_address);
-                callback(write_function, new_prefix, sizeof(p->power_change_interfaces[i].requested_power_state), "requested_power_state",   "0x%02x",  &p->power_change_interfaces[i].requested_power_state);
-            }
+// "_forge_1905_TLV()" can either allocate the buffer where the TLV is forged
+// (when 'buffer' is NULL) or use the one provided by the caller. The next two
+// functions take care of the details.
+//
+// "_getForgeBuffer()" returns NULL if the caller's buffer is too small to
+// contain 'len' bytes.
+//
+static uint8_t *_getForgeBuffer(uint8_t *buffer, uint16_t buffer_size, uint16_t len)
+{
+    if (NULL == buffer)
+    {
+        return (uint8_t *)memalloc(len);
+    }
+    if (len > buffer_size)
+    {
+        return NULL;
+    }
+    return buffer;
+}
+static void _releaseForgeBuffer(uint8_t *ret, uint8_t *buffer)
+{
+    if (ret != buffer)
+    {
+        memfree(ret);
+    }
+}
 
-            return;
-        }
+static uint8_t *_forge_1905_TLV(uint8_t *memory_structure, uint16_t *len, uint8_t *buffer, uint16_t buffer_size)
+{
+    // Every type is forged through its "tlv_1905_defs" entry, whose length
+    // function gives the exact size up front
+    //
+    const struct tlv *tlv = (const struct tlv *)memory_structure;
+    uint8_t          *ret, *p;
+    size_t            length;
 
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS:
-        {
-            struct interfacePowerChangeStatusTLV *p;
-            uint8_t i;
+    if (NULL == memory_structure)
+    {
+        return NULL;
+    }
 
-            p = (struct interfacePowerChangeStatusTLV *)memory_structure;
+    length = tlv_length_single(tlv_1905_defs, tlv);
+    if (0 == length || length > MAX_NETWORK_SEGMENT_SIZE)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("Failed to forge TLV %s\n",
+                                    convert_1905_TLV_type_to_string(*memory_structure));
+        return NULL;
+    }
+    *len = length;
 
-            callback(write_function, tlv_prefix, sizeof(p->power_change_interfaces_nr), "power_change_interfaces_nr", "%d",  &p->power_change_interfaces_nr);
-            for (i=0; i < p->power_change_interfaces_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
+    p = ret = _getForgeBuffer(buffer, buffer_size, *len);
+    if (NULL == ret)
+    {
+        return NULL;
+    }
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%spower_change_interfaces[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
+    if (!tlv_forge_single(tlv_1905_defs, tlv, &p, &length) || 0 != length)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("Failed to forge TLV %s\n",
+                                    convert_1905_TLV_type_to_string(*memory_structure));
+        _releaseForgeBuffer(ret, buffer);
+        return NULL;
+    }
 
-                callback(write_function, new_prefix, sizeof(p->power_change_interfaces[i].interface_address), "interface_address",  "0x%02x",  p->power_change_interfaces[i].interface_address);
-                callback(write_function, new_prefix, sizeof(p->power_change_interfaces[i].result),            "result",             "%d",     &p->power_change_interfaces[i].result);
-            }
+    return ret;
+}
 
-            return;
-        }
 
-        case TLV_TYPE_L2_NEIGHBOR_DEVICE:
-        {
-            struct l2NeighborDeviceTLV *p;
-            uint8_t i, j, k;
+uint8_t *forge_1905_TLV_from_structure(uint8_t *memory_structure, uint16_t *len)
+{
+    return _forge_1905_TLV(memory_structure, len, NULL, 0);
+}
 
-            p = (struct l2NeighborDeviceTLV *)memory_structure;
+uint8_t forge_1905_TLV_into_buffer(uint8_t *memory_structure, uint8_t *buffer, uint16_t buffer_size, uint16_t *len)
+{
+    if (NULL == buffer)
+    {
+        return 0;
+    }
 
-            callback(write_function, tlv_prefix, sizeof(p->local_interfaces_nr), "local_interfaces_nr", "%d",  &p->local_interfaces_nr);
-            for (i=0; i < p->local_interfaces_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
+    *len = 0;
+    if (NULL == _forge_1905_TLV(memory_structure, len, buffer, buffer_size))
+    {
+        return 0;
+    }
 
-                snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
+    return 1;
+}
 
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].local_mac_address), "local_mac_address", "0x%02x",   p->local_interfaces[i].local_mac_address);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].l2_neighbors_nr),   "l2_neighbors_nr",   "%d",      &p->local_interfaces[i].l2_neighbors_nr);
 
-                for (j=0; j < p->local_interfaces[i].l2_neighbors_nr; j++)
-                {
-                    snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->l2_neighbors[%d]->", tlv_prefix, i, j);
-                    new_prefix[MAX_PREFIX-1] = 0x0;
+void free_1905_TLV_structure(uint8_t *memory_structure)
+{
+    if (NULL == memory_structure)
+    {
+        return;
+    }
 
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address), "l2_neighbor_mac_address", "0x%02x",   p->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address);
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr), "behind_mac_addresses_nr", "%d",      &p->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr);
+    tlv_free_single(tlv_1905_defs, (struct tlv *)memory_structure);
+}
 
-                    for (k=0; k < p->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr; k++)
-                    {
-                        snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->l2_neighbors[%d]->behind_mac_addresses[%d]", tlv_prefix, i, j, k);
-                        new_prefix[MAX_PREFIX-1] = 0x0;
 
-                        callback(write_function, new_prefix, 6, "behind_mac_addresses", "0x%02x", p->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k]);
-                    }
-                }
-            }
+uint8_t compare_1905_TLV_structures(uint8_t *memory_structure_1, uint8_t *memory_structure_2)
+{
+    if (NULL == memory_structure_1 || NULL == memory_structure_2)
+    {
+        return 1;
+    }
 
-            return;
-        }
+    return tlv_compare_single(tlv_1905_defs, (struct tlv *)memory_structure_1, (struct tlv *)memory_structure_2) ? 0 : 1;
+}
 
-        default:
-        {
-            struct tlv_list *dummy = alloc_dummy_tlv_list(memory_structure);
-            tlv_print(tlv_1905_defs, dummy, write_function, prefix);
-            free_dummy_tlv_list(dummy);
 
-            return;
-        }
+void visit_1905_TLV_structure(uint8_t *memory_structure, visitor_callback callback, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    if (NULL == memory_structure)
+    {
+        return;
     }
 
-    // This code cannot be reached
+    // The "tlv_1905_defs" print functions always use "print_callback()"
     //
-    return;
+    tlv_print_single(tlv_1905_defs, (struct tlv *)memory_structure, write_function, prefix);
 }
 
 const char *convert_1905_TLV_type_to_string(uint8_t tlv_type)
@@ -96,7 +96,7 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                // Malformed packet
                //
-               free(ret);
+               memfree(ret);
                return NULL;
             }
 
@@ -109,7 +109,7 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                // Reserved (invalid) value received
                //
-               free(ret);
+               memfree(ret);
                return NULL;
             }
             else if (0 == destination)
@@ -127,7 +127,7 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                // This code cannot be reached
                //
-               free(ret);
+               memfree(ret);
                return NULL;
             }
 
@@ -137,7 +137,7 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                // Reserved (invalid) value received
                //
-               free(ret);
+               memfree(ret);
                return NULL;
             }
             else if (0 == link_metrics_type)
@@ -156,7 +156,7 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                // This code cannot be reached
                //
-               free(ret);
+               memfree(ret);
                return NULL;
             }
 
@@ -186,14 +186,14 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                 // Malformed packet
                 //
-                free(ret);
+                memfree(ret);
                 return NULL;
             }
             if (0 != (len-12)%29)
             {
                 // Malformed packet
                 //
-                free(ret);
+                memfree(ret);
                 return NULL;
             }
 
@@ -208,7 +208,7 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                 // Malformed packet
                 //
-                free(ret);
+                memfree(ret);
                 return NULL;
             }
 
@@ -234,8 +234,8 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                 // Malformed packet
                 //
-                free(ret->transmitter_link_metrics);
-                free(ret);
+                memfree(ret->transmitter_link_metrics);
+                memfree(ret);
                 return NULL;
             }
 
@@ -266,14 +266,14 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                 // Malformed packet
                 //
-                free(ret);
+                memfree(ret);
                 return NULL;
             }
             if (0 != (len-12)%23)
             {
                 // Malformed packet
                 //
-                free(ret);
+                memfree(ret);
                 return NULL;
             }
 
@@ -288,7 +288,7 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                 // Malformed packet
                 //
-                free(ret);
+                memfree(ret);
                 return NULL;
             }
 
@@ -311,8 +311,8 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                 // Malformed packet
                 //
-                free(ret->receiver_link_metrics);
-                free(ret);
+                memfree(ret->receiver_link_metrics);
+                memfree(ret);
                 return NULL;
             }
 
@@ -340,7 +340,7 @@ uint8_t *parse_bbf_TLV_from_packet(uint8_t *packet_stream)
             {
                 // Malformed packet
                 //
-                free(ret);
+                memfree(ret);
                 return NULL;
             }
 
@@ -518,7 +518,7 @@ uint8_t *forge_bbf_TLV_from_structure(uint8_t *memory_structure, uint16_t *len)
             {
                 // Malformed structure
                 //
-                free(ret);
+                memfree(ret);
                 return NULL;
             }
 
@@ -557,7 +557,7 @@ void free_bbf_TLV_structure(uint8_t *memory_structure)
         case BBF_TLV_TYPE_NON_1905_LINK_METRIC_QUERY:
         case BBF_TLV_TYPE_NON_1905_LINK_METRIC_RESULT_CODE:
         {
-            free(memory_structure);
+            memfree(memory_structure);
 
             return;
         }
@@ -570,9 +570,9 @@ void free_bbf_TLV_structure(uint8_t *memory_structure)
 
             if (m->transmitter_link_metrics_nr > 0 && NULL != m->transmitter_link_metrics)
             {
-                free(m->transmitter_link_metrics);
+                memfree(m->transmitter_link_metrics);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -585,9 +585,9 @@ void free_bbf_TLV_structure(uint8_t *memory_structure)
 
             if (m->receiver_link_metrics_nr > 0 && NULL != m->receiver_link_metrics)
             {
-                free(m->receiver_link_metrics);
+                memfree(m->receiver_link_metrics);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -12,9 +12,31 @@
 struct tlv_list
 {
     size_t tlv_nr;
+    size_t tlv_max; /**< Number of allocated slots in tlvs, at least tlv_nr. */
     struct tlv **tlvs;
 };
 
+/** @brief Count the TLVs in @a buffer by only looking at their headers.
+ *
+ * Stops at the first TLV that doesn't fit, tlv_parse() reports that error.
+ */
+static size_t tlv_count(const uint8_t *buffer, size_t length)
+{
+    size_t count = 0;
+
+    while (length >= 3)
+    {
+        size_t tlv_size = (((size_t)buffer[1] << 8) | buffer[2]) + 3;
+
+        if (tlv_size > length)
+            break;
+        buffer += tlv_size;
+        length -= tlv_size;
+        count++;
+    }
+    return count;
+}
+
 const struct tlv_def *tlv_find_def(tlv_defs_t defs, uint8_t tlv_type)
 {
     return &defs[tlv_type];
@@ -25,9 +47,65 @@ const struct tlv_def *tlv_find_tlv_def(tlv_defs_t defs, const struct tlv *tlv)
     return tlv_find_def(defs, tlv->type);
 }
 
+struct tlv *tlv_parse_single(tlv_defs_t defs, const uint8_t *buffer, size_t length)
+{
+    uint8_t tlv_type;
+    uint16_t tlv_length;
+    const struct tlv_def *tlv_def;
+    struct tlv *tlv_new;
+
+    if (!_E1BL(&buffer, &tlv_type, &length) || !_E2BL(&buffer, &tlv_length, &length))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("TLV header truncated, only %u bytes in buffer\n", (unsigned)length);
+        return NULL;
+    }
+    if (tlv_length > length)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("TLV(%u) of length %u but only %u bytes left in buffer\n",
+                                    tlv_type, tlv_length, (unsigned)length);
+        return NULL;
+    }
+
+    tlv_def = tlv_find_def(defs, tlv_type);
+    if (tlv_def->name == NULL)
+    {
+        struct tlv_unknown *tlv;
+        PLATFORM_PRINTF_DEBUG_WARNING("Unknown TLV type %u of length %u\n",
+                                      (unsigned)tlv_type, (unsigned)tlv_length);
+        tlv = memalloc(sizeof(struct tlv_unknown));
+        tlv->value = memalloc(tlv_length);
+        tlv->length = tlv_length;
+        memcpy(tlv->value, buffer, tlv_length);
+        tlv_new = &tlv->tlv;
+    }
+    else if (tlv_def->parse == NULL)
+    {
+        /* Default parse function only works for 0-length TLVs */
+        if (tlv_length == 0)
+        {
+            tlv_new = memalloc(sizeof(struct tlv));
+        }
+        else
+        {
+            PLATFORM_PRINTF_DEBUG_ERROR("Implementation error: no parse function for TLV %s length %u\n",
+                                        tlv_def->name, (unsigned)tlv_length);
+            return NULL;
+        }
+    }
+    else
+    {
+        tlv_new = tlv_def->parse(tlv_def, buffer, tlv_length);
+    }
+    if (tlv_new != NULL)
+    {
+        tlv_new->type = tlv_type;
+    }
+    return tlv_new;
+}
+
 struct tlv_list *tlv_parse(tlv_defs_t defs, const uint8_t *buffer, size_t length)
 {
-    struct tlv_list *ret = malloc(sizeof(struct tlv_list));
+    struct tlv_list *ret = memalloc(sizeof(struct tlv_list));
 
     if (ret == NULL)
     {
@@ -35,67 +113,43 @@ struct tlv_list *tlv_parse(tlv_defs_t defs, const uint8_t *buffer, size_t length
         return ret;
     }
     ret->tlv_nr = 0;
+    ret->tlv_max = 0;
     ret->tlvs = NULL;
 
+    /* A pre-scan of the headers is much cheaper than growing the list while parsing. */
+    tlv_reserve(ret, tlv_count(buffer, length));
+
     while (length >= 3)    // Minimal TLV: 1 byte type, 2 bytes length
     {
-        uint8_t tlv_type;
         uint16_t tlv_length;
-        const struct tlv_def *tlv_def;
+        const uint8_t *p = buffer + 1;
+        size_t remaining = length - 1;
+        size_t tlv_size;
         struct tlv *tlv_new;
 
-        _E1BL(&buffer, &tlv_type, &length);
-        _E2BL(&buffer, &tlv_length, &length);
-        if (tlv_length > length)
+        /* Only peek at the length, tlv_parse_single() parses the header itself. */
+        _E2BL(&p, &tlv_length, &remaining);
+        tlv_size = (size_t)tlv_length + 3;
+        if (tlv_size > length)
         {
             PLATFORM_PRINTF_DEBUG_ERROR("TLV(%u) of length %u but only %u bytes left in buffer\n",
-                                        tlv_type, tlv_length, (unsigned)length);
+                                        buffer[0], tlv_length, (unsigned)length - 3);
             goto err_out;
         }
 
-        tlv_def = tlv_find_def(defs, tlv_type);
-        if (tlv_def->name == NULL)
-        {
-            struct tlv_unknown *tlv;
-            PLATFORM_PRINTF_DEBUG_WARNING("Unknown TLV type %u of length %u\n",
-                                          (unsigned)tlv_type, (unsigned)tlv_length);
-            tlv = memalloc(sizeof(struct tlv_unknown));
-            tlv->value = memalloc(tlv_length);
-            tlv->length = tlv_length;
-            memcpy(tlv->value, buffer, tlv_length);
-            tlv_new = &tlv->tlv;
-        }
-        else if (tlv_def->parse == NULL)
-        {
-            /* Default parse function only works for 0-length TLVs */
-            if (tlv_length == 0)
-            {
-                tlv_new = memalloc(sizeof(struct tlv));
-            }
-            else
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Implementation error: no parse function for TLV %s length %u\n",
-                                            tlv_def->name, (unsigned)tlv_length);
-                goto err_out;
-            }
-        }
-        else
-        {
-            tlv_new = tlv_def->parse(tlv_def, buffer, tlv_length);
-        }
+        tlv_new = tlv_parse_single(defs, buffer, tlv_size);
         if (tlv_new == NULL)
         {
             goto err_out;
         }
-        tlv_new->type = tlv_type;
         if (!tlv_add(defs, ret, tlv_new))
         {
             /* tlv_add already prints an error */
-            tlv_def ? tlv_def->free(tlv_new) : free(tlv_new);
+            tlv_free_single(defs, tlv_new);
             goto err_out;
         }
-        buffer += tlv_length;
-        length -= tlv_length;
+        buffer += tlv_size;
+        length -= tlv_size;
     }
 
     return ret;
@@ -105,99 +159,210 @@ err_out:
     return NULL;
 }
 
-bool tlv_forge(tlv_defs_t defs, const struct tlv_list *tlvs, size_t max_length, uint8_t **buffer, size_t *length)
+size_t tlv_length_single(tlv_defs_t defs, const struct tlv *tlv)
 {
-    size_t i;
-    size_t total_length;
-    uint8_t *p;
+    const struct tlv_def *tlv_def = tlv_find_tlv_def(defs, tlv);
 
-    /* First, calculate total_length. */
-    total_length = 0;
-    for (i = 0; i < tlvs->tlv_nr; i++)
+    if (tlv_def->name == NULL)
     {
-        const struct tlv *tlv = tlvs->tlvs[i];
-        const struct tlv_def *tlv_def = tlv_find_tlv_def(defs, tlv);
-        if (tlv_def->name == NULL)
-        {
-            PLATFORM_PRINTF_DEBUG_WARNING("tlv_forge: skipping unknown TLV %u\n", tlv->type);
-        }
-        else if (tlv_def->length == NULL)
+        PLATFORM_PRINTF_DEBUG_WARNING("Can't forge unknown TLV %u\n", tlv->type);
+        return 0;
+    }
+    else if (tlv_def->length == NULL)
+    {
+        /* Assume 0-length TLV */
+        return 3;
+    }
+    else if (tlv_def->forge == NULL)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("No forge defined for TVL %s\n", tlv_def->name);
+        return 0;
+    }
+    else
+    {
+        /* Add 3 bytes for type + length */
+        return (size_t)tlv_def->length(tlv) + 3;
+    }
+}
+
+bool tlv_forge_single(tlv_defs_t defs, const struct tlv *tlv, uint8_t **buf, size_t *length)
+{
+    const struct tlv_def *tlv_def = tlv_find_tlv_def(defs, tlv);
+    uint16_t tlv_length;
+
+    if (tlv_def->name == NULL || (tlv_def->length != NULL && tlv_def->forge == NULL))
+        return false;
+
+    tlv_length = tlv_def->length == NULL ? 0 : tlv_def->length(tlv);
+    if (!_I1BL(&tlv->type, buf, length))
+        return false;
+    if (!_I2BL(&tlv_length, buf, length))
+        return false;
+    if (tlv_def->forge != NULL && !tlv_def->forge(tlv, buf, length))
+        return false;
+    return true;
+}
+
+bool tlv_forge(tlv_defs_t defs, const struct tlv_list *tlvs, size_t max_length, size_t headroom, size_t tailroom,
+               uint8_t ***buffers, size_t **lengths, size_t *buffers_nr)
+{
+    return tlv_forge_array(defs, tlvs->tlvs, tlvs->tlv_nr, max_length, headroom, tailroom, buffers, lengths, buffers_nr);
+}
+
+bool tlv_forge_array(tlv_defs_t defs, struct tlv * const *tlvs, size_t tlv_nr, size_t max_length, size_t headroom,
+                     size_t tailroom, uint8_t ***buffers, size_t **lengths, size_t *buffers_nr)
+{
+    size_t i;
+    size_t fragment;
+    size_t fragment_length;
+    size_t *tlv_sizes;
+
+    *buffers = NULL;
+    *lengths = NULL;
+    *buffers_nr = 0;
+
+    /* First, calculate the size of each TLV and decide where each packet starts. The lengths are only calculated once,
+     * so keep them around for the second pass. */
+    tlv_sizes = memalloc((tlv_nr + 1) * sizeof(size_t));
+    *lengths = memalloc((tlv_nr + 1) * sizeof(size_t));
+    fragment = 0;
+    fragment_length = 0;
+    for (i = 0; i < tlv_nr; i++)
+    {
+        const struct tlv *tlv = tlvs[i];
+
+        tlv_sizes[i] = tlv_length_single(defs, tlv);
+        if (tlv_sizes[i] == 0)
         {
-            /* Assume 0-length TLV */
-            total_length += 3;
+            if (tlv_find_tlv_def(defs, tlv)->name != NULL)
+            {
+                /* tlv_length_single already prints an error */
+                goto err_out;
+            }
+            /* Unknown TLVs are skipped */
+            continue;
         }
-        else if (tlv_def->forge == NULL)
+        if (tlv_sizes[i] > max_length)
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("No forge defined for TVL %s\n", tlv_def->name);
-            return false;
+            PLATFORM_PRINTF_DEBUG_ERROR("TLV %u doesn't fit in a single packet, %u > %u.\n",
+                                        tlv->type, (unsigned)tlv_sizes[i], (unsigned)max_length);
+            goto err_out;
         }
-        else
+        if (fragment_length + tlv_sizes[i] > max_length)
         {
-            /* Add 3 bytes for type + length */
-            total_length += tlv_def->length(tlv) + 3;
+            (*lengths)[fragment++] = fragment_length;
+            fragment_length = 0;
         }
+        fragment_length += tlv_sizes[i];
     }
+    /* The last (or only) packet. An empty list still gives one, empty, packet. */
+    (*lengths)[fragment++] = fragment_length;
+    *buffers_nr = fragment;
 
-    /* Now, allocate the buffer and fill it. */
-    /** @todo support splitting over packets. */
-    if (total_length > max_length)
+    /* Now, allocate the packets and forge each TLV straight into its packet. */
+    *buffers = memalloc(*buffers_nr * sizeof(uint8_t *));
+    for (fragment = 0; fragment < *buffers_nr; fragment++)
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("TLV list doesn't fit, %u > %u.\n", (unsigned)total_length, (unsigned)max_length);
-        return false;
+        (*buffers)[fragment] = memalloc(headroom + (*lengths)[fragment] + tailroom);
     }
 
-    /** @todo foresee headroom */
-    *length = total_length;
-    *buffer = malloc(total_length);
-    p = *buffer;
-    for (i = 0; i < tlvs->tlv_nr; i++)
+    fragment = 0;
+    fragment_length = (*lengths)[0];
     {
-        const struct tlv *tlv = tlvs->tlvs[i];
-        const struct tlv_def *tlv_def = tlv_find_tlv_def(defs, tlv);
-        uint16_t tlv_length = tlv_def->length(tlv);
+        uint8_t *p = (*buffers)[0] + headroom;
 
-        if (!_I1BL(&tlv->type, &p, &total_length))
-            goto err_out;
-        if (!_I2BL(&tlv_length, &p, &total_length))
-            goto err_out;
-        if (!tlv_def->forge(tlv, &p, &total_length))
-            goto err_out;
+        for (i = 0; i < tlv_nr; i++)
+        {
+            if (tlv_sizes[i] == 0)
+                continue;
+            if (fragment_length == 0)
+            {
+                /* The current packet is full, move to the next one. */
+                fragment++;
+                p = (*buffers)[fragment] + headroom;
+                fragment_length = (*lengths)[fragment];
+            }
+            if (!tlv_forge_single(defs, tlvs[i], &p, &fragment_length))
+                goto err_out;
+        }
     }
-    if (total_length != 0)
+    if (fragment_length != 0 || fragment != *buffers_nr - 1)
         goto err_out;
+
+    memfree(tlv_sizes);
     return true;
 
 err_out:
-    PLATFORM_PRINTF_DEBUG_ERROR("TLV list forging implementation error.\n");
-    free(*buffer);
+    if (*buffers != NULL)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("TLV list forging implementation error.\n");
+    }
+    memfree(tlv_sizes);
+    tlv_forge_free(*buffers, *lengths, *buffers_nr);
+    *buffers = NULL;
+    *lengths = NULL;
+    *buffers_nr = 0;
     return false;
 }
 
-void tlv_print(tlv_defs_t defs, const struct tlv_list *tlvs, void (*write_function)(const char *fmt, ...), const char *prefix)
+void tlv_forge_free(uint8_t **buffers, size_t *lengths, size_t buffers_nr)
 {
     size_t i;
 
-    for (i = 0; i < tlvs->tlv_nr; i++)
+    if (buffers != NULL)
     {
-        struct tlv *tlv = tlvs->tlvs[i];
-        const struct tlv_def *tlv_def = tlv_find_tlv_def(defs, tlv);
-        // In order to make it easier for the callback() function to present
-        // useful information, append the type of the TLV to the prefix
-        //
-        char new_prefix[100];
-
-        snprintf(new_prefix, sizeof(new_prefix)-1, "%sTLV(%s)->",
-                          prefix, (tlv_def->name == NULL) ? "Unknown" : tlv_def->name);
-        new_prefix[sizeof(new_prefix)-1] = '\0';
-
-        if (tlv_def->print == NULL)
+        for (i = 0; i < buffers_nr; i++)
         {
-            write_function("%s\n", new_prefix);
-        }
-        else
-        {
-            tlv_def->print(tlv, write_function, new_prefix);
+            memfree(buffers[i]);
         }
+        memfree(buffers);
+    }
+    memfree(lengths);
+}
+
+void tlv_print_single(tlv_defs_t defs, const struct tlv *tlv, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    const struct tlv_def *tlv_def = tlv_find_tlv_def(defs, tlv);
+    // In order to make it easier for the callback() function to present
+    // useful information, append the type of the TLV to the prefix
+    //
+    char new_prefix[100];
+
+    snprintf(new_prefix, sizeof(new_prefix)-1, "%sTLV(%s)->",
+                      prefix, (tlv_def->name == NULL) ? "Unknown" : tlv_def->name);
+    new_prefix[sizeof(new_prefix)-1] = '\0';
+
+    if (tlv_def->print == NULL)
+    {
+        write_function("%s\n", new_prefix);
+    }
+    else
+    {
+        tlv_def->print(tlv, write_function, new_prefix);
+    }
+}
+
+void tlv_print(tlv_defs_t defs, const struct tlv_list *tlvs, void (*write_function)(const char *fmt, ...), const char *prefix)
+{
+    size_t i;
+
+    for (i = 0; i < tlvs->tlv_nr; i++)
+    {
+        tlv_print_single(defs, tlvs->tlvs[i], write_function, prefix);
+    }
+}
+
+void tlv_free_single(tlv_defs_t defs, struct tlv *tlv)
+{
+    const struct tlv_def *tlv_def = tlv_find_tlv_def(defs, tlv);
+
+    if (tlv_def->free == NULL)
+    {
+        memfree(tlv);
+    }
+    else
+    {
+        tlv_def->free(tlv);
     }
 }
 
@@ -210,19 +375,26 @@ void tlv_free(tlv_defs_t defs, struct tlv_list *tlvs)
 
     for (i = 0; i < tlvs->tlv_nr; i++)
     {
-        struct tlv *tlv = tlvs->tlvs[i];
-        const struct tlv_def *tlv_def = tlv_find_tlv_def(defs, tlv);
-        if (tlv_def->free == NULL)
-        {
-            free(tlv);
-        }
-        else
-        {
-            tlv_def->free(tlv);
-        }
+        tlv_free_single(defs, tlvs->tlvs[i]);
     }
-    free(tlvs->tlvs);
-    free(tlvs);
+    memfree(tlvs->tlvs);
+    memfree(tlvs);
+}
+
+bool tlv_compare_single(tlv_defs_t defs, const struct tlv *tlv1, const struct tlv *tlv2)
+{
+    const struct tlv_def *tlv_def = tlv_find_def(defs, tlv1->type);
+
+    if (tlv1->type != tlv2->type)
+    {
+        return false;
+    }
+    if (tlv_def->compare != NULL)
+    {
+        return tlv_def->compare(tlv1, tlv2);
+    }
+    // else assume equal
+    return true;
 }
 
 bool tlv_compare(tlv_defs_t defs, const struct tlv_list *tlvs1, const struct tlv_list *tlvs2)
@@ -238,32 +410,32 @@ bool tlv_compare(tlv_defs_t defs, const struct tlv_list *tlvs1, const struct tlv
 
     for (i = 0; i < tlvs1->tlv_nr; i++)
     {
-        struct tlv *tlv1 = tlvs1->tlvs[i];
-        struct tlv *tlv2 = tlvs2->tlvs[i];
-        const struct tlv_def *tlv_def = tlv_find_def(defs, tlv1->type);
-
-        if (tlv1->type != tlv2->type)
+        if (!tlv_compare_single(defs, tlvs1->tlvs[i], tlvs2->tlvs[i]))
         {
             return false;
         }
-        if (tlv_def->compare != NULL)
-        {
-            if (!tlv_def->compare(tlv1, tlv2))
-            {
-                return false;
-            }
-        }
-        // else assume equal
     }
 
     return true;
 }
 
+void tlv_reserve(struct tlv_list *tlvs, size_t tlv_nr)
+{
+    if (tlv_nr <= tlvs->tlv_max)
+        return;
+
+    tlvs->tlvs = memrealloc(tlvs->tlvs, tlv_nr * sizeof(struct tlv*));
+    tlvs->tlv_max = tlv_nr;
+}
+
 bool tlv_add(tlv_defs_t defs, struct tlv_list *tlvs, struct tlv *tlv)
 {
     /** @todo keep ordered, check for duplicates, handle aggregation */
-    tlvs->tlv_nr++;
-    tlvs->tlvs = memrealloc(tlvs->tlvs, tlvs->tlv_nr * sizeof(struct tlv*));
-    tlvs->tlvs[tlvs->tlv_nr - 1] = tlv;
+    if (tlvs->tlv_nr == tlvs->tlv_max)
+    {
+        /* Double the capacity, so that appending n TLVs costs O(n) copies in total. */
+        tlv_reserve(tlvs, tlvs->tlv_max == 0 ? 8 : 2 * tlvs->tlv_max);
+    }
+    tlvs->tlvs[tlvs->tlv_nr++] = tlv;
     return true;
 }
@@ -58,6 +58,13 @@
  * This will be used as the member name in the struct, and also for printing.
  */
 
+/** @def TLV_FIELD2_NAME
+ * @brief The name of the second field of the TLV value.
+ *
+ * Optional. Up to four fields are supported, TLV_FIELD2_NAME to TLV_FIELD4_NAME, each with its own optional
+ * TLV_FIELDn_LENGTH. Fields are parsed and forged in order.
+ */
+
 /** @def TLV_FIELD1_LENGTH
  * @brief Define the field as a fixed-with basic type.
  *
@@ -250,6 +257,13 @@ struct exampleTLV {
 #include "tlv_template_inner.h"
 #endif // TLV_FIELD3_NAME
 
+#ifdef TLV_FIELD4_NAME
+#define TLV_FIELD_NAME    TLV_FIELD4_NAME
+#define TLV_FIELD_LENGTH  TLV_FIELD4_LENGTH
+#define TLV_FIELD_NUM     4
+#include "tlv_template_inner.h"
+#endif // TLV_FIELD4_NAME
+
 static struct tlv *TLV_TEMPLATE_FUNCTION_NAME(parse)(const struct tlv_def *def __attribute__((unused)),
                                                      const uint8_t *buffer __attribute__((unused)),
                                                      size_t length __attribute__((unused)))
@@ -276,6 +290,11 @@ static struct tlv *TLV_TEMPLATE_FUNCTION_NAME(parse)(const struct tlv_def *def _
         goto err_out;
 #endif // TLV_FIELD3_NAME
 
+#ifdef TLV_FIELD4_NAME
+    if (!TLV_TEMPLATE_FUNCTION_NAME(parse_field4)(def, self, &buffer, &length))
+        goto err_out;
+#endif // TLV_FIELD4_NAME
+
     /* Check for trailing garbage that didn't get parsed. */
     if (length > 0)
         goto err_out;
@@ -288,7 +307,7 @@ err_out:
     if (def->free != NULL)
         def->free((struct tlv *)self);
     else
-        free(self);
+        memfree(self);
     return NULL;
 }
 
@@ -322,6 +341,14 @@ static uint16_t TLV_TEMPLATE_FUNCTION_NAME(length)(const struct tlv *tlv)
 #else
     ret += sizeof(self->TLV_FIELD3_NAME);
 #endif
+#endif
+
+#ifdef TLV_FIELD4_NAME
+#ifdef TLV_FIELD4_LENGTH
+    ret += TLV_FIELD4_LENGTH;
+#else
+    ret += sizeof(self->TLV_FIELD4_NAME);
+#endif
 #endif
 
     return ret;
@@ -352,6 +379,11 @@ static bool TLV_TEMPLATE_FUNCTION_NAME(forge)(const struct tlv *tlv,
         return false;
 #endif // TLV_FIELD3_NAME
 
+#ifdef TLV_FIELD4_NAME
+    if (!TLV_TEMPLATE_FUNCTION_NAME(forge_field4)(self, buf, length))
+        return false;
+#endif // TLV_FIELD4_NAME
+
 #endif // TLV_FORGE_BODY
 
     return true;
@@ -375,6 +407,10 @@ static void TLV_TEMPLATE_FUNCTION_NAME(print)(const struct tlv *tlv, void (*writ
 #ifdef TLV_FIELD3_NAME
     TLV_TEMPLATE_FUNCTION_NAME(print_field3)(self, write_function, prefix);
 #endif // TLV_FIELD3_NAME
+
+#ifdef TLV_FIELD4_NAME
+    TLV_TEMPLATE_FUNCTION_NAME(print_field4)(self, write_function, prefix);
+#endif // TLV_FIELD4_NAME
 }
 
 static void TLV_TEMPLATE_FUNCTION_NAME(free)(struct tlv *tlv)
@@ -383,10 +419,10 @@ static void TLV_TEMPLATE_FUNCTION_NAME(free)(struct tlv *tlv)
 
 #ifdef TLV_FREE_BODY
 #undef TLV_FREE_BODY
-    return TLV_TEMPLATE_FUNCTION_NAME(free_body)(self);
+    TLV_TEMPLATE_FUNCTION_NAME(free_body)(self);
 #endif
 
-    free(self);
+    memfree(self);
 }
 
 static bool TLV_TEMPLATE_FUNCTION_NAME(compare)(const struct tlv *tlv1, const struct tlv *tlv2)
@@ -407,6 +443,11 @@ static bool TLV_TEMPLATE_FUNCTION_NAME(compare)(const struct tlv *tlv1, const st
         return false;
 #endif // TLV_FIELD3_NAME
 
+#ifdef TLV_FIELD4_NAME
+    if (!TLV_TEMPLATE_FUNCTION_NAME(compare_field4)(self1, self2))
+        return false;
+#endif // TLV_FIELD4_NAME
+
 #endif
 
     return true;
@@ -429,6 +470,12 @@ static bool TLV_TEMPLATE_FUNCTION_NAME(compare)(const struct tlv *tlv1, const st
 #ifdef TLV_FIELD3_LENGTH
 #undef TLV_FIELD3_LENGTH
 #endif
+#ifdef TLV_FIELD4_NAME
+#undef TLV_FIELD4_NAME
+#endif
+#ifdef TLV_FIELD4_LENGTH
+#undef TLV_FIELD4_LENGTH
+#endif
 #undef TLV_PARSE
 #undef TLV_FORGE
 #undef TLV_PRINT
@@ -111,7 +111,7 @@ static bool TLV_TEMPLATE_FIELD_FUNCTION_NAME(compare)(const TLV_TEMPLATE_STRUCT_
                                                       const TLV_TEMPLATE_STRUCT_NAME *self2)
 {
 #if TLV_FIELD_LENGTH > 0
-    return (self1->TLV_FIELD1_NAME == self2->TLV_FIELD1_NAME);
+    return (self1->TLV_FIELD_NAME == self2->TLV_FIELD_NAME);
 #else
     return (memcmp(self1->TLV_FIELD_NAME, self2->TLV_FIELD_NAME, sizeof(self1->TLV_FIELD_NAME)) == 0);
 #endif
@@ -261,6 +261,9 @@ int main(void)
     #define x1905CMDUFORGE004 "x1905CMDUFORGE004 - Forge topology query CMDU (x1905_cmdu_005)"
     result += _check(x1905CMDUFORGE004, &x1905_cmdu_structure_005, x1905_cmdu_streams_005, x1905_cmdu_streams_len_005);
 
+    #define x1905CMDUFORGE005 "x1905CMDUFORGE005 - Forge vendor specific CMDU split in two fragments (x1905_cmdu_006)"
+    result += _check(x1905CMDUFORGE005, &x1905_cmdu_structure_006, x1905_cmdu_streams_006, x1905_cmdu_streams_len_006);
+
     x1905_cmdu_print_real[0] = '\0';
     visit_1905_CMDU_structure(&x1905_cmdu_structure_001, print_callback, check_print, "->");
     if (strcmp(x1905_cmdu_print_expected_001, x1905_cmdu_print_real) != 0)
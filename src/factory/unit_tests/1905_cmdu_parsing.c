@@ -48,7 +48,8 @@
  */
 
 //
-// This file tests the "parse_1905_CMDU_from_packets()" function by providing
+// This file tests the "parse_1905_CMDU_from_packets()" (and
+// "parse_1905_CMDU_view_from_packets()") functions by providing
 // some test input streams and checking the generated output structure.
 //
 
@@ -86,6 +87,121 @@ static int check_parse_1905_cmdu(const char *test_description, uint8_t **input,
     return result;
 }
 
+static int check_parse_1905_cmdu_arena(const char *test_description, uint8_t **input, struct CMDU *expected_output)
+{
+    int result;
+    int i;
+    struct memArena *arena;
+    struct CMDU     *real_output;
+
+    // A tiny chunk size forces the parser to span several chunks on the first
+    // round. After the reset everything must fit in the (merged) first one.
+    //
+    result = 0;
+    arena  = memArenaCreate(64);
+
+    for (i=0; i<2; i++)
+    {
+        memArenaSelect(arena);
+        real_output = parse_1905_CMDU_from_packets(input);
+
+        if (0 == memArenaContains(arena, real_output) || 0 != compare_1905_CMDU_structures(real_output, expected_output))
+        {
+            result = 1;
+            PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+            PLATFORM_PRINTF("  Expected output:\n");
+            visit_1905_CMDU_structure(expected_output, print_callback, PLATFORM_PRINTF, "");
+            PLATFORM_PRINTF("  Real output    :\n");
+            visit_1905_CMDU_structure(real_output, print_callback, PLATFORM_PRINTF, "");
+            memArenaSelect(NULL);
+            break;
+        }
+
+        // Must leave the arena contents alone (it is still selected)
+        //
+        free_1905_CMDU_structure(real_output);
+        memArenaSelect(NULL);
+        memArenaReset(arena);
+    }
+
+    memArenaDestroy(arena);
+
+    if (0 == result)
+    {
+        PLATFORM_PRINTF("%-100s: OK\n", test_description);
+    }
+
+    return result;
+}
+
+static int check_parse_1905_cmdu_view(const char *test_description, uint8_t **input, struct CMDU *expected_output)
+{
+    int result;
+    struct CMDU_view *view;
+    struct CMDU      *real_output;
+    uint16_t          i;
+
+    result      = 1;
+    real_output = NULL;
+
+    view = parse_1905_CMDU_view_from_packets(input);
+
+    if (
+         NULL != view                                                 &&
+         view->message_version == expected_output->message_version   &&
+         view->message_type    == expected_output->message_type      &&
+         view->message_id      == expected_output->message_id        &&
+         view->relay_indicator == expected_output->relay_indicator
+       )
+    {
+        // The TLV views must match (in type and order) the expected TLVs...
+        //
+        for (i=0; i<view->tlvs_nr && NULL != expected_output->list_of_TLVs[i]; i++)
+        {
+            if (view->tlvs[i].type != *expected_output->list_of_TLVs[i] || view->tlvs[i].type != *view->tlvs[i].stream)
+            {
+                break;
+            }
+        }
+
+        // ...and, once materialized, the result must be the same as a full
+        // parse
+        //
+        if (i == view->tlvs_nr && NULL == expected_output->list_of_TLVs[i])
+        {
+            real_output = materialize_1905_CMDU_view(view);
+            if (0 == compare_1905_CMDU_structures(real_output, expected_output))
+            {
+                result = 0;
+            }
+        }
+    }
+
+    if (0 == result)
+    {
+        PLATFORM_PRINTF("%-100s: OK\n", test_description);
+    }
+    else
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  Expected output:\n");
+        visit_1905_CMDU_structure(expected_output, print_callback, PLATFORM_PRINTF, "");
+        if (NULL != real_output)
+        {
+            PLATFORM_PRINTF("  Real output    :\n");
+            visit_1905_CMDU_structure(real_output, print_callback, PLATFORM_PRINTF, "");
+        }
+    }
+
+    if (NULL != real_output)
+    {
+        free_1905_CMDU_structure(real_output);
+    }
+    free_1905_CMDU_view(view);
+
+    return result;
+}
+
 static int check_parse_1905_cmdu_header(const char *test_description, uint8_t *input, size_t input_len,
                                         struct CMDU_header *expected_output)
 {
@@ -152,6 +268,15 @@ int main(void)
     #define x1905CMDUPARSE004 "x1905CMDUPARSE004 - Parse topology query CMDU (x1905_cmdu_streams_005)"
     result += check_parse_1905_cmdu(x1905CMDUPARSE004, x1905_cmdu_streams_005, &x1905_cmdu_structure_005);
 
+    #define x1905CMDUPARSEVIEW001 "x1905CMDUPARSEVIEW001 - Parse link metric query CMDU view (x1905_cmdu_streams_001)"
+    result += check_parse_1905_cmdu_view(x1905CMDUPARSEVIEW001, x1905_cmdu_streams_001, &x1905_cmdu_structure_001);
+
+    #define x1905CMDUPARSEVIEW002 "x1905CMDUPARSEVIEW002 - Parse vendor specific CMDU view from two fragments (x1905_cmdu_streams_006)"
+    result += check_parse_1905_cmdu_view(x1905CMDUPARSEVIEW002, x1905_cmdu_streams_006, &x1905_cmdu_structure_006);
+
+    #define x1905CMDUPARSEARENA001 "x1905CMDUPARSEARENA001 - Parse vendor specific CMDU on an arena (x1905_cmdu_streams_006)"
+    result += check_parse_1905_cmdu_arena(x1905CMDUPARSEARENA001, x1905_cmdu_streams_006, &x1905_cmdu_structure_006);
+
     result += check_parse_1905_cmdu_header("x1905CMDUPARSEHDR001 - Parse CMDU packet last fragment",
                                            x1905_cmdu_packet_001, x1905_cmdu_packet_len_001, &x1905_cmdu_header_001);
 
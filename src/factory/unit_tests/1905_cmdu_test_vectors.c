@@ -321,6 +321,75 @@ uint8_t *x1905_cmdu_streams_005[] =
 uint16_t x1905_cmdu_streams_len_005[] = {11, 0};
 
 
+////////////////////////////////////////////////////////////////////////////////
+//// Test vector 006 (CMDU <--> packet)
+////////////////////////////////////////////////////////////////////////////////
+
+// Two vendor specific TLVs which do not fit together in one single fragment.
+// Their payload (and the tail of each stream) is all zeros.
+//
+static uint8_t x1905_cmdu_vendor_payload_006[1000];
+
+struct CMDU x1905_cmdu_structure_006 =
+{
+    .message_version = CMDU_MESSAGE_VERSION_1905_1_2013,
+    .message_type    = CMDU_TYPE_VENDOR_SPECIFIC,
+    .message_id      = 42,
+    .relay_indicator = 0,
+    .list_of_TLVs    =
+        (uint8_t* []){
+            (uint8_t *)(struct vendorSpecificTLV[]){
+                {
+                    .tlv.type          = TLV_TYPE_VENDOR_SPECIFIC,
+                    .vendorOUI         = {0x00, 0x90, 0x96},
+                    .m_nr              = sizeof(x1905_cmdu_vendor_payload_006),
+                    .m                 = x1905_cmdu_vendor_payload_006,
+                },
+            },
+            (uint8_t *)(struct vendorSpecificTLV[]){
+                {
+                    .tlv.type          = TLV_TYPE_VENDOR_SPECIFIC,
+                    .vendorOUI         = {0x00, 0x90, 0x96},
+                    .m_nr              = sizeof(x1905_cmdu_vendor_payload_006),
+                    .m                 = x1905_cmdu_vendor_payload_006,
+                },
+            },
+            NULL
+        },
+};
+
+uint8_t *x1905_cmdu_streams_006[] =
+{
+    (uint8_t [8 + 3 + 1003 + 3]){
+        0x00,
+        0x00,
+        0x00, 0x04,
+        0x00, 0x2a,
+        0x00,
+        0x00,
+
+        0x0b,
+        0x03, 0xeb,
+        0x00, 0x90, 0x96,
+    },
+    (uint8_t [8 + 3 + 1003 + 3]){
+        0x00,
+        0x00,
+        0x00, 0x04,
+        0x00, 0x2a,
+        0x01,
+        0x80,
+
+        0x0b,
+        0x03, 0xeb,
+        0x00, 0x90, 0x96,
+    },
+    NULL
+};
+
+uint16_t x1905_cmdu_streams_len_006[] = {1017, 1017, 0};
+
+
 // TODO: More tests for all types of CMDUs
 
 
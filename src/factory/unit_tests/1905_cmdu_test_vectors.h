@@ -73,6 +73,10 @@ extern struct CMDU   x1905_cmdu_structure_005;
 extern uint8_t        *x1905_cmdu_streams_005[];
 extern uint16_t        x1905_cmdu_streams_len_005[];
 
+extern struct CMDU   x1905_cmdu_structure_006;
+extern uint8_t        *x1905_cmdu_streams_006[];
+extern uint16_t        x1905_cmdu_streams_len_006[];
+
 /** @defgroup tv_cmdu_header CMDU header parsing test vectors
  */
 
@@ -225,6 +225,12 @@ int main(void)
     #define x1905TLVFORGE039 "x1905TLVFORGE039 - Forge searched service TLV (x1905_tlv_structure_053)"
     result += _check(x1905TLVFORGE039, (uint8_t *)&x1905_tlv_structure_053, x1905_tlv_stream_053, x1905_tlv_stream_len_053);
 
+    #define x1905TLVFORGE040 "x1905TLVFORGE040 - Forge push button join notification TLV (x1905_tlv_structure_054)"
+    result += _check(x1905TLVFORGE040, (uint8_t *)&x1905_tlv_structure_054, x1905_tlv_stream_054, x1905_tlv_stream_len_054);
+
+    #define x1905TLVFORGE041 "x1905TLVFORGE041 - Forge WSC TLV (x1905_tlv_structure_055)"
+    result += _check(x1905TLVFORGE041, (uint8_t *)&x1905_tlv_structure_055, x1905_tlv_stream_055, x1905_tlv_stream_len_055);
+
     // Return the number of test cases that failed
     //
     return result;
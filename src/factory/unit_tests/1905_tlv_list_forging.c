@@ -0,0 +1,221 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+
+//
+// This file tests the "tlv_forge()" function by forging lists of TLVs into
+// packets of different sizes (and with different amounts of headroom and
+// tailroom) and checking how the TLVs have been split among them.
+//
+
+#include "platform.h"
+#include "1905_tlvs.h"
+#include "1905_tlv_list_test_vectors.h"
+
+#include <string.h> // memcmp(), memset(), ...
+
+#define HEADROOM_MARKER (0xa5)
+#define TAILROOM_MARKER (0x5a)
+
+// Parse 'stream' into a TLV list, forge it back with "tlv_forge()" and check
+// that:
+//
+//   - It generates 'expected_nr' packets, with the lengths contained in the
+//     'expected_lengths' array.
+//     'expected_nr' set to "0" means "tlv_forge()" must fail instead.
+//
+//   - The TLVs of each packet start 'headroom' bytes into its buffer, and
+//     'headroom' and 'tailroom' bytes can be written before and after them.
+//
+//   - All the packets put together are the original 'stream'.
+//
+uint8_t _check(const char *test_description, uint8_t *stream, uint16_t stream_len,
+               size_t max_length, size_t headroom, size_t tailroom,
+               size_t *expected_lengths, size_t expected_nr)
+{
+    uint8_t           result;
+    struct tlv_list  *tlvs;
+    uint8_t         **buffers;
+    size_t           *lengths;
+    size_t            buffers_nr;
+    size_t            offset;
+    size_t            i;
+
+    tlvs = tlv_parse(tlv_1905_defs, stream, stream_len);
+    if (NULL == tlvs)
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  tlv_parse() returned a NULL pointer\n");
+
+        return 1;
+    }
+
+    if (!tlv_forge(tlv_1905_defs, tlvs, max_length, headroom, tailroom, &buffers, &lengths, &buffers_nr))
+    {
+        tlv_free(tlv_1905_defs, tlvs);
+
+        if (0 == expected_nr)
+        {
+            PLATFORM_PRINTF("%-100s: OK\n", test_description);
+            return 0;
+        }
+
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  tlv_forge() failed\n");
+
+        return 1;
+    }
+    tlv_free(tlv_1905_defs, tlvs);
+
+    result = 0;
+
+    if (0 == expected_nr)
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  tlv_forge() should have failed, but returned %u packets\n", (unsigned)buffers_nr);
+
+        result = 1;
+    }
+    else if (expected_nr != buffers_nr)
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  Expected packets: %u\n", (unsigned)expected_nr);
+        PLATFORM_PRINTF("  Real packets    : %u\n", (unsigned)buffers_nr);
+
+        result = 1;
+    }
+    else
+    {
+        offset = 0;
+        for (i = 0; i < buffers_nr; i++)
+        {
+            if (expected_lengths[i] != lengths[i])
+            {
+                PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+                PLATFORM_PRINTF("  Packet #%u: expected length %u, real length %u\n",
+                                (unsigned)i, (unsigned)expected_lengths[i], (unsigned)lengths[i]);
+
+                result = 1;
+                break;
+            }
+
+            // The caller fills the headroom (ex: with the CMDU header) and the
+            // tailroom (ex: with padding) once the TLVs have been forged.
+            // Doing so must not overwrite any of them.
+            //
+            memset(buffers[i], HEADROOM_MARKER, headroom);
+            memset(buffers[i] + headroom + lengths[i], TAILROOM_MARKER, tailroom);
+
+            if (offset + lengths[i] > stream_len || 0 != memcmp(buffers[i] + headroom, stream + offset, lengths[i]))
+            {
+                PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+                PLATFORM_PRINTF("  Packet #%u does not contain the expected TLVs\n", (unsigned)i);
+
+                result = 1;
+                break;
+            }
+            offset += lengths[i];
+        }
+
+        if (0 == result && offset != stream_len)
+        {
+            PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+            PLATFORM_PRINTF("  Only %u out of %u bytes were forged\n", (unsigned)offset, (unsigned)stream_len);
+
+            result = 1;
+        }
+
+        if (0 == result)
+        {
+            PLATFORM_PRINTF("%-100s: OK\n", test_description);
+        }
+    }
+
+    tlv_forge_free(buffers, lengths, buffers_nr);
+
+    return result;
+}
+
+
+int main(void)
+{
+    uint8_t result = 0;
+
+    size_t lengths_001[] = {36};
+    size_t lengths_002[] = {27, 9};
+    size_t lengths_003[] = {18, 18, 18, 18, 18};
+    size_t lengths_004[] = {90};
+    size_t lengths_005[] = {66, 4};
+    size_t lengths_007[] = {0};
+
+    #define x1905TLVLISTFORGE001 "x1905TLVLISTFORGE001 - Forge TLV list exactly fitting one packet (x1905_tlv_list_stream_001)"
+    result += _check(x1905TLVLISTFORGE001, x1905_tlv_list_stream_001, x1905_tlv_list_stream_len_001, 36, 0, 0, lengths_001, 1);
+
+    #define x1905TLVLISTFORGE002 "x1905TLVLISTFORGE002 - Forge TLV list one byte longer than a packet (x1905_tlv_list_stream_001)"
+    result += _check(x1905TLVLISTFORGE002, x1905_tlv_list_stream_001, x1905_tlv_list_stream_len_001, 35, 0, 0, lengths_002, 2);
+
+    #define x1905TLVLISTFORGE003 "x1905TLVLISTFORGE003 - Forge TLV list into 5 packets with head/tailroom (x1905_tlv_list_stream_002)"
+    result += _check(x1905TLVLISTFORGE003, x1905_tlv_list_stream_002, x1905_tlv_list_stream_len_002, 20, 14, 4, lengths_003, 5);
+
+    #define x1905TLVLISTFORGE004 "x1905TLVLISTFORGE004 - Forge TLV list into 1 packet with head/tailroom (x1905_tlv_list_stream_002)"
+    result += _check(x1905TLVLISTFORGE004, x1905_tlv_list_stream_002, x1905_tlv_list_stream_len_002, 1500, 14, 4, lengths_004, 1);
+
+    #define x1905TLVLISTFORGE005 "x1905TLVLISTFORGE005 - Forge TLV list with a TLV exactly fitting a packet (x1905_tlv_list_stream_003)"
+    result += _check(x1905TLVLISTFORGE005, x1905_tlv_list_stream_003, x1905_tlv_list_stream_len_003, 66, 8, 0, lengths_005, 2);
+
+    #define x1905TLVLISTFORGE006 "x1905TLVLISTFORGE006 - Forge TLV list with a TLV larger than a packet (x1905_tlv_list_stream_003)"
+    result += _check(x1905TLVLISTFORGE006, x1905_tlv_list_stream_003, x1905_tlv_list_stream_len_003, 65, 8, 0, NULL, 0);
+
+    #define x1905TLVLISTFORGE007 "x1905TLVLISTFORGE007 - Forge empty TLV list into one empty packet"
+    result += _check(x1905TLVLISTFORGE007, x1905_tlv_list_stream_001, 0, 36, 14, 4, lengths_007, 1);
+
+    // Return the number of test cases that failed
+    //
+    return result;
+}
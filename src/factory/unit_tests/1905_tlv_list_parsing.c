@@ -0,0 +1,220 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+
+//
+// This file tests how "tlv_parse()", "tlv_add()" and "tlv_reserve()" build
+// lists of TLVs: lists reserved up front (from the pre-scan of the TLV headers
+// done by "tlv_parse()") and lists grown one TLV at a time (through several
+// capacity doublings) must end up containing the same TLVs, in the same order.
+//
+
+#include "platform.h"
+#include "1905_tlvs.h"
+#include "1905_tlv_list_test_vectors.h"
+
+#include <string.h> // memcmp(), memcpy(), ...
+
+// Number of TLVs used to grow a list well past its initial capacity (which is
+// then doubled 5 times: 8 -> 16 -> 32 -> 64 -> 128 -> 256)
+//
+#define GROWTH_TLVS_NR  (200)
+
+// Build a list by adding, one by one, each of the TLVs contained in 'stream'
+// to an empty list (after reserving room for 'reserved_nr' of them), and check
+// that:
+//
+//   - It is equal to the list "tlv_parse()" returns for the whole 'stream'.
+//
+//   - Forging it back with "tlv_forge()" gives the original 'stream'.
+//
+uint8_t _check(const char *test_description, uint8_t *stream, uint16_t stream_len, size_t reserved_nr)
+{
+    uint8_t           result;
+    struct tlv_list  *parsed;
+    struct tlv_list  *added;
+    uint8_t         **buffers;
+    size_t           *lengths;
+    size_t            buffers_nr;
+    uint16_t          offset;
+
+    result = 1;
+    buffers = NULL;
+    lengths = NULL;
+    buffers_nr = 0;
+
+    parsed = tlv_parse(tlv_1905_defs, stream, stream_len);
+    added  = tlv_parse(tlv_1905_defs, NULL, 0);
+
+    if (NULL == parsed || NULL == added)
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  tlv_parse() returned a NULL pointer\n");
+
+        goto out;
+    }
+
+    tlv_reserve(added, reserved_nr);
+
+    offset = 0;
+    while (offset < stream_len)
+    {
+        struct tlv *tlv;
+        uint16_t    tlv_size;
+
+        tlv_size = (((uint16_t)stream[offset + 1] << 8) | stream[offset + 2]) + 3;
+
+        tlv = tlv_parse_single(tlv_1905_defs, stream + offset, tlv_size);
+        if (NULL == tlv || !tlv_add(tlv_1905_defs, added, tlv))
+        {
+            PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+            PLATFORM_PRINTF("  Could not add the TLV found at offset %u\n", offset);
+
+            if (NULL != tlv)
+            {
+                tlv_free_single(tlv_1905_defs, tlv);
+            }
+            goto out;
+        }
+        offset += tlv_size;
+    }
+
+    if (!tlv_compare(tlv_1905_defs, parsed, added))
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  The parsed list and the grown list are different\n");
+
+        goto out;
+    }
+
+    if (!tlv_forge(tlv_1905_defs, added, stream_len, 0, 0, &buffers, &lengths, &buffers_nr) ||
+        1 != buffers_nr || stream_len != lengths[0] || 0 != memcmp(buffers[0], stream, stream_len))
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  Forging the grown list does not give back the original stream\n");
+
+        goto out;
+    }
+
+    result = 0;
+    PLATFORM_PRINTF("%-100s: OK\n", test_description);
+
+out:
+    tlv_forge_free(buffers, lengths, buffers_nr);
+    if (NULL != parsed)
+    {
+        tlv_free(tlv_1905_defs, parsed);
+    }
+    if (NULL != added)
+    {
+        tlv_free(tlv_1905_defs, added);
+    }
+
+    return result;
+}
+
+// Check that "tlv_parse()" rejects 'stream' (ex: because its last TLV is
+// truncated), even if the pre-scan of its headers already reserved room for
+// the TLVs before it.
+//
+uint8_t _checkError(const char *test_description, uint8_t *stream, uint16_t stream_len)
+{
+    struct tlv_list *parsed;
+
+    parsed = tlv_parse(tlv_1905_defs, stream, stream_len);
+    if (NULL != parsed)
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  tlv_parse() should have returned a NULL pointer\n");
+
+        tlv_free(tlv_1905_defs, parsed);
+        return 1;
+    }
+
+    PLATFORM_PRINTF("%-100s: OK\n", test_description);
+    return 0;
+}
+
+
+int main(void)
+{
+    uint8_t  result = 0;
+
+    uint8_t  growth_stream[GROWTH_TLVS_NR * 9];
+    uint16_t i;
+
+    // GROWTH_TLVS_NR "AL MAC address type" TLVs, each one with a different
+    // MAC address
+    //
+    for (i = 0; i < GROWTH_TLVS_NR; i++)
+    {
+        memcpy(&growth_stream[i * 9], x1905_tlv_list_stream_001, 9);
+        growth_stream[i * 9 + 7] = (uint8_t)(i >> 8);
+        growth_stream[i * 9 + 8] = (uint8_t)(i & 0xff);
+    }
+
+    #define x1905TLVLISTPARSE001 "x1905TLVLISTPARSE001 - Grow TLV list without reserving (x1905_tlv_list_stream_002)"
+    result += _check(x1905TLVLISTPARSE001, x1905_tlv_list_stream_002, x1905_tlv_list_stream_len_002, 0);
+
+    #define x1905TLVLISTPARSE002 "x1905TLVLISTPARSE002 - Grow TLV list past a small reservation (x1905_tlv_list_stream_002)"
+    result += _check(x1905TLVLISTPARSE002, x1905_tlv_list_stream_002, x1905_tlv_list_stream_len_002, 3);
+
+    #define x1905TLVLISTPARSE003 "x1905TLVLISTPARSE003 - Grow TLV list within its reservation (x1905_tlv_list_stream_003)"
+    result += _check(x1905TLVLISTPARSE003, x1905_tlv_list_stream_003, x1905_tlv_list_stream_len_003, 2);
+
+    #define x1905TLVLISTPARSE004 "x1905TLVLISTPARSE004 - Grow TLV list through 5 capacity doublings"
+    result += _check(x1905TLVLISTPARSE004, growth_stream, sizeof(growth_stream), 0);
+
+    #define x1905TLVLISTPARSE005 "x1905TLVLISTPARSE005 - Parse TLV list whose last TLV is truncated (x1905_tlv_list_stream_002)"
+    result += _checkError(x1905TLVLISTPARSE005, x1905_tlv_list_stream_002, x1905_tlv_list_stream_len_002 - 1);
+
+    // Return the number of test cases that failed
+    //
+    return result;
+}
@@ -0,0 +1,165 @@
+/*
+ *  Broadband Forum BUS (Broadband User Services) Work Area
+ *
+ *  Copyright (c) 2017, Broadband Forum
+ *  Copyright (c) 2017, MaxLinear, Inc. and its affiliates
+ *
+ *  This is draft software, is subject to change, and has not been
+ *  approved by members of the Broadband Forum. It is made available to
+ *  non-members for internal study purposes only. For such study
+ *  purposes, you have the right to make copies and modifications only
+ *  for distributing this software internally within your organization
+ *  among those who are working on it (redistribution outside of your
+ *  organization for other than study purposes of the original or
+ *  modified works is not permitted). For the avoidance of doubt, no
+ *  patent rights are conferred by this license.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Unless a different date is specified upon issuance of a draft
+ *  software release, all member and non-member license rights under the
+ *  draft software release will expire on the earliest to occur of (i)
+ *  nine months from the date of issuance, (ii) the issuance of another
+ *  version of the same software release, or (iii) the adoption of the
+ *  draft software release as final.
+ *
+ *  ---
+ *
+ *  This version of this source file is part of the Broadband Forum
+ *  WT-382 IEEE 1905.1/1a stack project.
+ *
+ *  Please follow the release link (given below) for further details
+ *  of the release, e.g. license validity dates and availability of
+ *  more recent draft or final releases.
+ *
+ *  Release name: WT-382_draft1
+ *  Release link: https://www.broadband-forum.org/software#WT-382_draft1
+ */
+
+
+// This file contains test vectors than can be used to check the functions from
+// "tlv.h" that work on whole lists of TLVs ("tlv_parse()", "tlv_forge()", ...)
+// using the 1905 TLV metadata ("tlv_1905_defs").
+//
+// Each test vector is made up of two variables:
+//
+//   - An array of bits representing several consecutive TLVs, as found in the
+//     payload of a CMDU
+//   - An variable holding the length of the array
+//
+// All the TLVs in these streams must be of types already described in
+// "tlv_1905_defs".
+//
+
+#include "1905_tlv_list_test_vectors.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//// Test vector 001 (4 TLVs of 9 bytes each)
+////////////////////////////////////////////////////////////////////////////////
+
+uint8_t x1905_tlv_list_stream_001[] =
+{
+    0x01,
+    0x00, 0x06,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x01,
+
+    0x01,
+    0x00, 0x06,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x02,
+
+    0x01,
+    0x00, 0x06,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x03,
+
+    0x01,
+    0x00, 0x06,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x04,
+};
+
+uint16_t x1905_tlv_list_stream_len_001 = 36;
+
+
+////////////////////////////////////////////////////////////////////////////////
+//// Test vector 002 (10 TLVs of 9 bytes each, of two different types)
+////////////////////////////////////////////////////////////////////////////////
+
+uint8_t x1905_tlv_list_stream_002[] =
+{
+    0x01,
+    0x00, 0x06,
+    0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x01,
+
+    0x02,
+    0x00, 0x06,
+    0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x02,
+
+    0x01,
+    0x00, 0x06,
+    0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x03,
+
+    0x02,
+    0x00, 0x06,
+    0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x04,
+
+    0x01,
+    0x00, 0x06,
+    0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x05,
+
+    0x02,
+    0x00, 0x06,
+    0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x06,
+
+    0x01,
+    0x00, 0x06,
+    0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x07,
+
+    0x02,
+    0x00, 0x06,
+    0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x08,
+
+    0x01,
+    0x00, 0x06,
+    0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x09,
+
+    0x02,
+    0x00, 0x06,
+    0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x0a,
+};
+
+uint16_t x1905_tlv_list_stream_len_002 = 90;
+
+
+////////////////////////////////////////////////////////////////////////////////
+//// Test vector 003 (one TLV of 66 bytes followed by one TLV of 4 bytes)
+////////////////////////////////////////////////////////////////////////////////
+
+uint8_t x1905_tlv_list_stream_003[] =
+{
+    0x0b,
+    0x00, 0x3f,
+    0x00, 0x90, 0x96,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+
+    0x0c,
+    0x00, 0x01,
+    0x00,
+};
+
+uint16_t x1905_tlv_list_stream_len_003 = 70;
+
@@ -226,6 +226,12 @@ int main(void)
     #define x1905TLVPARSE044 "x1905TLVPARSE044 - Parse Associated Clients TLV (x1905_tlv_stream_053)"
     result += _check(x1905TLVPARSE044, x1905_tlv_stream_053, (uint8_t *)&x1905_tlv_structure_053);
 
+    #define x1905TLVPARSE045 "x1905TLVPARSE045 - Parse push button join notification TLV (x1905_tlv_stream_054)"
+    result += _check(x1905TLVPARSE045, x1905_tlv_stream_054, (uint8_t *)&x1905_tlv_structure_054);
+
+    #define x1905TLVPARSE046 "x1905TLVPARSE046 - Parse WSC TLV (x1905_tlv_stream_055)"
+    result += _check(x1905TLVPARSE046, x1905_tlv_stream_055, (uint8_t *)&x1905_tlv_structure_055);
+
 
     // Return the number of test cases that failed
     //
@@ -1676,3 +1676,65 @@ uint8_t x1905_tlv_stream_053[] =
 };
 
 uint16_t x1905_tlv_stream_len_053 = ARRAY_SIZE(x1905_tlv_stream_053);
+
+
+////////////////////////////////////////////////////////////////////////////////
+////
+//// Test vector 054 (TLV <--> packet)
+////
+////////////////////////////////////////////////////////////////////////////////
+
+struct pushButtonJoinNotificationTLV x1905_tlv_structure_054 =
+{
+    .tlv.type                    = TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION,
+    .al_mac_address              = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05},
+    .message_identifier          = 0x1234,
+    .mac_address                 = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15},
+    .new_mac_address             = {0x20, 0x21, 0x22, 0x23, 0x24, 0x25},
+};
+
+uint8_t x1905_tlv_stream_054[] =
+{
+    0x13,
+    0x00, 20,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x12, 0x34,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25,
+};
+
+uint16_t x1905_tlv_stream_len_054 = ARRAY_SIZE(x1905_tlv_stream_054);
+
+
+////////////////////////////////////////////////////////////////////////////////
+////
+//// Test vector 055 (TLV <--> packet)
+////
+////////////////////////////////////////////////////////////////////////////////
+
+static uint8_t x1905_tlv_wsc_frame_055[] =
+{
+    0x10, 0x4a, 0x00, 0x01, 0x10,
+    0x10, 0x22, 0x00, 0x01, 0x04,
+    0x10, 0x47, 0x00, 0x10, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                            0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+};
+
+struct wscTLV x1905_tlv_structure_055 =
+{
+    .tlv.type                    = TLV_TYPE_WSC,
+    .wsc_frame_size              = ARRAY_SIZE(x1905_tlv_wsc_frame_055),
+    .wsc_frame                   = x1905_tlv_wsc_frame_055,
+};
+
+uint8_t x1905_tlv_stream_055[] =
+{
+    0x11,
+    0x00, 30,
+    0x10, 0x4a, 0x00, 0x01, 0x10,
+    0x10, 0x22, 0x00, 0x01, 0x04,
+    0x10, 0x47, 0x00, 0x10, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                            0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+};
+
+uint16_t x1905_tlv_stream_len_055 = ARRAY_SIZE(x1905_tlv_stream_055);
@@ -233,5 +233,13 @@ extern struct associatedClientsTLV                     x1905_tlv_structure_053;
 extern uint8_t                                           x1905_tlv_stream_053[];
 extern uint16_t                                          x1905_tlv_stream_len_053;
 
+extern struct pushButtonJoinNotificationTLV            x1905_tlv_structure_054;
+extern uint8_t                                           x1905_tlv_stream_054[];
+extern uint16_t                                          x1905_tlv_stream_len_054;
+
+extern struct wscTLV                                   x1905_tlv_structure_055;
+extern uint8_t                                           x1905_tlv_stream_055[];
+extern uint16_t                                          x1905_tlv_stream_len_055;
+
 #endif
 